@@ -49,12 +49,16 @@
 #include <Math/Math.h>
 #include <iostream>
 #include "DynamicsPlotManager.h"
+#include "DynamicsPlot/ParallelSweep.h"
 
 using namespace std;
 
 namespace nerd {
 
-BasinPlotter::BasinPlotter() : DynamicsPlotter("BasinOfAttraction") {
+BasinPlotter::BasinPlotter() 
+	: DynamicsPlotter("BasinOfAttraction"), mXStart(0.0), mXStepSize(0.0), mYStart(0.0), 
+	  mYStepSize(0.0), mCurrentResolutionX(0), mCurrentResolutionY(0), mCurrentAccuracy(0.0) 
+{
 	// initialising
 
 	mVariedX = new StringValue("0");
@@ -324,158 +328,92 @@ void BasinPlotter::calculateData() {
 	}
 
 	// MAIN LOOP over x parameter points
-		
-	int stepsRun = mStepsToRun->get();
-	int stepsCheck = mStepsToCheck->get();
-	double accuracy = mAccuracy->get();
 	
-	QList< QList<double> > attractors;
+	mXStart = xStart;
+	mXStepSize = xStepSize;
+	mYStart = yStart;
+	mYStepSize = yStepSize;
+	mCurrentResolutionX = resolutionX;
+	mCurrentResolutionY = resolutionY;
+	mCurrentAccuracy = mAccuracy->get();
+	mCurrentProjectionRangesX = projectionRangesX;
+	mCurrentProjectionRangesY = projectionRangesY;
+	mAttractors.clear();
+	
+	if(canUseParallelSweep(network) && !resetSimulation && restoreNetConfiguration
+		&& resetNetworkActivation && !mEnableConstraintsInCurrentRun)
+	{
+		//all grid points are independent: distribute the columns over several threads.
+		//the attractors are numbered in column order when the columns are merged.
+		restoreNetworkConfiguration();
+		restoreCurrentNetworkActivites();
 		
-	for(int x = 1; x <= resolutionX && mActiveValue->get(); ++x) {
-			
-		mProgressPercentage->set((double)(100 * x / resolutionX));
-
-		// INNER LOOP over y parameter points
-		for(int y = 1; y <= resolutionY && mActiveValue->get(); ++y) {
-			
-			if(resetSimulation) {
-				triggerReset();
-			}
-			
-			if(restoreNetConfiguration) {
-				restoreNetworkConfiguration();
-			}
-			
-			if(resetNetworkActivation) {
-				restoreCurrentNetworkActivites();
-			}
-			
-			// set x parameter
-			variedValX->set(xValues.at(x - 1));
-			// set y parameter
-			variedValY->set(yValues.at(y - 1));
-			
-			if(!notifyNetworkParametersChanged(network)) {
-				return;
-			}
-
-			for(int runStep = 0; runStep < stepsRun && mActiveValue->get(); ++runStep) {
-				// let the network run for 1 timestep
-				triggerNetworkStep();
-			}
-			
-			QList< QList<double> > networkStates;
-			QList<double> networkState;
-			QList< QPair<double,double> > variedPositions;
-
-			QList< QPair< QList<double>, QList<double> > > projectionPositions;
-
-			bool foundMatch = false;
-			int attrPeriod = 0;
-
-			for(int checkStep = 0; checkStep <= stepsCheck && !foundMatch && mActiveValue->get(); ++checkStep) {
-				triggerNetworkStep();
-				
-				// get current network state
-				networkState = DynamicsPlotterUtil::getNetworkState(networkValues);
+		mXValues = xValues;
+		mYValues = yValues;
+		mWorkerVariedValuesX.clear();
+		mWorkerVariedValuesY.clear();
+		mWorkerNetworkValues.clear();
+		mWorkerProjectionValuesX.clear();
+		mWorkerProjectionValuesY.clear();
+		mWorkerNeuronsToTransfer.clear();
+		mCompletedColumns.clear();
+		
+		ParallelSweep sweep(network, mNumberOfThreads->get());
+		sweep.execute(resolutionX, this, mActiveValue, mProgressPercentage);
+		
+		QMutexLocker guard(&mColumnMutex);
+		mCompletedColumns.clear();
+	}
+	else {
+		for(int x = 1; x <= resolutionX && mActiveValue->get(); ++x) {
 				
-				// abort on empty state
-				if(networkState.isEmpty()) {
-					reportProblem("BasinPlotter: Encountered empty network state.");
-					return;
-				}
+			mProgressPercentage->set((double)(100 * x / resolutionX));
+	
+			// INNER LOOP over y parameter points
+			for(int y = 1; y <= resolutionY && mActiveValue->get(); ++y) {
 				
-				// compare states to find attractors
-				for(int period = 1; period <= checkStep && !foundMatch; ++period) {
-					foundMatch = DynamicsPlotterUtil::compareNetworkStates(
-							networkStates.at(checkStep-period),
-							networkState,
-							accuracy);
-					attrPeriod = period;
+				if(resetSimulation) {
+					triggerReset();
 				}
 				
-				// save current state as last one
-				networkStates.append(networkState);
-
-				variedPositions.append(QPair<double,double>(variedValX->get(), variedValY->get()));
-
-				if(nrProjections > 0) {
-					QPair< QList<double>, QList<double> > currentPositions;
-					currentPositions.first = DynamicsPlotterUtil::getMeanValues(projectionValuesX);
-					currentPositions.second = DynamicsPlotterUtil::getMeanValues(projectionValuesY);
-					projectionPositions.append(currentPositions);
+				if(restoreNetConfiguration) {
+					restoreNetworkConfiguration();
 				}
-
-			}
-			
-			// at this point, either an attractor has been found
-			if(foundMatch && mActiveValue->get()) {
 				
-				// check for past attractors
-				bool attrMatch = false;
-				int attrNo = 1;
-				while(attrNo <= attractors.size() && !attrMatch) {
-					for(int state = 1; state <= attrPeriod && !attrMatch; ++state) {
-						attrMatch = DynamicsPlotterUtil::compareNetworkStates(
-								attractors.at(attrNo-1),
-								networkStates.at(networkStates.size()-state),
-									// was: size()-1-state
-								accuracy);
-					}
-					attrNo++;
+				if(resetNetworkActivation) {
+					restoreCurrentNetworkActivites();
 				}
 				
+				// set x parameter
+				variedValX->set(xValues.at(x - 1));
+				// set y parameter
+				variedValY->set(yValues.at(y - 1));
 				
-				//Thread safety of matrix.
-				QMutexLocker guard(mDynamicsPlotManager->getMatrixLocker());
-				
-				// write matrix
-				mData->set(attrNo, x, y, 0);
-				mData->set(attrPeriod, x, y, 1);
-
-				// calculate and plot attractor position
-				int nrPositions = variedPositions.size();
-				for(int periodPos = 1; periodPos <= attrPeriod; ++periodPos) {
-					int currPosition = nrPositions - periodPos;
-
-					double currValX = variedPositions.at(currPosition).first;
-					double currValY = variedPositions.at(currPosition).second;
-				
-					int attrPosX = ceil((currValX - xStart) / xStepSize + 1);
-					int attrPosY = ceil((currValY - yStart) / yStepSize + 1);
+				if(!notifyNetworkParametersChanged(network)) {
+					return;
+				}
+	
+				BasinPoint point;
+				if(!findAttractor(0, 0, networkValues, variedValX, variedValY,
+								  projectionValuesX, projectionValuesY, point)) 
+				{
+					reportProblem("BasinPlotter: Encountered empty network state.");
+					return;
+				}
 				
-					mData->set(attrNo, attrPosX, attrPosY, 2);
-
-					for(int currProj = 0; currProj < nrProjections; ++currProj) {
-						double xVal = projectionPositions.at(currPosition).first.at(currProj);
-						double yVal = projectionPositions.at(currPosition).second.at(currProj);
-
-						double pStartX = projectionRangesX.at(currProj * 2);
-						double pEndX = projectionRangesX.at(currProj * 2 + 1);
-						double pStepX = (pEndX - pStartX) / (double) (resolutionX - 1);
-						double pStartY = projectionRangesY.at(currProj * 2);
-						double pEndY = projectionRangesY.at(currProj * 2 + 1);
-						double pStepY = (pEndY - pStartY) / (double) (resolutionY - 1);
-						
-						int xPos = floor((xVal - pStartX) / pStepX + 1);
-						int yPos = floor((yVal - pStartY) / pStepY + 1);
-
-						mData->set(attrNo, xPos, yPos, 3 + currProj);
-					}
+				// at this point, either an attractor has been found
+				if(point.mFoundAttractor && mActiveValue->get()) {
+					writeAttractor(x, y, point);
 				}
 				
-				if(!attrMatch) {
-					attractors.append(networkStates.last());
+				// or not, but then there's nothing to do :D
+				
+				// runtime maintencance
+				if(core->isShuttingDown()) {
+					return;
 				}
+				core->executePendingTasks();
 			}
-			
-			// or not, but then there's nothing to do :D
-			
-			// runtime maintencance
-			if(core->isShuttingDown()) {
-				return;
-			}
-			core->executePendingTasks();
 		}
 	}
 	
@@ -490,5 +428,252 @@ void BasinPlotter::calculateData() {
 
 }
 
+
+/**
+ * Resolves the varied, projected and state elements in the network copy of the worker.
+ */
+bool BasinPlotter::prepareWorker(ParallelSweep *sweep, int worker) {
+	QList<NeuralNetworkElement*> networkElements = sweep->getNetworkElements(worker);
+	QList<Neuron*> neuronsToTransfer;
+	
+	DoubleValue *variedValX = DynamicsPlotterUtil::getElementValue(
+					mVariedX->get(), networkElements, &neuronsToTransfer);
+	DoubleValue *variedValY = DynamicsPlotterUtil::getElementValue(
+					mVariedY->get(), networkElements, &neuronsToTransfer);
+	if(variedValX == 0 || variedValY == 0) {
+		return false;
+	}
+	
+	QList< QList<DoubleValue*> > projectionValuesX;
+	QList< QList<DoubleValue*> > projectionValuesY;
+	if(!mCurrentProjectionRangesX.isEmpty()) {
+		projectionValuesX = DynamicsPlotterUtil::getElementValues(
+				DynamicsPlotterUtil::parseElementString(mProjectionsX->get()), networkElements);
+		projectionValuesY = DynamicsPlotterUtil::getElementValues(
+				DynamicsPlotterUtil::parseElementString(mProjectionsY->get()), networkElements);
+		if(projectionValuesX.size() * 2 != mCurrentProjectionRangesX.size()
+			|| projectionValuesY.size() * 2 != mCurrentProjectionRangesY.size()) 
+		{
+			return false;
+		}
+	}
+	
+	mWorkerVariedValuesX.append(variedValX);
+	mWorkerVariedValuesY.append(variedValY);
+	mWorkerNetworkValues.append(DynamicsPlotterUtil::getNetworkValues(networkElements));
+	mWorkerProjectionValuesX.append(projectionValuesX);
+	mWorkerProjectionValuesY.append(projectionValuesY);
+	mWorkerNeuronsToTransfer.append(neuronsToTransfer);
+	return true;
+}
+
+
+/**
+ * Searches the attractors of all points of a column (in a worker thread).
+ * The periods are written immediately, the attractor numbers are assigned 
+ * later in mergeColumn().
+ */
+void BasinPlotter::processColumn(ParallelSweep *sweep, int worker, int column) {
+	QVector<BasinPoint> points(mYValues.size());
+	
+	for(int y = 0; y < mYValues.size() && !sweep->isCanceled(); ++y) {
+		sweep->restoreInitialState(worker);
+		
+		mWorkerVariedValuesX.at(worker)->set(mXValues.at(column));
+		mWorkerVariedValuesY.at(worker)->set(mYValues.at(y));
+		DynamicsPlotterUtil::transferNeuronActivationToOutput(mWorkerNeuronsToTransfer.at(worker));
+		
+		if(!findAttractor(sweep, worker, mWorkerNetworkValues.at(worker), 
+						  mWorkerVariedValuesX.at(worker), mWorkerVariedValuesY.at(worker),
+						  mWorkerProjectionValuesX.at(worker), 
+						  mWorkerProjectionValuesY.at(worker), points[y])) 
+		{
+			sweep->reportProblem("BasinPlotter: Encountered empty network state.");
+			sweep->cancel();
+			return;
+		}
+	}
+	if(sweep->isCanceled()) {
+		return;
+	}
+	
+	{
+		QMutexLocker guard(mDynamicsPlotManager->getMatrixLocker());
+		for(int y = 0; y < points.size(); ++y) {
+			if(points.at(y).mFoundAttractor) {
+				mData->set(points.at(y).mPeriod, column + 1, y + 1, 1);
+			}
+		}
+	}
+	
+	QMutexLocker guard(&mColumnMutex);
+	mCompletedColumns.insert(column, points);
+}
+
+
+/**
+ * Numbers the attractors of a completed column (in the main thread, in column order).
+ */
+void BasinPlotter::mergeColumn(ParallelSweep*, int column) {
+	QVector<BasinPoint> points;
+	{
+		QMutexLocker guard(&mColumnMutex);
+		points = mCompletedColumns.take(column);
+	}
+	for(int y = 0; y < points.size(); ++y) {
+		if(points.at(y).mFoundAttractor) {
+			writeAttractor(column + 1, y + 1, points.at(y));
+		}
+	}
+}
+
+
+/**
+ * Runs the network (of the sweep worker, or the current network if sweep is 0) 
+ * and searches for an attractor. The last states of the run (one period) are
+ * stored in point.
+ *
+ * @return false if an empty network state was encountered.
+ */
+bool BasinPlotter::findAttractor(ParallelSweep *sweep, int worker, 
+						const QList<DoubleValue*> &networkValues,
+						DoubleValue *variedValX, DoubleValue *variedValY,
+						const QList< QList<DoubleValue*> > &projectionValuesX,
+						const QList< QList<DoubleValue*> > &projectionValuesY,
+						BasinPoint &point)
+{
+	int stepsRun = mStepsToRun->get();
+	int stepsCheck = mStepsToCheck->get();
+	double accuracy = mCurrentAccuracy;
+	int nrProjections = projectionValuesX.size();
+	
+	for(int runStep = 0; runStep < stepsRun && isCalculationActive(sweep); ++runStep) {
+		// let the network run for 1 timestep
+		executeNetworkStep(sweep, worker);
+	}
+	
+	QList< QList<double> > &networkStates = point.mNetworkStates;
+	QList<double> networkState;
+	
+	bool foundMatch = false;
+	int attrPeriod = 0;
+
+	for(int checkStep = 0; checkStep <= stepsCheck && !foundMatch && isCalculationActive(sweep); ++checkStep) {
+		executeNetworkStep(sweep, worker);
+		
+		// get current network state
+		networkState = DynamicsPlotterUtil::getNetworkState(networkValues);
+		
+		// abort on empty state
+		if(networkState.isEmpty()) {
+			return false;
+		}
+		
+		// compare states to find attractors
+		for(int period = 1; period <= checkStep && !foundMatch; ++period) {
+			foundMatch = DynamicsPlotterUtil::compareNetworkStates(
+					networkStates.at(checkStep-period),
+					networkState,
+					accuracy);
+			attrPeriod = period;
+		}
+		
+		// save current state as last one
+		networkStates.append(networkState);
+
+		point.mVariedPositions.append(QPair<double,double>(variedValX->get(), variedValY->get()));
+
+		if(nrProjections > 0) {
+			QPair< QList<double>, QList<double> > currentPositions;
+			currentPositions.first = DynamicsPlotterUtil::getMeanValues(projectionValuesX);
+			currentPositions.second = DynamicsPlotterUtil::getMeanValues(projectionValuesY);
+			point.mProjectionPositions.append(currentPositions);
+		}
+	}
+	
+	point.mFoundAttractor = foundMatch && isCalculationActive(sweep);
+	point.mPeriod = attrPeriod;
+	
+	//only the states of the last period are required later on.
+	if(point.mFoundAttractor) {
+		int numberOfStates = networkStates.size();
+		networkStates = networkStates.mid(numberOfStates - attrPeriod);
+		point.mVariedPositions = point.mVariedPositions.mid(numberOfStates - attrPeriod);
+		if(nrProjections > 0) {
+			point.mProjectionPositions = point.mProjectionPositions.mid(numberOfStates - attrPeriod);
+		}
+	}
+	return true;
+}
+
+
+/**
+ * Compares the attractor of a grid point with the already known attractors 
+ * and writes it to the data matrix.
+ */
+void BasinPlotter::writeAttractor(int x, int y, const BasinPoint &point) {
+	
+	const QList< QList<double> > &networkStates = point.mNetworkStates;
+	int attrPeriod = point.mPeriod;
+	int nrProjections = mCurrentProjectionRangesX.size() / 2;
+	
+	// check for past attractors
+	bool attrMatch = false;
+	int attrNo = 1;
+	while(attrNo <= mAttractors.size() && !attrMatch) {
+		for(int state = 1; state <= attrPeriod && !attrMatch; ++state) {
+			attrMatch = DynamicsPlotterUtil::compareNetworkStates(
+					mAttractors.at(attrNo-1),
+					networkStates.at(networkStates.size()-state),
+						// was: size()-1-state
+					mCurrentAccuracy);
+		}
+		attrNo++;
+	}
+	
+	
+	//Thread safety of matrix.
+	QMutexLocker guard(mDynamicsPlotManager->getMatrixLocker());
+	
+	// write matrix
+	mData->set(attrNo, x, y, 0);
+	mData->set(attrPeriod, x, y, 1);
+
+	// calculate and plot attractor position
+	int nrPositions = point.mVariedPositions.size();
+	for(int periodPos = 1; periodPos <= attrPeriod; ++periodPos) {
+		int currPosition = nrPositions - periodPos;
+
+		double currValX = point.mVariedPositions.at(currPosition).first;
+		double currValY = point.mVariedPositions.at(currPosition).second;
+	
+		int attrPosX = ceil((currValX - mXStart) / mXStepSize + 1);
+		int attrPosY = ceil((currValY - mYStart) / mYStepSize + 1);
+	
+		mData->set(attrNo, attrPosX, attrPosY, 2);
+
+		for(int currProj = 0; currProj < nrProjections; ++currProj) {
+			double xVal = point.mProjectionPositions.at(currPosition).first.at(currProj);
+			double yVal = point.mProjectionPositions.at(currPosition).second.at(currProj);
+
+			double pStartX = mCurrentProjectionRangesX.at(currProj * 2);
+			double pEndX = mCurrentProjectionRangesX.at(currProj * 2 + 1);
+			double pStepX = (pEndX - pStartX) / (double) (mCurrentResolutionX - 1);
+			double pStartY = mCurrentProjectionRangesY.at(currProj * 2);
+			double pEndY = mCurrentProjectionRangesY.at(currProj * 2 + 1);
+			double pStepY = (pEndY - pStartY) / (double) (mCurrentResolutionY - 1);
+			
+			int xPos = floor((xVal - pStartX) / pStepX + 1);
+			int yPos = floor((yVal - pStartY) / pStepY + 1);
+
+			mData->set(attrNo, xPos, yPos, 3 + currProj);
+		}
+	}
+	
+	if(!attrMatch) {
+		mAttractors.append(networkStates.last());
+	}
+}
+
 }
 
@@ -46,10 +46,28 @@
 #define BASINPLOTTER_H
 
 #include "DynamicsPlot/DynamicsPlotter.h"
+#include "DynamicsPlot/ParallelSweepKernel.h"
+#include <QPair>
+#include <QHash>
+#include <QVector>
+#include <QMutex>
 
 namespace nerd {
 	
-	class BasinPlotter : public DynamicsPlotter {
+	/**
+	 * The attractor reached from a single parameter point.
+	 */
+	struct BasinPoint {
+		BasinPoint() : mFoundAttractor(false), mPeriod(0) {}
+
+		bool mFoundAttractor;
+		int mPeriod;
+		QList< QList<double> > mNetworkStates;
+		QList< QPair<double,double> > mVariedPositions;
+		QList< QPair< QList<double>, QList<double> > > mProjectionPositions;
+	};
+	
+	class BasinPlotter : public DynamicsPlotter, public ParallelSweepKernel {
 
 	public:
 		BasinPlotter();
@@ -57,6 +75,19 @@ namespace nerd {
 		
 		virtual void calculateData();
 
+		virtual bool prepareWorker(ParallelSweep *sweep, int worker);
+		virtual void processColumn(ParallelSweep *sweep, int worker, int column);
+		virtual void mergeColumn(ParallelSweep *sweep, int column);
+
+	private:
+		bool findAttractor(ParallelSweep *sweep, int worker, 
+						   const QList<DoubleValue*> &networkValues,
+						   DoubleValue *variedValX, DoubleValue *variedValY,
+						   const QList< QList<DoubleValue*> > &projectionValuesX,
+						   const QList< QList<DoubleValue*> > &projectionValuesY,
+						   BasinPoint &point);
+		void writeAttractor(int x, int y, const BasinPoint &point);
+
 	private:
 
 		StringValue *mVariedX;
@@ -80,6 +111,28 @@ namespace nerd {
 		BoolValue *mResetNetworkActivation;
 		BoolValue *mRestoreNetworkConfiguration;
 		BoolValue *mResetSimulator;
+
+		double mXStart;
+		double mXStepSize;
+		double mYStart;
+		double mYStepSize;
+		int mCurrentResolutionX;
+		int mCurrentResolutionY;
+		double mCurrentAccuracy;
+		QList<double> mCurrentProjectionRangesX;
+		QList<double> mCurrentProjectionRangesY;
+		QList< QList<double> > mAttractors;
+
+		QList<double> mXValues;
+		QList<double> mYValues;
+		QList<DoubleValue*> mWorkerVariedValuesX;
+		QList<DoubleValue*> mWorkerVariedValuesY;
+		QList<QList<DoubleValue*> > mWorkerNetworkValues;
+		QList<QList< QList<DoubleValue*> > > mWorkerProjectionValuesX;
+		QList<QList< QList<DoubleValue*> > > mWorkerProjectionValuesY;
+		QList<QList<Neuron*> > mWorkerNeuronsToTransfer;
+		QMutex mColumnMutex;
+		QHash<int, QVector<BasinPoint> > mCompletedColumns;
 	};
 }
 
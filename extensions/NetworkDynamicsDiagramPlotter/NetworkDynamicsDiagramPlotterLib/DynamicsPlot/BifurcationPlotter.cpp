@@ -49,12 +49,15 @@
 #include <Math/Math.h>
 #include <iostream>
 #include "DynamicsPlotManager.h"
+#include "DynamicsPlot/ParallelSweep.h"
 
 using namespace std;
 
 namespace nerd {
 
-BifurcationPlotter::BifurcationPlotter() : DynamicsPlotter("Bifurcation") {
+BifurcationPlotter::BifurcationPlotter() 
+	: DynamicsPlotter("Bifurcation"), mCurrentResolutionY(0) 
+{
 	// initialising
 	mObservedElements = new StringValue("0");
 	mObservedElements->setDescription("Elements to observe, syntax "
@@ -252,93 +255,113 @@ void BifurcationPlotter::calculateData() {
 
 	// MAIN LOOP over parameter points
 
-	//check if the diagram also has to be drawn in backwards mode.
-
-	// two runs if backward calculation is on
-	for(int phase = 0; phase <= runSecondIteration; ++phase) {
-
-		restoreCurrentNetworkActivites();
+	if(canUseParallelSweep(network) && !resetSimulation && restoreNetConfiguration
+		&& resetNetworkActivation)
+	{
+		//all parameter points are independent: distribute the columns over several threads.
+		//the backwards run is treated as a second set of columns.
 		restoreNetworkConfiguration();
-
-		for(int x = 1; x <= vVals.size() && mActiveValue->get(); ++x) {
-
-			mProgressPercentage->set((double)(100*x/resolutionX));;
-
-			if(resetSimulation) {
-				triggerReset();
-			}
-
-			if(restoreNetConfiguration) {
-				restoreNetworkConfiguration();
-			}
-
-			if(resetNetworkActivation) {
-				restoreCurrentNetworkActivites();
-			}
-
-			//switch between forwards and backwards movement
-			if(phase == 0) {
-                variedValue->set(vVals.at(x-1)); // set actual value
-			} else {
-                variedValue->set(vVals.at(resolutionX-x));
-			}
-
-
-			// INNER LOOP over steps
-			for(int j = 0; j < numberSteps && mActiveValue->get(); ++j) {
-				// let the network run for 1 timestep
-				triggerNetworkStep();
-			}
-
-			// plotting steps
-			for(int j = 0; j < plottedSteps; ++j) {
-                triggerNetworkStep();
-
-                // Calculate average neuron activation
-                for(int i = 0; i < observedValuesList.size(); ++i) {
-
-                    QList<DoubleValue*> observedValues =
-                                                observedValuesList.at(i);
-                    int oSize = observedValues.size();
-                    if(oSize == 0) {
-                        reportProblem("BifurcationPlotter: Observed Values Size was 0!");
-                        continue;
-                    }
-
-                    double oStart = oParams.at(i).at(0);
-                    double oEnd = oParams.at(i).at(1);
-                    double act = DynamicsPlotterUtil::getMeanValue(observedValues);
-
-                    //Thread safety of matrix.
-                    {
-                        QMutexLocker guard(mDynamicsPlotManager->getMatrixLocker());
-
-                        int posX = (phase == 0) ? x :
-                                    mData->getMatrixWidth() - x;
-
-                        if(act < oStart) {
-                            //Indivate that a value is out of bound (mark with 2)
-                            mData->set(2, posX, 1, i);
-                        }
-                        else if(act > oEnd) {
-                            //Indicate that a value is out of bound (mark with 2)
-                            mData->set(2, posX, resolutionY, i);
-                        }
-                        else {
-                            double oStepSize = oParams.at(i).at(2);
-                            int y = ceil((act - oStart)/oStepSize);
-
-                            mData->set(1, posX, y, i);
-                        }
-                    }
-                }
-            }
-
-			// runtime maintencance
-			if(core->isShuttingDown()) {
-				return;
+		restoreCurrentNetworkActivites();
+		
+		mVariedValues = vVals;
+		mObservedParameters = oParams;
+		mCurrentResolutionY = resolutionY;
+		mWorkerVariedValues.clear();
+		mWorkerObservedValues.clear();
+		
+		ParallelSweep sweep(network, mNumberOfThreads->get());
+		sweep.execute(resolutionX * (runSecondIteration + 1), this, 
+					  mActiveValue, mProgressPercentage);
+	}
+	else {
+		//check if the diagram also has to be drawn in backwards mode.
+
+		// two runs if backward calculation is on
+		for(int phase = 0; phase <= runSecondIteration; ++phase) {
+
+			restoreCurrentNetworkActivites();
+			restoreNetworkConfiguration();
+
+			for(int x = 1; x <= vVals.size() && mActiveValue->get(); ++x) {
+
+				mProgressPercentage->set((double)(100*x/resolutionX));;
+
+				if(resetSimulation) {
+					triggerReset();
+				}
+
+				if(restoreNetConfiguration) {
+					restoreNetworkConfiguration();
+				}
+
+				if(resetNetworkActivation) {
+					restoreCurrentNetworkActivites();
+				}
+
+				//switch between forwards and backwards movement
+				if(phase == 0) {
+	                variedValue->set(vVals.at(x-1)); // set actual value
+				} else {
+	                variedValue->set(vVals.at(resolutionX-x));
+				}
+
+
+				// INNER LOOP over steps
+				for(int j = 0; j < numberSteps && mActiveValue->get(); ++j) {
+					// let the network run for 1 timestep
+					triggerNetworkStep();
+				}
+
+				// plotting steps
+				for(int j = 0; j < plottedSteps; ++j) {
+	                triggerNetworkStep();
+
+	                // Calculate average neuron activation
+	                for(int i = 0; i < observedValuesList.size(); ++i) {
+
+	                    QList<DoubleValue*> observedValues =
+	                                                observedValuesList.at(i);
+	                    int oSize = observedValues.size();
+	                    if(oSize == 0) {
+	                        reportProblem("BifurcationPlotter: Observed Values Size was 0!");
+	                        continue;
+	                    }
+
+	                    double oStart = oParams.at(i).at(0);
+	                    double oEnd = oParams.at(i).at(1);
+	                    double act = DynamicsPlotterUtil::getMeanValue(observedValues);
+
+	                    //Thread safety of matrix.
+	                    {
+	                        QMutexLocker guard(mDynamicsPlotManager->getMatrixLocker());
+
+	                        int posX = (phase == 0) ? x :
+	                                    mData->getMatrixWidth() - x;
+
+	                        if(act < oStart) {
+	                            //Indivate that a value is out of bound (mark with 2)
+	                            mData->set(2, posX, 1, i);
+	                        }
+	                        else if(act > oEnd) {
+	                            //Indicate that a value is out of bound (mark with 2)
+	                            mData->set(2, posX, resolutionY, i);
+	                        }
+	                        else {
+	                            double oStepSize = oParams.at(i).at(2);
+	                            int y = ceil((act - oStart)/oStepSize);
+
+	                            mData->set(1, posX, y, i);
+	                        }
+	                    }
+	                }
+	            }
+
+				// runtime maintencance
+				if(core->isShuttingDown()) {
+					return;
+				}
+				core->executePendingTasks();
 			}
-			core->executePendingTasks();
 		}
 	}
 
@@ -352,5 +375,94 @@ void BifurcationPlotter::calculateData() {
 
 }
 
+
+
+/**
+ * Resolves the varied and observed elements in the network copy of the worker.
+ */
+bool BifurcationPlotter::prepareWorker(ParallelSweep *sweep, int worker) {
+	QList<NeuralNetworkElement*> networkElements = sweep->getNetworkElements(worker);
+	QList<Neuron*> neuronsToTransfer;
+	
+	DoubleValue *variedValue = DynamicsPlotterUtil::getElementValue(
+					mVariedElement->get(), networkElements, &neuronsToTransfer);
+	QList< QList<DoubleValue*> > observedValuesList = DynamicsPlotterUtil::getElementValues(
+			DynamicsPlotterUtil::parseElementString(mObservedElements->get()), networkElements);
+	
+	if(variedValue == 0 || observedValuesList.size() != mObservedParameters.size()) {
+		return false;
+	}
+	mWorkerVariedValues.append(variedValue);
+	mWorkerObservedValues.append(observedValuesList);
+	return true;
+}
+
+
+/**
+ * Runs the network for one parameter point (in a worker thread).
+ * Columns >= resolution belong to the backwards run.
+ */
+void BifurcationPlotter::processColumn(ParallelSweep *sweep, int worker, int column) {
+	int resolutionX = mVariedValues.size();
+	int phase = column / resolutionX;
+	int x = (column % resolutionX) + 1;
+	
+	int numberSteps = mStepsToRun->get();
+	int plottedSteps = mStepsToPlot->get();
+	const QList< QList<DoubleValue*> > &observedValuesList = mWorkerObservedValues.at(worker);
+	
+	sweep->restoreInitialState(worker);
+	
+	//switch between forwards and backwards movement
+	if(phase == 0) {
+		mWorkerVariedValues.at(worker)->set(mVariedValues.at(x-1));
+	} else {
+		mWorkerVariedValues.at(worker)->set(mVariedValues.at(resolutionX-x));
+	}
+	
+	for(int j = 0; j < numberSteps && !sweep->isCanceled(); ++j) {
+		sweep->executeNetworkStep(worker);
+	}
+	
+	//collect the marks of the column: (y, observed element, mark)
+	QList<int> marks;
+	for(int j = 0; j < plottedSteps && !sweep->isCanceled(); ++j) {
+		sweep->executeNetworkStep(worker);
+		
+		for(int i = 0; i < observedValuesList.size(); ++i) {
+			const QList<DoubleValue*> &observedValues = observedValuesList.at(i);
+			if(observedValues.empty()) {
+				sweep->reportProblem("BifurcationPlotter: Observed Values Size was 0!");
+				continue;
+			}
+			double oStart = mObservedParameters.at(i).at(0);
+			double oEnd = mObservedParameters.at(i).at(1);
+			double act = DynamicsPlotterUtil::getMeanValue(observedValues);
+			
+			if(act < oStart) {
+				//Indicate that a value is out of bound (mark with 2)
+				marks << 1 << i << 2;
+			}
+			else if(act > oEnd) {
+				//Indicate that a value is out of bound (mark with 2)
+				marks << mCurrentResolutionY << i << 2;
+			}
+			else {
+				double oStepSize = mObservedParameters.at(i).at(2);
+				marks << (int) ceil((act - oStart) / oStepSize) << i << 1;
+			}
+		}
+	}
+	if(sweep->isCanceled()) {
+		return;
+	}
+	
+	QMutexLocker guard(mDynamicsPlotManager->getMatrixLocker());
+	int posX = (phase == 0) ? x : mData->getMatrixWidth() - x;
+	for(int i = 0; i + 2 < marks.size(); i += 3) {
+		mData->set(marks.at(i + 2), posX, marks.at(i), marks.at(i + 1));
+	}
+}
+
 }
 
@@ -46,9 +46,10 @@
 #define BIFURCATIONPLOTTER_H
 
 #include "DynamicsPlot/DynamicsPlotter.h"
+#include "DynamicsPlot/ParallelSweepKernel.h"
 
 namespace nerd {
-	class BifurcationPlotter : public DynamicsPlotter {
+	class BifurcationPlotter : public DynamicsPlotter, public ParallelSweepKernel {
 
 	public:
 		BifurcationPlotter();
@@ -56,6 +57,9 @@ namespace nerd {
 		
 		virtual void calculateData();
 
+		virtual bool prepareWorker(ParallelSweep *sweep, int worker);
+		virtual void processColumn(ParallelSweep *sweep, int worker, int column);
+
 	private:
 		StringValue *mObservedElements;
 		StringValue *mObservedRanges;
@@ -72,6 +76,12 @@ namespace nerd {
 		BoolValue *mRunBackwards;
 		BoolValue *mRestoreNetworkConfiguration;
 		BoolValue *mResetSimulator;
+
+		QList<double> mVariedValues;
+		QList< QList<double> > mObservedParameters;
+		int mCurrentResolutionY;
+		QList<DoubleValue*> mWorkerVariedValues;
+		QList< QList< QList<DoubleValue*> > > mWorkerObservedValues;
 	};
 }
 
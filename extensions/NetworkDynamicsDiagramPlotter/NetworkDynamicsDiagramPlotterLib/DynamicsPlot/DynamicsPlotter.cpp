@@ -59,6 +59,7 @@
 #include "Value/ULongLongValue.h"
 #include <Math/Math.h>
 #include <QTime>
+#include <QThread>
 #include "Network/NeuralNetworkManager.h"
 #include "Network/Neuro.h"
 #include <QStringList>
@@ -66,6 +67,7 @@
 #include "NetworkEditorConstants.h"
 #include <Util/DynamicsPlotterUtil.h>
 #include "DynamicsPlotManager.h"
+#include "DynamicsPlot/ParallelSweep.h"
 
 
 using namespace std;
@@ -114,6 +116,10 @@ DynamicsPlotter::DynamicsPlotter(const QString &name)
 	mActiveValue = new BoolValue(false);
 	mExecutionTime = new IntValue(0);
 	mProgressPercentage = new DoubleValue(0);
+	mNumberOfThreads = new IntValue(qMax(1, QThread::idealThreadCount()));
+	mNumberOfThreads->setDescription("Number of threads used to calculate the parameter grid "
+						"of a diagram (if supported by the diagram). "
+						"With 1 the network is executed in the main thread.");
 	mEnableConstraints = new BoolValue(false);
 
 	mData = new MatrixValue(); //data matrix
@@ -136,6 +142,7 @@ DynamicsPlotter::DynamicsPlotter(const QString &name)
 	addParameter("Config/Activate", mActiveValue, true);
 	addParameter("Performance/ExecutionTime", mExecutionTime, true);
 	addParameter("Performance/ProgressPercentage", mProgressPercentage, true);
+	addParameter("Performance/NumberOfThreads", mNumberOfThreads, true);
 	addParameter("Config/EnableConstraints", mEnableConstraints, true);
 	
 	addParameter("Internal/Data", mData, true);
@@ -370,50 +377,7 @@ void DynamicsPlotter::storeNetworkConfiguration() {
 	if(network == 0) {
 		return;
 	}
-	mNetworkConfigurationValues.clear();
-
-	QList<Neuron*> neurons = network->getNeurons();
-	for(QListIterator<Neuron*> i(neurons); i.hasNext();) {
-		Neuron *neuron = i.next();
-		
-		mNetworkConfigurationValues.insert(&neuron->getBiasValue(), neuron->getBiasValue().get());
-		
-		QList<Value*> observables;
-		
-		{
-			TransferFunction *tf = neuron->getTransferFunction();
-			if(tf != 0) {
-				observables << tf->getObservableOutputs();
-			}
-		}
-		{
-			ActivationFunction *af = neuron->getActivationFunction();
-			if(af != 0) {
-				observables << af->getObservableOutputs();
-			}
-		}
-		
-		QList<Synapse*> synapses = neuron->getSynapses();
-		for(QListIterator<Synapse*> j(synapses); j.hasNext();) {
-			Synapse *synapse = j.next();
-			
-			mNetworkConfigurationValues.insert(&synapse->getStrengthValue(),
-								synapse->getStrengthValue().get());
-			
-			SynapseFunction *sf = synapse->getSynapseFunction();
-			if(sf != 0) {
-				observables << sf->getObservableOutputs();
-			}
-		}
-		
-		 
-		for(QListIterator<Value*> j(observables); j.hasNext();) {
-			DoubleValue *value = dynamic_cast<DoubleValue*>(j.next());
-			if(value != 0) {
-				mNetworkConfigurationValues.insert(value, value->get());
-			}
-		}
-	}
+	mNetworkConfigurationValues = DynamicsPlotterUtil::getNetworkConfiguration(network);
 }
 
 
@@ -455,6 +419,43 @@ void DynamicsPlotter::triggerReset() {
 	}
 }
 
+/**
+ * Returns true if the parameter grid may be calculated with a ParallelSweep. 
+ * This requires more than one thread and a network that is not coupled to 
+ * a physical simulation via a control interface. Each diagram has to check
+ * additionally, whether its grid points can be calculated independently.
+ */
+bool DynamicsPlotter::canUseParallelSweep(ModularNeuralNetwork *network) const {
+	return mNumberOfThreads->get() > 1 && network != 0 
+			&& network->getControlInterface() == 0;
+}
+
+/**
+ * Executes a network step. If sweep is 0, then the step is triggered for the current 
+ * network via the NextStep event. Otherwise only the network of the given sweep 
+ * worker is executed.
+ */
+void DynamicsPlotter::executeNetworkStep(ParallelSweep *sweep, int worker) {
+	if(sweep == 0) {
+		triggerNetworkStep();
+	}
+	else {
+		sweep->executeNetworkStep(worker);
+	}
+}
+
+
+/**
+ * Returns false if the calculation (or the given sweep) was stopped.
+ */
+bool DynamicsPlotter::isCalculationActive(ParallelSweep *sweep) const {
+	if(sweep == 0) {
+		return mActiveValue->get();
+	}
+	return !sweep->isCanceled();
+}
+
+
 bool DynamicsPlotter::notifyNetworkParametersChanged(ModularNeuralNetwork *network) {
 	
 	if(network == 0) {
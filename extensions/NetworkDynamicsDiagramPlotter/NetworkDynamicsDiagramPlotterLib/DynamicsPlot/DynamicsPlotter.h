@@ -64,6 +64,7 @@
 namespace nerd {
 
 	class DynamicsPlotManager;
+	class ParallelSweep;
 	
 	/**
 	 * DynamicsPlotter.
@@ -103,6 +104,9 @@ namespace nerd {
 		virtual void triggerNetworkStep();
 		virtual void triggerReset();
 		virtual bool notifyNetworkParametersChanged(ModularNeuralNetwork *network);
+		virtual bool canUseParallelSweep(ModularNeuralNetwork *network) const;
+		void executeNetworkStep(ParallelSweep *sweep, int worker);
+		bool isCalculationActive(ParallelSweep *sweep) const;
 		
 	protected:
 		Event *mNextStepEvent;
@@ -115,6 +119,7 @@ namespace nerd {
 		BoolValue *mActiveValue;
 		IntValue *mExecutionTime;
 		DoubleValue *mProgressPercentage;
+		IntValue *mNumberOfThreads;
 		BoolValue *mEnableConstraints;
 		bool mEnableConstraintsInCurrentRun;
 		QList<double> mNetworkActivities;
@@ -44,6 +44,7 @@
 
 #include "IsoperiodPlotter.h"
 #include "DynamicsPlotManager.h"
+#include "DynamicsPlot/ParallelSweep.h"
 #include <Util/DynamicsPlotterUtil.h>
 #include "Core/Core.h"
 #include "math.h"
@@ -239,90 +240,77 @@ void IsoperiodPlotter::calculateData() {
 	}
 
 	// MAIN LOOP over x parameter points
+	
+	if(canUseParallelSweep(network) && !resetSimulation && restoreNetConfiguration
+		&& resetNetworkActivation && !mEnableConstraintsInCurrentRun)
+	{
+		//all grid points are independent: distribute the columns over several threads.
+		restoreNetworkConfiguration();
+		restoreCurrentNetworkActivites();
 		
-	int stepsRun = mStepsToRun->get();
-	int stepsCheck = mStepsToCheck->get();
-	double accuracy = mAccuracy->get();
+		mXValues = xValues;
+		mYValues = yValues;
+		mWorkerVariedValuesX.clear();
+		mWorkerVariedValuesY.clear();
+		mWorkerNetworkValues.clear();
+		mWorkerNeuronsToTransfer.clear();
+		
+		ParallelSweep sweep(network, mNumberOfThreads->get());
+		sweep.execute(resolutionX, this, mActiveValue, mProgressPercentage);
+	}
+	else {
+		for(int x = 1; x <= resolutionX && mActiveValue->get(); ++x) {
+				
+			mProgressPercentage->set((double)(100*x/resolutionX));
 	
-	for(int x = 1; x <= resolutionX && mActiveValue->get(); ++x) {
-			
-		mProgressPercentage->set((double)(100*x/resolutionX));
-
-		// INNER LOOP over y parameter points
-		for(int y = 1; y <= resolutionY && mActiveValue->get(); ++y) {
-			
-			if(resetSimulation) {
-				triggerReset();
-			}
-			
-			if(restoreNetConfiguration) {
-				restoreNetworkConfiguration();
-			}
-			
-			if(resetNetworkActivation) {
-				restoreCurrentNetworkActivites();
-			}
-			
-			// set x parameter
-			variedValX->set(xValues.at(x-1));
-			// set y parameter
-			variedValY->set(yValues.at(y-1));
-			
-			if(!notifyNetworkParametersChanged(network)) {
-				return;
-			}
-
-			for(int j=1; j < stepsRun-stepsCheck && mActiveValue->get(); ++j) {
-				// let the network run for 1 timestep
-				triggerNetworkStep();
-			}
-			
-			QList< QList<double> > states;
-			bool foundMatch = false;
-			int currPeriod = 0;
-			for(int k = 0; k <= stepsCheck && !foundMatch && mActiveValue->get();
-				++k) {
-				triggerNetworkStep();
+			// INNER LOOP over y parameter points
+			for(int y = 1; y <= resolutionY && mActiveValue->get(); ++y) {
+				
+				if(resetSimulation) {
+					triggerReset();
+				}
+				
+				if(restoreNetConfiguration) {
+					restoreNetworkConfiguration();
+				}
+				
+				if(resetNetworkActivation) {
+					restoreCurrentNetworkActivites();
+				}
 				
-				// get current network state
-				QList<double> networkState = 
-						DynamicsPlotterUtil::getNetworkState(networkValues);
+				// set x parameter
+				variedValX->set(xValues.at(x-1));
+				// set y parameter
+				variedValY->set(yValues.at(y-1));
 				
-				// abort on empty state
-				if(networkState.isEmpty()) {
+				if(!notifyNetworkParametersChanged(network)) {
+					return;
+				}
+	
+				bool ok = true;
+				int currPeriod = findPeriod(0, 0, networkValues, ok);
+				if(!ok) {
 					reportProblem("IsoperiodPlotter: Encountered empty "
 								"network state. Something went wrong.");
 					return;
 				}
 				
-				// compare states to find attractors
-				for(int i = 1; i <= k && !foundMatch; ++i) {
-					foundMatch = DynamicsPlotterUtil::
-						compareNetworkStates(states.at(k-i),
-						networkState,
-						accuracy);
-					currPeriod = i;
+				// at this point, either an attractor has been found
+				if(currPeriod > 0 && mActiveValue->get()) {
+					
+					QMutexLocker guard(mDynamicsPlotManager->getMatrixLocker());
+					
+					// write matrix
+					mData->set(currPeriod, x, y, 0);
 				}
+				// or not, but then there's nothing to do :D
 				
-				// save current state as last one
-				states.append(networkState);
-			}
-			
-			// at this point, either an attractor has been found
-			if(foundMatch && mActiveValue->get()) {
-				
-				QMutexLocker guard(mDynamicsPlotManager->getMatrixLocker());
-				
-				// write matrix
-				mData->set(currPeriod, x, y, 0);
-			}
-			// or not, but then there's nothing to do :D
-			
-			// runtime maintencance
-			if(core->isShuttingDown()) {
-				return;
+				// runtime maintencance
+				if(core->isShuttingDown()) {
+					return;
+				}
+				core->executePendingTasks();
 			}
-			core->executePendingTasks();
 		}
 	}
 	
@@ -337,5 +325,116 @@ void IsoperiodPlotter::calculateData() {
 
 }
 
+
+
+/**
+ * Resolves the varied elements and the network state values in the network copy of the worker.
+ */
+bool IsoperiodPlotter::prepareWorker(ParallelSweep *sweep, int worker) {
+	QList<NeuralNetworkElement*> networkElements = sweep->getNetworkElements(worker);
+	QList<Neuron*> neuronsToTransfer;
+	
+	DoubleValue *variedValX = DynamicsPlotterUtil::getElementValue(
+					mVariedX->get(), networkElements, &neuronsToTransfer);
+	DoubleValue *variedValY = DynamicsPlotterUtil::getElementValue(
+					mVariedY->get(), networkElements, &neuronsToTransfer);
+	if(variedValX == 0 || variedValY == 0) {
+		return false;
+	}
+	mWorkerVariedValuesX.append(variedValX);
+	mWorkerVariedValuesY.append(variedValY);
+	mWorkerNetworkValues.append(DynamicsPlotterUtil::getNetworkValues(networkElements));
+	mWorkerNeuronsToTransfer.append(neuronsToTransfer);
+	return true;
 }
 
+
+/**
+ * Calculates the periods of all points of a column (in a worker thread).
+ */
+void IsoperiodPlotter::processColumn(ParallelSweep *sweep, int worker, int column) {
+	QVector<int> periods(mYValues.size(), 0);
+	
+	for(int y = 0; y < mYValues.size() && !sweep->isCanceled(); ++y) {
+		sweep->restoreInitialState(worker);
+		
+		mWorkerVariedValuesX.at(worker)->set(mXValues.at(column));
+		mWorkerVariedValuesY.at(worker)->set(mYValues.at(y));
+		DynamicsPlotterUtil::transferNeuronActivationToOutput(mWorkerNeuronsToTransfer.at(worker));
+		
+		bool ok = true;
+		periods[y] = findPeriod(sweep, worker, mWorkerNetworkValues.at(worker), ok);
+		if(!ok) {
+			sweep->reportProblem("IsoperiodPlotter: Encountered empty "
+								"network state. Something went wrong.");
+			sweep->cancel();
+			return;
+		}
+	}
+	if(sweep->isCanceled()) {
+		return;
+	}
+	
+	//write the column as a whole
+	QMutexLocker guard(mDynamicsPlotManager->getMatrixLocker());
+	for(int y = 0; y < periods.size(); ++y) {
+		if(periods.at(y) > 0) {
+			mData->set(periods.at(y), column + 1, y + 1, 0);
+		}
+	}
+}
+
+
+/**
+ * Runs the network (of the sweep worker, or the current network if sweep is 0) 
+ * and returns the period of the reached attractor, or 0 if no attractor was found.
+ * ok is set to false if an empty network state was encountered.
+ */
+int IsoperiodPlotter::findPeriod(ParallelSweep *sweep, int worker, 
+								const QList<DoubleValue*> &networkValues, bool &ok)
+{
+	int stepsRun = mStepsToRun->get();
+	int stepsCheck = mStepsToCheck->get();
+	double accuracy = mAccuracy->get();
+	
+	for(int j=1; j < stepsRun-stepsCheck && isCalculationActive(sweep); ++j) {
+		// let the network run for 1 timestep
+		executeNetworkStep(sweep, worker);
+	}
+	
+	QList< QList<double> > states;
+	bool foundMatch = false;
+	int currPeriod = 0;
+	for(int k = 0; k <= stepsCheck && !foundMatch && isCalculationActive(sweep);
+		++k) {
+		executeNetworkStep(sweep, worker);
+		
+		// get current network state
+		QList<double> networkState = 
+				DynamicsPlotterUtil::getNetworkState(networkValues);
+		
+		// abort on empty state
+		if(networkState.isEmpty()) {
+			ok = false;
+			return 0;
+		}
+		
+		// compare states to find attractors
+		for(int i = 1; i <= k && !foundMatch; ++i) {
+			foundMatch = DynamicsPlotterUtil::
+				compareNetworkStates(states.at(k-i),
+				networkState,
+				accuracy);
+			currPeriod = i;
+		}
+		
+		// save current state as last one
+		states.append(networkState);
+	}
+	if(!foundMatch) {
+		return 0;
+	}
+	return currPeriod;
+}
+
+}
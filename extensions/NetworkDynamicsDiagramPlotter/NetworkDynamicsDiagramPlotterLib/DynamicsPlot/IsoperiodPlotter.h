@@ -46,10 +46,11 @@
 #define ISOPERIODPLOTTER_H
 
 #include "DynamicsPlot/DynamicsPlotter.h"
+#include "DynamicsPlot/ParallelSweepKernel.h"
 
 namespace nerd {
 	
-	class IsoperiodPlotter : public DynamicsPlotter {
+	class IsoperiodPlotter : public DynamicsPlotter, public ParallelSweepKernel {
 
 	public:
 		IsoperiodPlotter();
@@ -57,6 +58,13 @@ namespace nerd {
 		
 		virtual void calculateData();
 
+		virtual bool prepareWorker(ParallelSweep *sweep, int worker);
+		virtual void processColumn(ParallelSweep *sweep, int worker, int column);
+
+	private:
+		int findPeriod(ParallelSweep *sweep, int worker, 
+					   const QList<DoubleValue*> &networkValues, bool &ok);
+
 	private:
 
 		StringValue *mVariedX;
@@ -75,6 +83,13 @@ namespace nerd {
 		BoolValue *mResetNetworkActivation;
 		BoolValue *mRestoreNetworkConfiguration;
 		BoolValue *mResetSimulator;
+
+		QList<double> mXValues;
+		QList<double> mYValues;
+		QList<DoubleValue*> mWorkerVariedValuesX;
+		QList<DoubleValue*> mWorkerVariedValuesY;
+		QList<QList<DoubleValue*> > mWorkerNetworkValues;
+		QList<QList<Neuron*> > mWorkerNeuronsToTransfer;
 	};
 }
 
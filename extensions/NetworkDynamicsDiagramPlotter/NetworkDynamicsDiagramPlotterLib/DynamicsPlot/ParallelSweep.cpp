@@ -0,0 +1,354 @@
+/***************************************************************************
+ *   NERD - Neurodynamics and Evolutionary Robotics Development Toolkit    *
+ *                                                                         *
+ *   University of Osnabrueck, Germany                                     *
+ *   Institute of Cognitive Science                                        *
+ *   Neurocybernetics Group                                                *
+ *   http://www.ikw.uni-osnabrueck.de/~neurokybernetik/                    *
+ *                                                                         *
+ *   Project homepage: nerd.x-bot.org                                      *
+ *                                                                         *
+ *   Copyright (C) 2008 - 2013 by the Neurocybernetics Group Osnabrück     *
+ *   Contact: Christian Rempis                                             *
+ *   christian.rempis@uni-osnabrueck.de                                    *
+ *   Contributors: see contributors.txt in the nerd main directory.        *
+ *                                                                         *
+ *                                                                         *
+ *   Acknowledgments:                                                      *
+ *   The NERD Toolkit is part of the EU project ALEAR                      *
+ *   (Artificial Language Evolution on Autonomous Robots) www.ALEAR.eu     *
+ *   This work was funded (2008 - 2011) by EU-Project Number ICT 214856    *
+ *                                                                         *
+ *                                                                         *
+ *   License Agreement:                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ *                                                                         *
+ *   Publications based on work using the NERD kit have to state this      *
+ *   clearly by citing the NERD homepage and the NERD overview paper.      *  
+ ***************************************************************************/
+
+
+
+#include "ParallelSweep.h"
+#include "Core/Core.h"
+#include "Network/Neuro.h"
+#include "Network/NeuralNetworkManager.h"
+#include "Util/DynamicsPlotterUtil.h"
+#include <QMutexLocker>
+#include <iostream>
+
+using namespace std;
+
+namespace nerd {
+
+
+ParallelSweepWorker::ParallelSweepWorker(ParallelSweep *sweep, int index)
+	: QThread(0), mSweep(sweep), mIndex(index)
+{
+	Core::getInstance()->registerThread(this);
+}
+
+ParallelSweepWorker::~ParallelSweepWorker() {
+	Core::getInstance()->deregisterThread(this);
+}
+
+void ParallelSweepWorker::run() {
+	mSweep->runWorker(mIndex);
+}
+
+
+
+/**
+ * Creates a new ParallelSweep with numberOfWorkers copies of the given network.
+ * The copies (and their initial states used by restoreInitialState()) reflect the 
+ * state of the network at construction time. 
+ */
+ParallelSweep::ParallelSweep(ModularNeuralNetwork *network, int numberOfWorkers)
+	: mKernel(0), mNumberOfUpdatesPerStep(1), mNetworkUpdateDisabled(false),
+	  mNumberOfCompletedColumns(0), mNumberOfFinishedWorkers(0), mCanceled(0)
+{
+	NeuralNetworkManager *nnm = Neuro::getNeuralNetworkManager();
+	if(nnm != 0) {
+		mNumberOfUpdatesPerStep = nnm->getNumberOfUpdatesPerStepValue()->get();
+		mNetworkUpdateDisabled = nnm->getDisableNetworkUpdateValue()->get();
+	}
+
+	for(int i = 0; network != 0 && i < numberOfWorkers; ++i) {
+		ModularNeuralNetwork *copy = dynamic_cast<ModularNeuralNetwork*>(network->createCopy());
+		if(copy == 0) {
+			break;
+		}
+		mNetworks.append(copy);
+		mConfigurations.append(DynamicsPlotterUtil::getNetworkConfiguration(copy));
+
+		QList<Neuron*> neurons = copy->getNeurons();
+		QList<double> activations;
+		QList<double> outputs;
+		for(QListIterator<Neuron*> j(neurons); j.hasNext();) {
+			Neuron *neuron = j.next();
+			activations.append(neuron->getActivationValue().get());
+			outputs.append(neuron->getOutputActivationValue().get());
+		}
+		mNeurons.append(neurons);
+		mActivations.append(activations);
+		mOutputs.append(outputs);
+		mQueues.append(QList<int>());
+	}
+}
+
+ParallelSweep::~ParallelSweep() {
+	cancel();
+	for(QListIterator<ParallelSweepWorker*> i(mWorkers); i.hasNext();) {
+		ParallelSweepWorker *worker = i.next();
+		worker->wait();
+		delete worker;
+	}
+	while(!mNetworks.empty()) {
+		delete mNetworks.takeFirst();
+	}
+}
+
+
+int ParallelSweep::getNumberOfWorkers() const {
+	return mNetworks.size();
+}
+
+
+ModularNeuralNetwork* ParallelSweep::getNetwork(int worker) const {
+	return mNetworks.value(worker, 0);
+}
+
+
+QList<NeuralNetworkElement*> ParallelSweep::getNetworkElements(int worker) const {
+	QList<NeuralNetworkElement*> elements;
+	ModularNeuralNetwork *network = getNetwork(worker);
+	if(network != 0) {
+		network->getNetworkElements(elements);
+	}
+	return elements;
+}
+
+
+/**
+ * Restores the network configuration (bias, weights, observable parameters) and 
+ * the neuron activations that the network had when the sweep was created. 
+ * Like the sequential plotters, the network itself is not reset, so that both
+ * paths compute the same results.
+ */
+void ParallelSweep::restoreInitialState(int worker) {
+	ModularNeuralNetwork *network = getNetwork(worker);
+	if(network == 0) {
+		return;
+	}
+
+	for(QHashIterator<DoubleValue*, double> i(mConfigurations.at(worker)); i.hasNext();) {
+		i.next();
+		i.key()->set(i.value());
+	}
+
+	const QList<Neuron*> &neurons = mNeurons.at(worker);
+	const QList<double> &activations = mActivations.at(worker);
+	const QList<double> &outputs = mOutputs.at(worker);
+	for(int i = 0; i < neurons.size(); ++i) {
+		Neuron *neuron = neurons.at(i);
+		neuron->getActivationValue().set(activations.at(i));
+		neuron->getOutputActivationValue().set(outputs.at(i));
+	}
+}
+
+
+/**
+ * Executes a single network step (the same number of updates as the NeuralNetworkManager 
+ * would do) without triggering any events.
+ */
+void ParallelSweep::executeNetworkStep(int worker) {
+	if(mNetworkUpdateDisabled) {
+		return;
+	}
+	ModularNeuralNetwork *network = getNetwork(worker);
+	if(network != 0) {
+		network->executeStep(mNumberOfUpdatesPerStep);
+	}
+}
+
+
+/**
+ * Computes all columns with the given kernel. This method has to be called from 
+ * the main execution thread. While the workers are running, the main thread merges
+ * completed columns, updates the progress value and executes pending tasks. 
+ * The sweep is canceled if the activeValue becomes false or if the application 
+ * shuts down.
+ *
+ * @return true if all columns have been computed.
+ */
+bool ParallelSweep::execute(int numberOfColumns, ParallelSweepKernel *kernel, 
+							BoolValue *activeValue, DoubleValue *progress)
+{
+	Core *core = Core::getInstance();
+
+	if(kernel == 0 || mNetworks.empty() || !mWorkers.empty()) {
+		return false;
+	}
+	mKernel = kernel;
+	mCanceled.fetchAndStoreOrdered(0);
+	mNumberOfCompletedColumns = 0;
+	mNumberOfFinishedWorkers = 0;
+	mCompletedColumns.fill(false, numberOfColumns);
+
+	//round-robin distribution, so that the left part of the diagram is finished first.
+	for(int i = 0; i < mQueues.size(); ++i) {
+		mQueues[i].clear();
+	}
+	for(int column = 0; column < numberOfColumns; ++column) {
+		mQueues[column % mQueues.size()].append(column);
+	}
+
+	for(int i = 0; i < mNetworks.size(); ++i) {
+		if(!kernel->prepareWorker(this, i)) {
+			DynamicsPlotterUtil::reportProblem("ParallelSweep: Could not find the required "
+							"elements in the copy of the network. Aborting.");
+			mKernel = 0;
+			return false;
+		}
+	}
+
+	for(int i = 0; i < mNetworks.size(); ++i) {
+		ParallelSweepWorker *worker = new ParallelSweepWorker(this, i);
+		mWorkers.append(worker);
+		worker->start();
+	}
+
+	int nextColumnToMerge = 0;
+	bool finished = false;
+	while(!finished) {
+		QStringList problems;
+		int numberOfCompletedColumns = 0;
+		{
+			QMutexLocker locker(&mStateMutex);
+			if(mNumberOfFinishedWorkers < mWorkers.size()) {
+				mStateChanged.wait(&mStateMutex, 50);
+			}
+			finished = mNumberOfFinishedWorkers == mWorkers.size();
+			numberOfCompletedColumns = mNumberOfCompletedColumns;
+			problems = mProblems;
+			mProblems.clear();
+		}
+		for(QListIterator<QString> i(problems); i.hasNext();) {
+			DynamicsPlotterUtil::reportProblem(i.next());
+		}
+
+		while(nextColumnToMerge < numberOfColumns) {
+			{
+				QMutexLocker locker(&mStateMutex);
+				if(!mCompletedColumns.at(nextColumnToMerge)) {
+					break;
+				}
+			}
+			mKernel->mergeColumn(this, nextColumnToMerge);
+			++nextColumnToMerge;
+		}
+
+		if(progress != 0 && numberOfColumns > 0) {
+			progress->set((double) (100 * numberOfCompletedColumns / numberOfColumns));
+		}
+
+		core->executePendingTasks();
+		if(core->isShuttingDown() || (activeValue != 0 && !activeValue->get())) {
+			cancel();
+		}
+	}
+
+	for(QListIterator<ParallelSweepWorker*> i(mWorkers); i.hasNext();) {
+		ParallelSweepWorker *worker = i.next();
+		worker->wait();
+		delete worker;
+	}
+	mWorkers.clear();
+	mKernel = 0;
+
+	return mCanceled == 0 && nextColumnToMerge == numberOfColumns;
+}
+
+
+bool ParallelSweep::isCanceled() const {
+	return mCanceled != 0;
+}
+
+
+void ParallelSweep::cancel() {
+	mCanceled.fetchAndStoreOrdered(1);
+}
+
+
+/**
+ * Collects problem messages of the workers. The messages are reported 
+ * by the main thread.
+ */
+void ParallelSweep::reportProblem(const QString &message) {
+	QMutexLocker locker(&mStateMutex);
+	mProblems.append(message);
+}
+
+
+void ParallelSweep::runWorker(int worker) {
+	int column = 0;
+	while(!isCanceled() && takeColumn(worker, column)) {
+		mKernel->processColumn(this, worker, column);
+		if(!isCanceled()) {
+			columnCompleted(column);
+		}
+	}
+	QMutexLocker locker(&mStateMutex);
+	mNumberOfFinishedWorkers++;
+	mStateChanged.wakeAll();
+}
+
+
+/**
+ * Takes the next column of the worker's own queue. If the own queue is empty, 
+ * then the last column of the longest queue is stolen.
+ */
+bool ParallelSweep::takeColumn(int worker, int &column) {
+	QMutexLocker locker(&mQueueMutex);
+
+	if(!mQueues.at(worker).empty()) {
+		column = mQueues[worker].takeFirst();
+		return true;
+	}
+	int victim = -1;
+	for(int i = 0; i < mQueues.size(); ++i) {
+		if(!mQueues.at(i).empty() && (victim == -1 || mQueues.at(i).size() > mQueues.at(victim).size())) {
+			victim = i;
+		}
+	}
+	if(victim == -1) {
+		return false;
+	}
+	column = mQueues[victim].takeLast();
+	return true;
+}
+
+
+void ParallelSweep::columnCompleted(int column) {
+	QMutexLocker locker(&mStateMutex);
+	mCompletedColumns[column] = true;
+	mNumberOfCompletedColumns++;
+	mStateChanged.wakeAll();
+}
+
+}
+
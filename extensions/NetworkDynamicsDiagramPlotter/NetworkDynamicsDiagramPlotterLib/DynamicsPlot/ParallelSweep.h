@@ -0,0 +1,150 @@
+/***************************************************************************
+ *   NERD - Neurodynamics and Evolutionary Robotics Development Toolkit    *
+ *                                                                         *
+ *   University of Osnabrueck, Germany                                     *
+ *   Institute of Cognitive Science                                        *
+ *   Neurocybernetics Group                                                *
+ *   http://www.ikw.uni-osnabrueck.de/~neurokybernetik/                    *
+ *                                                                         *
+ *   Project homepage: nerd.x-bot.org                                      *
+ *                                                                         *
+ *   Copyright (C) 2008 - 2013 by the Neurocybernetics Group Osnabrück     *
+ *   Contact: Christian Rempis                                             *
+ *   christian.rempis@uni-osnabrueck.de                                    *
+ *   Contributors: see contributors.txt in the nerd main directory.        *
+ *                                                                         *
+ *                                                                         *
+ *   Acknowledgments:                                                      *
+ *   The NERD Toolkit is part of the EU project ALEAR                      *
+ *   (Artificial Language Evolution on Autonomous Robots) www.ALEAR.eu     *
+ *   This work was funded (2008 - 2011) by EU-Project Number ICT 214856    *
+ *                                                                         *
+ *                                                                         *
+ *   License Agreement:                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ *                                                                         *
+ *   Publications based on work using the NERD kit have to state this      *
+ *   clearly by citing the NERD homepage and the NERD overview paper.      *  
+ ***************************************************************************/
+
+
+
+#ifndef NERDParallelSweep_H
+#define NERDParallelSweep_H
+
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QAtomicInt>
+#include <QList>
+#include <QVector>
+#include <QHash>
+#include <QStringList>
+#include "ModularNeuralNetwork/ModularNeuralNetwork.h"
+#include "DynamicsPlot/ParallelSweepKernel.h"
+#include "Value/BoolValue.h"
+#include "Value/DoubleValue.h"
+
+namespace nerd {
+
+	class ParallelSweep;
+
+	/**
+	 * ParallelSweepWorker.
+	 * Worker thread of a ParallelSweep.
+	 */
+	class ParallelSweepWorker : public QThread {
+	public:
+		ParallelSweepWorker(ParallelSweep *sweep, int index);
+		virtual ~ParallelSweepWorker();
+
+	protected:
+		virtual void run();
+
+	private:
+		ParallelSweep *mSweep;
+		int mIndex;
+	};
+
+
+	/**
+	 * ParallelSweep.
+	 * Distributes the columns of a parameter grid over several worker threads.
+	 *
+	 * Each worker gets its own copy of the network, which is stepped directly with 
+	 * NeuralNetwork::executeStep() instead of triggering the global NextStep event. 
+	 * Therefore a ParallelSweep can only be used if the network is not coupled to a 
+	 * physical simulation and if the grid points (or at least the columns) can 
+	 * be computed independently of each other.
+	 *
+	 * The columns are initially distributed round-robin over the workers. A worker
+	 * that finished its own columns steals the columns from the end of the queue
+	 * of the most loaded worker. The workers write their results directly into
+	 * the data matrix (one column at a time), so that the diagram can be previewed
+	 * during the calculation.
+	 */
+	class ParallelSweep {
+	public:
+		ParallelSweep(ModularNeuralNetwork *network, int numberOfWorkers);
+		virtual ~ParallelSweep();
+
+		int getNumberOfWorkers() const;
+		ModularNeuralNetwork* getNetwork(int worker) const;
+		QList<NeuralNetworkElement*> getNetworkElements(int worker) const;
+
+		void restoreInitialState(int worker);
+		void executeNetworkStep(int worker);
+
+		bool execute(int numberOfColumns, ParallelSweepKernel *kernel, 
+					 BoolValue *activeValue, DoubleValue *progress);
+		bool isCanceled() const;
+		void cancel();
+		void reportProblem(const QString &message);
+
+		void runWorker(int worker);
+
+	private:
+		bool takeColumn(int worker, int &column);
+		void columnCompleted(int column);
+
+	private:
+		QList<ModularNeuralNetwork*> mNetworks;
+		QList<QHash<DoubleValue*, double> > mConfigurations;
+		QList<QList<Neuron*> > mNeurons;
+		QList<QList<double> > mActivations;
+		QList<QList<double> > mOutputs;
+		QList<ParallelSweepWorker*> mWorkers;
+		ParallelSweepKernel *mKernel;
+		int mNumberOfUpdatesPerStep;
+		bool mNetworkUpdateDisabled;
+
+		QMutex mQueueMutex;
+		QList<QList<int> > mQueues;
+
+		QMutex mStateMutex;
+		QWaitCondition mStateChanged;
+		QVector<bool> mCompletedColumns;
+		int mNumberOfCompletedColumns;
+		int mNumberOfFinishedWorkers;
+		QStringList mProblems;
+		QAtomicInt mCanceled;
+	};
+
+}
+
+#endif
+
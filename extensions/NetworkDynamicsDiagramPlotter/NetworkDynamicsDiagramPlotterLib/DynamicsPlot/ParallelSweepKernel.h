@@ -0,0 +1,82 @@
+/***************************************************************************
+ *   NERD - Neurodynamics and Evolutionary Robotics Development Toolkit    *
+ *                                                                         *
+ *   University of Osnabrueck, Germany                                     *
+ *   Institute of Cognitive Science                                        *
+ *   Neurocybernetics Group                                                *
+ *   http://www.ikw.uni-osnabrueck.de/~neurokybernetik/                    *
+ *                                                                         *
+ *   Project homepage: nerd.x-bot.org                                      *
+ *                                                                         *
+ *   Copyright (C) 2008 - 2013 by the Neurocybernetics Group Osnabrück     *
+ *   Contact: Christian Rempis                                             *
+ *   christian.rempis@uni-osnabrueck.de                                    *
+ *   Contributors: see contributors.txt in the nerd main directory.        *
+ *                                                                         *
+ *                                                                         *
+ *   Acknowledgments:                                                      *
+ *   The NERD Toolkit is part of the EU project ALEAR                      *
+ *   (Artificial Language Evolution on Autonomous Robots) www.ALEAR.eu     *
+ *   This work was funded (2008 - 2011) by EU-Project Number ICT 214856    *
+ *                                                                         *
+ *                                                                         *
+ *   License Agreement:                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ *                                                                         *
+ *   Publications based on work using the NERD kit have to state this      *
+ *   clearly by citing the NERD homepage and the NERD overview paper.      *  
+ ***************************************************************************/
+
+
+
+#ifndef NERDParallelSweepKernel_H
+#define NERDParallelSweepKernel_H
+
+
+namespace nerd {
+
+	class ParallelSweep;
+
+	/**
+	 * ParallelSweepKernel.
+	 * Interface for the column computations of a ParallelSweep.
+	 *
+	 * prepareWorker() is called in the main thread for each worker before the 
+	 * sweep starts. It should resolve all required network elements in the network
+	 * copy of the worker (ParallelSweep::getNetwork()).
+	 *
+	 * processColumn() is called concurrently in the worker threads. An implementation
+	 * may only access the network copy and the data of the given worker. Results 
+	 * have to be written to the data matrix under the matrix lock of the DynamicsPlotManager.
+	 *
+	 * mergeColumn() is called in the main thread for each completed column in 
+	 * ascending column order. This can be used for computations that depend on the
+	 * order of the parameter points (like the numbering of attractors).
+	 */
+	class ParallelSweepKernel {
+	public:
+		virtual ~ParallelSweepKernel() {}
+
+		virtual bool prepareWorker(ParallelSweep *sweep, int worker) = 0;
+		virtual void processColumn(ParallelSweep *sweep, int worker, int column) = 0;
+		virtual void mergeColumn(ParallelSweep*, int) {}
+	};
+
+}
+
+#endif
+
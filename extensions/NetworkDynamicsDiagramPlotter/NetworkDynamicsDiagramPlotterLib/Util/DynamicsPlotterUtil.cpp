@@ -351,6 +351,61 @@ namespace nerd {
         return activations;
 	}
 
+	/**
+	 * Collects all configuration parameters of a network (bias values, synapse strengths and
+	 * all observable double parameters of transfer-, activation- and synapse functions)
+	 * together with their current values.
+	 */
+	QHash<DoubleValue*, double> DynamicsPlotterUtil::getNetworkConfiguration(NeuralNetwork *network) {
+		QHash<DoubleValue*, double> configuration;
+		if(network == 0) {
+			return configuration;
+		}
+
+		QList<Neuron*> neurons = network->getNeurons();
+		for(QListIterator<Neuron*> i(neurons); i.hasNext();) {
+			Neuron *neuron = i.next();
+
+			configuration.insert(&neuron->getBiasValue(), neuron->getBiasValue().get());
+
+			QList<Value*> observables;
+
+			{
+				TransferFunction *tf = neuron->getTransferFunction();
+				if(tf != 0) {
+					observables << tf->getObservableOutputs();
+				}
+			}
+			{
+				ActivationFunction *af = neuron->getActivationFunction();
+				if(af != 0) {
+					observables << af->getObservableOutputs();
+				}
+			}
+
+			QList<Synapse*> synapses = neuron->getSynapses();
+			for(QListIterator<Synapse*> j(synapses); j.hasNext();) {
+				Synapse *synapse = j.next();
+
+				configuration.insert(&synapse->getStrengthValue(),
+									synapse->getStrengthValue().get());
+
+				SynapseFunction *sf = synapse->getSynapseFunction();
+				if(sf != 0) {
+					observables << sf->getObservableOutputs();
+				}
+			}
+
+			for(QListIterator<Value*> j(observables); j.hasNext();) {
+				DoubleValue *value = dynamic_cast<DoubleValue*>(j.next());
+				if(value != 0) {
+					configuration.insert(value, value->get());
+				}
+			}
+		}
+		return configuration;
+	}
+
 	int DynamicsPlotterUtil::findAttractorPeriod(QList< QList<double> > history) {
         bool attractor = false;
         int period = 0;
@@ -51,6 +51,7 @@
 #include <QList>
 #include "Network/NeuralNetwork.h"
 #include <QStringList>
+#include <QHash>
 #include "Core/Core.h"
 
 namespace nerd {
@@ -87,6 +88,8 @@ namespace nerd {
 
 		static QList<double> getNeuronActivations(NeuralNetwork* network);
 
+		static QHash<DoubleValue*, double> getNetworkConfiguration(NeuralNetwork *network);
+
 		static int findAttractorPeriod(QList< QList<double> > history);
 
 		static bool compareNetworkStates(const QList<double> &state1,
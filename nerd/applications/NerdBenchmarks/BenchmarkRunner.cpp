@@ -0,0 +1,290 @@
+/***************************************************************************
+ *   NERD - Neurodynamics and Evolutionary Robotics Development Toolkit    *
+ *                                                                         *
+ *   University of Osnabrueck, Germany                                     *
+ *   Institute of Cognitive Science                                        *
+ *   Neurocybernetics Group                                                *
+ *   http://www.ikw.uni-osnabrueck.de/~neurokybernetik/                    *
+ *                                                                         *
+ *   Project homepage: nerd.x-bot.org                                      *
+ *                                                                         *
+ *   Copyright (C) 2008 - 2013 by the Neurocybernetics Group Osnabrück     *
+ *   Contact: Christian Rempis                                             *
+ *   christian.rempis@uni-osnabrueck.de                                    *
+ *   Contributors: see contributors.txt in the nerd main directory.        *
+ *                                                                         *
+ *                                                                         *
+ *   Acknowledgments:                                                      *
+ *   The NERD Toolkit is part of the EU project ALEAR                      *
+ *   (Artificial Language Evolution on Autonomous Robots) www.ALEAR.eu     *
+ *   This work was funded (2008 - 2011) by EU-Project Number ICT 214856    *
+ *                                                                         *
+ *                                                                         *
+ *   License Agreement:                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ *                                                                         *
+ *   Publications based on work using the NERD kit have to state this      *
+ *   clearly by citing the NERD homepage and the NERD overview paper.      *  
+ ***************************************************************************/
+
+
+
+#include "BenchmarkRunner.h"
+#include <QElapsedTimer>
+#include <QRegExp>
+#include <QFile>
+#include <QTextStream>
+#include <QVector>
+#include <QListIterator>
+#include <iostream>
+#include <stdio.h>
+
+using namespace std;
+
+namespace nerd {
+
+const int BenchmarkRunner::MIN_SAMPLE_TIME = 100;
+const int BenchmarkRunner::NUMBER_OF_SAMPLES = 5;
+
+
+/**
+ * Constructs a new BenchmarkRunner.
+ */
+BenchmarkRunner::BenchmarkRunner()
+{
+}
+
+
+/**
+ * Destructor. Destroys all added Benchmarks.
+ */
+BenchmarkRunner::~BenchmarkRunner() {
+	while(!mBenchmarks.empty()) {
+		delete mBenchmarks.takeFirst();
+	}
+}
+
+
+/**
+ * Adds a Benchmark. The runner takes ownership of the Benchmark.
+ */
+void BenchmarkRunner::addBenchmark(Benchmark *benchmark) {
+	if(benchmark != 0 && !mBenchmarks.contains(benchmark)) {
+		mBenchmarks.append(benchmark);
+	}
+}
+
+
+/**
+ * Executes all Benchmarks whose names match the given regular expression. 
+ * An empty filter executes all Benchmarks.
+ */
+void BenchmarkRunner::runBenchmarks(const QString &filter) {
+	mResults.clear();
+	QRegExp filterExpression(filter);
+
+	for(QListIterator<Benchmark*> i(mBenchmarks); i.hasNext();) {
+		Benchmark *benchmark = i.next();
+		if(filter != "" && filterExpression.indexIn(benchmark->getName()) < 0) {
+			continue;
+		}
+		BenchmarkResult result;
+		if(!runBenchmark(benchmark, result)) {
+			cout << "Skipped  " << benchmark->getName().toStdString().c_str() << endl;
+			continue;
+		}
+		mResults.append(result);
+
+		printf("%-50s %14.1f ns  [%.1f - %.1f] (%lld iterations)\n", 
+				result.mName.toStdString().c_str(), result.mNanoSecondsPerIteration,
+				result.mMinNanoSecondsPerIteration, result.mMaxNanoSecondsPerIteration,
+				result.mIterations);
+		fflush(stdout);
+	}
+}
+
+
+QList<BenchmarkResult> BenchmarkRunner::getResults() const {
+	return mResults;
+}
+
+
+/**
+ * Creates the JSON representation of the results. Each benchmark is written to 
+ * a single line, which keeps diffs of stored baselines readable.
+ */
+QString BenchmarkRunner::createJson() const {
+	QString json = "{\n\t\"benchmarks\": [\n";
+	for(int i = 0; i < mResults.size(); ++i) {
+		const BenchmarkResult &result = mResults.at(i);
+		QString name = result.mName;
+		name.replace("\\", "\\\\").replace("\"", "\\\"");
+		json.append("\t\t{\"name\": \"" + name + "\", ")
+			.append("\"nsPerIteration\": " 
+					+ QString::number(result.mNanoSecondsPerIteration, 'f', 3) + ", ")
+			.append("\"minNsPerIteration\": " 
+					+ QString::number(result.mMinNanoSecondsPerIteration, 'f', 3) + ", ")
+			.append("\"maxNsPerIteration\": " 
+					+ QString::number(result.mMaxNanoSecondsPerIteration, 'f', 3) + ", ")
+			.append("\"iterations\": " + QString::number(result.mIterations) + ", ")
+			.append("\"samples\": " + QString::number(result.mNumberOfSamples) + "}");
+		if(i < mResults.size() - 1) {
+			json.append(",");
+		}
+		json.append("\n");
+	}
+	json.append("\t]\n}\n");
+	return json;
+}
+
+
+bool BenchmarkRunner::writeJson(const QString &fileName) const {
+	QFile file(fileName);
+	if(!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+		cerr << "BenchmarkRunner: Could not write file [" 
+			 << fileName.toStdString().c_str() << "]" << endl;
+		return false;
+	}
+	QTextStream output(&file);
+	output << createJson();
+	file.close();
+	return true;
+}
+
+
+/**
+ * Reads the results of a JSON file written by writeJson(). Only the names and the
+ * median durations (nsPerIteration) are read.
+ *
+ * @param fileName the name of the file to read.
+ * @param results the hash to fill with the duration of each benchmark.
+ * @return true if the file could be read.
+ */
+bool BenchmarkRunner::readJson(const QString &fileName, QHash<QString, double> &results) {
+	QFile file(fileName);
+	if(!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+		cerr << "BenchmarkRunner: Could not read file [" 
+			 << fileName.toStdString().c_str() << "]" << endl;
+		return false;
+	}
+	QRegExp entry("\"name\"\\s*:\\s*\"((?:[^\"\\\\]|\\\\.)*)\"\\s*,\\s*"
+				  "\"nsPerIteration\"\\s*:\\s*([-+0-9.eE]+)");
+
+	QTextStream input(&file);
+	QString content = input.readAll();
+	file.close();
+
+	int position = 0;
+	while((position = entry.indexIn(content, position)) >= 0) {
+		QString name = entry.cap(1);
+		name.replace("\\\"", "\"").replace("\\\\", "\\");
+		bool ok = true;
+		double duration = entry.cap(2).toDouble(&ok);
+		if(ok) {
+			results.insert(name, duration);
+		}
+		position += entry.matchedLength();
+	}
+	return true;
+}
+
+
+/**
+ * Compares the current results with a baseline and prints the relative changes.
+ *
+ * @param baseline the durations of the baseline (see readJson()).
+ * @param tolerance the accepted relative slowdown (0.1 = 10%).
+ * @return the number of benchmarks that are slower than the baseline by more 
+ *         than the tolerance.
+ */
+int BenchmarkRunner::compareWithBaseline(const QHash<QString, double> &baseline, 
+										 double tolerance) const 
+{
+	int numberOfRegressions = 0;
+
+	cout << endl << "Comparison with baseline (tolerance " 
+		 << (tolerance * 100.0) << "%):" << endl;
+
+	for(QListIterator<BenchmarkResult> i(mResults); i.hasNext();) {
+		const BenchmarkResult &result = i.next();
+		if(!baseline.contains(result.mName) || baseline.value(result.mName) <= 0.0) {
+			printf("%-50s %14s\n", result.mName.toStdString().c_str(), "new");
+			continue;
+		}
+		double reference = baseline.value(result.mName);
+		double change = (result.mNanoSecondsPerIteration - reference) / reference;
+
+		QString status = "";
+		if(change > tolerance) {
+			status = "REGRESSION";
+			numberOfRegressions++;
+		}
+		else if(change < -tolerance) {
+			status = "improved";
+		}
+		printf("%-50s %+13.1f%%  %s\n", result.mName.toStdString().c_str(), 
+				change * 100.0, status.toStdString().c_str());
+	}
+	cout << "Regressions: " << numberOfRegressions << endl;
+	return numberOfRegressions;
+}
+
+
+/**
+ * Calibrates the number of iterations and measures the samples of a single Benchmark.
+ */
+bool BenchmarkRunner::runBenchmark(Benchmark *benchmark, BenchmarkResult &result) {
+	if(!benchmark->setUp()) {
+		benchmark->tearDown();
+		return false;
+	}
+
+	QElapsedTimer timer;
+
+	//calibrate
+	int iterations = 1;
+	while(true) {
+		timer.start();
+		benchmark->run(iterations);
+		qint64 elapsed = timer.nsecsElapsed();
+		if(elapsed >= (qint64) MIN_SAMPLE_TIME * 1000000 || iterations >= (1 << 28)) {
+			break;
+		}
+		iterations *= 2;
+	}
+
+	QVector<double> samples;
+	for(int i = 0; i < NUMBER_OF_SAMPLES; ++i) {
+		timer.start();
+		benchmark->run(iterations);
+		samples.append(((double) timer.nsecsElapsed()) / ((double) iterations));
+	}
+	benchmark->tearDown();
+
+	qSort(samples);
+
+	result.mName = benchmark->getName();
+	result.mNanoSecondsPerIteration = samples.at(samples.size() / 2);
+	result.mMinNanoSecondsPerIteration = samples.first();
+	result.mMaxNanoSecondsPerIteration = samples.last();
+	result.mIterations = iterations;
+	result.mNumberOfSamples = samples.size();
+	return true;
+}
+
+
+}
@@ -0,0 +1,108 @@
+/***************************************************************************
+ *   NERD - Neurodynamics and Evolutionary Robotics Development Toolkit    *
+ *                                                                         *
+ *   University of Osnabrueck, Germany                                     *
+ *   Institute of Cognitive Science                                        *
+ *   Neurocybernetics Group                                                *
+ *   http://www.ikw.uni-osnabrueck.de/~neurokybernetik/                    *
+ *                                                                         *
+ *   Project homepage: nerd.x-bot.org                                      *
+ *                                                                         *
+ *   Copyright (C) 2008 - 2013 by the Neurocybernetics Group Osnabrück     *
+ *   Contact: Christian Rempis                                             *
+ *   christian.rempis@uni-osnabrueck.de                                    *
+ *   Contributors: see contributors.txt in the nerd main directory.        *
+ *                                                                         *
+ *                                                                         *
+ *   Acknowledgments:                                                      *
+ *   The NERD Toolkit is part of the EU project ALEAR                      *
+ *   (Artificial Language Evolution on Autonomous Robots) www.ALEAR.eu     *
+ *   This work was funded (2008 - 2011) by EU-Project Number ICT 214856    *
+ *                                                                         *
+ *                                                                         *
+ *   License Agreement:                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ *                                                                         *
+ *   Publications based on work using the NERD kit have to state this      *
+ *   clearly by citing the NERD homepage and the NERD overview paper.      *  
+ ***************************************************************************/
+
+
+
+#ifndef NERDBenchmarkRunner_H
+#define NERDBenchmarkRunner_H
+
+#include <QString>
+#include <QList>
+#include <QHash>
+#include "Benchmark.h"
+
+namespace nerd {
+
+	/**
+	 * BenchmarkResult.
+	 * The measured duration of a single Benchmark.
+	 */
+	struct BenchmarkResult {
+		QString mName;
+		double mNanoSecondsPerIteration;
+		double mMinNanoSecondsPerIteration;
+		double mMaxNanoSecondsPerIteration;
+		qint64 mIterations;
+		int mNumberOfSamples;
+	};
+
+
+	/**
+	 * BenchmarkRunner.
+	 *
+	 * Executes Benchmarks and collects their results. For each Benchmark the number 
+	 * of iterations is doubled until a single sample takes at least MIN_SAMPLE_TIME ms.
+	 * Then NUMBER_OF_SAMPLES samples with this number of iterations are measured and 
+	 * the median duration per iteration is reported.
+	 *
+	 * The results can be written as JSON file and compared against such a file 
+	 * (a stored baseline) to detect performance regressions.
+	 */
+	class BenchmarkRunner {
+	public:
+		BenchmarkRunner();
+		virtual ~BenchmarkRunner();
+
+		void addBenchmark(Benchmark *benchmark);
+		void runBenchmarks(const QString &filter = "");
+		QList<BenchmarkResult> getResults() const;
+
+		QString createJson() const;
+		bool writeJson(const QString &fileName) const;
+		static bool readJson(const QString &fileName, QHash<QString, double> &results);
+		int compareWithBaseline(const QHash<QString, double> &baseline, double tolerance) const;
+
+		static const int MIN_SAMPLE_TIME;
+		static const int NUMBER_OF_SAMPLES;
+
+	private:
+		bool runBenchmark(Benchmark *benchmark, BenchmarkResult &result);
+
+	private:
+		QList<Benchmark*> mBenchmarks;
+		QList<BenchmarkResult> mResults;
+	};
+
+}
+
+#endif
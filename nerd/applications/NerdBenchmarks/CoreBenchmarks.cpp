@@ -0,0 +1,180 @@
+/***************************************************************************
+ *   NERD - Neurodynamics and Evolutionary Robotics Development Toolkit    *
+ *                                                                         *
+ *   University of Osnabrueck, Germany                                     *
+ *   Institute of Cognitive Science                                        *
+ *   Neurocybernetics Group                                                *
+ *   http://www.ikw.uni-osnabrueck.de/~neurokybernetik/                    *
+ *                                                                         *
+ *   Project homepage: nerd.x-bot.org                                      *
+ *                                                                         *
+ *   Copyright (C) 2008 - 2013 by the Neurocybernetics Group Osnabrück     *
+ *   Contact: Christian Rempis                                             *
+ *   christian.rempis@uni-osnabrueck.de                                    *
+ *   Contributors: see contributors.txt in the nerd main directory.        *
+ *                                                                         *
+ *                                                                         *
+ *   Acknowledgments:                                                      *
+ *   The NERD Toolkit is part of the EU project ALEAR                      *
+ *   (Artificial Language Evolution on Autonomous Robots) www.ALEAR.eu     *
+ *   This work was funded (2008 - 2011) by EU-Project Number ICT 214856    *
+ *                                                                         *
+ *                                                                         *
+ *   License Agreement:                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ *                                                                         *
+ *   Publications based on work using the NERD kit have to state this      *
+ *   clearly by citing the NERD homepage and the NERD overview paper.      *  
+ ***************************************************************************/
+
+
+
+#include "CoreBenchmarks.h"
+#include "BenchmarkRunner.h"
+#include "Core/Core.h"
+#include "Value/ValueManager.h"
+
+namespace nerd {
+
+
+/**
+ * Adds all Benchmarks of the system library to the given runner.
+ */
+void addCoreBenchmarks(BenchmarkRunner *runner) {
+	runner->addBenchmark(new EventTriggerBenchmark(0));
+	runner->addBenchmark(new EventTriggerBenchmark(1));
+	runner->addBenchmark(new EventTriggerBenchmark(10));
+	runner->addBenchmark(new EventTriggerBenchmark(100));
+	runner->addBenchmark(new ValueSetBenchmark(0));
+	runner->addBenchmark(new ValueSetBenchmark(1));
+	runner->addBenchmark(new ValueSetBenchmark(10));
+	runner->addBenchmark(new ScriptFunctionBenchmark());
+}
+
+
+
+EventTriggerBenchmark::EventTriggerBenchmark(int numberOfListeners)
+	: Benchmark("Core/Event/Trigger/" + QString::number(numberOfListeners) + "Listeners"),
+	  mNumberOfListeners(numberOfListeners), mEvent(0)
+{
+}
+
+
+bool EventTriggerBenchmark::setUp() {
+	mEvent = new Event("/Benchmark/Event");
+	for(int i = 0; i < mNumberOfListeners; ++i) {
+		CountingListener *listener = new CountingListener();
+		mListeners.append(listener);
+		mEvent->addEventListener(listener);
+	}
+	return true;
+}
+
+
+void EventTriggerBenchmark::run(int iterations) {
+	for(int i = 0; i < iterations; ++i) {
+		mEvent->trigger();
+	}
+}
+
+
+void EventTriggerBenchmark::tearDown() {
+	delete mEvent;
+	mEvent = 0;
+	while(!mListeners.empty()) {
+		delete mListeners.takeFirst();
+	}
+}
+
+
+
+ValueSetBenchmark::ValueSetBenchmark(int numberOfListeners)
+	: Benchmark("Core/Value/DoubleSet/" + QString::number(numberOfListeners) + "Listeners"),
+	  mNumberOfListeners(numberOfListeners), mValue(0)
+{
+}
+
+
+bool ValueSetBenchmark::setUp() {
+	mValue = new DoubleValue(0.0);
+	for(int i = 0; i < mNumberOfListeners; ++i) {
+		CountingListener *listener = new CountingListener();
+		mListeners.append(listener);
+		mValue->addValueChangedListener(listener);
+	}
+	return true;
+}
+
+
+void ValueSetBenchmark::run(int iterations) {
+	for(int i = 0; i < iterations; ++i) {
+		//alternate the content, otherwise unchanged values are not propagated.
+		mValue->set((double) (i & 1));
+	}
+}
+
+
+void ValueSetBenchmark::tearDown() {
+	delete mValue;
+	mValue = 0;
+	while(!mListeners.empty()) {
+		delete mListeners.takeFirst();
+	}
+}
+
+
+
+ScriptFunctionBenchmark::ScriptFunctionBenchmark()
+	: Benchmark("Core/Script/FunctionCall"), mContext(0)
+{
+}
+
+
+bool ScriptFunctionBenchmark::setUp() {
+	ValueManager *vm = Core::getInstance()->getValueManager();
+	if(vm->getDoubleValue("/Benchmark/ScriptValue") == 0) {
+		vm->addValue("/Benchmark/ScriptValue", new DoubleValue(0.0));
+	}
+
+	mContext = new ScriptingContext("BenchmarkScript");
+	mContext->setScriptCode(
+			"defVar('value', '/Benchmark/ScriptValue');"
+			"var counter = 0;"
+			"function step() {"
+			"  counter = counter + 1;"
+			"  value = Math.sin(counter) * 0.5;"
+			"}");
+	mContext->resetScriptContext();
+	mContext->executeScriptFunction("step();");
+	return true;
+}
+
+
+void ScriptFunctionBenchmark::run(int iterations) {
+	for(int i = 0; i < iterations; ++i) {
+		mContext->executeScriptFunction("step();");
+	}
+}
+
+
+void ScriptFunctionBenchmark::tearDown() {
+	delete mContext;
+	mContext = 0;
+}
+
+
+}
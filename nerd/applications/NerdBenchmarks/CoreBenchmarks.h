@@ -0,0 +1,135 @@
+/***************************************************************************
+ *   NERD - Neurodynamics and Evolutionary Robotics Development Toolkit    *
+ *                                                                         *
+ *   University of Osnabrueck, Germany                                     *
+ *   Institute of Cognitive Science                                        *
+ *   Neurocybernetics Group                                                *
+ *   http://www.ikw.uni-osnabrueck.de/~neurokybernetik/                    *
+ *                                                                         *
+ *   Project homepage: nerd.x-bot.org                                      *
+ *                                                                         *
+ *   Copyright (C) 2008 - 2013 by the Neurocybernetics Group Osnabrück     *
+ *   Contact: Christian Rempis                                             *
+ *   christian.rempis@uni-osnabrueck.de                                    *
+ *   Contributors: see contributors.txt in the nerd main directory.        *
+ *                                                                         *
+ *                                                                         *
+ *   Acknowledgments:                                                      *
+ *   The NERD Toolkit is part of the EU project ALEAR                      *
+ *   (Artificial Language Evolution on Autonomous Robots) www.ALEAR.eu     *
+ *   This work was funded (2008 - 2011) by EU-Project Number ICT 214856    *
+ *                                                                         *
+ *                                                                         *
+ *   License Agreement:                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ *                                                                         *
+ *   Publications based on work using the NERD kit have to state this      *
+ *   clearly by citing the NERD homepage and the NERD overview paper.      *  
+ ***************************************************************************/
+
+
+
+#ifndef NERDCoreBenchmarks_H
+#define NERDCoreBenchmarks_H
+
+#include "Benchmark.h"
+#include "Event/Event.h"
+#include "Event/EventListener.h"
+#include "Value/DoubleValue.h"
+#include "Value/ValueChangedListener.h"
+#include "Script/ScriptingContext.h"
+#include <QList>
+
+namespace nerd {
+
+	class BenchmarkRunner;
+
+	/**
+	 * CountingListener.
+	 * A minimal EventListener and ValueChangedListener used to measure the 
+	 * notification overhead of Events and Values.
+	 */
+	class CountingListener : public virtual EventListener, public virtual ValueChangedListener {
+	public:
+		CountingListener() : mCounter(0) {}
+		virtual ~CountingListener() {}
+		virtual QString getName() const { return "CountingListener"; }
+		virtual void eventOccured(Event*) { mCounter++; }
+		virtual void valueChanged(Value*) { mCounter++; }
+
+		int mCounter;
+	};
+
+
+	/**
+	 * EventTriggerBenchmark.
+	 * Measures Event::trigger() with a given number of EventListeners.
+	 */
+	class EventTriggerBenchmark : public Benchmark {
+	public:
+		EventTriggerBenchmark(int numberOfListeners);
+		virtual bool setUp();
+		virtual void run(int iterations);
+		virtual void tearDown();
+
+	private:
+		int mNumberOfListeners;
+		Event *mEvent;
+		QList<CountingListener*> mListeners;
+	};
+
+
+	/**
+	 * ValueSetBenchmark.
+	 * Measures DoubleValue::set() with a given number of ValueChangedListeners.
+	 */
+	class ValueSetBenchmark : public Benchmark {
+	public:
+		ValueSetBenchmark(int numberOfListeners);
+		virtual bool setUp();
+		virtual void run(int iterations);
+		virtual void tearDown();
+
+	private:
+		int mNumberOfListeners;
+		DoubleValue *mValue;
+		QList<CountingListener*> mListeners;
+	};
+
+
+	/**
+	 * ScriptFunctionBenchmark.
+	 * Measures the execution of a small script function in a ScriptingContext,
+	 * including the import and export of a bound Value.
+	 */
+	class ScriptFunctionBenchmark : public Benchmark {
+	public:
+		ScriptFunctionBenchmark();
+		virtual bool setUp();
+		virtual void run(int iterations);
+		virtual void tearDown();
+
+	private:
+		ScriptingContext *mContext;
+	};
+
+
+	void addCoreBenchmarks(BenchmarkRunner *runner);
+
+}
+
+#endif
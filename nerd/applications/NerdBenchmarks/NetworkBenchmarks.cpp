@@ -0,0 +1,169 @@
+/***************************************************************************
+ *   NERD - Neurodynamics and Evolutionary Robotics Development Toolkit    *
+ *                                                                         *
+ *   University of Osnabrueck, Germany                                     *
+ *   Institute of Cognitive Science                                        *
+ *   Neurocybernetics Group                                                *
+ *   http://www.ikw.uni-osnabrueck.de/~neurokybernetik/                    *
+ *                                                                         *
+ *   Project homepage: nerd.x-bot.org                                      *
+ *                                                                         *
+ *   Copyright (C) 2008 - 2013 by the Neurocybernetics Group Osnabrück     *
+ *   Contact: Christian Rempis                                             *
+ *   christian.rempis@uni-osnabrueck.de                                    *
+ *   Contributors: see contributors.txt in the nerd main directory.        *
+ *                                                                         *
+ *                                                                         *
+ *   Acknowledgments:                                                      *
+ *   The NERD Toolkit is part of the EU project ALEAR                      *
+ *   (Artificial Language Evolution on Autonomous Robots) www.ALEAR.eu     *
+ *   This work was funded (2008 - 2011) by EU-Project Number ICT 214856    *
+ *                                                                         *
+ *                                                                         *
+ *   License Agreement:                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ *                                                                         *
+ *   Publications based on work using the NERD kit have to state this      *
+ *   clearly by citing the NERD homepage and the NERD overview paper.      *  
+ ***************************************************************************/
+
+
+
+#include "NetworkBenchmarks.h"
+#include "BenchmarkRunner.h"
+#include "ModularNeuralNetwork/ModularNeuralNetwork.h"
+#include "Network/Neuron.h"
+#include "Network/Synapse.h"
+#include "IO/NeuralNetworkIONerdV1Xml.h"
+#include "Math/Random.h"
+#include <QVector>
+
+namespace nerd {
+
+
+/**
+ * Adds all Benchmarks of the neural network library to the given runner.
+ */
+void addNetworkBenchmarks(BenchmarkRunner *runner) {
+	runner->addBenchmark(new NetworkStepBenchmark(10, 5));
+	runner->addBenchmark(new NetworkStepBenchmark(100, 10));
+	runner->addBenchmark(new NetworkStepBenchmark(1000, 10));
+	runner->addBenchmark(new NetworkCopyBenchmark(100, 10));
+	runner->addBenchmark(new NetworkCopyBenchmark(1000, 10));
+	runner->addBenchmark(new NetworkXmlBenchmark(100, 10));
+	runner->addBenchmark(new NetworkXmlBenchmark(1000, 10));
+}
+
+
+
+NetworkBenchmark::NetworkBenchmark(const QString &name, int numberOfNeurons, int fanIn)
+	: Benchmark(name + "/" + QString::number(numberOfNeurons) + "Neurons"),
+	  mNumberOfNeurons(numberOfNeurons), mFanIn(fanIn), mNetwork(0)
+{
+}
+
+
+bool NetworkBenchmark::setUp() {
+	mNetwork = createNetwork(mNumberOfNeurons, mFanIn);
+	return mNetwork != 0;
+}
+
+
+void NetworkBenchmark::tearDown() {
+	delete mNetwork;
+	mNetwork = 0;
+}
+
+
+/**
+ * Creates a reproducible random network. 
+ *
+ * @param numberOfNeurons the number of neurons of the network.
+ * @param fanIn the number of incoming synapses of each neuron.
+ * @return the new network.
+ */
+NeuralNetwork* NetworkBenchmark::createNetwork(int numberOfNeurons, int fanIn) {
+	Random::setSeed(4711);
+
+	ModularNeuralNetwork *network = new ModularNeuralNetwork();
+
+	QVector<Neuron*> neurons(numberOfNeurons);
+	for(int i = 0; i < numberOfNeurons; ++i) {
+		Neuron *neuron = new Neuron("Neuron" + QString::number(i), 
+						*(network->getDefaultTransferFunction()), 
+						*(network->getDefaultActivationFunction()));
+		neuron->getBiasValue().set(Random::nextDoubleBetween(-0.5, 0.5));
+		neurons[i] = neuron;
+		network->addNeuron(neuron);
+	}
+	for(int i = 0; i < numberOfNeurons; ++i) {
+		for(int j = 0; j < fanIn; ++j) {
+			Neuron *source = neurons.at(Random::nextInt(numberOfNeurons));
+			Synapse::createSynapse(source, neurons.at(i), Random::nextDoubleBetween(-2.0, 2.0),
+						*(network->getDefaultSynapseFunction()));
+		}
+	}
+	return network;
+}
+
+
+
+NetworkStepBenchmark::NetworkStepBenchmark(int numberOfNeurons, int fanIn)
+	: NetworkBenchmark("Neuro/Network/ExecuteStep", numberOfNeurons, fanIn)
+{
+}
+
+
+void NetworkStepBenchmark::run(int iterations) {
+	for(int i = 0; i < iterations; ++i) {
+		mNetwork->executeStep();
+	}
+}
+
+
+
+NetworkCopyBenchmark::NetworkCopyBenchmark(int numberOfNeurons, int fanIn)
+	: NetworkBenchmark("Neuro/Network/CreateCopy", numberOfNeurons, fanIn)
+{
+}
+
+
+void NetworkCopyBenchmark::run(int iterations) {
+	for(int i = 0; i < iterations; ++i) {
+		delete mNetwork->createCopy();
+	}
+}
+
+
+
+NetworkXmlBenchmark::NetworkXmlBenchmark(int numberOfNeurons, int fanIn)
+	: NetworkBenchmark("Neuro/Network/XmlRoundTrip", numberOfNeurons, fanIn)
+{
+}
+
+
+void NetworkXmlBenchmark::run(int iterations) {
+	for(int i = 0; i < iterations; ++i) {
+		QString errorMessage;
+		QList<QString> warnings;
+		QString xml = NeuralNetworkIONerdV1Xml::createXmlFromNetwork(mNetwork);
+		delete NeuralNetworkIONerdV1Xml::createNetFromXml(xml, &errorMessage, &warnings);
+	}
+}
+
+
+}
@@ -0,0 +1,116 @@
+/***************************************************************************
+ *   NERD - Neurodynamics and Evolutionary Robotics Development Toolkit    *
+ *                                                                         *
+ *   University of Osnabrueck, Germany                                     *
+ *   Institute of Cognitive Science                                        *
+ *   Neurocybernetics Group                                                *
+ *   http://www.ikw.uni-osnabrueck.de/~neurokybernetik/                    *
+ *                                                                         *
+ *   Project homepage: nerd.x-bot.org                                      *
+ *                                                                         *
+ *   Copyright (C) 2008 - 2013 by the Neurocybernetics Group Osnabrück     *
+ *   Contact: Christian Rempis                                             *
+ *   christian.rempis@uni-osnabrueck.de                                    *
+ *   Contributors: see contributors.txt in the nerd main directory.        *
+ *                                                                         *
+ *                                                                         *
+ *   Acknowledgments:                                                      *
+ *   The NERD Toolkit is part of the EU project ALEAR                      *
+ *   (Artificial Language Evolution on Autonomous Robots) www.ALEAR.eu     *
+ *   This work was funded (2008 - 2011) by EU-Project Number ICT 214856    *
+ *                                                                         *
+ *                                                                         *
+ *   License Agreement:                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ *                                                                         *
+ *   Publications based on work using the NERD kit have to state this      *
+ *   clearly by citing the NERD homepage and the NERD overview paper.      *  
+ ***************************************************************************/
+
+
+
+#ifndef NERDNetworkBenchmarks_H
+#define NERDNetworkBenchmarks_H
+
+#include "Benchmark.h"
+#include "Network/NeuralNetwork.h"
+
+namespace nerd {
+
+	class BenchmarkRunner;
+
+	/**
+	 * NetworkBenchmark.
+	 *
+	 * Base class for Benchmarks on generated ModularNeuralNetworks. The network 
+	 * is created with a fixed random seed, so all runs measure the same topology:
+	 * each neuron receives a synapse from fanIn randomly selected neurons.
+	 */
+	class NetworkBenchmark : public Benchmark {
+	public:
+		NetworkBenchmark(const QString &name, int numberOfNeurons, int fanIn);
+		virtual bool setUp();
+		virtual void tearDown();
+
+		static NeuralNetwork* createNetwork(int numberOfNeurons, int fanIn);
+
+	protected:
+		int mNumberOfNeurons;
+		int mFanIn;
+		NeuralNetwork *mNetwork;
+	};
+
+
+	/**
+	 * NetworkStepBenchmark.
+	 * Measures NeuralNetwork::executeStep().
+	 */
+	class NetworkStepBenchmark : public NetworkBenchmark {
+	public:
+		NetworkStepBenchmark(int numberOfNeurons, int fanIn);
+		virtual void run(int iterations);
+	};
+
+
+	/**
+	 * NetworkCopyBenchmark.
+	 * Measures NeuralNetwork::createCopy() including the destruction of the copy.
+	 */
+	class NetworkCopyBenchmark : public NetworkBenchmark {
+	public:
+		NetworkCopyBenchmark(int numberOfNeurons, int fanIn);
+		virtual void run(int iterations);
+	};
+
+
+	/**
+	 * NetworkXmlBenchmark.
+	 * Measures a full round trip through NeuralNetworkIONerdV1Xml (serialization
+	 * and parsing).
+	 */
+	class NetworkXmlBenchmark : public NetworkBenchmark {
+	public:
+		NetworkXmlBenchmark(int numberOfNeurons, int fanIn);
+		virtual void run(int iterations);
+	};
+
+
+	void addNetworkBenchmarks(BenchmarkRunner *runner);
+
+}
+
+#endif
@@ -0,0 +1,205 @@
+/***************************************************************************
+ *   NERD - Neurodynamics and Evolutionary Robotics Development Toolkit    *
+ *                                                                         *
+ *   University of Osnabrueck, Germany                                     *
+ *   Institute of Cognitive Science                                        *
+ *   Neurocybernetics Group                                                *
+ *   http://www.ikw.uni-osnabrueck.de/~neurokybernetik/                    *
+ *                                                                         *
+ *   Project homepage: nerd.x-bot.org                                      *
+ *                                                                         *
+ *   Copyright (C) 2008 - 2013 by the Neurocybernetics Group Osnabrück     *
+ *   Contact: Christian Rempis                                             *
+ *   christian.rempis@uni-osnabrueck.de                                    *
+ *   Contributors: see contributors.txt in the nerd main directory.        *
+ *                                                                         *
+ *                                                                         *
+ *   Acknowledgments:                                                      *
+ *   The NERD Toolkit is part of the EU project ALEAR                      *
+ *   (Artificial Language Evolution on Autonomous Robots) www.ALEAR.eu     *
+ *   This work was funded (2008 - 2011) by EU-Project Number ICT 214856    *
+ *                                                                         *
+ *                                                                         *
+ *   License Agreement:                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ *                                                                         *
+ *   Publications based on work using the NERD kit have to state this      *
+ *   clearly by citing the NERD homepage and the NERD overview paper.      *  
+ ***************************************************************************/
+
+
+
+#include "SimulationBenchmarks.h"
+#include "BenchmarkRunner.h"
+#include "Core/Core.h"
+#include "Physics/Physics.h"
+#include "Physics/PhysicsManager.h"
+#include "Physics/SimObject.h"
+#include "SimulationConstants.h"
+#include <QProcess>
+#include <QFile>
+
+namespace nerd {
+
+
+/**
+ * Adds all Benchmarks of the simulator libraries to the given runner.
+ *
+ * @param runner the runner to add the Benchmarks to.
+ * @param evaluationScript the script used by the EvaluationBenchmark (may be empty).
+ */
+void addSimulationBenchmarks(BenchmarkRunner *runner, const QString &evaluationScript) {
+	runner->addBenchmark(new PhysicsStepBenchmark(3));
+	runner->addBenchmark(new PhysicsStepBenchmark(10));
+	runner->addBenchmark(new PhysicsResetBenchmark(10));
+	runner->addBenchmark(new EvaluationBenchmark(evaluationScript));
+}
+
+
+
+PhysicsStepBenchmark::PhysicsStepBenchmark(int gridSize)
+	: Benchmark("Simulator/ODE/Step/" + QString::number(gridSize * gridSize) + "Boxes"),
+	  mGridSize(gridSize)
+{
+}
+
+
+bool PhysicsStepBenchmark::setUp() {
+	if(!createReferenceModel(mGridSize)) {
+		return false;
+	}
+	return Physics::getPhysicsManager()->resetSimulation();
+}
+
+
+void PhysicsStepBenchmark::run(int iterations) {
+	PhysicsManager *pm = Physics::getPhysicsManager();
+	for(int i = 0; i < iterations; ++i) {
+		pm->executeSimulationStep();
+	}
+}
+
+
+void PhysicsStepBenchmark::tearDown() {
+	PhysicsManager *pm = Physics::getPhysicsManager();
+	pm->clearPhysics();
+	pm->destroySimObjects();
+}
+
+
+/**
+ * Creates the reference model in the PhysicsManager: a ground plane and 
+ * gridSize x gridSize dynamic boxes placed on it.
+ *
+ * @param gridSize the number of boxes per row.
+ * @return true if all required prototypes were available.
+ */
+bool PhysicsStepBenchmark::createReferenceModel(int gridSize) {
+	PhysicsManager *pm = Physics::getPhysicsManager();
+
+	SimObject *planePrototype = pm->getPrototype(SimulationConstants::PROTOTYPE_PLANE_BODY);
+	SimObject *boxPrototype = pm->getPrototype(SimulationConstants::PROTOTYPE_BOX_BODY);
+	if(planePrototype == 0 || boxPrototype == 0) {
+		Core::log("PhysicsStepBenchmark: Required prototypes are not available.", true);
+		return false;
+	}
+
+	SimObject *plane = planePrototype->createCopy();
+	plane->setName("Ground");
+	pm->addSimObject(plane);
+
+	for(int i = 0; i < gridSize; ++i) {
+		for(int j = 0; j < gridSize; ++j) {
+			SimObject *box = boxPrototype->createCopy();
+			box->setName("Box" + QString::number(i) + "_" + QString::number(j));
+			box->getParameter("Width")->setValueFromString("0.2");
+			box->getParameter("Height")->setValueFromString("0.2");
+			box->getParameter("Depth")->setValueFromString("0.2");
+			box->getParameter("Mass")->setValueFromString("1.0");
+			box->getParameter("Dynamic")->setValueFromString("true");
+			box->getParameter("Position")->setValueFromString("(" 
+					+ QString::number(i * 0.5) + ",0.11," + QString::number(j * 0.5) + ")");
+			pm->addSimObject(box);
+		}
+	}
+	return true;
+}
+
+
+
+PhysicsResetBenchmark::PhysicsResetBenchmark(int gridSize)
+	: Benchmark("Simulator/ODE/Reset/" + QString::number(gridSize * gridSize) + "Boxes"),
+	  mGridSize(gridSize)
+{
+}
+
+
+bool PhysicsResetBenchmark::setUp() {
+	return PhysicsStepBenchmark::createReferenceModel(mGridSize);
+}
+
+
+void PhysicsResetBenchmark::run(int iterations) {
+	PhysicsManager *pm = Physics::getPhysicsManager();
+	for(int i = 0; i < iterations; ++i) {
+		pm->resetSimulation();
+	}
+}
+
+
+void PhysicsResetBenchmark::tearDown() {
+	PhysicsManager *pm = Physics::getPhysicsManager();
+	pm->clearPhysics();
+	pm->destroySimObjects();
+}
+
+
+
+EvaluationBenchmark::EvaluationBenchmark(const QString &scriptFile)
+	: Benchmark("Evaluation/FullEvaluation"), mScriptFile(scriptFile)
+{
+}
+
+
+bool EvaluationBenchmark::setUp() {
+	if(mScriptFile == "") {
+		return false;
+	}
+	if(!QFile::exists(mScriptFile)) {
+		Core::log("EvaluationBenchmark: Could not find evaluation script [" 
+					+ mScriptFile + "]", true);
+		return false;
+	}
+	//the first run also warms up the file system caches.
+	int exitCode = QProcess::execute("/bin/bash", QStringList() << mScriptFile);
+	if(exitCode != 0) {
+		Core::log("EvaluationBenchmark: Evaluation script failed with exit code " 
+					+ QString::number(exitCode), true);
+		return false;
+	}
+	return true;
+}
+
+
+void EvaluationBenchmark::run(int iterations) {
+	for(int i = 0; i < iterations; ++i) {
+		QProcess::execute("/bin/bash", QStringList() << mScriptFile);
+	}
+}
+
+
+}
@@ -0,0 +1,115 @@
+/***************************************************************************
+ *   NERD - Neurodynamics and Evolutionary Robotics Development Toolkit    *
+ *                                                                         *
+ *   University of Osnabrueck, Germany                                     *
+ *   Institute of Cognitive Science                                        *
+ *   Neurocybernetics Group                                                *
+ *   http://www.ikw.uni-osnabrueck.de/~neurokybernetik/                    *
+ *                                                                         *
+ *   Project homepage: nerd.x-bot.org                                      *
+ *                                                                         *
+ *   Copyright (C) 2008 - 2013 by the Neurocybernetics Group Osnabrück     *
+ *   Contact: Christian Rempis                                             *
+ *   christian.rempis@uni-osnabrueck.de                                    *
+ *   Contributors: see contributors.txt in the nerd main directory.        *
+ *                                                                         *
+ *                                                                         *
+ *   Acknowledgments:                                                      *
+ *   The NERD Toolkit is part of the EU project ALEAR                      *
+ *   (Artificial Language Evolution on Autonomous Robots) www.ALEAR.eu     *
+ *   This work was funded (2008 - 2011) by EU-Project Number ICT 214856    *
+ *                                                                         *
+ *                                                                         *
+ *   License Agreement:                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ *                                                                         *
+ *   Publications based on work using the NERD kit have to state this      *
+ *   clearly by citing the NERD homepage and the NERD overview paper.      *  
+ ***************************************************************************/
+
+
+
+#ifndef NERDSimulationBenchmarks_H
+#define NERDSimulationBenchmarks_H
+
+#include "Benchmark.h"
+#include <QString>
+
+namespace nerd {
+
+	class BenchmarkRunner;
+
+	/**
+	 * PhysicsStepBenchmark.
+	 *
+	 * Measures PhysicsManager::executeSimulationStep() on the ODE reference model:
+	 * a ground plane with a grid of boxes resting on it.
+	 */
+	class PhysicsStepBenchmark : public Benchmark {
+	public:
+		PhysicsStepBenchmark(int gridSize);
+		virtual bool setUp();
+		virtual void run(int iterations);
+		virtual void tearDown();
+
+		static bool createReferenceModel(int gridSize);
+
+	private:
+		int mGridSize;
+	};
+
+
+	/**
+	 * PhysicsResetBenchmark.
+	 * Measures PhysicsManager::resetSimulation() on the ODE reference model.
+	 */
+	class PhysicsResetBenchmark : public Benchmark {
+	public:
+		PhysicsResetBenchmark(int gridSize);
+		virtual bool setUp();
+		virtual void run(int iterations);
+		virtual void tearDown();
+
+	private:
+		int mGridSize;
+	};
+
+
+	/**
+	 * EvaluationBenchmark.
+	 *
+	 * Measures a complete evaluation, i.e. the start of a simulator, the loading of
+	 * the environment and the evaluation of a network. As the evaluation depends on 
+	 * an installed scenario, it is provided as shell script (-evaluationScript). 
+	 * Without such a script the benchmark is skipped.
+	 */
+	class EvaluationBenchmark : public Benchmark {
+	public:
+		EvaluationBenchmark(const QString &scriptFile);
+		virtual bool setUp();
+		virtual void run(int iterations);
+
+	private:
+		QString mScriptFile;
+	};
+
+
+	void addSimulationBenchmarks(BenchmarkRunner *runner, const QString &evaluationScript);
+
+}
+
+#endif
@@ -0,0 +1,168 @@
+/***************************************************************************
+ *   NERD - Neurodynamics and Evolutionary Robotics Development Toolkit    *
+ *                                                                         *
+ *   University of Osnabrueck, Germany                                     *
+ *   Institute of Cognitive Science                                        *
+ *   Neurocybernetics Group                                                *
+ *   http://www.ikw.uni-osnabrueck.de/~neurokybernetik/                    *
+ *                                                                         *
+ *   Project homepage: nerd.x-bot.org                                      *
+ *                                                                         *
+ *   Copyright (C) 2008 - 2013 by the Neurocybernetics Group Osnabrück     *
+ *   Contact: Christian Rempis                                             *
+ *   christian.rempis@uni-osnabrueck.de                                    *
+ *   Contributors: see contributors.txt in the nerd main directory.        *
+ *                                                                         *
+ *                                                                         *
+ *   Acknowledgments:                                                      *
+ *   The NERD Toolkit is part of the EU project ALEAR                      *
+ *   (Artificial Language Evolution on Autonomous Robots) www.ALEAR.eu     *
+ *   This work was funded (2008 - 2011) by EU-Project Number ICT 214856    *
+ *                                                                         *
+ *                                                                         *
+ *   License Agreement:                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ *                                                                         *
+ *   Publications based on work using the NERD kit have to state this      *
+ *   clearly by citing the NERD homepage and the NERD overview paper.      *  
+ ***************************************************************************/
+
+
+
+#include "Core/Core.h"
+#include <QCoreApplication>
+#include <QStringList>
+#include <QHash>
+#include <iostream>
+#include "PlugIns/CommandLineArgument.h"
+#include "Physics/Physics.h"
+#include "Network/Neuro.h"
+#include "Collections/ODE_Physics.h"
+#include "BenchmarkRunner.h"
+#include "CoreBenchmarks.h"
+#include "NetworkBenchmarks.h"
+#include "SimulationBenchmarks.h"
+
+
+using namespace std;
+using namespace nerd;
+
+/**
+ * nerdBenchmarks executes reproducible micro benchmarks for the hot paths of the 
+ * NERD libraries (events, values, scripts, network execution and IO, physics).
+ *
+ * The results can be written as JSON file (-json) and compared against a previously
+ * written file (-compare). In comparison mode the exit code is 1 if there are 
+ * regressions (the number is printed), so the tool can be used directly in 
+ * regression scripts. Errors (e.g. unreadable files) exit with -1.
+ */
+int main(int argc, char *argv[])
+{
+	QCoreApplication *app = new QCoreApplication(argc, argv);
+
+	Core::resetCore();
+
+	Physics::install();
+	Neuro::install();
+
+	//install ODE PhysicsLayer
+	ODE_Physics();
+
+	CommandLineArgument *jsonArg = new CommandLineArgument("json", "json", "<file>",
+			"Writes the benchmark results as JSON to <file>.", 1, 0, true);
+	CommandLineArgument *compareArg = new CommandLineArgument("compare", "compare", 
+			"<baseline> [<tolerance>]",
+			"Compares the results with the JSON file <baseline>. Benchmarks that are slower "
+			"than the baseline by more than <tolerance> (default 0.1 = 10%) are reported as "
+			"regressions.", 1, 1, true);
+	CommandLineArgument *filterArg = new CommandLineArgument("filter", "filter", "<regExp>",
+			"Only executes benchmarks whose names match <regExp>.", 1, 0, true);
+	CommandLineArgument *evaluationArg = new CommandLineArgument("evaluationScript", 
+			"evaluationScript", "<file>",
+			"Measures a full evaluation by executing the shell script <file>.", 1, 0, true);
+
+	Core::getInstance()->setMainExecutionThread();
+
+	if(!Core::getInstance()->init()) {
+		cerr << "Could not initialize the NERD Core!" << endl;
+		Core::resetCore();
+		delete app;
+		return -1;
+	}
+
+	QString evaluationScript = "";
+	if(evaluationArg->getNumberOfEntries() > 0) {
+		evaluationScript = evaluationArg->getEntryParameters(0).at(0);
+	}
+	QString filter = "";
+	if(filterArg->getNumberOfEntries() > 0) {
+		filter = filterArg->getEntryParameters(0).at(0);
+	}
+
+	BenchmarkRunner runner;
+	addCoreBenchmarks(&runner);
+	addNetworkBenchmarks(&runner);
+	addSimulationBenchmarks(&runner, evaluationScript);
+
+	runner.runBenchmarks(filter);
+
+	int result = 0;
+
+	if(jsonArg->getNumberOfEntries() > 0) {
+		if(!runner.writeJson(jsonArg->getEntryParameters(0).at(0))) {
+			result = -1;
+		}
+	}
+
+	if(compareArg->getNumberOfEntries() > 0) {
+		QStringList parameters = compareArg->getEntryParameters(0);
+		double tolerance = 0.1;
+		if(parameters.size() > 1) {
+			bool ok = true;
+			tolerance = parameters.at(1).toDouble(&ok);
+			if(!ok || tolerance < 0.0) {
+				cerr << "Invalid tolerance [" << parameters.at(1).toStdString().c_str() 
+					 << "]" << endl;
+				tolerance = 0.1;
+			}
+		}
+		QHash<QString, double> baseline;
+		if(!BenchmarkRunner::readJson(parameters.at(0), baseline)) {
+			result = -1;
+		}
+		else {
+			//the comparison also runs if writing the json file failed, but that 
+			//failure (-1) is kept as exit code. The count is not used as exit code, 
+			//as exit codes wrap modulo 256.
+			int numberOfRegressions = runner.compareWithBaseline(baseline, tolerance);
+			if(numberOfRegressions > 0) {
+				cerr << numberOfRegressions << " benchmark(s) regressed." << endl;
+				if(result == 0) {
+					result = 1;
+				}
+			}
+		}
+	}
+
+	Core::getInstance()->shutDown();
+	Core::getInstance()->waitForAllThreadsToComplete();
+	Core::resetCore();
+
+	delete app;
+
+	return result;
+}
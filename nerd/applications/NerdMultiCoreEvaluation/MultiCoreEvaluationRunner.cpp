@@ -58,13 +58,15 @@
 #include <QProcess>
 #include <QThread>
 #include "Math/Math.h"
+#include <QTimer>
 
 using namespace std;
 
 namespace nerd {
 	
 	MultiCoreEvaluationRunner::MultiCoreEvaluationRunner()
-	: mDoShutDown(false), mShutDownEvent(0), mMessageValue(0), mMinIndex(-1), mMaxIndex(-1)
+	: mDoShutDown(false), mShutDownEvent(0), mMessageValue(0), mMinIndex(-1), mMaxIndex(-1),
+	  mCurrentIndex(0), mPoolSize(1), mEventLoop(0)
 	{
 		connect(this, SIGNAL(quitMainApplication()),
 				QCoreApplication::instance(), SLOT(quit()));
@@ -74,10 +76,18 @@ namespace nerd {
 		Core::getInstance()->getValueManager()->addValue(
 			"/Evaluation/Messages", mMessageValue);
 		
-		mNumberOfProcesses = new IntValue(4);
+		mNumberOfProcesses = new IntValue(0);
+		mNumberOfProcesses->setDescription("The number of parallel evaluation processes. "
+			"Values <= 0 use one process per available core.");
 		Core::getInstance()->getValueManager()->addValue(
 			"/Evaluation/NumberOfProcesses", mNumberOfProcesses);
 		
+		mUseWorkers = new BoolValue(false);
+		mUseWorkers->setDescription("If true, the job script is started as persistent "
+			"worker (argument 'worker') that receives the indices to evaluate at stdin.");
+		Core::getInstance()->getValueManager()->addValue(
+			"/Evaluation/UseWorkers", mUseWorkers);
+		
 		
 		CommandLineArgument *jobFileNameArg = new CommandLineArgument("scriptFile", "scriptFile", 
 									 "<absoluteFileName>", "The name of the main evaluation script",
@@ -203,71 +213,41 @@ namespace nerd {
 		//load config file
 		ValueManager *vm = Core::getInstance()->getValueManager();
 		vm->loadValues("evalConf.val");
-		vm->saveValues("evalConf.val", vm->getValueNamesMatchingPattern(".*/NumberOfProcesses"), "");
+		vm->saveValues("evalConf.val", 
+				vm->getValueNamesMatchingPattern(".*/NumberOfProcesses|.*/UseWorkers"), "");
 		
 		
 		//execute evaluations
-		int numberOfProcesses = Math::min(16, mNumberOfProcesses->get());
+		mPoolSize = mNumberOfProcesses->get();
+		if(mPoolSize <= 0) {
+			mPoolSize = qMax(1, QThread::idealThreadCount());
+		}
+		mCurrentIndex = mMinIndex;
 		
-		int currentIndex = mMinIndex;
+		//all processes and the event loop live in this thread. Completion and output
+		//of the processes is handled event driven instead of polling each process.
+		QEventLoop eventLoop;
+		mEventLoop = &eventLoop;
 		
-		while((!mActiveProcesses.empty() || (mMinIndex <= mMaxIndex)) && !mDoShutDown) {
-			
-			while(mActiveProcesses.size() < numberOfProcesses && currentIndex <= mMaxIndex) {
-				//create a new process.
-				
-				Core::log("Evaluating index: " + QString::number(currentIndex), true);
-				
-				QStringList parameter;
-				parameter << mJobFile;
-				parameter << QString::number(currentIndex);
-				currentIndex++;
-				
-				QProcess *proc = new QProcess();
-				proc->start("/bin/bash", parameter);
-				
-				mActiveProcesses.append(proc);
-				
-				//Core::log("size: " + QString::number(mActiveProcesses.size()) + " at " + QString::number(currentIndex) + " of max " + QString::number(mMaxIndex) + " procs: " + QString::number(numberOfProcesses), true);
-			}
-
-			if(mActiveProcesses.empty()) {
-				break;
-			}
-			
-			while(true) {
-				Core::getInstance()->executePendingTasks();
-				
-				QList<QProcess*> finishedProcesses;
-				
-				for(int i =  0; i < mActiveProcesses.size(); ++i) {
-					QProcess *proc = mActiveProcesses.at(i);
-					if(proc->waitForFinished(100)) {
-						finishedProcesses.append(proc);
-					}
-					Core::getInstance()->executePendingTasks();
-				}
-
-				if(!finishedProcesses.empty()) {
-					while(!finishedProcesses.empty()) {
-						QProcess *proc = finishedProcesses.at(0);
-						finishedProcesses.removeAll(proc);
-						mActiveProcesses.removeAll(proc);
-						
-						if(proc->exitCode() != 0) {
-							Core::log("MultiCoreEvaluationRunner: Problem with evaluation process. "
-									  "Exit code was " + QString::number(proc->exitCode()), true);
-						}
-						else {
-							Core::log("MultiCoreEvaluationRunner: An evaluation was finished...", true);
-						}
-						delete proc;
-					}
-					break;
-				}
-			}
-
+		QTimer taskTimer;
+		connect(&taskTimer, SIGNAL(timeout()), this, SLOT(processPendingTasks()), 
+				Qt::DirectConnection);
+		taskTimer.start(100);
+		
+		if(mUseWorkers->get()) {
+			startWorkers();
 		}
+		else {
+			startNextProcesses();
+		}
+		
+		if(!mActiveProcesses.empty() && !mDoShutDown) {
+			eventLoop.exec();
+		}
+		taskTimer.stop();
+		mEventLoop = 0;
+		
+		stopProcesses();
 		
 		Core::log("Multi-core evaluation was completed", true);
 		
@@ -286,6 +266,176 @@ namespace nerd {
 	}
 	
 	
+	/**
+	 * Starts a new process for each pending index as long as the pool is not full.
+	 */
+	void MultiCoreEvaluationRunner::startNextProcesses() {
+		while(mActiveProcesses.size() < mPoolSize && mCurrentIndex <= mMaxIndex) {
+			Core::log("Evaluating index: " + QString::number(mCurrentIndex), true);
+			
+			QStringList parameter;
+			parameter << mJobFile;
+			parameter << QString::number(mCurrentIndex);
+			mCurrentIndex++;
+			
+			QProcess *proc = new QProcess();
+			connect(proc, SIGNAL(finished(int, QProcess::ExitStatus)),
+					this, SLOT(processFinished()), Qt::DirectConnection);
+			proc->start("/bin/bash", parameter);
+			
+			mActiveProcesses.append(proc);
+		}
+	}
+	
+	
+	/**
+	 * Starts the persistent workers and assigns the first index to each of them.
+	 */
+	void MultiCoreEvaluationRunner::startWorkers() {
+		int numberOfWorkers = qMin(mPoolSize, mMaxIndex - mMinIndex + 1);
+		
+		for(int i = 0; i < numberOfWorkers; ++i) {
+			QStringList parameter;
+			parameter << mJobFile;
+			parameter << "worker";
+			
+			QProcess *proc = new QProcess();
+			connect(proc, SIGNAL(readyReadStandardOutput()),
+					this, SLOT(workerOutputAvailable()), Qt::DirectConnection);
+			connect(proc, SIGNAL(finished(int, QProcess::ExitStatus)),
+					this, SLOT(processFinished()), Qt::DirectConnection);
+			proc->start("/bin/bash", parameter);
+			
+			mActiveProcesses.append(proc);
+			mWorkerJobs.insert(proc, -1);
+			assignNextJob(proc);
+		}
+	}
+	
+	
+	/**
+	 * Sends the next pending index to the given worker. If there is no pending index,
+	 * the worker is told to quit.
+	 *
+	 * @return true if a new index was assigned.
+	 */
+	bool MultiCoreEvaluationRunner::assignNextJob(QProcess *worker) {
+		if(mCurrentIndex > mMaxIndex || mDoShutDown) {
+			mWorkerJobs.insert(worker, -1);
+			worker->write("quit\n");
+			worker->closeWriteChannel();
+			return false;
+		}
+		Core::log("Evaluating index: " + QString::number(mCurrentIndex), true);
+		
+		mWorkerJobs.insert(worker, mCurrentIndex);
+		worker->write(QString::number(mCurrentIndex).append("\n").toLatin1());
+		mCurrentIndex++;
+		return true;
+	}
+	
+	
+	void MultiCoreEvaluationRunner::processFinished() {
+		//sender() is not reliable for direct connections across threads, so all
+		//processes are checked.
+		for(int i = mActiveProcesses.size() - 1; i >= 0; --i) {
+			QProcess *proc = mActiveProcesses.at(i);
+			if(proc->state() != QProcess::NotRunning) {
+				continue;
+			}
+			mActiveProcesses.removeAt(i);
+			
+			if(mWorkerJobs.contains(proc)) {
+				int index = mWorkerJobs.take(proc);
+				if(index >= 0) {
+					Core::log("MultiCoreEvaluationRunner: Worker terminated during evaluation "
+							  "of index " + QString::number(index) + ". Exit code was " 
+							  + QString::number(proc->exitCode()), true);
+				}
+			}
+			else if(proc->exitCode() != 0) {
+				Core::log("MultiCoreEvaluationRunner: Problem with evaluation process. "
+						  "Exit code was " + QString::number(proc->exitCode()), true);
+			}
+			else {
+				Core::log("MultiCoreEvaluationRunner: An evaluation was finished...", true);
+			}
+			proc->deleteLater();
+		}
+		if(!mUseWorkers->get() && !mDoShutDown) {
+			startNextProcesses();
+		}
+		checkCompletion();
+	}
+	
+	
+	void MultiCoreEvaluationRunner::workerOutputAvailable() {
+		for(int i = 0; i < mActiveProcesses.size(); ++i) {
+			QProcess *proc = mActiveProcesses.at(i);
+			
+			while(proc->canReadLine()) {
+				QString line = QString::fromLatin1(proc->readLine()).trimmed();
+				
+				//other output of the worker (e.g. log messages) is ignored.
+				if(!line.startsWith("done ") && !line.startsWith("failed ")) {
+					continue;
+				}
+				int index = mWorkerJobs.value(proc, -1);
+				if(line.startsWith("failed ")) {
+					Core::log("MultiCoreEvaluationRunner: Evaluation of index " 
+							  + QString::number(index) + " failed.", true);
+				}
+				else {
+					Core::log("MultiCoreEvaluationRunner: An evaluation was finished...", true);
+				}
+				assignNextJob(proc);
+			}
+		}
+	}
+	
+	
+	void MultiCoreEvaluationRunner::processPendingTasks() {
+		Core::getInstance()->executePendingTasks();
+		checkCompletion();
+	}
+	
+	
+	void MultiCoreEvaluationRunner::checkCompletion() {
+		if(mEventLoop != 0 && (mActiveProcesses.empty() || mDoShutDown)) {
+			mEventLoop->quit();
+		}
+	}
+	
+	
+	/**
+	 * Terminates all processes that are still running (workers or evaluations that 
+	 * were interrupted by a shutdown) and destroys them. Workers are asked to quit 
+	 * first. Processes that do not terminate within a few seconds are killed.
+	 */
+	void MultiCoreEvaluationRunner::stopProcesses() {
+		while(!mActiveProcesses.empty()) {
+			QProcess *proc = mActiveProcesses.takeFirst();
+			disconnect(proc, 0, this, 0);
+			
+			if(proc->state() != QProcess::NotRunning) {
+				if(mWorkerJobs.contains(proc)) {
+					proc->write("quit\n");
+				}
+				proc->closeWriteChannel();
+				if(!proc->waitForFinished(5000)) {
+					Core::log("MultiCoreEvaluationRunner: Process did not terminate. [Killing]", 
+							  true);
+					proc->kill();
+					proc->waitForFinished(1000);
+				}
+			}
+			mWorkerJobs.remove(proc);
+			delete proc;
+		}
+		mWorkerJobs.clear();
+	}
+	
+	
 	StringValue* MultiCoreEvaluationRunner::getMessageValue() const {
 		return mMessageValue;
 	}
@@ -51,12 +51,27 @@
 #include "Event/Event.h"
 #include "Value/StringValue.h"
 #include "Value/IntValue.h"
+#include "Value/BoolValue.h"
 #include <QProcess>
+#include <QEventLoop>
+#include <QHash>
 
 namespace nerd {
 	
 	/**
 	 * MultiCoreEvaluationRunner.
+	 *
+	 * Evaluates the indices of a job script with a pool of local processes. The 
+	 * size of the pool is given by /Evaluation/NumberOfProcesses. Values <= 0 use 
+	 * one process per available core.
+	 *
+	 * By default each index is evaluated by a separate call of the job script.
+	 * If /Evaluation/UseWorkers is true, the job script is instead started once per
+	 * pool slot with the single argument "worker". Such a worker receives the indices
+	 * to evaluate line by line at stdin and has to report each completed index with 
+	 * a line "done <index> ..." (or "failed <index>") at stdout. This matches the
+	 * protocol of evaluation applications started with -worker, so that the 
+	 * simulators are kept alive between evaluations.
 	 */
 	class MultiCoreEvaluationRunner : public QThread, public virtual SystemObject, 
 									  public virtual EventListener 
@@ -82,15 +97,32 @@ namespace nerd {
 	protected:
 		virtual void run();
 		
+	private slots:
+		void processFinished();
+		void workerOutputAvailable();
+		void processPendingTasks();
+		
+	private:
+		void startNextProcesses();
+		void startWorkers();
+		bool assignNextJob(QProcess *worker);
+		void checkCompletion();
+		void stopProcesses();
+		
 	private:
 		bool mDoShutDown;
 		Event *mShutDownEvent;
 		StringValue *mMessageValue;
 		IntValue *mNumberOfProcesses;
+		BoolValue *mUseWorkers;
 		int mMinIndex;
 		int mMaxIndex;
+		int mCurrentIndex;
+		int mPoolSize;
 		QString mJobFile;
 		QList<QProcess*> mActiveProcesses;
+		QHash<QProcess*, int> mWorkerJobs;
+		QEventLoop *mEventLoop;
 		
 	};
 	
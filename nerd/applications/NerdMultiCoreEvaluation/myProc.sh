@@ -1,14 +1,32 @@
 #!/bin/bash
 
+evaluate() {
+	seconds=$(( (RANDOM%10+1)*100000 ))
+	#sleep $seconds
 
-echo Start $1
-seconds=$(( (RANDOM%10+1)*100000 ))
-#sleep $seconds
+	x=1
+	while [ $x -le $seconds ]
+	do
+	x=$(( $x + 1 ))
+	done
+}
 
-x=1
-while [ $x -le $seconds ]
+if [ "$1" == "worker" ]
+then
+#Persistent worker: read indices from stdin until quit is received.
+while read index
 do
-x=$(( $x + 1 ))
+	if [ "$index" == "quit" ]
+	then
+		break
+	fi
+	echo Start $index
+	evaluate
+	echo done $index
 done
+exit 0
+fi
 
+echo Start $1
+evaluate
 echo Done $1
@@ -168,6 +168,7 @@ void AutoStoreNetworksHelper::storeNetworks() {
 				QString onnFileName = fileName + ".onn";
 
 				//cerr << "Saving to " << onnFileName.toStdString().c_str() << endl;
+				NeuralNetworkIO::prepareNetworkForWriting(net);
 				QString xml = NeuralNetworkIONerdV1Xml::createXmlFromNetwork(net);
 
 				QFile file(onnFileName);
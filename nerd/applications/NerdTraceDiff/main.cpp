@@ -0,0 +1,97 @@
+/***************************************************************************
+ *   NERD - Neurodynamics and Evolutionary Robotics Development Toolkit    *
+ *                                                                         *
+ *   University of Osnabrueck, Germany                                     *
+ *   Institute of Cognitive Science                                        *
+ *   Neurocybernetics Group                                                *
+ *   http://www.ikw.uni-osnabrueck.de/~neurokybernetik/                    *
+ *                                                                         *
+ *   Project homepage: nerd.x-bot.org                                      *
+ *                                                                         *
+ *   Copyright (C) 2008 - 2013 by the Neurocybernetics Group Osnabrück     *
+ *   Contact: Christian Rempis                                             *
+ *   christian.rempis@uni-osnabrueck.de                                    *
+ *   Contributors: see contributors.txt in the nerd main directory.        *
+ *                                                                         *
+ *                                                                         *
+ *   Acknowledgments:                                                      *
+ *   The NERD Toolkit is part of the EU project ALEAR                      *
+ *   (Artificial Language Evolution on Autonomous Robots) www.ALEAR.eu     *
+ *   This work was funded (2008 - 2011) by EU-Project Number ICT 214856    *
+ *                                                                         *
+ *                                                                         *
+ *   License Agreement:                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ *                                                                         *
+ *   Publications based on work using the NERD kit have to state this      *
+ *   clearly by citing the NERD homepage and the NERD overview paper.      *  
+ ***************************************************************************/
+
+
+
+#include <QCoreApplication>
+#include <QStringList>
+#include <iostream>
+#include "Core/Core.h"
+#include "Util/StepTraceFile.h"
+
+
+using namespace std;
+using namespace nerd;
+
+/**
+ * nerdTraceDiff compares two evaluation traces written with -traceEvaluation 
+ * (e.g. from a serial and a parallel evaluation with the same fixed seed).
+ *
+ * Exit codes: 0 if the traces are equivalent, 1 if they diverge (the first 
+ * diverging step and channel are printed) and 2 if a trace could not be read.
+ */
+int main(int argc, char *argv[])
+{
+	QCoreApplication app(argc, argv);
+
+	QStringList args = app.arguments();
+	if(args.size() < 3 || args.size() > 4) {
+		cerr << "Usage: nerdTraceDiff <trace1> <trace2> [<tolerance>]" << endl
+			 << "  <tolerance>: maximal absolute difference of two values "
+			 << "(default 0 = bit exact)." << endl;
+		return 2;
+	}
+
+	double tolerance = 0.0;
+	if(args.size() == 4) {
+		bool ok = true;
+		tolerance = args.at(3).toDouble(&ok);
+		if(!ok || tolerance < 0.0) {
+			cerr << "Invalid tolerance [" << args.at(3).toStdString() << "]" << endl;
+			return 2;
+		}
+	}
+
+	QString report;
+	int result = StepTraceFile::compare(args.at(1), args.at(2), tolerance, report);
+
+	if(result == 2) {
+		cerr << report.toStdString() << endl;
+	}
+	else {
+		cout << report.toStdString() << endl;
+	}
+
+	Core::resetCore();
+	return result;
+}
@@ -60,6 +60,7 @@
 #include <QDir>
 #include <QDate>
 #include "Util/Tracer.h"
+#include "Util/Profiler.h"
 #include "Evolution/Evolution.h"
 
 #define TRACE(message)
@@ -300,6 +301,7 @@ EvaluationMethod* EvolutionManager::getDefaultEvaluationMethod() const {
  */
 bool EvolutionManager::processNextGeneration() {
 	TRACE("EvolutionManager::processNextGeneration");
+	PROFILE_SCOPE("EvolutionManager::processNextGeneration");
 
 	if(!mInitialized) {
 		return false;
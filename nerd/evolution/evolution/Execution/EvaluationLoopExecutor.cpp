@@ -58,6 +58,8 @@
 #include "Fitness/Fitness.h"
 #include "Fitness/FitnessManager.h"
 #include "EvolutionConstants.h"
+#include <QTextStream>
+#include <stdio.h>
 
 using namespace std;
 
@@ -67,8 +69,16 @@ namespace nerd{
 EvaluationLoopExecutor::EvaluationLoopExecutor() : EvaluationLoop(), mInitialized(false),
 				mRealTimeSupport(true), 
 				mSimulationDelay(0), mUseRealtimeValue(0), mTimeStepSizeValue(0), 
-				mNextIndividualEvent(0), mIndividualCompletedEvent(0), mCurrentIndividual(0) 
+				mNextIndividualEvent(0), mIndividualCompletedEvent(0), mCurrentIndividual(0),
+				mWorkerArgument(0)
 {
+	mWorkerArgument = new CommandLineArgument(
+		"evaluationWorker", "worker", "",
+		"Runs the application as persistent evaluation worker. Jobs are read line by line "
+		"from stdin in the format <jobId> [/Value/Path=value ...]. After each evaluated "
+		"individual the line \"done <jobId> <fitnessFunction>=<fitness> ...\" is written "
+		"to stdout. The worker terminates when stdin is closed or \"quit\" is received.",
+		0, 0, true);
 
 	ValueManager *manager = Core::getInstance()->getValueManager();
 
@@ -141,9 +151,13 @@ void EvaluationLoopExecutor::run() {
 	int currentIndividual = 0;
 	mCurrentIndividual->set(0);
 	
+	if(mWorkerArgument->getNumberOfEntries() > 0) {
+		executeWorkerJobs();
+	}
+	
 // 	TODO: make numberOfIndividuals etc. classvariables and update their value on reset
 	while((currentIndividual < numberOfIndividuals || unboundedNumberOfIndividuals) 
-			&& !mDoShutDown) 
+			&& !mDoShutDown && mWorkerArgument->getNumberOfEntries() == 0) 
 	{
 		Core::getInstance()->executePendingTasks();
 		mCurrentIndividual->set(currentIndividual++);
@@ -169,6 +183,102 @@ void EvaluationLoopExecutor::run() {
 }
 
 
+/**
+ * Evaluates individuals as long as jobs are provided at stdin. This allows a
+ * controlling process (e.g. NerdMultiCoreEvaluation) to keep a simulator
+ * alive for many evaluations and to avoid the startup costs (plugin loading,
+ * environment creation, physics initialization) for each individual.
+ *
+ * Each job line starts with a job id, followed by an optional list of
+ * Value assignments (/Path/To/Value=content) that are applied before the 
+ * evaluation starts. When the individual is completed, the fitness of all
+ * FitnessFunctions is reported with a single "done" line.
+ */
+void EvaluationLoopExecutor::executeWorkerJobs() {
+	QTextStream input(stdin, QIODevice::ReadOnly);
+	QTextStream output(stdout, QIODevice::WriteOnly);
+
+	output << "ready" << endl;
+
+	int currentIndividual = 0;
+	while(!mDoShutDown) {
+		Core::getInstance()->executePendingTasks();
+
+		QString line = input.readLine();
+		if(line.isNull()) {
+			break;
+		}
+		line = line.trimmed();
+		if(line == "") {
+			continue;
+		}
+		if(line == "quit") {
+			break;
+		}
+
+		QStringList assignments = line.split(" ", QString::SkipEmptyParts);
+		QString jobId = assignments.takeFirst();
+
+		if(!applyJobAssignments(assignments)) {
+			output << "failed " << jobId << endl;
+			continue;
+		}
+		Core::getInstance()->executePendingTasks();
+
+		mCurrentIndividual->set(currentIndividual++);
+		mCurrentTry->set(0);
+		mNextIndividualEvent->trigger();
+		executeEvaluationLoop();
+		mIndividualCompletedEvent->trigger();
+		Core::getInstance()->executePendingTasks();
+
+		if(mDoShutDown) {
+			output << "failed " << jobId << endl;
+			break;
+		}
+
+		QString result = "done " + jobId;
+		QList<FitnessFunction*> fitnessFunctions = 
+					Fitness::getFitnessManager()->getFitnessFunctions();
+		for(QListIterator<FitnessFunction*> i(fitnessFunctions); i.hasNext();) {
+			FitnessFunction *fitness = i.next();
+			result.append(" ").append(fitness->getName()).append("=")
+				  .append(QString::number(fitness->getFitness(), 'g', 15));
+		}
+		output << result << endl;
+	}
+}
+
+
+/**
+ * Applies a list of Value assignments of the form /Path/To/Value=content.
+ * Returns false if a Value could not be found or did not accept the content.
+ */
+bool EvaluationLoopExecutor::applyJobAssignments(const QStringList &assignments) {
+	ValueManager *vm = Core::getInstance()->getValueManager();
+
+	bool ok = true;
+	for(QListIterator<QString> i(assignments); i.hasNext();) {
+		QString assignment = i.next();
+		int separator = assignment.indexOf("=");
+		if(separator <= 0) {
+			Core::log("EvaluationLoopExecutor: Could not parse job assignment [" 
+					+ assignment + "].", true);
+			ok = false;
+			continue;
+		}
+		QString name = assignment.left(separator);
+		Value *value = vm->getValue(name);
+		if(value == 0 || !value->setValueFromString(assignment.mid(separator + 1))) {
+			Core::log("EvaluationLoopExecutor: Could not apply job assignment [" 
+					+ assignment + "].", true);
+			ok = false;
+		}
+	}
+	return ok;
+}
+
+
 bool EvaluationLoopExecutor::init() {
 	bool ok =  EvaluationLoop::init();
 
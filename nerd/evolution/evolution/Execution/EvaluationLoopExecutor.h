@@ -57,6 +57,8 @@
 #include <QTimer>
 #include <QMutex>
 #include <QWaitCondition>
+#include <QStringList>
+#include "PlugIns/CommandLineArgument.h"
 
 namespace nerd {
 
@@ -82,6 +84,8 @@ class EvaluationLoopExecutor : public QThread, public EvaluationLoop, public vir
 		virtual void run();
 		virtual void performWait();
 		virtual void pause();
+		virtual void executeWorkerJobs();
+		virtual bool applyJobAssignments(const QStringList &assignments);
 
 
 	public slots:
@@ -108,6 +112,7 @@ class EvaluationLoopExecutor : public QThread, public EvaluationLoop, public vir
 		Event *mIndividualCompletedEvent;
 		IntValue *mNumberOfIndividuals;
 		IntValue *mCurrentIndividual;
+		CommandLineArgument *mWorkerArgument;
 
 };
 }
@@ -54,6 +54,7 @@
 #include "PlugIns/PlugInManager.h"
 #include "PlugIns/ControllerFitnessFunctionParser.h"
 #include "PlugIns/SimObjectGroupPrinter.h"
+#include "Evaluation/EvaluationTraceRecorder.h"
 
 using namespace std;
 
@@ -121,6 +122,7 @@ bool NeuroAndSimEvaluationBaseApplication::setUp() {
 
 bool NeuroAndSimEvaluationBaseApplication::setupApplication() {
 	new SimObjectGroupPrinter();
+	new EvaluationTraceRecorder();
 	return true;
 }	
 
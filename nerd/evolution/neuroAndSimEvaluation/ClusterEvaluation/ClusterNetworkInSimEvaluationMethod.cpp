@@ -334,6 +334,7 @@ bool ClusterNetworkInSimEvaluationMethod::prepareEvaluation() {
 			}
 			QString errorMsg;
 			QString filePath = currentDirectory + networkName;
+			NeuralNetworkIO::prepareNetworkForWriting(network);
 			QString netXml = NeuralNetworkIONerdV1Xml::createXmlFromNetwork(network);
 			
 			QFile file(filePath);
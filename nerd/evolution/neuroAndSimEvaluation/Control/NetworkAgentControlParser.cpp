@@ -52,12 +52,14 @@
 #include "Fitness/Fitness.h"
 #include <iostream>
 #include "ModularNeuralNetwork/ModularNeuralNetwork.h"
+#include "Value/ValueManager.h"
 
 using namespace std;
 
 namespace nerd {
 
 NetworkAgentControlParser::NetworkAgentControlParser()
+	: mPhysicsEnvironmentChangedEvent(0), mNetworkFiles(0)
 {
 	mNetLoaderArgument = new CommandLineArgument("loadNet", "net", 
 			"<agent> <network> [<fitness>]", "Loads a neural network from file "
@@ -68,6 +70,14 @@ NetworkAgentControlParser::NetworkAgentControlParser()
 			"the last known network (first network in the list or recent networks in the editor.",
 			0, 2, true);
 
+	mNetworkFiles = new StringValue("");
+	mNetworkFiles->setDescription("Comma separated list of <agent>:<network> pairs. "
+			"Changing this value replaces the controllers of the given agents by the "
+			"networks loaded from file.");
+	//the networks are also reloaded if the same files are set again (e.g. changed on disk).
+	mNetworkFiles->setNotifyAllSetAttempts(true);
+	Core::getInstance()->getValueManager()->addValue("/Control/NetworkFiles", mNetworkFiles);
+
 	Neuro::install();
 	Core::getInstance()->addSystemObject(this);
 }
@@ -89,6 +99,16 @@ void NetworkAgentControlParser::eventOccured(Event *event) {
 	}
 }
 
+
+void NetworkAgentControlParser::valueChanged(Value *value) {
+	if(value == 0) {
+		return;
+	}
+	else if(value == mNetworkFiles) {
+		replaceNetworks(mNetworkFiles->get());
+	}
+}
+
 bool NetworkAgentControlParser::init() {
 	bool ok = true;
 
@@ -105,11 +125,17 @@ bool NetworkAgentControlParser::bind() {
 	
 	connectNetworksToInterfaces();
 
+	mNetworkFiles->addValueChangedListener(this);
+
 	return ok;
 }
 
 
 bool NetworkAgentControlParser::cleanUp() {
+	mNetworkFiles->removeValueChangedListener(this);
+	if(mPhysicsEnvironmentChangedEvent != 0) {
+		mPhysicsEnvironmentChangedEvent->removeEventListener(this);
+	}
 	return true;
 }
 
@@ -250,6 +276,68 @@ void NetworkAgentControlParser::connectNetworksToInterfaces() {
 }
 
 
+
+/**
+ * Replaces the controllers of the given agents with networks loaded from file.
+ * The previous networks are removed from the NeuralNetworkManager and destroyed.
+ *
+ * @param networkFiles a comma separated list of <agent>:<network> pairs.
+ */
+void NetworkAgentControlParser::replaceNetworks(const QString &networkFiles) {
+	NeuralNetworkManager *nnm = Neuro::getNeuralNetworkManager();
+	PhysicsManager *pm = Physics::getPhysicsManager();
+	bool replacedNetwork = false;
+
+	QStringList entries = networkFiles.split(",", QString::SkipEmptyParts);
+	for(QListIterator<QString> i(entries); i.hasNext();) {
+		QString entry = i.next().trimmed();
+		QString agentName = "";
+		QString networkFile = entry;
+
+		int separator = entry.indexOf(":");
+		if(separator >= 0) {
+			agentName = entry.left(separator);
+			networkFile = entry.mid(separator + 1);
+		}
+
+		SimObjectGroup *agent = 0;
+		if(agentName == "" && !pm->getSimObjectGroups().empty()) {
+			agent = pm->getSimObjectGroups().at(0);
+		}
+		else {
+			agent = pm->getSimObjectGroup(agentName);
+		}
+		if(agent == 0) {
+			Core::log(QString("NetworkAgentControlParser: Could not find an agent with name [")
+					.append(agentName).append("]! [Skipping]"));
+			continue;
+		}
+
+		QString errorMessage;
+		QList<QString> messages;
+		NeuralNetwork *net = NeuralNetworkIO::createNetworkFromFile(
+								networkFile, &errorMessage, &messages);
+		if(net == 0) {
+			Core::log(QString("NetworkAgentControlParser: Could not load network from file [")
+					.append(networkFile).append("]: ").append(errorMessage));
+			continue;
+		}
+
+		NeuralNetwork *oldNet = dynamic_cast<NeuralNetwork*>(agent->getController());
+		agent->setController(net);
+		if(oldNet != 0) {
+			nnm->removeNeuralNetwork(oldNet);
+			delete oldNet;
+		}
+		nnm->addNeuralNetwork(net);
+		net->reset();
+		replacedNetwork = true;
+	}
+
+	if(replacedNetwork) {
+		nnm->triggerCurrentNetworksReplacedEvent();
+	}
 }
 
 
+}
@@ -49,14 +49,22 @@
 #include "PlugIns/CommandLineArgument.h"
 #include "Event/EventListener.h"
 #include "Event/Event.h"
+#include "Value/StringValue.h"
+#include "Value/ValueChangedListener.h"
 
 namespace nerd {
 
 	/**
 	 * NetworkAgentControlParser.
+	 *
+	 * Networks can also be exchanged at runtime with Value /Control/NetworkFiles,
+	 * which takes a comma separated list of <agent>:<network> pairs. If <agent> is 
+	 * empty, the first available agent is used. This is used by persistent evaluation 
+	 * workers to evaluate a new network without restarting the application.
 	 */
 	class NetworkAgentControlParser : public virtual SystemObject, 
-									  public virtual EventListener 
+									  public virtual EventListener,
+									  public virtual ValueChangedListener
 	{
 	public:
 		NetworkAgentControlParser();
@@ -64,6 +72,7 @@ namespace nerd {
 
 		virtual QString getName() const;
 		virtual void eventOccured(Event *event);
+		virtual void valueChanged(Value *value);
 
 		virtual bool init();
 		virtual bool bind();
@@ -71,10 +80,12 @@ namespace nerd {
 
 	protected:
 		void connectNetworksToInterfaces();
+		void replaceNetworks(const QString &networkFiles);
 
 	private:
 		CommandLineArgument *mNetLoaderArgument;	
 		Event *mPhysicsEnvironmentChangedEvent;
+		StringValue *mNetworkFiles;
 	};
 
 }
@@ -0,0 +1,270 @@
+/***************************************************************************
+ *   NERD - Neurodynamics and Evolutionary Robotics Development Toolkit    *
+ *                                                                         *
+ *   University of Osnabrueck, Germany                                     *
+ *   Institute of Cognitive Science                                        *
+ *   Neurocybernetics Group                                                *
+ *   http://www.ikw.uni-osnabrueck.de/~neurokybernetik/                    *
+ *                                                                         *
+ *   Project homepage: nerd.x-bot.org                                      *
+ *                                                                         *
+ *   Copyright (C) 2008 - 2013 by the Neurocybernetics Group Osnabrück     *
+ *   Contact: Christian Rempis                                             *
+ *   christian.rempis@uni-osnabrueck.de                                    *
+ *   Contributors: see contributors.txt in the nerd main directory.        *
+ *                                                                         *
+ *                                                                         *
+ *   Acknowledgments:                                                      *
+ *   The NERD Toolkit is part of the EU project ALEAR                      *
+ *   (Artificial Language Evolution on Autonomous Robots) www.ALEAR.eu     *
+ *   This work was funded (2008 - 2011) by EU-Project Number ICT 214856    *
+ *                                                                         *
+ *                                                                         *
+ *   License Agreement:                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ *                                                                         *
+ *   Publications based on work using the NERD kit have to state this      *
+ *   clearly by citing the NERD homepage and the NERD overview paper.      *  
+ ***************************************************************************/
+
+
+
+#include "EvaluationTraceRecorder.h"
+#include "Core/Core.h"
+#include "Event/EventManager.h"
+#include "Value/ValueManager.h"
+#include "Value/InterfaceValue.h"
+#include "NerdConstants.h"
+#include "EvolutionConstants.h"
+#include "SimulationConstants.h"
+#include "Physics/Physics.h"
+#include "Physics/PhysicsManager.h"
+#include "Physics/SimObjectGroup.h"
+#include "Network/Neuro.h"
+#include "Network/NeuralNetworkManager.h"
+#include "Network/NeuralNetwork.h"
+#include "Network/Neuron.h"
+#include "Fitness/Fitness.h"
+#include "Fitness/FitnessManager.h"
+#include "Fitness/FitnessFunction.h"
+
+namespace nerd {
+
+
+/**
+ * Constructs a new EvaluationTraceRecorder.
+ */
+EvaluationTraceRecorder::EvaluationTraceRecorder()
+	: mNextTryEvent(0), mNextStepEvent(0), mPreStepCompletedEvent(0), mTryCompletedEvent(0),
+	  mCurrentIndividual(0), mCurrentTry(0), mCurrentStep(0), mSimulationSeed(0),
+	  mHasPendingStep(false)
+{
+	mTraceArgument = new CommandLineArgument("traceEvaluation", "trace", "<file>",
+			"Records the interface values, neuron activations and fitness increments "
+			"of each evaluation step to the binary trace <file>. Traces can be compared "
+			"with nerdTraceDiff.", 1, 0, true);
+
+	Core::getInstance()->addSystemObject(this);
+}
+
+
+/**
+ * Destructor.
+ */
+EvaluationTraceRecorder::~EvaluationTraceRecorder() {
+}
+
+
+QString EvaluationTraceRecorder::getName() const {
+	return "EvaluationTraceRecorder";
+}
+
+
+bool EvaluationTraceRecorder::init() {
+	if(mTraceArgument->getNumberOfEntries() == 0 
+		|| mTraceArgument->getEntryParameters(0).empty()) 
+	{
+		return true;
+	}
+	QString fileName = mTraceArgument->getEntryParameters(0).at(0);
+	if(!mTraceFile.create(fileName)) {
+		Core::log("EvaluationTraceRecorder: Could not create trace file [" 
+					+ fileName + "]", true);
+		return false;
+	}
+	return true;
+}
+
+
+bool EvaluationTraceRecorder::bind() {
+	if(!mTraceFile.isOpen()) {
+		return true;
+	}
+	EventManager *em = Core::getInstance()->getEventManager();
+	ValueManager *vm = Core::getInstance()->getValueManager();
+
+	mNextTryEvent = em->registerForEvent(EvolutionConstants::EVENT_EXECUTION_NEXT_TRY, this);
+	mNextStepEvent = em->registerForEvent(NerdConstants::EVENT_EXECUTION_NEXT_STEP, this);
+	mPreStepCompletedEvent = em->registerForEvent(
+				NerdConstants::EVENT_EXECUTION_PRE_STEP_COMPLETED, this);
+	mTryCompletedEvent = em->registerForEvent(
+				EvolutionConstants::EVENT_EXECUTION_TRY_COMPLETED, this);
+
+	if(mNextStepEvent == 0 || mPreStepCompletedEvent == 0) {
+		Core::log("EvaluationTraceRecorder: Could not find the step events. "
+				  "No trace is recorded.", true);
+		mTraceFile.close();
+		return true;
+	}
+
+	mCurrentIndividual = vm->getIntValue(EvolutionConstants::VALUE_EXECUTION_CURRENT_INDIVIDUAL);
+	mCurrentTry = vm->getIntValue(SimulationConstants::VALUE_EXECUTION_CURRENT_TRY);
+	mCurrentStep = vm->getIntValue(SimulationConstants::VALUE_EXECUTION_CURRENT_STEP);
+	mSimulationSeed = vm->getIntValue(SimulationConstants::VALUE_RANDOMIZATION_SIMULATION_SEED);
+
+	return true;
+}
+
+
+bool EvaluationTraceRecorder::cleanUp() {
+	if(mTraceFile.isOpen()) {
+		writePendingStep();
+		mTraceFile.close();
+	}
+	return true;
+}
+
+
+/**
+ * The state of a step is recorded when the step is completed (pre step completed), 
+ * the fitness increments are added when the fitness functions were updated 
+ * (i.e. at the next step or at the end of the try).
+ */
+void EvaluationTraceRecorder::eventOccured(Event *event) {
+	if(event == 0 || !mTraceFile.isOpen()) {
+		return;
+	}
+	else if(event == mPreStepCompletedEvent) {
+		writePendingStep();
+		recordStepState();
+	}
+	else if(event == mNextStepEvent || event == mTryCompletedEvent) {
+		writePendingStep();
+	}
+	else if(event == mNextTryEvent) {
+		writePendingStep();
+		mLastFitness.clear();
+	}
+}
+
+
+/**
+ * Collects the seed, the interface values and the neuron activations of the 
+ * current step. Channel names are only rebuilt if the observed objects changed.
+ */
+void EvaluationTraceRecorder::recordStepState() {
+	mPendingStep.mIndividual = mCurrentIndividual != 0 ? mCurrentIndividual->get() : 0;
+	mPendingStep.mTry = mCurrentTry != 0 ? mCurrentTry->get() : 0;
+	mPendingStep.mStep = mCurrentStep != 0 ? mCurrentStep->get() : 0;
+	mPendingStep.mValues.clear();
+	mCurrentSources.clear();
+
+	mPendingStep.mValues.append(mSimulationSeed != 0 ? mSimulationSeed->get() : 0.0);
+	mCurrentSources.append(mSimulationSeed);
+
+	QList<SimObjectGroup*> groups = Physics::getPhysicsManager()->getSimObjectGroups();
+	for(QListIterator<SimObjectGroup*> i(groups); i.hasNext();) {
+		SimObjectGroup *group = i.next();
+		QList<InterfaceValue*> values = group->getInputValues();
+		values << group->getOutputValues() << group->getInfoValues();
+		for(QListIterator<InterfaceValue*> j(values); j.hasNext();) {
+			InterfaceValue *value = j.next();
+			mPendingStep.mValues.append(value->get());
+			mCurrentSources.append(value);
+		}
+	}
+
+	QList<NeuralNetwork*> networks = Neuro::getNeuralNetworkManager()->getNeuralNetworks();
+	for(QListIterator<NeuralNetwork*> i(networks); i.hasNext();) {
+		QList<Neuron*> neurons = i.next()->getNeurons();
+		for(QListIterator<Neuron*> j(neurons); j.hasNext();) {
+			Neuron *neuron = j.next();
+			mPendingStep.mValues.append(neuron->getActivationValue().get());
+			mPendingStep.mValues.append(neuron->getOutputActivationValue().get());
+			mCurrentSources.append(neuron);
+		}
+	}
+
+	mFitnessFunctions = Fitness::getFitnessManager()->getFitnessFunctions();
+	for(QListIterator<FitnessFunction*> i(mFitnessFunctions); i.hasNext();) {
+		mCurrentSources.append(i.next());
+	}
+
+	if(mCurrentSources != mChannelSources) {
+		mChannelSources = mCurrentSources;
+		mChannels.clear();
+		mChannels.append("/Simulation/Seed");
+		for(QListIterator<SimObjectGroup*> i(groups); i.hasNext();) {
+			SimObjectGroup *group = i.next();
+			QList<InterfaceValue*> values = group->getInputValues();
+			values << group->getOutputValues() << group->getInfoValues();
+			for(QListIterator<InterfaceValue*> j(values); j.hasNext();) {
+				mChannels.append("/Interface/" + group->getName() + "/" + j.next()->getName());
+			}
+		}
+		for(int i = 0; i < networks.size(); ++i) {
+			QList<Neuron*> neurons = networks.at(i)->getNeurons();
+			for(QListIterator<Neuron*> j(neurons); j.hasNext();) {
+				QString prefix = "/Network/" + QString::number(i) + "/" 
+								 + QString::number(j.next()->getId());
+				mChannels.append(prefix + "/Activation");
+				mChannels.append(prefix + "/Output");
+			}
+		}
+		for(QListIterator<FitnessFunction*> i(mFitnessFunctions); i.hasNext();) {
+			mChannels.append("/Fitness/" + i.next()->getName());
+		}
+	}
+	mHasPendingStep = true;
+}
+
+
+/**
+ * Completes the pending step with the fitness increments and writes it to the trace.
+ */
+void EvaluationTraceRecorder::writePendingStep() {
+	if(!mHasPendingStep) {
+		return;
+	}
+	mHasPendingStep = false;
+
+	for(QListIterator<FitnessFunction*> i(mFitnessFunctions); i.hasNext();) {
+		FitnessFunction *fitnessFunction = i.next();
+		double fitness = fitnessFunction->getCurrentFitness();
+		mPendingStep.mValues.append(fitness - mLastFitness.value(fitnessFunction, 0.0));
+		mLastFitness.insert(fitnessFunction, fitness);
+	}
+
+	mTraceFile.setChannels(mChannels);
+	if(!mTraceFile.writeStep(mPendingStep)) {
+		Core::log("EvaluationTraceRecorder: Could not write trace. Recording stopped.", true);
+		mTraceFile.close();
+	}
+}
+
+
+}
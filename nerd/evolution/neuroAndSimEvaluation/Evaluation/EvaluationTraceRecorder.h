@@ -0,0 +1,117 @@
+/***************************************************************************
+ *   NERD - Neurodynamics and Evolutionary Robotics Development Toolkit    *
+ *                                                                         *
+ *   University of Osnabrueck, Germany                                     *
+ *   Institute of Cognitive Science                                        *
+ *   Neurocybernetics Group                                                *
+ *   http://www.ikw.uni-osnabrueck.de/~neurokybernetik/                    *
+ *                                                                         *
+ *   Project homepage: nerd.x-bot.org                                      *
+ *                                                                         *
+ *   Copyright (C) 2008 - 2013 by the Neurocybernetics Group Osnabrück     *
+ *   Contact: Christian Rempis                                             *
+ *   christian.rempis@uni-osnabrueck.de                                    *
+ *   Contributors: see contributors.txt in the nerd main directory.        *
+ *                                                                         *
+ *                                                                         *
+ *   Acknowledgments:                                                      *
+ *   The NERD Toolkit is part of the EU project ALEAR                      *
+ *   (Artificial Language Evolution on Autonomous Robots) www.ALEAR.eu     *
+ *   This work was funded (2008 - 2011) by EU-Project Number ICT 214856    *
+ *                                                                         *
+ *                                                                         *
+ *   License Agreement:                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ *                                                                         *
+ *   Publications based on work using the NERD kit have to state this      *
+ *   clearly by citing the NERD homepage and the NERD overview paper.      *  
+ ***************************************************************************/
+
+
+
+#ifndef NERDEvaluationTraceRecorder_H
+#define NERDEvaluationTraceRecorder_H
+
+#include <QString>
+#include <QList>
+#include <QHash>
+#include "Core/SystemObject.h"
+#include "Event/EventListener.h"
+#include "Event/Event.h"
+#include "PlugIns/CommandLineArgument.h"
+#include "Value/IntValue.h"
+#include "Util/StepTraceFile.h"
+
+namespace nerd {
+
+	class FitnessFunction;
+
+	/**
+	 * EvaluationTraceRecorder.
+	 *
+	 * Records the state of each evaluation step to a binary StepTraceFile if the
+	 * command line argument -traceEvaluation <file> is given. Each step contains
+	 * the simulation seed, all interface values of all SimObjectGroups, the activation
+	 * and output of all neurons of the current networks and the fitness increment 
+	 * of all fitness functions.
+	 *
+	 * Traces of two runs (e.g. a serial and a parallel evaluation of the same 
+	 * individuals with a fixed seed) can be compared with the nerdTraceDiff tool, which 
+	 * reports the first diverging step and channel.
+	 *
+	 * Without the command line argument the recorder does not register for any Event.
+	 */
+	class EvaluationTraceRecorder : public virtual SystemObject, public virtual EventListener {
+	public:
+		EvaluationTraceRecorder();
+		virtual ~EvaluationTraceRecorder();
+
+		virtual QString getName() const;
+
+		virtual bool init();
+		virtual bool bind();
+		virtual bool cleanUp();
+
+		virtual void eventOccured(Event *event);
+
+	private:
+		void recordStepState();
+		void writePendingStep();
+
+	private:
+		CommandLineArgument *mTraceArgument;
+		StepTraceFile mTraceFile;
+		Event *mNextTryEvent;
+		Event *mNextStepEvent;
+		Event *mPreStepCompletedEvent;
+		Event *mTryCompletedEvent;
+		IntValue *mCurrentIndividual;
+		IntValue *mCurrentTry;
+		IntValue *mCurrentStep;
+		IntValue *mSimulationSeed;
+		bool mHasPendingStep;
+		StepTrace mPendingStep;
+		QList<QString> mChannels;
+		QList<const void*> mChannelSources;
+		QList<const void*> mCurrentSources;
+		QList<FitnessFunction*> mFitnessFunctions;
+		QHash<FitnessFunction*, double> mLastFitness;
+	};
+
+}
+
+#endif
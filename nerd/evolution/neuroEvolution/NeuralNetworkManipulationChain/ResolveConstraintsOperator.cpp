@@ -54,7 +54,7 @@
 #include <iostream>
 #include <QListIterator>
 #include "Constraints/GroupConstraint.h"
-#include <QTime>
+#include "Constraints/ConstraintResolver.h"
 
 //#define OUT(messag)
 #define OUT(message) cerr << message
@@ -123,49 +123,23 @@ bool ResolveConstraintsOperator::applyOperator(Individual *individual, CommandEx
 		}
 	}
 
-	bool constraintsResolved = true;
+	//constraints that are still fulfilled since the last resolver run (e.g. of the parent
+	//network) and whose dependencies were not affected by mutations are skipped.
+	ConstraintResolver resolver;
+	resolver.setMaxNumberOfIterations(mMaxNumberOfResolverIterations->get());
+	resolver.setTimeout(10000);
+	resolver.setSkipResolvedConstraints(true);
+	resolver.setProcessPendingTasks(true);
+	resolver.setVerbose(verbose);
 
-	QTime stopWatch;
-	stopWatch.start();
+	bool constraintsResolved = resolver.resolve(groups, 0, trashcan); //TODO add executor
 
-	Core *core = Core::getInstance();
-
-	int i = 0;
-	for(; i < mMaxNumberOfResolverIterations->get(); ++i) {
-
-		if(verbose) {
-			Core::log("ConstraintResolver: Starting Resolver Iteration " + QString::number(i), true);
-		}
-
-		constraintsResolved = true;
-		
-		for(QListIterator<NeuronGroup*> g(groups); g.hasNext();) {
-			NeuronGroup *group = g.next();
-
-			QList<GroupConstraint*> constraints = group->getConstraints();
-
-			for(QListIterator<GroupConstraint*> c(constraints); c.hasNext();) {
-				GroupConstraint *constraint = c.next();
-
-				if(!constraint->applyConstraint(group, 0, trashcan)) { //TODO add executor
-					constraintsResolved = false;
-					
-					if(verbose) {
-						Core::log("ConstraintResolver: Failed resolving [" + constraint->getName() + "]", true);
-					}
-				}
-			}
-		}
-
-		if(constraintsResolved || stopWatch.elapsed() > 10000) {
-			break;
-		}
-		core->executePendingTasks();
-		if(core->isShuttingDown()) {
-			return false;
-		}
+	if(verbose) {
+		Core::log("ConstraintResolver: Resolver ran " + QString::number(resolver.getNumberOfIterations())
+				+ " iterations with " + QString::number(resolver.getNumberOfConstraintApplications())
+				+ " constraint applications (" 
+				+ QString::number(resolver.getNumberOfSkippedConstraints()) + " skipped)", true);
 	}
-// 	cerr << "Resolver ran " << i << " times for individual " << individual->getId() << endl;
 
 	while(!trashcan.empty()) {
 		NeuralNetworkElement *elem = trashcan.at(0);
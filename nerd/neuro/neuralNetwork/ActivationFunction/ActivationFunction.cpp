@@ -67,6 +67,22 @@ double ActivationFunction::calculateActivation(Neuron *owner) {
 	return 0.0;
 }
 
+
+/**
+ * Returns true if the function can be executed concurrently with the functions
+ * of other networks. Functions using global state during the network update 
+ * return false, so that their networks are not executed by a NeuralNetworkExecutionPool 
+ * worker. Examples are the global random number generator, whose numbers have to be
+ * drawn in the same order as in a sequential execution, and script engines, which may 
+ * only be used by the thread that created them.
+ *
+ * This contract also applies to SynapseFunction::isThreadSafe() and 
+ * TransferFunction::isThreadSafe().
+ */
+bool ActivationFunction::isThreadSafe() const {
+	return true;
+}
+
 bool ActivationFunction::equals(ActivationFunction *activationFunction) const {
 	return ParameterizedObject::equals(activationFunction);
 }
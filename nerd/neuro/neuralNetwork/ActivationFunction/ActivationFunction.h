@@ -65,6 +65,7 @@ namespace nerd {
 		virtual ActivationFunction* createCopy() const = 0;
 		virtual void reset(Neuron *owner) = 0;
 		virtual double calculateActivation(Neuron *owner);
+		virtual bool isThreadSafe() const;
 		
 		virtual bool equals(ActivationFunction *activationFunction) const;
 
@@ -49,6 +49,8 @@
 #include "Core/Core.h"
 #include "Network/Synapse.h"
 #include "Network/Neuron.h"
+#include "Math/Math.h"
+#include "NeuralNetworkConstants.h"
 
 using namespace std;
 
@@ -59,7 +61,7 @@ namespace nerd {
  * Constructs a new DelayLineActivationFunction.
  */
 DelayLineActivationFunction::DelayLineActivationFunction()
-	: ActivationFunction("DelayLine")
+	: ActivationFunction("DelayLine"), mPosition(0), mDelayLineDelay(0), mSynapseRevision(0)
 {
 	mDelay = new IntValue(2);
 
@@ -73,7 +75,8 @@ DelayLineActivationFunction::DelayLineActivationFunction()
  * @param other the DelayLineActivationFunction object to copy.
  */
 DelayLineActivationFunction::DelayLineActivationFunction(const DelayLineActivationFunction &other)
-	: Object(), ValueChangedListener(), ObservableNetworkElement(other), ActivationFunction(other)
+	: Object(), ValueChangedListener(), ObservableNetworkElement(other), ActivationFunction(other),
+	  mPosition(0), mDelayLineDelay(0), mSynapseRevision(0)
 {
 	mDelay = dynamic_cast<IntValue*>(getParameter("Delay"));
 }
@@ -89,7 +92,9 @@ ActivationFunction* DelayLineActivationFunction::createCopy() const {
 }
 
 void DelayLineActivationFunction::reset(Neuron*) {
-	mDelayedActivations.clear();
+	//the delay line is rebuilt (with synapse delays) at the next calculation.
+	mDelayLine.clear();
+	mPosition = 0;
 }
 
 
@@ -98,25 +103,70 @@ double DelayLineActivationFunction::calculateActivation(Neuron *owner) {
 	if(owner == 0) {
 		return 0.0;
 	}
-	double activation = owner->getBiasValue().get();
+	if(mDelayLine.empty() || mDelayLineDelay != mDelay->get()
+		|| mSynapseRevision != owner->getSynapseRevision())
+	{
+		updateDelayLine(owner);
+	}
 
-	QList<Synapse*> synapses = owner->getSynapses();
-	for(QListIterator<Synapse*> i(synapses); i.hasNext();) {
-		activation += i.next()->calculateActivation();
+	int size = mDelayLine.size();
+	int position = mPosition;
+	int delay = Math::max(0, mDelayLineDelay);
+	double *delayLine = mDelayLine.data();
+
+	delayLine[(position + delay) % size] += owner->getBiasValue().get();
+
+	Synapse* const *synapses = mSynapses.constData();
+	const int *synapseDelays = mSynapseDelays.constData();
+	int numberOfSynapses = mSynapses.size();
+	for(int i = 0; i < numberOfSynapses; ++i) {
+		delayLine[(position + delay + synapseDelays[i]) % size] += synapses[i]->calculateActivation();
 	}
 
-	int delay = mDelay->get();
+	double activation = delayLine[position];
+	delayLine[position] = 0.0;
+	mPosition = (position + 1) % size;
+
+	return activation;
+}
+
+/**
+ * Collects the incoming synapses with their delays and resizes the delay line 
+ * to the longest delay. Inputs that are already on their way keep their arrival step
+ * (as far as they fit into the new delay line).
+ */
+void DelayLineActivationFunction::updateDelayLine(Neuron *owner) {
+	mDelayLineDelay = mDelay->get();
+	mSynapseRevision = owner->getSynapseRevision();
 
-	mDelayedActivations.append(activation);
-	while(mDelayedActivations.size() > delay + 1) {
-		mDelayedActivations.takeFirst();
+	QList<Synapse*> synapses = owner->getSynapses();
+	mSynapses.resize(synapses.size());
+	mSynapseDelays.resize(synapses.size());
+
+	int maxSynapseDelay = 0;
+	for(int i = 0; i < synapses.size(); ++i) {
+		Synapse *synapse = synapses.at(i);
+		int synapseDelay = 0;
+		if(synapse->hasProperty(NeuralNetworkConstants::TAG_SYNAPSE_DELAY)) {
+			synapseDelay = Math::max(0, 
+					synapse->getProperty(NeuralNetworkConstants::TAG_SYNAPSE_DELAY).toInt());
+		}
+		mSynapses[i] = synapse;
+		mSynapseDelays[i] = synapseDelay;
+		maxSynapseDelay = Math::max(maxSynapseDelay, synapseDelay);
 	}
-	if(mDelayedActivations.size() == delay + 1) {
-		return mDelayedActivations.takeFirst();
+
+	int size = Math::max(0, mDelayLineDelay) + maxSynapseDelay + 1;
+	QVector<double> delayLine(size, 0.0);
+	int oldSize = mDelayLine.size();
+	for(int i = 0; i < oldSize && i < size; ++i) {
+		delayLine[i] = mDelayLine.at((mPosition + i) % oldSize);
 	}
-	return 0.0;
+	mDelayLine = delayLine;
+	mPosition = 0;
 }
 
+
 bool DelayLineActivationFunction::equals(ActivationFunction *activationFunction) const {
 	if(ActivationFunction::equals(activationFunction) == false) {
 		return false;
@@ -47,14 +47,25 @@
 
 #include <QString>
 #include <QHash>
+#include <QVector>
 #include "Value/IntValue.h"
 #include "ActivationFunction/ActivationFunction.h"
 
 namespace nerd {
 
+	class Synapse;
+
 	/**
 	 * DelayLineActivationFunction.
 	 *
+	 * Returns the summed input (bias and synapses) of the neuron with a delay of 
+	 * "Delay" steps. Each incoming synapse may add its own delay with the synapse 
+	 * property SynapseDelay (in steps). 
+	 *
+	 * The delayed inputs are accumulated in a circular buffer of the size of the longest
+	 * delay, where each entry holds the summed input arriving in one of the next steps. 
+	 * Thus a step costs O(synapses), independent of the delay length. The buffer and the
+	 * synapse delays are set up at reset and whenever the synapses or the delay change.
 	 */
 	class DelayLineActivationFunction : public ActivationFunction {
 	public:
@@ -69,9 +80,17 @@ namespace nerd {
 
 		bool equals(ActivationFunction *activationFunction) const;
 
+	private:
+		void updateDelayLine(Neuron *owner);
+
 	private:
 		IntValue *mDelay;
-		QList<double> mDelayedActivations;
+		QVector<double> mDelayLine;
+		int mPosition;
+		int mDelayLineDelay;
+		int mSynapseRevision;
+		QVector<Synapse*> mSynapses;
+		QVector<int> mSynapseDelays;
 	};
 
 }
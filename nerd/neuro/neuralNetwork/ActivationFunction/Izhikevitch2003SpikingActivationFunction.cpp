@@ -54,7 +54,7 @@ using namespace std;
 namespace nerd {
 
 Izhikevitch2003SpikingActivationFunction::Izhikevitch2003SpikingActivationFunction()
-	: ActivationFunction("Izhikevitch2003")
+	: ActivationFunction("Izhikevitch2003"), mStationary(false)
 {
 	mMembranePotential_v = new DoubleValue(-70.0);
 	mMembraneRecovery_u = new DoubleValue(-14.0);
@@ -98,7 +98,8 @@ Izhikevitch2003SpikingActivationFunction::Izhikevitch2003SpikingActivationFuncti
 
 Izhikevitch2003SpikingActivationFunction::Izhikevitch2003SpikingActivationFunction(
 			const Izhikevitch2003SpikingActivationFunction &other)
-	: Object(), ValueChangedListener(), ObservableNetworkElement(other), ActivationFunction(other)
+	: Object(), ValueChangedListener(), ObservableNetworkElement(other), ActivationFunction(other),
+	  mStationary(false)
 {
 	mMembranePotential_v = dynamic_cast<DoubleValue*>(getParameter("v"));
 	mMembraneRecovery_u = dynamic_cast<DoubleValue*>(getParameter("u"));
@@ -130,12 +131,13 @@ void Izhikevitch2003SpikingActivationFunction::reset(Neuron*) {
 	mMembraneRecovery_u->set(mSubthresholdSensitivityRelation_b->get() 
 								* mMembranePotential_v->get());
 	mInputCurrent->set(0.0);
+	mStationary = false;
 }
 
 
 double Izhikevitch2003SpikingActivationFunction::calculateActivation(Neuron *owner) {
-	ActivationFunction::calculateActivation(owner);
 	if(owner == 0) {
+		ActivationFunction::calculateActivation(owner);
 		return 0.0;
 	}
 	double activation = owner->getBiasValue().get();
@@ -145,9 +147,27 @@ double Izhikevitch2003SpikingActivationFunction::calculateActivation(Neuron *own
 		activation += i.next()->calculateActivation();
 	}
 	
+	return integrate(owner, activation);
+}
+
+
+/**
+ * Advances the neuron state by one step of size dt with the given input current
+ * (bias plus synaptic input). This is used by calculateActivation() and by the
+ * SpikingEventEngine, which accumulates the synaptic input itself.
+ *
+ * @return the new membrane potential.
+ */
+double Izhikevitch2003SpikingActivationFunction::integrate(Neuron *owner, double inputCurrent) {
+	ActivationFunction::calculateActivation(owner);
+
+	double activation = inputCurrent;
+	
 	mInputCurrent->set(activation);
 	
 	double v = mMembranePotential_v->get();
+	double previousV = v;
+	double previousU = mMembraneRecovery_u->get();
 	
 	if(v >= 30.0) {
 		mMembranePotential_v->set(mRestValueAfterSpike_c->get());
@@ -190,9 +210,23 @@ double Izhikevitch2003SpikingActivationFunction::calculateActivation(Neuron *own
 //         trace[1,i] = n.u
 //     return trace
 
+	//the update is deterministic: with the same input, a fixed point stays a fixed point.
+	mStationary = (mMembranePotential_v->get() == previousV) 
+					&& (mMembraneRecovery_u->get() == previousU);
+
 	return mMembranePotential_v->get();
 }
 
+
+/**
+ * Returns true if the last call of integrate() did not change the state (v, u) of 
+ * the neuron. In this case, further updates with the same input current will also 
+ * leave the state unchanged, so they can be skipped.
+ */
+bool Izhikevitch2003SpikingActivationFunction::isStationary() const {
+	return mStationary;
+}
+
 bool Izhikevitch2003SpikingActivationFunction::equals(ActivationFunction *activationFunction) const {
 	if(ActivationFunction::equals(activationFunction) == false) {
 		return false;
@@ -69,6 +69,8 @@ namespace nerd {
 
 		virtual void reset(Neuron *owner);
 		virtual double calculateActivation(Neuron *owner);
+		double integrate(Neuron *owner, double inputCurrent);
+		bool isStationary() const;
 
 		bool equals(ActivationFunction *activationFunction) const;
 		
@@ -84,6 +86,7 @@ namespace nerd {
 		DoubleValue *mY;
 		IntValue *mRecoveryUpdateMode_du;
 		DoubleValue *mInputCurrent;
+		bool mStationary;
 	};
 
 }
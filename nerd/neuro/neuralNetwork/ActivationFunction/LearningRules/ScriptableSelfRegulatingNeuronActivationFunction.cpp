@@ -144,6 +144,11 @@ ActivationFunction* ScriptableSelfRegulatingNeuronActivationFunction::createCopy
 	return new ScriptableSelfRegulatingNeuronActivationFunction(*this);
 }
 
+
+bool ScriptableSelfRegulatingNeuronActivationFunction::isThreadSafe() const {
+	return false;
+}
+
 void ScriptableSelfRegulatingNeuronActivationFunction::reset(Neuron *owner) {
 	SelfRegulatingNeuronActivationFunction::reset(owner);
 }
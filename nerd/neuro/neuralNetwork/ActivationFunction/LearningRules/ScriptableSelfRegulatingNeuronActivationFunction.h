@@ -75,6 +75,7 @@ namespace nerd {
 		virtual ~ScriptableSelfRegulatingNeuronActivationFunction();
 
 		virtual ActivationFunction* createCopy() const;
+		virtual bool isThreadSafe() const;
 
 		virtual void reset(Neuron *owner);
 		virtual double calculateActivation(Neuron *owner);
@@ -142,6 +142,11 @@ ActivationFunction* ScriptableActivationFunction::createCopy() const {
 	return new ScriptableActivationFunction(*this);
 }
 
+
+bool ScriptableActivationFunction::isThreadSafe() const {
+	return false;
+}
+
 QString ScriptableActivationFunction::getName() const {
 	return NeuroModulatorActivationFunction::getName();
 }
@@ -71,6 +71,7 @@ namespace nerd {
 		virtual ~ScriptableActivationFunction();
 
 		virtual ActivationFunction* createCopy() const;
+		virtual bool isThreadSafe() const;
 		virtual QString getName() const;
 		virtual void valueChanged(Value *value);
 		
@@ -127,6 +127,14 @@ ActivationFunction* SignalGeneratorActivationFunction::createCopy() const {
 	return new SignalGeneratorActivationFunction(*this);
 }
 
+
+/**
+ * The signal durations and amplitudes are drawn from the global random number generator.
+ */
+bool SignalGeneratorActivationFunction::isThreadSafe() const {
+	return false;
+}
+
 void SignalGeneratorActivationFunction::valueChanged(Value *value) {
 	ActivationFunction::valueChanged(value);
 	if(value == 0) {
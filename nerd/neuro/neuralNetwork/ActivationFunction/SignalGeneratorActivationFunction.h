@@ -65,6 +65,7 @@ namespace nerd {
 		virtual ~SignalGeneratorActivationFunction();
 
 		virtual ActivationFunction* createCopy() const;
+		virtual bool isThreadSafe() const;
 
 		virtual void valueChanged(Value *value);
 
@@ -172,6 +172,28 @@ bool ConnectionSymmetryConstraint::isValid(NeuronGroup *owner) {
 }
 
 
+/**
+ * Only synapses are changed: the neurons of the owner group are paired with the
+ * neurons of the target group (network element pairs), and the synapses of each
+ * target neuron are mirrored to its paired owner neuron. The neurons themselves are
+ * only read, but adding or removing neurons in either group changes the pairing, 
+ * and the neurons at the other end of a synapse decide which connection mode applies.
+ */
+bool ConnectionSymmetryConstraint::getDependencies(NeuronGroup *owner, QList<NeuralNetworkElement*> &elements) {
+	if(owner == 0 || owner->getOwnerNetwork() == 0) {
+		return false;
+	}
+	NeuronGroup *target = ModularNeuralNetwork::selectNeuronGroupById(mTargetGroupId->get(),
+									owner->getOwnerNetwork()->getNeuronGroups());
+	if(target == 0) {
+		return false;
+	}
+	GroupConstraint::addGroupDependencies(owner, elements);
+	GroupConstraint::addGroupDependencies(target, elements);
+	return true;
+}
+
+
 bool ConnectionSymmetryConstraint::applyConstraint(NeuronGroup *owner, CommandExecutor*,
 									 QList<NeuralNetworkElement*> &trashcan)
 {
@@ -42,6 +42,7 @@
  ***************************************************************************/
 
 #include "ConstraintManager.h"
+#include "Constraints/ConstraintResolver.h"
 #include "Core/Core.h"
 #include "NeuralNetworkConstants.h"
 #include "ModularNeuralNetwork/ModularNeuralNetwork.h"
@@ -297,52 +298,15 @@ bool ConstraintManager::runConstraints(QList<NeuronGroup*> groups, int maxIterat
 	}
 
 	errors.clear();
-	
-	bool resolverSuccess = false;
-
-	//resolve constraints
-	for(int i = 0; i < maxIterations; ++i) {
-		bool allOk = true;
-		
-		if(collectOnlyErrorsOfLastResolverRun) {
-			errors.clear();
-		}
-		
-		errors.append(QString("-- Resolver Run ").append(QString::number(i)).append(" --"));
-
-		for(QListIterator<NeuronGroup*> g(groups); g.hasNext();) {
-			NeuronGroup *group = g.next();
 
-			QStringList resolverErrors;
-			QStringList resolverWarnings;
-			if(!ConstraintManager::runGroupConstraints(group, 1, executor, trashcan, 
-													resolverErrors, resolverWarnings)) 
-			{
-				allOk = false;
-			}
+	//resolve constraints (only constraints affected by changes are re-applied).
+	ConstraintResolver resolver;
+	resolver.setMaxNumberOfIterations(maxIterations);
+	resolver.setCollectOnlyErrorsOfLastIteration(collectOnlyErrorsOfLastResolverRun);
 
-			if(!resolverErrors.empty()) {
-				errors.append(QString("> ") + group->getName() + " (" + QString::number(group->getId()) 
-								+ ") Errors:");
-				errors << resolverErrors;
-			}
-			if(!resolverWarnings.empty()) {
-				errors.append(QString("> ") + group->getName() + " (" + QString::number(group->getId()) 
-								+ ") Warnings:");
-				errors << resolverWarnings;
-			}
-		}
+	bool resolverSuccess = resolver.resolve(groups, executor, trashcan);
+	errors << resolver.getErrors();
 
-		if(allOk) {
-// 			ConstraintManager::mMarkConstrainedElements = false;
-// 			if(sConstraintManager != 0) {
-// 				sConstraintManager->notifyConstraintsUpdated();
-// 			}
-// 			return true;
-			resolverSuccess = true;
-			break;
-		}
-	}
 	ConstraintManager::mMarkConstrainedElements = false;
 	if(sConstraintManager != 0) {
 		sConstraintManager->notifyConstraintsUpdated();
@@ -356,7 +320,7 @@ bool ConstraintManager::runConstraints(QList<NeuronGroup*> groups, int maxIterat
 		for(QListIterator<NeuralNetworkElement*> i(allElements); i.hasNext();) {
 			NeuralNetworkElement *elem = i.next();
 			
-			elem->removePropertyByPattern(NeuralNetworkConstants::PROP_PREFIX_CONSTRAINT_TEMP + ".*");
+			elem->removePropertiesByPrefix(NeuralNetworkConstants::PROP_PREFIX_CONSTRAINT_TEMP);
 		}
 	}
 	
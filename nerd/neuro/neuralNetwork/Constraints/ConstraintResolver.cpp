@@ -0,0 +1,698 @@
+/***************************************************************************
+ *   NERD - Neurodynamics and Evolutionary Robotics Development Toolkit    *
+ *                                                                         *
+ *   University of Osnabrueck, Germany                                     *
+ *   Institute of Cognitive Science                                        *
+ *   Neurocybernetics Group                                                *
+ *   http://www.ikw.uni-osnabrueck.de/~neurokybernetik/                    *
+ *                                                                         *
+ *   Project homepage: nerd.x-bot.org                                      *
+ *                                                                         *
+ *   Copyright (C) 2008 - 2013 by the Neurocybernetics Group Osnabrück     *
+ *   Contact: Christian Rempis                                             *
+ *   christian.rempis@uni-osnabrueck.de                                    *
+ *   Contributors: see contributors.txt in the nerd main directory.        *
+ *                                                                         *
+ *                                                                         *
+ *   Acknowledgments:                                                      *
+ *   The NERD Toolkit is part of the EU project ALEAR                      *
+ *   (Artificial Language Evolution on Autonomous Robots) www.ALEAR.eu     *
+ *   This work was funded (2008 - 2011) by EU-Project Number ICT 214856    *
+ *                                                                         *
+ *                                                                         *
+ *   License Agreement:                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ *                                                                         *
+ *   Publications based on work using the NERD kit have to state this      *
+ *   clearly by citing the NERD homepage and the NERD overview paper.      *  
+ ***************************************************************************/
+
+
+#include "ConstraintResolver.h"
+#include "ModularNeuralNetwork/ModularNeuralNetwork.h"
+#include "ModularNeuralNetwork/NeuronGroup.h"
+#include "ModularNeuralNetwork/NeuroModule.h"
+#include "Network/Neuron.h"
+#include "Network/Synapse.h"
+#include "TransferFunction/TransferFunction.h"
+#include "ActivationFunction/ActivationFunction.h"
+#include "SynapseFunction/SynapseFunction.h"
+#include "NeuralNetworkConstants.h"
+#include "Core/Core.h"
+#include "Value/Value.h"
+#include "Math/Vector3D.h"
+#include <QSet>
+#include <QTime>
+#include <QListIterator>
+#include <iostream>
+
+using namespace std;
+
+namespace nerd {
+
+static const quint64 SIGNATURE_OFFSET = 14695981039346656037ULL;
+static const quint64 SIGNATURE_PRIME = 1099511628211ULL;
+
+
+static quint64 addToSignature(quint64 signature, const void *data, int size) {
+	const unsigned char *bytes = static_cast<const unsigned char*>(data);
+	for(int i = 0; i < size; ++i) {
+		signature ^= bytes[i];
+		signature *= SIGNATURE_PRIME;
+	}
+	return signature;
+}
+
+static quint64 addToSignature(quint64 signature, quint64 value) {
+	return addToSignature(signature, &value, sizeof(quint64));
+}
+
+static quint64 addToSignature(quint64 signature, double value) {
+	return addToSignature(signature, &value, sizeof(double));
+}
+
+static quint64 addToSignature(quint64 signature, const QString &value) {
+	signature = addToSignature(signature, (quint64) value.size());
+	return addToSignature(signature, value.constData(), value.size() * sizeof(QChar));
+}
+
+static quint64 addToSignature(quint64 signature, ParameterizedObject *object) {
+	if(object == 0) {
+		return addToSignature(signature, (quint64) 0);
+	}
+	signature = addToSignature(signature, object->getName());
+	QList<Value*> parameters = object->getParameters();
+	for(QListIterator<Value*> i(parameters); i.hasNext();) {
+		Value *value = i.next();
+		signature = addToSignature(signature, value == 0 ? QString("") : value->getValueAsString());
+	}
+	return signature;
+}
+
+
+ConstraintResolver::ConstraintResolver()
+	: mMaxNumberOfIterations(50), mTimeout(0), mSkipResolvedConstraints(false),
+	  mProcessPendingTasks(false), mCollectOnlyErrorsOfLastIteration(false), mVerbose(false),
+	  mNetwork(0),
+	  mNumberOfIterations(0), mNumberOfApplications(0), mNumberOfSkippedConstraints(0)
+{
+}
+
+ConstraintResolver::~ConstraintResolver() {
+}
+
+
+void ConstraintResolver::setMaxNumberOfIterations(int iterations) {
+	mMaxNumberOfIterations = iterations;
+}
+
+
+int ConstraintResolver::getMaxNumberOfIterations() const {
+	return mMaxNumberOfIterations;
+}
+
+
+/**
+ * Sets the maximal time (in ms) the resolver may spend. The timeout is checked between
+ * two resolver iterations. A timeout <= 0 disables the check.
+ */
+void ConstraintResolver::setTimeout(int milliseconds) {
+	mTimeout = milliseconds;
+}
+
+
+int ConstraintResolver::getTimeout() const {
+	return mTimeout;
+}
+
+
+/**
+ * If true, constraints with dependency information are not applied if their
+ * dependencies did not change since their last successful resolver run.
+ */
+void ConstraintResolver::setSkipResolvedConstraints(bool skip) {
+	mSkipResolvedConstraints = skip;
+}
+
+
+bool ConstraintResolver::isSkippingResolvedConstraints() const {
+	return mSkipResolvedConstraints;
+}
+
+
+/**
+ * If true, Core::executePendingTasks() is called between the resolver iterations
+ * and the resolver stops when the Core is shutting down.
+ */
+void ConstraintResolver::setProcessPendingTasks(bool process) {
+	mProcessPendingTasks = process;
+}
+
+
+void ConstraintResolver::setCollectOnlyErrorsOfLastIteration(bool onlyLast) {
+	mCollectOnlyErrorsOfLastIteration = onlyLast;
+}
+
+
+/**
+ * If true, the start of each resolver iteration and each failed constraint are 
+ * logged with Core::log().
+ */
+void ConstraintResolver::setVerbose(bool verbose) {
+	mVerbose = verbose;
+}
+
+
+/**
+ * Resolves all constraints of the given groups.
+ *
+ * @param groups the groups whose constraints should be resolved. All groups have
+ *        to be part of the same ModularNeuralNetwork.
+ * @param executor the executor passed to GroupConstraint::applyConstraint().
+ * @param trashcan collects all elements removed by the constraints.
+ * @return true if all constraints are fulfilled.
+ */
+bool ConstraintResolver::resolve(QList<NeuronGroup*> groups, CommandExecutor *executor,
+								 QList<NeuralNetworkElement*> &trashcan)
+{
+	clear();
+
+	for(QListIterator<NeuronGroup*> i(groups); i.hasNext() && mNetwork == 0;) {
+		NeuronGroup *group = i.next();
+		if(group != 0) {
+			mNetwork = group->getOwnerNetwork();
+		}
+	}
+
+	//build the worklist
+	for(QListIterator<NeuronGroup*> g(groups); g.hasNext();) {
+		NeuronGroup *group = g.next();
+		if(group == 0) {
+			continue;
+		}
+		QList<GroupConstraint*> constraints = group->getConstraints();
+		for(QListIterator<GroupConstraint*> c(constraints); c.hasNext();) {
+			Entry entry;
+			entry.mGroup = group;
+			entry.mConstraint = c.next();
+			entry.mDirty = true;
+			entry.mLocal = false;
+			mEntries.append(entry);
+
+			updateDependencies(mEntries.size() - 1);
+		}
+	}
+
+	if(mNetwork != 0) {
+		QList<NeuralNetworkElement*> elements;
+		mNetwork->getNetworkElements(elements);
+		for(QListIterator<NeuralNetworkElement*> i(elements); i.hasNext();) {
+			NeuralNetworkElement *element = i.next();
+			mSignatures.insert(element, calculateElementSignature(element));
+		}
+		for(int i = 0; i < mEntries.size(); ++i) {
+			GroupConstraint *constraint = mEntries.at(i).mConstraint;
+			mConstraintSignatures.insert(constraint, calculateConstraintSignature(constraint));
+		}
+
+		if(mSkipResolvedConstraints) {
+			for(int i = 0; i < mEntries.size(); ++i) {
+				Entry &entry = mEntries[i];
+				if(entry.mLocal && entry.mConstraint->getResolvedSignature() != 0
+					&& entry.mConstraint->getResolvedSignature()
+						== calculateSignature(entry.mDependencies, entry.mConstraintDependencies,
+										  entry.mConstraint, entry.mGroup))
+				{
+					entry.mDirty = false;
+					++mNumberOfSkippedConstraints;
+				}
+			}
+		}
+	}
+
+	QTime stopWatch;
+	stopWatch.start();
+
+	Core *core = Core::getInstance();
+	bool resolved = false;
+
+	for(int i = 0; i < mMaxNumberOfIterations; ++i) {
+		mNumberOfIterations = i + 1;
+
+		if(mVerbose) {
+			Core::log("ConstraintResolver: Starting Resolver Iteration " + QString::number(i), true);
+		}
+
+		if(mCollectOnlyErrorsOfLastIteration) {
+			mErrors.clear();
+		}
+		mErrors.append(QString("-- Resolver Run ").append(QString::number(i)).append(" --"));
+
+		QHash<NeuronGroup*, QStringList> groupErrors;
+		QHash<NeuronGroup*, QStringList> groupWarnings;
+		QList<int> appliedGlobalEntries;
+
+		for(int j = 0; j < mEntries.size(); ++j) {
+			Entry &entry = mEntries[j];
+
+			//without a network no changes can be tracked: apply everything.
+			if(!entry.mDirty && mNetwork != 0) {
+				continue;
+			}
+
+			GroupConstraint *constraint = entry.mConstraint;
+			constraint->setErrorMessage("");
+			entry.mDirty = !constraint->applyConstraint(entry.mGroup, executor, trashcan);
+			++mNumberOfApplications;
+
+			if(entry.mDirty) {
+				if(mVerbose) {
+					Core::log("ConstraintResolver: Failed resolving [" + constraint->getName() + "]", true);
+				}
+				groupErrors[entry.mGroup] << constraint->getName() + ": "
+											+ constraint->getErrorMessage();
+			}
+			if(constraint->getWarningMessage() != "") {
+				groupWarnings[entry.mGroup] << constraint->getName() + ": "
+											+ constraint->getWarningMessage();
+			}
+
+			if(mNetwork == 0) {
+				continue;
+			}
+			updateConstraintSignature(j);
+
+			if(mEntries.at(j).mLocal) {
+				QSet<NeuralNetworkElement*> oldDependencies =
+						QSet<NeuralNetworkElement*>::fromList(entry.mDependencies);
+				updateDependencies(j);
+				for(QListIterator<NeuralNetworkElement*> k(mEntries.at(j).mDependencies); k.hasNext();) {
+					oldDependencies.remove(k.next());
+				}
+				//elements that left the dependencies may have been removed from the network.
+				for(QSetIterator<NeuralNetworkElement*> k(oldDependencies); k.hasNext();) {
+					NeuralNetworkElement *element = k.next();
+					if(mSignatures.remove(element) > 0) {
+						markChanged(element, j);
+					}
+				}
+				updateSignatures(mEntries.at(j).mDependencies, j);
+			}
+			if(!mEntries.at(j).mLocal) {
+				appliedGlobalEntries.append(j);
+			}
+		}
+
+		//the changes of global constraints are detected once per iteration.
+		if(!appliedGlobalEntries.empty()) {
+			//with several global constraints the cause of a change is unknown.
+			updateNetworkSignatures(appliedGlobalEntries.size() == 1 
+										? appliedGlobalEntries.first() : -1);
+		}
+
+		for(QListIterator<NeuronGroup*> g(groups); g.hasNext();) {
+			NeuronGroup *group = g.next();
+			if(group == 0) {
+				continue;
+			}
+			if(groupErrors.contains(group)) {
+				mErrors.append(QString("> ") + group->getName() + " ("
+						+ QString::number(group->getId()) + ") Errors:");
+				mErrors << groupErrors.value(group);
+			}
+			if(groupWarnings.contains(group)) {
+				mErrors.append(QString("> ") + group->getName() + " ("
+						+ QString::number(group->getId()) + ") Warnings:");
+				mErrors << groupWarnings.value(group);
+			}
+		}
+
+		resolved = true;
+		for(int j = 0; j < mEntries.size(); ++j) {
+			if(mEntries.at(j).mDirty) {
+				resolved = false;
+				break;
+			}
+		}
+		if(resolved) {
+			break;
+		}
+		if(mTimeout > 0 && stopWatch.elapsed() > mTimeout) {
+			break;
+		}
+		if(mProcessPendingTasks) {
+			core->executePendingTasks();
+			if(core->isShuttingDown()) {
+				break;
+			}
+		}
+	}
+
+	//remember the resolved state of all constraints with dependency information.
+	for(int i = 0; i < mEntries.size(); ++i) {
+		Entry &entry = mEntries[i];
+		if(!entry.mLocal || !resolved || mNetwork == 0) {
+			entry.mConstraint->setResolvedSignature(0);
+			continue;
+		}
+		QList<NeuralNetworkElement*> dependencies;
+		QList<GroupConstraint*> constraintDependencies;
+		entry.mConstraint->getDependencies(entry.mGroup, dependencies);
+		entry.mConstraint->getConstraintDependencies(entry.mGroup, constraintDependencies);
+		entry.mConstraint->setResolvedSignature(calculateSignature(dependencies, 
+				constraintDependencies, entry.mConstraint, entry.mGroup));
+	}
+
+	mEntries.clear();
+	mGlobalEntries.clear();
+	mWatchers.clear();
+	mSignatures.clear();
+	mConstraintWatchers.clear();
+	mConstraintSignatures.clear();
+	mNetwork = 0;
+
+	return resolved;
+}
+
+
+/**
+ * Returns the errors and warnings of the last resolve() call, formatted as
+ * in ConstraintManager::runConstraints().
+ */
+QStringList ConstraintResolver::getErrors() const {
+	return mErrors;
+}
+
+
+int ConstraintResolver::getNumberOfIterations() const {
+	return mNumberOfIterations;
+}
+
+
+int ConstraintResolver::getNumberOfConstraintApplications() const {
+	return mNumberOfApplications;
+}
+
+
+int ConstraintResolver::getNumberOfSkippedConstraints() const {
+	return mNumberOfSkippedConstraints;
+}
+
+
+/**
+ * Calculates a 64 bit signature of all attributes of an element that can be
+ * checked or modified by a constraint. Temporary resolver properties and the
+ * reduced degrees of freedom tags are ignored, because they are changed
+ * during every resolver run.
+ */
+quint64 ConstraintResolver::calculateElementSignature(NeuralNetworkElement *element) {
+	quint64 signature = SIGNATURE_OFFSET;
+	if(element == 0) {
+		return signature;
+	}
+	signature = addToSignature(signature, (quint64) element->getId());
+
+	Vector3D position = element->getPosition();
+	signature = addToSignature(signature, position.getX());
+	signature = addToSignature(signature, position.getY());
+	signature = addToSignature(signature, position.getZ());
+
+	Neuron *neuron = dynamic_cast<Neuron*>(element);
+	Synapse *synapse = dynamic_cast<Synapse*>(element);
+	NeuronGroup *group = dynamic_cast<NeuronGroup*>(element);
+
+	if(neuron != 0) {
+		signature = addToSignature(signature, neuron->getBiasValue().get());
+		signature = addToSignature(signature, neuron->getTransferFunction());
+		signature = addToSignature(signature, neuron->getActivationFunction());
+
+		QList<Synapse*> synapses = neuron->getSynapses();
+		signature = addToSignature(signature, (quint64) synapses.size());
+		for(QListIterator<Synapse*> i(synapses); i.hasNext();) {
+			signature = addToSignature(signature, (quint64) i.next()->getId());
+		}
+		synapses = neuron->getOutgoingSynapses();
+		signature = addToSignature(signature, (quint64) synapses.size());
+		for(QListIterator<Synapse*> i(synapses); i.hasNext();) {
+			signature = addToSignature(signature, (quint64) i.next()->getId());
+		}
+	}
+	else if(synapse != 0) {
+		signature = addToSignature(signature, synapse->getStrengthValue().get());
+		signature = addToSignature(signature, (quint64) (synapse->getEnabledValue().get() ? 1 : 0));
+		signature = addToSignature(signature, (quint64) (synapse->getSource() == 0
+										? 0 : synapse->getSource()->getId()));
+		signature = addToSignature(signature, (quint64) (synapse->getTarget() == 0
+										? 0 : synapse->getTarget()->getId()));
+		signature = addToSignature(signature, synapse->getSynapseFunction());
+
+		QList<Synapse*> synapses = synapse->getSynapses();
+		signature = addToSignature(signature, (quint64) synapses.size());
+		for(QListIterator<Synapse*> i(synapses); i.hasNext();) {
+			signature = addToSignature(signature, (quint64) i.next()->getId());
+		}
+	}
+	else if(group != 0) {
+		QList<Neuron*> neurons = group->getNeurons();
+		signature = addToSignature(signature, (quint64) neurons.size());
+		for(QListIterator<Neuron*> i(neurons); i.hasNext();) {
+			signature = addToSignature(signature, (quint64) i.next()->getId());
+		}
+		QList<NeuroModule*> modules = group->getSubModules();
+		signature = addToSignature(signature, (quint64) modules.size());
+		for(QListIterator<NeuroModule*> i(modules); i.hasNext();) {
+			signature = addToSignature(signature, (quint64) i.next()->getId());
+		}
+	}
+
+	QList<QString> names = element->getPropertyNames();
+	for(QListIterator<QString> i(names); i.hasNext();) {
+		const QString &name = i.next();
+		if(name == NeuralNetworkConstants::TAG_ELEMENT_REDUCED_DEGREES_OF_FREEDOM
+			|| name == NeuralNetworkConstants::PROP_ELEMENT_MODIFIED
+			|| name.startsWith(NeuralNetworkConstants::PROP_PREFIX_CONSTRAINT_TEMP)
+			|| (name.startsWith("__") && name.endsWith("__")))
+		{
+			continue;
+		}
+		signature = addToSignature(signature, name);
+		signature = addToSignature(signature, element->getProperty(name));
+	}
+	return signature;
+}
+
+
+/**
+ * Calculates a signature of the name and the parameters of a constraint.
+ */
+quint64 ConstraintResolver::calculateConstraintSignature(GroupConstraint *constraint) {
+	return addToSignature(SIGNATURE_OFFSET, constraint);
+}
+
+
+/**
+ * Calculates the signature of a constraint with the given dependencies. Besides the
+ * dependencies, the signature covers the parameters of the constraint, the parameters
+ * of the constraints it reads and the owner group.
+ * The signature is never 0, so that 0 can be used as "not resolved".
+ */
+quint64 ConstraintResolver::calculateSignature(const QList<NeuralNetworkElement*> &dependencies,
+											   const QList<GroupConstraint*> &constraintDependencies,
+											   GroupConstraint *constraint, NeuronGroup *owner)
+{
+	quint64 signature = SIGNATURE_OFFSET;
+	signature = addToSignature(signature, (quint64) (owner == 0 ? 0 : owner->getId()));
+	signature = addToSignature(signature, constraint);
+	signature = addToSignature(signature, (quint64) dependencies.size());
+	for(QListIterator<NeuralNetworkElement*> i(dependencies); i.hasNext();) {
+		signature = addToSignature(signature, calculateElementSignature(i.next()));
+	}
+	signature = addToSignature(signature, (quint64) constraintDependencies.size());
+	for(QListIterator<GroupConstraint*> i(constraintDependencies); i.hasNext();) {
+		GroupConstraint *dependency = i.next();
+		signature = addToSignature(signature, (quint64) (dependency->getOwnerGroup() == 0 
+										? 0 : dependency->getOwnerGroup()->getId()));
+		signature = addToSignature(signature, dependency);
+	}
+	if(signature == 0) {
+		signature = 1;
+	}
+	return signature;
+}
+
+
+/**
+ * Recollects the dependencies of an entry and updates the watcher table.
+ */
+void ConstraintResolver::updateDependencies(int index) {
+	Entry &entry = mEntries[index];
+
+	for(QListIterator<NeuralNetworkElement*> i(entry.mDependencies); i.hasNext();) {
+		NeuralNetworkElement *element = i.next();
+		QHash<NeuralNetworkElement*, QList<int> >::iterator watchers = mWatchers.find(element);
+		if(watchers != mWatchers.end()) {
+			watchers.value().removeAll(index);
+			if(watchers.value().empty()) {
+				mWatchers.erase(watchers);
+			}
+		}
+	}
+	entry.mDependencies.clear();
+
+	for(QListIterator<GroupConstraint*> i(entry.mConstraintDependencies); i.hasNext();) {
+		GroupConstraint *constraint = i.next();
+		QHash<GroupConstraint*, QList<int> >::iterator watchers = mConstraintWatchers.find(constraint);
+		if(watchers != mConstraintWatchers.end()) {
+			watchers.value().removeAll(index);
+			if(watchers.value().empty()) {
+				mConstraintWatchers.erase(watchers);
+			}
+		}
+	}
+	entry.mConstraintDependencies.clear();
+
+	entry.mLocal = entry.mConstraint->getDependencies(entry.mGroup, entry.mDependencies);
+	if(!entry.mLocal) {
+		entry.mDependencies.clear();
+		if(!mGlobalEntries.contains(index)) {
+			mGlobalEntries.append(index);
+		}
+		return;
+	}
+	mGlobalEntries.removeAll(index);
+
+	for(QListIterator<NeuralNetworkElement*> i(entry.mDependencies); i.hasNext();) {
+		mWatchers[i.next()].append(index);
+	}
+
+	entry.mConstraint->getConstraintDependencies(entry.mGroup, entry.mConstraintDependencies);
+	for(QListIterator<GroupConstraint*> i(entry.mConstraintDependencies); i.hasNext();) {
+		mConstraintWatchers[i.next()].append(index);
+	}
+}
+
+
+/**
+ * Recalculates the signatures of the given elements and marks all watchers
+ * of changed elements as dirty. Elements seen for the first time are not
+ * considered as changed: a new element always changes the signature of the
+ * elements it is connected to.
+ */
+void ConstraintResolver::updateSignatures(const QList<NeuralNetworkElement*> &elements,
+										  int appliedEntry)
+{
+	for(QListIterator<NeuralNetworkElement*> i(elements); i.hasNext();) {
+		NeuralNetworkElement *element = i.next();
+		quint64 signature = calculateElementSignature(element);
+
+		QHash<NeuralNetworkElement*, quint64>::iterator cached = mSignatures.find(element);
+		if(cached == mSignatures.end()) {
+			mSignatures.insert(element, signature);
+		}
+		else if(cached.value() != signature) {
+			cached.value() = signature;
+			markChanged(element, appliedEntry);
+		}
+	}
+}
+
+
+/**
+ * Recalculates the signatures of all elements of the network, including the
+ * detection of removed elements. Used after the application of global constraints.
+ *
+ * @param appliedEntry the entry that caused the changes, or -1 if unknown.
+ */
+void ConstraintResolver::updateNetworkSignatures(int appliedEntry) {
+	QList<NeuralNetworkElement*> elements;
+	mNetwork->getNetworkElements(elements);
+	QSet<NeuralNetworkElement*> removed =
+			QSet<NeuralNetworkElement*>::fromList(mSignatures.keys());
+	for(QListIterator<NeuralNetworkElement*> i(elements); i.hasNext();) {
+		removed.remove(i.next());
+	}
+	for(QSetIterator<NeuralNetworkElement*> i(removed); i.hasNext();) {
+		NeuralNetworkElement *element = i.next();
+		mSignatures.remove(element);
+		markChanged(element, appliedEntry);
+	}
+	updateSignatures(elements, appliedEntry);
+}
+
+
+/**
+ * Recalculates the signature of the parameters of the applied constraint and 
+ * marks all constraints reading these parameters as dirty if they changed
+ * (e.g. the pair list of a SymmetryConstraint).
+ */
+void ConstraintResolver::updateConstraintSignature(int appliedEntry) {
+	GroupConstraint *constraint = mEntries.at(appliedEntry).mConstraint;
+	quint64 signature = calculateConstraintSignature(constraint);
+	QHash<GroupConstraint*, quint64>::iterator cached = mConstraintSignatures.find(constraint);
+	if(cached != mConstraintSignatures.end() && cached.value() == signature) {
+		return;
+	}
+	mConstraintSignatures.insert(constraint, signature);
+
+	QList<int> watchers = mConstraintWatchers.value(constraint);
+	for(QListIterator<int> i(watchers); i.hasNext();) {
+		int index = i.next();
+		if(index != appliedEntry) {
+			mEntries[index].mDirty = true;
+		}
+	}
+}
+
+
+/**
+ * Marks all constraints watching the element and all global constraints as dirty.
+ * The constraint that caused the change keeps its state, which is determined
+ * by the return value of its applyConstraint() method.
+ */
+void ConstraintResolver::markChanged(NeuralNetworkElement *element, int appliedEntry) {
+	QList<int> watchers = mWatchers.value(element);
+	for(QListIterator<int> i(watchers); i.hasNext();) {
+		int index = i.next();
+		if(index != appliedEntry) {
+			mEntries[index].mDirty = true;
+		}
+	}
+	for(QListIterator<int> i(mGlobalEntries); i.hasNext();) {
+		int index = i.next();
+		if(index != appliedEntry) {
+			mEntries[index].mDirty = true;
+		}
+	}
+}
+
+
+void ConstraintResolver::clear() {
+	mEntries.clear();
+	mGlobalEntries.clear();
+	mWatchers.clear();
+	mSignatures.clear();
+	mConstraintWatchers.clear();
+	mConstraintSignatures.clear();
+	mErrors.clear();
+	mNetwork = 0;
+	mNumberOfIterations = 0;
+	mNumberOfApplications = 0;
+	mNumberOfSkippedConstraints = 0;
+}
+
+}
+
@@ -0,0 +1,148 @@
+/***************************************************************************
+ *   NERD - Neurodynamics and Evolutionary Robotics Development Toolkit    *
+ *                                                                         *
+ *   University of Osnabrueck, Germany                                     *
+ *   Institute of Cognitive Science                                        *
+ *   Neurocybernetics Group                                                *
+ *   http://www.ikw.uni-osnabrueck.de/~neurokybernetik/                    *
+ *                                                                         *
+ *   Project homepage: nerd.x-bot.org                                      *
+ *                                                                         *
+ *   Copyright (C) 2008 - 2013 by the Neurocybernetics Group Osnabrück     *
+ *   Contact: Christian Rempis                                             *
+ *   christian.rempis@uni-osnabrueck.de                                    *
+ *   Contributors: see contributors.txt in the nerd main directory.        *
+ *                                                                         *
+ *                                                                         *
+ *   Acknowledgments:                                                      *
+ *   The NERD Toolkit is part of the EU project ALEAR                      *
+ *   (Artificial Language Evolution on Autonomous Robots) www.ALEAR.eu     *
+ *   This work was funded (2008 - 2011) by EU-Project Number ICT 214856    *
+ *                                                                         *
+ *                                                                         *
+ *   License Agreement:                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ *                                                                         *
+ *   Publications based on work using the NERD kit have to state this      *
+ *   clearly by citing the NERD homepage and the NERD overview paper.      *  
+ ***************************************************************************/
+
+
+#ifndef NERDConstraintResolver_H
+#define NERDConstraintResolver_H
+
+#include <QList>
+#include <QHash>
+#include <QStringList>
+#include "Constraints/GroupConstraint.h"
+#include "Command/CommandExecutor.h"
+
+namespace nerd {
+
+	class ModularNeuralNetwork;
+
+	/**
+	 * ConstraintResolver.
+	 * Applies the constraints of a set of NeuronGroups until all of them are fulfilled.
+	 *
+	 * In contrast to a simple fixpoint loop, which applies all constraints in every
+	 * resolver iteration, the resolver keeps a worklist of dirty constraints. Each
+	 * constraint reports the network elements it depends on (GroupConstraint::getDependencies()).
+	 * After a constraint was applied, the signatures of its dependencies are recalculated,
+	 * and only the constraints watching a changed element are marked dirty again.
+	 * Constraints may also read the parameters of other constraints
+	 * (GroupConstraint::getConstraintDependencies()). A change of these parameters
+	 * marks the reading constraints dirty as well.
+	 * Constraints without dependency information are treated as global and are
+	 * re-applied after every change of the network. As such constraints may change
+	 * any element, the whole network is re-hashed once at the end of each iteration
+	 * in which a global constraint was applied.
+	 *
+	 * If enabled, constraints whose dependency signature did not change since their
+	 * last successful resolver run are not applied at all. This is useful for evolution,
+	 * where most constraints of a mutated network are still fulfilled.
+	 */
+	class ConstraintResolver {
+	public:
+		ConstraintResolver();
+		virtual ~ConstraintResolver();
+
+		void setMaxNumberOfIterations(int iterations);
+		int getMaxNumberOfIterations() const;
+		void setTimeout(int milliseconds);
+		int getTimeout() const;
+		void setSkipResolvedConstraints(bool skip);
+		bool isSkippingResolvedConstraints() const;
+		void setProcessPendingTasks(bool process);
+		void setCollectOnlyErrorsOfLastIteration(bool onlyLast);
+		void setVerbose(bool verbose);
+
+		bool resolve(QList<NeuronGroup*> groups, CommandExecutor *executor,
+					 QList<NeuralNetworkElement*> &trashcan);
+
+		QStringList getErrors() const;
+		int getNumberOfIterations() const;
+		int getNumberOfConstraintApplications() const;
+		int getNumberOfSkippedConstraints() const;
+
+		static quint64 calculateElementSignature(NeuralNetworkElement *element);
+		static quint64 calculateConstraintSignature(GroupConstraint *constraint);
+		static quint64 calculateSignature(const QList<NeuralNetworkElement*> &dependencies,
+										  const QList<GroupConstraint*> &constraintDependencies,
+										  GroupConstraint *constraint, NeuronGroup *owner);
+
+	private:
+		struct Entry {
+			NeuronGroup *mGroup;
+			GroupConstraint *mConstraint;
+			bool mLocal;
+			bool mDirty;
+			QList<NeuralNetworkElement*> mDependencies;
+			QList<GroupConstraint*> mConstraintDependencies;
+		};
+
+		void updateDependencies(int index);
+		void updateSignatures(const QList<NeuralNetworkElement*> &elements, int appliedEntry);
+		void updateNetworkSignatures(int appliedEntry);
+		void updateConstraintSignature(int appliedEntry);
+		void markChanged(NeuralNetworkElement *element, int appliedEntry);
+		void clear();
+
+	private:
+		int mMaxNumberOfIterations;
+		int mTimeout;
+		bool mSkipResolvedConstraints;
+		bool mProcessPendingTasks;
+		bool mCollectOnlyErrorsOfLastIteration;
+		bool mVerbose;
+		ModularNeuralNetwork *mNetwork;
+		QList<Entry> mEntries;
+		QList<int> mGlobalEntries;
+		QHash<NeuralNetworkElement*, QList<int> > mWatchers;
+		QHash<NeuralNetworkElement*, quint64> mSignatures;
+		QHash<GroupConstraint*, QList<int> > mConstraintWatchers;
+		QHash<GroupConstraint*, quint64> mConstraintSignatures;
+		QStringList mErrors;
+		int mNumberOfIterations;
+		int mNumberOfApplications;
+		int mNumberOfSkippedConstraints;
+	};
+
+}
+
+#endif
+
@@ -91,6 +91,17 @@ bool FeedForwardConstraint::isValid(NeuronGroup*) {
 }
 
 
+/**
+ * Recurrence chains are searched among the neurons of the owner group, and only 
+ * synapses of these chains are removed. All of them are incoming or outgoing 
+ * synapses of the group neurons.
+ */
+bool FeedForwardConstraint::getDependencies(NeuronGroup *owner, QList<NeuralNetworkElement*> &elements) {
+	GroupConstraint::addGroupDependencies(owner, elements);
+	return true;
+}
+
+
 bool FeedForwardConstraint::applyConstraint(NeuronGroup *owner, 
 									CommandExecutor*, 
 									QList<NeuralNetworkElement*> &trashcan)
@@ -43,6 +43,9 @@
 
 #include "GroupConstraint.h"
 #include "Network/NeuralNetwork.h"
+#include "ModularNeuralNetwork/NeuroModule.h"
+#include "Network/Synapse.h"
+#include <QSet>
 #include <iostream>
 
 using namespace std;
@@ -50,7 +53,7 @@ using namespace std;
 namespace nerd {
 
 GroupConstraint::GroupConstraint(const QString &name, qulonglong id)
-	: ParameterizedObject(name), mId(id), mOwnerGroup(0)
+	: ParameterizedObject(name), mId(id), mOwnerGroup(0), mResolvedSignature(0)
 {
 	if(mId == 0) {
 		mId = NeuralNetwork::generateNextId();
@@ -59,7 +62,7 @@ GroupConstraint::GroupConstraint(const QString &name, qulonglong id)
 
 GroupConstraint::GroupConstraint(const GroupConstraint &other) 
 	: Object(), ValueChangedListener(), ParameterizedObject(other), mId(other.mId),
-		mOwnerGroup(0)
+		mOwnerGroup(0), mResolvedSignature(other.mResolvedSignature)
 {
 }
 
@@ -120,6 +123,106 @@ bool GroupConstraint::groupIdsChanged(QHash<qulonglong, qulonglong>) {
 	return true;
 }
 
+/**
+ * Collects all network elements whose state can influence the result of applyConstraint()
+ * and all elements the constraint may modify. The ConstraintResolver uses these dependencies
+ * to re-apply the constraint only when one of the elements has changed.
+ *
+ * The default implementation returns false, which marks the constraint as global:
+ * it depends on the entire network and is re-applied after any change.
+ *
+ * @param owner the group that owns this constraint.
+ * @param elements the list to add the dependencies to.
+ * @return true if the dependencies are complete, false if the constraint is global.
+ */
+bool GroupConstraint::getDependencies(NeuronGroup*, QList<NeuralNetworkElement*>&) {
+	return false;
+}
+
+
+/**
+ * Collects all other constraints whose parameters are read by applyConstraint().
+ * The ConstraintResolver re-applies the constraint when one of these parameters changes.
+ * The default implementation adds nothing.
+ *
+ * @param owner the group that owns this constraint.
+ * @param constraints the list to add the constraints to.
+ */
+void GroupConstraint::getConstraintDependencies(NeuronGroup*, QList<GroupConstraint*>&) {
+}
+
+
+/**
+ * Adds the typical dependencies of a group to the list: the group itself, all
+ * enclosed neurons and submodules, all incoming and outgoing synapses of these
+ * neurons and the neurons at the other end of these synapses.
+ */
+void GroupConstraint::addGroupDependencies(NeuronGroup *group,
+									QList<NeuralNetworkElement*> &elements)
+{
+	if(group == 0) {
+		return;
+	}
+	QSet<NeuralNetworkElement*> known = QSet<NeuralNetworkElement*>::fromList(elements);
+
+	QList<NeuralNetworkElement*> candidates;
+	candidates.append(group);
+
+	QList<NeuroModule*> modules = group->getAllEnclosedModules();
+	for(QListIterator<NeuroModule*> i(modules); i.hasNext();) {
+		candidates.append(i.next());
+	}
+
+	QList<Neuron*> neurons = group->getAllEnclosedNeurons();
+	for(QListIterator<Neuron*> i(neurons); i.hasNext();) {
+		Neuron *neuron = i.next();
+		candidates.append(neuron);
+
+		QList<Synapse*> synapses = neuron->getSynapses();
+		synapses << neuron->getOutgoingSynapses();
+		for(int j = 0; j < synapses.size(); ++j) {
+			Synapse *synapse = synapses.at(j);
+			candidates.append(synapse);
+			candidates.append(synapse->getSource());
+			candidates.append(synapse->getTarget());
+
+			//synapses of synapses
+			QList<Synapse*> subSynapses = synapse->getSynapses();
+			for(QListIterator<Synapse*> k(subSynapses); k.hasNext();) {
+				Synapse *subSynapse = k.next();
+				if(!synapses.contains(subSynapse)) {
+					synapses.append(subSynapse);
+				}
+			}
+		}
+	}
+
+	for(QListIterator<NeuralNetworkElement*> i(candidates); i.hasNext();) {
+		NeuralNetworkElement *elem = i.next();
+		if(elem != 0 && !known.contains(elem)) {
+			known.insert(elem);
+			elements.append(elem);
+		}
+	}
+}
+
+
+/**
+ * Stores the dependency signature of the last successful resolver run.
+ * If the signature is unchanged in a later run, the ConstraintResolver may
+ * skip this constraint. The signature is copied with the constraint, so that
+ * the constraints of cloned networks keep their resolved state.
+ */
+void GroupConstraint::setResolvedSignature(quint64 signature) {
+	mResolvedSignature = signature;
+}
+
+
+quint64 GroupConstraint::getResolvedSignature() const {
+	return mResolvedSignature;
+}
+
+
 /**
  * Returns the error message. This message contains a verbal description of reasons
  * why isValid(), setRequiredElements and applyConstraints() failed. 
@@ -86,6 +86,13 @@ namespace nerd {
 
 		virtual bool groupIdsChanged(QHash<qulonglong, qulonglong> changedIds);
 
+		virtual bool getDependencies(NeuronGroup *owner, QList<NeuralNetworkElement*> &elements);
+		virtual void getConstraintDependencies(NeuronGroup *owner, QList<GroupConstraint*> &constraints);
+		static void addGroupDependencies(NeuronGroup *group, QList<NeuralNetworkElement*> &elements);
+
+		void setResolvedSignature(quint64 signature);
+		quint64 getResolvedSignature() const;
+
 		virtual QString getErrorMessage() const;
 		virtual void setErrorMessage(const QString &message);
 		
@@ -101,6 +108,7 @@ namespace nerd {
 		QString mErrorMessage;
 		QString mWarningMessage;
 		NeuronGroup *mOwnerGroup;
+		quint64 mResolvedSignature;
 	};
 
 }
@@ -91,6 +91,17 @@ bool NumberOfNeuronsConstraint::isValid(NeuronGroup*) {
 }
 
 
+/**
+ * The constraint counts the enclosed neurons of the owner group and adds or removes
+ * neurons of the group. Removed neurons take their synapses with them, which are
+ * part of the group dependencies as well.
+ */
+bool NumberOfNeuronsConstraint::getDependencies(NeuronGroup *owner, QList<NeuralNetworkElement*> &elements) {
+	GroupConstraint::addGroupDependencies(owner, elements);
+	return true;
+}
+
+
 bool NumberOfNeuronsConstraint::applyConstraint(NeuronGroup *owner, CommandExecutor*,
 												QList<NeuralNetworkElement*> &trashcan) 
 {
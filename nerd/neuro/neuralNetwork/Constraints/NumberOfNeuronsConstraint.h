@@ -66,6 +66,7 @@ namespace nerd {
 		virtual bool isValid(NeuronGroup *owner);
 		virtual bool applyConstraint(NeuronGroup *owner, CommandExecutor *executor,
 									 QList<NeuralNetworkElement*> &trashcan);
+		virtual bool getDependencies(NeuronGroup *owner, QList<NeuralNetworkElement*> &elements);
 		
 		virtual bool equals(GroupConstraint *constraint) const;
 
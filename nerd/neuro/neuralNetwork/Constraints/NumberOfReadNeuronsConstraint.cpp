@@ -85,6 +85,16 @@ bool NumberOfReadNeuronsConstraint::isValid(NeuronGroup*) {
 }
 
 
+/**
+ * Read neurons are group neurons with an outgoing synapse to a target outside of
+ * the group. So only the group neurons and their outgoing synapses are checked.
+ */
+bool NumberOfReadNeuronsConstraint::getDependencies(NeuronGroup *owner, QList<NeuralNetworkElement*> &elements) {
+	GroupConstraint::addGroupDependencies(owner, elements);
+	return true;
+}
+
+
 bool NumberOfReadNeuronsConstraint::applyConstraint(NeuronGroup *owner, CommandExecutor*,
 													QList<NeuralNetworkElement*>&) 
 {
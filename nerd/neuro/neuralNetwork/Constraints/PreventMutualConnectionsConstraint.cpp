@@ -117,6 +117,8 @@ bool PreventMutualConnectionsConstraint::applyConstraint(NeuronGroup *owner,
 		}
 	}
 
+	//this may remove synapses anywhere in the network, so the constraint is 
+	//treated as global by the ConstraintResolver.
 	if(owner->getOwnerNetwork() != 0) {
 		owner->getOwnerNetwork()->validateSynapseConnections();
 	}
@@ -190,6 +190,52 @@ bool SymmetryConstraint::isValid(NeuronGroup *owner) {
 	return true;
 }
 
+/**
+ * The owner group is rebuilt as a copy of the target group: modules and neurons
+ * (positions, bias, functions and properties) are created, removed or adjusted 
+ * to match the target, and the synapses of the target neurons are mirrored according
+ * to the connection mode, including the synapses to neurons outside of both groups.
+ * Therefore all elements of both groups, their synapses and the neurons at the 
+ * other end of these synapses are dependencies.
+ */
+bool SymmetryConstraint::getDependencies(NeuronGroup *owner, QList<NeuralNetworkElement*> &elements) {
+	if(owner == 0 || owner->getOwnerNetwork() == 0) {
+		return false;
+	}
+	NeuronGroup *target = ModularNeuralNetwork::selectNeuronGroupById(mTargetGroupId->get(),
+									owner->getOwnerNetwork()->getNeuronGroups());
+	if(target == 0) {
+		return false;
+	}
+	GroupConstraint::addGroupDependencies(owner, elements);
+	GroupConstraint::addGroupDependencies(target, elements);
+	return true;
+}
+
+
+/**
+ * The element pairs and target groups of all other SymmetryConstraints in the 
+ * network are merged into the pair list in applyConstraint().
+ */
+void SymmetryConstraint::getConstraintDependencies(NeuronGroup *owner, 
+						QList<GroupConstraint*> &constraints) 
+{
+	if(owner == 0 || owner->getOwnerNetwork() == 0) {
+		return;
+	}
+	QList<NeuronGroup*> allGroups = owner->getOwnerNetwork()->getNeuronGroups();
+	for(QListIterator<NeuronGroup*> i(allGroups); i.hasNext();) {
+		QList<GroupConstraint*> groupConstraints = i.next()->getConstraints();
+		for(QListIterator<GroupConstraint*> j(groupConstraints); j.hasNext();) {
+			GroupConstraint *constraint = j.next();
+			if(constraint != this && dynamic_cast<SymmetryConstraint*>(constraint) != 0) {
+				constraints.append(constraint);
+			}
+		}
+	}
+}
+
+
 bool SymmetryConstraint::applyConstraint(NeuronGroup *owner, CommandExecutor*,
 										QList<NeuralNetworkElement*> &trashcan) 
 {
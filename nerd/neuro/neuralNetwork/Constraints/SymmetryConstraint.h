@@ -87,6 +87,8 @@ namespace nerd {
 		virtual bool isValid(NeuronGroup *owner);
 		virtual bool applyConstraint(NeuronGroup *owner, CommandExecutor *executor,
 									 QList<NeuralNetworkElement*> &trashcan);
+		virtual bool getDependencies(NeuronGroup *owner, QList<NeuralNetworkElement*> &elements);
+		virtual void getConstraintDependencies(NeuronGroup *owner, QList<GroupConstraint*> &constraints);
 
 		virtual bool groupIdsChanged(QHash<qulonglong, qulonglong> changedIds);
 		
@@ -125,6 +125,8 @@ NeuralNetwork* NeuralNetworkIO::createNetworkFromFile(const QString &fileName,
 bool NeuralNetworkIO::createFileFromNetwork(const QString &fileName, NeuralNetwork *net, 
 					FileType type, QString *errorMsg, QList<QString> *warnings) 
 {
+	prepareNetworkForWriting(net);
+
 	switch(type) {
 		case SimbaV3Xml:
 			return NeuralNetworkIOSimbaV3Xml::createFileFromNetwork(fileName, net, errorMsg);
@@ -144,6 +146,8 @@ bool NeuralNetworkIO::createFileFromNetwork(const QString &fileName, NeuralNetwo
 bool NeuralNetworkIO::createFileFromNetwork(const QString &fileName, NeuralNetwork *net, 
 					QString *errorMsg, QList<QString> *warnings)
 {
+	prepareNetworkForWriting(net);
+
 	if(fileName.endsWith(".smb")) {
 		return NeuralNetworkIOSimbaV3Xml::createFileFromNetwork(fileName, net, errorMsg);
 	}
@@ -260,6 +264,24 @@ QString NeuralNetworkIO::getNERDSynapseFunctionNameFromSimbaV3(QString simbaV3Na
 	return simbaV3Name;
 }
 
+/**
+ * Synchronizes the runtime state of all network elements with their properties. 
+ * The state slots of learning functions are only written to the properties on demand,
+ * so this has to be called before a network is written with any of the file formats.
+ *
+ * @param net the NeuralNetwork that is going to be written.
+ */
+void NeuralNetworkIO::prepareNetworkForWriting(NeuralNetwork *net) {
+	if(net == 0) {
+		return;
+	}
+	QList<NeuralNetworkElement*> elements;
+	net->getNetworkElements(elements);
+	for(QListIterator<NeuralNetworkElement*> i(elements); i.hasNext();) {
+		i.next()->storeStateSlotsInProperties();
+	}
+}
+
 /**
  * Returns the number of the neuron in the NeuronList of the NeuralNetwork.
  *
@@ -60,6 +60,7 @@ namespace nerd {
 
 	public:
 		static int getNeuronNumber(NeuralNetwork *net, Neuron *neuron);
+		static void prepareNetworkForWriting(NeuralNetwork *net);
 
 		static bool createFileFromNetwork(const QString &fileName, NeuralNetwork *net, 
 					FileType type, QString *errorMsg = 0, QList<QString> *warnings = 0);
@@ -515,7 +515,6 @@ void NeuralNetworkIONerdV1Xml::addParametersToXML(QDomDocument &doc,
 void NeuralNetworkIONerdV1Xml::addPropertiesToXML(QDomDocument &doc, 
 						Properties &obj, QDomElement &xmlElement) 
 {
-
 	QList<QString> propertyNames = obj.getPropertyNames();
 
 	if(propertyNames.empty()) {
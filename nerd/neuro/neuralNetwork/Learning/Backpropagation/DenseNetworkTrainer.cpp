@@ -0,0 +1,997 @@
+/***************************************************************************
+ *   NERD - Neurodynamics and Evolutionary Robotics Development Toolkit    *
+ *                                                                         *
+ *   University of Osnabrueck, Germany                                     *
+ *   Institute of Cognitive Science                                        *
+ *   Neurocybernetics Group                                                *
+ *   http://www.ikw.uni-osnabrueck.de/~neurokybernetik/                    *
+ *                                                                         *
+ *   Project homepage: nerd.x-bot.org                                      *
+ *                                                                         *
+ *   Copyright (C) 2008 - 2013 by the Neurocybernetics Group Osnabrück     *
+ *   Contact: Christian Rempis                                             *
+ *   christian.rempis@uni-osnabrueck.de                                    *
+ *   Contributors: see contributors.txt in the nerd main directory.        *
+ *                                                                         *
+ *                                                                         *
+ *   Acknowledgments:                                                      *
+ *   The NERD Toolkit is part of the EU project ALEAR                      *
+ *   (Artificial Language Evolution on Autonomous Robots) www.ALEAR.eu     *
+ *   This work was funded (2008 - 2011) by EU-Project Number ICT 214856    *
+ *                                                                         *
+ *                                                                         *
+ *   License Agreement:                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ *                                                                         *
+ *   Publications based on work using the NERD kit have to state this      *
+ *   clearly by citing the NERD homepage and the NERD overview paper.      *  
+ ***************************************************************************/
+
+
+#include "DenseNetworkTrainer.h"
+#include <iostream>
+#include <string.h>
+#include <QHash>
+#include <QSet>
+#include <QMutexLocker>
+#include "Core/Core.h"
+#include "Network/Synapse.h"
+#include "Math/Math.h"
+#include "Math/Random.h"
+#include "ActivationFunction/AdditiveTimeDiscreteActivationFunction.h"
+#include "SynapseFunction/SimpleSynapseFunction.h"
+#include "TransferFunction/TransferFunctionNeutral.h"
+#include "TransferFunction/TransferFunctionSigmoid.h"
+#include "TransferFunction/TransferFunctionParameterizedSigmoid.h"
+#include "TransferFunction/TransferFunctionTanh.h"
+#include "TransferFunction/TransferFunctionASeriesTanh.h"
+#include "TransferFunction/TransferFunctionMSeriesTanh.h"
+#include "Value/DoubleValue.h"
+
+using namespace std;
+
+namespace nerd {
+
+
+DenseNetworkTrainerWorker::DenseNetworkTrainerWorker(DenseNetworkTrainer *trainer, int index)
+	: QThread(0), mTrainer(trainer), mIndex(index)
+{
+	Core::getInstance()->registerThread(this);
+}
+
+DenseNetworkTrainerWorker::~DenseNetworkTrainerWorker() {
+	Core::getInstance()->deregisterThread(this);
+}
+
+void DenseNetworkTrainerWorker::run() {
+	int generation = 0;
+	while(mTrainer->waitForSlice(generation)) {
+		mTrainer->processSlice(mIndex);
+		mTrainer->sliceCompleted();
+	}
+}
+
+
+
+/**
+ * Constructs a new DenseNetworkTrainer.
+ */
+DenseNetworkTrainer::DenseNetworkTrainer()
+	: mNetwork(0), mRecurrent(false), mNumberOfNeurons(0), mNumberOfInputs(0), 
+	  mWindowStart(0), mWindowLength(1), mComputeGradients(true), mLearningRate(0.1), 
+	  mMomentum(0.0), mBatchSize(32), mTruncationLength(10), 
+	  mNumberOfThreads(QThread::idealThreadCount()), mTrainBiases(true), 
+	  mSliceGeneration(0), mNumberOfPendingSlices(0), mShutdown(false)
+{
+	if(mNumberOfThreads < 1) {
+		mNumberOfThreads = 1;
+	}
+}
+
+
+/**
+ * Destructor.
+ */
+DenseNetworkTrainer::~DenseNetworkTrainer() {
+	stopWorkers();
+}
+
+
+/**
+ * Converts the network into the dense representation. 
+ *
+ * @param network the network to train.
+ * @param inputs the input neurons, in the order of the input values of the training data.
+ * @param outputs the output neurons, in the order of the desired values of the training data.
+ * @param recurrent if true, the network is trained with truncated backpropagation through time,
+ *        otherwise it has to be a feed-forward network.
+ * @return true if the network could be converted.
+ */
+bool DenseNetworkTrainer::setNetwork(NeuralNetwork *network, const QList<Neuron*> &inputs,
+						const QList<Neuron*> &outputs, bool recurrent)
+{
+	clear();
+
+	if(network == 0) {
+		return false;
+	}
+
+	QList<Neuron*> neurons = network->getNeurons();
+	QSet<Neuron*> networkNeurons = neurons.toSet();
+	QSet<Neuron*> inputNeurons = inputs.toSet();
+	if(inputNeurons.size() != inputs.size()) {
+		Core::log("DenseNetworkTrainer: Input neurons must not be listed twice.", true);
+		return false;
+	}
+	for(QListIterator<Neuron*> i(inputs + outputs); i.hasNext();) {
+		if(!networkNeurons.contains(i.next())) {
+			Core::log("DenseNetworkTrainer: Input or output neuron is not part of the network.", true);
+			return false;
+		}
+	}
+
+	QList<Neuron*> processedNeurons;
+	for(QListIterator<Neuron*> i(neurons); i.hasNext();) {
+		Neuron *neuron = i.next();
+		if(!inputNeurons.contains(neuron)) {
+			processedNeurons.append(neuron);
+		}
+	}
+
+	//the input neurons are always placed in the first rows.
+	mRecurrent = recurrent;
+	mNumberOfInputs = inputs.size();
+	mNeurons = inputs;
+	mLayerBounds.append(mNeurons.size());
+	if(mRecurrent) {
+		mNeurons += processedNeurons;
+		mLayerBounds.append(mNeurons.size());
+	}
+	else if(!determineLayers(processedNeurons, mNeurons)) {
+		clear();
+		return false;
+	}
+	mNumberOfNeurons = mNeurons.size();
+
+	int n = mNumberOfNeurons;
+	QHash<Neuron*, int> rows;
+	rows.reserve(n);
+
+	mTransferFunctions.resize(n);
+	mDerivativeTypes.resize(n);
+	mDerivativeFactors.resize(n);
+
+	for(int i = 0; i < n; ++i) {
+		Neuron *neuron = mNeurons.at(i);
+		rows.insert(neuron, i);
+
+		TransferFunction *tf = neuron->getTransferFunction();
+		mTransferFunctions[i] = tf;
+		mDerivativeTypes[i] = DERIVATIVE_LINEAR;
+		mDerivativeFactors[i] = 1.0;
+
+		if(i < mNumberOfInputs) {
+			continue;
+		}
+		if(dynamic_cast<AdditiveTimeDiscreteActivationFunction*>(
+					neuron->getActivationFunction()) == 0) 
+		{
+			Core::log("DenseNetworkTrainer: Activation function of neuron [" 
+					+ QString::number(neuron->getId()) + "] is not supported.", true);
+			clear();
+			return false;
+		}
+		if(dynamic_cast<TransferFunctionParameterizedSigmoid*>(tf) != 0) {
+			DoubleValue *steepness = dynamic_cast<DoubleValue*>(tf->getParameter("Steepness"));
+			mDerivativeTypes[i] = DERIVATIVE_SIGMOID;
+			mDerivativeFactors[i] = steepness == 0 ? 1.0 : steepness->get();
+		}
+		else if(dynamic_cast<TransferFunctionSigmoid*>(tf) != 0) {
+			mDerivativeTypes[i] = DERIVATIVE_SIGMOID;
+		}
+		else if(dynamic_cast<TransferFunctionTanh*>(tf) != 0
+				|| dynamic_cast<TransferFunctionASeriesTanh*>(tf) != 0
+				|| dynamic_cast<TransferFunctionMSeriesTanh*>(tf) != 0)
+		{
+			//the fixed point versions are approximated by the derivative of the tanh.
+			mDerivativeTypes[i] = DERIVATIVE_TANH;
+		}
+		else if(dynamic_cast<TransferFunctionNeutral*>(tf) == 0) {
+			Core::log("DenseNetworkTrainer: Transfer function [" 
+					+ (tf == 0 ? QString("") : tf->getName()) + "] of neuron [" 
+					+ QString::number(neuron->getId()) + "] is not supported.", true);
+			clear();
+			return false;
+		}
+	}
+
+	for(QListIterator<Neuron*> i(outputs); i.hasNext();) {
+		mOutputRows.append(rows.value(i.next()));
+	}
+
+	QVector<bool> usedEntries(n * n, false);
+	QList<Synapse*> synapses = network->getSynapses();
+	for(QListIterator<Synapse*> i(synapses); i.hasNext();) {
+		Synapse *synapse = i.next();
+		if(!synapse->getEnabledValue().get()) {
+			continue;
+		}
+		Neuron *source = synapse->getSource();
+		Neuron *target = dynamic_cast<Neuron*>(synapse->getTarget());
+		if(source == 0 || target == 0) {
+			Core::log("DenseNetworkTrainer: Synapses targeting other synapses are not supported.", true);
+			clear();
+			return false;
+		}
+		if(dynamic_cast<SimpleSynapseFunction*>(synapse->getSynapseFunction()) == 0) {
+			Core::log("DenseNetworkTrainer: Synapse function of synapse [" 
+					+ QString::number(synapse->getId()) + "] is not supported.", true);
+			clear();
+			return false;
+		}
+		int index = (rows.value(target) * n) + rows.value(source);
+		if(usedEntries.at(index)) {
+			Core::log("DenseNetworkTrainer: Parallel synapses between neuron [" 
+					+ QString::number(source->getId()) + "] and neuron [" 
+					+ QString::number(target->getId()) + "] are not supported.", true);
+			clear();
+			return false;
+		}
+		usedEntries[index] = true;
+		mSynapses.append(synapse);
+		mSynapseIndices.append(index);
+	}
+
+	mNetwork = network;
+	readWeightsFromNetwork();
+
+	return true;
+}
+
+
+bool DenseNetworkTrainer::isRecurrent() const {
+	return mRecurrent;
+}
+
+
+int DenseNetworkTrainer::getNumberOfNeurons() const {
+	return mNumberOfNeurons;
+}
+
+
+/**
+ * Sets the training data. In feed-forward mode, each sample of each sequence
+ * is used as an independent training pattern.
+ */
+void DenseNetworkTrainer::setTrainingData(const QList<DenseTrainingSequence> &sequences) {
+	mSequences.clear();
+	if(mRecurrent) {
+		mSequences = sequences;
+	}
+	else {
+		for(QListIterator<DenseTrainingSequence> i(sequences); i.hasNext();) {
+			const DenseTrainingSequence &sequence = i.next();
+			for(QListIterator<DenseTrainingSample> j(sequence); j.hasNext();) {
+				mSequences.append(DenseTrainingSequence() << j.next());
+			}
+		}
+	}
+	mSequenceOrder.resize(mSequences.size());
+	for(int i = 0; i < mSequenceOrder.size(); ++i) {
+		mSequenceOrder[i] = i;
+	}
+}
+
+
+int DenseNetworkTrainer::getNumberOfTrainingSequences() const {
+	return mSequences.size();
+}
+
+
+/**
+ * Trains the network for the given number of epochs. The weights of the network 
+ * itself are not changed until writeWeightsToNetwork() is called.
+ *
+ * @return the mean squared error of the last epoch.
+ */
+double DenseNetworkTrainer::train(int numberOfEpochs) {
+	double error = 0.0;
+	for(int i = 0; i < numberOfEpochs; ++i) {
+		error = trainEpoch();
+	}
+	return error;
+}
+
+
+/**
+ * Trains all sequences once in random order.
+ *
+ * @return the mean squared error during the epoch.
+ */
+double DenseNetworkTrainer::trainEpoch() {
+	return processEpoch(true);
+}
+
+
+/**
+ * Calculates the mean squared error of the current weights on the training data.
+ */
+double DenseNetworkTrainer::calculateError() {
+	return processEpoch(false);
+}
+
+
+/**
+ * Loads the synapse strengths and biases from the network and resets the momentum.
+ */
+void DenseNetworkTrainer::readWeightsFromNetwork() {
+	int n = mNumberOfNeurons;
+	mWeights.fill(0.0, n * n);
+	mTransposedWeights.fill(0.0, n * n);
+	mBiases.fill(0.0, n);
+	mWeightVelocities.fill(0.0, mSynapses.size());
+	mBiasVelocities.fill(0.0, n);
+
+	for(int i = 0; i < mSynapses.size(); ++i) {
+		int index = mSynapseIndices.at(i);
+		double weight = mSynapses.at(i)->getStrengthValue().get();
+		mWeights[index] = weight;
+		mTransposedWeights[((index % n) * n) + (index / n)] = weight;
+	}
+	for(int i = 0; i < n; ++i) {
+		mBiases[i] = mNeurons.at(i)->getBiasValue().get();
+	}
+}
+
+
+/**
+ * Copies the trained weights (and biases, if they are trained) back to the network.
+ */
+void DenseNetworkTrainer::writeWeightsToNetwork() {
+	for(int i = 0; i < mSynapses.size(); ++i) {
+		mSynapses.at(i)->getStrengthValue().set(mWeights.at(mSynapseIndices.at(i)));
+	}
+	if(mTrainBiases) {
+		for(int i = mNumberOfInputs; i < mNumberOfNeurons; ++i) {
+			mNeurons.at(i)->getBiasValue().set(mBiases.at(i));
+		}
+	}
+}
+
+
+/**
+ * Returns the current (trained) weight of the connection from source to target.
+ */
+double DenseNetworkTrainer::getWeight(Neuron *target, Neuron *source) const {
+	int row = mNeurons.indexOf(target);
+	int column = mNeurons.indexOf(source);
+	if(row < 0 || column < 0) {
+		return 0.0;
+	}
+	return mWeights.at((row * mNumberOfNeurons) + column);
+}
+
+
+void DenseNetworkTrainer::setLearningRate(double rate) {
+	mLearningRate = rate;
+}
+
+
+double DenseNetworkTrainer::getLearningRate() const {
+	return mLearningRate;
+}
+
+
+void DenseNetworkTrainer::setMomentum(double momentum) {
+	mMomentum = momentum;
+}
+
+
+double DenseNetworkTrainer::getMomentum() const {
+	return mMomentum;
+}
+
+
+void DenseNetworkTrainer::setBatchSize(int size) {
+	mBatchSize = Math::max(1, size);
+}
+
+
+int DenseNetworkTrainer::getBatchSize() const {
+	return mBatchSize;
+}
+
+
+/**
+ * Sets the number of steps after which the gradient is truncated in recurrent mode.
+ */
+void DenseNetworkTrainer::setTruncationLength(int numberOfSteps) {
+	mTruncationLength = Math::max(1, numberOfSteps);
+}
+
+
+int DenseNetworkTrainer::getTruncationLength() const {
+	return mTruncationLength;
+}
+
+
+void DenseNetworkTrainer::setNumberOfThreads(int numberOfThreads) {
+	mNumberOfThreads = Math::max(1, numberOfThreads);
+}
+
+
+int DenseNetworkTrainer::getNumberOfThreads() const {
+	return mNumberOfThreads;
+}
+
+
+void DenseNetworkTrainer::setTrainBiases(bool train) {
+	mTrainBiases = train;
+}
+
+
+bool DenseNetworkTrainer::isTrainingBiases() const {
+	return mTrainBiases;
+}
+
+
+/**
+ * Called by the workers to wait for the next mini-batch window.
+ *
+ * @return false if the workers should terminate.
+ */
+bool DenseNetworkTrainer::waitForSlice(int &generation) {
+	QMutexLocker locker(&mSliceMutex);
+	while(!mShutdown && generation == mSliceGeneration) {
+		mSlicesAvailable.wait(&mSliceMutex);
+	}
+	generation = mSliceGeneration;
+	return !mShutdown;
+}
+
+
+/**
+ * Runs the forward pass (and the backward pass, if gradients are required) of 
+ * the current window for all sequences of a slice.
+ */
+void DenseNetworkTrainer::processSlice(int index) {
+	DenseTrainerSlice &slice = mSlices[index];
+	slice.mSquaredError = 0.0;
+	slice.mNumberOfErrorTerms = 0;
+
+	if(slice.mSequences.empty()) {
+		return;
+	}
+
+	int numberOfSteps = mWindowLength;
+	prepareSlice(slice, numberOfSteps);
+
+	for(int i = 1; i <= numberOfSteps; ++i) {
+		forwardStep(slice, i);
+	}
+	if(mComputeGradients) {
+		for(int i = numberOfSteps; i >= 1; --i) {
+			backwardStep(slice, i, i == numberOfSteps);
+		}
+	}
+	if(mRecurrent) {
+		//carry the state over to the next window.
+		qSwap(slice.mOutputs[0], slice.mOutputs[numberOfSteps]);
+	}
+}
+
+
+void DenseNetworkTrainer::sliceCompleted() {
+	QMutexLocker locker(&mSliceMutex);
+	mNumberOfPendingSlices--;
+	if(mNumberOfPendingSlices <= 0) {
+		mSlicesCompleted.wakeAll();
+	}
+}
+
+
+/**
+ * Calculates c += a * b for row-major matrices (a: m x k, b: k x n, c: m x n).
+ * The loops are blocked to keep a tile of b in the cache, the innermost loop 
+ * runs over contiguous memory and can be vectorized by the compiler. 
+ * Zero entries of a (missing synapses, clamped neurons) are skipped.
+ */
+void DenseNetworkTrainer::multiplyAdd(const double *a, const double *b, double *c, 
+								int m, int k, int n)
+{
+	const int columnBlock = 256;
+	const int innerBlock = 64;
+
+	for(int j0 = 0; j0 < n; j0 += columnBlock) {
+		int j1 = Math::min(j0 + columnBlock, n);
+		for(int p0 = 0; p0 < k; p0 += innerBlock) {
+			int p1 = Math::min(p0 + innerBlock, k);
+			for(int i = 0; i < m; ++i) {
+				const double *aRow = a + (i * k);
+				double *cRow = c + (i * n);
+				for(int p = p0; p < p1; ++p) {
+					double factor = aRow[p];
+					if(factor == 0.0) {
+						continue;
+					}
+					const double *bRow = b + (p * n);
+					for(int j = j0; j < j1; ++j) {
+						cRow[j] += factor * bRow[j];
+					}
+				}
+			}
+		}
+	}
+}
+
+
+/**
+ * Transposes the row-major matrix a (rows x columns) into result (columns x rows).
+ */
+void DenseNetworkTrainer::transpose(const double *a, double *result, int rows, int columns) {
+	const int block = 32;
+
+	for(int i0 = 0; i0 < rows; i0 += block) {
+		int i1 = Math::min(i0 + block, rows);
+		for(int j0 = 0; j0 < columns; j0 += block) {
+			int j1 = Math::min(j0 + block, columns);
+			for(int i = i0; i < i1; ++i) {
+				for(int j = j0; j < j1; ++j) {
+					result[(j * rows) + i] = a[(i * columns) + j];
+				}
+			}
+		}
+	}
+}
+
+
+void DenseNetworkTrainer::clear() {
+	mNetwork = 0;
+	mNumberOfNeurons = 0;
+	mNumberOfInputs = 0;
+	mNeurons.clear();
+	mLayerBounds.clear();
+	mOutputRows.clear();
+	mTransferFunctions.clear();
+	mDerivativeTypes.clear();
+	mDerivativeFactors.clear();
+	mWeights.clear();
+	mTransposedWeights.clear();
+	mBiases.clear();
+	mWeightVelocities.clear();
+	mBiasVelocities.clear();
+	mSynapseIndices.clear();
+	mSynapses.clear();
+	mSlices.clear();
+}
+
+
+/**
+ * Sorts the neurons into layers, so that each neuron only receives input from 
+ * input neurons or neurons of previous layers. 
+ *
+ * @return false if the neurons contain recurrences.
+ */
+bool DenseNetworkTrainer::determineLayers(const QList<Neuron*> &neurons, 
+						QList<Neuron*> &orderedNeurons)
+{
+	QSet<Neuron*> remainingNeurons = neurons.toSet();
+	QList<Neuron*> pendingNeurons = neurons;
+
+	while(!pendingNeurons.empty()) {
+		QList<Neuron*> layer;
+		QList<Neuron*> postponedNeurons;
+		for(QListIterator<Neuron*> i(pendingNeurons); i.hasNext();) {
+			Neuron *neuron = i.next();
+			bool ready = true;
+			QList<Synapse*> synapses = neuron->getSynapses();
+			for(QListIterator<Synapse*> j(synapses); j.hasNext();) {
+				Synapse *synapse = j.next();
+				if(synapse->getEnabledValue().get() 
+					&& remainingNeurons.contains(synapse->getSource())) 
+				{
+					ready = false;
+					break;
+				}
+			}
+			if(ready) {
+				layer.append(neuron);
+			}
+			else {
+				postponedNeurons.append(neuron);
+			}
+		}
+		if(layer.empty()) {
+			Core::log("DenseNetworkTrainer: The network is not a feed-forward network (recurrences?)", true);
+			return false;
+		}
+		for(QListIterator<Neuron*> i(layer); i.hasNext();) {
+			remainingNeurons.remove(i.next());
+		}
+		orderedNeurons += layer;
+		mLayerBounds.append(orderedNeurons.size());
+		pendingNeurons = postponedNeurons;
+	}
+	return true;
+}
+
+
+/**
+ * Processes all training sequences in mini-batches. Each mini-batch is split into
+ * one slice per thread. The worker threads are kept alive during the whole epoch.
+ */
+double DenseNetworkTrainer::processEpoch(bool updateWeights) {
+	if(mNetwork == 0 || mSequences.empty()) {
+		return 0.0;
+	}
+	mComputeGradients = updateWeights;
+
+	if(updateWeights) {
+		for(int i = mSequenceOrder.size() - 1; i > 0; --i) {
+			qSwap(mSequenceOrder[i], mSequenceOrder[Random::nextInt(i + 1)]);
+		}
+	}
+
+	int numberOfSequences = mSequenceOrder.size();
+	int numberOfSlices = Math::min(mNumberOfThreads, Math::min(mBatchSize, numberOfSequences));
+	mSlices.resize(numberOfSlices);
+	if(numberOfSlices > 1) {
+		startWorkers(numberOfSlices);
+	}
+
+	double squaredError = 0.0;
+	int numberOfErrorTerms = 0;
+
+	for(int first = 0; first < numberOfSequences; first += mBatchSize) {
+		int last = Math::min(first + mBatchSize, numberOfSequences);
+		int batchSize = last - first;
+
+		int length = 1;
+		for(int i = 0; i < numberOfSlices; ++i) {
+			mSlices[i].mSequences.clear();
+		}
+		for(int i = first; i < last; ++i) {
+			int sequence = mSequenceOrder.at(i);
+			mSlices[((i - first) * numberOfSlices) / batchSize].mSequences.append(sequence);
+			length = Math::max(length, mSequences.at(sequence).size());
+		}
+
+		int windowLength = mRecurrent ? mTruncationLength : 1;
+		for(mWindowStart = 0; mWindowStart < length; mWindowStart += windowLength) {
+			mWindowLength = Math::min(windowLength, length - mWindowStart);
+
+			runSlices();
+
+			for(int i = 0; i < numberOfSlices; ++i) {
+				squaredError += mSlices.at(i).mSquaredError;
+				numberOfErrorTerms += mSlices.at(i).mNumberOfErrorTerms;
+			}
+			if(updateWeights) {
+				this->updateWeights(batchSize);
+			}
+		}
+	}
+	stopWorkers();
+
+	if(numberOfErrorTerms == 0) {
+		return 0.0;
+	}
+	return squaredError / ((double) numberOfErrorTerms);
+}
+
+
+void DenseNetworkTrainer::runSlices() {
+	if(mWorkers.empty()) {
+		for(int i = 0; i < mSlices.size(); ++i) {
+			processSlice(i);
+		}
+		return;
+	}
+	QMutexLocker locker(&mSliceMutex);
+	mNumberOfPendingSlices = mWorkers.size();
+	mSliceGeneration++;
+	mSlicesAvailable.wakeAll();
+	while(mNumberOfPendingSlices > 0) {
+		mSlicesCompleted.wait(&mSliceMutex);
+	}
+}
+
+
+void DenseNetworkTrainer::startWorkers(int numberOfWorkers) {
+	mShutdown = false;
+	mSliceGeneration = 0;
+	for(int i = 0; i < numberOfWorkers; ++i) {
+		DenseNetworkTrainerWorker *worker = new DenseNetworkTrainerWorker(this, i);
+		mWorkers.append(worker);
+		worker->start();
+	}
+}
+
+
+void DenseNetworkTrainer::stopWorkers() {
+	{
+		QMutexLocker locker(&mSliceMutex);
+		mShutdown = true;
+		mSlicesAvailable.wakeAll();
+	}
+	while(!mWorkers.empty()) {
+		DenseNetworkTrainerWorker *worker = mWorkers.takeFirst();
+		worker->wait();
+		delete worker;
+	}
+}
+
+
+/**
+ * Makes sure that all buffers of the slice have the required size. At the 
+ * beginning of a sequence the carried state is reset to 0.
+ */
+void DenseNetworkTrainer::prepareSlice(DenseTrainerSlice &slice, int numberOfSteps) {
+	int size = mNumberOfNeurons * slice.mSequences.size();
+
+	if(slice.mOutputs.size() < numberOfSteps + 1) {
+		slice.mOutputs.resize(numberOfSteps + 1);
+		slice.mDerivatives.resize(numberOfSteps + 1);
+	}
+	for(int i = 0; i <= numberOfSteps; ++i) {
+		if(slice.mOutputs[i].size() != size) {
+			slice.mOutputs[i].fill(0.0, size);
+			slice.mDerivatives[i].fill(0.0, size);
+		}
+	}
+	if(mWindowStart == 0) {
+		slice.mOutputs[0].fill(0.0, size);
+	}
+	slice.mActivations.resize(size);
+	slice.mErrors.resize(size);
+	slice.mDeltas.resize(size);
+	slice.mNextDeltas.resize(size);
+	slice.mTransposed.resize(size);
+
+	if(mComputeGradients) {
+		slice.mGradient.fill(0.0, mNumberOfNeurons * mNumberOfNeurons);
+		slice.mBiasGradient.fill(0.0, mNumberOfNeurons);
+	}
+}
+
+
+void DenseNetworkTrainer::forwardStep(DenseTrainerSlice &slice, int step) {
+	int n = mNumberOfNeurons;
+	int width = slice.mSequences.size();
+	double *outputs = slice.mOutputs[step].data();
+	double *derivatives = slice.mDerivatives[step].data();
+	double *activations = slice.mActivations.data();
+	int firstRow = mNumberOfInputs;
+
+	if(mRecurrent) {
+		loadInputs(slice, step, outputs);
+
+		const double *previousOutputs = slice.mOutputs[step - 1].constData();
+		memset(activations + (firstRow * width), 0, (n - firstRow) * width * sizeof(double));
+		multiplyAdd(mWeights.constData() + (firstRow * n), previousOutputs, 
+					activations + (firstRow * width), n - firstRow, n, width);
+		transferRows(firstRow, n, width, activations, outputs, derivatives);
+	}
+	else {
+		//outputs of later layers must not contain values of the previous batch.
+		memset(outputs, 0, n * width * sizeof(double));
+		loadInputs(slice, step, outputs);
+
+		for(int i = 1; i < mLayerBounds.size(); ++i) {
+			int first = mLayerBounds.at(i - 1);
+			int last = mLayerBounds.at(i);
+			memset(activations + (first * width), 0, (last - first) * width * sizeof(double));
+			multiplyAdd(mWeights.constData() + (first * n), outputs, 
+						activations + (first * width), last - first, n, width);
+			transferRows(first, last, width, activations, outputs, derivatives);
+		}
+	}
+	addOutputErrors(slice, step, outputs, 0);
+}
+
+
+void DenseNetworkTrainer::backwardStep(DenseTrainerSlice &slice, int step, bool lastStep) {
+	int n = mNumberOfNeurons;
+	int width = slice.mSequences.size();
+	const double *outputs = slice.mOutputs[step].constData();
+	const double *derivatives = slice.mDerivatives[step].constData();
+	double *errors = slice.mErrors.data();
+	double *deltas = slice.mDeltas.data();
+	double *transposed = slice.mTransposed.data();
+	int inputSize = mNumberOfInputs * width;
+	int size = n * width;
+
+	memset(errors, 0, size * sizeof(double));
+	addOutputErrors(slice, step, outputs, errors);
+
+	if(mRecurrent) {
+		if(!lastStep) {
+			multiplyAdd(mTransposedWeights.constData(), slice.mNextDeltas.constData(), 
+						errors, n, n, width);
+		}
+		for(int i = 0; i < inputSize; ++i) {
+			deltas[i] = 0.0;
+		}
+		for(int i = inputSize; i < size; ++i) {
+			deltas[i] = derivatives[i] * errors[i];
+		}
+		transpose(slice.mOutputs[step - 1].constData(), transposed, n, width);
+	}
+	else {
+		memset(deltas, 0, size * sizeof(double));
+		for(int i = mLayerBounds.size() - 1; i >= 1; --i) {
+			int first = mLayerBounds.at(i - 1) * width;
+			int last = mLayerBounds.at(i) * width;
+			multiplyAdd(mTransposedWeights.constData() + (mLayerBounds.at(i - 1) * n), deltas,
+						errors + first, mLayerBounds.at(i) - mLayerBounds.at(i - 1), n, width);
+			for(int j = first; j < last; ++j) {
+				deltas[j] = derivatives[j] * errors[j];
+			}
+		}
+		transpose(outputs, transposed, n, width);
+	}
+
+	multiplyAdd(deltas, transposed, slice.mGradient.data(), n, width, n);
+
+	double *biasGradient = slice.mBiasGradient.data();
+	for(int i = mNumberOfInputs; i < n; ++i) {
+		const double *row = deltas + (i * width);
+		double sum = 0.0;
+		for(int j = 0; j < width; ++j) {
+			sum += row[j];
+		}
+		biasGradient[i] += sum;
+	}
+
+	if(mRecurrent) {
+		qSwap(slice.mDeltas, slice.mNextDeltas);
+	}
+}
+
+
+/**
+ * Writes the input values of the given window step into the rows of the input neurons.
+ * Sequences that are already finished get input 0.
+ */
+void DenseNetworkTrainer::loadInputs(DenseTrainerSlice &slice, int step, double *outputs) {
+	int width = slice.mSequences.size();
+	int sampleIndex = mWindowStart + step - 1;
+
+	for(int i = 0; i < width; ++i) {
+		const DenseTrainingSequence &sequence = mSequences.at(slice.mSequences.at(i));
+		const QVector<double> *inputs = 0;
+		if(sampleIndex < sequence.size()) {
+			inputs = &(sequence.at(sampleIndex).mInputs);
+		}
+		for(int j = 0; j < mNumberOfInputs; ++j) {
+			outputs[(j * width) + i] = (inputs != 0 && j < inputs->size()) ? inputs->at(j) : 0.0;
+		}
+	}
+}
+
+
+/**
+ * Compares the outputs with the desired values of the given window step. If errors 
+ * is 0, the squared error is accumulated, otherwise the derivative of the error 
+ * is added to errors.
+ */
+void DenseNetworkTrainer::addOutputErrors(DenseTrainerSlice &slice, int step, 
+						const double *outputs, double *errors)
+{
+	int width = slice.mSequences.size();
+	int sampleIndex = mWindowStart + step - 1;
+
+	for(int i = 0; i < width; ++i) {
+		const DenseTrainingSequence &sequence = mSequences.at(slice.mSequences.at(i));
+		if(sampleIndex >= sequence.size()) {
+			continue;
+		}
+		const QVector<double> &desiredOutputs = sequence.at(sampleIndex).mDesiredOutputs;
+		for(int j = 0; j < mOutputRows.size() && j < desiredOutputs.size(); ++j) {
+			int index = (mOutputRows.at(j) * width) + i;
+			double difference = outputs[index] - desiredOutputs.at(j);
+			if(errors != 0) {
+				errors[index] += difference;
+			}
+			else {
+				slice.mSquaredError += difference * difference;
+				slice.mNumberOfErrorTerms++;
+			}
+		}
+	}
+}
+
+
+/**
+ * Adds the biases, applies the transfer functions (with the batch interface of the 
+ * TransferFunctions) and calculates the derivatives for the rows [firstRow, lastRow).
+ */
+void DenseNetworkTrainer::transferRows(int firstRow, int lastRow, int width, 
+						double *activations, double *outputs, double *derivatives)
+{
+	for(int i = firstRow; i < lastRow; ++i) {
+		double *activationRow = activations + (i * width);
+		double *outputRow = outputs + (i * width);
+		double *derivativeRow = derivatives + (i * width);
+		double bias = mBiases.at(i);
+		double factor = mDerivativeFactors.at(i);
+
+		for(int j = 0; j < width; ++j) {
+			activationRow[j] += bias;
+		}
+		mTransferFunctions.at(i)->transferActivations(activationRow, outputRow, width);
+
+		switch(mDerivativeTypes.at(i)) {
+			case DERIVATIVE_SIGMOID:
+				for(int j = 0; j < width; ++j) {
+					derivativeRow[j] = factor * outputRow[j] * (1.0 - outputRow[j]);
+				}
+				break;
+			case DERIVATIVE_TANH:
+				for(int j = 0; j < width; ++j) {
+					derivativeRow[j] = 1.0 - (outputRow[j] * outputRow[j]);
+				}
+				break;
+			default:
+				for(int j = 0; j < width; ++j) {
+					derivativeRow[j] = 1.0;
+				}
+		}
+	}
+}
+
+
+/**
+ * Sums up the gradients of all slices and changes the weights of all existing 
+ * synapses (and the biases) by gradient descent with momentum.
+ */
+void DenseNetworkTrainer::updateWeights(int numberOfSequences) {
+	int n = mNumberOfNeurons;
+	double scale = mLearningRate / ((double) Math::max(1, numberOfSequences));
+
+	for(int i = 0; i < mSynapseIndices.size(); ++i) {
+		int index = mSynapseIndices.at(i);
+		double gradient = 0.0;
+		for(int j = 0; j < mSlices.size(); ++j) {
+			if(!mSlices.at(j).mSequences.empty()) {
+				gradient += mSlices.at(j).mGradient.at(index);
+			}
+		}
+		double change = (mMomentum * mWeightVelocities.at(i)) - (scale * gradient);
+		mWeightVelocities[i] = change;
+		mWeights[index] += change;
+		mTransposedWeights[((index % n) * n) + (index / n)] = mWeights.at(index);
+	}
+
+	if(mTrainBiases) {
+		for(int i = mNumberOfInputs; i < n; ++i) {
+			double gradient = 0.0;
+			for(int j = 0; j < mSlices.size(); ++j) {
+				if(!mSlices.at(j).mSequences.empty()) {
+					gradient += mSlices.at(j).mBiasGradient.at(i);
+				}
+			}
+			double change = (mMomentum * mBiasVelocities.at(i)) - (scale * gradient);
+			mBiasVelocities[i] = change;
+			mBiases[i] += change;
+		}
+	}
+}
+
+}
+
+
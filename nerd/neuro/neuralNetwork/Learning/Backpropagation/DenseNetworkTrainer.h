@@ -0,0 +1,243 @@
+/***************************************************************************
+ *   NERD - Neurodynamics and Evolutionary Robotics Development Toolkit    *
+ *                                                                         *
+ *   University of Osnabrueck, Germany                                     *
+ *   Institute of Cognitive Science                                        *
+ *   Neurocybernetics Group                                                *
+ *   http://www.ikw.uni-osnabrueck.de/~neurokybernetik/                    *
+ *                                                                         *
+ *   Project homepage: nerd.x-bot.org                                      *
+ *                                                                         *
+ *   Copyright (C) 2008 - 2013 by the Neurocybernetics Group Osnabrück     *
+ *   Contact: Christian Rempis                                             *
+ *   christian.rempis@uni-osnabrueck.de                                    *
+ *   Contributors: see contributors.txt in the nerd main directory.        *
+ *                                                                         *
+ *                                                                         *
+ *   Acknowledgments:                                                      *
+ *   The NERD Toolkit is part of the EU project ALEAR                      *
+ *   (Artificial Language Evolution on Autonomous Robots) www.ALEAR.eu     *
+ *   This work was funded (2008 - 2011) by EU-Project Number ICT 214856    *
+ *                                                                         *
+ *                                                                         *
+ *   License Agreement:                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ *                                                                         *
+ *   Publications based on work using the NERD kit have to state this      *
+ *   clearly by citing the NERD homepage and the NERD overview paper.      *  
+ ***************************************************************************/
+
+
+#ifndef NERDDenseNetworkTrainer_H
+#define NERDDenseNetworkTrainer_H
+
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QList>
+#include <QVector>
+#include "Network/Neuron.h"
+#include "Network/NeuralNetwork.h"
+
+namespace nerd {
+
+	class DenseNetworkTrainer;
+	class TransferFunction;
+
+	/**
+	 * A single time step of a training sequence. If mDesiredOutputs is empty, 
+	 * no error is calculated for this step.
+	 */
+	struct DenseTrainingSample {
+		QVector<double> mInputs;
+		QVector<double> mDesiredOutputs;
+	};
+
+	typedef QList<DenseTrainingSample> DenseTrainingSequence;
+
+
+	/**
+	 * Buffers of a part of a mini-batch. All matrices are stored neuron-major
+	 * (one row per neuron, one column per sequence of the slice).
+	 */
+	struct DenseTrainerSlice {
+		QList<int> mSequences;
+		QVector<QVector<double> > mOutputs;
+		QVector<QVector<double> > mDerivatives;
+		QVector<double> mActivations;
+		QVector<double> mErrors;
+		QVector<double> mDeltas;
+		QVector<double> mNextDeltas;
+		QVector<double> mTransposed;
+		QVector<double> mGradient;
+		QVector<double> mBiasGradient;
+		double mSquaredError;
+		int mNumberOfErrorTerms;
+	};
+
+
+	/**
+	 * DenseNetworkTrainerWorker.
+	 * Worker thread of a DenseNetworkTrainer. Lives for one epoch and 
+	 * processes one slice of each mini-batch.
+	 */
+	class DenseNetworkTrainerWorker : public QThread {
+	public:
+		DenseNetworkTrainerWorker(DenseNetworkTrainer *trainer, int index);
+		virtual ~DenseNetworkTrainerWorker();
+
+	protected:
+		virtual void run();
+
+	private:
+		DenseNetworkTrainer *mTrainer;
+		int mIndex;
+	};
+
+
+	/**
+	 * DenseNetworkTrainer.
+	 *
+	 * Gradient descent trainer working on a dense matrix representation of a 
+	 * NeuralNetwork. Unlike Backpropagation, which walks the synapse lists of each
+	 * neuron for every sample, the network is converted once into a weight matrix
+	 * and a bias vector. Mini-batches are then processed with blocked matrix kernels
+	 * that are distributed over several threads (one slice of the batch per thread).
+	 * After training, writeWeightsToNetwork() copies the weights back into the synapses.
+	 *
+	 * Two modes are supported:
+	 * - Feed-forward: the network has to be acyclic. Activations are propagated 
+	 *   through all layers at once, as in Backpropagation. Each sample of the 
+	 *   training data is treated as an independent pattern.
+	 * - Recurrent: the network is updated synchronously, as in NeuralNetwork::executeStep().
+	 *   The sequences are trained with truncated backpropagation through time, 
+	 *   the weights are updated after each window of TruncationLength steps. 
+	 *   All neurons start with an output of 0.
+	 *
+	 * Only networks with AdditiveTimeDiscreteActivationFunctions, SimpleSynapseFunctions
+	 * and differentiable standard transfer functions (neutral, sigmoid, parameterized
+	 * sigmoid, tanh and the A/M-Series tanh) can be converted. The values of the 
+	 * input neurons are directly used as their outputs. Only existing (enabled) synapses
+	 * are trained. The error function is the mean squared error.
+	 */
+	class DenseNetworkTrainer {
+	public:
+		DenseNetworkTrainer();
+		virtual ~DenseNetworkTrainer();
+
+		bool setNetwork(NeuralNetwork *network, const QList<Neuron*> &inputs, 
+						const QList<Neuron*> &outputs, bool recurrent);
+		bool isRecurrent() const;
+		int getNumberOfNeurons() const;
+
+		void setTrainingData(const QList<DenseTrainingSequence> &sequences);
+		int getNumberOfTrainingSequences() const;
+
+		double train(int numberOfEpochs);
+		double trainEpoch();
+		double calculateError();
+
+		void readWeightsFromNetwork();
+		void writeWeightsToNetwork();
+		double getWeight(Neuron *target, Neuron *source) const;
+
+		void setLearningRate(double rate);
+		double getLearningRate() const;
+		void setMomentum(double momentum);
+		double getMomentum() const;
+		void setBatchSize(int size);
+		int getBatchSize() const;
+		void setTruncationLength(int numberOfSteps);
+		int getTruncationLength() const;
+		void setNumberOfThreads(int numberOfThreads);
+		int getNumberOfThreads() const;
+		void setTrainBiases(bool train);
+		bool isTrainingBiases() const;
+
+		bool waitForSlice(int &generation);
+		void processSlice(int index);
+		void sliceCompleted();
+
+		static void multiplyAdd(const double *a, const double *b, double *c, 
+								int m, int k, int n);
+		static void transpose(const double *a, double *result, int rows, int columns);
+
+	private:
+		enum {DERIVATIVE_LINEAR, DERIVATIVE_SIGMOID, DERIVATIVE_TANH};
+
+		void clear();
+		bool determineLayers(const QList<Neuron*> &neurons, QList<Neuron*> &orderedNeurons);
+		double processEpoch(bool updateWeights);
+		void runSlices();
+		void startWorkers(int numberOfWorkers);
+		void stopWorkers();
+		void prepareSlice(DenseTrainerSlice &slice, int numberOfSteps);
+		void forwardStep(DenseTrainerSlice &slice, int step);
+		void backwardStep(DenseTrainerSlice &slice, int step, bool lastStep);
+		void loadInputs(DenseTrainerSlice &slice, int step, double *outputs);
+		void addOutputErrors(DenseTrainerSlice &slice, int step, const double *outputs, double *errors);
+		void transferRows(int firstRow, int lastRow, int width, double *activations, 
+						  double *outputs, double *derivatives);
+		void updateWeights(int numberOfSequences);
+
+	private:
+		NeuralNetwork *mNetwork;
+		bool mRecurrent;
+		int mNumberOfNeurons;
+		int mNumberOfInputs;
+		QList<Neuron*> mNeurons;
+		QList<int> mLayerBounds;
+		QVector<int> mOutputRows;
+		QVector<TransferFunction*> mTransferFunctions;
+		QVector<int> mDerivativeTypes;
+		QVector<double> mDerivativeFactors;
+
+		QVector<double> mWeights;
+		QVector<double> mTransposedWeights;
+		QVector<double> mBiases;
+		QVector<double> mWeightVelocities;
+		QVector<double> mBiasVelocities;
+		QVector<int> mSynapseIndices;
+		QList<Synapse*> mSynapses;
+
+		QList<DenseTrainingSequence> mSequences;
+		QVector<int> mSequenceOrder;
+		int mWindowStart;
+		int mWindowLength;
+		bool mComputeGradients;
+
+		double mLearningRate;
+		double mMomentum;
+		int mBatchSize;
+		int mTruncationLength;
+		int mNumberOfThreads;
+		bool mTrainBiases;
+
+		QVector<DenseTrainerSlice> mSlices;
+		QList<DenseNetworkTrainerWorker*> mWorkers;
+		QMutex mSliceMutex;
+		QWaitCondition mSlicesAvailable;
+		QWaitCondition mSlicesCompleted;
+		int mSliceGeneration;
+		int mNumberOfPendingSlices;
+		bool mShutdown;
+	};
+
+}
+
+#endif
+
@@ -245,9 +245,13 @@ bool ModularNeuralNetwork::addNeuronGroup(NeuronGroup *group) {
 		mNeuronGroups.append(group);
 
 		//add all neurons of group, that are not already part of the network
+		//(the id lookup avoids a linear search for neurons that are already known)
 		QList<Neuron*> groupNeurons = group->getNeurons();
 		for(QListIterator<Neuron*> i(groupNeurons); i.hasNext();) {
 			Neuron *neuron = i.next();
+			if(neuron != 0 && mNeuronsById.value(neuron->getId()) == neuron) {
+				continue;
+			}
 			if(!mNeurons.contains(neuron)) {
 				addNeuron(neuron);
 			}
@@ -43,6 +43,8 @@
 
 #include "NeuralNetwork.h"
 #include <QListIterator>
+#include <QVector>
+#include <QSet>
 #include "TransferFunction/TransferFunctionTanh.h"
 #include "ActivationFunction/AdditiveTimeDiscreteActivationFunction.h"
 #include "SynapseFunction/SimpleSynapseFunction.h"
@@ -57,6 +59,8 @@
 #include "Network/Neuro.h"
 #include "Util/Util.h"
 #include "NeuralNetworkConstants.h"
+#include "NeuroModulation/NeuroModulatorField.h"
+#include "Network/SpikingEventEngine.h"
 #include <limits>
 
 #define TRACE(message)
@@ -73,13 +77,17 @@ NeuralNetwork::NeuralNetwork(const ActivationFunction &defaultActivationFunction
 	: mDefaultActivationFunction(defaultActivationFunction.createCopy()),
 	  mDefaultTransferFunction(defaultTransferFunction.createCopy()),
 	  mDefaultSynapseFunction(defaultSynapseFunction.createCopy()),
-	  mControlInterface(0), mBypassNetwork(false)
+	  mControlInterface(0), mBypassNetwork(false), mMinimalIterationNumber(0),
+	  mNeuroModulatorField(0), mExecutionScheduleValid(false), mScheduleStartIteration(0),
+	  mScheduleIterationRevision(0), mSpikingEventEngine(0)
 {
 	TRACE("NeuralNetwork::NeuralNetwork");
 }
 
 NeuralNetwork::NeuralNetwork(const NeuralNetwork &other) 
-		: Controller(), Object(), Properties(other), mControlInterface(0), mBypassNetwork(false)
+		: Controller(), Object(), Properties(other), mControlInterface(0), mBypassNetwork(false),
+		  mMinimalIterationNumber(0), mNeuroModulatorField(0), mExecutionScheduleValid(false),
+		  mScheduleStartIteration(0), mScheduleIterationRevision(0), mSpikingEventEngine(0)
 {
 	TRACE("NeuralNetwork::NeuralNetworkCopy");
 
@@ -87,21 +95,15 @@ NeuralNetwork::NeuralNetwork(const NeuralNetwork &other)
 	mDefaultTransferFunction = other.mDefaultTransferFunction->createCopy();
 	mDefaultSynapseFunction = other.mDefaultSynapseFunction->createCopy();
 
-	QList<SynapseTarget*> synapseTargets;
-	QList<Synapse*> newSynapses;
-
 	QList<Neuron*> neuronPrototypes = other.mNeurons;
 	QList<Synapse*> synapsePrototypes = other.getSynapses();
 
-// 	{
-// 		QList<SynapseTarget*> synapseTargetPrototypes;
-// 		for(QListIterator<Neuron*> i(neuronPrototypes); i.hasNext();) {
-// 			synapseTargetPrototypes.append(i.next());
-// 		}
-// 		for(QListIterator<Synapse*> i(synapsePrototypes); i.hasNext();) {
-// 			synapseTargetPrototypes.append(i.next());
-// 		}
-// 	}
+	//the copies are stored at the same index as their prototypes, so that no 
+	//search by id is required to connect them (copying is linear in the network size).
+	QVector<Synapse*> newSynapses(synapsePrototypes.size());
+
+	mNeurons.reserve(neuronPrototypes.size());
+	mNeuronsById.reserve(neuronPrototypes.size());
 
 	//copy all neurons.
 	{
@@ -111,35 +113,30 @@ NeuralNetwork::NeuralNetwork(const NeuralNetwork &other)
 			//memorize copy in orig. Never use this pointer for anything else than 
 			//during construction! This is for performance optimization only.
 			orig->mCopyPtr = n;
-			addNeuron(n);
-// 			synapseTargets.append(n);
+			insertNeuron(n, false);
 		}
 	}
 	//copy all synapses.
 	{
-		for(QListIterator<Synapse*> i(synapsePrototypes); i.hasNext();) {
-			Synapse *orig = i.next();
+		for(int i = 0; i < synapsePrototypes.size(); ++i) {
+			Synapse *orig = synapsePrototypes.at(i);
 			Synapse *s = orig->createCopy();
 			orig->mCopyPtr = s;
-// 			synapseTargets.append(s);
-			newSynapses.append(s);
+			newSynapses[i] = s;
 		}
 	}
 	//assign synapses
 	{
-		for(QListIterator<Synapse*> i(newSynapses); i.hasNext();) {
-			Synapse *copy = i.next();
-			Synapse *prototype = selectSynapseById(copy->getId(), synapsePrototypes);
+		for(int i = 0; i < newSynapses.size(); ++i) {
+			Synapse *copy = newSynapses.at(i);
+			Synapse *prototype = synapsePrototypes.at(i);
 			if(prototype == 0 || prototype->getSource() == 0 || prototype->getTarget() == 0) {
 				//TODO this has to be removed, because when creating a module this is valid.
 				Core::log("NeuralNetwork::copyConstructor: Detected synapse without "
 						  "target or source in synapse prototypes or a NULL synapse! [Skipping]");
 				continue;
 			}
-			//Neuron *source = selectNeuronById(prototype->getSource()->getId(), mNeurons);
 			Neuron *source = dynamic_cast<Neuron*>(prototype->getSource()->mCopyPtr);
-// 			SynapseTarget *target = selectSynapseTargetById(prototype->getTarget()->getId(),
-//  										synapseTargets);
 			SynapseTarget *target = dynamic_cast<SynapseTarget*>(prototype->getTarget()->mCopyPtr);
 
 			if(source == 0 || target == 0) {
@@ -152,6 +149,7 @@ NeuralNetwork::NeuralNetwork(const NeuralNetwork &other)
 			target->addSynapse(copy);
 		}
 	}
+	mMinimalIterationNumber = getMinimalStartIteration();
 	
 	validateSynapseConnections();
 }
@@ -162,6 +160,8 @@ NeuralNetwork::~NeuralNetwork() {
 	delete mDefaultTransferFunction;
 	delete mDefaultActivationFunction;
 	delete mDefaultSynapseFunction;
+	delete mNeuroModulatorField;
+	delete mSpikingEventEngine;
 
 	while(!mNeurons.empty()) {
 		Neuron *n = mNeurons.at(0);
@@ -286,9 +286,30 @@ ControlInterface* NeuralNetwork::getControlInterface() const {
 
 
 
+/**
+ * Executes the network: the input neurons are set from the control interface,
+ * the network is updated numberOfSteps times and the activations of the output 
+ * neurons are written back to the control interface.
+ *
+ * The three phases are also available separately. This allows the NeuralNetworkManager
+ * to update several networks in parallel, while all interface accesses remain
+ * sequential and in a fixed order.
+ */
 void NeuralNetwork::executeStep(int numberOfSteps) {
 	TRACE("NeuralNetwork::executeStep");
 
+	readInputs();
+	executeIterations(numberOfSteps);
+	writeOutputs();
+}
+
+
+/**
+ * Sets the activation of all input neurons from their interface values.
+ */
+void NeuralNetwork::readInputs() {
+	TRACE("NeuralNetwork::readInputs");
+
 	//update input neurons
 	for(QListIterator<NeuronInterfaceValuePair> i(mInputPairs); i.hasNext();) {
 		NeuronInterfaceValuePair pair = i.next();
@@ -305,77 +326,80 @@ void NeuralNetwork::executeStep(int numberOfSteps) {
 			pair.mNeuron->getOutputActivationValue().set(activation);
 		}
 	}
-	
+}
+
+
+/**
+ * Updates all processible neurons numberOfSteps times. This method does not access
+ * the control interface and may be called from a worker thread. In that case no 
+ * iteration events are triggered and no pending tasks are executed.
+ */
+void NeuralNetwork::executeIterations(int numberOfSteps) {
+	TRACE("NeuralNetwork::executeIterations");
+
+	bool mainThread = Core::getInstance()->isMainExecutionThread();
+
 	for(int k = 0; k < numberOfSteps; ++k) {
 
+		//modulator emitters may have moved or changed since the last step.
+		invalidateNeuroModulatorField();
+
 		for(QListIterator<Neuron*> i(mNeurons); i.hasNext();) {
 			//prepare ALL neurons
 			i.next()->prepare();
 		}
 
-		int currentIteration = mMinimalIterationNumber;
+		//the schedule only changes with the network structure or the iteration settings.
+		if(!mExecutionScheduleValid || mScheduleStartIteration != mMinimalIterationNumber
+			|| mScheduleIterationRevision != NeuralNetworkElement::getIterationRevision())
+		{
+			updateExecutionSchedule();
+		}
+
+		Neuron* const *scheduledNeurons = mScheduledNeurons.constData();
+		const int *offsets = mScheduleOffsets.constData();
+		int numberOfIterations = mScheduleOffsets.size() - 1;
 
-		QLinkedList<Neuron*> remainingNeurons = mProcessibleNeurons;
-		QLinkedList<Neuron*> lastExecutedNeurons;
+		//networks of spiking neurons may be updated event-driven (single iteration only).
+		bool eventDriven = numberOfIterations == 1 
+				&& hasProperty(NeuralNetworkConstants::TAG_NETWORK_EVENT_DRIVEN_SPIKING)
+				&& executeEventDriven();
 
-		do {
-			
-			//QLinkedList<Neuron*> remainingNeuronsBuffer = remainingNeurons;
-			for(QLinkedList<Neuron*>::iterator j = remainingNeurons.begin(); j != remainingNeurons.end();) {
-				//if(neuron->getStartIteration() <= currentIteration)
-				if((*j)->requiresUpdate(currentIteration)) {
-					lastExecutedNeurons.append(*j);
-					//remainingNeurons.removeAll(neuron);
-					j = remainingNeurons.erase(j);
-				}
-				else if((*j)->getStartIteration() < currentIteration) {
-					j = remainingNeurons.erase(j);
-				}
-				else {
-					j++;
-				}
-			}
+		for(int iteration = 0; iteration < numberOfIterations; ++iteration) {
+			int start = offsets[iteration];
+			int end = offsets[iteration + 1];
 
 			//update all affected neurons
-			for(QLinkedList<Neuron*>::iterator i = lastExecutedNeurons.begin(); 
-							i != lastExecutedNeurons.end(); i++) 
-			{
-				(*i)->updateActivation();
+			if(!eventDriven) {
+				for(int j = start; j < end; ++j) {
+					scheduledNeurons[j]->updateActivation();
+				}
 			}
 
 			//prepare for next iteration
-			for(QLinkedList<Neuron*>::iterator i = lastExecutedNeurons.begin(); 
-							i != lastExecutedNeurons.end(); i++) 
-			{
-				(*i)->prepare();
+			for(int j = start; j < end; ++j) {
+				scheduledNeurons[j]->prepare();
 			}
 
-			++currentIteration;
-
-			//update list or affected neurons
-			//QLinkedList<Neuron*> lastExecutedNeuronsBuffer = lastExecutedNeurons;
-			for(QLinkedList<Neuron*>::iterator j = lastExecutedNeurons.begin(); 
-						j != lastExecutedNeurons.end();) 
-			{
-				//if(neuron->getStartIteration() + (neuron->getRequiredIterations() - 1) < currentIteration) {
-				if(!(*j)->requiresUpdate(currentIteration)) {
-					//lastExecutedNeurons.removeAll(neuron);
-					j = lastExecutedNeurons.erase(j);
-				}
-				else {
-					j++;
-				}
+			if(mainThread) {
+				Neuro::getNeuralNetworkManager()->triggerNetworkIterationCompleted();
 			}
-
-			Neuro::getNeuralNetworkManager()->triggerNetworkIterationCompleted();
-
-		} while(!lastExecutedNeurons.empty() || !remainingNeurons.empty());
+		}
 		
-		if(k < numberOfSteps) {
+		//networks may also be executed in worker threads (e.g. for parallel parameter sweeps).
+		if(k < numberOfSteps && mainThread) {
 			Core::getInstance()->executePendingTasks();
 		}
 	}
-	
+}
+
+
+/**
+ * Transfers the activations of the output neurons to their interface values.
+ */
+void NeuralNetwork::writeOutputs() {
+	TRACE("NeuralNetwork::writeOutputs");
+
 	//transfer output neuron activations to actuators
 	if(!mBypassNetwork) {
 		for(QListIterator<NeuronInterfaceValuePair> i(mOutputPairs); i.hasNext();) {
@@ -395,12 +419,104 @@ void NeuralNetwork::executeStep(int numberOfSteps) {
 	}
 }
 
+
+/**
+ * Calculates which neurons have to be executed in which (sub-) iteration of a
+ * network step. The schedule depends only on the processible neurons and on the 
+ * iteration settings (ODN tags) of the neurons and synapses, so it is reused by
+ * executeStep() until one of them changes.
+ */
+void NeuralNetwork::updateExecutionSchedule() {
+	mScheduleIterationRevision = NeuralNetworkElement::getIterationRevision();
+	mScheduleStartIteration = mMinimalIterationNumber;
+
+	mScheduledNeurons.clear();
+	mScheduleOffsets.clear();
+	mScheduleOffsets.append(0);
+
+	int currentIteration = mMinimalIterationNumber;
+
+	QLinkedList<Neuron*> remainingNeurons = mProcessibleNeurons;
+	QLinkedList<Neuron*> lastExecutedNeurons;
+
+	do {
+		for(QLinkedList<Neuron*>::iterator j = remainingNeurons.begin(); j != remainingNeurons.end();) {
+			if((*j)->requiresUpdate(currentIteration)) {
+				lastExecutedNeurons.append(*j);
+				j = remainingNeurons.erase(j);
+			}
+			else if((*j)->getStartIteration() < currentIteration) {
+				j = remainingNeurons.erase(j);
+			}
+			else {
+				j++;
+			}
+		}
+
+		for(QLinkedList<Neuron*>::iterator i = lastExecutedNeurons.begin(); 
+						i != lastExecutedNeurons.end(); i++) 
+		{
+			mScheduledNeurons.append(*i);
+		}
+		mScheduleOffsets.append(mScheduledNeurons.size());
+
+		++currentIteration;
+
+		//update list or affected neurons
+		for(QLinkedList<Neuron*>::iterator j = lastExecutedNeurons.begin(); 
+					j != lastExecutedNeurons.end();) 
+		{
+			if(!(*j)->requiresUpdate(currentIteration)) {
+				j = lastExecutedNeurons.erase(j);
+			}
+			else {
+				j++;
+			}
+		}
+	} while(!lastExecutedNeurons.empty() || !remainingNeurons.empty());
+
+	mExecutionScheduleValid = true;
+
+	if(mSpikingEventEngine != 0) {
+		mSpikingEventEngine->invalidate();
+	}
+}
+
+
+/**
+ * Updates all scheduled neurons with the SpikingEventEngine. 
+ *
+ * @return false if the network can not be updated event-driven.
+ */
+bool NeuralNetwork::executeEventDriven() {
+	if(mSpikingEventEngine == 0) {
+		mSpikingEventEngine = new SpikingEventEngine(this);
+	}
+	return mSpikingEventEngine->executeStep(mScheduledNeurons);
+}
+
+
+/**
+ * Forces a recalculation of the execution schedule before the next network step.
+ * This is called automatically when neurons are added or removed, when synapses
+ * of a neuron change or when a neuron becomes an input neuron.
+ */
+void NeuralNetwork::invalidateExecutionSchedule() {
+	mExecutionScheduleValid = false;
+}
+
+
 void NeuralNetwork::reset() { 
 	TRACE("NeuralNetwork::reset");
 
 	for(QListIterator<Neuron*> i(mNeurons); i.hasNext();) {
 		i.next()->reset();
 	}
+	invalidateNeuroModulatorField();
+
+	if(mSpikingEventEngine != 0) {
+		mSpikingEventEngine->reset();
+	}
 
 	mMinimalIterationNumber = getMinimalStartIteration();
 }
@@ -422,6 +538,7 @@ void NeuralNetwork::propertyChanged(Properties *owner, const QString &property)
 					mProcessibleNeurons.append(neuron);
 				}
 			}
+			invalidateExecutionSchedule();
 		}
 		else if(property == NeuralNetworkConstants::TAG_OUTPUT_NEURON) {
 			if(owner->hasProperty(NeuralNetworkConstants::TAG_OUTPUT_NEURON)) {
@@ -447,31 +564,54 @@ bool NeuralNetwork::addNeuron(Neuron *neuron) {
 	if(neuron == 0 || mNeurons.contains(neuron)) {
 		return false;
 	}
+	insertNeuron(neuron, true);
+
+	invalidateNeuroModulatorField();
+	invalidateExecutionSchedule();
+
+	mMinimalIterationNumber = getMinimalStartIteration();
+
+	return true;
+}
+
+
+/**
+ * Inserts the neuron into the neuron lists of the network and sets the default 
+ * functions if the neuron has none. 
+ *
+ * @param checkLists if false, the neuron is known to be in none of the lists yet 
+ *        (neurons created by the copy constructor), so that the lists are not searched.
+ */
+void NeuralNetwork::insertNeuron(Neuron *neuron, bool checkLists) {
 	if(neuron->getTransferFunction() == 0) {
 		neuron->setTransferFunction(*mDefaultTransferFunction);
 	}
 	if(neuron->getActivationFunction() == 0) {
 		neuron->setActivationFunction(*mDefaultActivationFunction);
 	}
-	if(neuron->hasProperty(NeuralNetworkConstants::TAG_INPUT_NEURON) && !mInputNeurons.contains(neuron)) {
-		mInputNeurons.append(neuron);
-		mProcessibleNeurons.removeAll(neuron);
-	}
-	if(neuron->hasProperty(NeuralNetworkConstants::TAG_OUTPUT_NEURON) && !mOutputNeurons.contains(neuron)) {
-		mOutputNeurons.append(neuron);
+	if(neuron->hasProperty(NeuralNetworkConstants::TAG_INPUT_NEURON)) {
+		if(!checkLists || !mInputNeurons.contains(neuron)) {
+			mInputNeurons.append(neuron);
+		}
+		if(checkLists) {
+			mProcessibleNeurons.removeAll(neuron);
+		}
 	}
-	if(!mInputNeurons.contains(neuron) && !mProcessibleNeurons.contains(neuron)) {
+	else if(!checkLists 
+			|| (!mInputNeurons.contains(neuron) && !mProcessibleNeurons.contains(neuron))) 
+	{
 		mProcessibleNeurons.append(neuron);
 	}
+	if(neuron->hasProperty(NeuralNetworkConstants::TAG_OUTPUT_NEURON) 
+		&& (!checkLists || !mOutputNeurons.contains(neuron))) 
+	{
+		mOutputNeurons.append(neuron);
+	}
 	mNeurons.append(neuron);
 	mNeuronsById.insert(neuron->getId(), neuron);
 	
 	neuron->addPropertyChangedListener(this);
 	neuron->setOwnerNetwork(this);
-
-	mMinimalIterationNumber = getMinimalStartIteration();
-
-	return true;
 }
 
 
@@ -490,6 +630,8 @@ bool NeuralNetwork::removeNeuron(Neuron *neuron) {
 
 	neuron->removePropertyChangedListener(this);
 	neuron->setOwnerNetwork(0);
+	invalidateNeuroModulatorField();
+	invalidateExecutionSchedule();
 	return true;
 }
 
@@ -696,8 +838,11 @@ void NeuralNetwork::validateSynapseConnections() {
 	bool ok = false;
 	QList<Synapse*> removedSynapses;
 
+	QSet<Neuron*> neurons = mNeurons.toSet();
+
 	while(!ok) {
 		QList<Synapse*> synapses = getSynapses();
+		QSet<Synapse*> synapseSet = synapses.toSet();
 		ok = true;
 		for(QListIterator<Synapse*> i(synapses); i.hasNext();) {
 			Synapse *s = i.next();
@@ -707,7 +852,7 @@ void NeuralNetwork::validateSynapseConnections() {
 				return;
 			}
 			else {
-				if(s->getSource() == 0 || !mNeurons.contains(s->getSource())) {
+				if(s->getSource() == 0 || !neurons.contains(s->getSource())) {
 					ok = false;
 					removedSynapses.append(s);
 					s->getTarget()->removeSynapse(s);
@@ -715,10 +860,13 @@ void NeuralNetwork::validateSynapseConnections() {
 				}
 				else if(s->getTarget() != 0) {
 					SynapseTarget *target = s->getTarget();
-					if(!getSynapses().contains(dynamic_cast<Synapse*>(target)) 
-							&& !mNeurons.contains(dynamic_cast<Neuron*>(target))) {
+					if(!synapseSet.contains(dynamic_cast<Synapse*>(target)) 
+							&& !neurons.contains(dynamic_cast<Neuron*>(target))) {
+						//the synapse set is outdated now, so start over.
+						ok = false;
 						removedSynapses.append(s);
 						target->removeSynapse(s);
+						break;
 					}
 				}
 			}
@@ -829,6 +977,8 @@ void NeuralNetwork::freeElements(bool destroyElements) {
 	mOutputNeurons.clear();
 	mProcessibleNeurons.clear();
 	mNeuronsById.clear();
+	invalidateNeuroModulatorField();
+	invalidateExecutionSchedule();
 	if(controller != 0) {
 		setControlInterface(controller);
 	}
@@ -849,6 +999,56 @@ bool NeuralNetwork::isBypassingNetwork() const {
 }
 
 
+/**
+ * Returns true if all functions of the network are thread safe, so that the network
+ * can be updated concurrently with other networks (see NeuralNetworkExecutionPool).
+ */
+bool NeuralNetwork::isThreadSafe() const {
+	for(QListIterator<Neuron*> i(mNeurons); i.hasNext();) {
+		Neuron *neuron = i.next();
+		if((neuron->getTransferFunction() != 0 && !neuron->getTransferFunction()->isThreadSafe())
+			|| (neuron->getActivationFunction() != 0 
+				&& !neuron->getActivationFunction()->isThreadSafe()))
+		{
+			return false;
+		}
+	}
+	QList<Synapse*> synapses = getSynapses();
+	for(QListIterator<Synapse*> i(synapses); i.hasNext();) {
+		SynapseFunction *sf = i.next()->getSynapseFunction();
+		if(sf != 0 && !sf->isThreadSafe()) {
+			return false;
+		}
+	}
+	return true;
+}
+
+
+/**
+ * Returns true if a ValueChangedListener observes the activation or output of a neuron
+ * or the strength of a synapse. These Values are set during the network update, so
+ * a NeuralNetworkExecutionPool updates such networks in the calling thread, where 
+ * the listeners expect to be notified.
+ */
+bool NeuralNetwork::hasObservedStateValues() const {
+	for(QListIterator<Neuron*> i(mNeurons); i.hasNext();) {
+		Neuron *neuron = i.next();
+		if(!neuron->getActivationValue().getValueChangedListeners().empty()
+			|| !neuron->getOutputActivationValue().getValueChangedListeners().empty())
+		{
+			return true;
+		}
+	}
+	QList<Synapse*> synapses = getSynapses();
+	for(QListIterator<Synapse*> i(synapses); i.hasNext();) {
+		if(!i.next()->getStrengthValue().getValueChangedListeners().empty()) {
+			return true;
+		}
+	}
+	return false;
+}
+
+
 int NeuralNetwork::getHighestRequiredIterationNumber() const {
 	int highest = 0;
 	for(QListIterator<Neuron*> i(mNeurons); i.hasNext();) {
@@ -915,6 +1115,29 @@ void NeuralNetwork::synchronizeNeuronIds() {
 }
 
 
+/**
+ * Returns the cache with the modulator emitters of this network, 
+ * used by NeuroModulator::getConcentrationInNetworkAt().
+ */
+NeuroModulatorField* NeuralNetwork::getNeuroModulatorField() {
+	if(mNeuroModulatorField == 0) {
+		mNeuroModulatorField = new NeuroModulatorField(this);
+	}
+	return mNeuroModulatorField;
+}
+
+
+/**
+ * Forces the NeuroModulatorField to collect the modulator emitters again.
+ * This is done automatically at the beginning of each step.
+ */
+void NeuralNetwork::invalidateNeuroModulatorField() {
+	if(mNeuroModulatorField != 0) {
+		mNeuroModulatorField->invalidate();
+	}
+}
+
+
 qulonglong NeuralNetwork::mIdPool = 1;
 
 qulonglong NeuralNetwork::generateNextId() {
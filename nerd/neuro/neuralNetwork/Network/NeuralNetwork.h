@@ -49,6 +49,7 @@
 #include <QList>
 #include <QLinkedList>
 #include <QHash>
+#include <QVector>
 #include "TransferFunction/TransferFunction.h"
 #include "ActivationFunction/ActivationFunction.h"
 #include "SynapseFunction/SynapseFunction.h"
@@ -65,6 +66,8 @@
 namespace nerd {
 
 	class ControlInterface;
+	class NeuroModulatorField;
+	class SpikingEventEngine;
 
 	class NeuronInterfaceValuePair {
 	public:
@@ -102,6 +105,10 @@ namespace nerd {
 		virtual void executeStep(int numberOfSteps = 1);
 		virtual void reset();
 
+		virtual void readInputs();
+		virtual void executeIterations(int numberOfSteps);
+		virtual void writeOutputs();
+
 		virtual bool addNeuron(Neuron *neuron);
 		virtual bool removeNeuron(Neuron *neuron);
 		virtual QList<Neuron*> getNeurons() const;
@@ -132,6 +139,8 @@ namespace nerd {
 
 		void bypassNetwork(bool bypass);
 		bool isBypassingNetwork() const;
+		virtual bool isThreadSafe() const;
+		virtual bool hasObservedStateValues() const;
 
 		virtual int getHighestRequiredIterationNumber() const;
 		virtual QList<Neuron*> getNeuronsWithIterationRequirement(int requirement);
@@ -140,6 +149,10 @@ namespace nerd {
 
 		Neuron* getNeuronById(qulonglong id) const;
 		void synchronizeNeuronIds();
+		
+		NeuroModulatorField* getNeuroModulatorField();
+		void invalidateNeuroModulatorField();
+		void invalidateExecutionSchedule();
 
 		static qulonglong generateNextId();
 		static void resetIdCounter(qulonglong currentId = 0);
@@ -162,6 +175,11 @@ namespace nerd {
 		QList<Neuron*> mNeurons;
 		QHash<qulonglong, Neuron*> mNeuronsById;
 
+	private:
+		void insertNeuron(Neuron *neuron, bool checkLists);
+		void updateExecutionSchedule();
+		bool executeEventDriven();
+
 	private:		
 		static qulonglong mIdPool;
 		
@@ -177,6 +195,15 @@ namespace nerd {
 		QLinkedList<Neuron*> mProcessibleNeurons;
 		bool mBypassNetwork;
 		int mMinimalIterationNumber;
+		NeuroModulatorField *mNeuroModulatorField;
+
+		//neurons to execute in each iteration (range mScheduleOffsets[i] .. mScheduleOffsets[i + 1]).
+		QVector<Neuron*> mScheduledNeurons;
+		QVector<int> mScheduleOffsets;
+		bool mExecutionScheduleValid;
+		int mScheduleStartIteration;
+		int mScheduleIterationRevision;
+		SpikingEventEngine *mSpikingEventEngine;
 	};
 
 }
@@ -52,18 +52,22 @@
 #include <QStringList>
 #include "Math/Math.h"
 #include "Network/NeuralNetwork.h"
+#include "Network/NeuroTagManager.h"
 
 using namespace std;
 
 namespace nerd {
 
+QAtomicInt NeuralNetworkElement::mIterationRevision(0);
+
 
 /**
  * Constructs a new NeuralNetworkElement.
  */
 NeuralNetworkElement::NeuralNetworkElement()
-	: mStartIteration(0), mRequiredIterations(1), mCopyPtr(0)
+	: mStartIteration(0), mRequiredIterations(1), mStoringStateSlots(false), mCopyPtr(0)
 {
+	rebuildTagBits();
 	addPropertyChangedListener(this);
 
 	QList<QString> optionalPrefixes;
@@ -73,9 +77,12 @@ NeuralNetworkElement::NeuralNetworkElement()
 
 NeuralNetworkElement::NeuralNetworkElement(const NeuralNetworkElement &other) 
 	: Properties(other), mStartIteration(other.mStartIteration), 
-	  mRequiredIterations(other.mRequiredIterations), mCopyPtr(0)
+	  mRequiredIterations(other.mRequiredIterations), mStateSlotNames(other.mStateSlotNames),
+	  mStateValues(other.mStateValues), mStateValueSet(other.mStateValueSet), 
+	  mStoringStateSlots(false), mCopyPtr(0)
 {
 	updateIterationProperty();
+	rebuildTagBits();
 	addPropertyChangedListener(this);
 }
 
@@ -103,6 +110,7 @@ int NeuralNetworkElement::getRequiredIterations() const {
 
 void NeuralNetworkElement::setRequiredIterations(int iterations) {
 	mRequiredIterations = Math::max(1, iterations);
+	mIterationRevision.ref();
 	updateIterationProperty();
 }
 
@@ -116,8 +124,28 @@ int NeuralNetworkElement::getStartIteration() const {
 // 	updateIterationProperty();
 // }
 
+
+/**
+ * Returns a counter that is incremented whenever the start iteration or the number
+ * of required iterations of any element changes. This is used by the NeuralNetworks
+ * to detect outdated execution schedules.
+ */
+int NeuralNetworkElement::getIterationRevision() {
+	return mIterationRevision;
+}
+
+
 void NeuralNetworkElement::propertyChanged(Properties *owner, const QString &property) {
 	if(owner == this) {
+		updateTagBit(property);
+
+		if(!mStoringStateSlots && !mStateSlotNames.empty()) {
+			//external changes of a mirrored property are taken over by the state slot.
+			int slot = mStateSlotNames.indexOf(property);
+			if(slot >= 0) {
+				loadStateValueFromProperty(slot);
+			}
+		}
 		if(property == NeuralNetworkConstants::TAG_FAST_ITERATIONS 
 			|| property == QString("+").append(NeuralNetworkConstants::TAG_FAST_ITERATIONS)
 			|| property == NeuralNetworkConstants::TAG_NEURON_ORDER_DEPENDENT
@@ -156,10 +184,169 @@ void NeuralNetworkElement::propertyChanged(Properties *owner, const QString &pro
 					mRequiredIterations = iterations;
 				}
 			}
+			mIterationRevision.ref();
 		}
 	}
 }
 
+/**
+ * Returns true if the element has a property with the given name (ignoring hidden prefixes).
+ * Uses the tag bitset instead of the (locked) property table.
+ */
+bool NeuralNetworkElement::hasProperty(const QString &name) const {
+	int atom = NeuroTagManager::findTagAtom(stripHiddenPrefix(name));
+	if(atom < 0) {
+		if(NeuroTagManager::isTagAtomTableFull()) {
+			//the name may be used at elements without getting an atom.
+			return Properties::hasProperty(name);
+		}
+		//this name was never used as a property of any element.
+		return false;
+	}
+	return (mTagBits[atom / 32] & (1u << (atom % 32))) != 0;
+}
+
+
+/**
+ * Returns true if the element has the tag with the given atom (see NeuroTagManager::getTagAtom()).
+ * Hidden prefixes are ignored, as in hasProperty(). Names without an atom 
+ * have to be queried with hasProperty().
+ */
+bool NeuralNetworkElement::hasTag(int atom) const {
+	if(atom < 0 || atom >= NUMBER_OF_TAG_BITS) {
+		return false;
+	}
+	return (mTagBits[atom / 32] & (1u << (atom % 32))) != 0;
+}
+
+
+/**
+ * Adds a numeric state slot with the given name. If the slot already exists, 
+ * then the existing slot is returned. A new slot is initialized with the 
+ * value of the property with the same name (if available).
+ *
+ * @param name the name of the slot (and of the mirroring property).
+ * @return the index of the slot.
+ */
+int NeuralNetworkElement::addStateSlot(const QString &name) {
+	int slot = mStateSlotNames.indexOf(name);
+	if(slot >= 0) {
+		return slot;
+	}
+	mStateSlotNames.append(name);
+	mStateValues.append(0.0);
+	mStateValueSet.append(false);
+
+	slot = mStateSlotNames.size() - 1;
+	loadStateValueFromProperty(slot);
+	return slot;
+}
+
+
+/**
+ * Returns the index of the state slot with the given name, or -1 if there is no such slot.
+ */
+int NeuralNetworkElement::getStateSlot(const QString &name) const {
+	return mStateSlotNames.indexOf(name);
+}
+
+
+/**
+ * Returns true if the slot currently holds a value.
+ */
+bool NeuralNetworkElement::hasStateValue(int slot) const {
+	if(slot < 0 || slot >= mStateValueSet.size()) {
+		return false;
+	}
+	return mStateValueSet.at(slot);
+}
+
+
+/**
+ * Returns the value of the slot, or 0.0 if the slot does not hold a value.
+ */
+double NeuralNetworkElement::getStateValue(int slot) const {
+	if(!hasStateValue(slot)) {
+		return 0.0;
+	}
+	return mStateValues.at(slot);
+}
+
+
+void NeuralNetworkElement::setStateValue(int slot, double value) {
+	if(slot < 0 || slot >= mStateValues.size()) {
+		return;
+	}
+	mStateValues[slot] = value;
+	mStateValueSet[slot] = true;
+}
+
+
+void NeuralNetworkElement::clearStateValue(int slot) {
+	if(slot < 0 || slot >= mStateValues.size()) {
+		return;
+	}
+	mStateValues[slot] = 0.0;
+	mStateValueSet[slot] = false;
+}
+
+
+/**
+ * Writes the values of all state slots to the properties with the same names.
+ * Properties of slots without a value are removed.
+ */
+void NeuralNetworkElement::storeStateSlotsInProperties() {
+	mStoringStateSlots = true;
+	for(int i = 0; i < mStateSlotNames.size(); ++i) {
+		const QString &name = mStateSlotNames.at(i);
+		if(mStateValueSet.at(i)) {
+			setProperty(name, QString::number(mStateValues.at(i), 'g', 16));
+		}
+		else if(hasProperty(name)) {
+			removeProperty(name);
+		}
+	}
+	mStoringStateSlots = false;
+}
+
+
+void NeuralNetworkElement::updateTagBit(const QString &property) {
+	QString tagName = stripHiddenPrefix(property);
+	int atom = NeuroTagManager::getTagAtom(tagName);
+	if(atom < 0) {
+		return;
+	}
+	if(Properties::hasProperty(tagName)) {
+		mTagBits[atom / 32] |= (1u << (atom % 32));
+	}
+	else {
+		mTagBits[atom / 32] &= ~(1u << (atom % 32));
+	}
+}
+
+
+void NeuralNetworkElement::rebuildTagBits() {
+	for(int i = 0; i < NUMBER_OF_TAG_BITS / 32; ++i) {
+		mTagBits[i] = 0;
+	}
+	QList<QString> names = getPropertyNames();
+	for(QListIterator<QString> i(names); i.hasNext();) {
+		updateTagBit(i.next());
+	}
+}
+
+
+void NeuralNetworkElement::loadStateValueFromProperty(int slot) {
+	bool ok = false;
+	double value = 0.0;
+	if(hasProperty(mStateSlotNames.at(slot))) {
+		value = getProperty(mStateSlotNames.at(slot)).toDouble(&ok);
+	}
+	mStateValues[slot] = ok ? value : 0.0;
+	mStateValueSet[slot] = ok;
+}
+
+
 void NeuralNetworkElement::updateIterationProperty() {
 
 	if(mRequiredIterations <= 1) {
@@ -49,11 +49,27 @@
 #include <QtGlobal>
 #include "Core/Properties.h"
 #include "Core/PropertyChangedListener.h"
+#include <QStringList>
+#include <QVector>
+#include <QAtomicInt>
+#include "Network/NeuroTagManager.h"
 
 namespace nerd {
 	
 	/**
 	 * NeuralNetworkElement.
+	 *
+	 * Besides the (string) properties, an element provides numeric state slots.
+	 * These can be used by functions (e.g. learning synapse functions) to keep
+	 * runtime state at the element without converting strings in each step. 
+	 * A slot is added once with addStateSlot() and is afterwards accessed by its index. 
+	 * Each slot is mirrored by a property of the same name: the property initializes 
+	 * the slot and is only updated by storeStateSlotsInProperties(), which is called
+	 * by NeuralNetworkIO::prepareNetworkForWriting() before a network is saved.
+	 *
+	 * Tag queries (hasProperty()) are answered with a bitset indexed by the tag atoms 
+	 * of the NeuroTagManager. The bitset is kept up to date in propertyChanged(),
+	 * so subclasses overwriting propertyChanged() have to call this implementation first.
 	 */
 	class NeuralNetworkElement : public Properties, public virtual PropertyChangedListener {
 		public: 
@@ -74,14 +90,43 @@ namespace nerd {
 // 			virtual void setStartIteration(int startIteration);
 
 			virtual void propertyChanged(Properties *owner, const QString &property);
+			virtual bool hasProperty(const QString &name) const;
+			bool hasTag(int atom) const;
+
+			int addStateSlot(const QString &name);
+			int getStateSlot(const QString &name) const;
+			bool hasStateValue(int slot) const;
+			double getStateValue(int slot) const;
+			void setStateValue(int slot, double value);
+			void clearStateValue(int slot);
+			void storeStateSlotsInProperties();
+
+			static int getIterationRevision();
 
 		protected:
 			void updateIterationProperty();
 
+		private:
+			void loadStateValueFromProperty(int slot);
+			void updateTagBit(const QString &property);
+			void rebuildTagBits();
+
 		protected:
 			int mStartIteration;
 			int mRequiredIterations;
 
+		private:
+			QStringList mStateSlotNames;
+			QVector<double> mStateValues;
+			QVector<bool> mStateValueSet;
+			bool mStoringStateSlots;
+
+			//names without a tag atom fall back to the string based lookup.
+			static const int NUMBER_OF_TAG_BITS = NeuroTagManager::MAXIMUM_NUMBER_OF_TAG_ATOMS;
+			quint32 mTagBits[NUMBER_OF_TAG_BITS / 32];
+
+			static QAtomicInt mIterationRevision;
+
 		public:
 			NeuralNetworkElement *mCopyPtr;
 	};
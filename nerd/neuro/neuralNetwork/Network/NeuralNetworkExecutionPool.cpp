@@ -0,0 +1,258 @@
+/***************************************************************************
+ *   NERD - Neurodynamics and Evolutionary Robotics Development Toolkit    *
+ *                                                                         *
+ *   University of Osnabrueck, Germany                                     *
+ *   Institute of Cognitive Science                                        *
+ *   Neurocybernetics Group                                                *
+ *   http://www.ikw.uni-osnabrueck.de/~neurokybernetik/                    *
+ *                                                                         *
+ *   Project homepage: nerd.x-bot.org                                      *
+ *                                                                         *
+ *   Copyright (C) 2008 - 2013 by the Neurocybernetics Group Osnabrück     *
+ *   Contact: Christian Rempis                                             *
+ *   christian.rempis@uni-osnabrueck.de                                    *
+ *   Contributors: see contributors.txt in the nerd main directory.        *
+ *                                                                         *
+ *                                                                         *
+ *   Acknowledgments:                                                      *
+ *   The NERD Toolkit is part of the EU project ALEAR                      *
+ *   (Artificial Language Evolution on Autonomous Robots) www.ALEAR.eu     *
+ *   This work was funded (2008 - 2011) by EU-Project Number ICT 214856    *
+ *                                                                         *
+ *                                                                         *
+ *   License Agreement:                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ *                                                                         *
+ *   Publications based on work using the NERD kit have to state this      *
+ *   clearly by citing the NERD homepage and the NERD overview paper.      *  
+ ***************************************************************************/
+
+
+#include "NeuralNetworkExecutionPool.h"
+#include "Network/NeuralNetwork.h"
+#include "Core/Core.h"
+#include <QMutexLocker>
+#include <QListIterator>
+#include <iostream>
+
+using namespace std;
+
+namespace nerd {
+
+
+/**
+ * Creates a worker that waits for the first step after the given job generation.
+ */
+NeuralNetworkExecutionWorker::NeuralNetworkExecutionWorker(NeuralNetworkExecutionPool *pool, 
+														   int generation)
+	: QThread(0), mPool(pool), mGeneration(generation)
+{
+	Core::getInstance()->registerThread(this);
+}
+
+NeuralNetworkExecutionWorker::~NeuralNetworkExecutionWorker() {
+	Core::getInstance()->deregisterThread(this);
+}
+
+void NeuralNetworkExecutionWorker::run() {
+	int generation = mGeneration;
+	while(mPool->waitForJob(generation)) {
+		mPool->processJob();
+		mPool->jobCompleted();
+	}
+}
+
+
+
+/**
+ * Constructs a new NeuralNetworkExecutionPool. The worker threads are started 
+ * with the first call of executeNetworks().
+ *
+ * @param numberOfThreads the number of worker threads.
+ */
+NeuralNetworkExecutionPool::NeuralNetworkExecutionPool(int numberOfThreads)
+	: mNumberOfThreads(1), mJobGeneration(0), mNumberOfPendingWorkers(0), 
+	  mShutdown(false), mJobSteps(1), mNextNetwork(0)
+{
+	setNumberOfThreads(numberOfThreads);
+}
+
+
+/**
+ * Destructor. Stops all worker threads.
+ */
+NeuralNetworkExecutionPool::~NeuralNetworkExecutionPool() {
+	stopWorkers();
+}
+
+
+/**
+ * Sets the number of worker threads. Running workers are stopped and 
+ * restarted with the next call of executeNetworks().
+ */
+void NeuralNetworkExecutionPool::setNumberOfThreads(int numberOfThreads) {
+	if(numberOfThreads < 1) {
+		numberOfThreads = 1;
+	}
+	if(numberOfThreads == mNumberOfThreads) {
+		return;
+	}
+	stopWorkers();
+	mNumberOfThreads = numberOfThreads;
+}
+
+
+int NeuralNetworkExecutionPool::getNumberOfThreads() const {
+	return mNumberOfThreads;
+}
+
+
+/**
+ * Executes one step of all networks (see NeuralNetwork::executeStep()).
+ * Blocks until all networks have been executed.
+ *
+ * @param networks the networks to execute.
+ * @param numberOfSteps the number of network updates per step.
+ */
+void NeuralNetworkExecutionPool::executeNetworks(const QList<NeuralNetwork*> &networks, 
+												 int numberOfSteps)
+{
+	if(networks.empty()) {
+		return;
+	}
+	QList<NeuralNetwork*> parallelNetworks;
+	QList<NeuralNetwork*> sequentialNetworks;
+	for(QListIterator<NeuralNetwork*> i(networks); i.hasNext();) {
+		NeuralNetwork *net = i.next();
+		net->readInputs();
+		if(net->isThreadSafe() && !net->hasObservedStateValues()) {
+			parallelNetworks.append(net);
+		}
+		else {
+			sequentialNetworks.append(net);
+		}
+	}
+
+	if(!parallelNetworks.empty() && mWorkers.empty()) {
+		startWorkers();
+	}
+
+	if(!parallelNetworks.empty()) {
+		QMutexLocker locker(&mJobMutex);
+		mJobNetworks.resize(parallelNetworks.size());
+		for(int i = 0; i < parallelNetworks.size(); ++i) {
+			mJobNetworks[i] = parallelNetworks.at(i);
+		}
+		mJobSteps = numberOfSteps;
+		mNextNetwork = 0;
+		mNumberOfPendingWorkers = mWorkers.size();
+		mJobGeneration++;
+		mJobAvailable.wakeAll();
+	}
+
+	//networks using global state are updated in the calling thread meanwhile.
+	for(QListIterator<NeuralNetwork*> i(sequentialNetworks); i.hasNext();) {
+		i.next()->executeIterations(numberOfSteps);
+	}
+
+	{
+		QMutexLocker locker(&mJobMutex);
+		while(mNumberOfPendingWorkers > 0) {
+			mJobCompleted.wait(&mJobMutex);
+		}
+	}
+
+	for(QListIterator<NeuralNetwork*> i(networks); i.hasNext();) {
+		i.next()->writeOutputs();
+	}
+}
+
+
+/**
+ * Called by the workers to wait for the next step.
+ *
+ * @return false if the worker should terminate.
+ */
+bool NeuralNetworkExecutionPool::waitForJob(int &generation) {
+	QMutexLocker locker(&mJobMutex);
+	while(!mShutdown && generation == mJobGeneration) {
+		mJobAvailable.wait(&mJobMutex);
+	}
+	generation = mJobGeneration;
+	return !mShutdown;
+}
+
+
+/**
+ * Called by the workers to update networks until no network of the current step is left.
+ */
+void NeuralNetworkExecutionPool::processJob() {
+	int numberOfNetworks = mJobNetworks.size();
+	while(true) {
+		int index = mNextNetwork.fetchAndAddOrdered(1);
+		if(index >= numberOfNetworks) {
+			break;
+		}
+		mJobNetworks.at(index)->executeIterations(mJobSteps);
+	}
+}
+
+
+void NeuralNetworkExecutionPool::jobCompleted() {
+	QMutexLocker locker(&mJobMutex);
+	mNumberOfPendingWorkers--;
+	if(mNumberOfPendingWorkers <= 0) {
+		mJobCompleted.wakeAll();
+	}
+}
+
+
+void NeuralNetworkExecutionPool::startWorkers() {
+	int generation = 0;
+	{
+		QMutexLocker locker(&mJobMutex);
+		mShutdown = false;
+		generation = mJobGeneration;
+	}
+	for(int i = 0; i < mNumberOfThreads; ++i) {
+		NeuralNetworkExecutionWorker *worker = new NeuralNetworkExecutionWorker(this, generation);
+		mWorkers.append(worker);
+		worker->start();
+	}
+}
+
+
+void NeuralNetworkExecutionPool::stopWorkers() {
+	if(mWorkers.empty()) {
+		return;
+	}
+	{
+		QMutexLocker locker(&mJobMutex);
+		mShutdown = true;
+		mJobAvailable.wakeAll();
+	}
+	for(QListIterator<NeuralNetworkExecutionWorker*> i(mWorkers); i.hasNext();) {
+		NeuralNetworkExecutionWorker *worker = i.next();
+		worker->wait();
+		delete worker;
+	}
+	mWorkers.clear();
+	mJobNetworks.clear();
+}
+
+}
+
@@ -0,0 +1,134 @@
+/***************************************************************************
+ *   NERD - Neurodynamics and Evolutionary Robotics Development Toolkit    *
+ *                                                                         *
+ *   University of Osnabrueck, Germany                                     *
+ *   Institute of Cognitive Science                                        *
+ *   Neurocybernetics Group                                                *
+ *   http://www.ikw.uni-osnabrueck.de/~neurokybernetik/                    *
+ *                                                                         *
+ *   Project homepage: nerd.x-bot.org                                      *
+ *                                                                         *
+ *   Copyright (C) 2008 - 2013 by the Neurocybernetics Group Osnabrück     *
+ *   Contact: Christian Rempis                                             *
+ *   christian.rempis@uni-osnabrueck.de                                    *
+ *   Contributors: see contributors.txt in the nerd main directory.        *
+ *                                                                         *
+ *                                                                         *
+ *   Acknowledgments:                                                      *
+ *   The NERD Toolkit is part of the EU project ALEAR                      *
+ *   (Artificial Language Evolution on Autonomous Robots) www.ALEAR.eu     *
+ *   This work was funded (2008 - 2011) by EU-Project Number ICT 214856    *
+ *                                                                         *
+ *                                                                         *
+ *   License Agreement:                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ *                                                                         *
+ *   Publications based on work using the NERD kit have to state this      *
+ *   clearly by citing the NERD homepage and the NERD overview paper.      *  
+ ***************************************************************************/
+
+
+#ifndef NERDNeuralNetworkExecutionPool_H
+#define NERDNeuralNetworkExecutionPool_H
+
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QAtomicInt>
+#include <QList>
+#include <QVector>
+
+namespace nerd {
+
+	class NeuralNetwork;
+	class NeuralNetworkExecutionPool;
+
+	/**
+	 * NeuralNetworkExecutionWorker.
+	 * Worker thread of a NeuralNetworkExecutionPool. Lives as long as the pool
+	 * and executes networks whenever the pool starts a new step.
+	 */
+	class NeuralNetworkExecutionWorker : public QThread {
+	public:
+		NeuralNetworkExecutionWorker(NeuralNetworkExecutionPool *pool, int generation);
+		virtual ~NeuralNetworkExecutionWorker();
+
+	protected:
+		virtual void run();
+
+	private:
+		NeuralNetworkExecutionPool *mPool;
+		int mGeneration;
+	};
+
+
+	/**
+	 * NeuralNetworkExecutionPool.
+	 *
+	 * Executes a list of independent NeuralNetworks in parallel on a set of persistent
+	 * worker threads. For each step, the inputs of all networks are read and the outputs
+	 * are written sequentially in the calling thread (in the order of the list), so that
+	 * all interface values are accessed in the same order as with a sequential execution. 
+	 * Only the network updates (NeuralNetwork::executeIterations()) run in the workers. 
+	 * The workers take the next pending network from a shared counter, and the calling 
+	 * thread waits until all networks have been updated (barrier).
+	 *
+	 * The networks must not share any elements. Networks with functions using global state 
+	 * (such as scripted functions or noise from the global random generator, see 
+	 * NeuralNetwork::isThreadSafe()) are updated in the calling thread in the order of 
+	 * the list, while the workers update the other networks. So the random numbers are 
+	 * consumed in the same order as with a sequential execution.
+	 * Networks whose neuron or synapse Values are observed by ValueChangedListeners
+	 * (see NeuralNetwork::hasObservedStateValues()) are also updated in the calling thread,
+	 * so listeners are never notified in a worker thread.
+	 */
+	class NeuralNetworkExecutionPool {
+	public:
+		NeuralNetworkExecutionPool(int numberOfThreads = 2);
+		virtual ~NeuralNetworkExecutionPool();
+
+		void setNumberOfThreads(int numberOfThreads);
+		int getNumberOfThreads() const;
+
+		void executeNetworks(const QList<NeuralNetwork*> &networks, int numberOfSteps);
+
+		bool waitForJob(int &generation);
+		void processJob();
+		void jobCompleted();
+
+	private:
+		void startWorkers();
+		void stopWorkers();
+
+	private:
+		int mNumberOfThreads;
+		QList<NeuralNetworkExecutionWorker*> mWorkers;
+		QMutex mJobMutex;
+		QWaitCondition mJobAvailable;
+		QWaitCondition mJobCompleted;
+		int mJobGeneration;
+		int mNumberOfPendingWorkers;
+		bool mShutdown;
+		QVector<NeuralNetwork*> mJobNetworks;
+		int mJobSteps;
+		QAtomicInt mNextNetwork;
+	};
+
+}
+
+#endif
+
@@ -49,6 +49,7 @@
 #include "NerdConstants.h"
 #include <iostream>
 #include "Util/Tracer.h"
+#include "Util/Profiler.h"
 #include <QMutexLocker>
 #include <QThread>
 #include <QCoreApplication>
@@ -56,6 +57,7 @@
 #include "Network/NeuroTagManager.h"
 #include "NeuralNetworkConstants.h"
 #include "Network/Neuro.h"
+#include "Network/NeuralNetworkExecutionPool.h"
 
 
 #define TRACE(message)
@@ -70,7 +72,8 @@ NeuralNetworkManager::NeuralNetworkManager()
  	  mCurrentNetworksReplacedEvent(0), mNetworkEvaluationStarted(0), 
 	  mNetworkEvaluationCompleted(0), mNetworkStructuresChanged(0), 
 	  mNetworkIterationCompleted(0),
-	  mNetworkExecutionMutex(QMutex::Recursive), mBypassNetworkValue(0)
+	  mNetworkExecutionMutex(QMutex::Recursive), mBypassNetworkValue(0),
+	  mNumberOfExecutionThreads(0), mExecutionPool(0)
 {
 	EventManager *em = Core::getInstance()->getEventManager();
 	
@@ -124,6 +127,13 @@ NeuralNetworkManager::NeuralNetworkManager()
 												   "This allows networks running faster than the physical simulation.");
 	Core::getInstance()->getValueManager()->addValue(
 				NeuralNetworkConstants::VALUE_NNM_NUMBER_OF_ITERATIONS_PER_STEP, mNumberOfNetworkUpdatesPerStep);
+
+	mNumberOfExecutionThreads = new IntValue(0);
+	mNumberOfExecutionThreads->setDescription("Number of threads used to update the networks in parallel "
+										"(e.g. one network per agent in swarm experiments). With 0 or 1 "
+										"the networks are updated sequentially in the main thread.");
+	Core::getInstance()->getValueManager()->addValue(
+				NeuralNetworkConstants::VALUE_NNM_NUMBER_OF_EXECUTION_THREADS, mNumberOfExecutionThreads);
 	
 	mDisablePlasticity = new BoolValue(false);
 	mDisablePlasticity->setDescription("Gives a hint to all plastic synapse and activation functions to stop plasticity.\n"
@@ -182,6 +192,16 @@ NeuralNetworkManager::NeuralNetworkManager()
 						NeuralNetworkConstants::TAG_TYPE_NEURON,
 						"If set, then the neuron provides this activation during the initial simulation step\n"
 						"after a reset. This means, that lastActivation is set to this initial value after a reset."));
+	
+	ntm->addTag(NeuroTag(NeuralNetworkConstants::TAG_NETWORK_EVENT_DRIVEN_SPIKING,
+						NeuralNetworkConstants::TAG_TYPE_NETWORK,
+						"Executes a network of Izhikevitch2003 neurons with the event-driven SpikingEventEngine.\n"
+						"Synaptic input is only propagated when the output of a neuron changes."));
+	
+	ntm->addTag(NeuroTag(NeuralNetworkConstants::TAG_SYNAPSE_DELAY,
+						NeuralNetworkConstants::TAG_TYPE_SYNAPSE,
+						"Additional transmission delay (in network steps) of the synapse.\n"
+						"Used by DelayLine neurons and in networks with the EventDrivenSpiking tag."));
 }
 
 /**
@@ -193,6 +213,7 @@ NeuralNetworkManager::~NeuralNetworkManager() {
 
 	//do not destroy mBypassNetworkValue (is destroyed by ValueManager.
 	
+	delete mExecutionPool;
 	destroyNeuralNetworks();
 	while(!mTransferFunctionPrototypes.empty()) {
 		TransferFunction *tf = mTransferFunctionPrototypes.at(0);
@@ -319,6 +340,11 @@ bool NeuralNetworkManager::bind() {
 
 
 bool NeuralNetworkManager::cleanUp() {
+	QMutexLocker locker(&mNetworkExecutionMutex);
+
+	//stop the worker threads before the Core is destroyed.
+	delete mExecutionPool;
+	mExecutionPool = 0;
 	return true;
 }
 
@@ -521,6 +547,16 @@ BoolValue* NeuralNetworkManager::getDisableNetworkUpdateValue() const {
 	return mDisableNetworkUpdate;
 }
 
+
+IntValue* NeuralNetworkManager::getNumberOfUpdatesPerStepValue() const {
+	return mNumberOfNetworkUpdatesPerStep;
+}
+
+
+IntValue* NeuralNetworkManager::getNumberOfExecutionThreadsValue() const {
+	return mNumberOfExecutionThreads;
+}
+
 QMutex* NeuralNetworkManager::getNetworkExecutionMutex() {
 	return &mNetworkExecutionMutex;
 }
@@ -542,13 +578,29 @@ Event* NeuralNetworkManager::getIterationCompletedEvent() const {
 
 void NeuralNetworkManager::executeNeuralNetworks() {
 	TRACE("NeuralNetworkManager::executeNeuralNetworks");
+	PROFILE_SCOPE("NeuralNetworkManager::executeNeuralNetworks");
 
 	if(!mDisableNetworkUpdate->get()) {
 		//mNetworkEvaluationStarted is triggered as upstream event of NextStep.
 		QMutexLocker locker(&mNetworkExecutionMutex);
-		for(QListIterator<NeuralNetwork*> i(mNeuralNetworks); i.hasNext();) {
-			NeuralNetwork *net = i.next();
-			net->executeStep(mNumberOfNetworkUpdatesPerStep->get());
+
+		//networks are only updated in parallel if no one observes the single iterations, 
+		//because the iteration events can only be triggered in the main thread.
+		int numberOfThreads = mNumberOfExecutionThreads->get();
+		if(numberOfThreads > 1 && mNeuralNetworks.size() > 1
+			&& mNetworkIterationCompleted->getEventListeners().empty()) 
+		{
+			if(mExecutionPool == 0) {
+				mExecutionPool = new NeuralNetworkExecutionPool(numberOfThreads);
+			}
+			mExecutionPool->setNumberOfThreads(numberOfThreads);
+			mExecutionPool->executeNetworks(mNeuralNetworks, mNumberOfNetworkUpdatesPerStep->get());
+		}
+		else {
+			for(QListIterator<NeuralNetwork*> i(mNeuralNetworks); i.hasNext();) {
+				NeuralNetwork *net = i.next();
+				net->executeStep(mNumberOfNetworkUpdatesPerStep->get());
+			}
 		}
 	}
 	//trigger evaluation competed even if the update was not triggered
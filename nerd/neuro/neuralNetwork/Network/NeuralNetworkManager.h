@@ -57,6 +57,8 @@
 
 namespace nerd {
 
+	class NeuralNetworkExecutionPool;
+
 	/**
 	 * NeuralNetworkManager.
 	 */
@@ -98,6 +100,8 @@ namespace nerd {
 		BoolValue* getBypassNetworksValue() const;
 		BoolValue* getDisablePlasticityValue() const;
 		BoolValue* getDisableNetworkUpdateValue() const;
+		IntValue* getNumberOfUpdatesPerStepValue() const;
+		IntValue* getNumberOfExecutionThreadsValue() const;
 
 		QMutex* getNetworkExecutionMutex();
 		
@@ -131,6 +135,8 @@ namespace nerd {
 		QMutex mNetworkExecutionMutex;
 		BoolValue *mBypassNetworkValue;
 		IntValue *mNumberOfNetworkUpdatesPerStep;
+		IntValue *mNumberOfExecutionThreads;
+		NeuralNetworkExecutionPool *mExecutionPool;
 		BoolValue *mDisablePlasticity;
 		BoolValue *mDisableNetworkUpdate;
 		BoolValue *mDisableMainReset;
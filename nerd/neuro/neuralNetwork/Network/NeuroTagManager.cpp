@@ -54,6 +54,12 @@ using namespace std;
 namespace nerd {
 
 
+QHash<QString, int> NeuroTagManager::mTagAtoms;
+QStringList NeuroTagManager::mTagAtomNames;
+QReadWriteLock NeuroTagManager::mTagAtomLock;
+bool NeuroTagManager::mTagAtomTableFull = false;
+
+
 NeuroTag::NeuroTag(const QString &name, const QString &type, const QString &description) 
 	: mTagName(name), mType(type), mDescription(description)
 {
@@ -127,6 +133,9 @@ bool NeuroTagManager::addTag(NeuroTag tag) {
 	if(tag.mTagName.trimmed() == "" || tag.mType.trimmed() == "") {
 		return false;
 	}
+	//registered tags may also use the reserved atoms.
+	internTagName(tag.mTagName, MAXIMUM_NUMBER_OF_TAG_ATOMS);
+
 	for(QList<NeuroTag>::iterator i = mNeuroTags.begin(); i != mNeuroTags.end(); ++i) {
 		if(i->mType == tag.mType) {
 			mNeuroTags.insert(i, tag);
@@ -154,6 +163,84 @@ QList<NeuroTag> NeuroTagManager::getTags() const {
 }
 
 
+/**
+ * Returns the atom of the given tag name. If the name was not interned yet,
+ * then a new atom is created. 
+ *
+ * @return the atom or -1 if there is no free atom left for unregistered names.
+ */
+int NeuroTagManager::getTagAtom(const QString &tagName) {
+	return internTagName(tagName, MAXIMUM_NUMBER_OF_TAG_ATOMS - RESERVED_TAG_ATOMS);
+}
+
+
+/**
+ * Returns the atom of the given name or -1 if the name was never interned.
+ * As long as isTagAtomTableFull() is false, all property names of network elements 
+ * are interned, so that -1 also means that no element carries this tag.
+ */
+int NeuroTagManager::findTagAtom(const QString &tagName) {
+	QReadLocker locker(&mTagAtomLock);
+	return mTagAtoms.value(tagName, -1);
+}
+
+
+QString NeuroTagManager::getTagNameOfAtom(int atom) {
+	QReadLocker locker(&mTagAtomLock);
+	if(atom < 0 || atom >= mTagAtomNames.size()) {
+		return "";
+	}
+	return mTagAtomNames.at(atom);
+}
+
+
+/**
+ * Returns true if a name was rejected because the atom table was full.
+ * In this case names without an atom have to be looked up by string.
+ */
+bool NeuroTagManager::isTagAtomTableFull() {
+	QReadLocker locker(&mTagAtomLock);
+	return mTagAtomTableFull;
+}
+
+
+/**
+ * Removes all atoms and clears the full flag. Elements keep the atoms of their 
+ * tags, so this may only be called while no NeuralNetworkElement exists 
+ * (e.g. between tests). Tags registered afterwards with addTag() get new atoms.
+ */
+void NeuroTagManager::resetTagAtoms() {
+	QWriteLocker locker(&mTagAtomLock);
+	mTagAtoms.clear();
+	mTagAtomNames.clear();
+	mTagAtomTableFull = false;
+}
+
+
+int NeuroTagManager::internTagName(const QString &tagName, int maximumNumberOfAtoms) {
+	{
+		QReadLocker locker(&mTagAtomLock);
+		QHash<QString, int>::const_iterator i = mTagAtoms.find(tagName);
+		if(i != mTagAtoms.end()) {
+			return i.value();
+		}
+	}
+	QWriteLocker locker(&mTagAtomLock);
+	QHash<QString, int>::const_iterator i = mTagAtoms.find(tagName);
+	if(i != mTagAtoms.end()) {
+		return i.value();
+	}
+	int atom = mTagAtomNames.size();
+	if(atom >= maximumNumberOfAtoms) {
+		mTagAtomTableFull = true;
+		return -1;
+	}
+	mTagAtomNames.append(tagName);
+	mTagAtoms.insert(tagName, atom);
+	return atom;
+}
+
+
 
 }
 
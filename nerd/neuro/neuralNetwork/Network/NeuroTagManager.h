@@ -48,6 +48,8 @@
 
 #include <QString>
 #include <QHash>
+#include <QStringList>
+#include <QReadWriteLock>
 #include "Core/SystemObject.h"
 
 namespace nerd {
@@ -62,8 +64,21 @@ namespace nerd {
 	/**
 	 * NeuroTagManager.
 	 *
+	 * Besides the list of documented tags, the NeuroTagManager interns the tag names
+	 * used at network elements into small integer atoms. Elements use these atoms
+	 * to answer tag queries with a bit test instead of string comparisons.
+	 * Atoms are global, never released and can be used from any thread.
+	 *
+	 * The atom table is bounded by MAXIMUM_NUMBER_OF_TAG_ATOMS, so that arbitrary 
+	 * property names can not grow it without limit. The last RESERVED_TAG_ATOMS 
+	 * atoms are only given to tags registered with addTag(). Names without an atom 
+	 * are looked up by string at the elements.
 	 */
 	class NeuroTagManager : public virtual SystemObject {
+	public:
+		static const int MAXIMUM_NUMBER_OF_TAG_ATOMS = 256;
+		static const int RESERVED_TAG_ATOMS = 64;
+
 	public:
 		NeuroTagManager();
 		virtual ~NeuroTagManager();
@@ -81,9 +96,22 @@ namespace nerd {
 		bool hasTag(NeuroTag tag) const;
 		QList<NeuroTag> getTags() const;
 		
+		static int getTagAtom(const QString &tagName);
+		static int findTagAtom(const QString &tagName);
+		static QString getTagNameOfAtom(int atom);
+		static bool isTagAtomTableFull();
+		static void resetTagAtoms();
+
+	private:
+		static int internTagName(const QString &tagName, int maximumNumberOfAtoms);
 
 	private:
 		QList<NeuroTag> mNeuroTags;
+
+		static QHash<QString, int> mTagAtoms;
+		static QStringList mTagAtomNames;
+		static QReadWriteLock mTagAtomLock;
+		static bool mTagAtomTableFull;
 	};
 
 }
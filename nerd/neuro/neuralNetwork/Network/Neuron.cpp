@@ -61,7 +61,7 @@ const QString Neuron::NEURON_TYPE_OUTPUT = "TYPE_OUTPUT";
 Neuron::Neuron(const QString &name, const TransferFunction &tf, const ActivationFunction &af, qulonglong id)
 	: mId(id), mNameValue(name), mTransferFunction(0), mActivationFunction(0),
 	  mLastActivation(0.0), mLastOutputActivation(0.0), mActivationCalculated(false),
-	  mFlipActivation(false), mOwnerNetwork(0)
+	  mFlipActivation(false), mOwnerNetwork(0), mSynapseRevision(0)
 {
 	if(id == 0) {
 		mId = NeuralNetwork::generateNextId();
@@ -77,7 +77,7 @@ Neuron::Neuron(const Neuron &other)
 	  mTransferFunction(0), mActivationFunction(0),
 	  mLastActivation(other.mLastActivation), mLastOutputActivation(0.0), 
 	  mActivationCalculated(false), mFlipActivation(other.mFlipActivation),
-	  mOwnerNetwork(0)
+	  mOwnerNetwork(0), mSynapseRevision(0)
 {
 	mId = other.mId;
 	if(other.mTransferFunction != 0) {
@@ -172,7 +172,7 @@ void Neuron::reset() {
 void Neuron::updateActivation() {
 	if(mTransferFunction == 0 || mActivationFunction == 0) {
 		Core::log(QString("Neuron::updateActivation [").append(mNameValue.get())
-			.append("] : TransferFunction or ActivationFunction missing [SKIPPING]."));
+			.append("] : TransferFunction or ActivationFunction missing [SKIPPING]."), Core::LOG_WARNING);
 		return;
 	}
 	if(!mActivationCalculated) {
@@ -268,6 +268,9 @@ void Neuron::setActivationFunction(const ActivationFunction &af) {
 		delete mActivationFunction;
 	}
 	mActivationFunction = af.createCopy();
+	if(mOwnerNetwork != 0) {
+		mOwnerNetwork->invalidateNeuroModulatorField();
+	}
 }
 
 /**
@@ -279,6 +282,9 @@ void Neuron::setActivationFunction(ActivationFunction *af) {
 		return;
 	}
 	mActivationFunction = af;
+	if(mOwnerNetwork != 0) {
+		mOwnerNetwork->invalidateNeuroModulatorField();
+	}
 }
 
 
@@ -298,6 +304,7 @@ bool Neuron::addSynapse(Synapse *synapse) {
 	}
 	synapse->setTarget(this);
 	mIncommingSynapses.append(synapse);
+	synapsesChanged();
 	return true;
 }
 
@@ -310,6 +317,7 @@ bool Neuron::removeSynapse(Synapse *synapse) {
 	if(synapse->getTarget() == this) {
 		synapse->setTarget(0);
 	}
+	synapsesChanged();
 	return true;
 }
 
@@ -319,6 +327,29 @@ QList<Synapse*> Neuron::getSynapses() const {
 }
 
 
+/**
+ * Returns a counter that is incremented whenever an incoming synapse is added,
+ * removed or changes its delay. Functions that cache the incoming synapses can use 
+ * it to detect changes.
+ */
+int Neuron::getSynapseRevision() const {
+	return mSynapseRevision;
+}
+
+
+/**
+ * Increments the synapse revision and invalidates the execution schedule of the
+ * owner network. Called when the set of incoming synapses or one of their
+ * cached properties (such as the synapse delay) has changed.
+ */
+void Neuron::synapsesChanged() {
+	++mSynapseRevision;
+	if(mOwnerNetwork != 0) {
+		mOwnerNetwork->invalidateExecutionSchedule();
+	}
+}
+
+
 bool Neuron::registerOutgoingSynapse(Synapse *synapse) {
 	if(synapse == 0 || mOutgoingSynapses.contains(synapse)) {
 		return false;
@@ -102,6 +102,8 @@ namespace nerd {
 		virtual bool addSynapse(Synapse *synapse);
 		virtual bool removeSynapse(Synapse *synapse);
 		virtual QList<Synapse*> getSynapses() const;
+		int getSynapseRevision() const;
+		void synapsesChanged();
 		virtual bool registerOutgoingSynapse(Synapse *synapse);
 		virtual bool deregisterOutgoingSynapse(Synapse *synapse);
 		virtual QList<Synapse*> getOutgoingSynapses() const;
@@ -134,6 +136,7 @@ namespace nerd {
 		bool mActivationCalculated;
 		bool mFlipActivation;
 		NeuralNetwork *mOwnerNetwork;
+		int mSynapseRevision;
 
 	};
 
@@ -0,0 +1,404 @@
+/***************************************************************************
+ *   NERD - Neurodynamics and Evolutionary Robotics Development Toolkit    *
+ *                                                                         *
+ *   University of Osnabrueck, Germany                                     *
+ *   Institute of Cognitive Science                                        *
+ *   Neurocybernetics Group                                                *
+ *   http://www.ikw.uni-osnabrueck.de/~neurokybernetik/                    *
+ *                                                                         *
+ *   Project homepage: nerd.x-bot.org                                      *
+ *                                                                         *
+ *   Copyright (C) 2008 - 2013 by the Neurocybernetics Group Osnabrück     *
+ *   Contact: Christian Rempis                                             *
+ *   christian.rempis@uni-osnabrueck.de                                    *
+ *   Contributors: see contributors.txt in the nerd main directory.        *
+ *                                                                         *
+ *                                                                         *
+ *   Acknowledgments:                                                      *
+ *   The NERD Toolkit is part of the EU project ALEAR                      *
+ *   (Artificial Language Evolution on Autonomous Robots) www.ALEAR.eu     *
+ *   This work was funded (2008 - 2011) by EU-Project Number ICT 214856    *
+ *                                                                         *
+ *                                                                         *
+ *   License Agreement:                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ *                                                                         *
+ *   Publications based on work using the NERD kit have to state this      *
+ *   clearly by citing the NERD homepage and the NERD overview paper.      *  
+ ***************************************************************************/
+
+
+#include "SpikingEventEngine.h"
+#include "Network/NeuralNetwork.h"
+#include "Network/Neuron.h"
+#include "Network/Synapse.h"
+#include "ActivationFunction/Izhikevitch2003SpikingActivationFunction.h"
+#include "SynapseFunction/SimpleSynapseFunction.h"
+#include "NeuralNetworkConstants.h"
+#include "Core/Core.h"
+#include "Math/Math.h"
+#include <QHash>
+#include <QListIterator>
+#include <iostream>
+#include <limits>
+
+using namespace std;
+
+namespace nerd {
+
+
+SpikingEventEngine::SpikingEventEngine(NeuralNetwork *network)
+	: mNetwork(network), mValid(false), mApplicable(false), mDiscardEvents(true), mCurrentSlot(0),
+	  mNumberOfTransmittedEvents(0), mNumberOfSkippedUpdates(0)
+{
+}
+
+SpikingEventEngine::~SpikingEventEngine() {
+	clearObservedValues();
+}
+
+
+QString SpikingEventEngine::getName() const {
+	return "SpikingEventEngine";
+}
+
+
+/**
+ * Executes a single network step for the given neurons. The neurons have to be
+ * prepared already (as in NeuralNetwork::executeIterations()).
+ *
+ * @param updatedNeurons the neurons to update (all processible neurons of the network).
+ * @return false if the network can not be executed event-driven. In this case nothing
+ *         was updated.
+ */
+bool SpikingEventEngine::executeStep(const QVector<Neuron*> &updatedNeurons) {
+	if(!mValid) {
+		mApplicable = rebuild(updatedNeurons);
+		mValid = true;
+	}
+	if(!mApplicable) {
+		return false;
+	}
+	
+	int numberOfSlots = mEventSlots.size();
+	double *inputs = mInputs.data();
+
+	//deliver the delayed events of this step.
+	QVector<SpikeEvent> &currentEvents = mEventSlots[mCurrentSlot];
+	for(int i = 0; i < currentEvents.size(); ++i) {
+		const SpikeEvent &event = currentEvents.at(i);
+		inputs[mOutgoingTargets.at(event.mSynapse)] += 
+				mOutgoingWeights.at(event.mSynapse) * event.mOutputDelta;
+	}
+	currentEvents.clear();
+	
+	//send output changes of the last step to the targets.
+	for(int i = 0; i < mSourceIndices.size(); ++i) {
+		int source = mSourceIndices.at(i);
+		double output = mNeurons.at(source)->getLastOutputActivation();
+		double delta = output - mEmittedOutputs.at(source);
+		if(delta == 0.0) {
+			continue;
+		}
+		mEmittedOutputs[source] = output;
+		
+		int end = mOutgoingOffsets.at(source + 1);
+		for(int j = mOutgoingOffsets.at(source); j < end; ++j) {
+			int delay = mOutgoingDelays.at(j);
+			if(delay == 0) {
+				inputs[mOutgoingTargets.at(j)] += mOutgoingWeights.at(j) * delta;
+			}
+			else {
+				mEventSlots[(mCurrentSlot + delay) % numberOfSlots].append(SpikeEvent(j, delta));
+			}
+			++mNumberOfTransmittedEvents;
+		}
+	}
+	
+	//integrate the neurons.
+	for(int i = 0; i < mUpdateIndices.size(); ++i) {
+		int index = mUpdateIndices.at(i);
+		Neuron *neuron = mNeurons.at(index);
+		Izhikevitch2003SpikingActivationFunction *af = mUpdateFunctions.at(i);
+		
+		double input = neuron->getBiasValue().get() + inputs[index];
+		if(input == mLastInputs.at(i) && af->isStationary()) {
+			++mNumberOfSkippedUpdates;
+			continue;
+		}
+		mLastInputs[i] = input;
+		
+		double activation = af->integrate(neuron, input);
+		neuron->getActivationValue().set(activation);
+		neuron->getOutputActivationValue().set(
+				neuron->getTransferFunction()->transferActivation(activation, neuron));
+	}
+	
+	mCurrentSlot = (mCurrentSlot + 1) % numberOfSlots;
+	
+	return true;
+}
+
+
+/**
+ * Forces a rebuild of the synapse tables at the next step. Pending delayed
+ * events are kept.
+ */
+void SpikingEventEngine::invalidate() {
+	mValid = false;
+}
+
+
+/**
+ * Forces a rebuild of the synapse tables at the next step and discards all 
+ * pending delayed events. Used when the network is reset.
+ */
+void SpikingEventEngine::reset() {
+	mValid = false;
+	mDiscardEvents = true;
+}
+
+
+void SpikingEventEngine::valueChanged(Value*) {
+	mValid = false;
+}
+
+
+void SpikingEventEngine::forceListenerDeregistration(Value *value) {
+	mObservedValues.removeAll(value);
+	ValueChangedListener::forceListenerDeregistration(value);
+	mValid = false;
+}
+
+
+int SpikingEventEngine::getNumberOfTransmittedEvents() const {
+	return mNumberOfTransmittedEvents;
+}
+
+
+int SpikingEventEngine::getNumberOfSkippedUpdates() const {
+	return mNumberOfSkippedUpdates;
+}
+
+
+int SpikingEventEngine::getNumberOfPendingEvents() const {
+	int numberOfEvents = 0;
+	for(int i = 0; i < mEventSlots.size(); ++i) {
+		numberOfEvents += mEventSlots.at(i).size();
+	}
+	return numberOfEvents;
+}
+
+
+/**
+ * Returns the summed synaptic input that has arrived at the neuron so far
+ * (without the bias), or 0.0 if the neuron is not part of the engine.
+ */
+double SpikingEventEngine::getSynapticInput(Neuron *neuron) const {
+	int index = mNeurons.indexOf(neuron);
+	if(index < 0 || index >= mInputs.size()) {
+		return 0.0;
+	}
+	return mInputs.at(index);
+}
+
+
+/**
+ * Builds the outgoing synapse tables of all neurons and initializes the summed
+ * synaptic input of each neuron from the current outputs.
+ * 
+ * Unless the engine was reset, the delayed events in flight and the outputs already 
+ * sent by the neurons are carried over. The summed input then only contains the output 
+ * changes that have arrived, weighted with the new synapse strengths.
+ *
+ * @return true if the network can be executed event-driven.
+ */
+bool SpikingEventEngine::rebuild(const QVector<Neuron*> &updatedNeurons) {
+	clearObservedValues();
+
+	//pending output changes per synapse: (remaining steps, output delta).
+	QHash<Synapse*, QList<QPair<int, double> > > pendingEvents;
+	QHash<Neuron*, double> emittedOutputs;
+	if(!mDiscardEvents) {
+		int numberOfSlots = mEventSlots.size();
+		for(int i = 0; i < numberOfSlots; ++i) {
+			int remainingSteps = (i - mCurrentSlot + numberOfSlots) % numberOfSlots;
+			const QVector<SpikeEvent> &events = mEventSlots.at(i);
+			for(int j = 0; j < events.size(); ++j) {
+				const SpikeEvent &event = events.at(j);
+				pendingEvents[mOutgoingSynapses.at(event.mSynapse)].append(
+						qMakePair(remainingSteps, event.mOutputDelta));
+			}
+		}
+		for(int i = 0; i < mNeurons.size() && i < mEmittedOutputs.size(); ++i) {
+			emittedOutputs.insert(mNeurons.at(i), mEmittedOutputs.at(i));
+		}
+	}
+	mDiscardEvents = false;
+
+	mNeurons.clear();
+	mUpdateIndices.clear();
+	mUpdateFunctions.clear();
+	mLastInputs.clear();
+	mSourceIndices.clear();
+	mOutgoingOffsets.clear();
+	mOutgoingTargets.clear();
+	mOutgoingWeights.clear();
+	mOutgoingDelays.clear();
+	mOutgoingSynapses.clear();
+	mInputs.clear();
+	mEmittedOutputs.clear();
+	mEventSlots.clear();
+	mCurrentSlot = 0;
+
+	if(mNetwork == 0) {
+		return false;
+	}
+
+	QList<Neuron*> neurons = mNetwork->getNeurons();
+	QHash<Neuron*, int> indices;
+	indices.reserve(neurons.size());
+	mNeurons.reserve(neurons.size());
+	for(QListIterator<Neuron*> i(neurons); i.hasNext();) {
+		Neuron *neuron = i.next();
+		indices.insert(neuron, mNeurons.size());
+		mNeurons.append(neuron);
+	}
+
+	for(int i = 0; i < updatedNeurons.size(); ++i) {
+		Neuron *neuron = updatedNeurons.at(i);
+		Izhikevitch2003SpikingActivationFunction *af = 
+				dynamic_cast<Izhikevitch2003SpikingActivationFunction*>(neuron->getActivationFunction());
+		if(af == 0 || neuron->getTransferFunction() == 0 || !indices.contains(neuron)) {
+			Core::log("SpikingEventEngine: Neuron [" + neuron->getNameValue().get()
+					+ "] is not an Izhikevitch2003 neuron. [Using clock-driven execution]", true);
+			return false;
+		}
+		mUpdateIndices.append(indices.value(neuron));
+		mUpdateFunctions.append(af);
+	}
+	//NaN never equals an input, so each neuron is integrated at least once after a rebuild.
+	mLastInputs.fill(numeric_limits<double>::quiet_NaN(), mUpdateIndices.size());
+
+	//collect the synapses of all neurons, sorted by their source neuron.
+	QVector<int> numberOfOutgoingSynapses(mNeurons.size(), 0);
+	QList<Synapse*> synapses;
+	QList<int> synapseTargets;
+	for(int i = 0; i < mNeurons.size(); ++i) {
+		QList<Synapse*> incoming = mNeurons.at(i)->getSynapses();
+		for(QListIterator<Synapse*> j(incoming); j.hasNext();) {
+			Synapse *synapse = j.next();
+			if(dynamic_cast<SimpleSynapseFunction*>(synapse->getSynapseFunction()) == 0
+				|| !synapse->getSynapses().empty()
+				|| !indices.contains(synapse->getSource()))
+			{
+				Core::log("SpikingEventEngine: Synapse [" + QString::number(synapse->getId())
+						+ "] is not supported. [Using clock-driven execution]", true);
+				return false;
+			}
+			numberOfOutgoingSynapses[indices.value(synapse->getSource())]++;
+			synapses.append(synapse);
+			synapseTargets.append(i);
+		}
+	}
+
+	mOutgoingOffsets.resize(mNeurons.size() + 1);
+	mOutgoingOffsets[0] = 0;
+	for(int i = 0; i < mNeurons.size(); ++i) {
+		mOutgoingOffsets[i + 1] = mOutgoingOffsets.at(i) + numberOfOutgoingSynapses.at(i);
+		if(numberOfOutgoingSynapses.at(i) > 0) {
+			mSourceIndices.append(i);
+		}
+	}
+	mOutgoingTargets.resize(synapses.size());
+	mOutgoingWeights.resize(synapses.size());
+	mOutgoingDelays.resize(synapses.size());
+	mOutgoingSynapses.resize(synapses.size());
+	mInputs.fill(0.0, mNeurons.size());
+	mEmittedOutputs.fill(0.0, mNeurons.size());
+
+	//output changes that were not sent yet are sent in the next step as usual.
+	for(int i = 0; i < mNeurons.size(); ++i) {
+		Neuron *neuron = mNeurons.at(i);
+		mEmittedOutputs[i] = emittedOutputs.value(neuron, neuron->getLastOutputActivation());
+	}
+
+	QVector<int> insertPositions = mOutgoingOffsets;
+	QList<QPair<int, SpikeEvent> > carriedEvents;
+	int maxDelay = 0;
+	for(int i = 0; i < synapses.size(); ++i) {
+		Synapse *synapse = synapses.at(i);
+		int source = indices.value(synapse->getSource());
+		int target = synapseTargets.at(i);
+		int position = insertPositions[source]++;
+
+		double weight = 0.0;
+		if(synapse->getEnabledValue().get()) {
+			weight = synapse->getStrengthValue().get();
+		}
+		int delay = 0;
+		if(synapse->hasProperty(NeuralNetworkConstants::TAG_SYNAPSE_DELAY)) {
+			delay = Math::max(0, synapse->getProperty(
+						NeuralNetworkConstants::TAG_SYNAPSE_DELAY).toInt());
+		}
+		maxDelay = Math::max(maxDelay, delay);
+
+		mOutgoingTargets[position] = target;
+		mOutgoingWeights[position] = weight;
+		mOutgoingDelays[position] = delay;
+		mOutgoingSynapses[position] = synapse;
+
+		//output changes in flight have not arrived at the target yet.
+		double arrivedOutput = mEmittedOutputs.at(source);
+		QList<QPair<int, double> > events = pendingEvents.value(synapse);
+		for(QListIterator<QPair<int, double> > j(events); j.hasNext();) {
+			QPair<int, double> event = j.next();
+			arrivedOutput -= event.second;
+			carriedEvents.append(qMakePair(event.first, SpikeEvent(position, event.second)));
+			maxDelay = Math::max(maxDelay, event.first);
+		}
+		mInputs[target] += weight * arrivedOutput;
+
+		observeValue(&synapse->getStrengthValue());
+		observeValue(&synapse->getEnabledValue());
+	}
+	mEventSlots.resize(maxDelay + 1);
+	for(QListIterator<QPair<int, SpikeEvent> > i(carriedEvents); i.hasNext();) {
+		QPair<int, SpikeEvent> event = i.next();
+		mEventSlots[event.first].append(event.second);
+	}
+
+	return true;
+}
+
+
+void SpikingEventEngine::observeValue(Value *value) {
+	if(value->addValueChangedListener(this)) {
+		mObservedValues.append(value);
+	}
+}
+
+
+void SpikingEventEngine::clearObservedValues() {
+	for(QListIterator<Value*> i(mObservedValues); i.hasNext();) {
+		i.next()->removeValueChangedListener(this);
+	}
+	mObservedValues.clear();
+}
+
+}
+
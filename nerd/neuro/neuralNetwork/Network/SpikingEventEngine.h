@@ -0,0 +1,156 @@
+/***************************************************************************
+ *   NERD - Neurodynamics and Evolutionary Robotics Development Toolkit    *
+ *                                                                         *
+ *   University of Osnabrueck, Germany                                     *
+ *   Institute of Cognitive Science                                        *
+ *   Neurocybernetics Group                                                *
+ *   http://www.ikw.uni-osnabrueck.de/~neurokybernetik/                    *
+ *                                                                         *
+ *   Project homepage: nerd.x-bot.org                                      *
+ *                                                                         *
+ *   Copyright (C) 2008 - 2013 by the Neurocybernetics Group Osnabrück     *
+ *   Contact: Christian Rempis                                             *
+ *   christian.rempis@uni-osnabrueck.de                                    *
+ *   Contributors: see contributors.txt in the nerd main directory.        *
+ *                                                                         *
+ *                                                                         *
+ *   Acknowledgments:                                                      *
+ *   The NERD Toolkit is part of the EU project ALEAR                      *
+ *   (Artificial Language Evolution on Autonomous Robots) www.ALEAR.eu     *
+ *   This work was funded (2008 - 2011) by EU-Project Number ICT 214856    *
+ *                                                                         *
+ *                                                                         *
+ *   License Agreement:                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ *                                                                         *
+ *   Publications based on work using the NERD kit have to state this      *
+ *   clearly by citing the NERD homepage and the NERD overview paper.      *  
+ ***************************************************************************/
+
+
+#ifndef NERDSpikingEventEngine_H
+#define NERDSpikingEventEngine_H
+
+#include "Value/ValueChangedListener.h"
+#include <QList>
+#include <QVector>
+
+namespace nerd {
+
+	class NeuralNetwork;
+	class Neuron;
+	class Synapse;
+	class Izhikevitch2003SpikingActivationFunction;
+
+	/**
+	 * SpikeEvent.
+	 * A change of the output of a neuron that arrives at the target of a delayed 
+	 * synapse in a later network step. The event is weighted with the synapse
+	 * strength when it arrives.
+	 */
+	struct SpikeEvent {
+		SpikeEvent() : mSynapse(0), mOutputDelta(0.0) {}
+		SpikeEvent(int synapse, double outputDelta) : mSynapse(synapse), mOutputDelta(outputDelta) {}
+
+		int mSynapse;
+		double mOutputDelta;
+	};
+
+
+	/**
+	 * SpikingEventEngine.
+	 *
+	 * Event-driven execution of networks made of Izhikevitch2003SpikingActivationFunction 
+	 * neurons. It is used by NeuralNetwork::executeIterations() when the network has the 
+	 * property EventDrivenSpiking.
+	 *
+	 * Instead of evaluating all synapses in every step, the engine keeps the summed 
+	 * synaptic input of each neuron. Only when the output of a neuron changes (e.g. at a 
+	 * spike), the difference is sent to the targets of its outgoing synapses. Events with
+	 * a delay (synapse property SynapseDelay, in network steps) are stored in a calendar 
+	 * queue with one bucket per step. Without delays the neurons see the same inputs as 
+	 * in the clock-driven execution.
+	 *
+	 * The Izhikevitch model has no closed-form solution, so neurons are still integrated
+	 * step by step. However, a neuron that rests in a fixed point and whose input did 
+	 * not change is skipped, because its state would not change either.
+	 *
+	 * The engine only works if all updated neurons use Izhikevitch2003SpikingActivationFunction
+	 * and all synapses are SimpleSynapseFunctions between neurons. Otherwise executeStep()
+	 * returns false and the network falls back to the clock-driven execution.
+	 * Strength and enabled changes of synapses are detected automatically. 
+	 * All other changes require invalidate(). Events in flight are carried over such 
+	 * rebuilds and arrive at their original step, weighted with the new strength. 
+	 * Only reset() discards them.
+	 */
+	class SpikingEventEngine : public virtual ValueChangedListener {
+	public:
+		SpikingEventEngine(NeuralNetwork *network);
+		virtual ~SpikingEventEngine();
+
+		virtual QString getName() const;
+
+		bool executeStep(const QVector<Neuron*> &updatedNeurons);
+		void invalidate();
+		void reset();
+
+		virtual void valueChanged(Value *value);
+		virtual void forceListenerDeregistration(Value *value);
+
+		int getNumberOfTransmittedEvents() const;
+		int getNumberOfSkippedUpdates() const;
+		int getNumberOfPendingEvents() const;
+		double getSynapticInput(Neuron *neuron) const;
+
+	private:
+		bool rebuild(const QVector<Neuron*> &updatedNeurons);
+		void observeValue(Value *value);
+		void clearObservedValues();
+
+	private:
+		NeuralNetwork *mNetwork;
+		bool mValid;
+		bool mApplicable;
+		bool mDiscardEvents;
+
+		QVector<Neuron*> mNeurons;
+		QVector<int> mUpdateIndices;
+		QVector<Izhikevitch2003SpikingActivationFunction*> mUpdateFunctions;
+		QVector<double> mLastInputs;
+
+		//outgoing synapses of neuron i: mOutgoingOffsets[i] .. mOutgoingOffsets[i + 1].
+		QVector<int> mSourceIndices;
+		QVector<int> mOutgoingOffsets;
+		QVector<int> mOutgoingTargets;
+		QVector<double> mOutgoingWeights;
+		QVector<int> mOutgoingDelays;
+		QVector<Synapse*> mOutgoingSynapses;
+
+		QVector<double> mInputs;
+		QVector<double> mEmittedOutputs;
+		QVector<QVector<SpikeEvent> > mEventSlots;
+		int mCurrentSlot;
+
+		QList<Value*> mObservedValues;
+		int mNumberOfTransmittedEvents;
+		int mNumberOfSkippedUpdates;
+	};
+
+}
+
+#endif
+
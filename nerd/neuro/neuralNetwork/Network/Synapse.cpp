@@ -47,6 +47,7 @@
 #include "Network/NeuralNetwork.h"
 #include "Math/Math.h"
 #include "Util/NeuralNetworkUtil.h"
+#include "NeuralNetworkConstants.h"
 #include <iostream>
 
 using namespace std;
@@ -367,6 +368,22 @@ void Synapse::centerPosition() {
 }
 
 
+/**
+ * Notifies the target neuron when the synapse delay changes, so that functions
+ * caching the delays of the incoming synapses are updated.
+ */
+void Synapse::propertyChanged(Properties *owner, const QString &property) {
+	SynapseTarget::propertyChanged(owner, property);
+
+	if(owner != this || property != NeuralNetworkConstants::TAG_SYNAPSE_DELAY) {
+		return;
+	}
+	Neuron *target = dynamic_cast<Neuron*>(mTarget);
+	if(target != 0) {
+		target->synapsesChanged();
+	}
+}
+
 
 }
 
@@ -97,6 +97,8 @@ namespace nerd {
 
 		virtual void centerPosition();
 
+		virtual void propertyChanged(Properties *owner, const QString &property);
+
 	protected:
 		Neuron *mSourceNeuron;
 		SynapseTarget *mTarget;
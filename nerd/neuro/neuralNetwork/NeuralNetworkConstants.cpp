@@ -122,6 +122,9 @@ const QString NeuralNetworkConstants::VALUE_NNM_BYPASS_NETWORKS
 		const QString NeuralNetworkConstants::VALUE_NNM_NUMBER_OF_ITERATIONS_PER_STEP
 		= "/NeuralNetwork/UpdatesPerStep";
 
+const QString NeuralNetworkConstants::VALUE_NNM_NUMBER_OF_EXECUTION_THREADS
+		= "/NeuralNetwork/NumberOfExecutionThreads";
+
 const QString NeuralNetworkConstants::VALUE_EVO_CURRENT_GENERATION_NUMBER
 		= "/Evolution/CurrentGeneration";
 		
@@ -363,5 +366,11 @@ const QString NeuralNetworkConstants::TAG_EVOLUTION_NEW_BIAS
 		
 const QString NeuralNetworkConstants::TAG_DISABLE_NEURO_MODULATORS
 		= "DisableNeuroModulators";
+
+const QString NeuralNetworkConstants::TAG_NETWORK_EVENT_DRIVEN_SPIKING
+		= "EventDrivenSpiking";
+
+const QString NeuralNetworkConstants::TAG_SYNAPSE_DELAY
+		= "SynapseDelay";
 		
 		
\ No newline at end of file
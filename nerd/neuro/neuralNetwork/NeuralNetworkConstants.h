@@ -95,6 +95,7 @@ namespace nerd {
 		static const QString VALUE_EVO_STASIS_MODE;
 		static const QString VALUE_NNM_BYPASS_NETWORKS;
 		static const QString VALUE_NNM_NUMBER_OF_ITERATIONS_PER_STEP;
+		static const QString VALUE_NNM_NUMBER_OF_EXECUTION_THREADS;
 		static const QString VALUE_EVO_CURRENT_GENERATION_NUMBER;
 		static const QString VALUE_ANALYZER_RUN_COUNTER;
 		static const QString VALUE_ENABLE_NEURO_MODULATORS;
@@ -179,6 +180,8 @@ namespace nerd {
 		static const QString TAG_EVOLUTION_NEW_ELEMENT;
 		static const QString TAG_EVOLUTION_NEW_BIAS;
 		static const QString TAG_DISABLE_NEURO_MODULATORS;
+		static const QString TAG_NETWORK_EVENT_DRIVEN_SPIKING;
+		static const QString TAG_SYNAPSE_DELAY;
 		
 		
 	};
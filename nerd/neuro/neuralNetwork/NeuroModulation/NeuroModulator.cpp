@@ -53,12 +53,15 @@
 #include "Core/Core.h"
 #include "Value/BoolValue.h"
 #include "NeuroModulatorManager.h"
+#include "NeuroModulatorField.h"
 #include <sstream>
 
 using namespace std;
 
 namespace nerd {
 
+QAtomicInt NeuroModulator::mGeometryRevision(0);
+
 NeuroModulator::NeuroModulator() 
 	: mDefaultDistributionModus(2), mDefaultUpdateModus(0), mResetPending(true),
 		mEnableUpdate(0), mEnableConcentrationCalculation(0)
@@ -145,6 +148,7 @@ void NeuroModulator::setConcentration(int type, double concentration, NeuralNetw
 	bool containsType = mConcentrations.keys().contains(type);
 	mConcentrations.insert(type, concentration);
 	if(!containsType) {
+		mGeometryRevision.ref();
 		//initialize the update operator.
 		updateType(type, owner, true);
 	}
@@ -265,6 +269,9 @@ double NeuroModulator::getMaxConcentration(int type) {
 void NeuroModulator::setLocalAreaRect(int type, double width, double height, 
 									const Vector3D &offset, bool isCircle)
 {
+	QRectF oldBounds = getInfluenceBounds(type);
+	bool hadReferenceModule = mReferenceModules.contains(type);
+	
 	mReferenceModules.remove(type);
 	if(isCircle) {
 		////TODO currently, only real circles are supported (no ellipses)
@@ -272,6 +279,14 @@ void NeuroModulator::setLocalAreaRect(int type, double width, double height,
 	}
 	mAreas.insert(type, QRectF(offset.getX(), offset.getY(), width, height));
 	mIsCircle.insert(type, isCircle);
+	
+	//shrinking areas do not invalidate the NeuroModulatorFields.
+	QRectF newBounds = getInfluenceBounds(type);
+	if(hadReferenceModule || (newBounds.width() > 0.0 && newBounds.height() > 0.0 
+			&& !oldBounds.contains(newBounds))) 
+	{
+		mGeometryRevision.ref();
+	}
 }
 
 
@@ -282,6 +297,12 @@ void NeuroModulator::setAreaReferenceModule(int type, NeuroModule *module) {
 	mAreas.remove(type);
 	mIsCircle.remove(type);
 	mReferenceModules.insert(type, module);
+	mGeometryRevision.ref();
+}
+
+
+NeuroModule* NeuroModulator::getAreaReferenceModule(int type) const {
+	return mReferenceModules.value(type, 0);
 }
 
 
@@ -298,6 +319,23 @@ QRectF NeuroModulator::getLocalRect(int type) {
 }
 
 
+/**
+ * Returns the bounding box of the area of influence of the given type, 
+ * relative to the position of the owner.
+ */
+QRectF NeuroModulator::getInfluenceBounds(int type) {
+	QRectF area = getLocalRect(type);
+	if(area.width() <= 0.0 || area.height() <= 0.0) {
+		return QRectF(0.0, 0.0, 0.0, 0.0);
+	}
+	if(isCircularArea(type)) {
+		double radius = area.width() / 2.0;
+		return QRectF(area.x() - radius, area.y() - radius, area.width(), area.width());
+	}
+	return area;
+}
+
+
 bool NeuroModulator::isCircularArea(int type) {
 	return mIsCircle.value(type, true);
 }
@@ -451,26 +489,26 @@ bool NeuroModulator::equals(NeuroModulator *modulator) const {
 
 
 
+/**
+ * Returns the summed concentration of all modulator emitting neurons of the network
+ * at the given position. The emitters are looked up in the NeuroModulatorField of 
+ * the network, so that only emitters close to the position are evaluated.
+ */
 double NeuroModulator::getConcentrationInNetworkAt(int type, const Vector3D &position, NeuralNetwork *network) {
 
 	if(network == 0) {
 		return 0.0;
 	}
-	double concentration = 0.0;
-	
-	QList<Neuron*> neurons = network->getNeurons();
-	for(QListIterator<Neuron*> i(neurons); i.hasNext();) {
-		Neuron *neuron = i.next();
-		NeuroModulatorActivationFunction *nmaf = 
-					dynamic_cast<NeuroModulatorActivationFunction*>(neuron->getActivationFunction());
-		if(nmaf != 0) {
-			NeuroModulator *mod = nmaf->getNeuroModulator();
-			if(mod != 0) {
-				concentration += mod->getConcentrationAt(type, position, neuron);
-			}
-		}
-	}
-	return concentration;
+	return network->getNeuroModulatorField()->getConcentrationAt(type, position);
+}
+
+
+/**
+ * Returns a counter that is incremented whenever the area of influence of any modulator
+ * may have grown. This is used by the NeuroModulatorFields to detect outdated grids.
+ */
+int NeuroModulator::getGeometryRevision() {
+	return mGeometryRevision;
 }
 
 
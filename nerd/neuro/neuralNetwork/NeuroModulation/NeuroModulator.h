@@ -50,6 +50,7 @@
 #include "Network/ObservableNetworkElement.h"
 #include "Math/Vector3D.h"
 #include <QRectF>
+#include <QAtomicInt>
 
 namespace nerd {
 
@@ -86,7 +87,9 @@ class NeuralNetworkManager;
 		
 		virtual void setLocalAreaRect(int type, double width, double height, const Vector3D &offset, bool isCircle);
 		virtual void setAreaReferenceModule(int type, NeuroModule *module);
+		virtual NeuroModule* getAreaReferenceModule(int type) const;
 		virtual QRectF getLocalRect(int type);
+		virtual QRectF getInfluenceBounds(int type);
 		virtual bool isCircularArea(int type);
 		
 		virtual void setDistributionModus(int type, int modus);
@@ -103,6 +106,7 @@ class NeuralNetworkManager;
 		virtual bool equals(NeuroModulator *modulator) const;
 		
 		static double getConcentrationInNetworkAt(int type, const Vector3D &position, NeuralNetwork *network);
+		static int getGeometryRevision();
 		
 	protected:
 		virtual QString getModulatorDefaultDoc();
@@ -129,6 +133,9 @@ class NeuralNetworkManager;
 		BoolValue *mEnableConcentrationCalculation;
 		
 		NeuralNetworkManager *mNetworkManager;
+		
+	private:
+		static QAtomicInt mGeometryRevision;
 
 	};
 
@@ -0,0 +1,240 @@
+/***************************************************************************
+ *   NERD - Neurodynamics and Evolutionary Robotics Development Toolkit    *
+ *                                                                         *
+ *   University of Osnabrueck, Germany                                     *
+ *   Institute of Cognitive Science                                        *
+ *   Neurocybernetics Group                                                *
+ *   http://www.ikw.uni-osnabrueck.de/~neurokybernetik/                    *
+ *                                                                         *
+ *   Project homepage: nerd.x-bot.org                                      *
+ *                                                                         *
+ *   Copyright (C) 2008 - 2013 by the Neurocybernetics Group Osnabrück     *
+ *   Contact: Christian Rempis                                             *
+ *   christian.rempis@uni-osnabrueck.de                                    *
+ *   Contributors: see contributors.txt in the nerd main directory.        *
+ *                                                                         *
+ *                                                                         *
+ *   Acknowledgments:                                                      *
+ *   The NERD Toolkit is part of the EU project ALEAR                      *
+ *   (Artificial Language Evolution on Autonomous Robots) www.ALEAR.eu     *
+ *   This work was funded (2008 - 2011) by EU-Project Number ICT 214856    *
+ *                                                                         *
+ *                                                                         *
+ *   License Agreement:                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ *                                                                         *
+ *   Publications based on work using the NERD kit have to state this      *
+ *   clearly by citing the NERD homepage and the NERD overview paper.      *  
+ ***************************************************************************/
+
+
+
+#include "NeuroModulatorField.h"
+#include "NeuroModulation/NeuroModulator.h"
+#include "Network/NeuralNetwork.h"
+#include "Network/Neuron.h"
+#include "ActivationFunction/NeuroModulatorActivationFunction.h"
+#include <QtAlgorithms>
+#include <math.h>
+
+using namespace std;
+
+namespace nerd {
+
+/**
+ * Emitters covering more grid cells than this are not sorted into the grid, 
+ * but are checked for every query.
+ */
+static const int MAX_CELLS_PER_EMITTER = 64;
+
+
+NeuroModulatorField::NeuroModulatorField(NeuralNetwork *network)
+	: mNetwork(network), mValid(false)
+{
+}
+
+NeuroModulatorField::~NeuroModulatorField() {
+}
+
+
+/**
+ * Forces the field to gather all emitters again with the next query.
+ * Has to be called whenever neurons, their positions or their activation 
+ * functions change.
+ */
+void NeuroModulatorField::invalidate() {
+	mValid = false;
+}
+
+
+/**
+ * Returns the sum of the concentrations of all modulator emitters of the network 
+ * at the given position. This is equivalent to the exhaustive summation over all
+ * neurons of the network.
+ */
+double NeuroModulatorField::getConcentrationAt(int type, const Vector3D &position) {
+	if(!mValid) {
+		collectEmitters();
+	}
+	if(mEmitters.empty()) {
+		return 0.0;
+	}
+
+	TypeGrid &grid = mGrids[type];
+	if(grid.mRevision != NeuroModulator::getGeometryRevision()) {
+		buildGrid(type, grid);
+	}
+
+	static const QVector<int> emptyCell;
+	const QVector<int> &cell = grid.mCellSize <= 0.0 ? emptyCell 
+			: grid.mCells.value(getCellKey(getCellIndex(position.getX(), grid.mCellSize), 
+											getCellIndex(position.getY(), grid.mCellSize)), emptyCell);
+	const QVector<int> &large = grid.mLargeEmitters;
+
+	//merge both (sorted) candidate lists to keep the summation order of the network neurons.
+	double concentration = 0.0;
+	int i = 0;
+	int j = 0;
+	while(i < cell.size() || j < large.size()) {
+		int index = 0;
+		if(j >= large.size() || (i < cell.size() && cell.at(i) < large.at(j))) {
+			index = cell.at(i++);
+		}
+		else {
+			index = large.at(j++);
+		}
+		const Emitter &emitter = mEmitters.at(index);
+		concentration += emitter.mModulator->getConcentrationAt(type, position, emitter.mNeuron);
+	}
+	return concentration;
+}
+
+
+int NeuroModulatorField::getNumberOfEmitters() {
+	if(!mValid) {
+		collectEmitters();
+	}
+	return mEmitters.size();
+}
+
+
+void NeuroModulatorField::collectEmitters() {
+	mEmitters.clear();
+	mGrids.clear();
+	mValid = true;
+
+	if(mNetwork == 0) {
+		return;
+	}
+
+	QList<Neuron*> neurons = mNetwork->getNeurons();
+	for(QListIterator<Neuron*> i(neurons); i.hasNext();) {
+		Neuron *neuron = i.next();
+		NeuroModulatorActivationFunction *nmaf = 
+					dynamic_cast<NeuroModulatorActivationFunction*>(neuron->getActivationFunction());
+		if(nmaf != 0 && nmaf->getNeuroModulator() != 0) {
+			Emitter emitter;
+			emitter.mNeuron = neuron;
+			emitter.mModulator = nmaf->getNeuroModulator();
+			mEmitters.append(emitter);
+		}
+	}
+}
+
+
+/**
+ * Sorts all emitters into the grid cells overlapped by their area of influence.
+ * The cell size is the mean extent of the areas, so that most emitters
+ * are registered in only a few cells. 
+ */
+void NeuroModulatorField::buildGrid(int type, TypeGrid &grid) {
+	grid.mRevision = NeuroModulator::getGeometryRevision();
+	grid.mCells.clear();
+	grid.mLargeEmitters.clear();
+	grid.mCellSize = 0.0;
+
+	QVector<QRectF> bounds(mEmitters.size());
+	double extentSum = 0.0;
+	int numberOfBounded = 0;
+
+	for(int i = 0; i < mEmitters.size(); ++i) {
+		const Emitter &emitter = mEmitters.at(i);
+		if(emitter.mModulator->getAreaReferenceModule(type) != 0) {
+			//area depends on the module geometry, which is not tracked: check always.
+			grid.mLargeEmitters.append(i);
+			continue;
+		}
+		QRectF area = emitter.mModulator->getInfluenceBounds(type);
+		if(area.width() <= 0.0 || area.height() <= 0.0) {
+			continue;
+		}
+		//enlarge the bounds slightly to be robust against rounding errors at the borders.
+		Vector3D pos = emitter.mNeuron->getPosition();
+		double margin = 0.000001 * qMax(1.0, qMax(area.width(), area.height()));
+		bounds[i] = area.translated(pos.getX(), pos.getY()).adjusted(-margin, -margin, margin, margin);
+		extentSum += qMax(area.width(), area.height());
+		++numberOfBounded;
+	}
+	if(numberOfBounded == 0) {
+		return;
+	}
+	grid.mCellSize = qMax(1.0, extentSum / ((double) numberOfBounded));
+
+	for(int i = 0; i < mEmitters.size(); ++i) {
+		const QRectF &rect = bounds.at(i);
+		if(rect.width() <= 0.0 || rect.height() <= 0.0) {
+			continue;
+		}
+		int minX = getCellIndex(rect.left(), grid.mCellSize);
+		int maxX = getCellIndex(rect.right(), grid.mCellSize);
+		int minY = getCellIndex(rect.top(), grid.mCellSize);
+		int maxY = getCellIndex(rect.bottom(), grid.mCellSize);
+
+		if(((qint64) (maxX - minX + 1)) * ((qint64) (maxY - minY + 1)) > MAX_CELLS_PER_EMITTER) {
+			grid.mLargeEmitters.append(i);
+			continue;
+		}
+		for(int x = minX; x <= maxX; ++x) {
+			for(int y = minY; y <= maxY; ++y) {
+				grid.mCells[getCellKey(x, y)].append(i);
+			}
+		}
+	}
+	//mLargeEmitters may have been filled in two passes, so restore the neuron order.
+	qSort(grid.mLargeEmitters);
+}
+
+
+quint64 NeuroModulatorField::getCellKey(int x, int y) const {
+	return (((quint64) (quint32) x) << 32) | ((quint64) (quint32) y);
+}
+
+
+int NeuroModulatorField::getCellIndex(double coordinate, double cellSize) const {
+	double index = floor(coordinate / cellSize);
+	if(index > 1000000000.0) {
+		return 1000000000;
+	}
+	if(index < -1000000000.0) {
+		return -1000000000;
+	}
+	return (int) index;
+}
+
+
+}
+
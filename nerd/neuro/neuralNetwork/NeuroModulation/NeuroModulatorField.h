@@ -0,0 +1,119 @@
+/***************************************************************************
+ *   NERD - Neurodynamics and Evolutionary Robotics Development Toolkit    *
+ *                                                                         *
+ *   University of Osnabrueck, Germany                                     *
+ *   Institute of Cognitive Science                                        *
+ *   Neurocybernetics Group                                                *
+ *   http://www.ikw.uni-osnabrueck.de/~neurokybernetik/                    *
+ *                                                                         *
+ *   Project homepage: nerd.x-bot.org                                      *
+ *                                                                         *
+ *   Copyright (C) 2008 - 2013 by the Neurocybernetics Group Osnabrück     *
+ *   Contact: Christian Rempis                                             *
+ *   christian.rempis@uni-osnabrueck.de                                    *
+ *   Contributors: see contributors.txt in the nerd main directory.        *
+ *                                                                         *
+ *                                                                         *
+ *   Acknowledgments:                                                      *
+ *   The NERD Toolkit is part of the EU project ALEAR                      *
+ *   (Artificial Language Evolution on Autonomous Robots) www.ALEAR.eu     *
+ *   This work was funded (2008 - 2011) by EU-Project Number ICT 214856    *
+ *                                                                         *
+ *                                                                         *
+ *   License Agreement:                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ *                                                                         *
+ *   Publications based on work using the NERD kit have to state this      *
+ *   clearly by citing the NERD homepage and the NERD overview paper.      *  
+ ***************************************************************************/
+
+
+
+#ifndef NERDNeuroModulatorField_H
+#define NERDNeuroModulatorField_H
+
+#include <QHash>
+#include <QVector>
+#include <QRectF>
+#include "Math/Vector3D.h"
+
+namespace nerd {
+
+	class Neuron;
+	class NeuroModulator;
+	class NeuralNetwork;
+
+	/**
+	 * NeuroModulatorField.
+	 *
+	 * Per-network cache to speed up NeuroModulator::getConcentrationInNetworkAt().
+	 * All modulator emitting neurons of the network are gathered once (per step) and 
+	 * are sorted, separately for each modulator type, into a uniform 2D grid by 
+	 * their areas of influence. A concentration query then only evaluates the emitters
+	 * registered in the grid cell of the query position instead of all neurons of 
+	 * the network.
+	 *
+	 * The concentrations themselves are still evaluated with NeuroModulator::getConcentrationAt(),
+	 * and the emitters are summed up in the order of the network neurons, so the results
+	 * are identical to the exhaustive search. 
+	 *
+	 * The emitter list is invalidated by the owner network at the beginning of each
+	 * step and whenever neurons are added, removed or get a new activation function.
+	 * The grid of a modulator type is rebuilt whenever any modulator area grew
+	 * (see NeuroModulator::getGeometryRevision()).
+	 */
+	class NeuroModulatorField {
+	public:
+		NeuroModulatorField(NeuralNetwork *network);
+		virtual ~NeuroModulatorField();
+
+		void invalidate();
+		double getConcentrationAt(int type, const Vector3D &position);
+		
+		int getNumberOfEmitters();
+
+	private:
+		struct Emitter {
+			Neuron *mNeuron;
+			NeuroModulator *mModulator;
+		};
+
+		struct TypeGrid {
+			TypeGrid() : mRevision(-1), mCellSize(0.0) {}
+
+			int mRevision;
+			double mCellSize;
+			QHash<quint64, QVector<int> > mCells;
+			QVector<int> mLargeEmitters;
+		};
+
+		void collectEmitters();
+		void buildGrid(int type, TypeGrid &grid);
+		quint64 getCellKey(int x, int y) const;
+		int getCellIndex(double coordinate, double cellSize) const;
+
+	private:
+		NeuralNetwork *mNetwork;
+		bool mValid;
+		QVector<Emitter> mEmitters;
+		QHash<int, TypeGrid> mGrids;
+	};
+
+}
+
+#endif
+
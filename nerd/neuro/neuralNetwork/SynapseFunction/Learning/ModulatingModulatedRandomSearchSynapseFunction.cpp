@@ -61,7 +61,8 @@ namespace nerd {
 	*/
 	ModulatingModulatedRandomSearchSynapseFunction::ModulatingModulatedRandomSearchSynapseFunction()
 		: NeuroModulatorSynapseFunction("MRS2"), mOwner(0), 
-		  mCurrentNetwork(0), mNumberOfStepsWithoutModulators(0)
+		  mCurrentNetwork(0), mNumberOfStepsWithoutModulators(0), mStateOwner(0),
+		  mDisableCounterSlot(-1), mWeightChangeCounterSlot(-1), mStoredWeightSlot(-1)
 	{
 		mTypeParameters = new CodeValue("default");
 		mTypeParameters->setDescription("Parameter Settings (1 block per modulator):\n"
@@ -102,7 +103,8 @@ namespace nerd {
 	ModulatingModulatedRandomSearchSynapseFunction::ModulatingModulatedRandomSearchSynapseFunction(
 											const ModulatingModulatedRandomSearchSynapseFunction &other)
 		: Object(), ValueChangedListener(), NeuroModulatorElement(other), NeuroModulatorSynapseFunction(other), 
-		  mOwner(0), mCurrentNetwork(0), mNumberOfStepsWithoutModulators(0)
+		  mOwner(0), mCurrentNetwork(0), mNumberOfStepsWithoutModulators(0), mStateOwner(0),
+		  mDisableCounterSlot(-1), mWeightChangeCounterSlot(-1), mStoredWeightSlot(-1)
 	{
 		mObservables.clear();
 		
@@ -152,6 +154,14 @@ namespace nerd {
 	}
 
 
+	/**
+	 * The weight and topology changes are drawn from the global random number generator.
+	 */
+	bool ModulatingModulatedRandomSearchSynapseFunction::isThreadSafe() const {
+		return false;
+	}
+
+
 	/**
 	 * If the main parameters have been changed, then the internal settings are updated
 	 * to fit the new settings.
@@ -743,13 +753,9 @@ namespace nerd {
 			return 0;
 		}
 		
-		bool ok = true;
-		int countDisables = owner->getProperty("MRS-D").toInt(&ok);
-		if(!ok) {
-			countDisables = 0;
-		}
-		countDisables++;
-		owner->setProperty("MRS-D", QString::number(countDisables));
+		addStateSlots(owner);
+		int countDisables = ((int) owner->getStateValue(mDisableCounterSlot)) + 1;
+		owner->setStateValue(mDisableCounterSlot, countDisables);
 		
 		return countDisables;
 	}
@@ -765,13 +771,9 @@ namespace nerd {
 			return 0;
 		}
 		
-		bool ok = true;
-		int countChanges = owner->getProperty("MRS-M").toInt(&ok);
-		if(!ok) {
-			countChanges = 0;
-		}
-		countChanges++;
-		owner->setProperty("MRS-M", QString::number(countChanges));
+		addStateSlots(owner);
+		int countChanges = ((int) owner->getStateValue(mWeightChangeCounterSlot)) + 1;
+		owner->setStateValue(mWeightChangeCounterSlot, countChanges);
 		
 		return countChanges;
 	}
@@ -779,10 +781,10 @@ namespace nerd {
 	
 	/**
 	 * When a synapse is disabled, then its weigth is set to 0.0 (to allow cloning synapses to disable as well)
-	 * and stored as property. When the synapse is enabled again, then that stored value is recovered (if present).
+	 * and stored in a state slot (property _SMRS_w). When the synapse is enabled again, then that stored 
+	 * value is recovered (if present).
 	 * 
-	 * Note: Because of the conversions, the accuracy of the disabled synapse may change. But this is usually not
-	 * a problem. 
+	 * Note: The stored weight is only written to the property when the network is saved.
 	 */
 	void ModulatingModulatedRandomSearchSynapseFunction::enableWeight(Synapse *owner, bool enable) {
 		if(owner == 0) {
@@ -790,28 +792,41 @@ namespace nerd {
 		}
 		
 		
+		addStateSlots(owner);
+		
 		if(enable) {
-			bool ok = true;
-			
-			double oldWeight = owner->getProperty("_SMRS_w").toDouble(&ok);
-			
-			if(ok) {
-				owner->getStrengthValue().set(oldWeight);
+			if(owner->hasStateValue(mStoredWeightSlot)) {
+				owner->getStrengthValue().set(owner->getStateValue(mStoredWeightSlot));
 			}
 			owner->removeProperty(NeuralNetworkConstants::TAG_ELEMENT_DRAW_AS_DISABLED);
-			owner->removeProperty("_SMRS_w");
+			owner->clearStateValue(mStoredWeightSlot);
 		}
 		else {
-			if(!owner->hasProperty("_SMRS_w")) {
+			if(!owner->hasStateValue(mStoredWeightSlot)) {
 				double currentWeight = owner->getStrengthValue().get();
 				owner->getStrengthValue().set(0.0);
-				owner->setProperty("_SMRS_w", QString::number(currentWeight));
+				owner->setStateValue(mStoredWeightSlot, currentWeight);
 			}
 			owner->setProperty(NeuralNetworkConstants::TAG_ELEMENT_DRAW_AS_DISABLED);
 		}
 		mActive->set(enable);
 		
 	}
+
+	
+	/**
+	 * Adds the state slots for the change counters and the stored weight to the owner
+	 * synapse. The slot indices are cached as long as the owner does not change.
+	 */
+	void ModulatingModulatedRandomSearchSynapseFunction::addStateSlots(Synapse *owner) {
+		if(owner == mStateOwner) {
+			return;
+		}
+		mStateOwner = owner;
+		mDisableCounterSlot = owner->addStateSlot("MRS-D");
+		mWeightChangeCounterSlot = owner->addStateSlot("MRS-M");
+		mStoredWeightSlot = owner->addStateSlot("_SMRS_w");
+	}
 	
 	
 }
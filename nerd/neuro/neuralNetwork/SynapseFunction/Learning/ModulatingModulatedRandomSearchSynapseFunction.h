@@ -102,6 +102,7 @@ namespace nerd {
 		virtual ~ModulatingModulatedRandomSearchSynapseFunction();
 
 		virtual SynapseFunction* createCopy() const;
+		virtual bool isThreadSafe() const;
 
 		virtual void valueChanged(Value *value);
 
@@ -127,6 +128,7 @@ namespace nerd {
 		int incrementWeightChangeCounter(Synapse *owner);
 		
 		void enableWeight(Synapse *owner, bool enable = true);
+		void addStateSlots(Synapse *owner);
 
 	private:
 		Synapse *mOwner;
@@ -153,6 +155,11 @@ namespace nerd {
 		int mNumberOfStepsWithoutModulators;
 		
 		
+
+		Synapse *mStateOwner;
+		int mDisableCounterSlot;
+		int mWeightChangeCounterSlot;
+		int mStoredWeightSlot;
 	};
 	
 }
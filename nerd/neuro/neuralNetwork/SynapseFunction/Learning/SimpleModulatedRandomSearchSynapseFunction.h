@@ -76,6 +76,7 @@ namespace nerd {
 		virtual ~SimpleModulatedRandomSearchSynapseFunction();
 
 		virtual SynapseFunction* createCopy() const;
+		virtual bool isThreadSafe() const;
 
 		virtual void valueChanged(Value *value);
 
@@ -97,6 +98,7 @@ namespace nerd {
 		int incrementWeightChangeCounter(Synapse *owner);
 		
 		void enableWeight(Synapse *owner, bool enable = true);
+		void addStateSlots(Synapse *owner);
 
 		///// KK
 		virtual double boxMullerMethod(double var);
@@ -127,6 +129,11 @@ namespace nerd {
 		///// KK
 		bool mChangedThisStep;
 		/////
+
+		Synapse *mStateOwner;
+		int mDisableCounterSlot;
+		int mWeightChangeCounterSlot;
+		int mStoredWeightSlot;
 	};
 	
 }
@@ -140,6 +140,11 @@ SynapseFunction* ScriptableSynapseFunction::createCopy() const {
 	return new ScriptableSynapseFunction(*this);
 }
 
+
+bool ScriptableSynapseFunction::isThreadSafe() const {
+	return false;
+}
+
 QString ScriptableSynapseFunction::getName() const {
 	return NeuroModulatorSynapseFunction::getName();
 }
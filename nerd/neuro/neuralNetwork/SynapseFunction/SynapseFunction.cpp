@@ -68,6 +68,15 @@ double SynapseFunction::calculate(Synapse *owner) {
 }
 
 
+/**
+ * Returns false if calculate() uses global state, e.g. random weight changes.
+ * See ActivationFunction::isThreadSafe().
+ */
+bool SynapseFunction::isThreadSafe() const {
+	return true;
+}
+
+
 bool SynapseFunction::equals(SynapseFunction *synapseFunction) const {
 	return ParameterizedObject::equals(synapseFunction);
 }
@@ -65,6 +65,7 @@ namespace nerd {
 		
 		virtual void reset(Synapse *owner) = 0;
 		virtual double calculate(Synapse *owner);
+		virtual bool isThreadSafe() const;
 
 		bool equals(SynapseFunction *synapseFunction) const;
 		
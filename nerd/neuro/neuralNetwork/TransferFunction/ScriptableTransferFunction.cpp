@@ -126,6 +126,11 @@ TransferFunction* ScriptableTransferFunction::createCopy() const {
 	return new ScriptableTransferFunction(*this);
 }
 
+
+bool ScriptableTransferFunction::isThreadSafe() const {
+	return false;
+}
+
 QString ScriptableTransferFunction::getName() const {
 	return TransferFunction::getName();
 }
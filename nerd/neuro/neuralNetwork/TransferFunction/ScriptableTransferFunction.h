@@ -72,6 +72,7 @@ class RangeValue;
 		virtual ~ScriptableTransferFunction();
 
 		virtual TransferFunction* createCopy() const;
+		virtual bool isThreadSafe() const;
 		virtual QString getName() const;
 		virtual void valueChanged(Value *value);
 		
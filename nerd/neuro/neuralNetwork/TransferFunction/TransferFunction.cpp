@@ -73,6 +73,34 @@ double TransferFunction::getUpperBound() const {
 	return mUpperBound;
 }
 
+
+/**
+ * Returns false if the transfer uses global state. See ActivationFunction::isThreadSafe().
+ */
+bool TransferFunction::isThreadSafe() const {
+	return true;
+}
+
+/**
+ * Transfers count activations at once with the parameters of this TransferFunction.
+ * The default implementation calls transferActivation() for each element, so
+ * functions depending on their owner neuron keep working.
+ * 
+ * @param activations the input activations.
+ * @param outputs the array receiving the count results (may be the same as activations).
+ * @param count the number of activations.
+ * @param owners optional array with the owner neuron of each activation (may be 0).
+ * @param accuracy the requested accuracy (see class description).
+ */
+void TransferFunction::transferActivations(const double *activations, double *outputs, 
+						int count, Neuron **owners, BatchAccuracy)
+{
+	for(int i = 0; i < count; ++i) {
+		outputs[i] = transferActivation(activations[i], owners == 0 ? 0 : owners[i]);
+	}
+}
+
+
 bool TransferFunction::equals(TransferFunction *transferFunction) const {
 	if(ParameterizedObject::equals(transferFunction) == false) {
 		return false;
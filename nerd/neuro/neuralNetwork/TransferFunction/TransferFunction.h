@@ -47,6 +47,8 @@
 
 #include "Core/ParameterizedObject.h"
 #include "Network/ObservableNetworkElement.h"
+#include <string.h>
+#include <math.h>
 
 namespace nerd {
 
@@ -54,8 +56,25 @@ namespace nerd {
 
 	/**
 	 * TransferFunction
+	 *
+	 * Besides the scalar transferActivation(), a TransferFunction provides the batch
+	 * method transferActivations(), which transfers a whole block of activations with
+	 * the parameters of this function. The default implementation simply loops over 
+	 * transferActivation(). Stateless standard functions override it with tight loops
+	 * (parameters read once, no virtual calls) that the compiler can vectorize.
+	 *
+	 * The accuracy of a batch can be selected:
+	 * - ACCURACY_EXACT: results are identical to transferActivation().
+	 * - ACCURACY_FAST: exp() is replaced by a polynomial approximation 
+	 *                  (relative error below 1e-12), where this is supported.
+	 * - ACCURACY_FIRMWARE: functions with a robot firmware counterpart use the
+	 *                  fixed point lookup table of that firmware.
+	 * Functions that do not support a mode fall back to ACCURACY_EXACT.
 	 */
 	class TransferFunction : public ParameterizedObject, public virtual ObservableNetworkElement  {
+	public:
+		enum BatchAccuracy {ACCURACY_EXACT, ACCURACY_FAST, ACCURACY_FIRMWARE};
+
 	public:
 		TransferFunction(const QString &name, double lowerBound, double upperBound);
 		TransferFunction(const TransferFunction &other);
@@ -65,17 +84,43 @@ namespace nerd {
 
 		virtual void reset(Neuron *owner) = 0;
 		virtual double transferActivation(double activation, Neuron *owner) = 0;
+		virtual void transferActivations(const double *activations, double *outputs, int count,
+						Neuron **owners = 0, BatchAccuracy accuracy = ACCURACY_EXACT);
 
 		virtual double getLowerBound() const;
 		virtual double getUpperBound() const;
+		virtual bool isThreadSafe() const;
 		
 		bool equals(TransferFunction *transferFunction) const;
 		
+		static inline double fastExp(double x);
+
 	protected:		
 		double mLowerBound;
 		double mUpperBound;
 	};
 
+
+	/**
+	 * Approximates exp(x) with a range reduction to [-ln2/2, ln2/2] and a 
+	 * polynomial of degree 11. The function is free of branches, so loops 
+	 * calling it can be vectorized. Arguments are clamped to [-708, 708].
+	 */
+	inline double TransferFunction::fastExp(double x) {
+		x = x < -708.0 ? -708.0 : (x > 708.0 ? 708.0 : x);
+		double n = floor((x * 1.4426950408889634) + 0.5);
+		double r = (x - (n * 0.693147180369123816490)) - (n * 1.90821492927058770002e-10);
+		double p = 1.0 + r * (1.0 + r * (1.0 / 2.0 + r * (1.0 / 6.0 + r * (1.0 / 24.0 
+					+ r * (1.0 / 120.0 + r * (1.0 / 720.0 + r * (1.0 / 5040.0 
+					+ r * (1.0 / 40320.0 + r * (1.0 / 362880.0 + r * (1.0 / 3628800.0 
+					+ r * (1.0 / 39916800.0)))))))))));
+		//scale by 2^n by writing n directly into the exponent bits.
+		qint64 bits = ((qint64) n + 1023) << 52;
+		double scale;
+		memcpy(&scale, &bits, sizeof(double));
+		return p * scale;
+	}
+
 }
 
 #endif
@@ -85,6 +85,27 @@ const int16_t TransferFunctionASeriesTanh::mDeltas[] = {
 	   5,      4,     3,     2,     2,     1,     1,     1,    2 };
 
 double TransferFunctionASeriesTanh::transferActivation(double activation, Neuron*) {
+	return lookupTanh(activation);
+}
+
+
+/**
+ * Batch version of transferActivation(). The result always corresponds to the
+ * A-Series firmware, independently of the requested accuracy.
+ */
+void TransferFunctionASeriesTanh::transferActivations(const double *activations, double *outputs, 
+						int count, Neuron**, BatchAccuracy)
+{
+	for(int i = 0; i < count; ++i) {
+		outputs[i] = lookupTanh(activations[i]);
+	}
+}
+
+
+/**
+ * Calculates the tanh with the fixed point lookup table of the A-Series firmware.
+ */
+double TransferFunctionASeriesTanh::lookupTanh(double activation) {
 	// get the 8.24 fixed point value of the activation
 	int32_t fpActivation = ASeriesFunctions::doubleToFixedPoint_8_24(activation);
 	int16_t index, fpResult;
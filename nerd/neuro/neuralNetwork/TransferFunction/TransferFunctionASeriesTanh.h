@@ -63,6 +63,10 @@ namespace nerd {
 
 		virtual void reset(Neuron *owner);
 		virtual double transferActivation(double activation, Neuron *owner);
+		virtual void transferActivations(const double *activations, double *outputs, int count,
+						Neuron **owners = 0, BatchAccuracy accuracy = ACCURACY_EXACT);
+
+		static double lookupTanh(double activation);
 
 		bool equals(TransferFunction *transferFunction) const;
 		
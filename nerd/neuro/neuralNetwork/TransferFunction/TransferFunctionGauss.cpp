@@ -110,6 +110,40 @@ double TransferFunctionGauss::transferActivation(double activation, Neuron*) {
 			* exp(-1 * ((activation * activation) / (2 * sigma * sigma)))) - mShift->get();
 }
 
+
+/**
+ * Batch version of transferActivation(). With ACCURACY_FAST exp() is replaced
+ * by the polynomial approximation TransferFunction::fastExp().
+ */
+void TransferFunctionGauss::transferActivations(const double *activations, double *outputs, 
+						int count, Neuron**, BatchAccuracy accuracy)
+{
+	double sigma = mDeviation->get();
+	
+	//avoid division by zero.
+	if(sigma == 0) {
+		for(int i = 0; i < count; ++i) {
+			outputs[i] = 0.0;
+		}
+		return;
+	}
+	double factor = (1.0 / (sqrt(2 * Math::PI) * sigma));
+	double divisor = (2 * sigma * sigma);
+	double shift = mShift->get();
+
+	if(accuracy == ACCURACY_FAST) {
+		for(int i = 0; i < count; ++i) {
+			double activation = activations[i];
+			outputs[i] = (factor * fastExp(-1 * ((activation * activation) / divisor))) - shift;
+		}
+		return;
+	}
+	for(int i = 0; i < count; ++i) {
+		double activation = activations[i];
+		outputs[i] = (factor * exp(-1 * ((activation * activation) / divisor))) - shift;
+	}
+}
+
 bool TransferFunctionGauss::equals(TransferFunction *transferFunction) const {
 	if(TransferFunction::equals(transferFunction) == false) {
 		return false;
@@ -68,6 +68,8 @@ namespace nerd {
 
 		virtual void reset(Neuron *owner);
 		virtual double transferActivation(double activation, Neuron *owner);
+		virtual void transferActivations(const double *activations, double *outputs, int count,
+						Neuron **owners = 0, BatchAccuracy accuracy = ACCURACY_EXACT);
 		
 		bool equals(TransferFunction *transferFunction) const;
 
@@ -91,7 +91,27 @@ void TransferFunctionMSeriesTanh::reset(Neuron*) {
 
 
 double TransferFunctionMSeriesTanh::transferActivation(double activation, Neuron*) {
+	return lookupTanh(activation);
+}
+
+
+/**
+ * Batch version of transferActivation(). The result always corresponds to the
+ * M-Series firmware, independently of the requested accuracy.
+ */
+void TransferFunctionMSeriesTanh::transferActivations(const double *activations, double *outputs, 
+						int count, Neuron**, BatchAccuracy)
+{
+	for(int i = 0; i < count; ++i) {
+		outputs[i] = lookupTanh(activations[i]);
+	}
+}
+
 
+/**
+ * Calculates the tanh with the fixed point lookup table of the M-Series firmware.
+ */
+double TransferFunctionMSeriesTanh::lookupTanh(double activation) {
 	// get the 17.15 fixed point value of the activation
 	int32_t fpActivation = MSeriesFunctions::doubleToFixedPoint_17_15(activation);
 	int16_t index;
@@ -103,6 +103,28 @@ double TransferFunctionParameterizedSigmoid::transferActivation(double activatio
 	return (1.0 / (1 + ::exp((-(mSteepness->get()) * activation) + mShift->get())));
 }
 
+
+/**
+ * Batch version of transferActivation(). With ACCURACY_FAST exp() is replaced
+ * by the polynomial approximation TransferFunction::fastExp().
+ */
+void TransferFunctionParameterizedSigmoid::transferActivations(const double *activations, double *outputs, 
+						int count, Neuron**, BatchAccuracy accuracy)
+{
+	double steepness = -(mSteepness->get());
+	double shift = mShift->get();
+
+	if(accuracy == ACCURACY_FAST) {
+		for(int i = 0; i < count; ++i) {
+			outputs[i] = (1.0 / (1 + fastExp((steepness * activations[i]) + shift)));
+		}
+		return;
+	}
+	for(int i = 0; i < count; ++i) {
+		outputs[i] = (1.0 / (1 + ::exp((steepness * activations[i]) + shift)));
+	}
+}
+
 bool TransferFunctionParameterizedSigmoid::equals(TransferFunction *transferFunction) const {
 	if(TransferFunction::equals(transferFunction) == false) {
 		return false;
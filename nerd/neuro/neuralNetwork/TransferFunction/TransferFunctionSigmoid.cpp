@@ -93,6 +93,25 @@ double TransferFunctionSigmoid::transferActivation(double activation, Neuron*) {
 	return (1.0 / (1 + ::exp(-1 * activation)));
 }
 
+
+/**
+ * Batch version of transferActivation(). With ACCURACY_FAST exp() is replaced
+ * by the polynomial approximation TransferFunction::fastExp().
+ */
+void TransferFunctionSigmoid::transferActivations(const double *activations, double *outputs, 
+						int count, Neuron**, BatchAccuracy accuracy)
+{
+	if(accuracy == ACCURACY_FAST) {
+		for(int i = 0; i < count; ++i) {
+			outputs[i] = (1.0 / (1 + fastExp(-1 * activations[i])));
+		}
+		return;
+	}
+	for(int i = 0; i < count; ++i) {
+		outputs[i] = (1.0 / (1 + ::exp(-1 * activations[i])));
+	}
+}
+
 bool TransferFunctionSigmoid::equals(TransferFunction *transferFunction) const {
 	if(TransferFunction::equals(transferFunction) == false) {
 		return false;
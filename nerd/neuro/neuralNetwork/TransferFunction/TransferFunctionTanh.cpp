@@ -42,6 +42,7 @@
  ***************************************************************************/
 
 #include "TransferFunctionTanh.h"
+#include "TransferFunction/TransferFunctionMSeriesTanh.h"
 #include <math.h>
 #include <iostream>
 
@@ -81,6 +82,35 @@ double TransferFunctionTanh::transferActivation(double activation, Neuron*) {
 	return (2.0 / raw) - 1;
 }
 
+
+/**
+ * Batch version of transferActivation(). With ACCURACY_FAST exp() is replaced
+ * by the polynomial approximation TransferFunction::fastExp(), with ACCURACY_FIRMWARE
+ * the fixed point lookup table of the M-Series firmware is used.
+ */
+void TransferFunctionTanh::transferActivations(const double *activations, double *outputs, 
+						int count, Neuron**, BatchAccuracy accuracy)
+{
+	if(accuracy == ACCURACY_FIRMWARE) {
+		for(int i = 0; i < count; ++i) {
+			outputs[i] = TransferFunctionMSeriesTanh::lookupTanh(activations[i]);
+		}
+		return;
+	}
+	if(accuracy == ACCURACY_FAST) {
+		//the denominator of the fast version can not become 0.
+		for(int i = 0; i < count; ++i) {
+			outputs[i] = (2.0 / (fastExp(-2 * activations[i]) + 1)) - 1;
+		}
+		return;
+	}
+	for(int i = 0; i < count; ++i) {
+		double raw = (pow(M_E, -2 * activations[i]) + 1);
+		//avoid division by zero
+		outputs[i] = (raw == 0.0) ? -1.0 : ((2.0 / raw) - 1);
+	}
+}
+
 bool TransferFunctionTanh::equals(TransferFunction *transferFunction) const {
 	if(TransferFunction::equals(transferFunction) == false) {
 		return false;
@@ -48,6 +48,9 @@
 #include "Value/DoubleValue.h"
 #include "ActivationFunction/AdditiveTimeDiscreteActivationFunction.h"
 #include "ActivationFunction/ASeriesActivationFunction.h"
+#include "ActivationFunction/DelayLineActivationFunction.h"
+#include "NeuralNetworkConstants.h"
+#include "Value/IntValue.h"
 #include "ActivationFunction/ActivationFunctionAdapter.h"
 #include "Network/Neuron.h"
 #include "TransferFunction/TransferFunctionAdapter.h"
@@ -235,3 +238,68 @@ void TestActivationFunction::testObservableParameters() {
 	QVERIFY(afa.getObservableOutputNames().size() == 4);
 	QVERIFY(afa.getObservableOutputNames().contains("Value5") == false);
 }
+
+
+void TestActivationFunction::testDelayLineActivationFunction() {
+	DelayLineActivationFunction af;
+	QVERIFY(dynamic_cast<IntValue*>(af.getParameter("Delay"))->get() == 2);
+
+	Neuron source1("Source1", TransferFunctionAdapter("", 0.0, 1.0), af);
+	Neuron source2("Source2", TransferFunctionAdapter("", 0.0, 1.0), af);
+	Neuron n("Neuron1", TransferFunctionAdapter("", 0.0, 1.0), af);
+	ActivationFunction *delayLine = n.getActivationFunction();
+
+	Synapse *s1 = new Synapse(&source1, &n, 1.0, SimpleSynapseFunction());
+	Synapse *s2 = new Synapse(&source2, &n, 0.5, SimpleSynapseFunction());
+	s2->setProperty(NeuralNetworkConstants::TAG_SYNAPSE_DELAY, "3");
+	QVERIFY(n.addSynapse(s1));
+	QVERIFY(n.addSynapse(s2));
+
+	//an impulse at step 0 arrives after 2 steps (s1) and after 2 + 3 steps (s2).
+	double expected[] = {0.0, 0.0, 1.0, 0.0, 0.0, 5.0, 0.0, 0.0};
+	source1.getOutputActivationValue().set(1.0);
+	source2.getOutputActivationValue().set(10.0);
+	source1.prepare();
+	source2.prepare();
+	for(int i = 0; i < 8; ++i) {
+		QVERIFY(Math::compareDoubles(delayLine->calculateActivation(&n), expected[i], 0.000001));
+		source1.getOutputActivationValue().set(0.0);
+		source2.getOutputActivationValue().set(0.0);
+		source1.prepare();
+		source2.prepare();
+	}
+
+	//without s2 the delay line is shortened, the bias is delayed as well.
+	QVERIFY(n.removeSynapse(s2));
+	delete s2;
+	n.getBiasValue().set(0.25);
+	source1.getOutputActivationValue().set(2.0);
+	source1.prepare();
+	double expected2[] = {0.0, 0.0, 2.25, 0.25, 0.25};
+	for(int i = 0; i < 5; ++i) {
+		QVERIFY(Math::compareDoubles(delayLine->calculateActivation(&n), expected2[i], 0.000001));
+		source1.getOutputActivationValue().set(0.0);
+		source1.prepare();
+	}
+
+	//a reset clears the delay line.
+	n.getBiasValue().set(0.0);
+	delayLine->reset(&n);
+	QVERIFY(delayLine->calculateActivation(&n) == 0.0);
+	QVERIFY(delayLine->calculateActivation(&n) == 0.0);
+	QVERIFY(delayLine->calculateActivation(&n) == 0.0);
+
+	//a changed synapse delay is taken over without a reset.
+	int revision = n.getSynapseRevision();
+	s1->setProperty(NeuralNetworkConstants::TAG_SYNAPSE_DELAY, "1");
+	QVERIFY(n.getSynapseRevision() != revision);
+	source1.getOutputActivationValue().set(1.0);
+	source1.prepare();
+	double expected3[] = {0.0, 0.0, 0.0, 1.0, 0.0};
+	for(int i = 0; i < 5; ++i) {
+		QVERIFY(Math::compareDoubles(delayLine->calculateActivation(&n), expected3[i], 0.000001));
+		source1.getOutputActivationValue().set(0.0);
+		source1.prepare();
+	}
+}
+
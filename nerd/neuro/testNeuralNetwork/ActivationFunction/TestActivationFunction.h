@@ -61,6 +61,7 @@ private slots:
 	void testAdditiveTimeDiscreteActivationFunction();
 	void testASeriesActivationFunction();
 	void testObservableParameters();
+	void testDelayLineActivationFunction();
 
 private:
 	
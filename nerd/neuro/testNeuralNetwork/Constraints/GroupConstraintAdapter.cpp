@@ -51,7 +51,8 @@ GroupConstraintAdapter::GroupConstraintAdapter(const QString &name,
 		mElementIdChangedOldId(0), mElementIdChangedNewId(0),
 		mValidityCounter(true), mValidityReturnValue(0), 
 		mApplyConstraintCounter(0), mApplyReturnValue(true),
-		mNumberOfRequiredElements(0), mLastOwner(0), mDestroyFlag(destroyFlag)
+		mNumberOfRequiredElements(0), mLastOwner(0), mDestroyFlag(destroyFlag),
+		mUseGroupDependencies(false)
 {
 }
 
@@ -62,7 +63,8 @@ GroupConstraintAdapter::GroupConstraintAdapter(const GroupConstraintAdapter &oth
 		mElementIdChangedOldId(0), mElementIdChangedNewId(0),
 		mValidityCounter(true), mValidityReturnValue(0), 
 		mApplyConstraintCounter(0), mApplyReturnValue(true),
-		mNumberOfRequiredElements(0), mLastOwner(0), mDestroyFlag(0)
+		mNumberOfRequiredElements(0), mLastOwner(0), mDestroyFlag(0),
+		mUseGroupDependencies(other.mUseGroupDependencies)
 {
 }
 
@@ -114,6 +116,24 @@ bool GroupConstraintAdapter::applyConstraint(NeuronGroup *owner, CommandExecutor
 	return mApplyReturnValue;
 }
 
+
+bool GroupConstraintAdapter::getDependencies(NeuronGroup *owner, 
+											QList<NeuralNetworkElement*> &elements)
+{
+	if(!mUseGroupDependencies) {
+		return false;
+	}
+	GroupConstraint::addGroupDependencies(owner, elements);
+	return true;
+}
+
+
+void GroupConstraintAdapter::getConstraintDependencies(NeuronGroup*, 
+											QList<GroupConstraint*> &constraints)
+{
+	constraints << mConstraintDependencies;
+}
+
 }
 
 
@@ -69,6 +69,8 @@ namespace nerd {
 		virtual bool isValid(NeuronGroup *owner);
 		virtual bool applyConstraint(NeuronGroup *owner, CommandExecutor *executor,
 									QList<NeuralNetworkElement*> &trashcan);
+		virtual bool getDependencies(NeuronGroup *owner, QList<NeuralNetworkElement*> &elements);
+		virtual void getConstraintDependencies(NeuronGroup *owner, QList<GroupConstraint*> &constraints);
 
 		
 	public:
@@ -82,6 +84,8 @@ namespace nerd {
 		int mNumberOfRequiredElements;
 		NeuronGroup *mLastOwner;
 		bool *mDestroyFlag;
+		bool mUseGroupDependencies;
+		QList<GroupConstraint*> mConstraintDependencies;
 	};
 
 }
@@ -57,6 +57,8 @@
 #include "ModularNeuralNetwork/NeuroModule.h"
 #include "NeuralNetworkConstants.h"
 #include "ModularNeuralNetwork/ModularNeuralNetwork.h"
+#include "Constraints/ConstraintResolver.h"
+#include "Constraints/GroupConstraintAdapter.h"
 
 #define QV QVERIFY
 #define QC QCOMPARE
@@ -692,3 +694,153 @@ void TestSymmetryConstraint::testGetElementMatching() {
 
 	delete net;
 }
+
+
+void TestSymmetryConstraint::testConstraintResolver() {
+	NeuronGroup *group1 = new NeuronGroup("Group1", 101);
+	NeuronGroup *group2 = new NeuronGroup("Group2", 102);
+
+	Neuron *n1 = new Neuron("N1", TransferFunctionAdapter("TF1", 0.0, 1.0), 
+							ActivationFunctionAdapter("AF1"), 1001);
+	Neuron *n2 = new Neuron("N2", TransferFunctionAdapter("TF1", 0.0, 1.0), 
+							ActivationFunctionAdapter("AF1"), 1002);
+	group1->addNeuron(n1);
+	group2->addNeuron(n2);
+
+	ModularNeuralNetwork *net = new ModularNeuralNetwork();
+	net->addNeuronGroup(group1);
+	net->addNeuronGroup(group2);
+	net->addNeuron(n1);
+	net->addNeuron(n2);
+
+	GroupConstraintAdapter *local1 = new GroupConstraintAdapter("Local1", 0);
+	GroupConstraintAdapter *local2 = new GroupConstraintAdapter("Local2", 0);
+	GroupConstraintAdapter *global = new GroupConstraintAdapter("Global", 0);
+	local1->mUseGroupDependencies = true;
+	local2->mUseGroupDependencies = true;
+	group1->addConstraint(local1);
+	group1->addConstraint(global);
+	group2->addConstraint(local2);
+
+	QList<NeuronGroup*> groups = net->getNeuronGroups();
+	QList<NeuralNetworkElement*> trashcan;
+
+	ConstraintResolver resolver;
+	resolver.setMaxNumberOfIterations(5);
+	resolver.setSkipResolvedConstraints(true);
+
+	//first run: all constraints are applied once.
+	QVERIFY(resolver.resolve(groups, 0, trashcan) == true);
+	QCOMPARE(resolver.getNumberOfIterations(), 1);
+	QCOMPARE(local1->mApplyConstraintCounter, 1);
+	QCOMPARE(local2->mApplyConstraintCounter, 1);
+	QCOMPARE(global->mApplyConstraintCounter, 1);
+	QVERIFY(local1->getResolvedSignature() != 0);
+	QVERIFY(local2->getResolvedSignature() != 0);
+	QVERIFY(global->getResolvedSignature() == 0);
+
+	//unchanged network: only the global constraint is applied.
+	QVERIFY(resolver.resolve(groups, 0, trashcan) == true);
+	QCOMPARE(resolver.getNumberOfSkippedConstraints(), 2);
+	QCOMPARE(local1->mApplyConstraintCounter, 1);
+	QCOMPARE(local2->mApplyConstraintCounter, 1);
+	QCOMPARE(global->mApplyConstraintCounter, 2);
+
+	//a change in group2 only affects the constraints depending on group2.
+	n2->getBiasValue().set(0.5);
+	QVERIFY(resolver.resolve(groups, 0, trashcan) == true);
+	QCOMPARE(local1->mApplyConstraintCounter, 1);
+	QCOMPARE(local2->mApplyConstraintCounter, 2);
+	QCOMPARE(global->mApplyConstraintCounter, 3);
+
+	//temporary resolver tags do not change the signature.
+	n1->setProperty(NeuralNetworkConstants::TAG_ELEMENT_REDUCED_DEGREES_OF_FREEDOM, "B");
+	QVERIFY(resolver.resolve(groups, 0, trashcan) == true);
+	QCOMPARE(local1->mApplyConstraintCounter, 1);
+
+	//failing constraints are applied in each iteration and invalidate the signature.
+	n1->getBiasValue().set(0.2);
+	local1->mApplyReturnValue = false;
+	QVERIFY(resolver.resolve(groups, 0, trashcan) == false);
+	QCOMPARE(resolver.getNumberOfIterations(), 5);
+	QCOMPARE(local1->mApplyConstraintCounter, 6);
+	QCOMPARE(local2->mApplyConstraintCounter, 2);
+	QVERIFY(local1->getResolvedSignature() == 0);
+	QVERIFY(resolver.getErrors().contains("Local1: "));
+
+	//without skipping, all constraints are applied again.
+	local1->mApplyReturnValue = true;
+	resolver.setSkipResolvedConstraints(false);
+	QVERIFY(resolver.resolve(groups, 0, trashcan) == true);
+	QCOMPARE(local1->mApplyConstraintCounter, 7);
+	QCOMPARE(local2->mApplyConstraintCounter, 3);
+
+	delete net;
+}
+
+
+//Changes of the pair lists of other SymmetryConstraints have to be detected by the resolver.
+void TestSymmetryConstraint::testConstraintDependencies() {
+	NeuronGroup *group1 = new NeuronGroup("Group1", 101);
+	NeuronGroup *group2 = new NeuronGroup("Group2", 102);
+	NeuronGroup *group3 = new NeuronGroup("Group3", 103);
+
+	Neuron *n1 = new Neuron("N1", TransferFunctionAdapter("TF1", 0.0, 1.0), 
+							ActivationFunctionAdapter("AF1"), 1001);
+	Neuron *n2 = new Neuron("N2", TransferFunctionAdapter("TF1", 0.0, 1.0), 
+							ActivationFunctionAdapter("AF1"), 1002);
+	group1->addNeuron(n1);
+	group2->addNeuron(n2);
+
+	ModularNeuralNetwork *net = new ModularNeuralNetwork();
+	net->addNeuronGroup(group1);
+	net->addNeuronGroup(group2);
+	net->addNeuronGroup(group3);
+	net->addNeuron(n1);
+	net->addNeuron(n2);
+
+	SymmetryConstraint *sc2 = new SymmetryConstraint();
+	sc2->getTargetGroupIdValue()->set(103);
+	group2->addConstraint(sc2);
+	SymmetryConstraint *sc3 = new SymmetryConstraint();
+	sc3->getTargetGroupIdValue()->set(102);
+	group3->addConstraint(sc3);
+
+	//a SymmetryConstraint reads the pair lists of all other SymmetryConstraints.
+	QList<GroupConstraint*> dependencies;
+	sc2->getConstraintDependencies(group2, dependencies);
+	QCOMPARE(dependencies.size(), 1);
+	QVERIFY(dependencies.contains(sc3));
+
+	GroupConstraintAdapter *local1 = new GroupConstraintAdapter("Local1", 0);
+	local1->mUseGroupDependencies = true;
+	local1->mConstraintDependencies.append(sc2);
+	group1->addConstraint(local1);
+
+	//only group1 is resolved, so sc2 and sc3 are never applied.
+	QList<NeuronGroup*> groups;
+	groups.append(group1);
+	QList<NeuralNetworkElement*> trashcan;
+
+	ConstraintResolver resolver;
+	resolver.setMaxNumberOfIterations(5);
+	resolver.setSkipResolvedConstraints(true);
+
+	QVERIFY(resolver.resolve(groups, 0, trashcan) == true);
+	QCOMPARE(local1->mApplyConstraintCounter, 1);
+	QVERIFY(resolver.resolve(groups, 0, trashcan) == true);
+	QCOMPARE(resolver.getNumberOfSkippedConstraints(), 1);
+	QCOMPARE(local1->mApplyConstraintCounter, 1);
+
+	//editing the pair string of the other group re-applies the constraint.
+	sc2->getNetworkElementPairValue()->set("1001,1002");
+	QVERIFY(resolver.resolve(groups, 0, trashcan) == true);
+	QCOMPARE(resolver.getNumberOfSkippedConstraints(), 0);
+	QCOMPARE(local1->mApplyConstraintCounter, 2);
+
+	QVERIFY(resolver.resolve(groups, 0, trashcan) == true);
+	QCOMPARE(local1->mApplyConstraintCounter, 2);
+
+	delete net;
+}
+
@@ -64,6 +64,8 @@ private slots:
 	void testSetElementPosition();
 	void testModulePositionRecursively();
 	void testGetElementMatching();
+	void testConstraintResolver();
+	void testConstraintDependencies();
 
 private:
 	
@@ -57,10 +57,48 @@
 #include "SynapseFunction/SimpleSynapseFunction.h"
 #include "Control/ControlInterfaceAdapter.h"
 #include "Network/NeuralNetworkAdapter.h"
+#include "TransferFunction/TransferFunctionSigmoid.h"
+#include "TransferFunction/TransferFunctionNeutral.h"
+#include "Learning/Backpropagation/DenseNetworkTrainer.h"
+#include "Math/Math.h"
+#include "NeuralNetworkConstants.h"
+#include "Network/NeuralNetworkExecutionPool.h"
+#include "TransferFunction/TransferFunctionThreshold.h"
+#include "ActivationFunction/Izhikevitch2003SpikingActivationFunction.h"
+#include "ActivationFunction/SignalGeneratorActivationFunction.h"
+#include "Math/Random.h"
+#include "Network/SpikingEventEngine.h"
+#include "Value/ValueChangedListener.h"
+#include <QThread>
 
 using namespace std;
 using namespace nerd;
 
+
+//Counts the notifications and remembers whether one of them came from another thread.
+class ThreadCheckingListener : public ValueChangedListener {
+public:
+	ThreadCheckingListener() 
+		: mThread(QThread::currentThread()), mNumberOfNotifications(0), 
+		  mNotifiedInOtherThread(false) 
+	{
+	}
+	virtual void valueChanged(Value*) {
+		mNumberOfNotifications++;
+		if(QThread::currentThread() != mThread) {
+			mNotifiedInOtherThread = true;
+		}
+	}
+	virtual QString getName() const {
+		return "ThreadCheckingListener";
+	}
+
+	QThread *mThread;
+	int mNumberOfNotifications;
+	bool mNotifiedInOtherThread;
+};
+
+
 void TestNeuralNetwork::initTestCase() {
 }
 
@@ -364,6 +402,46 @@ void TestNeuralNetwork::testExecution() {
 	QCOMPARE(n1->mPrepareCounter, 2);
 	QCOMPARE(n2->mPrepareCounter, 2);
 
+	//the execution schedule follows changes of the iteration settings.
+	n2->setProperty(NeuralNetworkConstants::TAG_NEURON_ORDER_DEPENDENT, "1");
+	QCOMPARE(n2->getStartIteration(), 1);
+	nn1.executeStep();
+
+	QCOMPARE(n1->mUpdateActivationCounter, 2);
+	QCOMPARE(n2->mUpdateActivationCounter, 2);
+	QCOMPARE(n1->mPrepareCounter, 4);
+	QCOMPARE(n2->mPrepareCounter, 4);
+
+	n2->setProperty(NeuralNetworkConstants::TAG_NEURON_ORDER_DEPENDENT, "0,2");
+	QCOMPARE(n2->getRequiredIterations(), 2);
+	nn1.executeStep();
+
+	QCOMPARE(n1->mUpdateActivationCounter, 3);
+	QCOMPARE(n2->mUpdateActivationCounter, 4);
+	QCOMPARE(n1->mPrepareCounter, 6);
+	QCOMPARE(n2->mPrepareCounter, 7);
+
+	//... and structural changes.
+	NeuronAdapter *n3 = new NeuronAdapter("Neuron3", TransferFunctionAdapter("", 0.0, 1.0), 
+			ActivationFunctionAdapter(""));
+	QVERIFY(nn1.addNeuron(n3));
+	nn1.executeStep();
+
+	QCOMPARE(n1->mUpdateActivationCounter, 4);
+	QCOMPARE(n3->mUpdateActivationCounter, 1);
+
+	n3->setProperty(NeuralNetworkConstants::TAG_INPUT_NEURON);
+	nn1.executeStep();
+
+	QCOMPARE(n1->mUpdateActivationCounter, 5);
+	QCOMPARE(n3->mUpdateActivationCounter, 1);
+
+	QVERIFY(nn1.removeNeuron(n1));
+	nn1.executeStep();
+
+	QCOMPARE(n1->mUpdateActivationCounter, 5);
+	QCOMPARE(n2->mUpdateActivationCounter, 10);
+	delete n1;
 }
 
 
@@ -655,6 +733,94 @@ void TestNeuralNetwork::testInterfaceHandling() {
 }
 
 
+//Copies must keep the neuron lists and the execution schedule of the original network.
+void TestNeuralNetwork::testCopyPreservesSchedule() {
+	Core::resetCore();
+
+	SimpleSynapseFunction sf;
+	NeuralNetwork *net = new NeuralNetwork();
+	Neuron *in = new Neuron("In", TransferFunctionTanh(), AdditiveTimeDiscreteActivationFunction());
+	Neuron *hidden1 = new Neuron("Hidden1", TransferFunctionTanh(), 
+						AdditiveTimeDiscreteActivationFunction());
+	Neuron *hidden2 = new Neuron("Hidden2", TransferFunctionTanh(), 
+						AdditiveTimeDiscreteActivationFunction());
+	Neuron *out = new Neuron("Out", TransferFunctionTanh(), AdditiveTimeDiscreteActivationFunction());
+	in->setProperty(NeuralNetworkConstants::TAG_INPUT_NEURON);
+	out->setProperty(NeuralNetworkConstants::TAG_OUTPUT_NEURON);
+	hidden1->setProperty(NeuralNetworkConstants::TAG_NEURON_ORDER_DEPENDENT, "0,2");
+	hidden2->setProperty(NeuralNetworkConstants::TAG_NEURON_ORDER_DEPENDENT, "1,2");
+	hidden1->getBiasValue().set(0.2);
+	out->getBiasValue().set(-0.3);
+
+	//hidden2 is added before hidden1 to make the insertion order part of the schedule.
+	QVERIFY(net->addNeuron(out));
+	QVERIFY(net->addNeuron(hidden2));
+	QVERIFY(net->addNeuron(in));
+	QVERIFY(net->addNeuron(hidden1));
+
+	Synapse::createSynapse(in, hidden1, 1.5, sf);
+	Synapse::createSynapse(hidden1, hidden2, -2.0, sf);
+	Synapse::createSynapse(hidden2, hidden1, 0.7, sf);
+	Synapse::createSynapse(hidden2, out, 1.2, sf);
+	Synapse::createSynapse(out, out, 0.4, sf);
+	Synapse::createSynapse(out, hidden2, -0.5, sf);
+
+	NeuralNetwork *copy = net->createCopy();
+
+	QList<Neuron*> neurons = net->getNeurons();
+	QList<Neuron*> copiedNeurons = copy->getNeurons();
+	QCOMPARE(copiedNeurons.size(), neurons.size());
+	for(int i = 0; i < neurons.size(); ++i) {
+		QVERIFY(copiedNeurons.at(i) != neurons.at(i));
+		QCOMPARE(copiedNeurons.at(i)->getId(), neurons.at(i)->getId());
+		QCOMPARE(copiedNeurons.at(i)->getNameValue().get(), neurons.at(i)->getNameValue().get());
+		QCOMPARE(copy->getNeuronById(neurons.at(i)->getId()), copiedNeurons.at(i));
+	}
+	QCOMPARE(copy->getInputNeurons().size(), 1);
+	QCOMPARE(copy->getInputNeurons().first()->getId(), in->getId());
+	QCOMPARE(copy->getOutputNeurons().size(), 1);
+	QCOMPARE(copy->getOutputNeurons().first()->getId(), out->getId());
+
+	QList<Synapse*> synapses = net->getSynapses();
+	QList<Synapse*> copiedSynapses = copy->getSynapses();
+	QCOMPARE(copiedSynapses.size(), 6);
+	QCOMPARE(copiedSynapses.size(), synapses.size());
+	for(int i = 0; i < synapses.size(); ++i) {
+		Synapse *synapse = synapses.at(i);
+		Synapse *copiedSynapse = copiedSynapses.at(i);
+		QVERIFY(copiedSynapse != synapse);
+		QCOMPARE(copiedSynapse->getId(), synapse->getId());
+		QCOMPARE(copiedSynapse->getStrengthValue().get(), synapse->getStrengthValue().get());
+		QCOMPARE(copiedSynapse->getSource()->getId(), synapse->getSource()->getId());
+		QCOMPARE(copiedSynapse->getTarget()->getId(), synapse->getTarget()->getId());
+		QVERIFY(copiedNeurons.contains(copiedSynapse->getSource()));
+	}
+
+	//the same schedule yields the same activations in every step.
+	net->reset();
+	copy->reset();
+	Neuron *copiedIn = copy->getInputNeurons().first();
+	for(int step = 0; step < 20; ++step) {
+		double input = Math::sin(step * 0.5);
+		in->getOutputActivationValue().set(input);
+		copiedIn->getOutputActivationValue().set(input);
+		net->executeStep();
+		copy->executeStep();
+		for(int i = 0; i < neurons.size(); ++i) {
+			QVERIFY(Math::compareDoubles(neurons.at(i)->getActivationValue().get(),
+						copiedNeurons.at(i)->getActivationValue().get(), 0.000001));
+			QVERIFY(Math::compareDoubles(neurons.at(i)->getOutputActivationValue().get(),
+						copiedNeurons.at(i)->getOutputActivationValue().get(), 0.000001));
+		}
+	}
+	QVERIFY(out->getOutputActivationValue().get() != 0.0);
+
+	delete net;
+	delete copy;
+	Core::resetCore();
+}
+
+
 // Chris
 void TestNeuralNetwork::testDuplicationAndEquals() {
 	TransferFunctionAdapter tfa("TFA", -0.5, 0.5);
@@ -938,3 +1104,431 @@ void TestNeuralNetwork::testFreeElements() {
 	QVERIFY(destroyedNeuron1 == true);
 	QVERIFY(destroyedNeuron2 == true);
 }
+
+
+void TestNeuralNetwork::testDenseNetworkTrainer() {
+	NeuralNetwork net(AdditiveTimeDiscreteActivationFunction(), TransferFunctionSigmoid(),
+					  SimpleSynapseFunction());
+
+	Neuron *input1 = new Neuron("Input1", TransferFunctionNeutral(), AdditiveTimeDiscreteActivationFunction());
+	Neuron *input2 = new Neuron("Input2", TransferFunctionNeutral(), AdditiveTimeDiscreteActivationFunction());
+	Neuron *hidden1 = new Neuron("Hidden1", TransferFunctionSigmoid(), AdditiveTimeDiscreteActivationFunction());
+	Neuron *hidden2 = new Neuron("Hidden2", TransferFunctionSigmoid(), AdditiveTimeDiscreteActivationFunction());
+	Neuron *output = new Neuron("Output", TransferFunctionSigmoid(), AdditiveTimeDiscreteActivationFunction());
+	net.addNeuron(output);
+	net.addNeuron(hidden2);
+	net.addNeuron(hidden1);
+	net.addNeuron(input2);
+	net.addNeuron(input1);
+
+	hidden1->addSynapse(Synapse::createSynapse(input1, hidden1, 0.5, SimpleSynapseFunction()));
+	hidden1->addSynapse(Synapse::createSynapse(input2, hidden1, -0.3, SimpleSynapseFunction()));
+	hidden2->addSynapse(Synapse::createSynapse(input1, hidden2, -0.4, SimpleSynapseFunction()));
+	hidden2->addSynapse(Synapse::createSynapse(input2, hidden2, 0.2, SimpleSynapseFunction()));
+	Synapse *outputSynapse = Synapse::createSynapse(hidden1, output, 0.3, SimpleSynapseFunction());
+	output->addSynapse(outputSynapse);
+	output->addSynapse(Synapse::createSynapse(hidden2, output, -0.2, SimpleSynapseFunction()));
+
+	QList<Neuron*> inputs;
+	inputs << input1 << input2;
+	QList<Neuron*> outputs;
+	outputs << output;
+
+	//logical AND
+	QList<DenseTrainingSequence> data;
+	for(int i = 0; i < 4; ++i) {
+		DenseTrainingSample sample;
+		sample.mInputs << (i & 1) << ((i >> 1) & 1);
+		sample.mDesiredOutputs << (i == 3 ? 1.0 : 0.0);
+		data.append(DenseTrainingSequence() << sample);
+	}
+
+	DenseNetworkTrainer trainer;
+	QVERIFY(trainer.setNetwork(&net, inputs, outputs, false));
+	QCOMPARE(trainer.getNumberOfNeurons(), 5);
+	QCOMPARE(trainer.getWeight(output, hidden1), 0.3);
+	QCOMPARE(trainer.getWeight(hidden1, output), 0.0);
+	trainer.setTrainingData(data);
+	QCOMPARE(trainer.getNumberOfTrainingSequences(), 4);
+
+	//the error does not depend on the number of threads.
+	trainer.setNumberOfThreads(1);
+	double initialError = trainer.calculateError();
+	trainer.setNumberOfThreads(2);
+	QVERIFY(Math::compareDoubles(trainer.calculateError(), initialError, 0.0000000001));
+
+	trainer.setLearningRate(2.0);
+	trainer.setBatchSize(2);
+	trainer.train(500);
+	double trainedError = trainer.calculateError();
+	QVERIFY(trainedError < initialError * 0.5);
+
+	//the network itself is only changed on request.
+	QCOMPARE(outputSynapse->getStrengthValue().get(), 0.3);
+	trainer.writeWeightsToNetwork();
+	QCOMPARE(outputSynapse->getStrengthValue().get(), trainer.getWeight(output, hidden1));
+
+	//recurrent networks can only be trained in recurrent mode.
+	hidden1->addSynapse(Synapse::createSynapse(output, hidden1, 0.1, SimpleSynapseFunction()));
+	QVERIFY(trainer.setNetwork(&net, inputs, outputs, false) == false);
+	QVERIFY(trainer.setNetwork(&net, inputs, outputs, true));
+	QVERIFY(trainer.isRecurrent());
+
+	//the output is delayed by two steps in a synchronously updated network.
+	QList<DenseTrainingSequence> sequences;
+	for(int i = 0; i < 4; ++i) {
+		DenseTrainingSequence sequence;
+		for(int j = 0; j < 6; ++j) {
+			DenseTrainingSample sample;
+			sample.mInputs << (i & 1) << ((i >> 1) & 1);
+			if(j >= 2) {
+				sample.mDesiredOutputs << (i == 3 ? 1.0 : 0.0);
+			}
+			sequence.append(sample);
+		}
+		sequences.append(sequence);
+	}
+	trainer.setTrainingData(sequences);
+	trainer.setTruncationLength(3);
+	initialError = trainer.calculateError();
+	trainer.train(300);
+	QVERIFY(trainer.calculateError() < initialError);
+}
+
+
+void TestNeuralNetwork::testParallelExecution() {
+	Core::resetCore();
+
+	QList<NeuralNetwork*> networks;
+	QList<NeuronAdapter*> neurons;
+	for(int i = 0; i < 5; ++i) {
+		NeuralNetwork *net = new NeuralNetwork();
+		for(int j = 0; j < 2; ++j) {
+			NeuronAdapter *neuron = new NeuronAdapter("Neuron", TransferFunctionAdapter("", 0.0, 1.0), 
+						ActivationFunctionAdapter(""));
+			QVERIFY(net->addNeuron(neuron));
+			neurons.append(neuron);
+		}
+		networks.append(net);
+	}
+	//an order dependent neuron is updated twice in each step.
+	neurons.at(3)->setProperty(NeuralNetworkConstants::TAG_NEURON_ORDER_DEPENDENT, "0,2");
+
+	NeuralNetworkExecutionPool pool(3);
+	QCOMPARE(pool.getNumberOfThreads(), 3);
+
+	pool.executeNetworks(networks, 2);
+	pool.executeNetworks(networks, 1);
+
+	for(int i = 0; i < neurons.size(); ++i) {
+		QCOMPARE(neurons.at(i)->mUpdateActivationCounter, i == 3 ? 6 : 3);
+	}
+
+	//the workers are restarted with the new number of threads.
+	pool.setNumberOfThreads(2);
+	QCOMPARE(pool.getNumberOfThreads(), 2);
+	pool.executeNetworks(networks, 1);
+
+	for(int i = 0; i < neurons.size(); ++i) {
+		QCOMPARE(neurons.at(i)->mUpdateActivationCounter, i == 3 ? 8 : 4);
+	}
+
+	while(!networks.empty()) {
+		delete networks.takeFirst();
+	}
+	Core::resetCore();
+}
+
+
+//Listeners of neuron and synapse Values are notified in the calling thread.
+void TestNeuralNetwork::testParallelExecutionNotifiesInCallingThread() {
+	Core::resetCore();
+
+	SimpleSynapseFunction sf;
+	QList<NeuralNetwork*> networks;
+	for(int i = 0; i < 4; ++i) {
+		NeuralNetwork *net = new NeuralNetwork();
+		Neuron *neuron = new Neuron("Neuron", TransferFunctionTanh(), 
+								AdditiveTimeDiscreteActivationFunction());
+		neuron->getBiasValue().set(0.5);
+		net->addNeuron(neuron);
+		Synapse::createSynapse(neuron, neuron, -1.0, sf);
+		networks.append(net);
+	}
+	Neuron *observedNeuron = networks.at(1)->getNeurons().first();
+	Synapse *observedSynapse = networks.at(2)->getSynapses().first();
+
+	QVERIFY(networks.at(1)->hasObservedStateValues() == false);
+
+	ThreadCheckingListener listener;
+	observedNeuron->getOutputActivationValue().addValueChangedListener(&listener);
+	observedSynapse->getStrengthValue().addValueChangedListener(&listener);
+	QVERIFY(networks.at(1)->isThreadSafe());
+	QVERIFY(networks.at(1)->hasObservedStateValues());
+	QVERIFY(networks.at(2)->hasObservedStateValues());
+	QVERIFY(networks.at(3)->hasObservedStateValues() == false);
+
+	NeuralNetworkExecutionPool pool(3);
+	for(int step = 0; step < 10; ++step) {
+		pool.executeNetworks(networks, 1);
+	}
+	QVERIFY(listener.mNumberOfNotifications > 0);
+	QVERIFY(listener.mNotifiedInOtherThread == false);
+
+	observedNeuron->getOutputActivationValue().removeValueChangedListener(&listener);
+	observedSynapse->getStrengthValue().removeValueChangedListener(&listener);
+	QVERIFY(networks.at(1)->hasObservedStateValues() == false);
+
+	while(!networks.empty()) {
+		delete networks.takeFirst();
+	}
+	Core::resetCore();
+}
+
+
+//Networks using the global random number generator must give the same results as
+//with a sequential execution.
+void TestNeuralNetwork::testParallelExecutionIsDeterministic() {
+	Core::resetCore();
+
+	SimpleSynapseFunction sf;
+	SignalGeneratorActivationFunction signalGenerator;
+	signalGenerator.getParameter("RandActivation")->setValueFromString("true");
+	signalGenerator.getParameter("RandDuration")->setValueFromString("true");
+	signalGenerator.getParameter("MinDuration")->setValueFromString("1");
+	signalGenerator.getParameter("MaxDuration")->setValueFromString("4");
+
+	QList<NeuralNetwork*> sequentialNetworks;
+	for(int i = 0; i < 6; ++i) {
+		NeuralNetwork *net = new NeuralNetwork();
+		Neuron *source = 0;
+		if(i % 2 == 0) {
+			source = new Neuron("Signal", TransferFunctionTanh(), signalGenerator);
+		}
+		else {
+			source = new Neuron("Source", TransferFunctionTanh(), 
+								AdditiveTimeDiscreteActivationFunction());
+			source->getBiasValue().set(0.1 * i);
+		}
+		Neuron *hidden = new Neuron("Hidden", TransferFunctionTanh(), 
+								AdditiveTimeDiscreteActivationFunction());
+		net->addNeuron(source);
+		net->addNeuron(hidden);
+		Synapse::createSynapse(source, hidden, 1.5, sf);
+		Synapse::createSynapse(hidden, hidden, 0.5, sf);
+		Synapse::createSynapse(hidden, source, -0.3, sf);
+		sequentialNetworks.append(net);
+	}
+
+	QList<NeuralNetwork*> parallelNetworks;
+	for(int i = 0; i < sequentialNetworks.size(); ++i) {
+		parallelNetworks.append(sequentialNetworks.at(i)->createCopy());
+		QCOMPARE(parallelNetworks.at(i)->isThreadSafe(), i % 2 != 0);
+	}
+
+	QList<QList<double> > sequentialActivations;
+	Random::setSeed(42);
+	for(int i = 0; i < sequentialNetworks.size(); ++i) {
+		sequentialNetworks.at(i)->reset();
+	}
+	for(int step = 0; step < 50; ++step) {
+		QList<double> activations;
+		for(int i = 0; i < sequentialNetworks.size(); ++i) {
+			sequentialNetworks.at(i)->executeStep();
+			QList<Neuron*> neurons = sequentialNetworks.at(i)->getNeurons();
+			for(int j = 0; j < neurons.size(); ++j) {
+				activations.append(neurons.at(j)->getOutputActivationValue().get());
+			}
+		}
+		sequentialActivations.append(activations);
+	}
+
+	NeuralNetworkExecutionPool pool(3);
+	Random::setSeed(42);
+	for(int i = 0; i < parallelNetworks.size(); ++i) {
+		parallelNetworks.at(i)->reset();
+	}
+	for(int step = 0; step < 50; ++step) {
+		pool.executeNetworks(parallelNetworks, 1);
+		QList<double> activations;
+		for(int i = 0; i < parallelNetworks.size(); ++i) {
+			QList<Neuron*> neurons = parallelNetworks.at(i)->getNeurons();
+			for(int j = 0; j < neurons.size(); ++j) {
+				activations.append(neurons.at(j)->getOutputActivationValue().get());
+			}
+		}
+		QCOMPARE(activations, sequentialActivations.at(step));
+	}
+
+	while(!sequentialNetworks.empty()) {
+		delete sequentialNetworks.takeFirst();
+	}
+	while(!parallelNetworks.empty()) {
+		delete parallelNetworks.takeFirst();
+	}
+	Core::resetCore();
+}
+
+
+void TestNeuralNetwork::testEventDrivenSpiking() {
+	Core::resetCore();
+
+	SimpleSynapseFunction sf;
+	Neuron *a = new Neuron("A", TransferFunctionThreshold(), Izhikevitch2003SpikingActivationFunction());
+	Neuron *b = new Neuron("B", TransferFunctionThreshold(), Izhikevitch2003SpikingActivationFunction());
+	Neuron *c = new Neuron("C", TransferFunctionThreshold(), Izhikevitch2003SpikingActivationFunction());
+	a->getBiasValue().set(10.0);
+	Synapse::createSynapse(a, b, 0.5, sf);
+	Synapse::createSynapse(b, c, 0.8, sf);
+	Synapse::createSynapse(c, a, -0.2, sf);
+
+	NeuralNetwork *clockNet = new NeuralNetwork();
+	clockNet->addNeuron(a);
+	clockNet->addNeuron(b);
+	clockNet->addNeuron(c);
+
+	NeuralNetwork *eventNet = clockNet->createCopy();
+	eventNet->setProperty(NeuralNetworkConstants::TAG_NETWORK_EVENT_DRIVEN_SPIKING);
+	clockNet->reset();
+	eventNet->reset();
+
+	QList<Neuron*> clockNeurons = clockNet->getNeurons();
+	QList<Neuron*> eventNeurons = eventNet->getNeurons();
+	QCOMPARE(eventNeurons.size(), 3);
+
+	//both execution modes produce the same membrane potentials and spikes.
+	int numberOfSpikes = 0;
+	for(int step = 0; step < 1000; ++step) {
+		clockNet->executeStep();
+		eventNet->executeStep();
+		for(int i = 0; i < clockNeurons.size(); ++i) {
+			QVERIFY(Math::compareDoubles(clockNeurons.at(i)->getActivationValue().get(),
+						eventNeurons.at(i)->getActivationValue().get(), 0.000001));
+			QVERIFY(Math::compareDoubles(clockNeurons.at(i)->getOutputActivationValue().get(),
+						eventNeurons.at(i)->getOutputActivationValue().get(), 0.000001));
+		}
+		if(clockNeurons.at(0)->getOutputActivationValue().get() != 0.0) {
+			++numberOfSpikes;
+		}
+	}
+	QVERIFY(numberOfSpikes > 0);
+
+	//weight changes are detected without an explicit invalidation.
+	clockNeurons.at(1)->getSynapses().at(0)->getStrengthValue().set(20.0);
+	eventNeurons.at(1)->getSynapses().at(0)->getStrengthValue().set(20.0);
+	for(int step = 0; step < 200; ++step) {
+		clockNet->executeStep();
+		eventNet->executeStep();
+		QVERIFY(Math::compareDoubles(clockNeurons.at(1)->getActivationValue().get(),
+					eventNeurons.at(1)->getActivationValue().get(), 0.000001));
+	}
+
+	//networks with other neuron models fall back to the clock-driven execution.
+	NeuralNetwork *otherNet = new NeuralNetwork();
+	otherNet->setProperty(NeuralNetworkConstants::TAG_NETWORK_EVENT_DRIVEN_SPIKING);
+	NeuronAdapter *neuron = new NeuronAdapter("Neuron", TransferFunctionAdapter("", 0.0, 1.0), 
+						ActivationFunctionAdapter(""));
+	otherNet->addNeuron(neuron);
+	otherNet->executeStep();
+	QCOMPARE(neuron->mUpdateActivationCounter, 1);
+
+	delete clockNet;
+	delete eventNet;
+	delete otherNet;
+	Core::resetCore();
+}
+
+
+/**
+ * Prepares all neurons and executes a single step of the engine, as done by 
+ * NeuralNetwork::executeIterations().
+ */
+static bool executeEngineStep(SpikingEventEngine &engine, NeuralNetwork *net, 
+							const QVector<Neuron*> &updatedNeurons) 
+{
+	QList<Neuron*> neurons = net->getNeurons();
+	for(QListIterator<Neuron*> i(neurons); i.hasNext();) {
+		i.next()->prepare();
+	}
+	return engine.executeStep(updatedNeurons);
+}
+
+
+void TestNeuralNetwork::testDelayedSpikeEvents() {
+	Core::resetCore();
+
+	//A is a source neuron whose output is set manually, B and C are not updated here.
+	SimpleSynapseFunction sf;
+	Neuron *a = new Neuron("A", TransferFunctionThreshold(), Izhikevitch2003SpikingActivationFunction());
+	Neuron *b = new Neuron("B", TransferFunctionThreshold(), Izhikevitch2003SpikingActivationFunction());
+	Neuron *c = new Neuron("C", TransferFunctionThreshold(), Izhikevitch2003SpikingActivationFunction());
+	Synapse *delayed = Synapse::createSynapse(a, b, 0.5, sf);
+	delayed->setProperty(NeuralNetworkConstants::TAG_SYNAPSE_DELAY, "3");
+	Synapse::createSynapse(a, c, 0.7, sf);
+
+	NeuralNetwork *net = new NeuralNetwork();
+	net->addNeuron(a);
+	net->addNeuron(b);
+	net->addNeuron(c);
+	net->reset();
+
+	SpikingEventEngine engine(net);
+	QVector<Neuron*> updatedNeurons;
+
+	//step 0: no output, no input.
+	QVERIFY(executeEngineStep(engine, net, updatedNeurons));
+	QCOMPARE(engine.getNumberOfPendingEvents(), 0);
+	QCOMPARE(engine.getSynapticInput(b), 0.0);
+
+	//step 1: A spikes. C receives it immediately, B after 3 steps (step 4).
+	a->getOutputActivationValue().set(1.0);
+	QVERIFY(executeEngineStep(engine, net, updatedNeurons));
+	QCOMPARE(engine.getNumberOfPendingEvents(), 1);
+	QCOMPARE(engine.getSynapticInput(c), 0.7);
+	QCOMPARE(engine.getSynapticInput(b), 0.0);
+
+	QVERIFY(executeEngineStep(engine, net, updatedNeurons));
+	QVERIFY(executeEngineStep(engine, net, updatedNeurons));
+	QCOMPARE(engine.getNumberOfPendingEvents(), 1);
+	QCOMPARE(engine.getSynapticInput(b), 0.0);
+
+	QVERIFY(executeEngineStep(engine, net, updatedNeurons));
+	QCOMPARE(engine.getNumberOfPendingEvents(), 0);
+	QCOMPARE(engine.getSynapticInput(b), 0.5);
+
+	//step 5: A stops spiking. The change arrives at B in step 8.
+	a->getOutputActivationValue().set(0.0);
+	QVERIFY(executeEngineStep(engine, net, updatedNeurons));
+	QCOMPARE(engine.getNumberOfPendingEvents(), 1);
+	QCOMPARE(engine.getSynapticInput(c), 0.0);
+	QCOMPARE(engine.getSynapticInput(b), 0.5);
+
+	QVERIFY(executeEngineStep(engine, net, updatedNeurons));
+
+	//step 7: the strength change rebuilds the engine while the event is in flight.
+	//the arrived spike is weighted with the new strength, the pending event is kept.
+	delayed->getStrengthValue().set(2.0);
+	QVERIFY(executeEngineStep(engine, net, updatedNeurons));
+	QCOMPARE(engine.getNumberOfPendingEvents(), 1);
+	QCOMPARE(engine.getSynapticInput(b), 2.0);
+
+	//step 8: the event arrives at its original step.
+	QVERIFY(executeEngineStep(engine, net, updatedNeurons));
+	QCOMPARE(engine.getNumberOfPendingEvents(), 0);
+	QCOMPARE(engine.getSynapticInput(b), 0.0);
+
+	//a spike in flight is discarded by reset().
+	a->getOutputActivationValue().set(1.0);
+	QVERIFY(executeEngineStep(engine, net, updatedNeurons));
+	QCOMPARE(engine.getNumberOfPendingEvents(), 1);
+	engine.invalidate();
+	QVERIFY(executeEngineStep(engine, net, updatedNeurons));
+	QCOMPARE(engine.getNumberOfPendingEvents(), 1);
+	engine.reset();
+	QVERIFY(executeEngineStep(engine, net, updatedNeurons));
+	QCOMPARE(engine.getNumberOfPendingEvents(), 0);
+	QCOMPARE(engine.getSynapticInput(b), 2.0);
+
+	delete net;
+	Core::resetCore();
+}
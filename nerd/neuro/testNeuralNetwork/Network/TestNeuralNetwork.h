@@ -63,9 +63,16 @@ private slots:
 	void testExecution();	
 	void testNetworkDuplication();
 	void testInterfaceHandling();
+	void testCopyPreservesSchedule();
 	void testDuplicationAndEquals();
 	void testSelectObjectsById();
 	void testFreeElements();
+	void testDenseNetworkTrainer();
+	void testParallelExecution();
+	void testParallelExecutionNotifiesInCallingThread();
+	void testParallelExecutionIsDeterministic();
+	void testEventDrivenSpiking();
+	void testDelayedSpikeEvents();
 
 private:
 	
@@ -61,6 +61,7 @@
 #include "Value/DoubleValue.h"
 #include "Math/Math.h"
 #include "NeuralNetworkConstants.h"
+#include "Network/NeuroTagManager.h"
 
 
 using namespace std;
@@ -554,12 +555,87 @@ void TestNeuron::testInitOutputAtReset() {
 }
 
 
+void TestNeuron::testTagLookup() {
+	Neuron neuron("Neuron", TransferFunctionTanh(), AdditiveTimeDiscreteActivationFunction());
+
+	QVERIFY(neuron.hasProperty("TestTagA") == false);
+
+	neuron.setProperty("TestTagA");
+	neuron.setProperty("+TestTagB", "Value");
+	int atomA = NeuroTagManager::getTagAtom("TestTagA");
+	int atomB = NeuroTagManager::getTagAtom("TestTagB");
+	QVERIFY(atomA >= 0);
+	QVERIFY(atomA != atomB);
+	QCOMPARE(NeuroTagManager::findTagAtom("TestTagA"), atomA);
+	QVERIFY(NeuroTagManager::getTagNameOfAtom(atomB) == "TestTagB");
+
+	//hidden prefixes are ignored.
+	QVERIFY(neuron.hasProperty("TestTagA"));
+	QVERIFY(neuron.hasProperty("+TestTagA"));
+	QVERIFY(neuron.hasProperty("TestTagB"));
+	QVERIFY(neuron.hasTag(atomA));
+	QVERIFY(neuron.hasTag(atomB));
+
+	//copies know the tags of the original.
+	Neuron *copy = neuron.createCopy();
+	QVERIFY(copy->hasTag(atomA));
+	QVERIFY(copy->hasProperty("TestTagB"));
+
+	//a tag is only removed if no prefixed version is left.
+	neuron.setProperty("+TestTagA");
+	neuron.removeProperty("TestTagA");
+	QVERIFY(neuron.hasTag(atomA));
+	neuron.removeProperty("+TestTagA");
+	QVERIFY(neuron.hasTag(atomA) == false);
+	QVERIFY(neuron.hasProperty("TestTagA") == false);
+	QVERIFY(copy->hasTag(atomA));
+
+	neuron.setProperty("_##_Temp1");
+	neuron.setProperty("_##_Temp2", "1");
+	neuron.removePropertiesByPrefix("_##_");
+	QVERIFY(neuron.hasProperty("_##_Temp1") == false);
+	QVERIFY(neuron.hasProperty("_##_Temp2") == false);
+	QVERIFY(neuron.hasProperty("TestTagB"));
+
+	delete copy;
+}
 
 
+//Fills the global atom table, so it has to start and end with an empty table.
+void TestNeuron::testTagAtomTableLimit() {
+	NeuroTagManager::resetTagAtoms();
+	QVERIFY(NeuroTagManager::isTagAtomTableFull() == false);
+	{
+		Neuron neuron("Neuron", TransferFunctionTanh(), AdditiveTimeDiscreteActivationFunction());
+
+		//arbitrary property names can not grow the atom table beyond its bound.
+		for(int i = 0; i < NeuroTagManager::MAXIMUM_NUMBER_OF_TAG_ATOMS; ++i) {
+			neuron.setProperty(QString("TestProperty") + QString::number(i));
+		}
+		QVERIFY(NeuroTagManager::isTagAtomTableFull());
+		QCOMPARE(NeuroTagManager::getTagAtom("TestUnregisteredTag"), -1);
+		QVERIFY(NeuroTagManager::getTagNameOfAtom(NeuroTagManager::MAXIMUM_NUMBER_OF_TAG_ATOMS) == "");
+		int lastName = NeuroTagManager::MAXIMUM_NUMBER_OF_TAG_ATOMS - 1;
+		QCOMPARE(NeuroTagManager::findTagAtom(QString("TestProperty") + QString::number(lastName)), -1);
+
+		//names without an atom are still found with the string lookup.
+		QVERIFY(neuron.hasProperty(QString("TestProperty") + QString::number(lastName)));
+		QVERIFY(neuron.hasProperty("TestUnregisteredTag") == false);
+		neuron.removeProperty(QString("TestProperty") + QString::number(lastName));
+		QVERIFY(neuron.hasProperty(QString("TestProperty") + QString::number(lastName)) == false);
+
+		//registered tags still get one of the reserved atoms.
+		NeuroTagManager tagManager;
+		QVERIFY(tagManager.addTag(NeuroTag("TestRegisteredTag", "Test", "")));
+		int registeredAtom = NeuroTagManager::findTagAtom("TestRegisteredTag");
+		QVERIFY(registeredAtom >= 0);
+		QVERIFY(registeredAtom < NeuroTagManager::MAXIMUM_NUMBER_OF_TAG_ATOMS);
+		neuron.setProperty("TestRegisteredTag");
+		QVERIFY(neuron.hasTag(registeredAtom));
+	}
 
-
-
-
-
-
-
+	//other tests expect an atom for each property name.
+	NeuroTagManager::resetTagAtoms();
+	QVERIFY(NeuroTagManager::isTagAtomTableFull() == false);
+	QCOMPARE(NeuroTagManager::findTagAtom("TestProperty0"), -1);
+}
@@ -63,6 +63,8 @@ private slots:
 	void testNeuronCalculation();
 	void testDuplication();
 	void testInitOutputAtReset();
+	void testTagLookup();
+	void testTagAtomTableLimit();
 	
 
 private:
@@ -417,3 +417,53 @@ void TestSynapse::testDuplication() {
 
 
 
+
+
+void TestSynapse::testStateSlots() {
+	Neuron sourceNeuron("Source", TransferFunctionTanh(), AdditiveTimeDiscreteActivationFunction());
+	Neuron targetNeuron("Target", TransferFunctionTanh(), AdditiveTimeDiscreteActivationFunction());
+
+	Synapse synapse(&sourceNeuron, &targetNeuron, 0.5, SimpleSynapseFunction());
+	synapse.setProperty("Counter", "3");
+
+	//a new slot is initialized from the property with the same name.
+	int counter = synapse.addStateSlot("Counter");
+	int weight = synapse.addStateSlot("Weight");
+	QCOMPARE(counter, 0);
+	QCOMPARE(weight, 1);
+	QCOMPARE(synapse.addStateSlot("Counter"), 0);
+	QCOMPARE(synapse.getStateSlot("Weight"), 1);
+	QCOMPARE(synapse.getStateSlot("Unknown"), -1);
+
+	QVERIFY(synapse.hasStateValue(counter));
+	QCOMPARE(synapse.getStateValue(counter), 3.0);
+	QVERIFY(synapse.hasStateValue(weight) == false);
+	QVERIFY(synapse.hasStateValue(5) == false);
+
+	//slot values are not written to the properties until requested.
+	synapse.setStateValue(counter, 4.0);
+	synapse.setStateValue(weight, 0.123456789);
+	QVERIFY(synapse.getProperty("Counter") == "3");
+	QVERIFY(synapse.hasProperty("Weight") == false);
+
+	//copies keep their slots.
+	Synapse *copy = synapse.createCopy();
+	QCOMPARE(copy->getStateSlot("Weight"), weight);
+	QCOMPARE(copy->getStateValue(weight), 0.123456789);
+
+	synapse.storeStateSlotsInProperties();
+	QVERIFY(synapse.getProperty("Counter") == "4");
+	QCOMPARE(synapse.getProperty("Weight").toDouble(), 0.123456789);
+
+	//external property changes are taken over by the slots.
+	synapse.setProperty("Counter", "10");
+	QCOMPARE(synapse.getStateValue(counter), 10.0);
+
+	//cleared slots remove their properties.
+	synapse.clearStateValue(weight);
+	synapse.storeStateSlotsInProperties();
+	QVERIFY(synapse.hasProperty("Weight") == false);
+	QCOMPARE(synapse.getStateValue(weight), 0.0);
+
+	delete copy;
+}
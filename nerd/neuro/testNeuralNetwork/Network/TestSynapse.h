@@ -64,6 +64,7 @@ private slots:
 	void testAddAndRemoveSynapses();
 	void testActivationCalculation(); 
 	void testDuplication();
+	void testStateSlots();
 
 private:
 	
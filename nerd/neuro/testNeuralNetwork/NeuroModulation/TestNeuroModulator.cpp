@@ -52,6 +52,12 @@
 #include "Network/Synapse.h"
 #include "Math/ASeriesFunctions.h"
 #include "NeuroModulation/NeuroModulator.h"
+#include "NeuroModulation/NeuroModulatorField.h"
+#include "Network/NeuralNetwork.h"
+#include "Network/Neuron.h"
+#include "TransferFunction/TransferFunctionTanh.h"
+#include "ActivationFunction/AdditiveTimeDiscreteActivationFunction.h"
+#include "ActivationFunction/AdditiveTimeDiscreteNeuroModulatorActivationFunction.h"
 
 
 using namespace nerd;
@@ -136,6 +142,59 @@ void TestNeuroModulator::testLocalConcentrationCalculation() {
 //Chris
 void TestNeuroModulator::testNetworkConcentrationCalculation() {
 	
+	NeuralNetwork net;
+	QVERIFY(NeuroModulator::getConcentrationInNetworkAt(1, Vector3D(0.0, 0.0, 0.0), &net) == 0.0);
+	QVERIFY(NeuroModulator::getConcentrationInNetworkAt(1, Vector3D(0.0, 0.0, 0.0), 0) == 0.0);
+	
+	//modulator cells with different areas, interleaved with normal neurons.
+	QList<NeuroModulator*> modulators;
+	for(int i = 0; i < 60; ++i) {
+		if(i % 3 == 0) {
+			Neuron *neuron = new Neuron("N", TransferFunctionTanh(), AdditiveTimeDiscreteActivationFunction());
+			neuron->setPosition(Vector3D(i * 10.0, 0.0, 0.0));
+			net.addNeuron(neuron);
+			continue;
+		}
+		Neuron *neuron = new Neuron("M", TransferFunctionTanh(), 
+						AdditiveTimeDiscreteNeuroModulatorActivationFunction());
+		neuron->setPosition(Vector3D((i * 37) % 500, (i * 53) % 400, 0.0));
+		net.addNeuron(neuron);
+		
+		NeuroModulator *mod = dynamic_cast<NeuroModulatorActivationFunction*>(
+									neuron->getActivationFunction())->getNeuroModulator();
+		QVERIFY(mod != 0);
+		mod->setConcentration(1, 0.1 * (i % 7), neuron);
+		mod->setConcentration(2, 1.0, neuron);
+		mod->setLocalAreaRect(1, 20.0 + (i % 5) * 30.0, 40.0, Vector3D(-10.0, 5.0, 0.0), (i % 2) == 0);
+		mod->setLocalAreaRect(2, (i == 7) ? 2000.0 : 15.0, 15.0, Vector3D(0.0, 0.0, 0.0), true);
+		modulators.append(mod);
+	}
+	QCOMPARE(net.getNeuroModulatorField()->getNumberOfEmitters(), 40);
+	
+	//compare with the exhaustive summation over all neurons.
+	for(int round = 0; round < 2; ++round) {
+		for(int type = 1; type <= 3; ++type) {
+			for(double x = -50.0; x < 550.0; x += 13.0) {
+				for(double y = -50.0; y < 450.0; y += 17.0) {
+					Vector3D pos(x, y, 0.0);
+					double expected = 0.0;
+					QList<Neuron*> neurons = net.getNeurons();
+					for(int i = 0; i < neurons.size(); ++i) {
+						NeuroModulatorActivationFunction *nmaf = 
+							dynamic_cast<NeuroModulatorActivationFunction*>(neurons.at(i)->getActivationFunction());
+						if(nmaf != 0) {
+							expected += nmaf->getNeuroModulator()->getConcentrationAt(type, pos, neurons.at(i));
+						}
+					}
+					QCOMPARE(NeuroModulator::getConcentrationInNetworkAt(type, pos, &net), expected);
+				}
+			}
+		}
+		//growing areas have to be detected without an explicit invalidation.
+		for(int i = 0; i < modulators.size(); ++i) {
+			modulators.at(i)->setLocalAreaRect(1, 180.0, 120.0, Vector3D(-30.0, -30.0, 0.0), false);
+		}
+	}
 }
 
 
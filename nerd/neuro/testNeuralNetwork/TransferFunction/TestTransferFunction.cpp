@@ -49,9 +49,14 @@
 #include "Value/DoubleValue.h"
 #include "TransferFunction/TransferFunctionTanh.h"
 #include "TransferFunction/TransferFunctionASeriesTanh.h"
+#include "TransferFunction/TransferFunctionMSeriesTanh.h"
+#include "TransferFunction/TransferFunctionSigmoid.h"
+#include "TransferFunction/TransferFunctionParameterizedSigmoid.h"
+#include "TransferFunction/TransferFunctionGauss.h"
 #include "Math/ASeriesFunctions.h"
 #include <iostream>
 #include "Math/Math.h"
+#include <math.h>
 
 using namespace std;
 
@@ -247,3 +252,57 @@ void TestTransferFunction::testTransferFunctionASeriesTanh() {
 	QVERIFY(Math::compareDoubles(aSeriesTanh.transferActivation(0.0, 0), 0.00000000, 8));
 
 }
+
+
+void TestTransferFunction::testBatchTransfer() {
+	QList<TransferFunction*> functions;
+	functions.append(new TransferFunctionSigmoid());
+	functions.append(new TransferFunctionParameterizedSigmoid(0.3, 2.5));
+	functions.append(new TransferFunctionGauss(0.7, 0.1));
+	functions.append(new TransferFunctionTanh());
+	functions.append(new TransferFunctionASeriesTanh());
+	functions.append(new TransferFunctionMSeriesTanh());
+	functions.append(new TransferFunctionAdapter("Adapter", -1.0, 1.0));
+
+	const int count = 101;
+	double activations[count];
+	double outputs[count];
+	for(int i = 0; i < count; ++i) {
+		activations[i] = -10.0 + (i * 0.2);
+	}
+
+	for(QListIterator<TransferFunction*> i(functions); i.hasNext();) {
+		TransferFunction *tf = i.next();
+
+		//exact batch results are identical to the scalar results.
+		tf->transferActivations(activations, outputs, count);
+		for(int j = 0; j < count; ++j) {
+			QCOMPARE(outputs[j], tf->transferActivation(activations[j], 0));
+		}
+
+		//fast batch results are close to the scalar results.
+		tf->transferActivations(activations, outputs, count, 0, TransferFunction::ACCURACY_FAST);
+		for(int j = 0; j < count; ++j) {
+			QVERIFY(Math::compareDoubles(outputs[j], tf->transferActivation(activations[j], 0), 0.000000001));
+		}
+	}
+
+	//the firmware version of the tanh corresponds to the M-Series tanh.
+	TransferFunctionMSeriesTanh mSeriesTanh;
+	functions.at(3)->transferActivations(activations, outputs, count, 0, 
+						TransferFunction::ACCURACY_FIRMWARE);
+	for(int j = 0; j < count; ++j) {
+		QCOMPARE(outputs[j], mSeriesTanh.transferActivation(activations[j], 0));
+	}
+
+	//in-place transfer
+	double values[3] = {-1.0, 0.0, 1.0};
+	functions.at(0)->transferActivations(values, values, 3);
+	QCOMPARE(values[1], 0.5);
+	QVERIFY(Math::compareDoubles(values[2], 1.0 / (1.0 + exp(-1.0)), 0.0000001));
+
+	while(!functions.empty()) {
+		delete functions.takeFirst();
+	}
+}
+
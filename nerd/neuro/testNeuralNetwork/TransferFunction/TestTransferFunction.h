@@ -61,6 +61,7 @@ private slots:
 	void testTransferFunction();
 	void testTransferFunctionTanh();
 	void testTransferFunctionASeriesTanh();
+	void testBatchTransfer();
 
 private:
 	
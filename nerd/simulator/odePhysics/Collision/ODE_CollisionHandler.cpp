@@ -291,7 +291,7 @@ void ODE_CollisionHandler::collisionCallback(void *data, dGeomID o1, dGeomID o2)
 		CollisionObject *second = mLookUpTable.value(o2);	
 
 		if(first == 0 || second == 0) {
-			Core::log("ODE_CollisionHandler: CollisionObject could not be defined.");
+			Core::log("ODE_CollisionHandler: CollisionObject could not be defined.", Core::LOG_WARNING);
 			return;
 		}
 
@@ -54,8 +54,9 @@
 #include "Value/DoubleValue.h"
 #include "Value/IntValue.h"
 #include "Value/BoolValue.h"
-#include <QTime>
+#include <QElapsedTimer>
 #include "Value/ValueManager.h"
+#include "Util/Profiler.h"
 #include "Physics/Physics.h"
 #include <iostream>
 
@@ -211,37 +212,60 @@ dJointGroupID ODE_SimulationAlgorithm::getJointGroupID() const {
  * @return Returns whether the step-execution was successful.
  */
 bool ODE_SimulationAlgorithm::executeSimulationStep(PhysicsManager *pManager) {
-	QTime time;
 	bool measurePerformance = Core::getInstance()->isPerformanceMeasuringEnabled();
 
 	int iterationsPerStep = mIterationsPerStepValue->get();	
 
 	if(measurePerformance) {
-		//Run physics with performance measuring.
+		//Run physics with performance measuring (stages are also recorded by the profiler).
+		Profiler *profiler = Core::getInstance()->getProfiler();
 
-		int durationMotorUpdate = 0;
-		int durationSensorUpdate = 0;
-		int durationStep = 0;
-		int durationCollision = 0;
+		qint64 durationMotorUpdate = 0;
+		qint64 durationSensorUpdate = 0;
+		qint64 durationStep = 0;
+		qint64 durationCollision = 0;
 
+		QElapsedTimer time;
 		time.start();
+		qint64 lastTime = 0;
+		qint64 currentTime = 0;
 
 		for(int i = 0; i < iterationsPerStep; ++i) {
+			profiler->enter("MotorUpdate");
 			pManager->updateActuators();
-			durationMotorUpdate += time.restart();
+			profiler->leave();
+			currentTime = time.nsecsElapsed();
+			durationMotorUpdate += currentTime - lastTime;
+			lastTime = currentTime;
+
+			profiler->enter("CollisionExecution");
 			mODECollisionHandler->clearContactList();
 			dSpaceCollide(mODEMainSpace, 0, &nearCallback);
-			durationCollision += time.restart();
+			profiler->leave();
+			currentTime = time.nsecsElapsed();
+			durationCollision += currentTime - lastTime;
+			lastTime = currentTime;
+
+			profiler->enter("StepExecution");
 			dWorldStep(mODEWorld, mTimeStepSizeValue->get());
 			dJointGroupEmpty(mContactJointGroup);
-			durationStep += time.restart();
+			profiler->leave();
+			currentTime = time.nsecsElapsed();
+			durationStep += currentTime - lastTime;
+			lastTime = currentTime;
+
+			profiler->enter("SensorUpdate");
 			pManager->updateSensors();
-			durationSensorUpdate += time.restart();
+			profiler->leave();
+			currentTime = time.nsecsElapsed();
+			durationSensorUpdate += currentTime - lastTime;
+			lastTime = currentTime;
 		}
-		mUpdateMotorsDurationValue->set(durationMotorUpdate);
-		mUpdateSensorsDurationValue->set(durationSensorUpdate);
-		mStepDurationValue->set(durationStep);
-		mStepCollisionDurationValue->set(durationCollision);
+		//the values are given in ms, but are summed up with ns resolution.
+		mUpdateMotorsDurationValue->set((int) (durationMotorUpdate / 1000000));
+		mUpdateSensorsDurationValue->set((int) (durationSensorUpdate / 1000000));
+		mStepDurationValue->set((int) (durationStep / 1000000));
+		mStepCollisionDurationValue->set((int) (durationCollision / 1000000));
 	}
 	else {
 		//Run physics without performance measuring.
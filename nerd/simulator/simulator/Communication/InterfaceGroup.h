@@ -47,6 +47,7 @@
 #define NERDInterfaceGroup_H
 
 #include <QVector>
+#include <QList>
 #include "Value/InterfaceValue.h"
 #include "Physics/SimObjectGroup.h"
 
@@ -54,10 +55,28 @@ namespace nerd {
 
 	/**
 	 * InterfaceGroup
+	 *
+	 * Besides the interface values, the group holds the queue of motor frames that 
+	 * were received for upcoming simulation steps (batched or pipelined step commands)
+	 * and the sensor frames collected for a currently running batch.
 	 */
 	struct InterfaceGroup {
 	public:
-		InterfaceGroup(int id) : mId(id), mAssociatedObjectGroup(0) {}
+		InterfaceGroup(int id) : mId(id), mAssociatedObjectGroup(0), mStepRunning(false),
+					mBatchSize(0), mBatchRemaining(0) {}
+
+		/**
+		 * Drops all queued motor frames and the state of a running step or batch, 
+		 * e.g. after a reset, so that no frame received before is applied later.
+		 */
+		void clearPendingSteps() {
+			mPendingInputFrames.clear();
+			mPendingBatchSizes.clear();
+			mStepRunning = false;
+			mBatchSize = 0;
+			mBatchRemaining = 0;
+			mBatchOutputFrames.clear();
+		}
 		
 		int mId;
 		SimObjectGroup *mAssociatedObjectGroup;
@@ -65,6 +84,13 @@ namespace nerd {
 		QVector<InterfaceValue*> mInputValues;
 		QVector<InterfaceValue*> mOutputValues;
 		QVector<InterfaceValue*> mInfoValues;
+		
+		QList<QVector<double> > mPendingInputFrames;
+		QList<int> mPendingBatchSizes;
+		bool mStepRunning;
+		int mBatchSize;
+		int mBatchRemaining;
+		QVector<double> mBatchOutputFrames;
 	};
 
 }
@@ -67,7 +67,8 @@ using namespace std;
 namespace nerd {
 
 SeedUDPClientHandler::SeedUDPClientHandler(SeedUDPCommunication *owner,
-							const QHostAddress &clientAddress, quint16 clientPort)
+							const QHostAddress &clientAddress, quint16 clientPort,
+							int minorProtocolId)
 				: mOwner(owner), mRunCommunicationLoop(true), mCommunicationLoopRunning(false),
 					mCountNextStepCommands(0), mClientRunner(0),
 					mClientAddress(clientAddress), mClientPort(clientPort),
@@ -76,7 +77,8 @@ SeedUDPClientHandler::SeedUDPClientHandler(SeedUDPCommunication *owner,
 					mSendConnectionInfoMessage(false),
 					mSendCommunicationResetInfoMessage(false),
 					mSendResetCompletedMessage(false),
-					mSendStepCompletedMessage(false)
+					mSendStepCompletedMessage(false),
+					mMinorProtocolId(minorProtocolId), mStepTimerRunning(false)
 {
 }
 
@@ -202,6 +204,9 @@ void SeedUDPClientHandler::runCommunication() {
 			case SeedUDPCommunication::UDP_NEXT_SIMULATION_STEP:
 				handleNextStepCommand();
 				break;
+			case SeedUDPCommunication::UDP_NEXT_SIMULATION_STEPS:
+				handleNextStepsCommand();
+				break;
 			case SeedUDPCommunication::UDP_END_COMMUNICATION:
 				handleEndCommunicationCommand();
 				break;
@@ -255,8 +260,8 @@ void SeedUDPClientHandler::datagramReceived() {
 
 		mDatagrams.append(data);
 	}
-	mSocketMutex.unlock();
 	mReadWaitCondition.wakeAll();
+	mSocketMutex.unlock();
 }
 
 
@@ -264,24 +269,17 @@ bool SeedUDPClientHandler::waitForNextDatagram() {
 	return waitForNextDatagram(false);
 }
 
+/**
+ * Waits for the next datagram of the client. The datagram list and the message flags
+ * are checked with the same mutex that is used for the notifications, so the handler 
+ * wakes up immediately when a datagram arrives or (if interruptible) when a message
+ * has to be sent. The timeout only serves to notice a stopped communication loop.
+ */
 bool SeedUDPClientHandler::waitForNextDatagram(bool interruptible) {
 
-	//TODO use mutex to lock against read events while checking.
-	mSocketMutex.lock();
-	if(!mDatagrams.isEmpty()) {
-		mReadDatagram.setData(mDatagrams.first());
-		mDatagrams.removeFirst();
-		mSocketMutex.unlock();
-		return true;
-	}
-	mSocketMutex.unlock();
-
-	bool notified = false;
-	do {
-		mReadMutex.lock();
-		notified = mReadWaitCondition.wait(&mReadMutex, 50);
-		mReadMutex.unlock();
+	QMutexLocker locker(&mSocketMutex);
 
+	while(mDatagrams.isEmpty() && mRunCommunicationLoop) {
 		if(interruptible) {
 			if(mSendResetCompletedMessage || mSendStepCompletedMessage
 				|| mSendCommunicationResetInfoMessage || mSendConnectionInfoMessage)
@@ -289,31 +287,16 @@ bool SeedUDPClientHandler::waitForNextDatagram(bool interruptible) {
 				break;
 			}
 		}
-		if(!mRunCommunicationLoop) {
-			break;
-		}
-		if(!mDatagrams.isEmpty()) {
-			break;
-		}
-
-	} while(!notified || (mDatagrams.isEmpty() && !interruptible));
-
-	mSocketMutex.lock();
-
-	//mDatagramMutex.lock();
-	bool receivedData = true;
+		mReadWaitCondition.wait(&mSocketMutex, 50);
+	}
 
 	if(mDatagrams.isEmpty()) {
 		mReadDatagram.clear();
-		receivedData = false;
-	}
-	else {
-		mReadDatagram.setData(mDatagrams.first());
-		mDatagrams.removeFirst();
+		return false;
 	}
-	//mDatagramMutex.unlock();
-	mSocketMutex.unlock();
-	return receivedData;
+	mReadDatagram.setData(mDatagrams.first());
+	mDatagrams.removeFirst();
+	return true;
 }
 
 
@@ -384,7 +367,7 @@ bool SeedUDPClientHandler::executeSendConnectionInformation() {
 	mWriteDatagram.clear();
 	mWriteDatagram.writeByte(SeedUDPCommunication::UDP_INIT_COMMUNICATION_ACK);
 	mWriteDatagram.writeByte(1);
-	mWriteDatagram.writeByte(1);
+	mWriteDatagram.writeByte(mMinorProtocolId);
 	sendDatagram();
 
 	return true;
@@ -422,6 +405,12 @@ bool SeedUDPClientHandler::executeSendSimulationResetMessage() {
 }
 
 
+/**
+ * Sends the sensor data of all interface groups after a completed simulation step.
+ * Groups that are executing a batch of steps only collect their sensor frame until 
+ * the batch is complete. Afterwards the next queued motor frame of each group 
+ * (pipelined or batched step commands) is applied and the next step is requested.
+ */
 bool SeedUDPClientHandler::executeSendStepCompletedMessage() {
 
 	mSendStepCompletedMessage = false;
@@ -432,6 +421,21 @@ bool SeedUDPClientHandler::executeSendStepCompletedMessage() {
 		int id = ids.at(i);
 
 		InterfaceGroup *group = mInterfaceGroups.value(id);
+		group->mStepRunning = false;
+
+		if(group->mBatchSize > 0) {
+			for(int j = 0; j < group->mOutputValues.size(); ++j) {
+				group->mBatchOutputFrames.append(group->mOutputValues.at(j)->get());
+			}
+			for(int j = 0; j < group->mInfoValues.size(); ++j) {
+				group->mBatchOutputFrames.append(group->mInfoValues.at(j)->get());
+			}
+			--group->mBatchRemaining;
+			if(group->mBatchRemaining <= 0) {
+				sendBatchCompletedMessage(group);
+			}
+			continue;
+		}
 
 		mWriteDatagram.clear();
 		mWriteDatagram.writeByte(SeedUDPCommunication::UDP_NEXT_SIMULATION_STEP_COMPLETED);
@@ -456,19 +460,127 @@ bool SeedUDPClientHandler::executeSendStepCompletedMessage() {
 
 		sendDatagram();
 
-		if(!waitForConfirmation(SeedUDPCommunication::UDP_NEXT_SIMULATION_STEP_COMPLETED_ACK)) {
+		//NSP 1.2 clients do not acknowledge completed steps.
+		if(mMinorProtocolId < 2 
+			&& !waitForConfirmation(SeedUDPCommunication::UDP_NEXT_SIMULATION_STEP_COMPLETED_ACK)) 
+		{
 			return false;
 		}
 	}
 
+	if(mStepTimerRunning && mOwner != 0) {
+		mOwner->reportStepLatency(((double) mStepTimer.nsecsElapsed()) / 1000000.0);
+		mStepTimerRunning = false;
+	}
+
 	mCountNextStepCommands = 0;
+
+	for(int i = 0; i < ids.size(); ++i) {
+		startNextQueuedStep(mInterfaceGroups.value(ids.at(i)));
+	}
+	return true;
+}
+
+
+/**
+ * Sends all collected sensor frames of a completed batch. The frames are split
+ * into as few datagrams as possible (see createBatchCompletedDatagrams()).
+ * The events contain all registered events that occurred during the batch.
+ */
+bool SeedUDPClientHandler::sendBatchCompletedMessage(InterfaceGroup *group) {
+	if(group == 0) {
+		return false;
+	}
+
+	QList<int> eventIds;
+	for(int j = 0; j < mOccuredEvents.size(); ++j) {
+		eventIds.append(mRegisteredEvents.value(mOccuredEvents.at(j)));
+	}
+	mOccuredEvents.clear();
+
+	QList<QByteArray> datagrams = createBatchCompletedDatagrams(*group, eventIds);
+
+	if(mUdpSocket != 0 && mUdpSocket->isValid()) {
+		for(int i = 0; i < datagrams.size(); ++i) {
+			mUdpSocket->write(datagrams.at(i));
+		}
+	}
+
+	group->mBatchSize = 0;
+	group->mBatchRemaining = 0;
+	group->mBatchOutputFrames.clear();
+
 	return true;
 }
 
 
+/**
+ * Creates the UDP_NEXT_SIMULATION_STEPS_COMPLETED datagrams for the collected sensor 
+ * frames of a batch. Each datagram contains a range of consecutive frames:
+ *
+ * UDP_NEXT_SIMULATION_STEPS_COMPLETED | groupId | firstFrame | numberOfFrames 
+ *         | numberOfOutputs | numberOfInfos | numberOfEvents | frames... | eventIds...
+ *
+ * No datagram is larger than maxDatagramSize bytes, unless a single frame alone exceeds 
+ * that size. The events are only attached to the last datagram of the batch, so a 
+ * client knows that the batch is complete when firstFrame + numberOfFrames equals the
+ * number of requested steps.
+ */
+QList<QByteArray> SeedUDPClientHandler::createBatchCompletedDatagrams(const InterfaceGroup &group,
+						const QList<int> &eventIds, int maxDatagramSize)
+{
+	QList<QByteArray> datagrams;
+
+	int frameSize = group.mOutputValues.size() + group.mInfoValues.size();
+	int numberOfFrames = group.mBatchSize;
+	if(frameSize > 0) {
+		numberOfFrames = group.mBatchOutputFrames.size() / frameSize;
+	}
+
+	//header: command byte, 6 ints, end byte. 
+	int availableSize = maxDatagramSize - (2 + 6 * 4) - (eventIds.size() * 4);
+	int framesPerDatagram = numberOfFrames;
+	if(frameSize > 0) {
+		framesPerDatagram = qMax(1, availableSize / (frameSize * 4));
+	}
+
+	UdpDatagram datagram;
+	int firstFrame = 0;
+	do {
+		int count = qMin(framesPerDatagram, numberOfFrames - firstFrame);
+		bool lastDatagram = (firstFrame + count) >= numberOfFrames;
+
+		datagram.clear();
+		datagram.writeByte(SeedUDPCommunication::UDP_NEXT_SIMULATION_STEPS_COMPLETED);
+		datagram.writeInt(group.mId);
+		datagram.writeInt(firstFrame);
+		datagram.writeInt(count);
+		datagram.writeInt(group.mOutputValues.size());
+		datagram.writeInt(group.mInfoValues.size());
+		datagram.writeInt(lastDatagram ? eventIds.size() : 0);
+
+		int end = (firstFrame + count) * frameSize;
+		for(int j = firstFrame * frameSize; j < end; ++j) {
+			datagram.writeFloat(group.mBatchOutputFrames.at(j));
+		}
+		if(lastDatagram) {
+			for(int j = 0; j < eventIds.size(); ++j) {
+				datagram.writeInt(eventIds.at(j));
+			}
+		}
+		datagram.writeByte(SeedUDPCommunication::UDP_DATAGRAM_END);
+		datagrams.append(datagram.getData());
+
+		firstFrame += count;
+	} while(firstFrame < numberOfFrames);
+
+	return datagrams;
+}
+
 
 bool SeedUDPClientHandler::sendConnectionInformation() {
 
+	QMutexLocker locker(&mSocketMutex);
 	mSendConnectionInfoMessage = true;
 	mReadWaitCondition.wakeAll();
 	return true;
@@ -476,6 +588,7 @@ bool SeedUDPClientHandler::sendConnectionInformation() {
 
 bool SeedUDPClientHandler::sendCommunicationResetMessage() {
 
+	QMutexLocker locker(&mSocketMutex);
 	mSendCommunicationResetInfoMessage = true;
 	mReadWaitCondition.wakeAll();
 	return true;
@@ -483,6 +596,7 @@ bool SeedUDPClientHandler::sendCommunicationResetMessage() {
 
 bool SeedUDPClientHandler::sendSimulationResetMessage() {
 
+	QMutexLocker locker(&mSocketMutex);
 	mSendResetCompletedMessage = true;
 	mReadWaitCondition.wakeAll();
 	return true;
@@ -490,6 +604,7 @@ bool SeedUDPClientHandler::sendSimulationResetMessage() {
 
 bool SeedUDPClientHandler::sendStepCompletedMessage() {
 
+	QMutexLocker locker(&mSocketMutex);
 	mSendStepCompletedMessage = true;
 	mReadWaitCondition.wakeAll();
 	return true;
@@ -961,6 +1076,8 @@ bool SeedUDPClientHandler::handleAgentDeregistrationCommand() {
 
 
 bool SeedUDPClientHandler::handleResetSimulationCommand() {
+	clearPendingSteps();
+
 	if(mOwner == 0) {
 		return false;
 	}
@@ -982,6 +1099,8 @@ bool SeedUDPClientHandler::handleResetSimulationCommand() {
 
 
 bool SeedUDPClientHandler::handleResetCommunicationCommand() {
+	clearPendingSteps();
+
 	if(mOwner == 0) {
 		return false;
 	}
@@ -991,6 +1110,12 @@ bool SeedUDPClientHandler::handleResetCommunicationCommand() {
 }
 
 
+/**
+ * Handles a single step command: groupId | numberOfInputs | inputs...
+ * The motor frame is queued and applied as soon as the currently running step 
+ * of the group (if any) is completed. This allows NSP 1.2 clients to send the 
+ * command for step N+1 while step N is still executed.
+ */
 bool SeedUDPClientHandler::handleNextStepCommand() {
 
 	if(mOwner == 0) {
@@ -1008,6 +1133,86 @@ bool SeedUDPClientHandler::handleNextStepCommand() {
 		return false;
 	}
 
+	if(!readMotorFrames(group, 1, -1)) {
+		return false;
+	}
+
+	mWriteDatagram.clear();
+	mWriteDatagram.writeByte(SeedUDPCommunication::UDP_NEXT_SIMULATION_STEP_ACK);
+	mWriteDatagram.writeInt(groupId);
+	sendDatagram();
+
+	startNextQueuedStep(group);
+
+	return true;
+}
+
+
+/**
+ * Handles a batch of step commands (NSP 1.2 only): 
+ * groupId | numberOfSteps | numberOfInputs | inputs of step 1... | inputs of step n...
+ * The command is acknowledged with the number of accepted steps (0 if rejected).
+ * The sensor data of all steps is sent with UDP_NEXT_SIMULATION_STEPS_COMPLETED
+ * datagrams after the last step of the batch (see createBatchCompletedDatagrams()).
+ */
+bool SeedUDPClientHandler::handleNextStepsCommand() {
+
+	if(mOwner == 0) {
+		return false;
+	}
+
+	int groupId = mReadDatagram.readNextInt();
+	int numberOfSteps = mReadDatagram.readNextInt();
+
+	InterfaceGroup *group = mInterfaceGroups.value(groupId);
+
+	bool accept = true;
+	if(group == 0) {
+		Core::log(QString("SeedUDPClientHandler Failure: Received next steps "
+				"command with wrong group id ").append(QString::number(groupId)));
+		accept = false;
+	}
+	else if(mMinorProtocolId < 2) {
+		Core::log("SeedUDPClientHandler Failure: Batched steps require protocol NSP 1.2");
+		accept = false;
+	}
+	else if(numberOfSteps < 1 || numberOfSteps > mOwner->getMaximalBatchSize()) {
+		Core::log(QString("SeedUDPClientHandler Failure: Invalid number of batched steps ")
+				.append(QString::number(numberOfSteps)));
+		accept = false;
+	}
+
+	if(accept && !readMotorFrames(group, numberOfSteps, numberOfSteps)) {
+		accept = false;
+	}
+
+	mWriteDatagram.clear();
+	mWriteDatagram.writeByte(SeedUDPCommunication::UDP_NEXT_SIMULATION_STEPS_ACK);
+	mWriteDatagram.writeInt(groupId);
+	mWriteDatagram.writeInt(accept ? numberOfSteps : 0);
+	sendDatagram();
+
+	if(!accept) {
+		return false;
+	}
+
+	startNextQueuedStep(group);
+
+	return true;
+}
+
+
+/**
+ * Reads numberOfInputs followed by numberOfFrames motor frames from the current
+ * datagram and appends them to the input queue of the group. 
+ * 
+ * @param batchSize the number of steps of the batch (>0), or -1 for a single step
+ *        that is answered with a UDP_NEXT_SIMULATION_STEP_COMPLETED message.
+ */
+bool SeedUDPClientHandler::readMotorFrames(InterfaceGroup *group, int numberOfFrames, int batchSize) {
+	if(group == 0) {
+		return false;
+	}
 
 	int numberOfInputs = mReadDatagram.readNextInt();
 
@@ -1017,21 +1222,76 @@ bool SeedUDPClientHandler::handleNextStepCommand() {
 				.append(" unequal to number of controlled inputs ")
 				.append(QString::number(group->mInputValues.size())));
 	}
+	if(numberOfInputs < 0 || mReadDatagram.maxUnreadBytes() < numberOfFrames * numberOfInputs * 4) {
+		Core::log("SeedUDPClientHandler Failure: Step command contains less data than announced.");
+		return false;
+	}
 
-	for(int i = 0; i < numberOfInputs && i < group->mInputValues.size(); ++i) {
-		group->mInputValues.at(i)->setNormalized(mReadDatagram.readNextFloat());
+	for(int i = 0; i < numberOfFrames; ++i) {
+		QVector<double> frame(numberOfInputs);
+		for(int j = 0; j < numberOfInputs; ++j) {
+			frame[j] = mReadDatagram.readNextFloat();
+		}
+		group->mPendingInputFrames.append(frame);
+
+		//only the first frame of a batch carries the batch size, the others are marked with 0.
+		group->mPendingBatchSizes.append(i == 0 ? batchSize : 0);
 	}
+	return true;
+}
 
-	mWriteDatagram.clear();
-	mWriteDatagram.writeByte(SeedUDPCommunication::UDP_NEXT_SIMULATION_STEP_ACK);
-	mWriteDatagram.writeInt(groupId);
-	sendDatagram();
+
+/**
+ * Applies the next queued motor frame of the group and requests the next simulation 
+ * step, unless the group is still waiting for the completion of a previous step.
+ */
+void SeedUDPClientHandler::startNextQueuedStep(InterfaceGroup *group) {
+	if(group == 0 || mOwner == 0 || group->mStepRunning || group->mPendingInputFrames.empty()) {
+		return;
+	}
+
+	QVector<double> frame = group->mPendingInputFrames.takeFirst();
+	int batchSize = group->mPendingBatchSizes.takeFirst();
+
+	if(batchSize > 0) {
+		group->mBatchSize = batchSize;
+		group->mBatchRemaining = batchSize;
+		group->mBatchOutputFrames.clear();
+		group->mBatchOutputFrames.reserve(batchSize 
+				* (group->mOutputValues.size() + group->mInfoValues.size()));
+	}
+	else if(batchSize < 0) {
+		group->mBatchSize = 0;
+	}
+
+	for(int i = 0; i < frame.size() && i < group->mInputValues.size(); ++i) {
+		group->mInputValues.at(i)->setNormalized(frame.at(i));
+	}
+
+	group->mStepRunning = true;
+	if(!mStepTimerRunning) {
+		mStepTimer.start();
+		mStepTimerRunning = true;
+	}
 
 	mOwner->demandNextSimulationStep(this);
+}
 
-	return true;
+/**
+ * Drops the queued motor frames and running batches of all interface groups. 
+ * Called when the client resets the simulation or the communication, because 
+ * the client does not expect answers for steps requested before the reset.
+ */
+void SeedUDPClientHandler::clearPendingSteps() {
+	QList<InterfaceGroup*> groups = mInterfaceGroups.values();
+	for(int i = 0; i < groups.size(); ++i) {
+		groups.at(i)->clearPendingSteps();
+	}
+	mCountNextStepCommands = 0;
+	mStepTimerRunning = false;
 }
 
+
 bool SeedUDPClientHandler::handleEndCommunicationCommand() {
 
 	mWriteDatagram.clear();
@@ -52,6 +52,7 @@
 #include <QWaitCondition>
 #include <QMutex>
 #include <QSemaphore>
+#include <QElapsedTimer>
 #include "Value/Value.h"
 #include "Value/InterfaceValue.h"
 #include "Event/EventListener.h"
@@ -73,9 +74,13 @@ namespace nerd {
 	class SeedUDPClientHandler : public QThread, public virtual EventListener {
 	Q_OBJECT
 	
+	public:
+		static const int MAX_DATAGRAM_SIZE = 8192;
+
 	public:
 		SeedUDPClientHandler(SeedUDPCommunication *owner, 
-						const QHostAddress &clientAddress, quint16 clientPort);
+						const QHostAddress &clientAddress, quint16 clientPort,
+						int minorProtocolId = 1);
 
 		virtual ~SeedUDPClientHandler();
 		
@@ -100,6 +105,9 @@ namespace nerd {
 		
 		
 		virtual void reportCommunicationFailure(const QString &message);
+
+		static QList<QByteArray> createBatchCompletedDatagrams(const InterfaceGroup &group,
+						const QList<int> &eventIds, int maxDatagramSize = MAX_DATAGRAM_SIZE);
 		
 	public slots:
 		void datagramReceived();
@@ -127,6 +135,12 @@ namespace nerd {
 		virtual bool handleResetSimulationCommand();
 		virtual bool handleResetCommunicationCommand();
 		virtual bool handleNextStepCommand();
+		virtual bool handleNextStepsCommand();
+		
+		virtual bool readMotorFrames(InterfaceGroup *group, int numberOfFrames, int batchSize);
+		virtual void startNextQueuedStep(InterfaceGroup *group);
+		virtual bool sendBatchCompletedMessage(InterfaceGroup *group);
+		virtual void clearPendingSteps();
 
 		virtual bool handleEndCommunicationCommand();
 		
@@ -148,7 +162,6 @@ namespace nerd {
 		QHash<Event*, int> mRegisteredEvents;
 		QList<Event*> mOccuredEvents;
 		
-		QMutex mReadMutex;
 		QMutex mSocketMutex;
 		QMutex mDatagramMutex;
 		QMutex mSendMutex;
@@ -173,6 +186,10 @@ namespace nerd {
 		bool mSendCommunicationResetInfoMessage;
 		bool mSendResetCompletedMessage;
 		bool mSendStepCompletedMessage;
+		
+		int mMinorProtocolId;
+		QElapsedTimer mStepTimer;
+		bool mStepTimerRunning;
 
 
 	};
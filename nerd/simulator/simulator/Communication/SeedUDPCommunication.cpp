@@ -53,6 +53,7 @@
 #include <QCoreApplication>
 #include <QFile>
 #include <QTextStream>
+#include <QElapsedTimer>
 #include "NerdConstants.h"
 
 using namespace std;
@@ -69,9 +70,21 @@ SeedUDPCommunication::SeedUDPCommunication() : mUdpServerSocket(0),
 	Core::getInstance()->addSystemObject(this);
 
 	mPortValue = new IntValue(45454);
+	mMaxBatchSize = new IntValue(64);
+	mStepDuration = new DoubleValue(0.0);
+	mStepLatency = new DoubleValue(0.0);
+
+	mMaxBatchSize->setDescription("The maximal number of steps a client may request with a "
+						"single UDP_NEXT_SIMULATION_STEPS command (NSP 1.2).");
+	mStepDuration->setDescription("The execution time of the last simulation step in ms.");
+	mStepLatency->setDescription("The time in ms between the reception of the last step command "
+						"and the transmission of the corresponding sensor data.");
 
 	ValueManager *vm = Core::getInstance()->getValueManager();
 	vm->addValue("/UDPCommunication/ServerPort", mPortValue);
+	vm->addValue("/UDPCommunication/MaxBatchSize", mMaxBatchSize);
+	vm->addValue("/UDPCommunication/Performance/StepDuration", mStepDuration);
+	vm->addValue("/UDPCommunication/Performance/StepLatency", mStepLatency);
 
 	mLastReceivedHostAddress = new QHostAddress();
 	mLastReceivedPort = 0;
@@ -158,7 +171,7 @@ void SeedUDPCommunication::startListening(QThread *owner) {
 
 	Core::getInstance()->registerThread(this);
 
-	cerr << "Nerd NSP 1.1 server listening at port " << mPortValue->get() << endl;
+	cerr << "Nerd NSP 1.2 server listening at port " << mPortValue->get() << endl;
 	Core::log(QString("SeedUDPCommunication: Starting listening at port ")
 			.append(QString::number(mPortValue->get())));
 
@@ -228,10 +241,10 @@ bool SeedUDPCommunication::startUdpServer() {
 			int majorProtocolId = mReadDatagram.readNextByte();
 			int minorProtocolId = mReadDatagram.readNextByte();
 
-			if(majorProtocolId == 1 && minorProtocolId == 1) {
+			if(majorProtocolId == 1 && (minorProtocolId == 1 || minorProtocolId == 2)) {
 
 				SeedUDPClientHandler *clientHandler = new SeedUDPClientHandler(this,
-						*mLastReceivedHostAddress, mLastReceivedPort);
+						*mLastReceivedHostAddress, mLastReceivedPort, minorProtocolId);
 
 				Core::getInstance()->registerThread(clientHandler);
 
@@ -314,24 +327,25 @@ void SeedUDPCommunication::datagramReceived() {
 											mLastReceivedHostAddress, &mLastReceivedPort);
 		mDatagrams.append(data);
 	}
-	mSocketMutex.unlock();
-
 	mReadWaitCondition.wakeAll();
+	mSocketMutex.unlock();
 }
 
 
+/**
+ * Waits until a datagram arrives or until there is other work for the server loop
+ * (step and reset requests of the client handlers). The wait condition is checked
+ * and waited for with the same mutex that guards the notifications, so no wakeup
+ * can get lost. The timeout only ensures that the pending tasks of the Core are 
+ * executed when the server is idle.
+ */
 void SeedUDPCommunication::waitForNextDatagram() {
 
-	//TODO use mutex to lock against read events while checking.
 	mSocketMutex.lock();
 
-	mSocketMutex.unlock();
-
-	mReadMutex.lock();
-	mReadWaitCondition.wait(&mReadMutex, 5);
-	mReadMutex.unlock();
-
-	mSocketMutex.lock();
+	if(!hasPendingWork()) {
+		mReadWaitCondition.wait(&mSocketMutex, 20);
+	}
 
 	if(mDatagrams.isEmpty()) {
 		mReadDatagram.clear();
@@ -346,11 +360,13 @@ void SeedUDPCommunication::waitForNextDatagram() {
 
 
 void SeedUDPCommunication::demandCommunicationReset() {
+	QMutexLocker locker(&mSocketMutex);
 	mResetCommunicationRequest = true;
 	mReadWaitCondition.wakeAll();
 }
 
 void SeedUDPCommunication::demandSimulationReset(SeedUDPClientHandler*, int seed) {
+	QMutexLocker locker(&mSocketMutex);
 
 	mSeed = seed;
 	mResetRequestCounter--;
@@ -364,6 +380,8 @@ void SeedUDPCommunication::demandSimulationReset(SeedUDPClientHandler*, int seed
 
 
 void SeedUDPCommunication::demandNextSimulationStep(SeedUDPClientHandler*) {
+	QMutexLocker locker(&mSocketMutex);
+
 	mNextStepRequestCounter--;
 
 	if(mNextStepRequestCounter < 0){
@@ -380,6 +398,23 @@ void SeedUDPCommunication::terminateCliendHandler(SeedUDPClientHandler *handler)
 		mHandlersToTerminate.append(handler);
 	}
 	mGroupControllerMutex.unlock();
+
+	QMutexLocker locker(&mSocketMutex);
+	mReadWaitCondition.wakeAll();
+}
+
+
+/**
+ * Called by the client handlers to report the time (in ms) between the reception of 
+ * a step command and the transmission of the resulting sensor data.
+ */
+void SeedUDPCommunication::reportStepLatency(double latency) {
+	mStepLatency->set(latency);
+}
+
+
+int SeedUDPCommunication::getMaximalBatchSize() const {
+	return mMaxBatchSize->get();
 }
 
 
@@ -487,14 +522,43 @@ void SeedUDPCommunication::resetSimulation() {
 }
 
 
+/**
+ * Returns true if the server loop has to process something without waiting.
+ * Has to be called with a locked mSocketMutex. The handler and group lists are
+ * checked with the mGroupControllerMutex.
+ */
+bool SeedUDPCommunication::hasPendingWork() const {
+	if(!mDatagrams.isEmpty() || mResetCommunicationRequest) {
+		return true;
+	}
+	QMutexLocker guard(&mGroupControllerMutex);
+	if(!mHandlersToTerminate.empty()) {
+		return true;
+	}
+	if(!mControlledObjectGroups.isEmpty() 
+		&& (mNextStepRequestCounter <= 0 || mResetRequestCounter <= 0)) 
+	{
+		return true;
+	}
+	return false;
+}
+
+
 void SeedUDPCommunication::executeNextStep() {
 
+	QElapsedTimer timer;
+	timer.start();
+
 	if(mNextStepEvent != 0 && mStepCompletedEvent != 0) {
 		mNextStepEvent->trigger();
 		mStepCompletedEvent->trigger();
 	}
 
+	mStepDuration->set(((double) timer.nsecsElapsed()) / 1000000.0);
+
+	mSocketMutex.lock();
 	mNextStepRequestCounter = mControlledObjectGroups.size();
+	mSocketMutex.unlock();
 
 	for(int i = 0; i < mClientHandlers.size(); ++i) {
 		mClientHandlers.at(i)->sendStepCompletedMessage();
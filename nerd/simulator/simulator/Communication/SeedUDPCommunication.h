@@ -54,6 +54,7 @@
 #include <QMutex>
 #include "Event/Event.h"
 #include "Value/IntValue.h"
+#include "Value/DoubleValue.h"
 #include "Communication/SeedUDPClientHandler.h"
 #include "Physics/SimObjectGroup.h"
 #include "Value/StringValue.h"
@@ -64,6 +65,15 @@ namespace nerd {
 
 	/**
 	 * SeedUDPCommunication
+	 *
+	 * Protocol NSP 1.1 executes each step in a strict request / acknowledge lockstep.
+	 * With protocol NSP 1.2 (requested with minor protocol id 2 during 
+	 * UDP_INIT_COMMUNICATION) the client does not acknowledge completed steps, 
+	 * may send the command for the next step before the current step is completed 
+	 * (pipelining) and may send batches of motor frames with UDP_NEXT_SIMULATION_STEPS, 
+	 * which are answered with UDP_NEXT_SIMULATION_STEPS_COMPLETED datagrams
+	 * containing all sensor frames of the batch. Large batches are split into 
+	 * several datagrams of at most SeedUDPClientHandler::MAX_DATAGRAM_SIZE bytes.
 	 */
 	class SeedUDPCommunication : public QThread, public virtual SystemObject {
 	Q_OBJECT
@@ -102,8 +112,11 @@ namespace nerd {
 		static const unsigned char UDP_RESET_SIMULATION_COMPLETED_ACK = 76;
 		static const unsigned char UDP_NEXT_SIMULATION_STEP = 80;
 		static const unsigned char UDP_NEXT_SIMULATION_STEP_ACK = 81;
+		static const unsigned char UDP_NEXT_SIMULATION_STEPS = 82;
+		static const unsigned char UDP_NEXT_SIMULATION_STEPS_ACK = 83;
 		static const unsigned char UDP_NEXT_SIMULATION_STEP_COMPLETED = 85;
 		static const unsigned char UDP_NEXT_SIMULATION_STEP_COMPLETED_ACK = 86;
+		static const unsigned char UDP_NEXT_SIMULATION_STEPS_COMPLETED = 87;
 
 		static const unsigned char UDP_GET_AGENT_OVERVIEW = 90;
 		static const unsigned char UDP_AGENT_OVERVIEW = 91;
@@ -147,6 +160,8 @@ namespace nerd {
 		void demandSimulationReset(SeedUDPClientHandler *handler, int seed);
 		void demandNextSimulationStep(SeedUDPClientHandler *handler);
 		void terminateCliendHandler(SeedUDPClientHandler *handler);
+		void reportStepLatency(double latency);
+		int getMaximalBatchSize() const;
 
 		bool registerGroupController(SimObjectGroup *groupToControl,
 																SeedUDPClientHandler *controller);
@@ -161,6 +176,7 @@ namespace nerd {
 		virtual void resetCommunication();
 		virtual void resetSimulation();
 		virtual void executeNextStep();
+		virtual bool hasPendingWork() const;
 
 	private:
 		Event *mResetEvent;
@@ -170,6 +186,9 @@ namespace nerd {
 
 		QUdpSocket *mUdpServerSocket;
 		IntValue *mPortValue;
+		IntValue *mMaxBatchSize;
+		DoubleValue *mStepDuration;
+		DoubleValue *mStepLatency;
 		QHostAddress *mLastReceivedHostAddress;
 		quint16 mLastReceivedPort;
 
@@ -180,9 +199,8 @@ namespace nerd {
 		bool mResetCommunicationRequest;
 
 		QHash<SimObjectGroup*, SeedUDPClientHandler*> mControlledObjectGroups;
-		QMutex mGroupControllerMutex;
+		mutable QMutex mGroupControllerMutex;
 
-		QMutex mReadMutex;
 		QMutex mSocketMutex;
 		QWaitCondition mReadWaitCondition;
 		QList<QByteArray> mDatagrams;
@@ -172,13 +172,14 @@ void SimbaUDPCommunication::datagramReceived() {
 	}
 	
 	mSocketMutex.lock();
-	QByteArray data(mUdpSocket->pendingDatagramSize(), 0);
-	mUdpSocket->readDatagram(data.data(), data.size(), 
+	while(mUdpSocket->hasPendingDatagrams()) {
+		QByteArray data(mUdpSocket->pendingDatagramSize(), 0);
+		mUdpSocket->readDatagram(data.data(), data.size(), 
   						mLastReceivedHostAddress, &mLastReceivedPort);
-	mDatagrams.append(data);
-	mSocketMutex.unlock();
-
+		mDatagrams.append(data);
+	}
 	mReadWaitCondition.wakeAll();
+	mSocketMutex.unlock();
 
 }
 
@@ -298,7 +299,10 @@ void SimbaUDPCommunication::setPort(int port) {
 
 
 void SimbaUDPCommunication::stopCommunication() {
+	mSocketMutex.lock();
 	mRunCommunicationLoop = false;
+	mReadWaitCondition.wakeAll();
+	mSocketMutex.unlock();
 
 	if(QThread::currentThread() != this) {
 		wait();
@@ -580,98 +584,36 @@ void SimbaUDPCommunication::startUDPServer() {
 }
 
 
+/**
+ * Waits for the next datagram. The datagram list is checked and waited for 
+ * with the same mutex that is used by datagramReceived(), so the method returns
+ * as soon as a datagram arrives. The pending tasks of the Core are executed 
+ * whenever the wait times out.
+ */
 bool SimbaUDPCommunication::waitForNextDatagram() {
 
-	bool interruptible = false;
-
 	Core::getInstance()->executePendingTasks();
 
-	//TODO use mutex to lock against read events while checking.
 	mSocketMutex.lock();
-	if(!mDatagrams.isEmpty()) {
-		mData = mDatagrams.first();
-		mDatagrams.removeFirst();
-		mSocketMutex.unlock();
-// 		cerr << "Found one that wa savailable" << endl;
-		return true;
-	}
-	mSocketMutex.unlock();
-
-	bool notified = false;
-// 	cerr << "checking for next datagram" << endl;
-
-	int pendingTaskCounter = 0;
-
-	do {
-		mReadMutex.lock();
-		notified = mReadWaitCondition.wait(&mReadMutex, 50);
-		mReadMutex.unlock();
-
-		if(++pendingTaskCounter > 5) {
-			pendingTaskCounter = 0;
+	while(mDatagrams.isEmpty() && mRunCommunicationLoop) {
+		if(!mReadWaitCondition.wait(&mSocketMutex, 50)) {
+			mSocketMutex.unlock();
 			Core::getInstance()->executePendingTasks();
+			mSocketMutex.lock();
 		}
-
-		if(!mRunCommunicationLoop) {
-			return false;
-		}
-		if(!mDatagrams.isEmpty()) {
-			break;
-		}
-
-	} while((!notified || (mDatagrams.isEmpty() && !interruptible)) && mRunCommunicationLoop);
+	}
 
 	if(!mRunCommunicationLoop) {
+		mSocketMutex.unlock();
 		return false;
 	}
 
-// 	cerr << "Done checking for next datagram" << endl;
+	mData = mDatagrams.first();
+	mDatagrams.removeFirst();
 
-	mSocketMutex.lock();
-
-	//mDatagramMutex.lock();
-	//bool receivedData = true;
-
-	if(mDatagrams.isEmpty()) {
-		mData.clear();
-		//receivedData = false;
-	}
-	else {
-		mData = mDatagrams.first();
-		mDatagrams.removeFirst();
-	}
-	//mDatagramMutex.unlock();
 	mSocketMutex.unlock();
 
 	return true;
-
-// 	//TODO use mutex to lock against read events while checking.
-// 	mSocketMutex.lock();
-// 	while(mRunCommunicationLoop && mDatagrams.size() <= 0) {
-// 		mSocketMutex.unlock();
-// 		
-// 		bool gotDatagram = false;
-// 		while(!gotDatagram && mRunCommunicationLoop) {
-// 			mReadMutex.lock();
-// 			gotDatagram = mReadWaitCondition.wait(&mReadMutex, 100);
-// 			mReadMutex.unlock();
-// 
-// 			if(!gotDatagram) {
-// 				Core::getInstance()->executePendingTasks();
-// 			}
-// 		}
-// 		
-// 		if(!mRunCommunicationLoop) {
-// 			mDataPosition = 0;
-// 			return;
-// 		}
-// 		mSocketMutex.lock();
-// 	};
-// 	mData = mDatagrams.first();
-// 	mDatagrams.removeFirst();
-// 	mDataPosition = 0;
-// 	
-// 	mSocketMutex.unlock();
 }
 
 void SimbaUDPCommunication::sendHandShakeInformation() {
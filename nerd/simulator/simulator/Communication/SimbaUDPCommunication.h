@@ -128,7 +128,6 @@ namespace nerd {
 		QByteArray mData;
 		int mDataPosition;
 		
-		QMutex mReadMutex;
 		QMutex mSocketMutex;
 		QSemaphore mSocketSemaphore;
 		bool mRunCommunicationLoop;
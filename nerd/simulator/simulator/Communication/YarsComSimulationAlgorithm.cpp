@@ -59,6 +59,7 @@
 #include "SimulationConstants.h"
 #include <QThread>
 #include <QTime>
+#include <QElapsedTimer>
 
 
 using namespace std;
@@ -76,7 +77,7 @@ YarsComSimulationAlgorithm::YarsComSimulationAlgorithm()
 	  mDebug(false), mRobotStates(0), mAgentInterface(0), mAgentObject(0), mShutDownEvent(0),
 	  mTerminateTryEvent(0), mSocket(0), mAddress(0), mSendBuffer(0),
 	  mRecBuffer(0), mCurrentTry(0), mSeedValue(0), mGeneration(0), mResetRequested(false),
-	  mSendXML(true)
+	  mSendXML(true), mUsingSharedMemory(false)
 {
 	//create the agent interface as control interface to the neural networks.
 	mAgentInterface = new SimObjectGroup("Yars", "Agent");
@@ -92,6 +93,8 @@ YarsComSimulationAlgorithm::YarsComSimulationAlgorithm()
 	mConnectToYars = new BoolValue(false);
 	mPort = new IntValue(_STANDARD_COMPORT_SERVER);
 	mTerminateTryAtAbortSignal = new BoolValue(false);
+	mStepLatency = new DoubleValue(0.0);
+	mUseSharedMemory = new BoolValue(false);
 	mSendBuffer = new UdpDatagram();
 	mRecBuffer = new UdpDatagram();
 	mAddress = new QHostAddress(_STANDARD_IP_SERVER);
@@ -105,6 +108,8 @@ YarsComSimulationAlgorithm::YarsComSimulationAlgorithm()
 	addParameter("Yars/Port", mPort);
 	addParameter("Yars/EnvironmentXML", mEnvironmentXML);
 	addParameter("Yars/TerminateTryAtAbort", mTerminateTryAtAbortSignal);
+	addParameter("Yars/Performance/StepLatency", mStepLatency);
+	addParameter("Yars/UseSharedMemory", mUseSharedMemory);
 
 	publishAllParameters();
 }
@@ -120,6 +125,7 @@ YarsComSimulationAlgorithm::~YarsComSimulationAlgorithm() {
 	if(mSocket != 0) {
 		delete mSocket;
 	}
+	closeSharedMemory();
 	
 	//Other values (Input, Output, Interface) are deleted by ValueManager.
 }
@@ -238,6 +244,9 @@ bool YarsComSimulationAlgorithm::executeSimulationStep(PhysicsManager*) {
 		return true;
 	}
 
+	QElapsedTimer timer;
+	timer.start();
+
 	// send InputValues to Yars, then trigger next simulation step in Yars.
 	// send motor data
 	//if(mDebug) std::cout << "Sending motor Data to YARS\n";
@@ -257,6 +266,7 @@ bool YarsComSimulationAlgorithm::executeSimulationStep(PhysicsManager*) {
   	if(!receiveSensorData()) {
 		return false;
 	}
+	mStepLatency->set(((double) timer.nsecsElapsed()) / 1000000.0);
 
 	if(mTerminateTryAtAbortSignal->get() && mRobotStates == _STANDARD_ROBOT_STATE_ABORT) {
 		//terminate current try
@@ -362,11 +372,12 @@ void YarsComSimulationAlgorithm::checkForConnection() {
 
 		mSendBuffer->clear();
 		mRecBuffer->clear();
+		mUnreadDatagrams.clear();
 
 		// register		
 		mSendBuffer->writeByte(0);
 		
-		if(mSocket->writeDatagram(mSendBuffer->getData(), *mAddress, mPort->get()) < 0) {
+		if(sendDatagram() < 0) {
 			std::cerr << "Unable to register with YARS server, disconnecting...\n";
 			Core::log("YarsComSimulationAlgorithm: checkForConnection(): Unable to register with YARS server");
 			mConnectToYars->set(false);
@@ -386,6 +397,10 @@ void YarsComSimulationAlgorithm::checkForConnection() {
 		if(mDebug) std::cout << "... receiving robot structure done.\n";
 		mConnected = true; //only when successfully.
 		
+		if(mUseSharedMemory->get()) {
+			negotiateSharedMemory();
+		}
+		
 	}
 }
 
@@ -414,7 +429,7 @@ bool YarsComSimulationAlgorithm::handshake() {
 	}
 	
 	mSendBuffer->writeInt(_STANDARD_COMEND);
-	mSocket->writeDatagram(mSendBuffer->getData(), *mAddress, mPort->get());
+	sendDatagram();
 	mSendBuffer->clear();
 
 	mInputValues.clear();
@@ -589,7 +604,7 @@ bool YarsComSimulationAlgorithm::additionalHandshakePacket(int &tmp)
 	if(mDebug) std::cout << "  - sending additional extended handshake request to port " << mPort->get() <<" ...\n";
 	mSendBuffer->writeInt(_STANDARD_COM_ID_HANDSHAKE_EXT_REQ);
 	mSendBuffer->writeInt(_STANDARD_COMEND);
-	mSocket->writeDatagram(mSendBuffer->getData(), *mAddress, mPort->get());
+	sendDatagram();
 	mSendBuffer->clear();	
 
 	// 3rd: start receiving additional handshake packet
@@ -632,7 +647,7 @@ bool YarsComSimulationAlgorithm::receiveExtendedSensorMotorInfo(QString &name, d
 	// send handshake req
 	mSendBuffer->writeInt(_STANDARD_COM_ID_HANDSHAKE_EXT_REQ);
 	mSendBuffer->writeInt(_STANDARD_COMEND);
-	mSocket->writeDatagram(mSendBuffer->getData(), *mAddress, mPort->get());
+	sendDatagram();
 	mSendBuffer->clear();
 	
 	// receive handshake ext ack, string length, string
@@ -660,7 +675,7 @@ bool YarsComSimulationAlgorithm::receiveExtendedSensorMotorInfo(QString &name, d
 	// send handshake ext request
 	mSendBuffer->writeInt(_STANDARD_COM_ID_HANDSHAKE_EXT_REQ);
 	mSendBuffer->writeInt(_STANDARD_COMEND);
-	mSocket->writeDatagram(mSendBuffer->getData(), *mAddress, mPort->get());
+	sendDatagram();
 	mSendBuffer->clear();
 
 	// wait for handshake ack
@@ -695,7 +710,7 @@ bool YarsComSimulationAlgorithm::init(int &seed)
 	mSendBuffer->writeInt(robotNum);
 	mSendBuffer->writeInt(seed);
 	
-	if(mSocket->writeDatagram(mSendBuffer->getData(), *mAddress, mPort->get()) < 0) {
+	if(sendDatagram() < 0) {
 		std::cerr << "Unable to send Init() to YARS server\n";
 		Core::log("YarsComSimulationAlgorithm: Init(): Unable to send Init() to YARS server");
 		return false;
@@ -741,7 +756,7 @@ bool YarsComSimulationAlgorithm::reset(int&) {
 	mSendBuffer->writeInt(robotNum);
 	mSendBuffer->writeInt(-1);
 
-	if(mSocket->writeDatagram(mSendBuffer->getData(), *mAddress, mPort->get()) < 0) {
+	if(sendDatagram() < 0) {
 		std::cerr << "Unable to send reset() to YARS server\n";
 		Core::log("YarsComSimulationAlgorithm: reset(): Unable to send reset() to YARS server");
 		return false;
@@ -792,7 +807,7 @@ bool YarsComSimulationAlgorithm::nextTry(int &seed) {
 	mSendBuffer->writeInt(robotNum);
 	mSendBuffer->writeInt(seed);
 	
-	if(mSocket->writeDatagram(mSendBuffer->getData(), *mAddress, mPort->get()) < 0) {
+	if(sendDatagram() < 0) {
 		std::cerr << "Unable to send nextTry() to YARS server\n";
 		Core::log("YarsComSimulationAlgorithm: nextTry(): Unable to send nextTry() to YARS server");
 		return false;
@@ -858,7 +873,7 @@ bool YarsComSimulationAlgorithm::sendMotorData() {
 	}
 	
 	mSendBuffer->writeInt(_STANDARD_COMEND);
-	if(mSocket->writeDatagram(mSendBuffer->getData(), *mAddress, mPort->get()) < 0) {
+	if(sendDatagram() < 0) {
 		std::cerr << "Unable to send motorData to YARS server\n";
 		Core::log("YarsComSimulationAlgorithm: sendMotorData(): Unable to send motorData to YARS server");
 		return false;
@@ -900,7 +915,7 @@ bool YarsComSimulationAlgorithm::additionalDataReqPacket(int motorDataSent, int
 	if(mDebug) std::cout << "additionalDataReqPacket()\n";
 	// finalize current  data req package
 	mSendBuffer->writeInt(_STANDARD_COMEND);
-	if(mSocket->writeDatagram(mSendBuffer->getData(), *mAddress, mPort->get()) < 0) {
+	if(sendDatagram() < 0) {
 		std::cerr << "Unable to finalize motorDataPacket\n";
 		Core::log("YarsComSimulationAlgorithm: additionalDataReqPacket(): Unable to finalize motorDataPacket");
 		return false;
@@ -964,7 +979,7 @@ bool YarsComSimulationAlgorithm::receiveSensorData() {
 		{
 			mSendBuffer->writeInt(_STANDARD_COM_ID_DATAREQ);
 			mSendBuffer->writeInt(_STANDARD_COMEND);
-			if(mSocket->writeDatagram(mSendBuffer->getData(), *mAddress, mPort->get()) < 0) {
+			if(sendDatagram() < 0) {
 				std::cerr << "Unable to request sensor data from Yars\n";
 				Core::log("YarsComSimulationAlgorithm: receiveSensorData(): Unable to request sensor data from Yars");
 				return false;
@@ -1199,7 +1214,7 @@ bool YarsComSimulationAlgorithm::sendXML(QString *dataString, int sourceType, in
 	mSendBuffer->writeInt(indyNumber);
 	mSendBuffer->writeInt(_STANDARD_COMEND);
 	
-	if(mSocket->writeDatagram(mSendBuffer->getData(), *mAddress, mPort->get()) < 0) {
+	if(sendDatagram() < 0) {
 		std::cerr << "Unable to send newSim() request\n";
 		Core::log("YarsComSimulationAlgorithm: sendXML(): Unable to send newSim request");
 		return false;
@@ -1247,7 +1262,7 @@ bool YarsComSimulationAlgorithm::sendXML(QString *dataString, int sourceType, in
 		if(mDebug) std::cout << "standard comend\n";
 		mSendBuffer->writeInt(_STANDARD_COMEND);
 		if(mDebug) std::cout << "transmitting datagram of package " << (i + 1) << "\n";
-		if(mSocket->writeDatagram(mSendBuffer->getData(), *mAddress, mPort->get()) < 0) {
+		if(sendDatagram() < 0) {
 			std::cerr << "Unable to send string data packets\n";
 			Core::log("YarsComSimulationAlgorithm: sendXML(): Unable to send string data packets");
 			return false;
@@ -1277,7 +1292,7 @@ bool YarsComSimulationAlgorithm::clearSim()
 	mSendBuffer->clear();
 	mSendBuffer->writeInt(_STANDARD_COM_ID_CLEAR_SIM_REQ);
 	mSendBuffer->writeInt(_STANDARD_COMEND);
-	if(mSocket->writeDatagram(mSendBuffer->getData(), *mAddress, mPort->get()) < 0) {
+	if(sendDatagram() < 0) {
 		std::cerr << "Unable to send clearSim() request\n";
 		Core::log("YarsComSimulationAlgorithm: clearSim(): Unable to send clearSim request");
 		return false;
@@ -1333,26 +1348,157 @@ bool YarsComSimulationAlgorithm::checkSimpleAcknowledge(int ack, QString ackName
 
 // convenience Method to read Datagram from mSocket into mRecBuffer
 bool YarsComSimulationAlgorithm::readNextDatagram() {
-	while(!mSocket->hasPendingDatagrams() && !mShutDown) {
-		Core::getInstance()->executePendingTasks();
-		mSocket->waitForReadyRead(25);
+	if(mUsingSharedMemory) {
+		QByteArray message;
+		while(!mFromYars.read(message, 25) && !mShutDown) {
+			if(mFromYars.isClosed()) {
+				mRecBuffer->clear();
+				return false;
+			}
+			Core::getInstance()->executePendingTasks();
+		}
+		if(mShutDown) {
+			return true;
+		}
+		mRecBuffer->setData(message);
+		return true;
 	}
 
-	if(mShutDown) {
+	//a datagram received during the shared memory negotiation, but not answering it.
+	if(!mUnreadDatagrams.empty()) {
+		mRecBuffer->setData(mUnreadDatagrams.takeFirst());
 		return true;
 	}
 
-	QByteArray temp(mSocket->pendingDatagramSize(),0);
-	quint16 port = mPort->get();
-	if(mSocket->readDatagram(temp.data(), temp.size(), mAddress, &port) < 0) {
-		mRecBuffer->clear();
+	while(true) {
+		//only execute pending tasks when no datagram arrived within the timeout.
+		while(!mSocket->hasPendingDatagrams() && !mShutDown) {
+			if(!mSocket->waitForReadyRead(25)) {
+				Core::getInstance()->executePendingTasks();
+			}
+		}
+
+		if(mShutDown) {
+			return true;
+		}
+
+		QByteArray temp(mSocket->pendingDatagramSize(),0);
+		quint16 port = mPort->get();
+		if(mSocket->readDatagram(temp.data(), temp.size(), mAddress, &port) < 0) {
+			mRecBuffer->clear();
+			return false;
+		}
+
+		mRecBuffer->setData(temp);
+
+		//a late acceptance of a withdrawn shared memory offer (see negotiateSharedMemory()).
+		UdpDatagram header;
+		header.setData(temp);
+		if(header.readNextInt() != _STANDARD_COM_ID_SHM_ACK) {
+			return true;
+		}
+		if(mDebug) std::cout << "YarsClient: ignoring late SHM_ACK\n";
+	}
+	
+}
+
+
+/**
+ * Sends the content of mSendBuffer to YARS, either via shared memory or via UDP.
+ * Returns the number of sent bytes or -1 if sending failed.
+ */
+qint64 YarsComSimulationAlgorithm::sendDatagram() {
+	if(mUsingSharedMemory) {
+		if(!mToYars.write(mSendBuffer->getData(), 5000)) {
+			return -1;
+		}
+		return mSendBuffer->getDataSize();
+	}
+	return mSocket->writeDatagram(mSendBuffer->getData(), *mAddress, mPort->get());
+}
+
+
+/**
+ * Offers YARS to continue the communication via shared memory. This is only tried 
+ * if YARS runs on the local host. If YARS does not accept the offer within one second, 
+ * the shared memory is released again and the communication continues via UDP.
+ * An acknowledgement arriving after that is dropped by readNextDatagram(). Any other 
+ * datagram received instead of the acknowledgement is kept for readNextDatagram().
+ */
+bool YarsComSimulationAlgorithm::negotiateSharedMemory() {
+	closeSharedMemory();
+
+	if(*mAddress != QHostAddress(QHostAddress::LocalHost)) {
 		return false;
 	}
 
-	mRecBuffer->setData(temp);
+	QString name = QString("/nerd_yars_%1_%2").arg(QCoreApplication::applicationPid())
+							.arg(mSocket->localPort());
+	int capacity = 1 << 20;
 
+	if(!mToYars.create(name + "_toYars", capacity, SharedMemoryRingBuffer::PRODUCER) 
+		|| !mFromYars.create(name + "_fromYars", capacity, SharedMemoryRingBuffer::CONSUMER)) 
+	{
+		closeSharedMemory();
+		return false;
+	}
+
+	mSendBuffer->clear();
+	mSendBuffer->writeInt(_STANDARD_COM_ID_SHM_REQ);
+	mSendBuffer->writeString(name);
+	mSendBuffer->writeInt(capacity);
+	mSendBuffer->writeInt(_STANDARD_COMEND);
+	qint64 sent = mSocket->writeDatagram(mSendBuffer->getData(), *mAddress, mPort->get());
+	mSendBuffer->clear();
+	if(sent < 0) {
+		closeSharedMemory();
+		return false;
+	}
+
+	QTime time;
+	time.start();
+	while(!mSocket->hasPendingDatagrams() && time.elapsed() < 1000) {
+		mSocket->waitForReadyRead(25);
+	}
+
+	bool accepted = false;
+	if(mSocket->hasPendingDatagrams()) {
+		QByteArray reply(mSocket->pendingDatagramSize(), 0);
+		quint16 port = mPort->get();
+		if(mSocket->readDatagram(reply.data(), reply.size(), mAddress, &port) >= 0) {
+			UdpDatagram answer;
+			answer.setData(reply);
+			accepted = answer.readNextInt() == _STANDARD_COM_ID_SHM_ACK;
+			if(!accepted) {
+				mUnreadDatagrams.append(reply);
+			}
+		}
+	}
+	if(!accepted) {
+		Core::log("YarsComSimulationAlgorithm: YARS does not support shared memory. Using UDP.");
+		closeSharedMemory();
+
+		//withdraw the offer, so that a late acknowledgement of YARS is not used.
+		mSendBuffer->clear();
+		mSendBuffer->writeInt(_STANDARD_COM_ID_SHM_FAIL);
+		mSendBuffer->writeInt(_STANDARD_COMEND);
+		mSocket->writeDatagram(mSendBuffer->getData(), *mAddress, mPort->get());
+		mSendBuffer->clear();
+		return false;
+	}
+
+	mUsingSharedMemory = true;
+	Core::log("YarsComSimulationAlgorithm: Using shared memory transport [" + name + "]");
 	return true;
-	
+}
+
+
+void YarsComSimulationAlgorithm::closeSharedMemory() {
+	mUsingSharedMemory = false;
+	mToYars.close();
+	mFromYars.close();
+	mToYars.detach();
+	mFromYars.detach();
 }
 
 
@@ -1439,11 +1585,12 @@ void YarsComSimulationAlgorithm::disconnectFromYars() {
 	mSendBuffer->clear();
 	mSendBuffer->writeInt(_STANDARD_COM_ID_QUIT_REQ);
 	mSendBuffer->writeInt(_STANDARD_COMEND);
-	if(mSocket->writeDatagram(mSendBuffer->getData(), *mAddress, mPort->get()) < 0) {
+	if(sendDatagram() < 0) {
 		std::cerr << "Unable to send termination request to Yars\n";
 		Core::log("YarsComSimulationAlgorithm: disconnectFromYars(): Unable to send termination request to Yars");
 	}
 	mSendBuffer->clear();
+	closeSharedMemory();
 	
 // 	QTime time;
 // 	time.start();
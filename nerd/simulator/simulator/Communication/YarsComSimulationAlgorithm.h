@@ -81,6 +81,9 @@
 #define _STANDARD_COM_ID_CLEAR_SIM_FAIL         95
 #define _STANDARD_COM_ID_QUIT_REQ              100 
 #define _STANDARD_COM_ID_QUIT_ACK              101 
+#define _STANDARD_COM_ID_SHM_REQ               110
+#define _STANDARD_COM_ID_SHM_ACK               111
+#define _STANDARD_COM_ID_SHM_FAIL              112
 #define _STANDARD_COM_TAGROBOT                   0
 #define _STANDARD_COM_TAGCOMPOUND              100
 #define _STANDARD_COM_TAGSEGMENT               200
@@ -103,6 +106,7 @@
 
 #include <QString>
 #include <QHash>
+#include <QList>
 #include "Collision/CollisionHandler.h"
 #include "Physics/PhysicalSimulationAlgorithm.h"
 #include "Value/IntValue.h"
@@ -116,6 +120,7 @@
 #include <QFile>
 #include <QTextStream>
 #include "Value/FileNameValue.h"
+#include "Communication/SharedMemoryRingBuffer.h"
 
 
 //TODO move to CPP
@@ -127,6 +132,13 @@ namespace nerd {
 /**
 	* YarsComSimulationAlgorithm.
 	*
+	* If Yars/UseSharedMemory is enabled and YARS runs on the same host, then NERD 
+	* offers YARS a shared memory transport after the handshake (_STANDARD_COM_ID_SHM_REQ
+	* with the base name of two SharedMemoryRingBuffers and their capacity). If YARS 
+	* accepts with _STANDARD_COM_ID_SHM_ACK, all further messages are exchanged through
+	* the ring buffers "<name>_toYars" and "<name>_fromYars" with exactly the same 
+	* (UdpDatagram) layout as before. Otherwise NERD withdraws the offer with 
+	* _STANDARD_COM_ID_SHM_FAIL and the communication continues via UDP.
 	*/
 class YarsComSimulationAlgorithm : public PhysicalSimulationAlgorithm,
 								   public CollisionHandler,
@@ -173,6 +185,9 @@ class YarsComSimulationAlgorithm : public PhysicalSimulationAlgorithm,
 		bool clearSim();
 		bool checkSimpleAcknowledge(int ack, QString ackName);
 		bool readNextDatagram();		
+		qint64 sendDatagram();
+		bool negotiateSharedMemory();
+		void closeSharedMemory();
 		void datagramReceptionErrorOutput();
 
 	private:
@@ -203,6 +218,12 @@ class YarsComSimulationAlgorithm : public PhysicalSimulationAlgorithm,
 		bool mResetRequested;
 		bool mSendXML;
 		BoolValue *mTerminateTryAtAbortSignal;
+		DoubleValue *mStepLatency;
+		BoolValue *mUseSharedMemory;
+		SharedMemoryRingBuffer mToYars;
+		SharedMemoryRingBuffer mFromYars;
+		bool mUsingSharedMemory;
+		QList<QByteArray> mUnreadDatagrams;
 };
 
 }
@@ -0,0 +1,406 @@
+/***************************************************************************
+ *   NERD - Neurodynamics and Evolutionary Robotics Development Toolkit    *
+ *                                                                         *
+ *   University of Osnabrueck, Germany                                     *
+ *   Institute of Cognitive Science                                        *
+ *   Neurocybernetics Group                                                *
+ *   http://www.ikw.uni-osnabrueck.de/~neurokybernetik/                    *
+ *                                                                         *
+ *   Project homepage: nerd.x-bot.org                                      *
+ *                                                                         *
+ *   Copyright (C) 2008 - 2013 by the Neurocybernetics Group Osnabrück     *
+ *   Contact: Christian Rempis                                             *
+ *   christian.rempis@uni-osnabrueck.de                                    *
+ *   Contributors: see contributors.txt in the nerd main directory.        *
+ *                                                                         *
+ *                                                                         *
+ *   Acknowledgments:                                                      *
+ *   The NERD Toolkit is part of the EU project ALEAR                      *
+ *   (Artificial Language Evolution on Autonomous Robots) www.ALEAR.eu     *
+ *   This work was funded (2008 - 2011) by EU-Project Number ICT 214856    *
+ *                                                                         *
+ *                                                                         *
+ *   License Agreement:                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ *                                                                         *
+ *   Publications based on work using the NERD kit have to state this      *
+ *   clearly by citing the NERD homepage and the NERD overview paper.      *  
+ ***************************************************************************/
+
+
+#include "IndexedRecordingReader.h"
+#include "Core/Core.h"
+#include <QDataStream>
+#include <iostream>
+
+using namespace std;
+
+namespace nerd {
+
+
+IndexedRecordingReader::IndexedRecordingReader()
+	: mCompressed(false), mFramesPerChunk(0), mDataOffset(0), mRecovered(false),
+	  mNumberOfFrames(0), mCachedChunk(-1)
+{
+}
+
+IndexedRecordingReader::~IndexedRecordingReader() {
+	close();
+}
+
+
+/**
+ * Opens an indexed recording and loads its frame index.
+ *
+ * @param fileName the data file to open.
+ * @param ignoreFooter if true, the index is always rebuilt by scanning the chunks.
+ *        This is slower, but also works for damaged files.
+ * @return true if the file could be opened and contains at least the file header.
+ */
+bool IndexedRecordingReader::open(const QString &fileName, bool ignoreFooter) {
+	close();
+
+	mFile.setFileName(fileName);
+	if(!mFile.open(QIODevice::ReadOnly)) {
+		Core::log("IndexedRecordingReader: Could not open file [" + fileName + "]", true);
+		return false;
+	}
+
+	QDataStream stream(&mFile);
+	uint version = 0;
+	stream >> version;
+	stream >> mFramesPerChunk;
+	stream >> mCompressed;
+	if(stream.status() != QDataStream::Ok || version != RECORDING_FORMAT_INDEXED) {
+		close();
+		return false;
+	}
+	mDataOffset = mFile.pos();
+
+	if(ignoreFooter || !readIndexFromFooter()) {
+		if(!rebuildIndex()) {
+			close();
+			return false;
+		}
+	}
+
+	mNumberOfFrames = 0;
+	if(!mIndex.empty()) {
+		mNumberOfFrames = mIndex.last().mFirstFrame + mIndex.last().mNumberOfFrames;
+	}
+	return true;
+}
+
+
+void IndexedRecordingReader::close() {
+	if(mFile.isOpen()) {
+		mFile.close();
+	}
+	mIndex.clear();
+	mNumberOfFrames = 0;
+	mRecovered = false;
+	mCachedChunk = -1;
+	mCachedData.clear();
+	mFrameOffsets.clear();
+	mFrameSizes.clear();
+	mFrameSteps.clear();
+}
+
+
+bool IndexedRecordingReader::isOpen() const {
+	return mFile.isOpen();
+}
+
+
+/**
+ * Returns true if the index of the file had to be rebuilt, because the footer was missing.
+ */
+bool IndexedRecordingReader::wasRecovered() const {
+	return mRecovered;
+}
+
+
+uint IndexedRecordingReader::getNumberOfFrames() const {
+	return mNumberOfFrames;
+}
+
+
+qint32 IndexedRecordingReader::getFirstStep() const {
+	if(mIndex.empty()) {
+		return 0;
+	}
+	return mIndex.first().mFirstStep;
+}
+
+
+qint32 IndexedRecordingReader::getLastStep() const {
+	if(mIndex.empty()) {
+		return 0;
+	}
+	return mIndex.last().mLastStep;
+}
+
+
+const QVector<RecordingChunkInfo>& IndexedRecordingReader::getIndex() const {
+	return mIndex;
+}
+
+
+/**
+ * Determines the simulation step at which the given frame was recorded.
+ */
+bool IndexedRecordingReader::getStepOfFrame(uint frame, qint32 &step) {
+	int chunk = getChunkOfFrame(frame);
+	if(chunk < 0 || !loadChunk(chunk)) {
+		return false;
+	}
+	step = mFrameSteps.at(frame - mIndex.at(chunk).mFirstFrame);
+	return true;
+}
+
+
+/**
+ * Copies the data block of the given frame (as written by
+ * SimulationRecorder::updateRecordedData()) to data.
+ */
+bool IndexedRecordingReader::readFrame(uint frame, QByteArray &data) {
+	int chunk = getChunkOfFrame(frame);
+	if(chunk < 0 || !loadChunk(chunk)) {
+		return false;
+	}
+	int localFrame = frame - mIndex.at(chunk).mFirstFrame;
+	data = mCachedData.mid(mFrameOffsets.at(localFrame), mFrameSizes.at(localFrame));
+	return true;
+}
+
+
+/**
+ * Decodes only the requested value channels of a frame. The channel indices
+ * correspond to the order of the recorded values in the _info file.
+ * Channels that are not available in the frame are set to 0.
+ *
+ * @return true if the frame could be read.
+ */
+bool IndexedRecordingReader::readChannels(uint frame, const QVector<int> &channels,
+										QVector<double> &values)
+{
+	int chunk = getChunkOfFrame(frame);
+	if(chunk < 0 || !loadChunk(chunk)) {
+		return false;
+	}
+	int localFrame = frame - mIndex.at(chunk).mFirstFrame;
+	int frameSize = mFrameSizes.at(localFrame);
+	QByteArray data = QByteArray::fromRawData(mCachedData.constData() + mFrameOffsets.at(localFrame),
+											  frameSize);
+	QDataStream stream(data);
+
+	qint32 numberOfValues = 0;
+	stream >> numberOfValues;
+
+	//only channels that are completely contained in the frame are decoded.
+	int availableValues = (frameSize - (int) sizeof(qint32)) / (int) sizeof(double);
+	if(numberOfValues > availableValues) {
+		numberOfValues = availableValues;
+	}
+
+	values.resize(channels.size());
+	for(int i = 0; i < channels.size(); ++i) {
+		int channel = channels.at(i);
+		double value = 0.0;
+		if(channel >= 0 && channel < numberOfValues) {
+			stream.device()->seek(sizeof(qint32) + (channel * sizeof(double)));
+			stream >> value;
+		}
+		values[i] = value;
+	}
+	return true;
+}
+
+
+/**
+ * Reads the frame index with the help of the fixed-size footer at the end of the file.
+ */
+bool IndexedRecordingReader::readIndexFromFooter() {
+	qint64 fileSize = mFile.size();
+	if(fileSize - mDataOffset < RECORDING_FOOTER_SIZE) {
+		return false;
+	}
+
+	QDataStream stream(&mFile);
+	mFile.seek(fileSize - RECORDING_FOOTER_SIZE);
+
+	uint numberOfChunks = 0;
+	qint64 indexOffset = 0;
+	uint magic = 0;
+	stream >> numberOfChunks;
+	stream >> indexOffset;
+	stream >> magic;
+
+	if(magic != RECORDING_INDEX_MAGIC || indexOffset < mDataOffset
+		|| indexOffset + (numberOfChunks * RECORDING_INDEX_ENTRY_SIZE) + RECORDING_FOOTER_SIZE != fileSize)
+	{
+		return false;
+	}
+
+	mFile.seek(indexOffset);
+	mIndex.resize(numberOfChunks);
+	for(uint i = 0; i < numberOfChunks; ++i) {
+		RecordingChunkInfo &info = mIndex[i];
+		stream >> info.mOffset;
+		stream >> info.mFirstFrame;
+		stream >> info.mNumberOfFrames;
+		stream >> info.mFirstStep;
+		stream >> info.mLastStep;
+	}
+	if(stream.status() != QDataStream::Ok) {
+		mIndex.clear();
+		return false;
+	}
+	mRecovered = false;
+	return true;
+}
+
+
+/**
+ * Rebuilds the frame index by walking over all chunk headers. Scanning stops
+ * at the first incomplete or damaged chunk, so that a truncated recording
+ * can be played back up to the last completely written chunk.
+ */
+bool IndexedRecordingReader::rebuildIndex() {
+	mIndex.clear();
+
+	qint64 fileSize = mFile.size();
+	qint64 pos = mDataOffset;
+	QDataStream stream(&mFile);
+
+	while(pos + RECORDING_CHUNK_HEADER_SIZE <= fileSize) {
+		mFile.seek(pos);
+
+		RecordingChunkInfo info;
+		uint magic = 0;
+		uint storedSize = 0;
+		uint rawSize = 0;
+		stream >> magic;
+		stream >> info.mFirstFrame;
+		stream >> info.mNumberOfFrames;
+		stream >> info.mFirstStep;
+		stream >> info.mLastStep;
+		stream >> storedSize;
+		stream >> rawSize;
+
+		if(magic != RECORDING_CHUNK_MAGIC
+			|| pos + RECORDING_CHUNK_HEADER_SIZE + storedSize > fileSize)
+		{
+			break;
+		}
+		info.mOffset = pos;
+		mIndex.append(info);
+
+		pos += RECORDING_CHUNK_HEADER_SIZE + storedSize;
+	}
+	mRecovered = true;
+
+	if(mIndex.empty()) {
+		Core::log("IndexedRecordingReader: Could not find any complete chunk in file ["
+				+ mFile.fileName() + "]", true);
+	}
+	return true;
+}
+
+
+/**
+ * Binary search for the chunk containing the given frame.
+ */
+int IndexedRecordingReader::getChunkOfFrame(uint frame) const {
+	if(frame >= mNumberOfFrames) {
+		return -1;
+	}
+	int low = 0;
+	int high = mIndex.size() - 1;
+	while(low <= high) {
+		int mid = (low + high) / 2;
+		const RecordingChunkInfo &info = mIndex.at(mid);
+		if(frame < info.mFirstFrame) {
+			high = mid - 1;
+		}
+		else if(frame >= info.mFirstFrame + info.mNumberOfFrames) {
+			low = mid + 1;
+		}
+		else {
+			return mid;
+		}
+	}
+	return -1;
+}
+
+
+/**
+ * Reads (and if required decompresses) a chunk and builds the table with the
+ * frame offsets within the chunk. The last loaded chunk is kept in memory.
+ */
+bool IndexedRecordingReader::loadChunk(int chunk) {
+	if(chunk == mCachedChunk) {
+		return true;
+	}
+	mCachedChunk = -1;
+	mFrameOffsets.clear();
+	mFrameSizes.clear();
+	mFrameSteps.clear();
+
+	const RecordingChunkInfo &info = mIndex.at(chunk);
+
+	QDataStream stream(&mFile);
+	mFile.seek(info.mOffset + RECORDING_CHUNK_HEADER_SIZE - (2 * sizeof(uint)));
+	uint storedSize = 0;
+	uint rawSize = 0;
+	stream >> storedSize;
+	stream >> rawSize;
+
+	QByteArray stored = mFile.read(storedSize);
+	if(stored.size() != (int) storedSize) {
+		return false;
+	}
+	mCachedData = mCompressed ? qUncompress(stored) : stored;
+	if(mCachedData.size() != (int) rawSize) {
+		Core::log("IndexedRecordingReader: Damaged chunk at offset "
+				+ QString::number(info.mOffset), true);
+		return false;
+	}
+
+	QDataStream frameStream(mCachedData);
+	for(uint i = 0; i < info.mNumberOfFrames; ++i) {
+		uint frameNumber = 0;
+		qint32 step = 0;
+		uint size = 0;
+		frameStream >> frameNumber;
+		frameStream >> step;
+		frameStream >> size;
+		int offset = (int) frameStream.device()->pos();
+		if(frameStream.status() != QDataStream::Ok || offset + (int) size > mCachedData.size()) {
+			return false;
+		}
+		mFrameOffsets.append(offset);
+		mFrameSizes.append(size);
+		mFrameSteps.append(step);
+		frameStream.skipRawData(size);
+	}
+	mCachedChunk = chunk;
+	return true;
+}
+
+}
+
@@ -0,0 +1,116 @@
+/***************************************************************************
+ *   NERD - Neurodynamics and Evolutionary Robotics Development Toolkit    *
+ *                                                                         *
+ *   University of Osnabrueck, Germany                                     *
+ *   Institute of Cognitive Science                                        *
+ *   Neurocybernetics Group                                                *
+ *   http://www.ikw.uni-osnabrueck.de/~neurokybernetik/                    *
+ *                                                                         *
+ *   Project homepage: nerd.x-bot.org                                      *
+ *                                                                         *
+ *   Copyright (C) 2008 - 2013 by the Neurocybernetics Group Osnabrück     *
+ *   Contact: Christian Rempis                                             *
+ *   christian.rempis@uni-osnabrueck.de                                    *
+ *   Contributors: see contributors.txt in the nerd main directory.        *
+ *                                                                         *
+ *                                                                         *
+ *   Acknowledgments:                                                      *
+ *   The NERD Toolkit is part of the EU project ALEAR                      *
+ *   (Artificial Language Evolution on Autonomous Robots) www.ALEAR.eu     *
+ *   This work was funded (2008 - 2011) by EU-Project Number ICT 214856    *
+ *                                                                         *
+ *                                                                         *
+ *   License Agreement:                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ *                                                                         *
+ *   Publications based on work using the NERD kit have to state this      *
+ *   clearly by citing the NERD homepage and the NERD overview paper.      *  
+ ***************************************************************************/
+
+
+#ifndef NERDIndexedRecordingReader_H
+#define NERDIndexedRecordingReader_H
+
+#include <QString>
+#include <QFile>
+#include <QByteArray>
+#include <QVector>
+#include "Gui/SimulationRecorder/RecordingChunkInfo.h"
+
+namespace nerd {
+
+	/**
+	 * IndexedRecordingReader.
+	 * Provides random access to the frames of an indexed data recording (format 3).
+	 *
+	 * The frame index is read from the footer of the file. If the footer is missing
+	 * or damaged (e.g. the recording was interrupted), the index is rebuilt by scanning
+	 * the chunk headers, so that all completely written chunks can be recovered.
+	 *
+	 * Seeking to a frame requires a binary search in the (small) chunk index and
+	 * at most one chunk read. The most recently decoded chunk is cached, so sequential
+	 * playback only reads each chunk once.
+	 *
+	 * With readChannels() only selected double values of a frame are decoded. This
+	 * assumes the frame layout of SimulationRecorder::updateRecordedData()
+	 * (numberOfValues | value...), which subclasses only extend at the end.
+	 */
+	class IndexedRecordingReader {
+	public:
+		IndexedRecordingReader();
+		virtual ~IndexedRecordingReader();
+
+		bool open(const QString &fileName, bool ignoreFooter = false);
+		void close();
+		bool isOpen() const;
+		bool wasRecovered() const;
+
+		uint getNumberOfFrames() const;
+		qint32 getFirstStep() const;
+		qint32 getLastStep() const;
+		const QVector<RecordingChunkInfo>& getIndex() const;
+
+		bool getStepOfFrame(uint frame, qint32 &step);
+		bool readFrame(uint frame, QByteArray &data);
+		bool readChannels(uint frame, const QVector<int> &channels, QVector<double> &values);
+
+	private:
+		bool readIndexFromFooter();
+		bool rebuildIndex();
+		int getChunkOfFrame(uint frame) const;
+		bool loadChunk(int chunk);
+
+	private:
+		QFile mFile;
+		bool mCompressed;
+		uint mFramesPerChunk;
+		qint64 mDataOffset;
+		bool mRecovered;
+		QVector<RecordingChunkInfo> mIndex;
+		uint mNumberOfFrames;
+
+		int mCachedChunk;
+		QByteArray mCachedData;
+		QVector<int> mFrameOffsets;
+		QVector<int> mFrameSizes;
+		QVector<qint32> mFrameSteps;
+	};
+
+}
+
+#endif
+
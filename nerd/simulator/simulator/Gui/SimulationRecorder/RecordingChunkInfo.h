@@ -0,0 +1,93 @@
+/***************************************************************************
+ *   NERD - Neurodynamics and Evolutionary Robotics Development Toolkit    *
+ *                                                                         *
+ *   University of Osnabrueck, Germany                                     *
+ *   Institute of Cognitive Science                                        *
+ *   Neurocybernetics Group                                                *
+ *   http://www.ikw.uni-osnabrueck.de/~neurokybernetik/                    *
+ *                                                                         *
+ *   Project homepage: nerd.x-bot.org                                      *
+ *                                                                         *
+ *   Copyright (C) 2008 - 2013 by the Neurocybernetics Group Osnabrück     *
+ *   Contact: Christian Rempis                                             *
+ *   christian.rempis@uni-osnabrueck.de                                    *
+ *   Contributors: see contributors.txt in the nerd main directory.        *
+ *                                                                         *
+ *                                                                         *
+ *   Acknowledgments:                                                      *
+ *   The NERD Toolkit is part of the EU project ALEAR                      *
+ *   (Artificial Language Evolution on Autonomous Robots) www.ALEAR.eu     *
+ *   This work was funded (2008 - 2011) by EU-Project Number ICT 214856    *
+ *                                                                         *
+ *                                                                         *
+ *   License Agreement:                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ *                                                                         *
+ *   Publications based on work using the NERD kit have to state this      *
+ *   clearly by citing the NERD homepage and the NERD overview paper.      *  
+ ***************************************************************************/
+
+
+#ifndef NERDRecordingChunkInfo_H
+#define NERDRecordingChunkInfo_H
+
+#include <QtGlobal>
+
+namespace nerd {
+
+	/**
+	 * Data format 3 of the SimulationRecorder (indexed, chunked format).
+	 *
+	 * Header:  version (uint, 3) | framesPerChunk (uint) | compressed (bool)
+	 * Chunk:   CHUNK_MAGIC (uint) | firstFrame (uint) | numberOfFrames (uint)
+	 *          | firstStep (qint32) | lastStep (qint32) | storedSize (uint)
+	 *          | rawSize (uint) | payload (storedSize bytes, optionally qCompress'ed)
+	 * Payload: for each frame: frameNumber (uint) | step (qint32) | size (uint) | data...
+	 * Index:   for each chunk: offset (qint64) | firstFrame (uint) | numberOfFrames (uint)
+	 *          | firstStep (qint32) | lastStep (qint32)  (RECORDING_INDEX_ENTRY_SIZE bytes)
+	 * Footer:  numberOfChunks (uint) | indexOffset (qint64) | INDEX_MAGIC (uint)
+	 *
+	 * The footer has a fixed size and allows to locate the index without
+	 * scanning the file. If the footer is missing (e.g. after a crash), the
+	 * index can be rebuilt by walking over the self-describing chunk headers.
+	 */
+	const uint RECORDING_FORMAT_INDEXED = 3;
+	const uint RECORDING_CHUNK_MAGIC = 0x4e434b33;
+	const uint RECORDING_INDEX_MAGIC = 0x4e494458;
+	const int RECORDING_CHUNK_HEADER_SIZE = 7 * 4;
+	const int RECORDING_INDEX_ENTRY_SIZE = 8 + 4 * 4;
+	const int RECORDING_FOOTER_SIZE = 4 + 8 + 4;
+
+	/**
+	 * RecordingChunkInfo.
+	 * An entry of the frame index of an indexed data recording.
+	 */
+	struct RecordingChunkInfo {
+		RecordingChunkInfo()
+			: mOffset(0), mFirstFrame(0), mNumberOfFrames(0), mFirstStep(0), mLastStep(0) {}
+
+		qint64 mOffset;
+		uint mFirstFrame;
+		uint mNumberOfFrames;
+		qint32 mFirstStep;
+		qint32 mLastStep;
+	};
+
+}
+
+#endif
+
@@ -0,0 +1,187 @@
+/***************************************************************************
+ *   NERD - Neurodynamics and Evolutionary Robotics Development Toolkit    *
+ *                                                                         *
+ *   University of Osnabrueck, Germany                                     *
+ *   Institute of Cognitive Science                                        *
+ *   Neurocybernetics Group                                                *
+ *   http://www.ikw.uni-osnabrueck.de/~neurokybernetik/                    *
+ *                                                                         *
+ *   Project homepage: nerd.x-bot.org                                      *
+ *                                                                         *
+ *   Copyright (C) 2008 - 2013 by the Neurocybernetics Group Osnabrück     *
+ *   Contact: Christian Rempis                                             *
+ *   christian.rempis@uni-osnabrueck.de                                    *
+ *   Contributors: see contributors.txt in the nerd main directory.        *
+ *                                                                         *
+ *                                                                         *
+ *   Acknowledgments:                                                      *
+ *   The NERD Toolkit is part of the EU project ALEAR                      *
+ *   (Artificial Language Evolution on Autonomous Robots) www.ALEAR.eu     *
+ *   This work was funded (2008 - 2011) by EU-Project Number ICT 214856    *
+ *                                                                         *
+ *                                                                         *
+ *   License Agreement:                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ *                                                                         *
+ *   Publications based on work using the NERD kit have to state this      *
+ *   clearly by citing the NERD homepage and the NERD overview paper.      *  
+ ***************************************************************************/
+
+
+#include "RecordingChunkWriter.h"
+#include "Core/Core.h"
+#include <QDataStream>
+#include <QMutexLocker>
+#include <iostream>
+
+using namespace std;
+
+namespace nerd {
+
+
+/**
+ * Creates a new writer for the given (already opened) file and writes the
+ * file header. The writer thread is not started automatically.
+ *
+ * @param file the file to write to. The file has to be open for writing.
+ * @param framesPerChunk the (maximal) number of frames per chunk.
+ * @param compress if true, the chunk payloads are compressed with qCompress().
+ */
+RecordingChunkWriter::RecordingChunkWriter(QFile *file, uint framesPerChunk, bool compress)
+	: QThread(0), mFile(file), mCompress(compress), mFinish(false)
+{
+	if(mFile != 0) {
+		QDataStream stream(mFile);
+		stream << RECORDING_FORMAT_INDEXED;
+		stream << framesPerChunk;
+		stream << mCompress;
+	}
+	Core::getInstance()->registerThread(this);
+}
+
+RecordingChunkWriter::~RecordingChunkWriter() {
+	Core::getInstance()->deregisterThread(this);
+}
+
+
+/**
+ * Hands a completed chunk over to the writer thread.
+ * The offset of the chunk info is set by the writer.
+ */
+void RecordingChunkWriter::addChunk(const RecordingChunkInfo &info, const QByteArray &rawData) {
+	QMutexLocker locker(&mMutex);
+	mPendingInfos.append(info);
+	mPendingData.append(rawData);
+	mChunksAvailable.wakeAll();
+}
+
+
+/**
+ * Writes all pending chunks, the frame index and the footer.
+ * Blocks until the writer thread has terminated.
+ */
+void RecordingChunkWriter::finish() {
+	{
+		QMutexLocker locker(&mMutex);
+		mFinish = true;
+		mChunksAvailable.wakeAll();
+	}
+	if(isRunning()) {
+		wait();
+	}
+	else {
+		//writer was never started: write synchronously.
+		run();
+	}
+}
+
+
+int RecordingChunkWriter::getNumberOfWrittenChunks() {
+	QMutexLocker locker(&mMutex);
+	return mIndex.size();
+}
+
+
+void RecordingChunkWriter::run() {
+	while(true) {
+		RecordingChunkInfo info;
+		QByteArray data;
+		{
+			QMutexLocker locker(&mMutex);
+			while(mPendingInfos.empty() && !mFinish) {
+				mChunksAvailable.wait(&mMutex);
+			}
+			if(mPendingInfos.empty()) {
+				break;
+			}
+			info = mPendingInfos.takeFirst();
+			data = mPendingData.takeFirst();
+		}
+		writeChunk(info, data);
+	}
+	writeIndex();
+}
+
+
+void RecordingChunkWriter::writeChunk(RecordingChunkInfo &info, const QByteArray &rawData) {
+	if(mFile == 0 || !mFile->isOpen()) {
+		return;
+	}
+	QByteArray stored = mCompress ? qCompress(rawData) : rawData;
+
+	info.mOffset = mFile->pos();
+
+	QDataStream stream(mFile);
+	stream << RECORDING_CHUNK_MAGIC;
+	stream << info.mFirstFrame;
+	stream << info.mNumberOfFrames;
+	stream << info.mFirstStep;
+	stream << info.mLastStep;
+	stream << ((uint) stored.size());
+	stream << ((uint) rawData.size());
+	stream.writeRawData(stored.data(), stored.size());
+
+	QMutexLocker locker(&mMutex);
+	mIndex.append(info);
+}
+
+
+void RecordingChunkWriter::writeIndex() {
+	if(mFile == 0 || !mFile->isOpen()) {
+		return;
+	}
+	QMutexLocker locker(&mMutex);
+
+	qint64 indexOffset = mFile->pos();
+
+	QDataStream stream(mFile);
+	for(QListIterator<RecordingChunkInfo> i(mIndex); i.hasNext();) {
+		const RecordingChunkInfo &info = i.next();
+		stream << info.mOffset;
+		stream << info.mFirstFrame;
+		stream << info.mNumberOfFrames;
+		stream << info.mFirstStep;
+		stream << info.mLastStep;
+	}
+	stream << ((uint) mIndex.size());
+	stream << indexOffset;
+	stream << RECORDING_INDEX_MAGIC;
+	mFile->flush();
+}
+
+}
+
@@ -0,0 +1,99 @@
+/***************************************************************************
+ *   NERD - Neurodynamics and Evolutionary Robotics Development Toolkit    *
+ *                                                                         *
+ *   University of Osnabrueck, Germany                                     *
+ *   Institute of Cognitive Science                                        *
+ *   Neurocybernetics Group                                                *
+ *   http://www.ikw.uni-osnabrueck.de/~neurokybernetik/                    *
+ *                                                                         *
+ *   Project homepage: nerd.x-bot.org                                      *
+ *                                                                         *
+ *   Copyright (C) 2008 - 2013 by the Neurocybernetics Group Osnabrück     *
+ *   Contact: Christian Rempis                                             *
+ *   christian.rempis@uni-osnabrueck.de                                    *
+ *   Contributors: see contributors.txt in the nerd main directory.        *
+ *                                                                         *
+ *                                                                         *
+ *   Acknowledgments:                                                      *
+ *   The NERD Toolkit is part of the EU project ALEAR                      *
+ *   (Artificial Language Evolution on Autonomous Robots) www.ALEAR.eu     *
+ *   This work was funded (2008 - 2011) by EU-Project Number ICT 214856    *
+ *                                                                         *
+ *                                                                         *
+ *   License Agreement:                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ *                                                                         *
+ *   Publications based on work using the NERD kit have to state this      *
+ *   clearly by citing the NERD homepage and the NERD overview paper.      *  
+ ***************************************************************************/
+
+
+#ifndef NERDRecordingChunkWriter_H
+#define NERDRecordingChunkWriter_H
+
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QByteArray>
+#include <QList>
+#include <QFile>
+#include "Gui/SimulationRecorder/RecordingChunkInfo.h"
+
+namespace nerd {
+
+	/**
+	 * RecordingChunkWriter.
+	 * Writes the chunks of an indexed data recording (format 3) in its own thread.
+	 * The recorder collects frames into chunks and hands completed chunks over
+	 * with addChunk(). Compression and disk I/O take place in the writer thread,
+	 * so that the simulation loop is not blocked by the recording.
+	 *
+	 * When finish() is called, all pending chunks are written, followed by the
+	 * frame index and the footer. The file itself is not closed by the writer.
+	 */
+	class RecordingChunkWriter : public QThread {
+	public:
+		RecordingChunkWriter(QFile *file, uint framesPerChunk, bool compress);
+		virtual ~RecordingChunkWriter();
+
+		void addChunk(const RecordingChunkInfo &info, const QByteArray &rawData);
+		void finish();
+
+		int getNumberOfWrittenChunks();
+
+	protected:
+		virtual void run();
+
+	private:
+		void writeChunk(RecordingChunkInfo &info, const QByteArray &rawData);
+		void writeIndex();
+
+	private:
+		QFile *mFile;
+		bool mCompress;
+		QMutex mMutex;
+		QWaitCondition mChunksAvailable;
+		QList<RecordingChunkInfo> mPendingInfos;
+		QList<QByteArray> mPendingData;
+		QList<RecordingChunkInfo> mIndex;
+		bool mFinish;
+	};
+
+}
+
+#endif
+
@@ -108,7 +108,8 @@ class StartRecordingTask : public Task {
 SimulationRecorder::SimulationRecorder()
 	: mResetEvent(0), mStepCompletedEvent(0), mResetTotalStepsCounter(0), mTotalStepsCounters(0),
 		mPhysicsWasDisabled(false), mStartEndFrameRange(0, 0), 	mNumberOfFrames(0), mFrameNumber(0), 
-		mWasPaused(false), 	mPreviousNumberOfStepsSetting(0), mFile(0), mDataStream(0), mExecutionMode(SIMREC_OFF)
+		mWasPaused(false), 	mPreviousNumberOfStepsSetting(0), mFile(0), mDataStream(0), mExecutionMode(SIMREC_OFF),
+		mVersion(0), mChunkWriter(0)
 		
 {
 	Core::getInstance()->addSystemObject(this);
@@ -120,6 +121,8 @@ SimulationRecorder::SimulationRecorder()
 	mFileNamePrefix = new StringValue("rec");
 	mPlaybackFile = new FileNameValue("");
 	mRecordingInterval = new IntValue(1);
+	mFramesPerChunk = new IntValue(256);
+	mCompressChunks = new BoolValue(true);
 	mObservedValues = new CodeValue("[Interfaces]\n/Sim/**/Position\n/Sim/**/OrientationQuaternion");
 	mRecordedValueNameList = new CodeValue();
 	mStartEndFrameValue = new RangeValue(0, 0);
@@ -138,6 +141,9 @@ SimulationRecorder::SimulationRecorder()
 	mRecordingInterval->setDescription("The interval at which frames are recorded. "
 										"\nOnly every nth simulation step is recorded."
 										"\nThis is important to reduce the file size");
+	mFramesPerChunk->setDescription("The number of frames that are collected in a single chunk of the data file."
+										"\nChunks are written in the background and are the unit for seeking during playback.");
+	mCompressChunks->setDescription("If true, then the chunks of the data file are compressed.");
 	mObservedValues->setDescription("Describes the values to record in terms of regular expressions."
 										"\nPredefined values are: "
 										"\n- [Interfaces] All interface values (motors and sensors) of the simluation.");
@@ -147,7 +153,7 @@ SimulationRecorder::SimulationRecorder()
 	mNumberOfFramesValue->setDescription("The number of data frames contained in the playing data file.");
 	mDesiredFrameValue->setDescription("Can be used to jump to a desired frame number during playback."
 										"\nFrames < 0 and > NumberOfFrames have no effect. Note that seeking over large"
-										"\ndistances can take some time!");
+										"\ndistances can take some time in old (version 2) data files!");
 	mResetTotalStepsCounter->setDescription("Sets the total number of steps back to zero when recording or playback starts."
 										"\nThe total number of steps can serve as a continuous time measurement even in "
 										"combination with intermediate reset() calls.");
@@ -161,6 +167,8 @@ SimulationRecorder::SimulationRecorder()
 	vm->addValue("/DataRecorder/Recording/FileName", mFileNamePrefix);
 	vm->addValue("/DataRecorder/Recording/RecordingDirectory", mRecordingDirectory);
 	vm->addValue("/DataRecorder/Recording/RecordingInterval", mRecordingInterval);
+	vm->addValue("/DataRecorder/Recording/FramesPerChunk", mFramesPerChunk);
+	vm->addValue("/DataRecorder/Recording/CompressChunks", mCompressChunks);
 	vm->addValue("/DataRecorder/Recording/RecordedValues", mObservedValues);
 	vm->addValue("/DataRecorder/Recording/RecordedValueNameList", mRecordedValueNameList);
 	vm->addValue("/DataRecorder/Recording/ResetTotalStepCounter", mResetTotalStepsCounter);
@@ -342,6 +350,8 @@ void SimulationRecorder::valueChanged(Value *value) {
  * the proper version number (so you need a matching NERD release with the correct data format. This may change over time!
  * 
  * The actual recording is then done with recordData() at every simulation step.
+ * Frames are collected in chunks, which are written by a RecordingChunkWriter in the background
+ * (data format 3, see RecordingChunkInfo.h).
  */
 void SimulationRecorder::startRecording() {
 
@@ -415,10 +425,13 @@ void SimulationRecorder::startRecording() {
 	
 	
 	mData.reserve(5000);
-	mFileDataStream.setDevice(mFile);
+	mChunkData.clear();
+	mChunkInfo = RecordingChunkInfo();
 	
-	//write data file format version number
-	mFileDataStream << ((uint) 2);
+	//the writer writes the file header (data file format version number) and all chunks.
+	mChunkWriter = new RecordingChunkWriter(mFile, Math::max(1, mFramesPerChunk->get()), 
+											mCompressChunks->get());
+	mChunkWriter->start();
 	
 	mExecutionMode = SIMREC_RECORDING;
 	mStepCounter = 0;
@@ -441,7 +454,13 @@ void SimulationRecorder::stopRecording() {
 	mStepCompletedEvent->removeEventListener(this);
 	mResetEvent->removeEventListener(this);
 	
-	mFileDataStream.setDevice(0);
+	//write the remaining frames, the frame index and the footer.
+	if(mChunkWriter != 0) {
+		flushChunk();
+		mChunkWriter->finish();
+		delete mChunkWriter;
+		mChunkWriter = 0;
+	}
 	
 	if(mFile != 0) {
 		mFile->flush();
@@ -461,8 +480,10 @@ void SimulationRecorder::stopRecording() {
 /**
  * Records a full data frame of the simulation. If forceRecording is true, then the frame is definively recorded. 
  * Otherwise, a recodring takes only place according to the recording policy, e.g. every nth time frame.
- * Data format: frameNumber | currentStep | frameSize | data... | frameSize
- * See the dataformat description for the full format.
+ * Data format: frameNumber | currentStep | frameSize | data...
+ * The frames are collected in the current chunk, which is handed over to the writer thread
+ * as soon as it contains FramesPerChunk frames.
+ * See the dataformat description in RecordingChunkInfo.h for the full format.
  */
  //TODO Add total step counter to frame!
 void SimulationRecorder::recordData(bool forceRecording) {
@@ -487,17 +508,43 @@ void SimulationRecorder::recordData(bool forceRecording) {
 	
 	updateRecordedData(*mDataStream);
 	
-	//write the number of bytes before and after the block to allow seeking backwards.
-	mFileDataStream << ((uint) mFrameNumber);
-	mFileDataStream << ((qint32) mCurrentStep->get());
-	mFileDataStream << ((uint) mData.size());
-	mFileDataStream.writeRawData(mData.data(), mData.size());
-	mFileDataStream << ((uint) mData.size());
+	delete mDataStream;
+	mDataStream = 0;
+	
+	qint32 step = (qint32) mCurrentStep->get();
+	if(mChunkInfo.mNumberOfFrames == 0) {
+		mChunkInfo.mFirstFrame = mFrameNumber;
+		mChunkInfo.mFirstStep = step;
+	}
+	mChunkInfo.mLastStep = step;
+	++mChunkInfo.mNumberOfFrames;
+	
+	{
+		QDataStream chunkStream(&mChunkData, QIODevice::WriteOnly | QIODevice::Append);
+		chunkStream << ((uint) mFrameNumber);
+		chunkStream << step;
+		chunkStream << ((uint) mData.size());
+		chunkStream.writeRawData(mData.data(), mData.size());
+	}
 	
 	++mFrameNumber;
+	
+	if(((int) mChunkInfo.mNumberOfFrames) >= mFramesPerChunk->get()) {
+		flushChunk();
+	}
+}
 
-	delete mDataStream;
-	mDataStream = 0;
+
+/**
+ * Hands the current chunk over to the writer thread and starts a new chunk.
+ */
+void SimulationRecorder::flushChunk() {
+	if(mChunkWriter == 0 || mChunkInfo.mNumberOfFrames == 0) {
+		return;
+	}
+	mChunkWriter->addChunk(mChunkInfo, mChunkData);
+	mChunkData = QByteArray();
+	mChunkInfo = RecordingChunkInfo();
 }
 
 
@@ -511,6 +558,9 @@ void SimulationRecorder::recordData(bool forceRecording) {
  * 
  * Before showing the first frame, the number of frames and the range of the simulation time
  * are summarized. If this makes problems, try to use the slower PlaybackSafeMode (for currupt files).
+ * 
+ * Indexed data files (format 3) are read with an IndexedRecordingReader. Files of format 2
+ * are still played back with the old sequential reader.
  */
 bool SimulationRecorder::startPlayback() {
 	if(mExecutionMode == SIMREC_RECORDING) {
@@ -544,66 +594,88 @@ bool SimulationRecorder::startPlayback() {
 	}
 	uint version = 0;
 	mFileDataStream >> version;
-	if(mFileDataStream.atEnd() || version != 2) {
+	mVersion = version;
+	
+	if(version == RECORDING_FORMAT_INDEXED) {
+		mFileDataStream.setDevice(0);
+		if(!mIndexedReader.open(mPlaybackFile->get(), mPlaybackSafeMode->get())) {
+			Core::log("SimulationRecorder: Could not read indexed data file [" 
+						+ mPlaybackFile->get() + "]", true);
+			stopPlayback();
+			return false;
+		}
+		if(mIndexedReader.wasRecovered()) {
+			Core::log("SimulationRecorder: Recovered frame index of data file [" 
+						+ mPlaybackFile->get() + "] with " 
+						+ QString::number(mIndexedReader.getNumberOfFrames()) + " frames.", true);
+		}
+		mNumberOfFrames = mIndexedReader.getNumberOfFrames();
+		mStartEndFrameValue->set(mIndexedReader.getFirstStep(), mIndexedReader.getLastStep());
+		mStartEndFrameRange.set(mIndexedReader.getFirstStep(), mIndexedReader.getLastStep());
+		mNumberOfFramesValue->set(mNumberOfFrames);
+	}
+	else if(mFileDataStream.atEnd() || version != 2) {
 		stopPlayback();
 		return false;
 	}
-	uint frameNumber = 0;
-	mFileDataStream >> frameNumber;
-	qint32 start = -1;
-	mFileDataStream >> start;
-	qint32 end = start;
-	
-	if(!mPlaybackSafeMode->get()) {
-		uint size = 0;
-		qint64 fileSize = mFile->size();
-		mFile->seek(fileSize - sizeof(uint));
-		mFileDataStream >> size;
-		mFile->seek(mFile->pos() - size - (2 * sizeof(uint)) - (2 * sizeof(qint32)));
+	else {
+		uint frameNumber = 0;
 		mFileDataStream >> frameNumber;
-		mFileDataStream >> end;
+		qint32 start = -1;
+		mFileDataStream >> start;
+		qint32 end = start;
+	
+		if(!mPlaybackSafeMode->get()) {
+			uint size = 0;
+			qint64 fileSize = mFile->size();
+			mFile->seek(fileSize - sizeof(uint));
+			mFileDataStream >> size;
+			mFile->seek(mFile->pos() - size - (2 * sizeof(uint)) - (2 * sizeof(qint32)));
+			mFileDataStream >> frameNumber;
+			mFileDataStream >> end;
 		
-		mNumberOfFrames = frameNumber + 1;
+			mNumberOfFrames = frameNumber + 1;
 		
-		mStartEndFrameValue->set(start, end);
-		mStartEndFrameRange.set(start, end);
-		mNumberOfFramesValue->set(mNumberOfFrames);
-	}
-	else {
-		//this is much slower, but it also works with corrupt files that 
-		//may occur when no space is left on a defice during writing.
-		int updateCounter = 0;
-		uint size = 0;
-		while(!mFileDataStream.atEnd()) {
-			++mNumberOfFrames;
+			mStartEndFrameValue->set(start, end);
+			mStartEndFrameRange.set(start, end);
+			mNumberOfFramesValue->set(mNumberOfFrames);
+		}
+		else {
+			//this is much slower, but it also works with corrupt files that 
+			//may occur when no space is left on a defice during writing.
+			int updateCounter = 0;
+			uint size = 0;
+			while(!mFileDataStream.atEnd()) {
+				++mNumberOfFrames;
 			
-			mFileDataStream >> size;
-			mFileDataStream.skipRawData(size);
-			mFileDataStream >> size;
-			if(!mFileDataStream.atEnd()) {
-				mFileDataStream >> frameNumber;
-			}
-			if(!mFileDataStream.atEnd()) {
-				mFileDataStream >> end;
-			}
+				mFileDataStream >> size;
+				mFileDataStream.skipRawData(size);
+				mFileDataStream >> size;
+				if(!mFileDataStream.atEnd()) {
+					mFileDataStream >> frameNumber;
+				}
+				if(!mFileDataStream.atEnd()) {
+					mFileDataStream >> end;
+				}
 			
-			if(updateCounter++ > 500) {
-				updateCounter = 0;
+				if(updateCounter++ > 500) {
+					updateCounter = 0;
 				
-				//execute core scheduler
-				Core::getInstance()->executePendingTasks();
+					//execute core scheduler
+					Core::getInstance()->executePendingTasks();
 				
-				//do not continue, if the playback has been canceled.
-				if(!mActivatePlayback->get()) {
-					stopPlayback();
-					return false;
+					//do not continue, if the playback has been canceled.
+					if(!mActivatePlayback->get()) {
+						stopPlayback();
+						return false;
+					}
 				}
 			}
-		}
 
-		mStartEndFrameValue->set(start, end);
-		mStartEndFrameRange.set(start, end);
-		mNumberOfFramesValue->set(mNumberOfFrames);
+			mStartEndFrameValue->set(start, end);
+			mStartEndFrameRange.set(start, end);
+			mNumberOfFramesValue->set(mNumberOfFrames);
+		}
 	}
 	
 	mFrameNumber = 0;
@@ -655,6 +727,8 @@ bool SimulationRecorder::stopPlayback() {
 		delete mFile;
 		mFile = 0;
 	}
+	mIndexedReader.close();
+	
 	if(mActivatePlayback->get()) {
 		mActivatePlayback->set(false);
 	}
@@ -688,6 +762,11 @@ void SimulationRecorder::playbackData() {
 		return;
 	}
 	
+	if(mVersion == RECORDING_FORMAT_INDEXED) {
+		playbackIndexedData();
+		return;
+	}
+	
 	//restart if at end of file.
 	if(mReachedAndOfFile) {
 		mFileDataStream.setDevice(0);
@@ -861,6 +940,60 @@ void SimulationRecorder::playbackData() {
 }
 
 
+/**
+ * Plays back a single data frame of an indexed data file (format 3).
+ * Seeking to a desired frame only requires a lookup in the frame index, so 
+ * jumps over arbitrary distances take constant time.
+ */
+void SimulationRecorder::playbackIndexedData() {
+	
+	if(mDesiredFrameValue->get() >= mNumberOfFrames || mDesiredFrameValue->get() == ((int) mFrameNumber)) {
+		mDesiredFrameValue->set(-1);
+	}
+	if(mDesiredFrameValue->get() >= 0) {
+		mFrameNumber = mDesiredFrameValue->get();
+		mDesiredFrameValue->set(-1);
+		mFirstPlaybackStep = true;
+	}
+	
+	//restart if at end of file.
+	if(((int) mFrameNumber) >= mNumberOfFrames) {
+		mFrameNumber = 0;
+		mFirstPlaybackStep = true;
+	}
+	
+	qint32 step = 0;
+	if(!mIndexedReader.getStepOfFrame(mFrameNumber, step)) {
+		Core::log("SimulationRecorder: Could not read frame " + QString::number(mFrameNumber), true);
+		stopPlayback();
+		return;
+	}
+	mStepCounter = step;
+	
+	//ckeck if we have to wait for the currect step to come...
+	if(!mFirstPlaybackStep && (mStepCounter > mCurrentStep->get())) {
+		return;
+	}
+	mFirstPlaybackStep = false;
+	
+	mCurrentStep->set(mStepCounter);
+	mCurrentFrameValue->set(mFrameNumber);
+	
+	QByteArray data;
+	if(!mIndexedReader.readFrame(mFrameNumber, data)) {
+		Core::log("SimulationRecorder: Could not read frame " + QString::number(mFrameNumber), true);
+		stopPlayback();
+		return;
+	}
+	++mFrameNumber;
+	
+	QDataStream dataStream(&data, QIODevice::ReadOnly);
+	
+	//recover the data of the single frame
+	updatePlaybackData(dataStream);
+}
+
+
 /**
  * Creates the a list with all matching (found) values to record and stores this
  * in mRecordedValueNameList, that can be viewed in the graphical PropertyPanel.
@@ -64,6 +64,8 @@
 #include <qtextstream.h>
 #include "Value/RangeValue.h"
 #include "Value/ULongLongValue.h"
+#include "Gui/SimulationRecorder/RecordingChunkWriter.h"
+#include "Gui/SimulationRecorder/IndexedRecordingReader.h"
 
 namespace nerd {
 
@@ -97,6 +99,7 @@ namespace nerd {
 		virtual bool startPlayback();
 		virtual bool stopPlayback();
 		virtual void playbackData();
+		virtual void playbackIndexedData();
 		
 		virtual void updateRecordedValueNameList();
 
@@ -108,6 +111,7 @@ namespace nerd {
 		virtual void updateRecordedData(QDataStream &dataStream);
 		virtual void updatePlaybackData(QDataStream &dataStream);
 		virtual void writeInfoFile(QTextStream &dataStream);
+		virtual void flushChunk();
 
 	private:	
 		Event *mResetEvent;
@@ -131,6 +135,8 @@ namespace nerd {
 		IntValue *mCurrentFrameValue;
 		BoolValue *mResetTotalStepsCounter;
 		ULongLongValue *mTotalStepsCounters;
+		IntValue *mFramesPerChunk;
+		BoolValue *mCompressChunks;
 		
 		
 		bool mPhysicsWasDisabled;
@@ -160,6 +166,11 @@ namespace nerd {
 		bool mFirstPlaybackStep;
 		bool mReadStepNumber;
 		uint mVersion;
+		
+		RecordingChunkWriter *mChunkWriter;
+		QByteArray mChunkData;
+		RecordingChunkInfo mChunkInfo;
+		IndexedRecordingReader mIndexedReader;
 	};
 
 }
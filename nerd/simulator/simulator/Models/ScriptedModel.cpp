@@ -55,6 +55,7 @@
 #include <QStringList>
 #include "Physics/BoxBody.h"
 #include "Physics/CapsuleBody.h"
+#include "Util/Profiler.h"
 
 
 using namespace std;
@@ -126,6 +127,7 @@ SimObject* ScriptedModel::createCopy() const {
 }
 
 void ScriptedModel::createModel() {
+	PROFILE_SCOPE("ScriptedModel::createModel");
 	mIdCounter = 1;
 
 	if(!hasModelSection()) {
@@ -176,6 +178,7 @@ void ScriptedModel::randomizeObjects() {
 }
 
 void ScriptedModel::createEnvironment() {
+	PROFILE_SCOPE("ScriptedModel::createEnvironment");
 
 	if(mScript == 0) {
 		return;
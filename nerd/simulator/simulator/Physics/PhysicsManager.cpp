@@ -56,6 +56,7 @@
 #include <QMutexLocker>
 #include <QRegExp>
 #include "Util/Tracer.h"
+#include "Util/Profiler.h"
 
 #include "Physics/SimBody.h"
 #include "Physics/SimActuator.h"
@@ -294,6 +295,7 @@ bool PhysicsManager::resetSimulation() {
 }
 
 bool PhysicsManager::executeSimulationStep() {
+	PROFILE_SCOPE("PhysicsManager::executeSimulationStep");
 
 	if(mDisablePhysics->get()) {
 		//still update the simulation time!
@@ -319,7 +321,10 @@ bool PhysicsManager::executeSimulationStep() {
 
 	bool executeStepOk = true;
 	if(mPhysicalSimulationAlgorithm != 0) {
-		mPhysicalSimulationAlgorithm->executeSimulationStep(this);
+		{
+			PROFILE_SCOPE("Physics");
+			mPhysicalSimulationAlgorithm->executeSimulationStep(this);
+		}
 
 		if(measurePerformance) {
 			mPhysicalStepDuration->set(time.restart());
@@ -327,6 +332,7 @@ bool PhysicsManager::executeSimulationStep() {
 
 		//synchronize all SimObjects with the current state of the physical model.
 		if(mSynchronizeObjectsWithPhysicalModel) {
+			PROFILE_SCOPE("Synchronization");
 			for(QList<SimObject*>::iterator i = mSimObjects.begin(); 
 				i != mSimObjects.end(); i++) 
 			{
@@ -339,6 +345,7 @@ bool PhysicsManager::executeSimulationStep() {
 		}
 
 		if(mCollisionManager !=  0 ) {
+			PROFILE_SCOPE("CollisionHandling");
 			mCollisionManager->updateCollisionRules();
 		}
 
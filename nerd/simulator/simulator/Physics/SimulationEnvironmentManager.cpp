@@ -55,6 +55,7 @@
 #include "Math/Random.h"
 #include <iostream>
 #include <Math/Math.h>
+#include "Util/Profiler.h"
 
 using namespace std;
 
@@ -175,27 +176,16 @@ void SimulationEnvironmentManager::storeParameter(SimObject *object,const QStrin
 			.append(paramValueName).append("\""));
 		return;
 	}
-	if(mParameterSettings.find(object) == mParameterSettings.end()) {
-		QHash<Value*, QString> objectSettingsHash;
-		objectSettingsHash[objectParameter] = valueAsString;
-		mParameterSettings[object] = objectSettingsHash;
-	}
-	else {
-		QHash<Value*, QString> savedSettings = mParameterSettings.value(object);
-		savedSettings[objectParameter] = valueAsString;
-		mParameterSettings[object] = savedSettings;
-	}
+	//modify the stored settings in place to avoid copying the settings of the object.
+	mParameterSettings[object].insert(objectParameter, valueAsString);
 }
 
 void SimulationEnvironmentManager::clearParameter(SimObject *object, const QString &paramValueName) {
-	QHash<Value*, QString> objectHash;
 	Value* valuetoRemove = object->getParameter(paramValueName);
-	if(mParameterSettings.find(object) != mParameterSettings.end() 
-		&& valuetoRemove != 0) 
-	{
-		objectHash = mParameterSettings.value(object);
-		objectHash.remove(valuetoRemove);
-		mParameterSettings[object] = objectHash;
+	QHash<SimObject*, QHash<Value*, QString> >::iterator settings = 
+				mParameterSettings.find(object);
+	if(settings != mParameterSettings.end() && valuetoRemove != 0) {
+		settings.value().remove(valuetoRemove);
 	}
 }
 
@@ -213,28 +203,27 @@ void SimulationEnvironmentManager::clearAllParameters() {
  */
 void SimulationEnvironmentManager::resetStartConditions() {
 
-	for(int i = 0; i < mParameterSettings.size(); i++) {
-		QHash<Value*, QString> parameters = mParameterSettings.value(
-			mParameterSettings.keys().at(i));
-		QHash<Value*, QString> buffer = parameters;
+	for(QHashIterator<SimObject*, QHash<Value*, QString> > i(mParameterSettings); i.hasNext();) {
+		const QHash<Value*, QString> &parameters = i.next().value();
 
 		//TODO test this carefully!
 
-		for(int j = 0; j < parameters.size(); j++) {
-			Value *value = parameters.keys().at(j);
-			if(dynamic_cast<QuaternionValue*>(value) != 0) {
-				//restore quaternions first to prevent orientation values to change...
-				QString parameterValue = parameters.value(value);
-				value->setValueFromString(parameterValue);
-				buffer.remove(value);
+		//restore quaternions first to prevent orientation values to change...
+		for(QHash<Value*, QString>::const_iterator j = parameters.constBegin(); 
+				j != parameters.constEnd(); ++j) 
+		{
+			if(dynamic_cast<QuaternionValue*>(j.key()) != 0) {
+				j.key()->setValueFromString(j.value());
 			}
 		}
 
 		//restore all remaining values.
-		for(int j = 0; j < buffer.size(); j++) {
-			Value *value = buffer.keys().at(j);
-			QString parameterValue = buffer.value(value);
-			value->setValueFromString(parameterValue);
+		for(QHash<Value*, QString>::const_iterator j = parameters.constBegin(); 
+				j != parameters.constEnd(); ++j) 
+		{
+			if(dynamic_cast<QuaternionValue*>(j.key()) == 0) {
+				j.key()->setValueFromString(j.value());
+			}
 		}
 	}
 	performRandomization();
@@ -246,15 +235,20 @@ void SimulationEnvironmentManager::resetStartConditions() {
  * registered at the PhysicsManager.
  */
 void SimulationEnvironmentManager::createSnapshot() {
+	PROFILE_SCOPE("SimulationEnvironmentManager::createSnapshot");
 
 	QList<SimObject*> simObjects = Physics::getPhysicsManager()->getSimObjects();
 
-	SimObject *current = 0;
 	for(int i = 0; i < simObjects.size(); i++) {
-		current = simObjects.at(i);
-		for(int j = 0; j < current->getParameterNames().size(); j++) {
-			QString paramName = current->getParameterNames().at(j);
-			storeParameter(current, paramName, current->getParameter(paramName)->getValueAsString()); 
+		SimObject *current = simObjects.at(i);
+
+		//the parameters are stored directly (instead of using storeParameter()) to 
+		//avoid a lookup of each parameter by name.
+		QHash<Value*, QString> &settings = mParameterSettings[current];
+		QList<Value*> parameters = current->getParameters();
+		for(QListIterator<Value*> j(parameters); j.hasNext();) {
+			Value *parameter = j.next();
+			settings.insert(parameter, parameter->getValueAsString());
 		}
 	}	
 }
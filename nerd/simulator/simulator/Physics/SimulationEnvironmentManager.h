@@ -65,6 +65,11 @@ class Value;
  * EventListener for the event "/Control/ResetSimulationSettings" and 
  * reacts to the event by changing the value of all stored parameters 
  * to the values that are saved. 
+ *
+ * The snapshot (createSnapshot(), getSnapshot()) refers to the Values of the
+ * SimObjects of this process and is not serialized. The environment of a new
+ * process is built by its models, because e.g. ScriptedModels own their objects 
+ * and run their scripts again at each reset.
  */
 
 class SimulationEnvironmentManager : public virtual SystemObject, 
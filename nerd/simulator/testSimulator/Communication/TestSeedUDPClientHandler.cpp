@@ -0,0 +1,179 @@
+/***************************************************************************
+ *   NERD - Neurodynamics and Evolutionary Robotics Development Toolkit    *
+ *                                                                         *
+ *   University of Osnabrueck, Germany                                     *
+ *   Institute of Cognitive Science                                        *
+ *   Neurocybernetics Group                                                *
+ *   http://www.ikw.uni-osnabrueck.de/~neurokybernetik/                    *
+ *                                                                         *
+ *   Project homepage: nerd.x-bot.org                                      *
+ *                                                                         *
+ *   Copyright (C) 2008 - 2013 by the Neurocybernetics Group Osnabrück     *
+ *   Contact: Christian Rempis                                             *
+ *   christian.rempis@uni-osnabrueck.de                                    *
+ *   Contributors: see contributors.txt in the nerd main directory.        *
+ *                                                                         *
+ *                                                                         *
+ *   Acknowledgments:                                                      *
+ *   The NERD Toolkit is part of the EU project ALEAR                      *
+ *   (Artificial Language Evolution on Autonomous Robots) www.ALEAR.eu     *
+ *   This work was funded (2008 - 2011) by EU-Project Number ICT 214856    *
+ *                                                                         *
+ *                                                                         *
+ *   License Agreement:                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ *                                                                         *
+ *   Publications based on work using the NERD kit have to state this      *
+ *   clearly by citing the NERD homepage and the NERD overview paper.      *  
+ ***************************************************************************/
+
+
+
+#include "TestSeedUDPClientHandler.h"
+#include "Communication/SeedUDPClientHandler.h"
+#include "Communication/SeedUDPCommunication.h"
+#include "Communication/UdpDatagram.h"
+#include "Core/Core.h"
+
+namespace nerd {
+
+//Gives access to the interface groups and the reset handlers. Without an owner
+//no simulation steps are requested.
+class SeedUDPClientHandlerAdapter : public SeedUDPClientHandler {
+public:
+	SeedUDPClientHandlerAdapter() : SeedUDPClientHandler(0, QHostAddress::LocalHost, 0, 2) {}
+
+	InterfaceGroup* addInterfaceGroup(int id) {
+		InterfaceGroup *group = new InterfaceGroup(id);
+		mInterfaceGroups.insert(id, group);
+		return group;
+	}
+	bool resetSimulation() {
+		return handleResetSimulationCommand();
+	}
+	bool resetCommunication() {
+		return handleResetCommunicationCommand();
+	}
+};
+
+
+//fills the step queue and the batch state of a group as during a pipelined batch.
+static void queueFrames(InterfaceGroup *group) {
+	group->mPendingInputFrames.append(QVector<double>(2, 0.5));
+	group->mPendingInputFrames.append(QVector<double>(2, -0.5));
+	group->mPendingBatchSizes << 2 << 0;
+	group->mStepRunning = true;
+	group->mBatchSize = 3;
+	group->mBatchRemaining = 1;
+	group->mBatchOutputFrames << 1.0 << 2.0;
+}
+
+void TestSeedUDPClientHandler::testBatchCompletedDatagrams() {
+	//3 outputs + 1 info per frame, 10 frames.
+	InterfaceGroup group(7);
+	group.mOutputValues.resize(3);
+	group.mInfoValues.resize(1);
+	group.mBatchSize = 10;
+	for(int i = 0; i < 40; ++i) {
+		group.mBatchOutputFrames.append(i * 0.25);
+	}
+	QList<int> eventIds;
+	eventIds << 3 << 5;
+
+	//small batch: everything fits into a single datagram.
+	QList<QByteArray> datagrams = 
+			SeedUDPClientHandler::createBatchCompletedDatagrams(group, eventIds);
+	QCOMPARE(datagrams.size(), 1);
+	QCOMPARE(datagrams.at(0).size(), 2 + (6 * 4) + (40 * 4) + (2 * 4));
+
+	//limit the datagram size to the header, the events and 4 frames (16 bytes each).
+	int maxSize = 2 + (6 * 4) + (2 * 4) + (4 * 16);
+	datagrams = SeedUDPClientHandler::createBatchCompletedDatagrams(group, eventIds, maxSize);
+	QCOMPARE(datagrams.size(), 3);
+
+	int expectedFirstFrame = 0;
+	int expectedCounts[] = {4, 4, 2};
+	for(int i = 0; i < datagrams.size(); ++i) {
+		QVERIFY(datagrams.at(i).size() <= maxSize);
+
+		UdpDatagram datagram;
+		datagram.setData(datagrams.at(i));
+		QCOMPARE(datagram.readNextByte(), 
+				 (unsigned char) SeedUDPCommunication::UDP_NEXT_SIMULATION_STEPS_COMPLETED);
+		QCOMPARE(datagram.readNextInt(), 7);
+		QCOMPARE(datagram.readNextInt(), expectedFirstFrame);
+		int count = datagram.readNextInt();
+		QCOMPARE(count, expectedCounts[i]);
+		QCOMPARE(datagram.readNextInt(), 3);
+		QCOMPARE(datagram.readNextInt(), 1);
+
+		//events are only attached to the last datagram.
+		int numberOfEvents = datagram.readNextInt();
+		QCOMPARE(numberOfEvents, i == 2 ? 2 : 0);
+
+		for(int j = expectedFirstFrame * 4; j < (expectedFirstFrame + count) * 4; ++j) {
+			QCOMPARE(datagram.readNextFloat(), (float) (j * 0.25));
+		}
+		if(numberOfEvents > 0) {
+			QCOMPARE(datagram.readNextInt(), 3);
+			QCOMPARE(datagram.readNextInt(), 5);
+		}
+		QCOMPARE(datagram.readNextByte(), (unsigned char) SeedUDPCommunication::UDP_DATAGRAM_END);
+		QCOMPARE(datagram.maxUnreadBytes(), 0);
+
+		expectedFirstFrame += count;
+	}
+	QCOMPARE(expectedFirstFrame, 10);
+}
+
+
+
+//Motor frames queued before a reset must not be applied to steps after the reset.
+void TestSeedUDPClientHandler::testResetDropsQueuedFrames() {
+	Core::resetCore();
+	{
+		SeedUDPClientHandlerAdapter handler;
+		InterfaceGroup *group1 = handler.addInterfaceGroup(1);
+		InterfaceGroup *group2 = handler.addInterfaceGroup(2);
+
+		for(int i = 0; i < 2; ++i) {
+			queueFrames(group1);
+			queueFrames(group2);
+
+			//without owner the reset itself fails, but the queues are dropped anyway.
+			if(i == 0) {
+				handler.resetSimulation();
+			}
+			else {
+				handler.resetCommunication();
+			}
+
+			for(int j = 0; j < 2; ++j) {
+				InterfaceGroup *group = j == 0 ? group1 : group2;
+				QVERIFY(group->mPendingInputFrames.empty());
+				QVERIFY(group->mPendingBatchSizes.empty());
+				QVERIFY(group->mStepRunning == false);
+				QCOMPARE(group->mBatchSize, 0);
+				QCOMPARE(group->mBatchRemaining, 0);
+				QVERIFY(group->mBatchOutputFrames.empty());
+			}
+		}
+	}
+	Core::resetCore();
+}
+
+}
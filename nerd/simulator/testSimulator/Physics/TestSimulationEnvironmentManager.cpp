@@ -46,6 +46,7 @@
 #include "Physics/SimulationEnvironmentManager.h"
 #include "Physics/SimObjectAdapter.h"
 #include "Physics/Physics.h"
+#include "Physics/PhysicsManager.h"
 #include "Value/DoubleValue.h"
 #include "Value/StringValue.h"
 #include "Value/BoolValue.h"
@@ -166,11 +167,46 @@ void TestSimulationEnvironmentManager::testStoreAndResetParams() {
 }
 
 
-// void TestSimulationEnvironmentManager::testCreateSnapshot() {
-// 	Core::resetCore();
-// 	SimulationEnvironmentManager *sManager = Physics::getSimulationEnvironmentManager();
-// 	//TODO (if necessary)
-// }
+//createSnapshot() stores the current parameters of all registered SimObjects as 
+//start conditions for the reset.
+void TestSimulationEnvironmentManager::testCreateSnapshot() {
+	Core::resetCore();
+	SimulationEnvironmentManager *sManager = Physics::getSimulationEnvironmentManager();
+	PhysicsManager *pm = Physics::getPhysicsManager();
+
+	SimObjectAdapter *obj1 = new SimObjectAdapter("Obj1", "");
+	DoubleValue *test1 = new DoubleValue(1.5);
+	obj1->addParameter("Test1", test1);
+	SimObjectAdapter *obj2 = new SimObjectAdapter("Obj2", "");
+	StringValue *test2 = new StringValue("Start");
+	obj2->addParameter("Test2", test2);
+	QVERIFY(pm->addSimObject(obj1));
+	QVERIFY(pm->addSimObject(obj2));
+
+	sManager->createSnapshot();
+	QCOMPARE(sManager->getSnapshot().size(), 2);
+	QCOMPARE(sManager->getSnapshot().value(obj1).size(), obj1->getParameters().size());
+	QVERIFY(sManager->getSnapshot().value(obj1).value(test1) == "1.5");
+
+	test1->set(-3.0);
+	test2->set("Changed");
+	sManager->resetStartConditions();
+	QCOMPARE(test1->get(), 1.5);
+	QVERIFY(test2->get() == "Start");
+
+	//a new snapshot replaces the stored settings, storeParameter() changes single settings.
+	test1->set(2.5);
+	sManager->createSnapshot();
+	QCOMPARE(sManager->getSnapshot().size(), 2);
+	sManager->storeParameter(obj2, "Test2", "Stored");
+	test1->set(0.0);
+	sManager->resetStartConditions();
+	QCOMPARE(test1->get(), 2.5);
+	QVERIFY(test2->get() == "Stored");
+
+	Core::resetCore();
+}
+
 // 
 // void TestSimulationEnvironmentManager::testRandomization() {
 // 	Core::resetCore();
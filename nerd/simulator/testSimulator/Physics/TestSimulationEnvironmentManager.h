@@ -54,7 +54,7 @@ Q_OBJECT
 
 private slots:
 	void testStoreAndResetParams();
-// 	void testCreateSnapshot();
+	void testCreateSnapshot();
 // 	void testRandomization();
 };
 }
@@ -0,0 +1,218 @@
+/***************************************************************************
+ *   NERD - Neurodynamics and Evolutionary Robotics Development Toolkit    *
+ *                                                                         *
+ *   University of Osnabrueck, Germany                                     *
+ *   Institute of Cognitive Science                                        *
+ *   Neurocybernetics Group                                                *
+ *   http://www.ikw.uni-osnabrueck.de/~neurokybernetik/                    *
+ *                                                                         *
+ *   Project homepage: nerd.x-bot.org                                      *
+ *                                                                         *
+ *   Copyright (C) 2008 - 2013 by the Neurocybernetics Group Osnabrück     *
+ *   Contact: Christian Rempis                                             *
+ *   christian.rempis@uni-osnabrueck.de                                    *
+ *   Contributors: see contributors.txt in the nerd main directory.        *
+ *                                                                         *
+ *                                                                         *
+ *   Acknowledgments:                                                      *
+ *   The NERD Toolkit is part of the EU project ALEAR                      *
+ *   (Artificial Language Evolution on Autonomous Robots) www.ALEAR.eu     *
+ *   This work was funded (2008 - 2011) by EU-Project Number ICT 214856    *
+ *                                                                         *
+ *                                                                         *
+ *   License Agreement:                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ *                                                                         *
+ *   Publications based on work using the NERD kit have to state this      *
+ *   clearly by citing the NERD homepage and the NERD overview paper.      *  
+ ***************************************************************************/
+
+
+
+#include "TestIndexedRecordingReader.h"
+#include "Core/Core.h"
+#include <QFile>
+#include <QDataStream>
+#include "Gui/SimulationRecorder/RecordingChunkWriter.h"
+#include "Gui/SimulationRecorder/IndexedRecordingReader.h"
+
+namespace nerd {
+
+static const uint NUMBER_OF_FRAMES = 10;
+static const uint FRAMES_PER_CHUNK = 4;
+
+
+void TestIndexedRecordingReader::testWriteAndSeek_data() {
+	QTest::addColumn<bool>("compress");
+
+	QTest::newRow("uncompressed") << false;
+	QTest::newRow("compressed") << true;
+}
+
+
+/**
+ * Writes NUMBER_OF_FRAMES frames as SimulationRecorder does: (numberOfValues | value...) 
+ * per frame, with the values frame * 0.5 and -frame.
+ */
+static bool writeTestRecording(const QString &fileName, bool compress) {
+	QFile file(fileName);
+	if(!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+		return false;
+	}
+
+	RecordingChunkWriter *writer = new RecordingChunkWriter(&file, FRAMES_PER_CHUNK, compress);
+	writer->start();
+
+	RecordingChunkInfo chunkInfo;
+	QByteArray chunkData;
+	for(uint frame = 0; frame < NUMBER_OF_FRAMES; ++frame) {
+		qint32 step = 100 + (2 * frame);
+
+		QByteArray frameData;
+		{
+			QDataStream frameStream(&frameData, QIODevice::WriteOnly);
+			frameStream << ((qint32) 2);
+			frameStream << (frame * 0.5);
+			frameStream << (-1.0 * frame);
+		}
+		if(chunkInfo.mNumberOfFrames == 0) {
+			chunkInfo.mFirstFrame = frame;
+			chunkInfo.mFirstStep = step;
+		}
+		chunkInfo.mLastStep = step;
+		++chunkInfo.mNumberOfFrames;
+
+		QDataStream chunkStream(&chunkData, QIODevice::WriteOnly | QIODevice::Append);
+		chunkStream << frame;
+		chunkStream << step;
+		chunkStream << ((uint) frameData.size());
+		chunkStream.writeRawData(frameData.data(), frameData.size());
+
+		if(chunkInfo.mNumberOfFrames >= FRAMES_PER_CHUNK || frame == NUMBER_OF_FRAMES - 1) {
+			writer->addChunk(chunkInfo, chunkData);
+			chunkInfo = RecordingChunkInfo();
+			chunkData = QByteArray();
+		}
+	}
+	writer->finish();
+	bool ok = writer->getNumberOfWrittenChunks() == 3;
+	delete writer;
+	file.close();
+	return ok;
+}
+
+
+void TestIndexedRecordingReader::testWriteAndSeek() {
+	QFETCH(bool, compress);
+
+	Core::resetCore();
+
+	QVERIFY(writeTestRecording("IndexedRecordingTestFile.dat", compress));
+
+	//read with footer and with a rebuilt index.
+	for(int rebuild = 0; rebuild < 2; ++rebuild) {
+		IndexedRecordingReader reader;
+		QVERIFY(reader.open("IndexedRecordingTestFile.dat", rebuild == 1));
+		QCOMPARE(reader.wasRecovered(), rebuild == 1);
+		QCOMPARE(reader.getNumberOfFrames(), NUMBER_OF_FRAMES);
+		QCOMPARE(reader.getIndex().size(), 3);
+		QCOMPARE(reader.getFirstStep(), (qint32) 100);
+		QCOMPARE(reader.getLastStep(), (qint32) 118);
+
+		//seek forward across chunks, then backward into the first chunk.
+		uint frames[] = {6, 9, 1, 4};
+		for(int i = 0; i < 4; ++i) {
+			uint frame = frames[i];
+			qint32 step = 0;
+			QVERIFY(reader.getStepOfFrame(frame, step));
+			QCOMPARE(step, (qint32) (100 + (2 * frame)));
+
+			QByteArray data;
+			QVERIFY(reader.readFrame(frame, data));
+			QDataStream stream(data);
+			qint32 numberOfValues = 0;
+			double value1 = 0.0;
+			double value2 = 0.0;
+			stream >> numberOfValues >> value1 >> value2;
+			QCOMPARE(numberOfValues, (qint32) 2);
+			QCOMPARE(value1, frame * 0.5);
+			QCOMPARE(value2, -1.0 * frame);
+		}
+
+		QByteArray data;
+		QVERIFY(!reader.readFrame(NUMBER_OF_FRAMES, data));
+		reader.close();
+	}
+
+	QFile::remove("IndexedRecordingTestFile.dat");
+
+	Core::resetCore();
+}
+
+
+
+void TestIndexedRecordingReader::testReadChannels_data() {
+	QTest::addColumn<bool>("compress");
+
+	QTest::newRow("uncompressed") << false;
+	QTest::newRow("compressed") << true;
+}
+
+
+void TestIndexedRecordingReader::testReadChannels() {
+	QFETCH(bool, compress);
+
+	Core::resetCore();
+
+	QVERIFY(writeTestRecording("IndexedRecordingTestFile.dat", compress));
+
+	IndexedRecordingReader reader;
+	QVERIFY(reader.open("IndexedRecordingTestFile.dat"));
+
+	//a subset of the channels in arbitrary order, unknown channels are 0.
+	QVector<int> channels;
+	channels << 1 << 0 << 1 << 7 << -1;
+
+	uint frames[] = {3, 8, 0};
+	for(int i = 0; i < 3; ++i) {
+		uint frame = frames[i];
+		QVector<double> values(1, 42.0);
+		QVERIFY(reader.readChannels(frame, channels, values));
+		QCOMPARE(values.size(), 5);
+		QCOMPARE(values.at(0), -1.0 * frame);
+		QCOMPARE(values.at(1), frame * 0.5);
+		QCOMPARE(values.at(2), -1.0 * frame);
+		QCOMPARE(values.at(3), 0.0);
+		QCOMPARE(values.at(4), 0.0);
+	}
+
+	//only the second channel.
+	QVector<int> secondChannel(1, 1);
+	QVector<double> values;
+	QVERIFY(reader.readChannels(5, secondChannel, values));
+	QCOMPARE(values.size(), 1);
+	QCOMPARE(values.at(0), -5.0);
+
+	QVERIFY(!reader.readChannels(NUMBER_OF_FRAMES, secondChannel, values));
+	reader.close();
+
+	QFile::remove("IndexedRecordingTestFile.dat");
+
+	Core::resetCore();
+}
+
+}
@@ -72,8 +72,10 @@
 #include "Physics/TestLightSensor.h"
 #include "Physics/TestDistanceSensor.h"
 #include "Physics/TestServoMotor.h"
+#include "SimulationRecorder/TestIndexedRecordingReader.h"
+#include "Communication/TestSeedUDPClientHandler.h"
 
-TEST_START("TestSimulator", 1, -1, 25);
+TEST_START("TestSimulator", 1, -1, 27);
 
 	TEST(TestGeom); //tests all geoms.
 	TEST(TestCollisionObject);
@@ -104,6 +106,8 @@ TEST_START("TestSimulator", 1, -1, 25);
 	TEST(TestLightSensor);
 	TEST(TestDistanceSensor);
 	TEST(TestServoMotor);
+	TEST(TestIndexedRecordingReader);
+	TEST(TestSeedUDPClientHandler);
 
 TEST_END;
 
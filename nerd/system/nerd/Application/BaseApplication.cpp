@@ -51,6 +51,11 @@
 #include <iostream>
 #include <QCoreApplication>
 #include "Value/ValueAtCommandLineHandler.h"
+#include "Value/BoolValue.h"
+#include "Util/Profiler.h"
+#include "NerdConstants.h"
+#include <QFile>
+#include <QTextStream>
 
 using namespace std;
 
@@ -61,7 +66,8 @@ namespace nerd {
  *
  */
 BaseApplication::BaseApplication()
-	: mSetUp(false), mShutDown(false), mName("BaseApplication")
+	: mSetUp(false), mShutDown(false), mName("BaseApplication"), 
+	  mProfilingStartup(false), mMeasurementsEnabledBeforeStartup(false)
 {
 	connect(this, SIGNAL(quitMainApplication()),
 			QCoreApplication::instance(), SLOT(quit()));
@@ -80,6 +86,14 @@ BaseApplication::BaseApplication()
 			1, 0,
 			true);
 
+	mArgument_startupProfile = new CommandLineArgument(
+			"startupProfile", "startupProfile", "[<file>]",
+			"Measures the duration of all startup phases and prints a report "
+			"when the startup is completed.\n"
+			"If <file> is given, then the report is also written to this file.",
+			0, 1,
+			true);
+
 	//allow for setting of parameters via command line argument (-sv)
 	new ValueAtCommandLineHandler();
 }
@@ -176,6 +190,10 @@ QString BaseApplication::getName() const {
  */
 void BaseApplication::run() {
 
+	if(mArgument_startupProfile->getNumberOfEntries() > 0) {
+		beginStartupProfile();
+	}
+
 	setUp();
 
 	if(!startSystem()) {
@@ -242,6 +260,7 @@ void BaseApplication::loadValues(QStringList fileNames) {
  */
 bool BaseApplication::setUp() {
 	bool ok = true;
+	PROFILE_SCOPE("SetupApplication");
 	if(!setupApplication()) {
 		Core::log("BaseApplication: Problems setting up simulator!");
 		ok = false;
@@ -265,17 +284,31 @@ bool BaseApplication::startSystem() {
 		setUp();
 	}
 
-	loadValues(mArgument_ival->getEntries());
+	{
+		PROFILE_SCOPE("LoadInitValues");
+		loadValues(mArgument_ival->getEntries());
+	}
 
 	if(!core->isInitialized()) {
-		if(!core->init()) {
+		bool initialized = false;
+		{
+			PROFILE_SCOPE("Core::init");
+			initialized = core->init();
+		}
+		if(!initialized) {
 			Core::log("Warning: Could not initialize Core. Terminating Application.");
+			endStartupProfile();
 			return false;
 		}
 	}
 
 	Core::log("Loading post init values.");
-	loadValues(mArgument_val->getEntries());
+	{
+		PROFILE_SCOPE("LoadValues");
+		loadValues(mArgument_val->getEntries());
+	}
+
+	endStartupProfile();
 
 	emit showGui();	
 
@@ -283,7 +316,61 @@ bool BaseApplication::startSystem() {
 }
 
 
+/**
+ * Enables the performance measurements of the Core and opens the Startup scope
+ * of the Profiler. All startup phases are recorded as sub-scopes.
+ */
+void BaseApplication::beginStartupProfile() {
+	BoolValue *enableMeasurements = Core::getInstance()->getValueManager()
+				->getBoolValue(NerdConstants::VALUE_NERD_ENABLE_PERFORMANCE_MEASUREMENTS);
+	if(enableMeasurements == 0) {
+		return;
+	}
+	mMeasurementsEnabledBeforeStartup = enableMeasurements->get();
+	enableMeasurements->set(true);
+	mProfilingStartup = true;
+	Core::getInstance()->getProfiler()->enter("Startup");
+}
+
+
+/**
+ * Closes the Startup scope and reports the measured startup durations. If the 
+ * measurements were not enabled before, they are disabled again and the startup
+ * measurements are discarded, so that they do not distort later measurements.
+ */
+void BaseApplication::endStartupProfile() {
+	if(!mProfilingStartup) {
+		return;
+	}
+	mProfilingStartup = false;
 
+	Profiler *profiler = Core::getInstance()->getProfiler();
+	profiler->leave();
+
+	QString report = profiler->createReport();
+	cout << "Startup profile:" << endl << report.toStdString().c_str() << endl;
+
+	QStringList parameters = mArgument_startupProfile->getEntryParameters(0);
+	if(!parameters.empty() && parameters.at(0).trimmed() != "") {
+		QFile file(parameters.at(0).trimmed());
+		if(file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+			QTextStream output(&file);
+			output << report;
+			file.close();
+		}
+		else {
+			Core::log("BaseApplication: Could not write startup profile to file [" 
+					+ file.fileName() + "]", true);
+		}
+	}
+
+	if(!mMeasurementsEnabledBeforeStartup) {
+		Core::getInstance()->getValueManager()
+				->getBoolValue(NerdConstants::VALUE_NERD_ENABLE_PERFORMANCE_MEASUREMENTS)->set(false);
+		profiler->clear();
+	}
 }
 
 
+
+}
@@ -80,6 +80,10 @@ namespace nerd {
 	 * parameters it is sometimes useful to process these parameters in your own
 	 * subclass to filter your own command line parameters now known by the
 	 * BaseApplication.
+	 *
+	 * With -startupProfile the durations of all startup phases (application setup, 
+	 * value files, init() and bind() of each SystemObject) are measured with the 
+	 * Profiler of the Core and reported when the startup is completed.
 	 */
 	class BaseApplication  : public QThread, public virtual SystemObject {
 	Q_OBJECT
@@ -112,6 +116,8 @@ namespace nerd {
 
 		virtual bool setUp();
 		virtual bool startSystem();
+		virtual void beginStartupProfile();
+		virtual void endStartupProfile();
 
 	protected:
 		QList<QString> mPreInitValueFileName;
@@ -122,6 +128,9 @@ namespace nerd {
 		QList<QString> mCommandLineArguments;
 		CommandLineArgument *mArgument_ival;
 		CommandLineArgument *mArgument_val;
+		CommandLineArgument *mArgument_startupProfile;
+		bool mProfilingStartup;
+		bool mMeasurementsEnabledBeforeStartup;
 	};
 
 }
@@ -0,0 +1,428 @@
+/***************************************************************************
+ *   NERD - Neurodynamics and Evolutionary Robotics Development Toolkit    *
+ *                                                                         *
+ *   University of Osnabrueck, Germany                                     *
+ *   Institute of Cognitive Science                                        *
+ *   Neurocybernetics Group                                                *
+ *   http://www.ikw.uni-osnabrueck.de/~neurokybernetik/                    *
+ *                                                                         *
+ *   Project homepage: nerd.x-bot.org                                      *
+ *                                                                         *
+ *   Copyright (C) 2008 - 2013 by the Neurocybernetics Group Osnabrück     *
+ *   Contact: Christian Rempis                                             *
+ *   christian.rempis@uni-osnabrueck.de                                    *
+ *   Contributors: see contributors.txt in the nerd main directory.        *
+ *                                                                         *
+ *                                                                         *
+ *   Acknowledgments:                                                      *
+ *   The NERD Toolkit is part of the EU project ALEAR                      *
+ *   (Artificial Language Evolution on Autonomous Robots) www.ALEAR.eu     *
+ *   This work was funded (2008 - 2011) by EU-Project Number ICT 214856    *
+ *                                                                         *
+ *                                                                         *
+ *   License Agreement:                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ *                                                                         *
+ *   Publications based on work using the NERD kit have to state this      *
+ *   clearly by citing the NERD homepage and the NERD overview paper.      *  
+ ***************************************************************************/
+
+
+#include "SharedMemoryRingBuffer.h"
+#include "Core/Core.h"
+#include <QElapsedTimer>
+#include <string.h>
+
+#ifdef linux
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#include <time.h>
+#endif
+
+namespace nerd {
+
+/**
+ * Memory layout of the header of the shared memory segment (see class documentation).
+ */
+struct RingBufferHeader {
+	unsigned int mMagic;
+	unsigned int mCapacity;
+	volatile unsigned int mHead;
+	volatile unsigned int mTail;
+	volatile int mWriteSignal;
+	volatile int mReadSignal;
+	volatile int mClosed;
+	int mReserved;
+};
+
+
+#ifdef linux
+/**
+ * Waits until the futex word at address does not contain expected any more,
+ * or until timeout (in ms, negative for infinite) has passed. Shared futexes
+ * are used, because the word is located in memory shared between processes.
+ */
+static void waitForSignal(volatile int *address, int expected, int timeout) {
+	if(timeout < 0) {
+		syscall(SYS_futex, address, FUTEX_WAIT, expected, 0, 0, 0);
+		return;
+	}
+	struct timespec time;
+	time.tv_sec = timeout / 1000;
+	time.tv_nsec = (timeout % 1000) * 1000000;
+	syscall(SYS_futex, address, FUTEX_WAIT, expected, &time, 0, 0);
+}
+
+static void sendSignal(volatile int *address) {
+	__sync_fetch_and_add(address, 1);
+	syscall(SYS_futex, address, FUTEX_WAKE, 1, 0, 0, 0);
+}
+#endif
+
+
+SharedMemoryRingBuffer::SharedMemoryRingBuffer()
+	: mOwner(false), mRole(PRODUCER), mMemory(0), mMappedSize(0), mCapacity(0)
+{
+}
+
+SharedMemoryRingBuffer::~SharedMemoryRingBuffer() {
+	detach();
+}
+
+
+/**
+ * Creates a new shared memory segment with the given name and a data area of
+ * capacity bytes. An existing segment with the same name is replaced.
+ * The creating object is the owner of the segment and removes it with detach().
+ *
+ * @param name the POSIX shared memory name (starting with a '/').
+ * @param capacity the size of the data area in bytes. The capacity is rounded up to 
+ *        a power of two, so that the byte counters can wrap around at 2^32.
+ * @param role whether this side writes (PRODUCER) or reads (CONSUMER) messages.
+ * @return true if successful, false if shared memory is not available.
+ */
+bool SharedMemoryRingBuffer::create(const QString &name, unsigned int capacity, Role role) {
+	detach();
+#ifdef linux
+	unsigned int roundedCapacity = 1024;
+	while(roundedCapacity < capacity && roundedCapacity < (1u << 30)) {
+		roundedCapacity <<= 1;
+	}
+	capacity = roundedCapacity;
+
+	QByteArray shmName = name.toLatin1();
+	shm_unlink(shmName.constData());
+
+	int fd = shm_open(shmName.constData(), O_CREAT | O_EXCL | O_RDWR, 0600);
+	if(fd < 0) {
+		Core::log(QString("SharedMemoryRingBuffer: Could not create shared memory [%1]: %2")
+				.arg(name).arg(strerror(errno)));
+		return false;
+	}
+	unsigned int size = HEADER_SIZE + capacity;
+	if(ftruncate(fd, size) != 0 || !map(fd, size)) {
+		::close(fd);
+		shm_unlink(shmName.constData());
+		return false;
+	}
+	::close(fd);
+
+	RingBufferHeader *header = reinterpret_cast<RingBufferHeader*>(mMemory);
+	memset(mMemory, 0, HEADER_SIZE);
+	header->mCapacity = capacity;
+	__sync_synchronize();
+	header->mMagic = MAGIC;
+
+	mName = name;
+	mOwner = true;
+	mRole = role;
+	mCapacity = capacity;
+	return true;
+#else
+	Q_UNUSED(name);
+	Q_UNUSED(capacity);
+	Q_UNUSED(role);
+	return false;
+#endif
+}
+
+
+/**
+ * Attaches to an existing shared memory segment created with create().
+ * The role has to be the opposite of the role of the creator.
+ */
+bool SharedMemoryRingBuffer::attach(const QString &name, Role role) {
+	detach();
+#ifdef linux
+	QByteArray shmName = name.toLatin1();
+	int fd = shm_open(shmName.constData(), O_RDWR, 0600);
+	if(fd < 0) {
+		return false;
+	}
+	struct stat status;
+	if(fstat(fd, &status) != 0 || status.st_size < HEADER_SIZE || !map(fd, status.st_size)) {
+		::close(fd);
+		return false;
+	}
+	::close(fd);
+
+	RingBufferHeader *header = reinterpret_cast<RingBufferHeader*>(mMemory);
+	if(header->mMagic != MAGIC || HEADER_SIZE + header->mCapacity > mMappedSize
+		|| header->mCapacity == 0 || (header->mCapacity & (header->mCapacity - 1)) != 0)
+	{
+		detach();
+		return false;
+	}
+	mName = name;
+	mOwner = false;
+	mRole = role;
+	mCapacity = header->mCapacity;
+	return true;
+#else
+	Q_UNUSED(name);
+	Q_UNUSED(role);
+	return false;
+#endif
+}
+
+
+/**
+ * Unmaps the segment. If this object created the segment, then it is also removed.
+ */
+void SharedMemoryRingBuffer::detach() {
+#ifdef linux
+	if(mMemory != 0) {
+		munmap(mMemory, mMappedSize);
+		if(mOwner) {
+			shm_unlink(mName.toLatin1().constData());
+		}
+	}
+#endif
+	mMemory = 0;
+	mMappedSize = 0;
+	mCapacity = 0;
+	mOwner = false;
+	mName = "";
+}
+
+
+bool SharedMemoryRingBuffer::isAttached() const {
+	return mMemory != 0;
+}
+
+
+QString SharedMemoryRingBuffer::getName() const {
+	return mName;
+}
+
+
+/**
+ * Appends a message to the buffer. If there is not enough free space, the method
+ * waits until the consumer has read enough data.
+ *
+ * @param message the message to write.
+ * @param timeout the maximal time to wait in ms (negative to wait without limit).
+ * @return true if the message was written, false on timeout or if the buffer is closed.
+ */
+bool SharedMemoryRingBuffer::write(const QByteArray &message, int timeout) {
+	if(mMemory == 0 || mRole != PRODUCER) {
+		return false;
+	}
+	RingBufferHeader *header = reinterpret_cast<RingBufferHeader*>(mMemory);
+	unsigned int size = message.size();
+	unsigned int required = sizeof(unsigned int) + size;
+	if(required > mCapacity) {
+		Core::log("SharedMemoryRingBuffer: Message exceeds the capacity of the buffer.");
+		return false;
+	}
+
+#ifdef linux
+	QElapsedTimer timer;
+	timer.start();
+	while(true) {
+		int signal = header->mReadSignal;
+		__sync_synchronize();
+		if(header->mClosed != 0) {
+			return false;
+		}
+		if(mCapacity - (header->mHead - header->mTail) >= required) {
+			break;
+		}
+		int remaining = timeout < 0 ? -1 : timeout - (int) timer.elapsed();
+		if(timeout >= 0 && remaining <= 0) {
+			return false;
+		}
+		waitForSignal(&header->mReadSignal, signal, remaining);
+	}
+
+	unsigned int head = header->mHead;
+	copyToBuffer(head, reinterpret_cast<const char*>(&size), sizeof(unsigned int));
+	copyToBuffer(head + sizeof(unsigned int), message.constData(), size);
+	__sync_synchronize();
+	header->mHead = head + required;
+	sendSignal(&header->mWriteSignal);
+	return true;
+#else
+	Q_UNUSED(timeout);
+	return false;
+#endif
+}
+
+
+/**
+ * Reads the next message from the buffer. If the buffer is empty, the method waits
+ * until a message is available.
+ *
+ * @param message the message that was read.
+ * @param timeout the maximal time to wait in ms (negative to wait without limit).
+ * @return true if a message was read, false on timeout or if the buffer is closed.
+ */
+bool SharedMemoryRingBuffer::read(QByteArray &message, int timeout) {
+	if(mMemory == 0 || mRole != CONSUMER) {
+		return false;
+	}
+	RingBufferHeader *header = reinterpret_cast<RingBufferHeader*>(mMemory);
+
+#ifdef linux
+	QElapsedTimer timer;
+	timer.start();
+	while(true) {
+		int signal = header->mWriteSignal;
+		__sync_synchronize();
+		if(header->mHead != header->mTail) {
+			break;
+		}
+		if(header->mClosed != 0) {
+			return false;
+		}
+		int remaining = timeout < 0 ? -1 : timeout - (int) timer.elapsed();
+		if(timeout >= 0 && remaining <= 0) {
+			return false;
+		}
+		waitForSignal(&header->mWriteSignal, signal, remaining);
+	}
+	__sync_synchronize();
+
+	unsigned int tail = header->mTail;
+	unsigned int size = 0;
+	copyFromBuffer(tail, reinterpret_cast<char*>(&size), sizeof(unsigned int));
+	if(size > mCapacity - sizeof(unsigned int)) {
+		Core::log("SharedMemoryRingBuffer: Corrupt message in shared memory [" + mName + "]");
+		close();
+		return false;
+	}
+	message.resize(size);
+	copyFromBuffer(tail + sizeof(unsigned int), message.data(), size);
+	__sync_synchronize();
+	header->mTail = tail + sizeof(unsigned int) + size;
+	sendSignal(&header->mReadSignal);
+	return true;
+#else
+	Q_UNUSED(message);
+	Q_UNUSED(timeout);
+	return false;
+#endif
+}
+
+
+bool SharedMemoryRingBuffer::hasPendingMessages() const {
+	if(mMemory == 0) {
+		return false;
+	}
+	RingBufferHeader *header = reinterpret_cast<RingBufferHeader*>(mMemory);
+	return header->mHead != header->mTail;
+}
+
+
+/**
+ * Marks the buffer as closed and wakes up a waiting peer. Only the signal word
+ * owned by this side is changed: a waiting consumer waits for the writeSignal of
+ * the producer, a waiting producer for the readSignal of the consumer.
+ */
+void SharedMemoryRingBuffer::close() {
+	if(mMemory == 0) {
+		return;
+	}
+	RingBufferHeader *header = reinterpret_cast<RingBufferHeader*>(mMemory);
+	header->mClosed = 1;
+	__sync_synchronize();
+#ifdef linux
+	if(mRole == PRODUCER) {
+		sendSignal(&header->mWriteSignal);
+	}
+	else {
+		sendSignal(&header->mReadSignal);
+	}
+#endif
+}
+
+
+bool SharedMemoryRingBuffer::isClosed() const {
+	if(mMemory == 0) {
+		return true;
+	}
+	return reinterpret_cast<RingBufferHeader*>(mMemory)->mClosed != 0;
+}
+
+
+bool SharedMemoryRingBuffer::map(int fileDescriptor, unsigned int size) {
+#ifdef linux
+	void *memory = mmap(0, size, PROT_READ | PROT_WRITE, MAP_SHARED, fileDescriptor, 0);
+	if(memory == MAP_FAILED) {
+		Core::log(QString("SharedMemoryRingBuffer: Could not map shared memory: %1")
+				.arg(strerror(errno)));
+		return false;
+	}
+	mMemory = reinterpret_cast<char*>(memory);
+	mMappedSize = size;
+	return true;
+#else
+	Q_UNUSED(fileDescriptor);
+	Q_UNUSED(size);
+	return false;
+#endif
+}
+
+
+void SharedMemoryRingBuffer::copyToBuffer(unsigned int position, const char *data, unsigned int size) {
+	char *buffer = mMemory + HEADER_SIZE;
+	unsigned int offset = position % mCapacity;
+	unsigned int firstPart = qMin(size, mCapacity - offset);
+	memcpy(buffer + offset, data, firstPart);
+	if(firstPart < size) {
+		memcpy(buffer, data + firstPart, size - firstPart);
+	}
+}
+
+
+void SharedMemoryRingBuffer::copyFromBuffer(unsigned int position, char *data, unsigned int size) const {
+	const char *buffer = mMemory + HEADER_SIZE;
+	unsigned int offset = position % mCapacity;
+	unsigned int firstPart = qMin(size, mCapacity - offset);
+	memcpy(data, buffer + offset, firstPart);
+	if(firstPart < size) {
+		memcpy(data + firstPart, buffer, size - firstPart);
+	}
+}
+
+}
+
@@ -0,0 +1,121 @@
+/***************************************************************************
+ *   NERD - Neurodynamics and Evolutionary Robotics Development Toolkit    *
+ *                                                                         *
+ *   University of Osnabrueck, Germany                                     *
+ *   Institute of Cognitive Science                                        *
+ *   Neurocybernetics Group                                                *
+ *   http://www.ikw.uni-osnabrueck.de/~neurokybernetik/                    *
+ *                                                                         *
+ *   Project homepage: nerd.x-bot.org                                      *
+ *                                                                         *
+ *   Copyright (C) 2008 - 2013 by the Neurocybernetics Group Osnabrück     *
+ *   Contact: Christian Rempis                                             *
+ *   christian.rempis@uni-osnabrueck.de                                    *
+ *   Contributors: see contributors.txt in the nerd main directory.        *
+ *                                                                         *
+ *                                                                         *
+ *   Acknowledgments:                                                      *
+ *   The NERD Toolkit is part of the EU project ALEAR                      *
+ *   (Artificial Language Evolution on Autonomous Robots) www.ALEAR.eu     *
+ *   This work was funded (2008 - 2011) by EU-Project Number ICT 214856    *
+ *                                                                         *
+ *                                                                         *
+ *   License Agreement:                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ *                                                                         *
+ *   Publications based on work using the NERD kit have to state this      *
+ *   clearly by citing the NERD homepage and the NERD overview paper.      *  
+ ***************************************************************************/
+
+
+#ifndef NERDSharedMemoryRingBuffer_H
+#define NERDSharedMemoryRingBuffer_H
+
+#include <QString>
+#include <QByteArray>
+
+namespace nerd {
+
+	/**
+	 * SharedMemoryRingBuffer.
+	 * A lock-free single-producer / single-consumer message queue in POSIX shared memory.
+	 * It is used as fast transport between processes on the same host (e.g. NERD and YARS),
+	 * where UDP sockets and their system calls dominate the communication time.
+	 *
+	 * The shared memory segment has a fixed binary layout, so that the other side 
+	 * can be implemented independently of NERD:
+	 *
+	 * Header (32 bytes, native byte order):
+	 *   magic (uint32, MAGIC) | capacity (uint32) | head (uint32) | tail (uint32) 
+	 *   | writeSignal (int32) | readSignal (int32) | closed (int32) | reserved (int32)
+	 * Data: capacity bytes (capacity is a power of two).
+	 *
+	 * head and tail are monotonic byte counters (modulo 2^32) of the written and read
+	 * bytes. Each message is stored as length (uint32) followed by the message bytes, 
+	 * wrapping around at the end of the data area. The producer only modifies head 
+	 * and writeSignal, the consumer only modifies tail and readSignal. Both signal words
+	 * are incremented after each message and are used as futex words to wait for new
+	 * data or free space without polling. closed may be set by both sides. Afterwards
+	 * the closing side increments its own signal word, which is the word the peer 
+	 * waits for. 
+	 *
+	 * The role of a side (PRODUCER or CONSUMER) is fixed with create() or attach().
+	 *
+	 * Shared memory is only available on Linux. On other systems create() and attach()
+	 * fail, so callers can fall back to another transport.
+	 */
+	class SharedMemoryRingBuffer {
+	public:
+		static const unsigned int MAGIC = 0x4e524231;
+		static const int HEADER_SIZE = 32;
+
+		enum Role {PRODUCER, CONSUMER};
+
+	public:
+		SharedMemoryRingBuffer();
+		virtual ~SharedMemoryRingBuffer();
+
+		bool create(const QString &name, unsigned int capacity, Role role);
+		bool attach(const QString &name, Role role);
+		void detach();
+		bool isAttached() const;
+		QString getName() const;
+
+		bool write(const QByteArray &message, int timeout);
+		bool read(QByteArray &message, int timeout);
+		bool hasPendingMessages() const;
+		void close();
+		bool isClosed() const;
+
+	private:
+		bool map(int fileDescriptor, unsigned int size);
+		void copyToBuffer(unsigned int position, const char *data, unsigned int size);
+		void copyFromBuffer(unsigned int position, char *data, unsigned int size) const;
+
+	private:
+		QString mName;
+		bool mOwner;
+		Role mRole;
+		char *mMemory;
+		unsigned int mMappedSize;
+		unsigned int mCapacity;
+	};
+
+}
+
+#endif
+
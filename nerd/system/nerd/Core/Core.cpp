@@ -64,7 +64,11 @@
 #include "PlugIns/PlugIn.h"
 #include <QStringList>
 #include <QListIterator>
+#include <QHash>
 #include "Util/Tracer.h"
+#include "Util/Profiler.h"
+#include "Core/LogWriter.h"
+#include <typeinfo>
 #include "Version.h"
 
 #define TRACE(message)
@@ -100,12 +104,15 @@ void terminationSignalCatcher(int sig){
  * and other useful core utilities.
  */
 Core::Core()
-	: mTaskLocker(QMutex::Recursive), mMainExecutionThread(0),
+	: mMainExecutionThread(0),
 		mInitializedSuccessful(false),
-		mValueManager(0), mEventManager(0), mPlugInManager(0), mSimulationDelay(0),
+		mValueManager(0), mEventManager(0), mPlugInManager(0), mScheduledTasks(0), 
+		mSimulationDelay(0),
 		mInitializationDuration(0), mBindingDuration(0),
-		mCurrentLogMessage(0), mLogFile(0), mLogFileStream(0),
-		mRunInPerformanceMode(0), mEnablePerformanceMeasures(0), mInitEvent(0), 
+		mCurrentLogMessage(0), mLogFile(0), mLogFileStream(0), mLogWriter(0),
+		mMinimumLogSeverity(0),
+		mRunInPerformanceMode(0), mEnablePerformanceMeasures(0), mProfilerTraceFile(0),
+		mProfiler(0), mInitEvent(0), 
 		mInitCompletedEvent(0), mBindEvent(0),
 		mShutDownEvent(0), mTasksExecutedEvent(0), mShutDownCompleted(false),
 		mIsShuttingDown(false)
@@ -133,6 +140,7 @@ Core::Core()
 	}
 
 	mEnablePerformanceMeasures = new BoolValue(false);
+	mProfiler = new Profiler(mEnablePerformanceMeasures);
 
 	if(!mIsUsingReducedFileWriting) {
 		//setup log file.
@@ -151,6 +159,8 @@ Core::Core()
 			mLogFile = 0;
 		}
 	}
+	mLogWriter = new LogWriter(mLogFileStream);
+	mLogWriter->start();
 
 	logMessage("NERD Debug Log [Version: " + getVersionString() + "]");
 	logMessage(QString("~System started."));
@@ -211,6 +221,14 @@ Core::~Core() {
 	mSystemObjects.clear();
 	mGlobalObjects.clear();
 
+	//the recent message value is destroyed together with the ValueManager.
+	mLogWriter->setRecentMessageValue(0);
+	mMinimumLogSeverity = 0;
+
+	//the profiler refers to a value of the ValueManager.
+	delete mProfiler;
+	mProfiler = 0;
+
 	delete mValueManager;
 	delete mEventManager;
 	delete mPlugInManager;
@@ -218,6 +236,10 @@ Core::~Core() {
 	//Note: mCurrentLogMessage was destroyed together with the ValueManager.
 	mCurrentLogMessage = 0;
 
+	//write all pending messages before the log file is closed.
+	delete mLogWriter;
+	mLogWriter = 0;
+
 	if(mLogFile != 0) {
 		mLogFile->close();
 	}
@@ -281,6 +303,21 @@ void Core::log(const QString &message, bool copyToCout) {
 }
 
 
+/**
+ * Logs a message with the given severity.
+ *
+ * @param message the message to log.
+ * @param severity the severity of the message.
+ * @param copyToCout if true, the message is also written to cout.
+ */
+void Core::log(const QString &message, LogSeverity severity, bool copyToCout) {
+	Core::getInstance()->logMessage(message, severity);
+	if(copyToCout) {
+		cout << message.toStdString().c_str() << endl;
+	}
+}
+
+
 /**
  * Creates all required objects for the Core.
  * 
@@ -299,6 +336,10 @@ void Core::setUpCore() {
 
 	mValueManager->addValue(NerdConstants::VALUE_NERD_ENABLE_PERFORMANCE_MEASUREMENTS, 
 							mEnablePerformanceMeasures);
+	mProfilerTraceFile = new StringValue("");
+	mProfilerTraceFile->setDescription("If set, the profiler data is written to this file "
+							"(Chrome trace JSON) and to [file].folded (flame graph stacks) at shutdown.");
+	mValueManager->addValue(NerdConstants::VALUE_NERD_PROFILER_TRACE_FILE, mProfilerTraceFile);
 
 	//try to load default properties.
 	if(!mIsUsingReducedFileWriting) {
@@ -330,6 +371,12 @@ void Core::setUpCore() {
 	mCurrentLogMessage = new StringValue("");
 	mCurrentLogMessage->setNotifyAllSetAttempts(true);
 	mValueManager->addValue(NerdConstants::VALUE_NERD_RECENT_LOGGER_MESSAGE, mCurrentLogMessage);
+	mLogWriter->setRecentMessageValue(mCurrentLogMessage);
+
+	mMinimumLogSeverity = new IntValue(LOG_INFO);
+	mMinimumLogSeverity->setDescription("Messages with a lower severity are not logged "
+							"(0: Debug, 1: Info, 2: Warning, 3: Error).");
+	mValueManager->addValue(NerdConstants::VALUE_NERD_MINIMUM_LOG_SEVERITY, mMinimumLogSeverity);
 
 	mInitializationDuration = new IntValue(0);
 	mBindingDuration = new IntValue(0);
@@ -465,6 +512,7 @@ bool Core::bindSystemObjects() {
 	//Bind objects
 	for(int i = 0; i < mSystemObjects.size(); i++) {
 		SystemObject *obj = mSystemObjects.at(i);
+		ProfilerScope scope("Bind ", obj->getName());
 		if(!obj->bind()) {
 			logMessage(QString("Core: Could not bind SystemObject [")
 					 .append(obj->getName()).append("]"));
@@ -570,6 +618,7 @@ bool Core::init() {
 
 	for(int i = 0; i< mSystemObjects.size(); i++) {
 		SystemObject *obj = mSystemObjects.at(i);
+		ProfilerScope scope("Init ", obj->getName());
 		if(!obj->init()) {
 			ok = false;
 			logMessage(QString("Core: Could not initialize SystemObject [")
@@ -852,6 +901,12 @@ bool Core::shutDown() {
 
 	mInitializedSuccessful = false;
 
+	if(mProfilerTraceFile != 0 && mProfilerTraceFile->get().trimmed() != "") {
+		QString traceFile = mProfilerTraceFile->get().trimmed();
+		mProfiler->writeChromeTrace(traceFile);
+		mProfiler->writeFoldedStacks(traceFile + ".folded");
+	}
+
 	//try to save properties
 	if(!mIsUsingReducedFileWriting) {
 		mProperties.saveToFile(getConfigDirectoryPath().append("/properties/main.props"));
@@ -898,30 +953,51 @@ bool Core::isShuttingDown() const {
  * can not be scheduled more than once, because it will be destroyed after its first
  * execution.
  *
+ * This method is lock-free and can be called by any number of threads concurrently.
+ * The Task is pushed to an intrusive stack, which is taken as a whole by the main 
+ * execution thread in executePendingTasks().
+ *
  * @param task the Task to schedule for execution in the main execution thread.
  * @return true if successful, false if the Task was already registered.
  */
 bool Core::scheduleTask(Task *task) {
-	QMutexLocker locker(&mTaskLocker);
-	if(task == 0 || mScheduledTasks.contains(task)) {
+	if(task == 0 || !task->mScheduled.testAndSetOrdered(0, 1)) {
 		return false;
 	}
-	mScheduledTasks.append(task);
+	Task *head = 0;
+	do {
+		head = mScheduledTasks;
+		task->mNextScheduledTask = head;
+	} while(!mScheduledTasks.testAndSetRelease(head, task));
+
 	return true;
 }
 
 
+/**
+ * Returns true if there are Tasks waiting for execution. This is a single atomic 
+ * read and can be used by execution loops to avoid unnecessary work.
+ */
+bool Core::hasPendingTasks() const {
+	Task *head = mScheduledTasks;
+	return head != 0;
+}
+
+
 /**
  * Returns a list with all currently pending Tasks, that have been registered with
- * method schedule Task. 
- * Note that the real internal list of Task is returned, which means that it might change
- * at any time while you are using it (if another thread schedules a Task). To ensure 
- * a fixed list, create a copy of the referenced Task list. 
+ * method schedule Task, in the order of their scheduling. 
+ * The returned list is a snapshot. As pending Tasks are destroyed when they are 
+ * executed, this method should only be called by the main execution thread.
  *
  * @return the list with all currently pending Tasks. 
  */
 QList<Task*> Core::getPendingTasks() const {
-	return mScheduledTasks;
+	QList<Task*> tasks;
+	for(Task *task = mScheduledTasks; task != 0; task = task->mNextScheduledTask) {
+		tasks.prepend(task);
+	}
+	return tasks;
 }
 
 
@@ -932,20 +1008,46 @@ QList<Task*> Core::getPendingTasks() const {
  * TODO: Maybe method should be protected or private.
  */
 void Core::clearPendingTasks() {
-	QMutexLocker locker(&mTaskLocker);
-	while(!mScheduledTasks.empty()) {
-		Task *task = mScheduledTasks.first();
-		mScheduledTasks.removeAll(task);
+	Task *task = takeScheduledTasks();
+	while(task != 0) {
+		Task *next = task->mNextScheduledTask;
 		delete task;
+		task = next;
 	}
 }
 
 
+/**
+ * Removes all pending Tasks from the queue in a single atomic operation.
+ * The Tasks are returned as linked list (see Task::mNextScheduledTask) in the 
+ * order of their scheduling.
+ */
+Task* Core::takeScheduledTasks() {
+	Task *task = mScheduledTasks.fetchAndStoreAcquire(0);
+
+	//the queue is a stack, so reverse the list to restore the scheduling order.
+	Task *ordered = 0;
+	while(task != 0) {
+		Task *next = task->mNextScheduledTask;
+		task->mNextScheduledTask = ordered;
+		ordered = task;
+		task = next;
+	}
+	return ordered;
+}
+
+
 /**
  * Executes all scheduled Tasks that are pending. 
  * While this method is executing new Tasks are scheduled, but 
  * not executed in the same execution loop. They are scheduled for the next 
  * call of executePendingTasks.
+ *
+ * Pending Tasks with the same coalescing key (see Task::getCoalescingKey()) that are 
+ * not separated by a Task without key form a group. Of each group only 
+ * the last Task is executed, but at the position of the first Task of the group, 
+ * so that it still runs before any keyless Task that was scheduled after the group 
+ * started.
  * 
  * Only the current main execution thread is allowed to call this method, if 
  * a thread registered to execute the main execution thread. Otherwise any
@@ -954,25 +1056,74 @@ void Core::clearPendingTasks() {
  */
 void Core::executePendingTasks() {
 
+	if(!hasPendingTasks()) {
+		return;
+	}
+
 	if(!isMainExecutionThread()) {
 		log("Core Warning: Method executePendingTasks was called from a thread "
 			" other than the main execution thread. Execution was denied!");
 		return;
 	}
 
-	mTaskLocker.lock();
-	if(mScheduledTasks.empty()) {
-		mTaskLocker.unlock();
-		return;
+	Task *task = takeScheduledTasks();
+
+	//tasks with the same coalescing key are grouped as long as they are not separated 
+	//by a task without key. The last task of each group is executed at the position 
+	//of the first one, so the tasks without key see the same values as without coalescing.
+	//lastTasks maps each task with a key to the task to execute at its position (or 0).
+	QHash<Task*, Task*> lastTasks;
+	QHash<const void*, Task*> firstTasks;
+	for(Task *current = task; current != 0; current = current->mNextScheduledTask) {
+		const void *key = current->getCoalescingKey();
+		if(key == 0) {
+			firstTasks.clear();
+			continue;
+		}
+		QHash<const void*, Task*>::iterator first = firstTasks.find(key);
+		if(first == firstTasks.end()) {
+			firstTasks.insert(key, current);
+			lastTasks.insert(current, current);
+		}
+		else {
+			lastTasks.insert(first.value(), current);
+			lastTasks.insert(current, 0);
+		}
+	}
+
+	bool profile = mProfiler != 0 && mProfiler->isEnabled();
+	if(profile) {
+		mProfiler->enter("Core::executePendingTasks");
 	}
-	QList<Task*> tasks(mScheduledTasks);
-	mScheduledTasks.clear();
-	mTaskLocker.unlock();
 
-	for(QListIterator<Task*> i(tasks); i.hasNext();) {
-		Task *task = i.next();
-		task->runTask();
+	while(task != 0) {
+		Task *next = task->mNextScheduledTask;
+
+		//the task to execute at this position (0 if superseded or already executed).
+		Task *executedTask = task;
+		if(!lastTasks.empty()) {
+			QHash<Task*, Task*>::const_iterator last = lastTasks.constFind(task);
+			if(last != lastTasks.constEnd()) {
+				executedTask = last.value();
+			}
+		}
+		if(executedTask != 0) {
+			if(profile) {
+				//attribute the execution time to the type of the task.
+				mProfiler->enter(typeid(*executedTask));
+				executedTask->runTask();
+				mProfiler->leave();
+			}
+			else {
+				executedTask->runTask();
+			}
+		}
 		delete task;
+		task = next;
+	}
+
+	if(profile) {
+		mProfiler->leave();
 	}
 	
 	//TODO remove
@@ -984,28 +1135,23 @@ void Core::executePendingTasks() {
  * Logs a string to the Core logger. This logger automatically writes the logger message
  * to a file, adding the current time. Additionally the message is written to a
  * StringValue available in the ValueManager with name "/Logger/RecentMessage"
- * that can be observed to capture all occuring logger messages. 
+ * that can be observed to capture the occuring logger messages. 
+ *
+ * The file is written asynchronously by a LogWriter thread, so this method does not
+ * block. To keep observers of the recent message cheap, the value is updated at most 
+ * a few times per second after a burst of messages (see LogWriter).
  *
  * Messages starting with a "~" are especially highlighted to simplify reading of log files.
  * 
  * @param message the message to log.
+ * @param severity the severity of the message. 
  */
-void Core::logMessage(const QString &message) {
-	if(mCurrentLogMessage != 0) {
-		mCurrentLogMessage->set(message);
-	}
-	if(mLogFileStream != 0) {
-		bool highlight = message.startsWith("~");
-		if(highlight) {
-			(*mLogFileStream) << endl
-				<< QTime::currentTime().toString("hh:mm:ss") << " : "
-				<< message.mid(1) << endl << endl;
-		}
-		else {
-			(*mLogFileStream) << QTime::currentTime().toString("hh:mm:ss") << " : "
-				<< message << endl;
-		}
-		mLogFileStream->flush();
+void Core::logMessage(const QString &message, LogSeverity severity) {
+	if(mMinimumLogSeverity != 0 && severity < mMinimumLogSeverity->get()) {
+		return;
+	}
+	if(mLogWriter != 0) {
+		mLogWriter->addMessage(message, severity);
 	}
 }
 
@@ -1090,6 +1236,15 @@ bool Core::isPerformanceMeasuringEnabled() const {
 }
 
 
+/**
+ * Returns the hierarchical profiler. It records only if performance measurements
+ * are enabled (see isPerformanceMeasuringEnabled()).
+ */
+Profiler* Core::getProfiler() const {
+	return mProfiler;
+}
+
+
 /**
  * Returns the Core Properties list. 
  * This list can be used by any object in the system to store or read
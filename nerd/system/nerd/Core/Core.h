@@ -57,6 +57,7 @@
 #include <QFile>
 #include <QTextStream>
 #include <QThread>
+#include <QAtomicPointer>
 #include "Core/Properties.h"
 #include "Core/Task.h"
 #include <signal.h>
@@ -75,6 +76,8 @@ class IntValue;
 class BoolValue;
 class StringValue;
 class SystemObject;
+class Profiler;
+class LogWriter;
 
 /**
  * Core.
@@ -125,9 +128,15 @@ class SystemObject;
  * Therefore the Property list can be used to store configurations
  * between application runs, which is useful e.g. to store the positons of
  * GUI windows, the current working directory of the file choosers, and much more.
+ *
+ * Log messages are written asynchronously by a LogWriter thread. Messages with a 
+ * severity below the value /Logger/MinimumSeverity are ignored.
  */
 class Core {
 
+	public:
+		enum LogSeverity {LOG_DEBUG = 0, LOG_INFO = 1, LOG_WARNING = 2, LOG_ERROR = 3};
+
 	public:
 		~Core();
 
@@ -135,6 +144,7 @@ class Core {
 		static void resetCore();
 
 		static void log(const QString &message, bool copyToCout = false);
+		static void log(const QString &message, LogSeverity severity, bool copyToCout = false);
 
 		EventManager* getEventManager() const;
 		ValueManager* getValueManager() const;
@@ -158,11 +168,12 @@ class Core {
 		QList<QString> getGlobalObjectNames() const;
 
 		bool scheduleTask(Task *task);
+		bool hasPendingTasks() const;
 		QList<Task*> getPendingTasks() const;
 		void clearPendingTasks();
 		void executePendingTasks();
 
-		void logMessage(const QString &message);
+		void logMessage(const QString &message, LogSeverity severity = LOG_INFO);
 
 		Event* getInitEvent() const;
 		Event* getInitCompletedEvent() const;
@@ -170,6 +181,7 @@ class Core {
 		Event* getShutDownEvent() const;
 
 		bool isPerformanceMeasuringEnabled() const;
+		Profiler* getProfiler() const;
 
 		Properties& getProperties();
 		QString getConfigDirectoryPath() const;
@@ -192,6 +204,7 @@ class Core {
 
 	private:
 		void setUpCore();
+		Task* takeScheduledTasks();
 
 	private:
 		static bool mCoreCreated;
@@ -200,7 +213,6 @@ class Core {
 		static int sCurrentInstanceId;
 		static bool sVerbose;
 
-		QMutex mTaskLocker;
 		QThread *mMainExecutionThread;
 
 		bool mInitializedSuccessful;
@@ -211,7 +223,7 @@ class Core {
 
 		QList<SystemObject*> mSystemObjects;
 		QMap<QString, SystemObject*> mGlobalObjects;
-		QList<Task*> mScheduledTasks;
+		QAtomicPointer<Task> mScheduledTasks;
 
 		IntValue *mSimulationDelay;
 		IntValue *mInitializationDuration;
@@ -220,9 +232,13 @@ class Core {
 		StringValue *mCurrentLogMessage;
 		QFile *mLogFile;
 		QTextStream *mLogFileStream;
+		LogWriter *mLogWriter;
+		IntValue *mMinimumLogSeverity;
 
 		BoolValue *mRunInPerformanceMode;
 		BoolValue *mEnablePerformanceMeasures;
+		StringValue *mProfilerTraceFile;
+		Profiler *mProfiler;
 
 		Event *mInitEvent;
 		Event *mInitCompletedEvent;
@@ -0,0 +1,294 @@
+/***************************************************************************
+ *   NERD - Neurodynamics and Evolutionary Robotics Development Toolkit    *
+ *                                                                         *
+ *   University of Osnabrueck, Germany                                     *
+ *   Institute of Cognitive Science                                        *
+ *   Neurocybernetics Group                                                *
+ *   http://www.ikw.uni-osnabrueck.de/~neurokybernetik/                    *
+ *                                                                         *
+ *   Project homepage: nerd.x-bot.org                                      *
+ *                                                                         *
+ *   Copyright (C) 2008 - 2013 by the Neurocybernetics Group Osnabrück     *
+ *   Contact: Christian Rempis                                             *
+ *   christian.rempis@uni-osnabrueck.de                                    *
+ *   Contributors: see contributors.txt in the nerd main directory.        *
+ *                                                                         *
+ *                                                                         *
+ *   Acknowledgments:                                                      *
+ *   The NERD Toolkit is part of the EU project ALEAR                      *
+ *   (Artificial Language Evolution on Autonomous Robots) www.ALEAR.eu     *
+ *   This work was funded (2008 - 2011) by EU-Project Number ICT 214856    *
+ *                                                                         *
+ *                                                                         *
+ *   License Agreement:                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ *                                                                         *
+ *   Publications based on work using the NERD kit have to state this      *
+ *   clearly by citing the NERD homepage and the NERD overview paper.      *  
+ ***************************************************************************/
+
+
+
+#include "LogWriter.h"
+#include "Core/Core.h"
+#include "Value/StringValue.h"
+#include <QMutexLocker>
+#include <QElapsedTimer>
+#include "Math/Math.h"
+
+namespace nerd {
+
+const int LogWriter::FLUSH_INTERVAL = 250;
+const int LogWriter::RECENT_MESSAGE_BURST = 32;
+
+
+/**
+ * Constructs a new LogWriter. The thread has to be started with start().
+ *
+ * @param stream the stream to write the log to. If 0, messages are only 
+ *        published to the recent message value.
+ */
+LogWriter::LogWriter(QTextStream *stream)
+	: mStream(stream), mRunning(1), mWriterWaiting(0), mRecentMessageTokens(RECENT_MESSAGE_BURST),
+	  mRecentMessageMutex(QMutex::Recursive), mRecentMessageValue(0), 
+	  mHasPendingRecentMessage(false), mLastSeverity(0), mNumberOfRepetitions(0)
+{
+	//the queue always contains a (consumed) stub entry.
+	mTail = new LogEntry();
+	mHead = mTail;
+}
+
+
+/**
+ * Stops the thread (if required), writes all pending messages and destroys the queue.
+ * The stream itself is not closed.
+ */
+LogWriter::~LogWriter() {
+	stop();
+	delete mTail;
+}
+
+
+/**
+ * Adds a message to the log. This method can be called from any thread and does not 
+ * block (except for the rate limited update of the recent message value).
+ *
+ * @param message the message.
+ * @param severity the severity of the message (see Core::LogSeverity).
+ */
+void LogWriter::addMessage(const QString &message, int severity) {
+	LogEntry *entry = new LogEntry();
+	entry->mMessage = message;
+	entry->mTime = QTime::currentTime();
+	entry->mSeverity = severity;
+
+	if(mRecentMessageTokens.fetchAndAddOrdered(-1) > 0) {
+		entry->mPublished = true;
+		publishRecentMessage(message);
+	}
+	else {
+		mRecentMessageTokens.ref();
+	}
+
+	//the entry is visible for the writer thread as soon as it is linked to its predecessor.
+	LogEntry *previous = mHead.fetchAndStoreOrdered(entry);
+	previous->mNext.fetchAndStoreOrdered(entry);
+
+	//the lock is only taken if the writer thread sleeps (see run()).
+	if(mWriterWaiting.fetchAndAddOrdered(0) != 0) {
+		QMutexLocker locker(&mWaitMutex);
+		mEntriesAvailable.wakeOne();
+	}
+}
+
+
+/**
+ * Sets the value that is updated with the most recent messages. 
+ * Must be set to 0 before the value is destroyed.
+ */
+void LogWriter::setRecentMessageValue(StringValue *value) {
+	QMutexLocker locker(&mRecentMessageMutex);
+	mRecentMessageValue = value;
+}
+
+
+/**
+ * Terminates the writer thread and writes all remaining messages.
+ * Messages added after stop() are written when the LogWriter is destroyed.
+ */
+void LogWriter::stop() {
+	{
+		QMutexLocker locker(&mWaitMutex);
+		mRunning = 0;
+		mEntriesAvailable.wakeAll();
+	}
+	if(isRunning()) {
+		wait();
+	}
+	writeEntries();
+	writeRepetitions();
+	publishPendingMessage();
+	if(mStream != 0) {
+		mStream->flush();
+	}
+}
+
+
+void LogWriter::run() {
+	QElapsedTimer flushTimer;
+	flushTimer.start();
+
+	while(mRunning != 0) {
+		bool wroteEntries = writeEntries();
+
+		if(flushTimer.elapsed() >= FLUSH_INTERVAL) {
+			writeRepetitions();
+			if(mStream != 0) {
+				mStream->flush();
+			}
+			publishPendingMessage();
+			if(mRecentMessageTokens < RECENT_MESSAGE_BURST) {
+				mRecentMessageTokens.ref();
+			}
+			flushTimer.restart();
+		}
+		if(!wroteEntries) {
+			//sleep until addMessage() links a new entry or the next flush is due.
+			//mWriterWaiting is set before the queue is checked again, so that an entry
+			//linked in between either is seen here or wakes the thread.
+			int timeout = Math::max(1, FLUSH_INTERVAL - (int) flushTimer.elapsed());
+			QMutexLocker locker(&mWaitMutex);
+			mWriterWaiting.fetchAndStoreOrdered(1);
+			if(mRunning != 0 && mTail->mNext.fetchAndAddOrdered(0) == 0) {
+				mEntriesAvailable.wait(&mWaitMutex, timeout);
+			}
+			mWriterWaiting.fetchAndStoreOrdered(0);
+		}
+	}
+}
+
+
+/**
+ * Writes all entries that are currently in the queue. Must only be called by 
+ * a single thread at a time (the writer thread, or any thread after stop()).
+ *
+ * @return true if at least one entry was written.
+ */
+bool LogWriter::writeEntries() {
+	bool wroteEntries = false;
+	while(true) {
+		LogEntry *next = mTail->mNext.fetchAndAddAcquire(0);
+		if(next == 0) {
+			//empty, or the next entry is not linked yet.
+			break;
+		}
+		delete mTail;
+		mTail = next;
+		wroteEntries = true;
+
+		if(next->mPublished) {
+			mHasPendingRecentMessage = false;
+		}
+		else {
+			mPendingRecentMessage = next->mMessage;
+			mHasPendingRecentMessage = true;
+		}
+
+		if(next->mSeverity == mLastSeverity && next->mMessage == mLastMessage) {
+			mNumberOfRepetitions++;
+			mLastRepetitionTime = next->mTime;
+			continue;
+		}
+		writeRepetitions();
+		writeMessage(next->mTime, next->mMessage, next->mSeverity);
+		mLastMessage = next->mMessage;
+		mLastSeverity = next->mSeverity;
+
+		if(next->mSeverity >= Core::LOG_ERROR && mStream != 0) {
+			mStream->flush();
+		}
+		//the tail remains in the queue as stub, so its content is not needed any more.
+		next->mMessage = QString();
+	}
+	return wroteEntries;
+}
+
+
+/**
+ * Writes a message with its time stamp. Messages starting with a "~" are highlighted.
+ */
+void LogWriter::writeMessage(const QTime &time, const QString &message, int severity) {
+	if(mStream == 0) {
+		return;
+	}
+	QString prefix;
+	switch(severity) {
+		case Core::LOG_DEBUG:
+			prefix = "[Debug] ";
+			break;
+		case Core::LOG_WARNING:
+			prefix = "[Warning] ";
+			break;
+		case Core::LOG_ERROR:
+			prefix = "[Error] ";
+			break;
+		default:
+			break;
+	}
+	if(message.startsWith("~")) {
+		(*mStream) << "\n" << time.toString("hh:mm:ss") << " : " 
+				   << prefix << message.mid(1) << "\n\n";
+	}
+	else {
+		(*mStream) << time.toString("hh:mm:ss") << " : " << prefix << message << "\n";
+	}
+}
+
+
+void LogWriter::writeRepetitions() {
+	if(mNumberOfRepetitions == 0) {
+		return;
+	}
+	if(mStream != 0) {
+		(*mStream) << mLastRepetitionTime.toString("hh:mm:ss") << " : Last message repeated " 
+				   << mNumberOfRepetitions << " times\n";
+	}
+	mNumberOfRepetitions = 0;
+}
+
+
+void LogWriter::publishRecentMessage(const QString &message) {
+	QMutexLocker locker(&mRecentMessageMutex);
+	if(mRecentMessageValue != 0) {
+		mRecentMessageValue->set(message);
+	}
+}
+
+
+/**
+ * Publishes the most recent message that was suppressed by the rate limit.
+ */
+void LogWriter::publishPendingMessage() {
+	if(!mHasPendingRecentMessage) {
+		return;
+	}
+	mHasPendingRecentMessage = false;
+	publishRecentMessage(mPendingRecentMessage);
+}
+
+}
+
@@ -0,0 +1,141 @@
+/***************************************************************************
+ *   NERD - Neurodynamics and Evolutionary Robotics Development Toolkit    *
+ *                                                                         *
+ *   University of Osnabrueck, Germany                                     *
+ *   Institute of Cognitive Science                                        *
+ *   Neurocybernetics Group                                                *
+ *   http://www.ikw.uni-osnabrueck.de/~neurokybernetik/                    *
+ *                                                                         *
+ *   Project homepage: nerd.x-bot.org                                      *
+ *                                                                         *
+ *   Copyright (C) 2008 - 2013 by the Neurocybernetics Group Osnabrück     *
+ *   Contact: Christian Rempis                                             *
+ *   christian.rempis@uni-osnabrueck.de                                    *
+ *   Contributors: see contributors.txt in the nerd main directory.        *
+ *                                                                         *
+ *                                                                         *
+ *   Acknowledgments:                                                      *
+ *   The NERD Toolkit is part of the EU project ALEAR                      *
+ *   (Artificial Language Evolution on Autonomous Robots) www.ALEAR.eu     *
+ *   This work was funded (2008 - 2011) by EU-Project Number ICT 214856    *
+ *                                                                         *
+ *                                                                         *
+ *   License Agreement:                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ *                                                                         *
+ *   Publications based on work using the NERD kit have to state this      *
+ *   clearly by citing the NERD homepage and the NERD overview paper.      *  
+ ***************************************************************************/
+
+
+
+#ifndef NERDLogWriter_H
+#define NERDLogWriter_H
+
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QAtomicInt>
+#include <QAtomicPointer>
+#include <QString>
+#include <QTime>
+#include <QTextStream>
+
+namespace nerd {
+
+	class StringValue;
+
+	/**
+	 * LogEntry.
+	 * A single message in the queue of the LogWriter.
+	 */
+	struct LogEntry {
+		LogEntry() : mNext(0), mSeverity(0), mPublished(false) {}
+
+		QAtomicPointer<LogEntry> mNext;
+		QString mMessage;
+		QTime mTime;
+		int mSeverity;
+		bool mPublished;
+	};
+
+
+	/**
+	 * LogWriter.
+	 * Writes the messages of the Core logger in its own thread.
+	 *
+	 * Messages are added with addMessage() from any thread to a lock-free 
+	 * multi-producer queue, so logging never waits for the disk. The writer thread
+	 * formats the messages, collapses identical consecutive messages to a single 
+	 * "Last message repeated N times" line and flushes the stream every 
+	 * FLUSH_INTERVAL ms (and immediately after errors). 
+	 *
+	 * The recent message value (/Logger/RecentMessage) is set directly by addMessage()
+	 * as long as the rate limit allows it (a burst of RECENT_MESSAGE_BURST messages, 
+	 * then one message per FLUSH_INTERVAL). Suppressed messages are still written to 
+	 * the log file, and the most recent of them is published by the writer thread.
+	 *
+	 * When the queue is empty, the writer thread sleeps on a wait condition until 
+	 * addMessage() wakes it up or the next flush is due.
+	 *
+	 * stop() writes all pending messages and terminates the thread.
+	 */
+	class LogWriter : public QThread {
+	public:
+		LogWriter(QTextStream *stream);
+		virtual ~LogWriter();
+
+		void addMessage(const QString &message, int severity);
+		void setRecentMessageValue(StringValue *value);
+		void stop();
+
+		static const int FLUSH_INTERVAL;
+		static const int RECENT_MESSAGE_BURST;
+
+	protected:
+		virtual void run();
+
+	private:
+		bool writeEntries();
+		void writeMessage(const QTime &time, const QString &message, int severity);
+		void writeRepetitions();
+		void publishRecentMessage(const QString &message);
+		void publishPendingMessage();
+
+	private:
+		QTextStream *mStream;
+		QAtomicPointer<LogEntry> mHead;
+		LogEntry *mTail;
+		QAtomicInt mRunning;
+		QAtomicInt mWriterWaiting;
+		QMutex mWaitMutex;
+		QWaitCondition mEntriesAvailable;
+		QAtomicInt mRecentMessageTokens;
+		QMutex mRecentMessageMutex;
+		StringValue *mRecentMessageValue;
+		QString mPendingRecentMessage;
+		bool mHasPendingRecentMessage;
+		QString mLastMessage;
+		int mLastSeverity;
+		QTime mLastRepetitionTime;
+		int mNumberOfRepetitions;
+	};
+
+}
+
+#endif
+
@@ -171,10 +171,11 @@ bool ParameterizedObject::addParameter(const QString &name, Value *value, bool p
  * @return the parameter identified with the given name if available, otherwise NULL.
  */
 Value* ParameterizedObject::getParameter(const QString &name) const {
-	if(!mNames.contains(name)) {
+	int index = mNames.indexOf(name);
+	if(index < 0) {
 		return 0;
 	}
-	return mValues.at(mNames.indexOf(name));
+	return mValues.at(index);
 }
 
 
@@ -175,24 +175,16 @@ bool Properties::hasExactProperty(const QString &prefixedName) const {
 bool Properties::hasProperty(const QString &name) const {
 	QMutexLocker locker(const_cast<QMutex*>(&mMutex));
 	
-	QString propName = name;
-	for(QListIterator<QString> j(mOptionalHiddenPrefixes); j.hasNext();) {
-		QString prefix = j.next();
-		if(propName.startsWith(prefix)) {
-			propName = propName.mid(prefix.size());
-			break;
-		}
+	QString propName = stripHiddenPrefix(name);
+
+	//only the raw name and its prefixed versions can match, so there is no need 
+	//to scan all properties. 
+	if(mProperties.contains(propName) && stripHiddenPrefix(propName) == propName) {
+		return true;
 	}
-	for(QHashIterator<QString, QString> i(mProperties); i.hasNext();) {
-		QString prop = i.next().key();
-		for(QListIterator<QString> j(mOptionalHiddenPrefixes); j.hasNext();) {
-			QString prefix = j.next();
-			if(prop.startsWith(prefix)) {
-				prop = prop.mid(prefix.size());
-				break;
-			}
-		}
-		if(prop == propName) {
+	for(QListIterator<QString> j(mOptionalHiddenPrefixes); j.hasNext();) {
+		QString prop = j.next() + propName;
+		if(mProperties.contains(prop) && stripHiddenPrefix(prop) == propName) {
 			return true;
 		}
 	}
@@ -200,6 +192,20 @@ bool Properties::hasProperty(const QString &name) const {
 }
 
 
+/**
+ * Returns the name without the first matching optional hidden prefix.
+ */
+QString Properties::stripHiddenPrefix(const QString &name) const {
+	for(QListIterator<QString> j(mOptionalHiddenPrefixes); j.hasNext();) {
+		const QString &prefix = j.next();
+		if(name.startsWith(prefix)) {
+			return name.mid(prefix.size());
+		}
+	}
+	return name;
+}
+
+
 /**
  * Removes a property from the property list.
  * 
@@ -245,6 +251,43 @@ void Properties::removePropertyByPattern(const QString &namePattern) {
 }
 
 
+/**
+ * Removes all properties whose names start with the given prefix.
+ * This is a faster alternative to removePropertyByPattern() for the common
+ * case of a simple prefix.
+ * 
+ * @param prefix the name prefix of the properties to remove.
+ */
+void Properties::removePropertiesByPrefix(const QString &prefix) {
+	QList<QString> removedProperties;
+	{
+		QMutexLocker locker(&mMutex);
+		
+		if(mProperties.empty()) {
+			return;
+		}
+		for(QHash<QString, QString>::iterator i = mProperties.begin(); i != mProperties.end();) {
+			if(i.key().startsWith(prefix)) {
+				removedProperties.append(i.key());
+				i = mProperties.erase(i);
+			}
+			else {
+				++i;
+			}
+		}
+	}
+
+	if(!removedProperties.empty()) {
+		for(QListIterator<PropertyChangedListener*> i(mListeners); i.hasNext();) {
+			PropertyChangedListener *listener = i.next();
+			for(QListIterator<QString> j(removedProperties); j.hasNext();) {
+				listener->propertyChanged(this, j.next());
+			}
+		}
+	}
+}
+
+
 /**
  * Returns a list with all property names that exist in this Properties list.
  *
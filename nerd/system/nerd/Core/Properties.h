@@ -78,6 +78,7 @@ namespace nerd {
 		virtual bool hasProperty(const QString &name) const;
 		virtual void removeProperty(const QString &name);
 		virtual void removePropertyByPattern(const QString &namePattern);
+		virtual void removePropertiesByPrefix(const QString &prefix);
 
 		virtual QList<QString> getPropertyNames() const;
 		const QHash<QString, QString>& getProperties() const;
@@ -92,6 +93,9 @@ namespace nerd {
 
 		virtual bool equals(Properties *properties) const;
 
+	protected:
+		QString stripHiddenPrefix(const QString &name) const;
+
 	private:
 		QHash<QString, QString> mProperties;
 		QList<PropertyChangedListener*> mListeners;
@@ -44,6 +44,8 @@
 #ifndef NERDTask_H
 #define NERDTask_H
 
+#include <QAtomicInt>
+
 namespace nerd {
 
 	/**
@@ -53,12 +55,31 @@ namespace nerd {
 	 * at the Core with scheduleTask() to be executed by the main execution loop.
 	 * This prevents access of critical, non-thread save sections of the system
 	 * from access through different threads.
+	 *
+	 * Tasks are linked directly into the lock-free queue of the Core, so scheduling 
+	 * a Task does not allocate any memory.
+	 *
+	 * If getCoalescingKey() returns a key other than NULL, then consecutive Tasks with 
+	 * the same key, that are pending in the same call of Core::executePendingTasks(), 
+	 * are coalesced: only the last of them is executed, at the position of the first one. 
+	 * The others are destroyed without execution. Tasks without a key separate such groups,
+	 * so they see the same state as without coalescing.
+	 * This is useful for Tasks that completely overwrite a state, like ChangeValueTask.
 	 */
 	class Task {
 	public:
+		Task() : mNextScheduledTask(0), mScheduled(0) {};
+		Task(const Task&) : mNextScheduledTask(0), mScheduled(0) {};
 		virtual ~Task() {};
 
 		virtual bool runTask() = 0;
+		virtual const void* getCoalescingKey() const { return 0; };
+
+	private:
+		friend class Core;
+
+		Task *mNextScheduledTask;
+		QAtomicInt mScheduled;
 	};
 
 }
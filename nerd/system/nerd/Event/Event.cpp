@@ -46,6 +46,7 @@
 #include "EventListener.h"
 #include "EventManager.h"
 #include "Core/Core.h"
+#include "Util/Profiler.h"
 #include <iostream>
 
 using namespace std;
@@ -179,6 +180,12 @@ void Event::trigger() {
 		mEventManager->pushToNotificationStack(this);
 	}
 
+	Profiler *profiler = Core::getInstance()->getProfiler();
+	bool profile = profiler != 0 && profiler->isEnabled();
+	if(profile) {
+		profiler->enter(getName());
+	}
+
 	for(int i = 0; i < mUpstreamEvents.size(); ++i) {
 		mUpstreamEvents.at(i)->trigger();
 	}
@@ -200,11 +207,23 @@ void Event::trigger() {
 		for(int index = 0; index < mEventBuffer.size(); index++) {
 			EventListener *e = mEventBuffer.at(index);
 			if(mEventListeners.contains(e)) {
-        e->eventOccured(this);
+				if(profile) {
+					//attribute the execution time to each listener.
+					profiler->enter(e->getName());
+					e->eventOccured(this);
+					profiler->leave();
+				}
+				else {
+					e->eventOccured(this);
+				}
 			}
 		}
 	}
 
+	if(profile) {
+		profiler->leave();
+	}
+
 	if(mTraceEventNotifications) {
 		//TODO deprecated
 		mEventManager->popFromNotificationStack();
@@ -88,10 +88,15 @@ const QString NerdConstants::GUI_MAIN_SIMULATION_WINDOW
 const QString NerdConstants::VALUE_NERD_ENABLE_PERFORMANCE_MEASUREMENTS
 		= "/Performance/EnablePerformanceMeasurements";
 
+const QString NerdConstants::VALUE_NERD_PROFILER_TRACE_FILE
+		= "/Performance/ProfilerTraceFile";
+
 // const QString NerdConstants::VALUE_NERD_SYSTEM_PAUSE
 // 		= "/Simulation/Pause";
 const QString NerdConstants::VALUE_NERD_RECENT_LOGGER_MESSAGE
 		= "/Logger/RecentMessage";
+const QString NerdConstants::VALUE_NERD_MINIMUM_LOG_SEVERITY
+		= "/Logger/MinimumSeverity";
 
 const QString NerdConstants::VALUE_NERD_REPOSITORY_CHANGED_COUNTER
 		= "/ValueManager/RepositoryChangedCounter";
@@ -81,8 +81,10 @@ namespace nerd {
 	//**************************************************************************
 
 		static const QString VALUE_NERD_ENABLE_PERFORMANCE_MEASUREMENTS;
+		static const QString VALUE_NERD_PROFILER_TRACE_FILE;
 // 		static const QString VALUE_NERD_SYSTEM_PAUSE;
 		static const QString VALUE_NERD_RECENT_LOGGER_MESSAGE;
+		static const QString VALUE_NERD_MINIMUM_LOG_SEVERITY;
 		static const QString VALUE_NERD_REPOSITORY_CHANGED_COUNTER;
 		static const QString VALUE_NERD_STEPS_PER_SECOND;
 		static const QString VALUE_RUN_IN_PERFORMANCE_MODE;
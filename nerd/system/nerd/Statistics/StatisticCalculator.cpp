@@ -50,7 +50,8 @@
 namespace nerd {
 
 StatisticCalculator::StatisticCalculator(const QString &name, const QString &valuePath)
-	: mStartIndex(0), mName(name), mObservedValue(0)
+	: mStartIndex(0), mNumberOfValues(0), mName(name), mObservedValue(0), 
+	  mObservedDoubleValue(0), mObservedIntValue(0)
 {
 	mLastSetValue = new DoubleValue(0.0);
 
@@ -86,37 +87,80 @@ bool StatisticCalculator::calculateNextValue(int index) {
 	if(mObservedValue == 0) {
 		return true;
 	}
-	DoubleValue *doubleValue = dynamic_cast<DoubleValue*>(mObservedValue);
-	if(doubleValue != 0) {
-		setValue(index, doubleValue->get());
+	//the type of the observed value was resolved in setObservedValue().
+	if(mObservedDoubleValue != 0) {
+		setValue(index, mObservedDoubleValue->get());
 		return true;
 	}
-	
-	IntValue *intValue = dynamic_cast<IntValue*>(mObservedValue);
-	if(intValue != 0) {
-		setValue(index, intValue->get());
+	if(mObservedIntValue != 0) {
+		setValue(index, mObservedIntValue->get());
 		return true;
 	}
 	return false;
 }
 
+
+/**
+ * Clears all values. The memory of the value array is kept for reuse.
+ */
 void StatisticCalculator::reset() {
-	mStatistics.clear();
+	mNumberOfValues = 0;
 }
 
 
 QList<double> StatisticCalculator::getStatistics(int startIndex, int endIndex) {
 	//TODO consider startindex.
 
-	if(startIndex > mStatistics.size() || startIndex < 0) {
+	if(startIndex > mNumberOfValues || startIndex < 0) {
 		return QList<double>();
 	}
-	return mStatistics.mid(startIndex, (endIndex - startIndex));
+	if(endIndex < startIndex || endIndex > mNumberOfValues) {
+		endIndex = mNumberOfValues;
+	}
+
+	QList<double> statistics;
+	for(int i = startIndex; i < endIndex; ++i) {
+		statistics.append(mStatistics.at(i));
+	}
+	return statistics;
 }
 
 
+/**
+ * Returns a copy of all values. Use getValues() and getNumberOfValues() 
+ * to access the values without copying.
+ */
 QList<double> StatisticCalculator::getStatistics() const {
-	return mStatistics;
+	QList<double> statistics;
+	statistics.reserve(mNumberOfValues);
+	for(int i = 0; i < mNumberOfValues; ++i) {
+		statistics.append(mStatistics.at(i));
+	}
+	return statistics;
+}
+
+
+/**
+ * Returns the value array. Only the first getNumberOfValues() entries are valid.
+ */
+const double* StatisticCalculator::getValues() const {
+	return mStatistics.constData();
+}
+
+
+int StatisticCalculator::getNumberOfValues() const {
+	return mNumberOfValues;
+}
+
+
+/**
+ * Returns the value with the highest index, or 0.0 if there are no values.
+ */
+double StatisticCalculator::getLastValue() const {
+	if(mNumberOfValues == 0) {
+		return 0.0;
+	}
+	return mStatistics.at(mNumberOfValues - 1);
 }
 
 
@@ -130,11 +174,18 @@ void StatisticCalculator::setValue(int index, double value) {
 		//TODO warning?
 		return;
 	}
-	//ensure that the list is large enough.
-	while(index >= mStatistics.size()) {
-		mStatistics.append(0.0);
+	if(index >= mStatistics.size()) {
+		//grow geometrically to avoid a reallocation for each new value.
+		mStatistics.resize(qMax(index + 1, qMax(64, mStatistics.size() * 2)));
+	}
+	//skipped indices are set to 0.0 (the array may contain values from before a reset).
+	for(int i = mNumberOfValues; i < index; ++i) {
+		mStatistics[i] = 0.0;
 	}
 	mStatistics[index] = value;
+	if(index >= mNumberOfValues) {
+		mNumberOfValues = index + 1;
+	}
 
 	mLastSetValue->set(value);
 
@@ -154,13 +205,14 @@ QList<StatisticCalculator*> StatisticCalculator::getChildStatistics() const
 }
 
 bool StatisticCalculator::setObservedValue(Value *value) {
-	if(  value != 0 
-		&& dynamic_cast<DoubleValue*>(value) == 0 
-    && dynamic_cast<IntValue*>(value) == 0)
-	{
+	DoubleValue *doubleValue = dynamic_cast<DoubleValue*>(value);
+	IntValue *intValue = dynamic_cast<IntValue*>(value);
+	if(value != 0 && doubleValue == 0 && intValue == 0) {
 		return false;
 	}
 	mObservedValue = value;
+	mObservedDoubleValue = doubleValue;
+	mObservedIntValue = intValue;
 	return true;
 }
 
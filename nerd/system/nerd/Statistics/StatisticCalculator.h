@@ -46,14 +46,20 @@
 #define NERDStatisticCalculator_H
 
 #include <QList>
+#include <QVector>
 #include "Core/Object.h"
 #include "Value/DoubleValue.h"
+#include "Value/IntValue.h"
 
 
 namespace nerd {
 
 	/**
 	 * StatisticCalculator.
+	 *
+	 * The values are stored in a contiguous array, which keeps its capacity when 
+	 * the statistics are reset. So after the first try (or generation) no 
+	 * further allocations are required.
 	 */
 	class StatisticCalculator : public virtual Object {
 	public:
@@ -67,6 +73,9 @@ namespace nerd {
 
 		QList<double> getStatistics(int startIndex, int endIndex);
 		QList<double> getStatistics() const;
+		const double* getValues() const;
+		int getNumberOfValues() const;
+		double getLastValue() const;
 		int getStartIndex() const;
 
 		void setValue(int index, double value);
@@ -82,10 +91,13 @@ namespace nerd {
 		
 	private:
 		int mStartIndex;
-		QList<double> mStatistics;
+		QVector<double> mStatistics;
+		int mNumberOfValues;
 		QString mName;
 		DoubleValue *mLastSetValue;
 		Value *mObservedValue;
+		DoubleValue *mObservedDoubleValue;
+		IntValue *mObservedIntValue;
 	};
 
 }
@@ -0,0 +1,133 @@
+/***************************************************************************
+ *   NERD - Neurodynamics and Evolutionary Robotics Development Toolkit    *
+ *                                                                         *
+ *   University of Osnabrueck, Germany                                     *
+ *   Institute of Cognitive Science                                        *
+ *   Neurocybernetics Group                                                *
+ *   http://www.ikw.uni-osnabrueck.de/~neurokybernetik/                    *
+ *                                                                         *
+ *   Project homepage: nerd.x-bot.org                                      *
+ *                                                                         *
+ *   Copyright (C) 2008 - 2013 by the Neurocybernetics Group Osnabrück     *
+ *   Contact: Christian Rempis                                             *
+ *   christian.rempis@uni-osnabrueck.de                                    *
+ *   Contributors: see contributors.txt in the nerd main directory.        *
+ *                                                                         *
+ *                                                                         *
+ *   Acknowledgments:                                                      *
+ *   The NERD Toolkit is part of the EU project ALEAR                      *
+ *   (Artificial Language Evolution on Autonomous Robots) www.ALEAR.eu     *
+ *   This work was funded (2008 - 2011) by EU-Project Number ICT 214856    *
+ *                                                                         *
+ *                                                                         *
+ *   License Agreement:                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ *                                                                         *
+ *   Publications based on work using the NERD kit have to state this      *
+ *   clearly by citing the NERD homepage and the NERD overview paper.      *  
+ ***************************************************************************/
+
+
+
+#include "StatisticsLogWriter.h"
+#include "Core/Core.h"
+#include <QMutexLocker>
+#include <QByteArray>
+
+namespace nerd {
+
+
+/**
+ * Creates a new writer for the given (already opened) file.
+ * The writer thread is not started automatically.
+ *
+ * @param file the file to write to. The file has to be open for writing.
+ */
+StatisticsLogWriter::StatisticsLogWriter(QFile *file)
+	: QThread(0), mFile(file), mFinish(false)
+{
+	Core::getInstance()->registerThread(this);
+}
+
+StatisticsLogWriter::~StatisticsLogWriter() {
+	Core::getInstance()->deregisterThread(this);
+}
+
+
+/**
+ * Hands a row over to the writer thread.
+ */
+void StatisticsLogWriter::addRow(const QVector<double> &row) {
+	QMutexLocker locker(&mMutex);
+	mPendingRows.append(row);
+	mRowsAvailable.wakeAll();
+}
+
+
+/**
+ * Writes all pending rows and blocks until the writer thread has terminated.
+ */
+void StatisticsLogWriter::finish() {
+	{
+		QMutexLocker locker(&mMutex);
+		mFinish = true;
+		mRowsAvailable.wakeAll();
+	}
+	if(isRunning()) {
+		wait();
+	}
+	else {
+		//writer was never started: write synchronously.
+		run();
+	}
+}
+
+
+void StatisticsLogWriter::run() {
+	while(true) {
+		QList<QVector<double> > rows;
+		{
+			QMutexLocker locker(&mMutex);
+			while(mPendingRows.empty() && !mFinish) {
+				mRowsAvailable.wait(&mMutex);
+			}
+			if(mPendingRows.empty()) {
+				break;
+			}
+			rows.swap(mPendingRows);
+		}
+		if(mFile == 0 || !mFile->isOpen()) {
+			continue;
+		}
+		QByteArray data;
+		for(QListIterator<QVector<double> > i(rows); i.hasNext();) {
+			const QVector<double> &row = i.next();
+			for(int j = 0; j < row.size(); ++j) {
+				if(j > 0) {
+					data.append(';');
+				}
+				data.append(QByteArray::number(row.at(j), 'g', 15));
+			}
+			data.append('\n');
+		}
+		mFile->write(data);
+		mFile->flush();
+	}
+}
+
+}
+
@@ -0,0 +1,89 @@
+/***************************************************************************
+ *   NERD - Neurodynamics and Evolutionary Robotics Development Toolkit    *
+ *                                                                         *
+ *   University of Osnabrueck, Germany                                     *
+ *   Institute of Cognitive Science                                        *
+ *   Neurocybernetics Group                                                *
+ *   http://www.ikw.uni-osnabrueck.de/~neurokybernetik/                    *
+ *                                                                         *
+ *   Project homepage: nerd.x-bot.org                                      *
+ *                                                                         *
+ *   Copyright (C) 2008 - 2013 by the Neurocybernetics Group Osnabrück     *
+ *   Contact: Christian Rempis                                             *
+ *   christian.rempis@uni-osnabrueck.de                                    *
+ *   Contributors: see contributors.txt in the nerd main directory.        *
+ *                                                                         *
+ *                                                                         *
+ *   Acknowledgments:                                                      *
+ *   The NERD Toolkit is part of the EU project ALEAR                      *
+ *   (Artificial Language Evolution on Autonomous Robots) www.ALEAR.eu     *
+ *   This work was funded (2008 - 2011) by EU-Project Number ICT 214856    *
+ *                                                                         *
+ *                                                                         *
+ *   License Agreement:                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ *                                                                         *
+ *   Publications based on work using the NERD kit have to state this      *
+ *   clearly by citing the NERD homepage and the NERD overview paper.      *  
+ ***************************************************************************/
+
+
+
+#ifndef NERDStatisticsLogWriter_H
+#define NERDStatisticsLogWriter_H
+
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QVector>
+#include <QList>
+#include <QFile>
+
+namespace nerd {
+
+	/**
+	 * StatisticsLogWriter.
+	 * Writes the rows of a StatisticsLogger in its own thread. The logger only 
+	 * copies the current values of its StatisticCalculators with addRow(), 
+	 * the formatting and the disk I/O take place in the writer thread.
+	 *
+	 * The rows are written as text, the values of a row separated by ";".
+	 * The file stays open until finish() is called, but it is not closed by the writer.
+	 */
+	class StatisticsLogWriter : public QThread {
+	public:
+		StatisticsLogWriter(QFile *file);
+		virtual ~StatisticsLogWriter();
+
+		void addRow(const QVector<double> &row);
+		void finish();
+
+	protected:
+		virtual void run();
+
+	private:
+		QFile *mFile;
+		QMutex mMutex;
+		QWaitCondition mRowsAvailable;
+		QList<QVector<double> > mPendingRows;
+		bool mFinish;
+	};
+
+}
+
+#endif
+
@@ -45,6 +45,7 @@
 #include "Statistics/Statistics.h"
 #include "Statistics/StatisticCalculator.h"
 #include "Statistics/StatisticsManager.h"
+#include "Statistics/StatisticsLogWriter.h"
 #include "Core/Core.h"
 #include "NerdConstants.h"
 #include <QTextStream>
@@ -65,7 +66,8 @@ StatisticsLogger::StatisticsLogger(const QString &loggerPath)
 		mLogEvent(0),
 		mLoggingEnabled(false), 
 		mFileSetupCompleted(false),
-		mStatisticsStepEvent("")
+		mStatisticsStepEvent(""),
+		mWriter(0)
 {
 	setLoggerPath(loggerPath);
 
@@ -80,7 +82,8 @@ StatisticsLogger::StatisticsLogger(FileNameValue *loggerPathValue)
 		mLogEvent(0),
 		mLoggingEnabled(false), 
 		mFileSetupCompleted(false),
-		mStatisticsStepEvent("")
+		mStatisticsStepEvent(""),
+		mWriter(0)
 {
 	if(mLoggerPathValue != 0) {
 		setLoggerPath(loggerPathValue->get());
@@ -101,7 +104,8 @@ StatisticsLogger::StatisticsLogger(const QString &loggerPath,
     mLogEvent(0),
     mLoggingEnabled(false), 
     mFileSetupCompleted(false),
-    mStatisticsStepEvent(statisticsStepEvent)
+    mStatisticsStepEvent(statisticsStepEvent),
+		mWriter(0)
 {
 	setLoggerPath(loggerPath);
 
@@ -110,6 +114,7 @@ StatisticsLogger::StatisticsLogger(const QString &loggerPath,
 
 
 StatisticsLogger::~StatisticsLogger() {
+	closeFile();
 }
 
 
@@ -142,6 +147,7 @@ bool StatisticsLogger::bind()
 
 
 bool StatisticsLogger::cleanUp() {
+	closeFile();
 	return true;
 }
 
@@ -154,6 +160,7 @@ void StatisticsLogger::setLoggerPath(const QString &loggerPath)
 		mLoggerPath = loggerPath + QDir::separator();
 	}
 
+	closeFile();
 	mFileSetupCompleted = false;
 	mLoggingEnabled = false;
 }
@@ -168,6 +175,7 @@ QString StatisticsLogger::getLoggerPath()
 void StatisticsLogger::setFileName(const QString &fileName)
 {
 	mFileName = fileName;
+	closeFile();
 	mFileSetupCompleted = false;
 	mLoggingEnabled = false;
 }
@@ -194,7 +202,6 @@ void StatisticsLogger::valueChanged(Value *value) {
 	}
 	else if(value == mLoggerPathValue) {
 		setLoggerPath(mLoggerPathValue->get());
-		mFileSetupCompleted = false;
 	}
 }
 
@@ -227,57 +234,58 @@ bool StatisticsLogger::saveStatistic() {
 		Core::getInstance()->enforceDirectoryPath(mLoggerPath);
 		QString fileName = QString(mLoggerPath).append(mFileName);
 
-		QFile file(fileName);
-		if(!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+		mFile.setFileName(fileName);
+		if(!mFile.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) {
 			Core::log(QString("StatisticsLogger: Could not open file [")
 				.append(fileName).append("] to write statistics."));
-			file.close();
 			return false;
 		}
 
-		QTextStream output(&file);
+		{
+			QTextStream output(&mFile);
 
-		for(QListIterator<StatisticCalculator*> i(calculators); i.hasNext();) {
-			StatisticCalculator *calc = i.next();
-			output << "# " << calc->getName() << endl;
+			for(QListIterator<StatisticCalculator*> i(calculators); i.hasNext();) {
+				StatisticCalculator *calc = i.next();
+				output << "# " << calc->getName() << endl;
+			}
 		}
 
-		file.close();
+		//the file stays open, the rows are written by the writer thread.
+		mWriter = new StatisticsLogWriter(&mFile);
+		mWriter->start();
 
 		mLoggingEnabled = true;
 
 	}
 
 	//if a logger file was successfully created, start loggin. Otherwise stop.
-	if(!mLoggingEnabled) {
+	if(!mLoggingEnabled || mWriter == 0) {
 		return false;
 	}
 
-	QString fileName = QString(mLoggerPath).append(mFileName);
-
-	QFile file(fileName);
-	if(!file.open(QIODevice::WriteOnly | QIODevice::Text | QIODevice::Append)) {
-		Core::log(QString("StatisticsLogger: ERROR - Could not open file [")
-			.append(fileName).append("] to write statistics!"));
-		file.close();
-		return false;
-	}
-
-	QTextStream output(&file);
-
+	mRow.resize(calculators.size());
 	for(int i = 0; i < calculators.size(); ++i) {
-		output << QString::number(calculators.at(i)->getStatistics().last(), 'g', 15);
-
-		if(i < calculators.size() - 1) {
-			output << ";";
-		}
+		mRow[i] = calculators.at(i)->getLastValue();
 	}
+	mWriter->addRow(mRow);
 
-	output << "\n";
+	return true;
+}
 
-	file.close();
 
-	return true;
+/**
+ * Writes all pending rows and closes the logger file.
+ */
+void StatisticsLogger::closeFile() {
+	if(mWriter != 0) {
+		mWriter->finish();
+		delete mWriter;
+		mWriter = 0;
+	}
+	if(mFile.isOpen()) {
+		mFile.close();
+	}
+	mLoggingEnabled = false;
 }
 
 
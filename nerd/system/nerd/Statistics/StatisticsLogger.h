@@ -51,14 +51,20 @@
 #include "Value/StringValue.h"
 #include "Value/ValueChangedListener.h"
 #include "Value/FileNameValue.h"
+#include <QFile>
 
 namespace nerd {
 
+	class StatisticsLogWriter;
+
 	/**
 	 * StatisticsLogger.
 	 * 
 	 * Saves valaues which are collect by a StatisticsCalculator into a logfile.
 	 * The statistics are saved if a log event is triggered. 
+	 *
+	 * The file is kept open until the logger path or file name changes, and the rows 
+	 * are written by a StatisticsLogWriter thread.
 	 */
 	class StatisticsLogger : public virtual SystemObject, public virtual EventListener, 
 							 public virtual ValueChangedListener 
@@ -91,6 +97,9 @@ namespace nerd {
 		virtual bool storeGenerationStatistics();
 		virtual bool saveStatistic();
 
+	private:
+		void closeFile();
+
 	private:
 		QString mLoggerPath;
 		FileNameValue *mLoggerPathValue;
@@ -100,6 +109,9 @@ namespace nerd {
 		bool mLoggingEnabled;
 		bool mFileSetupCompleted;
 		QString mStatisticsStepEvent;
+		QFile mFile;
+		StatisticsLogWriter *mWriter;
+		QVector<double> mRow;
   };
 
 }
@@ -89,13 +89,17 @@ StatisticsManager::~StatisticsManager() {
   // new general handling:
   //////////////////////////////////////////
   
-  QList<StatisticCalculator*> toDelete =  mStatistics.uniqueKeys();
+  QList<StatisticCalculator*> toDelete =  mStatistics.keys();
   
   for(int i = 0; i < toDelete.size(); i++) {
     delete toDelete.at(i);
   }
 
+  qDeleteAll(mStatistics);
   mStatistics.clear();
+  mStatisticsByStepEvent.clear();
+  mStatisticsByClearEvent.clear();
+  mUpdatedEventsByStepEvent.clear();
   
   //////////////////////////////////////////
 }
@@ -223,30 +227,40 @@ void StatisticsManager::eventOccured(Event *event) {
 	// new general handling:
 	//////////////////////////////////////////
 
-  QList<Event*> statisticUpdateEvents; 
+	if(!mStatistics.empty()) {
+		QHash<Event*, QVector<StatisticCalculatorProperty*> >::const_iterator step 
+					= mStatisticsByStepEvent.constFind(event);
+		if(step != mStatisticsByStepEvent.constEnd()) {
+			const QVector<StatisticCalculatorProperty*> &properties = step.value();
+			for(int j = 0; j < properties.size(); ++j) {
+				StatisticCalculatorProperty *property = properties.at(j);
+				property->calculator->calculateNextValue(property->currentIndex);
+				property->currentIndex++;
+			}
+		}
 
-	QMap<StatisticCalculator*, StatisticCalculatorProperty>::iterator i = mStatistics.begin();
-	while (i != mStatistics.end()) 
-	{
-		if(event == i.value().nextStatisticStepEvent) {
-			i.key()->calculateNextValue(i.value().currentIndex);
-			i.value().currentIndex++;
-			if(!statisticUpdateEvents.contains(i.value().statisticUpdatedEvent)) {
-				statisticUpdateEvents.append(i.value().statisticUpdatedEvent);
+		QHash<Event*, QVector<StatisticCalculatorProperty*> >::const_iterator clear
+					= mStatisticsByClearEvent.constFind(event);
+		if(clear != mStatisticsByClearEvent.constEnd()) {
+			const QVector<StatisticCalculatorProperty*> &properties = clear.value();
+			for(int j = 0; j < properties.size(); ++j) {
+				StatisticCalculatorProperty *property = properties.at(j);
+				//calculators with the same step and clear event are only stepped.
+				if(property->nextStatisticStepEvent != event) {
+					property->currentIndex = 0;
+					property->calculator->reset();
+				}
 			}
-		} 
-		else if(event == i.value().clearStatisticEvent) {
-			i.value().currentIndex = 0;
-			i.key()->reset();;
 		}
- 
-		i++;
-	}
 
-	for(int j = 0; j < statisticUpdateEvents.size(); j++) {
-		statisticUpdateEvents.at(j)->trigger();
+		if(step != mStatisticsByStepEvent.constEnd()) {
+			//copy, as listeners of the updated events may change the statistics.
+			QVector<Event*> statisticUpdateEvents = mUpdatedEventsByStepEvent.value(event);
+			for(int j = 0; j < statisticUpdateEvents.size(); j++) {
+				statisticUpdateEvents.at(j)->trigger();
+			}
+		}
 	}
-	statisticUpdateEvents.clear();
 
 	//////////////////////////////////////////
   
@@ -463,6 +477,7 @@ bool StatisticsManager::addStatistics(StatisticCalculator *calculator,
   }
   
   StatisticCalculatorProperty elem;
+  elem.calculator = calculator;
   elem.currentIndex = 0;
   
   // register to Events, if they do not exists --> create them
@@ -483,7 +498,16 @@ bool StatisticsManager::addStatistics(StatisticCalculator *calculator,
                      statisticUpdatedEventName)); 
   }
 
-  mStatistics.insert(calculator,elem);
+  // a calculator that was already added is replaced.
+  if(mStatistics.contains(calculator)) {
+    removeStatistics(calculator);
+  }
+
+  StatisticCalculatorProperty *property = new StatisticCalculatorProperty(elem);
+  mStatistics.insert(calculator, property);
+  mStatisticsByStepEvent[property->nextStatisticStepEvent].append(property);
+  mStatisticsByClearEvent[property->clearStatisticEvent].append(property);
+  updateUpdatedEvents(property->nextStatisticStepEvent);
 
   for(QListIterator<StatisticCalculator*> i(calculator->getChildStatistics()); i.hasNext();) {
     ok &= addStatistics(i.next(), 
@@ -498,7 +522,25 @@ bool StatisticsManager::addStatistics(StatisticCalculator *calculator,
     
 bool StatisticsManager::removeStatistics(StatisticCalculator *calculator)
 {
-  mStatistics.remove(calculator);
+  if(calculator == 0) {
+    return false;
+  }
+
+  StatisticCalculatorProperty *property = mStatistics.take(calculator);
+  if(property != 0) {
+    mStatisticsByStepEvent[property->nextStatisticStepEvent].remove(
+          mStatisticsByStepEvent[property->nextStatisticStepEvent].indexOf(property));
+    if(mStatisticsByStepEvent[property->nextStatisticStepEvent].empty()) {
+      mStatisticsByStepEvent.remove(property->nextStatisticStepEvent);
+    }
+    mStatisticsByClearEvent[property->clearStatisticEvent].remove(
+          mStatisticsByClearEvent[property->clearStatisticEvent].indexOf(property));
+    if(mStatisticsByClearEvent[property->clearStatisticEvent].empty()) {
+      mStatisticsByClearEvent.remove(property->clearStatisticEvent);
+    }
+    updateUpdatedEvents(property->nextStatisticStepEvent);
+    delete property;
+  }
   
   for(QListIterator<StatisticCalculator*> i(calculator->getChildStatistics()); i.hasNext();) {
     removeStatistics(i.next());
@@ -552,14 +594,15 @@ QList<StatisticCalculator*> StatisticsManager::getStatistics(const QString &stat
 {
   QList<StatisticCalculator*> list;
   
-  QMap<StatisticCalculator*, StatisticCalculatorProperty>::iterator i = mStatistics.begin();
-  while (i != mStatistics.end()) 
+  QHash<Event*, QVector<StatisticCalculatorProperty*> >::const_iterator i 
+        = mStatisticsByStepEvent.constBegin();
+  while (i != mStatisticsByStepEvent.constEnd()) 
   {
-    if( i.value().nextStatisticStepEvent->getNames().contains(statisticsStepEvent) )
+    if(i.key()->getNames().contains(statisticsStepEvent))
     {
-      if(!list.contains(i.key()))
-      {
-        list.append(i.key());
+      const QVector<StatisticCalculatorProperty*> &properties = i.value();
+      for(int j = 0; j < properties.size(); ++j) {
+        list.append(properties.at(j)->calculator);
       }
     }
  
@@ -570,6 +613,30 @@ QList<StatisticCalculator*> StatisticsManager::getStatistics(const QString &stat
 }
 
 
+/**
+ * Collects the (unique) statisticUpdatedEvents of all StatisticCalculators 
+ * that are stepped by the given event. They are triggered after each step.
+ */
+void StatisticsManager::updateUpdatedEvents(Event *nextStatisticStepEvent)
+{
+  QVector<Event*> updatedEvents;
+  const QVector<StatisticCalculatorProperty*> properties 
+        = mStatisticsByStepEvent.value(nextStatisticStepEvent);
+  for(int i = 0; i < properties.size(); ++i) {
+    Event *updatedEvent = properties.at(i)->statisticUpdatedEvent;
+    if(updatedEvent != 0 && !updatedEvents.contains(updatedEvent)) {
+      updatedEvents.append(updatedEvent);
+    }
+  }
+  if(updatedEvents.empty()) {
+    mUpdatedEventsByStepEvent.remove(nextStatisticStepEvent);
+  }
+  else {
+    mUpdatedEventsByStepEvent.insert(nextStatisticStepEvent, updatedEvents);
+  }
+}
+
+
 }
 
 
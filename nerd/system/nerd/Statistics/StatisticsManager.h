@@ -49,7 +49,8 @@
 #include "Statistics/StatisticCalculator.h"
 #include "Event/Event.h"
 #include <QList>
-#include <QMap>
+#include <QHash>
+#include <QVector>
 #include "Event/EventListener.h"
 
 namespace nerd {
@@ -62,6 +63,7 @@ namespace nerd {
    */
   struct StatisticCalculatorProperty 
   {   
+    StatisticCalculator *calculator;
     int currentIndex;
     Event *nextStatisticStepEvent;
     Event *clearStatisticEvent;
@@ -74,6 +76,9 @@ namespace nerd {
    *
    * TODO: The code should be refractored to use only the new introduced methods which are more 
    * general.  
+   *
+   * The statistics added with addStatistics() are indexed by their step and clear events,
+   * so an event only visits the StatisticCalculators that react on it.
 	 */
 	class StatisticsManager : public virtual SystemObject, public virtual EventListener {
 	public:
@@ -156,8 +161,12 @@ namespace nerd {
     // new general components:
     //////////////////////////////////////////
 
-    QMap<StatisticCalculator*, StatisticCalculatorProperty> mStatistics;
+    QHash<StatisticCalculator*, StatisticCalculatorProperty*> mStatistics;
+    QHash<Event*, QVector<StatisticCalculatorProperty*> > mStatisticsByStepEvent;
+    QHash<Event*, QVector<StatisticCalculatorProperty*> > mStatisticsByClearEvent;
+    QHash<Event*, QVector<Event*> > mUpdatedEventsByStepEvent;
     Event* registerOrAddEvent(const QString &eventName);
+    void updateUpdatedEvents(Event *nextStatisticStepEvent);
 
 	};
 
@@ -0,0 +1,453 @@
+/***************************************************************************
+ *   NERD - Neurodynamics and Evolutionary Robotics Development Toolkit    *
+ *                                                                         *
+ *   University of Osnabrueck, Germany                                     *
+ *   Institute of Cognitive Science                                        *
+ *   Neurocybernetics Group                                                *
+ *   http://www.ikw.uni-osnabrueck.de/~neurokybernetik/                    *
+ *                                                                         *
+ *   Project homepage: nerd.x-bot.org                                      *
+ *                                                                         *
+ *   Copyright (C) 2008 - 2013 by the Neurocybernetics Group Osnabrück     *
+ *   Contact: Christian Rempis                                             *
+ *   christian.rempis@uni-osnabrueck.de                                    *
+ *   Contributors: see contributors.txt in the nerd main directory.        *
+ *                                                                         *
+ *                                                                         *
+ *   Acknowledgments:                                                      *
+ *   The NERD Toolkit is part of the EU project ALEAR                      *
+ *   (Artificial Language Evolution on Autonomous Robots) www.ALEAR.eu     *
+ *   This work was funded (2008 - 2011) by EU-Project Number ICT 214856    *
+ *                                                                         *
+ *                                                                         *
+ *   License Agreement:                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ *                                                                         *
+ *   Publications based on work using the NERD kit have to state this      *
+ *   clearly by citing the NERD homepage and the NERD overview paper.      *  
+ ***************************************************************************/
+
+
+#include "Profiler.h"
+#include "Core/Core.h"
+#include "Value/BoolValue.h"
+#include <QMutexLocker>
+#include <QListIterator>
+#include <QFile>
+#include <QTextStream>
+#include <iostream>
+#ifdef __GNUC__
+#include <cxxabi.h>
+#include <cstdlib>
+#endif
+
+using namespace std;
+
+namespace nerd {
+
+const int Profiler::MAX_TRACE_EVENTS_PER_THREAD = 200000;
+
+
+ProfilerThreadData::ProfilerThreadData(int threadIndex)
+	: mThreadIndex(threadIndex), mRoot("", 0)
+{
+	mCurrentNode = &mRoot;
+}
+
+ProfilerThreadData::~ProfilerThreadData() {
+	QList<ProfilerNode*> nodes;
+	nodes << mRoot.mChildren.toList();
+	while(!nodes.empty()) {
+		ProfilerNode *node = nodes.takeLast();
+		nodes << node->mChildren.toList();
+		delete node;
+	}
+}
+
+
+
+/**
+ * Constructs a new Profiler.
+ *
+ * @param enableValue the value that enables or disables the recording.
+ */
+Profiler::Profiler(BoolValue *enableValue)
+	: mEnableValue(enableValue)
+{
+	mClock.start();
+}
+
+Profiler::~Profiler() {
+	QMutexLocker locker(&mThreadListMutex);
+	while(!mThreads.empty()) {
+		delete mThreads.takeFirst();
+	}
+}
+
+
+bool Profiler::isEnabled() const {
+	return mEnableValue != 0 && mEnableValue->get();
+}
+
+
+/**
+ * Opens a new scope with the given name as child of the current scope of the
+ * calling thread. Each enter() has to be matched by a leave().
+ */
+void Profiler::enter(const char *name) {
+	ProfilerThreadData *data = getThreadData();
+
+	QMutexLocker locker(&data->mMutex);
+	data->mCurrentNode = getChild(data->mCurrentNode, QLatin1String(name));
+	data->mStartTimes.append(mClock.nsecsElapsed());
+}
+
+
+void Profiler::enter(const QString &name) {
+	ProfilerThreadData *data = getThreadData();
+
+	QMutexLocker locker(&data->mMutex);
+	data->mCurrentNode = getChild(data->mCurrentNode, name);
+	data->mStartTimes.append(mClock.nsecsElapsed());
+}
+
+
+/**
+ * Opens a new scope named after the given (dynamic) type. The readable type 
+ * names are cached, so each type is demangled only once.
+ */
+void Profiler::enter(const std::type_info &type) {
+	QString name;
+	{
+		QMutexLocker locker(&mTypeNameMutex);
+		QHash<const char*, QString>::const_iterator i = mTypeNames.find(type.name());
+		if(i == mTypeNames.end()) {
+			i = mTypeNames.insert(type.name(), getTypeName(type));
+		}
+		name = i.value();
+	}
+	enter(name);
+}
+
+
+/**
+ * Returns the readable (demangled) name of a type. If the compiler does not 
+ * support demangling, the name of the type_info is returned unchanged.
+ */
+QString Profiler::getTypeName(const std::type_info &type) {
+#ifdef __GNUC__
+	int status = 0;
+	char *demangled = abi::__cxa_demangle(type.name(), 0, 0, &status);
+	if(demangled != 0) {
+		QString name = QString::fromLatin1(demangled);
+		free(demangled);
+		if(status == 0) {
+			return name;
+		}
+	}
+#endif
+	return QString::fromLatin1(type.name());
+}
+
+
+/**
+ * Closes the current scope of the calling thread and adds its execution time.
+ * Does nothing if there is no open scope.
+ */
+void Profiler::leave() {
+	qint64 now = mClock.nsecsElapsed();
+	ProfilerThreadData *data = getThreadData();
+
+	QMutexLocker locker(&data->mMutex);
+	if(data->mStartTimes.empty()) {
+		return;
+	}
+	qint64 start = data->mStartTimes.last();
+	data->mStartTimes.pop_back();
+	qint64 duration = now - start;
+
+	ProfilerNode *node = data->mCurrentNode;
+	node->mNumberOfCalls++;
+	node->mTotalTime += duration;
+	if(duration > node->mMaxTime) {
+		node->mMaxTime = duration;
+	}
+	if(data->mTraceEvents.size() < MAX_TRACE_EVENTS_PER_THREAD) {
+		ProfilerTraceEvent event;
+		event.mNode = node;
+		event.mStart = start;
+		event.mDuration = duration;
+		data->mTraceEvents.append(event);
+	}
+	if(node->mParent != 0) {
+		data->mCurrentNode = node->mParent;
+	}
+}
+
+
+/**
+ * Clears all measured times and trace events. The call paths are kept, so this 
+ * can also be called while scopes are open.
+ */
+void Profiler::clear() {
+	QMutexLocker locker(&mThreadListMutex);
+	for(QListIterator<ProfilerThreadData*> i(mThreads); i.hasNext();) {
+		ProfilerThreadData *data = i.next();
+		QMutexLocker dataLocker(&data->mMutex);
+
+		QList<ProfilerNode*> nodes = data->mRoot.mChildren.toList();
+		while(!nodes.empty()) {
+			ProfilerNode *node = nodes.takeLast();
+			node->mNumberOfCalls = 0;
+			node->mTotalTime = 0;
+			node->mMaxTime = 0;
+			nodes << node->mChildren.toList();
+		}
+		data->mTraceEvents.clear();
+	}
+}
+
+
+/**
+ * Creates a human readable report with the number of calls, the total and the 
+ * maximal execution time (in microseconds) of each call path.
+ */
+QString Profiler::createReport() {
+	QString report;
+	QMutexLocker locker(&mThreadListMutex);
+	for(QListIterator<ProfilerThreadData*> i(mThreads); i.hasNext();) {
+		ProfilerThreadData *data = i.next();
+		QMutexLocker dataLocker(&data->mMutex);
+
+		report.append("Thread " + QString::number(data->mThreadIndex) + "\n");
+		for(int j = 0; j < data->mRoot.mChildren.size(); ++j) {
+			addReport(data->mRoot.mChildren.at(j), 1, report);
+		}
+	}
+	return report;
+}
+
+
+/**
+ * Creates the call paths in the folded stack format (one line per path with the
+ * exclusive time in ns) that is used by flame graph tools.
+ */
+QString Profiler::createFoldedStacks() {
+	QString stacks;
+	QMutexLocker locker(&mThreadListMutex);
+	for(QListIterator<ProfilerThreadData*> i(mThreads); i.hasNext();) {
+		ProfilerThreadData *data = i.next();
+		QMutexLocker dataLocker(&data->mMutex);
+
+		QString threadName = "Thread" + QString::number(data->mThreadIndex);
+		for(int j = 0; j < data->mRoot.mChildren.size(); ++j) {
+			addFoldedStacks(data->mRoot.mChildren.at(j), threadName, stacks);
+		}
+	}
+	return stacks;
+}
+
+
+/**
+ * Creates a Chrome trace (JSON trace event format) with all recorded scopes.
+ * At most MAX_TRACE_EVENTS_PER_THREAD scopes are recorded per thread.
+ */
+QString Profiler::createChromeTrace() {
+	QString trace = "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+	bool first = true;
+
+	QMutexLocker locker(&mThreadListMutex);
+	for(QListIterator<ProfilerThreadData*> i(mThreads); i.hasNext();) {
+		ProfilerThreadData *data = i.next();
+		QMutexLocker dataLocker(&data->mMutex);
+
+		for(int j = 0; j < data->mTraceEvents.size(); ++j) {
+			const ProfilerTraceEvent &event = data->mTraceEvents.at(j);
+			QString name = event.mNode->mName;
+			name.replace("\\", "\\\\").replace("\"", "\\\"").replace("\n", " ");
+			if(!first) {
+				trace.append(",");
+			}
+			first = false;
+			trace.append("\n{\"name\":\"" + name + "\",\"ph\":\"X\",\"pid\":1,\"tid\":" 
+						+ QString::number(data->mThreadIndex)
+						+ ",\"ts\":" + QString::number(((double) event.mStart) / 1000.0, 'f', 3)
+						+ ",\"dur\":" + QString::number(((double) event.mDuration) / 1000.0, 'f', 3)
+						+ "}");
+		}
+	}
+	trace.append("\n]}\n");
+	return trace;
+}
+
+
+bool Profiler::writeFoldedStacks(const QString &fileName) {
+	return writeFile(fileName, createFoldedStacks());
+}
+
+
+bool Profiler::writeChromeTrace(const QString &fileName) {
+	return writeFile(fileName, createChromeTrace());
+}
+
+
+/**
+ * Returns the recording data of the calling thread. The data is created at the
+ * first call in each thread and remains valid until the Profiler is destroyed.
+ */
+ProfilerThreadData* Profiler::getThreadData() {
+	ProfilerThreadData **data = mThreadData.localData();
+	if(data != 0) {
+		return *data;
+	}
+	QMutexLocker locker(&mThreadListMutex);
+	ProfilerThreadData *threadData = new ProfilerThreadData(mThreads.size());
+	mThreads.append(threadData);
+	//only the pointer to the data is owned (and deleted) by the thread storage.
+	mThreadData.setLocalData(new ProfilerThreadData*(threadData));
+	return threadData;
+}
+
+
+ProfilerNode* Profiler::getChild(ProfilerNode *node, const QString &name) {
+	//nodes have only few children, so a linear search is fastest.
+	ProfilerNode* const *children = node->mChildren.constData();
+	int numberOfChildren = node->mChildren.size();
+	for(int i = 0; i < numberOfChildren; ++i) {
+		if(children[i]->mName == name) {
+			return children[i];
+		}
+	}
+	ProfilerNode *child = new ProfilerNode(name, node);
+	node->mChildren.append(child);
+	return child;
+}
+
+
+/**
+ * Same as getChild(ProfilerNode*, const QString&), but avoids the allocation of 
+ * a QString for existing nodes.
+ */
+ProfilerNode* Profiler::getChild(ProfilerNode *node, const QLatin1String &name) {
+	ProfilerNode* const *children = node->mChildren.constData();
+	int numberOfChildren = node->mChildren.size();
+	for(int i = 0; i < numberOfChildren; ++i) {
+		if(children[i]->mName == name) {
+			return children[i];
+		}
+	}
+	ProfilerNode *child = new ProfilerNode(QString(name), node);
+	node->mChildren.append(child);
+	return child;
+}
+
+
+void Profiler::addReport(ProfilerNode *node, int depth, QString &report) {
+	report.append(QString(depth * 2, ' ') + node->mName 
+				+ "  calls: " + QString::number(node->mNumberOfCalls)
+				+ "  total: " + QString::number(((double) node->mTotalTime) / 1000.0, 'f', 1) + " us"
+				+ "  max: " + QString::number(((double) node->mMaxTime) / 1000.0, 'f', 1) + " us\n");
+	for(int i = 0; i < node->mChildren.size(); ++i) {
+		addReport(node->mChildren.at(i), depth + 1, report);
+	}
+}
+
+
+void Profiler::addFoldedStacks(ProfilerNode *node, const QString &path, QString &stacks) {
+	QString name = node->mName;
+	name.replace(";", ",").replace(" ", "_").replace("\n", "_");
+	QString nodePath = path + ";" + name;
+
+	qint64 exclusiveTime = node->mTotalTime;
+	for(int i = 0; i < node->mChildren.size(); ++i) {
+		exclusiveTime -= node->mChildren.at(i)->mTotalTime;
+	}
+	if(exclusiveTime > 0) {
+		stacks.append(nodePath + " " + QString::number(exclusiveTime) + "\n");
+	}
+	for(int i = 0; i < node->mChildren.size(); ++i) {
+		addFoldedStacks(node->mChildren.at(i), nodePath, stacks);
+	}
+}
+
+
+bool Profiler::writeFile(const QString &fileName, const QString &content) {
+	QFile file(fileName);
+	if(!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) {
+		Core::log("Profiler: Could not write to file [" + fileName + "]", true);
+		return false;
+	}
+	QTextStream output(&file);
+	output << content;
+	file.close();
+	return true;
+}
+
+
+
+/**
+ * Opens a profiler scope if the profiler of the Core is enabled. 
+ * The scope is closed by the destructor.
+ */
+ProfilerScope::ProfilerScope(const char *name)
+	: mProfiler(Core::getInstance()->getProfiler())
+{
+	if(mProfiler != 0 && mProfiler->isEnabled()) {
+		mProfiler->enter(name);
+	}
+	else {
+		mProfiler = 0;
+	}
+}
+
+
+ProfilerScope::ProfilerScope(const QString &name)
+	: mProfiler(Core::getInstance()->getProfiler())
+{
+	if(mProfiler != 0 && mProfiler->isEnabled()) {
+		mProfiler->enter(name);
+	}
+	else {
+		mProfiler = 0;
+	}
+}
+
+
+/**
+ * Opens a scope named prefix + name. The name is only assembled if the profiler
+ * is enabled, so that disabled scopes do not allocate any strings.
+ */
+ProfilerScope::ProfilerScope(const char *prefix, const QString &name)
+	: mProfiler(Core::getInstance()->getProfiler())
+{
+	if(mProfiler != 0 && mProfiler->isEnabled()) {
+		mProfiler->enter(QLatin1String(prefix) + name);
+	}
+	else {
+		mProfiler = 0;
+	}
+}
+
+
+ProfilerScope::~ProfilerScope() {
+	if(mProfiler != 0) {
+		mProfiler->leave();
+	}
+}
+
+}
+
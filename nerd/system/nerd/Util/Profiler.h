@@ -0,0 +1,191 @@
+/***************************************************************************
+ *   NERD - Neurodynamics and Evolutionary Robotics Development Toolkit    *
+ *                                                                         *
+ *   University of Osnabrueck, Germany                                     *
+ *   Institute of Cognitive Science                                        *
+ *   Neurocybernetics Group                                                *
+ *   http://www.ikw.uni-osnabrueck.de/~neurokybernetik/                    *
+ *                                                                         *
+ *   Project homepage: nerd.x-bot.org                                      *
+ *                                                                         *
+ *   Copyright (C) 2008 - 2013 by the Neurocybernetics Group Osnabrück     *
+ *   Contact: Christian Rempis                                             *
+ *   christian.rempis@uni-osnabrueck.de                                    *
+ *   Contributors: see contributors.txt in the nerd main directory.        *
+ *                                                                         *
+ *                                                                         *
+ *   Acknowledgments:                                                      *
+ *   The NERD Toolkit is part of the EU project ALEAR                      *
+ *   (Artificial Language Evolution on Autonomous Robots) www.ALEAR.eu     *
+ *   This work was funded (2008 - 2011) by EU-Project Number ICT 214856    *
+ *                                                                         *
+ *                                                                         *
+ *   License Agreement:                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ *                                                                         *
+ *   Publications based on work using the NERD kit have to state this      *
+ *   clearly by citing the NERD homepage and the NERD overview paper.      *  
+ ***************************************************************************/
+
+
+#ifndef NERDProfiler_H
+#define NERDProfiler_H
+
+#include <QString>
+#include <QVector>
+#include <QList>
+#include <QMutex>
+#include <QThreadStorage>
+#include <QElapsedTimer>
+#include <QHash>
+#include <typeinfo>
+
+namespace nerd {
+
+	class BoolValue;
+
+	/**
+	 * ProfilerNode.
+	 * A call path of the Profiler with the accumulated execution times (in ns).
+	 */
+	struct ProfilerNode {
+		ProfilerNode(const QString &name, ProfilerNode *parent)
+			: mName(name), mParent(parent), mNumberOfCalls(0), mTotalTime(0), mMaxTime(0) {}
+
+		QString mName;
+		ProfilerNode *mParent;
+		QVector<ProfilerNode*> mChildren;
+		qint64 mNumberOfCalls;
+		qint64 mTotalTime;
+		qint64 mMaxTime;
+	};
+
+
+	/**
+	 * ProfilerTraceEvent.
+	 * A single timed scope, used for the Chrome trace export.
+	 */
+	struct ProfilerTraceEvent {
+		ProfilerNode *mNode;
+		qint64 mStart;
+		qint64 mDuration;
+	};
+
+
+	/**
+	 * ProfilerThreadData.
+	 * The call tree and the trace buffer of a single thread.
+	 */
+	class ProfilerThreadData {
+	public:
+		ProfilerThreadData(int threadIndex);
+		~ProfilerThreadData();
+
+		QMutex mMutex;
+		int mThreadIndex;
+		ProfilerNode mRoot;
+		ProfilerNode *mCurrentNode;
+		QVector<qint64> mStartTimes;
+		QVector<ProfilerTraceEvent> mTraceEvents;
+	};
+
+
+	/**
+	 * Profiler.
+	 *
+	 * Hierarchical profiler with nanosecond resolution. Scopes are opened with enter() 
+	 * and closed with leave() (or with a ProfilerScope object) and are aggregated per 
+	 * call path, i.e. the same function called from different places is listed 
+	 * separately. Each thread records into its own call tree, so threads do not 
+	 * block each other.
+	 *
+	 * The profiler is owned by the Core and only records while the value 
+	 * /Performance/EnablePerformanceMeasurements is true. When disabled, a scope 
+	 * costs a single flag check.
+	 *
+	 * The results can be exported as a text report, in the folded stack format of 
+	 * flame graph tools or as Chrome trace JSON (chrome://tracing). If the value 
+	 * /Performance/ProfilerTraceFile is set, the Core writes the trace (and the folded
+	 * stacks to [file].folded) at shutdown.
+	 */
+	class Profiler {
+	public:
+		Profiler(BoolValue *enableValue);
+		virtual ~Profiler();
+
+		bool isEnabled() const;
+
+		void enter(const char *name);
+		void enter(const QString &name);
+		void enter(const std::type_info &type);
+		void leave();
+
+		void clear();
+
+		QString createReport();
+		QString createFoldedStacks();
+		QString createChromeTrace();
+		bool writeFoldedStacks(const QString &fileName);
+		bool writeChromeTrace(const QString &fileName);
+
+		static QString getTypeName(const std::type_info &type);
+
+		static const int MAX_TRACE_EVENTS_PER_THREAD;
+
+	private:
+		ProfilerThreadData* getThreadData();
+		ProfilerNode* getChild(ProfilerNode *node, const QString &name);
+		ProfilerNode* getChild(ProfilerNode *node, const QLatin1String &name);
+		void addReport(ProfilerNode *node, int depth, QString &report);
+		void addFoldedStacks(ProfilerNode *node, const QString &path, QString &stacks);
+		bool writeFile(const QString &fileName, const QString &content);
+
+	private:
+		BoolValue *mEnableValue;
+		QElapsedTimer mClock;
+		QMutex mThreadListMutex;
+		QList<ProfilerThreadData*> mThreads;
+		QThreadStorage<ProfilerThreadData**> mThreadData;
+		QMutex mTypeNameMutex;
+		QHash<const char*, QString> mTypeNames;
+	};
+
+
+	/**
+	 * ProfilerScope.
+	 * Measures the execution time of the enclosing scope with the Profiler of the Core.
+	 */
+	class ProfilerScope {
+	public:
+		ProfilerScope(const char *name);
+		ProfilerScope(const QString &name);
+		ProfilerScope(const char *prefix, const QString &name);
+		~ProfilerScope();
+
+	private:
+		ProfilerScope(const ProfilerScope &other);
+
+	private:
+		Profiler *mProfiler;
+	};
+
+}
+
+#define PROFILE_SCOPE(name) ProfilerScope _profilerScope_(name);
+
+#endif
+
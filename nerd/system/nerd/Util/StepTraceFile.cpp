@@ -0,0 +1,371 @@
+/***************************************************************************
+ *   NERD - Neurodynamics and Evolutionary Robotics Development Toolkit    *
+ *                                                                         *
+ *   University of Osnabrueck, Germany                                     *
+ *   Institute of Cognitive Science                                        *
+ *   Neurocybernetics Group                                                *
+ *   http://www.ikw.uni-osnabrueck.de/~neurokybernetik/                    *
+ *                                                                         *
+ *   Project homepage: nerd.x-bot.org                                      *
+ *                                                                         *
+ *   Copyright (C) 2008 - 2013 by the Neurocybernetics Group Osnabrück     *
+ *   Contact: Christian Rempis                                             *
+ *   christian.rempis@uni-osnabrueck.de                                    *
+ *   Contributors: see contributors.txt in the nerd main directory.        *
+ *                                                                         *
+ *                                                                         *
+ *   Acknowledgments:                                                      *
+ *   The NERD Toolkit is part of the EU project ALEAR                      *
+ *   (Artificial Language Evolution on Autonomous Robots) www.ALEAR.eu     *
+ *   This work was funded (2008 - 2011) by EU-Project Number ICT 214856    *
+ *                                                                         *
+ *                                                                         *
+ *   License Agreement:                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ *                                                                         *
+ *   Publications based on work using the NERD kit have to state this      *
+ *   clearly by citing the NERD homepage and the NERD overview paper.      *  
+ ***************************************************************************/
+
+
+
+#include "StepTraceFile.h"
+#include "Core/Core.h"
+#include <math.h>
+#include <string.h>
+
+namespace nerd {
+
+const char StepTraceFile::MAGIC[8] = {'N', 'E', 'R', 'D', 'T', 'R', 'C', 'E'};
+const quint32 StepTraceFile::VERSION = 1;
+const quint8 StepTraceFile::RECORD_CHANNELS = 'C';
+const quint8 StepTraceFile::RECORD_STEP = 'S';
+
+
+/**
+ * Constructs a new, closed StepTraceFile.
+ */
+StepTraceFile::StepTraceFile()
+	: mChannelRevision(0), mWriteMode(false), mError(false)
+{
+}
+
+
+/**
+ * Destructor. Closes the file.
+ */
+StepTraceFile::~StepTraceFile() {
+	close();
+}
+
+
+/**
+ * Creates a new trace file. An existing file is overwritten.
+ *
+ * @param fileName the name of the trace file.
+ * @return true if the file could be created.
+ */
+bool StepTraceFile::create(const QString &fileName) {
+	close();
+
+	mFile.setFileName(fileName);
+	if(!mFile.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+		Core::log("StepTraceFile: Could not create trace file [" + fileName + "]", true);
+		return false;
+	}
+	mStream.setDevice(&mFile);
+	mStream.setByteOrder(QDataStream::LittleEndian);
+	mStream.setFloatingPointPrecision(QDataStream::DoublePrecision);
+
+	mStream.writeRawData(MAGIC, sizeof(MAGIC));
+	mStream << VERSION;
+
+	mWriteMode = true;
+	return mStream.status() == QDataStream::Ok;
+}
+
+
+/**
+ * Opens an existing trace file for reading.
+ *
+ * @param fileName the name of the trace file.
+ * @return true if the file is a valid trace file.
+ */
+bool StepTraceFile::open(const QString &fileName) {
+	close();
+
+	mFile.setFileName(fileName);
+	if(!mFile.open(QIODevice::ReadOnly)) {
+		Core::log("StepTraceFile: Could not open trace file [" + fileName + "]", true);
+		return false;
+	}
+	mStream.setDevice(&mFile);
+	mStream.setByteOrder(QDataStream::LittleEndian);
+	mStream.setFloatingPointPrecision(QDataStream::DoublePrecision);
+
+	char signature[sizeof(MAGIC)];
+	quint32 version = 0;
+	if(mStream.readRawData(signature, sizeof(MAGIC)) != (int) sizeof(MAGIC)
+		|| memcmp(signature, MAGIC, sizeof(MAGIC)) != 0)
+	{
+		Core::log("StepTraceFile: File [" + fileName + "] is not a trace file.", true);
+		close();
+		return false;
+	}
+	mStream >> version;
+	if(version != VERSION) {
+		Core::log("StepTraceFile: Trace file [" + fileName + "] has unsupported version " 
+				  + QString::number(version), true);
+		close();
+		return false;
+	}
+	mWriteMode = false;
+	return true;
+}
+
+
+void StepTraceFile::close() {
+	mStream.setDevice(0);
+	mFile.close();
+	mChannels.clear();
+	mChannelRevision = 0;
+	mWriteMode = false;
+	mError = false;
+}
+
+
+bool StepTraceFile::isOpen() const {
+	return mFile.isOpen();
+}
+
+
+/**
+ * Sets the channels of the following steps. A channel record is only written if
+ * the channels differ from the current ones.
+ */
+bool StepTraceFile::setChannels(const QList<QString> &channels) {
+	if(!mWriteMode) {
+		return false;
+	}
+	if(channels == mChannels && mChannelRevision > 0) {
+		return true;
+	}
+	mChannels = channels;
+	mChannelRevision++;
+
+	mStream << RECORD_CHANNELS << (quint32) channels.size();
+	for(int i = 0; i < channels.size(); ++i) {
+		mStream << channels.at(i).toUtf8();
+	}
+	return mStream.status() == QDataStream::Ok;
+}
+
+
+/**
+ * Writes a step record. The number of values has to match the number of channels.
+ */
+bool StepTraceFile::writeStep(const StepTrace &step) {
+	if(!mWriteMode || step.mValues.size() != mChannels.size()) {
+		return false;
+	}
+	mStream << RECORD_STEP << step.mIndividual << step.mTry << step.mStep;
+	for(int i = 0; i < step.mValues.size(); ++i) {
+		mStream << step.mValues.at(i);
+	}
+	return mStream.status() == QDataStream::Ok;
+}
+
+
+/**
+ * Reads the next step record. Channel records are processed on the fly, so that 
+ * getChannels() always describes the values of the last read step.
+ *
+ * @param step the step to fill.
+ * @return false at the end of the file or if the file is corrupted (see hasError()).
+ */
+bool StepTraceFile::readStep(StepTrace &step) {
+	if(mWriteMode || !mFile.isOpen() || mError) {
+		return false;
+	}
+	while(!mStream.atEnd()) {
+		quint8 type = 0;
+		mStream >> type;
+
+		if(type == RECORD_CHANNELS) {
+			quint32 numberOfChannels = 0;
+			mStream >> numberOfChannels;
+			mChannels.clear();
+			for(quint32 i = 0; i < numberOfChannels && mStream.status() == QDataStream::Ok; ++i) {
+				QByteArray name;
+				mStream >> name;
+				mChannels.append(QString::fromUtf8(name.constData(), name.size()));
+			}
+			mChannelRevision++;
+		}
+		else if(type == RECORD_STEP) {
+			mStream >> step.mIndividual >> step.mTry >> step.mStep;
+			step.mValues.resize(mChannels.size());
+			for(int i = 0; i < mChannels.size(); ++i) {
+				mStream >> step.mValues[i];
+			}
+			if(mStream.status() != QDataStream::Ok) {
+				mError = true;
+				return false;
+			}
+			return true;
+		}
+		else {
+			mError = true;
+			return false;
+		}
+		if(mStream.status() != QDataStream::Ok) {
+			mError = true;
+			return false;
+		}
+	}
+	return false;
+}
+
+
+QList<QString> StepTraceFile::getChannels() const {
+	return mChannels;
+}
+
+
+/**
+ * Returns a counter that is incremented whenever the channels change.
+ */
+int StepTraceFile::getChannelRevision() const {
+	return mChannelRevision;
+}
+
+
+/**
+ * Returns true if a corrupted or truncated record was read.
+ */
+bool StepTraceFile::hasError() const {
+	return mError;
+}
+
+
+/**
+ * Compares two trace files step by step and reports the first difference.
+ *
+ * @param fileName1 the first trace (reference).
+ * @param fileName2 the second trace.
+ * @param tolerance the accepted absolute difference of two values. With 0.0 the 
+ *        values have to be identical (NaN equals NaN).
+ * @param report filled with a human readable description of the result.
+ * @return 0 if the traces are equivalent, 1 if they diverge, 2 if a file could 
+ *         not be read.
+ */
+int StepTraceFile::compare(const QString &fileName1, const QString &fileName2,
+						   double tolerance, QString &report)
+{
+	StepTraceFile trace1;
+	StepTraceFile trace2;
+	if(!trace1.open(fileName1) || !trace2.open(fileName2)) {
+		report = "Could not open the trace files.";
+		return 2;
+	}
+
+	StepTrace step1;
+	StepTrace step2;
+	int revision1 = 0;
+	int revision2 = 0;
+	qint64 numberOfSteps = 0;
+
+	while(true) {
+		bool ok1 = trace1.readStep(step1);
+		bool ok2 = trace2.readStep(step2);
+
+		if(trace1.hasError() || trace2.hasError()) {
+			report = QString("Trace [") + (trace1.hasError() ? fileName1 : fileName2) 
+					 + "] is corrupted after " + QString::number(numberOfSteps) + " steps.";
+			return 2;
+		}
+		if(!ok1 && !ok2) {
+			report = "Traces are equivalent (" + QString::number(numberOfSteps) + " steps).";
+			return 0;
+		}
+
+		QString position = QString("individual %1, try %2, step %3")
+				.arg(ok1 ? step1.mIndividual : step2.mIndividual)
+				.arg(ok1 ? step1.mTry : step2.mTry)
+				.arg(ok1 ? step1.mStep : step2.mStep);
+
+		if(!ok1 || !ok2) {
+			report = "Trace [" + (ok1 ? fileName2 : fileName1) + "] ends before " 
+					 + position + ".";
+			return 1;
+		}
+		if(step1.mIndividual != step2.mIndividual || step1.mTry != step2.mTry 
+			|| step1.mStep != step2.mStep) 
+		{
+			report = QString("Step sequence diverges: [%1/%2/%3] vs. [%4/%5/%6] "
+							 "(individual/try/step).")
+					.arg(step1.mIndividual).arg(step1.mTry).arg(step1.mStep)
+					.arg(step2.mIndividual).arg(step2.mTry).arg(step2.mStep);
+			return 1;
+		}
+		if(revision1 != trace1.getChannelRevision() || revision2 != trace2.getChannelRevision()) {
+			revision1 = trace1.getChannelRevision();
+			revision2 = trace2.getChannelRevision();
+
+			QList<QString> channels1 = trace1.getChannels();
+			QList<QString> channels2 = trace2.getChannels();
+			if(channels1 != channels2) {
+				int index = 0;
+				while(index < channels1.size() && index < channels2.size() 
+						&& channels1.at(index) == channels2.at(index)) 
+				{
+					index++;
+				}
+				report = "Channels diverge at " + position + ": ["
+						+ (index < channels1.size() ? channels1.at(index) : QString("<none>"))
+						+ "] vs. ["
+						+ (index < channels2.size() ? channels2.at(index) : QString("<none>"))
+						+ "].";
+				return 1;
+			}
+		}
+		for(int i = 0; i < step1.mValues.size(); ++i) {
+			double value1 = step1.mValues.at(i);
+			double value2 = step2.mValues.at(i);
+			bool equal = false;
+			if(tolerance <= 0.0) {
+				equal = value1 == value2 || (value1 != value1 && value2 != value2);
+			}
+			else {
+				equal = fabs(value1 - value2) <= tolerance
+						|| (value1 != value1 && value2 != value2);
+			}
+			if(!equal) {
+				report = "First divergence at " + position + " in channel [" 
+						+ trace1.getChannels().at(i) + "]: " 
+						+ QString::number(value1, 'g', 17) + " vs. " 
+						+ QString::number(value2, 'g', 17) + " (difference " 
+						+ QString::number(value2 - value1, 'g', 17) + ").";
+				return 1;
+			}
+		}
+		numberOfSteps++;
+	}
+}
+
+
+}
@@ -0,0 +1,120 @@
+/***************************************************************************
+ *   NERD - Neurodynamics and Evolutionary Robotics Development Toolkit    *
+ *                                                                         *
+ *   University of Osnabrueck, Germany                                     *
+ *   Institute of Cognitive Science                                        *
+ *   Neurocybernetics Group                                                *
+ *   http://www.ikw.uni-osnabrueck.de/~neurokybernetik/                    *
+ *                                                                         *
+ *   Project homepage: nerd.x-bot.org                                      *
+ *                                                                         *
+ *   Copyright (C) 2008 - 2013 by the Neurocybernetics Group Osnabrück     *
+ *   Contact: Christian Rempis                                             *
+ *   christian.rempis@uni-osnabrueck.de                                    *
+ *   Contributors: see contributors.txt in the nerd main directory.        *
+ *                                                                         *
+ *                                                                         *
+ *   Acknowledgments:                                                      *
+ *   The NERD Toolkit is part of the EU project ALEAR                      *
+ *   (Artificial Language Evolution on Autonomous Robots) www.ALEAR.eu     *
+ *   This work was funded (2008 - 2011) by EU-Project Number ICT 214856    *
+ *                                                                         *
+ *                                                                         *
+ *   License Agreement:                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ *                                                                         *
+ *   Publications based on work using the NERD kit have to state this      *
+ *   clearly by citing the NERD homepage and the NERD overview paper.      *  
+ ***************************************************************************/
+
+
+
+#ifndef NERDStepTraceFile_H
+#define NERDStepTraceFile_H
+
+#include <QString>
+#include <QList>
+#include <QVector>
+#include <QFile>
+#include <QDataStream>
+
+namespace nerd {
+
+	/**
+	 * StepTrace.
+	 * The recorded channel values of a single execution step.
+	 */
+	struct StepTrace {
+		quint32 mIndividual;
+		quint32 mTry;
+		quint32 mStep;
+		QVector<double> mValues;
+	};
+
+
+	/**
+	 * StepTraceFile.
+	 *
+	 * Binary file with per-step traces of named double channels (e.g. interface values,
+	 * neuron activations, fitness). The file starts with a signature, followed by 
+	 * records of two kinds:
+	 *
+	 * - channel record: the names of all channels of the following step records.
+	 *   It is only written when the set of channels changes.
+	 * - step record: individual, try and step number and the values of all channels.
+	 *
+	 * Values are stored without loss of precision, so two traces can be compared 
+	 * bit by bit with compare(). All numbers are stored in little endian byte order.
+	 */
+	class StepTraceFile {
+	public:
+		StepTraceFile();
+		virtual ~StepTraceFile();
+
+		bool create(const QString &fileName);
+		bool open(const QString &fileName);
+		void close();
+		bool isOpen() const;
+
+		bool setChannels(const QList<QString> &channels);
+		bool writeStep(const StepTrace &step);
+
+		bool readStep(StepTrace &step);
+		QList<QString> getChannels() const;
+		int getChannelRevision() const;
+		bool hasError() const;
+
+		static int compare(const QString &fileName1, const QString &fileName2,
+						   double tolerance, QString &report);
+
+	private:
+		static const char MAGIC[8];
+		static const quint32 VERSION;
+		static const quint8 RECORD_CHANNELS;
+		static const quint8 RECORD_STEP;
+
+		QFile mFile;
+		QDataStream mStream;
+		QList<QString> mChannels;
+		int mChannelRevision;
+		bool mWriteMode;
+		bool mError;
+	};
+
+}
+
+#endif
@@ -46,12 +46,18 @@
 #include "ChangeValueTask.h"
 #include <iostream>
 #include <QList>
+#include <QMutexLocker>
 #include "Core/Core.h"
 
 using namespace std;
 
 namespace nerd {
 
+const int ChangeValueTask::MAX_POOL_SIZE = 1024;
+QMutex ChangeValueTask::sPoolMutex;
+void *ChangeValueTask::sFreeBlocks = 0;
+int ChangeValueTask::sPoolSize = 0;
+
 
 /**
  * Constructs a new ChangeValueTask.
@@ -88,6 +94,58 @@ bool ChangeValueTask::runTask() {
 }
 
 
+/**
+ * Returns the changed Value, so that only the last pending change of a Value is executed.
+ * Values that notify at all set attempts are not coalesced, because their listeners 
+ * expect each single change.
+ */
+const void* ChangeValueTask::getCoalescingKey() const {
+	if(mValue == 0 || mValue->isNotifyingAllSetAttempts()) {
+		return 0;
+	}
+	return mValue;
+}
+
+
+/**
+ * Takes the memory for a new ChangeValueTask from the pool, if available.
+ * Memory of other sizes (subclasses) is always allocated on the heap.
+ */
+void* ChangeValueTask::operator new(size_t size) {
+	if(size == sizeof(ChangeValueTask)) {
+		QMutexLocker locker(&sPoolMutex);
+		if(sFreeBlocks != 0) {
+			void *block = sFreeBlocks;
+			sFreeBlocks = *(static_cast<void**>(block));
+			sPoolSize--;
+			return block;
+		}
+	}
+	return ::operator new(size);
+}
+
+
+/**
+ * Returns the memory of a destroyed ChangeValueTask to the pool. The first bytes of 
+ * the free block are used to link the free blocks. 
+ */
+void ChangeValueTask::operator delete(void *memory, size_t size) {
+	if(memory == 0) {
+		return;
+	}
+	if(size == sizeof(ChangeValueTask)) {
+		QMutexLocker locker(&sPoolMutex);
+		if(sPoolSize < MAX_POOL_SIZE) {
+			*(static_cast<void**>(memory)) = sFreeBlocks;
+			sFreeBlocks = memory;
+			sPoolSize++;
+			return;
+		}
+	}
+	::operator delete(memory);
+}
+
+
 }
 
 
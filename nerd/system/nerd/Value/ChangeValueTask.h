@@ -48,6 +48,7 @@
 
 #include <QString>
 #include <QHash>
+#include <QMutex>
 #include "Value/Value.h"
 #include "Core/Task.h"
 
@@ -56,6 +57,13 @@ namespace nerd {
 	/**
 	 * ChangeValueTask.
 	 *
+	 * Sets the content of a Value in the main execution thread. 
+	 * If several ChangeValueTasks for the same Value are pending, only the last one 
+	 * is executed (see Task::getCoalescingKey()). Values that notify at all set 
+	 * attempts are excluded from this.
+	 *
+	 * ChangeValueTasks are scheduled at high rates by GUI elements and recorders, 
+	 * therefore the memory of destroyed tasks is kept in a small pool and reused.
 	 */
 	class ChangeValueTask : public Task {
 	public:
@@ -64,10 +72,20 @@ namespace nerd {
 		virtual ~ChangeValueTask();
 
 		virtual bool runTask();
+		virtual const void* getCoalescingKey() const;
+
+		static void* operator new(size_t size);
+		static void operator delete(void *memory, size_t size);
+
+		static const int MAX_POOL_SIZE;
 
 	private:
 		Value *mValue;	
 		QString mNewContent;
+
+		static QMutex sPoolMutex;
+		static void *sFreeBlocks;
+		static int sPoolSize;
 	};
 
 }
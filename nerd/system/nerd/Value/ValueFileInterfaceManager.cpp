@@ -46,11 +46,13 @@
 #include "Core/Core.h"
 #include "Event/EventManager.h"
 #include <QFile>
+#include <QFileInfo>
 #include "NerdConstants.h"
 #include <QDate>
 #include <QTime>
 #include "Value/IntValue.h"
 #include "Util/FileLocker.h"
+#include "Value/ValueSnapshot.h"
 
 namespace nerd {
 
@@ -175,8 +177,11 @@ void ValueFileInterfaceManager::eventOccured(Event *event) {
 		//Save all Values of the ValueManager with the given name pattern.		
 
 		ValueManager *vm = Core::getInstance()->getValueManager();
-	
-		if(!vm->saveValues(mAutoStoreValueFile->get(), vm->getValueNamesMatchingPattern(
+
+		if(mAutoStoreValueFile->get().endsWith(ValueSnapshot::FILE_EXTENSION)) {
+			storeValueSnapshot();
+		}
+		else if(!vm->saveValues(mAutoStoreValueFile->get(), vm->getValueNamesMatchingPattern(
 						mAutoStoreValuePattern->get()), 
 						QString("Autosave ValueManager. Pattern: [")
 							.append(mAutoStoreValuePattern->get()).append("]")), 
@@ -193,6 +198,57 @@ void ValueFileInterfaceManager::eventOccured(Event *event) {
 	}
 }
 
+/**
+ * Stores the Values as binary snapshot. The first store of a run writes the complete
+ * snapshot to a base file (<file>.base.vsn), all further stores only write the 
+ * Values that differ from that base.
+ *
+ * If the snapshot file of an earlier run is still a diff against the base file, it 
+ * is replaced by a complete snapshot before the base is rewritten, so that the old
+ * diff is never applied to the new base.
+ */
+void ValueFileInterfaceManager::storeValueSnapshot() {
+	ValueManager *vm = Core::getInstance()->getValueManager();
+
+	QString fileName = mAutoStoreValueFile->get();
+	QString baseFileName = fileName.left(fileName.length() 
+				- ValueSnapshot::FILE_EXTENSION.length())
+				.append(".base").append(ValueSnapshot::FILE_EXTENSION);
+
+	QList<QString> valuesToSave = 
+			vm->getValueNamesMatchingPattern(mAutoStoreValuePattern->get());
+
+	bool ok = true;
+	if(mSnapshotBaseFileName != baseFileName) {
+		ValueSnapshot previous;
+		if(previous.open(fileName)) {
+			bool refersToBase = previous.isDiff() 
+					&& QFileInfo(previous.getBaseFileName()).absoluteFilePath() 
+						== QFileInfo(baseFileName).absoluteFilePath();
+			previous.close();
+			if(refersToBase) {
+				ok = vm->saveValueSnapshot(fileName, valuesToSave);
+			}
+		}
+	}
+	if(ok && mSnapshotBaseFileName != baseFileName) {
+		ok = vm->saveValueSnapshot(baseFileName, valuesToSave);
+		if(ok) {
+			mSnapshotBaseFileName = baseFileName;
+		}
+	}
+	if(ok) {
+		ok = vm->saveValueSnapshot(fileName, valuesToSave, baseFileName);
+	}
+	if(!ok) {
+		Core::log(QString("ValueFileInterfaceManager [")
+				.append(getName()).append("]: Could not save value snapshot [")
+				.append(fileName)
+				.append("]. [IGNORING]" ));
+	}
+}
+
+
 FileNameValue& ValueFileInterfaceManager::getTypeFileNameValue() const {
 	return *mValueTypeFileName;
 }
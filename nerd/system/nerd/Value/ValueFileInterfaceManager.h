@@ -58,6 +58,9 @@ namespace nerd {
 
 	/**
 	 * ValueFileInterfaceManager.
+	 *
+	 * If the file to store ends with ValueSnapshot::FILE_EXTENSION, the Values are 
+	 * stored as binary snapshot diffs against the first snapshot of the run.
 	 */
 	class ValueFileInterfaceManager : public virtual SystemObject, 
 					public ParameterizedObject, public virtual EventListener {
@@ -80,6 +83,7 @@ namespace nerd {
 
 	private:
 		void storeValueTypeInformation();
+		void storeValueSnapshot();
 		
 	private:
 		Event *mLoadFileTriggerEvent;
@@ -92,6 +96,7 @@ namespace nerd {
 		FileNameValue *mValueTypeFileName;
 		QString mLoadTriggerEventName;
 		QString mStoreTriggerEventName;
+		QString mSnapshotBaseFileName;
 		
 	};
 
@@ -70,8 +70,10 @@
 #include "Value/ULongLongValue.h"
 #include "NerdConstants.h"
 #include "Util/FileLocker.h"
+#include "Value/ValueSnapshot.h"
 #include <iostream>
 #include <QDir>
+#include <QSet>
 
 using namespace std;
 
@@ -424,6 +426,7 @@ QList<Value*> ValueManager::getValues() {
 /**
  * Returns a list with all Value objects that are registered with names matching
  * the given pattern. The pattern may be a full name of a regular expression (like .*test.*stuff).
+ * Each Value is contained only once, even if it is registered with several matching names.
  *
  * @param pattern the regular expression to select the Values.
  * @return a list with all matching Values.
@@ -431,29 +434,35 @@ QList<Value*> ValueManager::getValues() {
 QList<Value*> ValueManager::getValuesMatchingPattern(const QString &pattern, bool caseSensitive) {
 	QMutexLocker guard(&mMutex);
 
-	QList<Value*> values;
-	QRegExp expr(pattern);
-	if(caseSensitive) {
-		expr.setCaseSensitivity(Qt::CaseSensitive);
-	}
-	else {
-		expr.setCaseSensitivity(Qt::CaseInsensitive);
+	QString key = (caseSensitive ? "s:" : "i:") + pattern;
+	QHash<QString, QList<Value*> >::const_iterator cached = mValueQueryCache.find(key);
+	if(cached != mValueQueryCache.end()) {
+		return cached.value();
 	}
 
-	QMap<QString, Value*>::iterator index;
-	for(index = mValues.begin(); index != mValues.end(); index++) {
-		if(expr.exactMatch(index.key())) {
-			if(!values.contains(index.value())) {
-				values.append(index.value());
-			}
+	QList<Value*> values;
+	QSet<Value*> containedValues;
+	QList<QString> names = getValueNamesMatchingPattern(pattern, caseSensitive);
+	for(QListIterator<QString> i(names); i.hasNext();) {
+		Value *value = mValues.value(i.next());
+		if(!containedValues.contains(value)) {
+			containedValues.insert(value);
+			values.append(value);
 		}
 	}
+
+	if(mValueQueryCache.size() >= MAX_NUMBER_OF_CACHED_QUERIES) {
+		mValueQueryCache.clear();
+	}
+	mValueQueryCache.insert(key, values);
 	return values;
 }
 
 
 /**
  * Retuns a list with all value names matching the given regular expression.
+ * If the pattern starts with a literal prefix (like /Sim/Agent/.*), then only 
+ * names starting with that prefix are considered.
  *
  * @param pattern the regular expression to describe the desired value names.
  * @param caseSensitive if true then the regular expression is interpreted case sensitive.
@@ -462,23 +471,96 @@ QList<Value*> ValueManager::getValuesMatchingPattern(const QString &pattern, boo
 QList<QString> ValueManager::getValueNamesMatchingPattern(const QString &pattern, bool caseSensitive) {
 	QMutexLocker guard(&mMutex);
 
+	QString key = (caseSensitive ? "s:" : "i:") + pattern;
+	QHash<QString, QList<QString> >::const_iterator cached = mNameQueryCache.find(key);
+	if(cached != mNameQueryCache.end()) {
+		return cached.value();
+	}
+
 	QList<QString> values;
-	QRegExp expr(pattern);
+	QRegExp &expr = getCompiledPattern(pattern, caseSensitive);
 
-	if(!caseSensitive) {
-		expr.setCaseSensitivity(Qt::CaseInsensitive);
+	QString prefix;
+	if(caseSensitive) {
+		prefix = getLiteralPrefix(pattern);
 	}
 
-	QMap<QString, Value*>::iterator index;
-	for(index = mValues.begin(); index != mValues.end(); index++) {
+	QMap<QString, Value*>::const_iterator index;
+	for(index = mValues.lowerBound(prefix); index != mValues.end(); index++) {
+		if(!index.key().startsWith(prefix)) {
+			break;
+		}
 		if(expr.exactMatch(index.key())) {
 			values.append(index.key());
 		}
 	}
+
+	if(mNameQueryCache.size() >= MAX_NUMBER_OF_CACHED_QUERIES) {
+		mNameQueryCache.clear();
+	}
+	mNameQueryCache.insert(key, values);
 	return values;
 }
 
 
+/**
+ * Returns the part of a regular expression that has to be matched literally at the 
+ * beginning of each matching string. Patterns with alternatives (|) have no prefix.
+ *
+ * @param pattern the regular expression.
+ * @return the literal prefix of the pattern (may be empty).
+ */
+QString ValueManager::getLiteralPrefix(const QString &pattern) {
+	if(pattern.contains("|")) {
+		return "";
+	}
+	QString prefix;
+	for(int i = 0; i < pattern.size(); ++i) {
+		QChar c = pattern.at(i);
+		if(c == '*' || c == '+' || c == '?' || c == '{') {
+			//the quantifier makes the previous character optional or repeatable.
+			prefix.chop(1);
+			break;
+		}
+		if(c == '\\' || c == '.' || c == '[' || c == '(' || c == ')' 
+			|| c == '^' || c == '$' || c == ']' || c == '}') 
+		{
+			break;
+		}
+		prefix.append(c);
+	}
+	return prefix;
+}
+
+
+/**
+ * Returns the compiled regular expression for the given pattern. Compiled patterns
+ * are cached, because the same patterns are used over and over again during setup.
+ */
+QRegExp& ValueManager::getCompiledPattern(const QString &pattern, bool caseSensitive) {
+	QString key = (caseSensitive ? "s:" : "i:") + pattern;
+	QHash<QString, QRegExp>::iterator cached = mPatternCache.find(key);
+	if(cached != mPatternCache.end()) {
+		return cached.value();
+	}
+	if(mPatternCache.size() >= MAX_NUMBER_OF_CACHED_QUERIES) {
+		mPatternCache.clear();
+	}
+	QRegExp expr(pattern);
+	expr.setCaseSensitivity(caseSensitive ? Qt::CaseSensitive : Qt::CaseInsensitive);
+	return mPatternCache.insert(key, expr).value();
+}
+
+
+/**
+ * Clears all memoized query results. Called whenever the set of Values changes.
+ */
+void ValueManager::clearQueryCaches() {
+	mNameQueryCache.clear();
+	mValueQueryCache.clear();
+}
+
+
 /**
  * Returns a list with all names that are associated with the given value. As a value can be
  * registered with different names, this method can be used to determine which other names 
@@ -541,6 +623,10 @@ void ValueManager::removeAllValues() {
  * Just for debugging purposes. Is obsolete and will be removed in future releases.
  */
 void ValueManager::notifyRepositoryChangedListeners() {
+	{
+		QMutexLocker guard(&mMutex);
+		clearQueryCaches();
+	}
 	mRepositoryChangedCounter->set(mRepositoryChangedCounter->get() + 1);
 	mRepositoryChangedEvent->trigger();
 }
@@ -629,6 +715,11 @@ bool ValueManager::loadValues(const QString &fileName, bool useFileLocking) {
 		return false;
 	}
 
+	if(ValueSnapshot::isSnapshotFile(fileName)) {
+		//snapshots are replaced atomically and do not require file locking.
+		return loadValueSnapshot(fileName);
+	}
+
 	QFile file(fileName);
 
 	if(!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
@@ -700,6 +791,10 @@ bool ValueManager::loadValues(const QString &fileName, bool useFileLocking) {
  * what kind of value file this is. 
  * If there is already a file with the given name, then the new file will overwrite the existing one.
  * Errors are logged to the debug log.
+ *
+ * If the file name ends with ValueSnapshot::FILE_EXTENSION, then a binary snapshot is
+ * written instead (see saveValueSnapshot()). Snapshots do not contain the comment and
+ * are not locked, as they are replaced atomically by renaming a uniquely named temporary file.
  * 
  * @param fileName the name of the file to save the values to. 
  * @param valuesToSave a list with the names of all Values that should be saved.
@@ -713,6 +808,10 @@ bool ValueManager::saveValues(const QString &fileName,
 {
 	QMutexLocker guard(&mMutex);
 
+	if(fileName.endsWith(ValueSnapshot::FILE_EXTENSION)) {
+		return saveValueSnapshot(fileName, valuesToSave);
+	}
+
 	QFile file(fileName);
 
 	int dirIndex = fileName.lastIndexOf("/");
@@ -764,6 +863,90 @@ bool ValueManager::saveValues(const QString &fileName,
 }
 
 
+/**
+ * Loads the Values of a binary ValueSnapshot. The snapshot file is mapped into memory,
+ * so no parsing is required for Bool, Int, Double and ULongLong Values.
+ * If the snapshot is a diff, then its base snapshot is loaded first.
+ * 
+ * @param fileName the name of the snapshot file.
+ * @return true if the snapshot (and its base) could be loaded.
+ */
+bool ValueManager::loadValueSnapshot(const QString &fileName) {
+	QMutexLocker guard(&mMutex);
+
+	Core::log(QString("Loading value snapshot ").append(fileName));
+
+	if(mFileNameBuffer.contains(fileName)) {
+		//avoid infinite loops.
+		return true;
+	}
+
+	ValueSnapshot snapshot;
+	if(!snapshot.open(fileName)) {
+		return false;
+	}
+
+	mFileNameBuffer.append(fileName);
+
+	bool ok = true;
+	if(snapshot.isDiff()) {
+		ok = loadValueSnapshot(snapshot.getBaseFileName());
+	}
+
+	for(int i = 0; i < snapshot.getNumberOfEntries(); ++i) {
+		QString name = snapshot.getName(i);
+		Value *value = getValue(name);
+		if(value == 0) {
+			Core::log(QString("ValueManager::loadValueSnapshot(): Could not find value [")
+				.append(name).append("]."));
+			continue;
+		}
+		if(!snapshot.applyEntry(i, value)) {
+			Core::log(QString("ValueManager::loadValueSnapshot(): Could not load setting for "
+				"value: [").append(name).append("]."));
+		}
+	}
+
+	mFileNameBuffer.removeLast();
+
+	return ok;
+}
+
+
+/**
+ * Saves a set of Values as binary ValueSnapshot. 
+ * If a base snapshot is given, then only the Values that differ from the base 
+ * are written. Loading such a diff automatically loads the base first.
+ *
+ * @param fileName the name of the snapshot file.
+ * @param valuesToSave the names of all Values that should be saved.
+ * @param baseSnapshotFileName the snapshot to write a diff against (optional).
+ * @return true if no error occurred, otherwise false.
+ */
+bool ValueManager::saveValueSnapshot(const QString &fileName, 
+									 QList<QString> valuesToSave,
+									 const QString &baseSnapshotFileName)
+{
+	QMutexLocker guard(&mMutex);
+
+	int dirIndex = fileName.lastIndexOf("/");
+	if(dirIndex > 0) {
+		Core::getInstance()->enforceDirectoryPath(fileName.mid(0, dirIndex));
+	}
+
+	QList<QString> names;
+	QList<Value*> values;
+	for(int i = 0; i < valuesToSave.size(); ++i) {
+		Value *value = getValue(valuesToSave.at(i));
+		if(value != 0) {
+			names.append(valuesToSave.at(i));
+			values.append(value);
+		}
+	}
+	return ValueSnapshot::write(fileName, names, values, baseSnapshotFileName);
+}
+
+
 /**
  * Adds a value prototype to the ValueManager. 
  * Prototypes are required to create typed Values (like BoolValue, StringValue,...) from string 
@@ -53,6 +53,8 @@
 #include <QList>
 #include <QVector>
 #include <QString>
+#include <QHash>
+#include <QRegExp>
 
 namespace nerd {
 class Value;
@@ -64,6 +66,15 @@ class DoubleValue;
 
 /**
  * ValueManager.
+ *
+ * Pattern queries (getValuesMatchingPattern(), getValueNamesMatchingPattern()) only 
+ * scan the names starting with the literal prefix of the pattern. Compiled patterns
+ * and query results are cached until the set of registered Values changes.
+ *
+ * Values can be stored as text value files or as binary ValueSnapshots 
+ * (saveValueSnapshot(), loadValueSnapshot()). loadValues() detects snapshots 
+ * automatically and saveValues() writes a snapshot if the file name ends 
+ * with ValueSnapshot::FILE_EXTENSION.
  */
 class ValueManager {
 
@@ -106,6 +117,10 @@ class ValueManager {
 						QList<QString> valuesToSave,
 						const QString &comment, 
 						bool useFileLocking = false);
+		bool loadValueSnapshot(const QString &fileName);
+		bool saveValueSnapshot(const QString &fileName, 
+						QList<QString> valuesToSave,
+						const QString &baseSnapshotFileName = "");
 
 		bool addPrototype(Value *prototype);
 		QList<Value*> getPrototypes() const;
@@ -113,7 +128,15 @@ class ValueManager {
 
 		void printValues(const QString &valueNamePattern);
 
+		static QString getLiteralPrefix(const QString &pattern);
+
 	private:
+		QRegExp& getCompiledPattern(const QString &pattern, bool caseSensitive);
+		void clearQueryCaches();
+
+	private:
+		static const int MAX_NUMBER_OF_CACHED_QUERIES = 1024;
+
 		QMap<QString, Value*> mValues;
 		QList<Value*> mPrototypes;
 		QVector<Object*> mNotificationStack;
@@ -121,6 +144,9 @@ class ValueManager {
 		QMutex mMutex;
 		IntValue *mRepositoryChangedCounter;
 		QList<QString> mFileNameBuffer;
+		QHash<QString, QRegExp> mPatternCache;
+		QHash<QString, QList<QString> > mNameQueryCache;
+		QHash<QString, QList<Value*> > mValueQueryCache;
 };
 }
 #endif /*VALUEMANAGER_H_*/
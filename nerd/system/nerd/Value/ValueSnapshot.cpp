@@ -0,0 +1,533 @@
+/***************************************************************************
+ *   NERD - Neurodynamics and Evolutionary Robotics Development Toolkit    *
+ *                                                                         *
+ *   University of Osnabrueck, Germany                                     *
+ *   Institute of Cognitive Science                                        *
+ *   Neurocybernetics Group                                                *
+ *   http://www.ikw.uni-osnabrueck.de/~neurokybernetik/                    *
+ *                                                                         *
+ *   Project homepage: nerd.x-bot.org                                      *
+ *                                                                         *
+ *   Copyright (C) 2008 - 2013 by the Neurocybernetics Group Osnabrück     *
+ *   Contact: Christian Rempis                                             *
+ *   christian.rempis@uni-osnabrueck.de                                    *
+ *   Contributors: see contributors.txt in the nerd main directory.        *
+ *                                                                         *
+ *                                                                         *
+ *   Acknowledgments:                                                      *
+ *   The NERD Toolkit is part of the EU project ALEAR                      *
+ *   (Artificial Language Evolution on Autonomous Robots) www.ALEAR.eu     *
+ *   This work was funded (2008 - 2011) by EU-Project Number ICT 214856    *
+ *                                                                         *
+ *                                                                         *
+ *   License Agreement:                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ *                                                                         *
+ *   Publications based on work using the NERD kit have to state this      *
+ *   clearly by citing the NERD homepage and the NERD overview paper.      *  
+ ***************************************************************************/
+
+
+
+#include "ValueSnapshot.h"
+#include "Core/Core.h"
+#include "Value/Value.h"
+#include "Value/BoolValue.h"
+#include "Value/IntValue.h"
+#include "Value/DoubleValue.h"
+#include "Value/ULongLongValue.h"
+#include <QtEndian>
+#include <QFileInfo>
+#include <QDir>
+#include <QTemporaryFile>
+#include <QHash>
+#include <string.h>
+#include <stdio.h>
+
+namespace nerd {
+
+const QString ValueSnapshot::FILE_EXTENSION = ".vsn";
+const char ValueSnapshot::MAGIC[8] = {'N', 'E', 'R', 'D', 'V', 'S', 'N', 'P'};
+const quint32 ValueSnapshot::VERSION = 1;
+const quint32 ValueSnapshot::FLAG_DIFF = 1;
+const quint32 ValueSnapshot::HEADER_SIZE = 40;
+const quint32 ValueSnapshot::ENTRY_SIZE = 20;
+
+/*
+ * File layout:
+ *
+ * Header (HEADER_SIZE bytes):
+ *   0  magic (8 bytes)
+ *   8  version
+ *  12  flags (FLAG_DIFF)
+ *  16  number of entries
+ *  20  offset of the base file name (diffs only)
+ *  24  length of the base file name
+ *  28  size of the file
+ *  32  reserved (8 bytes)
+ *
+ * Entries (ENTRY_SIZE bytes each, starting at HEADER_SIZE):
+ *   0  offset of the name
+ *   4  length of the name
+ *   8  payload type
+ *  12  offset of the payload
+ *  16  length of the payload
+ *
+ * Followed by the names and payloads.
+ */
+
+
+/**
+ * Constructs a new, closed ValueSnapshot.
+ */
+ValueSnapshot::ValueSnapshot()
+	: mData(0), mSize(0), mNumberOfEntries(0), mFlags(0)
+{
+}
+
+
+/**
+ * Destructor. Unmaps the snapshot file.
+ */
+ValueSnapshot::~ValueSnapshot() {
+	close();
+}
+
+
+/**
+ * Maps a snapshot file into memory and validates its header and entry table.
+ *
+ * @param fileName the name of the snapshot file.
+ * @return true if the file is a valid snapshot.
+ */
+bool ValueSnapshot::open(const QString &fileName) {
+	close();
+
+	mFile.setFileName(fileName);
+	if(!mFile.open(QIODevice::ReadOnly)) {
+		Core::log("ValueSnapshot: Could not open file [" + fileName + "]", true);
+		return false;
+	}
+	qint64 size = mFile.size();
+	if(size < (qint64) HEADER_SIZE || size > (qint64) 0xffffffffLL) {
+		Core::log("ValueSnapshot: File [" + fileName + "] is not a value snapshot.", true);
+		close();
+		return false;
+	}
+	mData = mFile.map(0, size);
+	if(mData == 0) {
+		Core::log("ValueSnapshot: Could not map file [" + fileName + "]", true);
+		close();
+		return false;
+	}
+	mSize = (quint32) size;
+
+	if(memcmp(mData, MAGIC, sizeof(MAGIC)) != 0 
+		|| readUInt32(8) != VERSION 
+		|| readUInt32(28) != mSize) 
+	{
+		Core::log("ValueSnapshot: File [" + fileName + "] is not a valid value snapshot "
+				  "or was written by an incompatible version.", true);
+		close();
+		return false;
+	}
+	mFlags = readUInt32(12);
+	mNumberOfEntries = readUInt32(16);
+
+	//validate all offsets once, so that the accessors can rely on them.
+	bool valid = (quint64) HEADER_SIZE + (quint64) mNumberOfEntries * ENTRY_SIZE <= mSize;
+	for(quint32 i = 0; valid && i < mNumberOfEntries; ++i) {
+		quint32 entry = HEADER_SIZE + i * ENTRY_SIZE;
+		valid = (quint64) readUInt32(entry) + readUInt32(entry + 4) <= mSize
+				&& (quint64) readUInt32(entry + 12) + readUInt32(entry + 16) <= mSize;
+	}
+	if(valid && (mFlags & FLAG_DIFF) != 0) {
+		quint32 offset = readUInt32(20);
+		quint32 length = readUInt32(24);
+		valid = (quint64) offset + length <= mSize;
+		if(valid) {
+			mBaseFileName = QString::fromUtf8((const char*) mData + offset, length);
+			if(QFileInfo(mBaseFileName).isRelative()) {
+				mBaseFileName = QFileInfo(fileName).dir().filePath(mBaseFileName);
+			}
+		}
+	}
+	if(!valid) {
+		Core::log("ValueSnapshot: File [" + fileName + "] is corrupted.", true);
+		close();
+		return false;
+	}
+	return true;
+}
+
+
+/**
+ * Unmaps and closes the snapshot file.
+ */
+void ValueSnapshot::close() {
+	if(mData != 0) {
+		mFile.unmap(const_cast<uchar*>(mData));
+		mData = 0;
+	}
+	mFile.close();
+	mSize = 0;
+	mNumberOfEntries = 0;
+	mFlags = 0;
+	mBaseFileName = "";
+}
+
+
+bool ValueSnapshot::isOpen() const {
+	return mData != 0;
+}
+
+
+/**
+ * Returns true if the snapshot only contains the differences to a base snapshot.
+ */
+bool ValueSnapshot::isDiff() const {
+	return (mFlags & FLAG_DIFF) != 0;
+}
+
+
+/**
+ * Returns the file name of the base snapshot of a diff. Relative names are 
+ * resolved against the directory of the diff.
+ */
+QString ValueSnapshot::getBaseFileName() const {
+	return mBaseFileName;
+}
+
+
+int ValueSnapshot::getNumberOfEntries() const {
+	return (int) mNumberOfEntries;
+}
+
+
+QString ValueSnapshot::getName(int index) const {
+	const uchar *entry = getEntry(index);
+	if(entry == 0) {
+		return "";
+	}
+	return QString::fromUtf8((const char*) mData + qFromLittleEndian<quint32>(entry), 
+							 qFromLittleEndian<quint32>(entry + 4));
+}
+
+
+ValueSnapshot::PayloadType ValueSnapshot::getPayloadType(int index) const {
+	const uchar *entry = getEntry(index);
+	if(entry == 0) {
+		return TYPE_STRING;
+	}
+	return (PayloadType) qFromLittleEndian<quint32>(entry + 8);
+}
+
+
+/**
+ * Returns a copy of the raw payload of an entry.
+ */
+QByteArray ValueSnapshot::getPayload(int index) const {
+	const uchar *entry = getEntry(index);
+	if(entry == 0) {
+		return QByteArray();
+	}
+	return QByteArray((const char*) mData + qFromLittleEndian<quint32>(entry + 12), 
+					  qFromLittleEndian<quint32>(entry + 16));
+}
+
+
+/**
+ * Sets the content of a Value from an entry. Binary payloads are set directly if the 
+ * Value has the matching type, otherwise they are converted to a string and set 
+ * with Value::setValueFromString().
+ *
+ * @param index the index of the entry.
+ * @param value the Value to change.
+ * @return true if the content could be set.
+ */
+bool ValueSnapshot::applyEntry(int index, Value *value) const {
+	const uchar *entry = getEntry(index);
+	if(entry == 0 || value == 0) {
+		return false;
+	}
+	quint32 type = qFromLittleEndian<quint32>(entry + 8);
+	const uchar *payload = mData + qFromLittleEndian<quint32>(entry + 12);
+	quint32 length = qFromLittleEndian<quint32>(entry + 16);
+
+	switch(type) {
+		case TYPE_BOOL:
+		{
+			if(length != 1) {
+				return false;
+			}
+			bool content = payload[0] != 0;
+			BoolValue *boolValue = dynamic_cast<BoolValue*>(value);
+			if(boolValue != 0) {
+				boolValue->set(content);
+				return true;
+			}
+			return value->setValueFromString(content ? "true" : "false");
+		}
+		case TYPE_INT:
+		{
+			if(length != 4) {
+				return false;
+			}
+			int content = (int) qFromLittleEndian<qint32>(payload);
+			IntValue *intValue = dynamic_cast<IntValue*>(value);
+			if(intValue != 0) {
+				intValue->set(content);
+				return true;
+			}
+			return value->setValueFromString(QString::number(content));
+		}
+		case TYPE_DOUBLE:
+		{
+			if(length != 8) {
+				return false;
+			}
+			quint64 bits = qFromLittleEndian<quint64>(payload);
+			double content = 0.0;
+			memcpy(&content, &bits, sizeof(double));
+			DoubleValue *doubleValue = dynamic_cast<DoubleValue*>(value);
+			if(doubleValue != 0) {
+				doubleValue->set(content);
+				return true;
+			}
+			return value->setValueFromString(QString::number(content, 'g', 17));
+		}
+		case TYPE_ULONGLONG:
+		{
+			if(length != 8) {
+				return false;
+			}
+			qulonglong content = qFromLittleEndian<quint64>(payload);
+			ULongLongValue *ulongValue = dynamic_cast<ULongLongValue*>(value);
+			if(ulongValue != 0) {
+				ulongValue->set(content);
+				return true;
+			}
+			return value->setValueFromString(QString::number(content));
+		}
+		case TYPE_STRING:
+			return value->setValueFromString(QString::fromUtf8((const char*) payload, length));
+		default:
+			return false;
+	}
+}
+
+
+/**
+ * Checks whether a file starts with the snapshot file signature.
+ */
+bool ValueSnapshot::isSnapshotFile(const QString &fileName) {
+	QFile file(fileName);
+	if(!file.open(QIODevice::ReadOnly)) {
+		return false;
+	}
+	char signature[sizeof(MAGIC)];
+	bool isSnapshot = file.read(signature, sizeof(MAGIC)) == (qint64) sizeof(MAGIC)
+						&& memcmp(signature, MAGIC, sizeof(MAGIC)) == 0;
+	file.close();
+	return isSnapshot;
+}
+
+
+/**
+ * Creates the payload of a Value. 
+ *
+ * @param value the Value to encode.
+ * @param payload the array to fill with the payload.
+ * @return the type of the payload.
+ */
+ValueSnapshot::PayloadType ValueSnapshot::createPayload(Value *value, QByteArray &payload) {
+	if(dynamic_cast<BoolValue*>(value) != 0) {
+		payload.resize(1);
+		payload[0] = dynamic_cast<BoolValue*>(value)->get() ? 1 : 0;
+		return TYPE_BOOL;
+	}
+	if(dynamic_cast<IntValue*>(value) != 0) {
+		payload.resize(4);
+		qToLittleEndian<qint32>(dynamic_cast<IntValue*>(value)->get(), (uchar*) payload.data());
+		return TYPE_INT;
+	}
+	if(dynamic_cast<DoubleValue*>(value) != 0) {
+		double content = dynamic_cast<DoubleValue*>(value)->get();
+		quint64 bits = 0;
+		memcpy(&bits, &content, sizeof(double));
+		payload.resize(8);
+		qToLittleEndian<quint64>(bits, (uchar*) payload.data());
+		return TYPE_DOUBLE;
+	}
+	if(dynamic_cast<ULongLongValue*>(value) != 0) {
+		payload.resize(8);
+		qToLittleEndian<quint64>(dynamic_cast<ULongLongValue*>(value)->get(), 
+								 (uchar*) payload.data());
+		return TYPE_ULONGLONG;
+	}
+	payload = value->getValueAsString().toUtf8();
+	return TYPE_STRING;
+}
+
+
+/**
+ * Writes a snapshot file. 
+ *
+ * If a base file is given, only the Values that are not contained in the base snapshot
+ * or whose payload differs are written. The base has to be a complete snapshot, if 
+ * it is a diff itself, a complete snapshot is written instead.
+ *
+ * @param fileName the name of the snapshot file.
+ * @param names the names of the Values.
+ * @param values the Values to store (same order as names).
+ * @param baseFileName the snapshot to create a diff against (optional).
+ * @return true if successful.
+ */
+bool ValueSnapshot::write(const QString &fileName, const QList<QString> &names, 
+						  const QList<Value*> &values, const QString &baseFileName) 
+{
+	if(names.size() != values.size()) {
+		return false;
+	}
+
+	ValueSnapshot base;
+	QHash<QString, int> baseEntries;
+	if(baseFileName != "") {
+		if(base.open(baseFileName) && !base.isDiff()) {
+			for(int i = 0; i < base.getNumberOfEntries(); ++i) {
+				baseEntries.insert(base.getName(i), i);
+			}
+		}
+		else {
+			Core::log("ValueSnapshot: Could not use [" + baseFileName 
+					  + "] as base snapshot. Writing a complete snapshot.", true);
+			base.close();
+		}
+	}
+
+	QByteArray entries;
+	QByteArray data;
+	quint32 numberOfEntries = 0;
+	QByteArray payload;
+
+	for(int i = 0; i < names.size(); ++i) {
+		Value *value = values.at(i);
+		if(value == 0) {
+			continue;
+		}
+		PayloadType type = createPayload(value, payload);
+
+		if(base.isOpen()) {
+			int baseIndex = baseEntries.value(names.at(i), -1);
+			if(baseIndex >= 0 && base.getPayloadType(baseIndex) == type 
+				&& base.getPayload(baseIndex) == payload) 
+			{
+				continue;
+			}
+		}
+		QByteArray name = names.at(i).toUtf8();
+
+		uchar entry[20];
+		qToLittleEndian<quint32>(data.size(), entry);
+		qToLittleEndian<quint32>(name.size(), entry + 4);
+		qToLittleEndian<quint32>(type, entry + 8);
+		qToLittleEndian<quint32>(data.size() + name.size(), entry + 12);
+		qToLittleEndian<quint32>(payload.size(), entry + 16);
+		entries.append((const char*) entry, ENTRY_SIZE);
+		data.append(name);
+		data.append(payload);
+		numberOfEntries++;
+	}
+
+	QByteArray baseName;
+	if(base.isOpen()) {
+		baseName = QFileInfo(fileName).absoluteDir().relativeFilePath(
+						QFileInfo(baseFileName).absoluteFilePath()).toUtf8();
+	}
+
+	quint32 dataOffset = HEADER_SIZE + entries.size();
+	quint32 fileSize = dataOffset + data.size() + baseName.size();
+
+	//make all offsets absolute.
+	for(quint32 i = 0; i < numberOfEntries; ++i) {
+		uchar *entry = (uchar*) entries.data() + i * ENTRY_SIZE;
+		qToLittleEndian<quint32>(qFromLittleEndian<quint32>(entry) + dataOffset, entry);
+		qToLittleEndian<quint32>(qFromLittleEndian<quint32>(entry + 12) + dataOffset, 
+								 entry + 12);
+	}
+
+	uchar header[40];
+	memset(header, 0, HEADER_SIZE);
+	memcpy(header, MAGIC, sizeof(MAGIC));
+	qToLittleEndian<quint32>(VERSION, header + 8);
+	qToLittleEndian<quint32>(base.isOpen() ? FLAG_DIFF : 0, header + 12);
+	qToLittleEndian<quint32>(numberOfEntries, header + 16);
+	qToLittleEndian<quint32>(dataOffset + data.size(), header + 20);
+	qToLittleEndian<quint32>(baseName.size(), header + 24);
+	qToLittleEndian<quint32>(fileSize, header + 28);
+
+	base.close();
+
+	//write to a temporary file and replace the snapshot atomically. The temporary file 
+	//has a unique name in the same directory, so that concurrent writers of the same 
+	//snapshot do not truncate each other's file and the rename stays on one file system.
+	QTemporaryFile file(fileName + ".XXXXXX");
+	file.setAutoRemove(false);
+	if(!file.open()) {
+		Core::log("ValueSnapshot: Could not create a temporary file for [" + fileName 
+				  + "] to write the snapshot.", true);
+		return false;
+	}
+	QString temporaryFileName = file.fileName();
+	bool ok = file.write((const char*) header, HEADER_SIZE) == (qint64) HEADER_SIZE
+				&& file.write(entries) == entries.size()
+				&& file.write(data) == data.size()
+				&& file.write(baseName) == baseName.size();
+	file.close();
+	//temporary files are only accessible by the owner.
+	file.setPermissions(QFile::ReadOwner | QFile::WriteOwner 
+						| QFile::ReadGroup | QFile::ReadOther);
+
+	if(ok && rename(QFile::encodeName(temporaryFileName).constData(), 
+					QFile::encodeName(fileName).constData()) != 0) 
+	{
+		//some platforms do not replace existing files.
+		QFile::remove(fileName);
+		ok = QFile::rename(temporaryFileName, fileName);
+	}
+	if(!ok) {
+		Core::log("ValueSnapshot: Could not write snapshot [" + fileName + "]", true);
+		QFile::remove(temporaryFileName);
+	}
+	return ok;
+}
+
+
+quint32 ValueSnapshot::readUInt32(quint32 offset) const {
+	return qFromLittleEndian<quint32>(mData + offset);
+}
+
+
+const uchar* ValueSnapshot::getEntry(int index) const {
+	if(mData == 0 || index < 0 || (quint32) index >= mNumberOfEntries) {
+		return 0;
+	}
+	return mData + HEADER_SIZE + index * ENTRY_SIZE;
+}
+
+
+}
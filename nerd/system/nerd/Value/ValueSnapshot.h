@@ -0,0 +1,128 @@
+/***************************************************************************
+ *   NERD - Neurodynamics and Evolutionary Robotics Development Toolkit    *
+ *                                                                         *
+ *   University of Osnabrueck, Germany                                     *
+ *   Institute of Cognitive Science                                        *
+ *   Neurocybernetics Group                                                *
+ *   http://www.ikw.uni-osnabrueck.de/~neurokybernetik/                    *
+ *                                                                         *
+ *   Project homepage: nerd.x-bot.org                                      *
+ *                                                                         *
+ *   Copyright (C) 2008 - 2013 by the Neurocybernetics Group Osnabrück     *
+ *   Contact: Christian Rempis                                             *
+ *   christian.rempis@uni-osnabrueck.de                                    *
+ *   Contributors: see contributors.txt in the nerd main directory.        *
+ *                                                                         *
+ *                                                                         *
+ *   Acknowledgments:                                                      *
+ *   The NERD Toolkit is part of the EU project ALEAR                      *
+ *   (Artificial Language Evolution on Autonomous Robots) www.ALEAR.eu     *
+ *   This work was funded (2008 - 2011) by EU-Project Number ICT 214856    *
+ *                                                                         *
+ *                                                                         *
+ *   License Agreement:                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ *                                                                         *
+ *   Publications based on work using the NERD kit have to state this      *
+ *   clearly by citing the NERD homepage and the NERD overview paper.      *  
+ ***************************************************************************/
+
+
+
+#ifndef NERDValueSnapshot_H
+#define NERDValueSnapshot_H
+
+#include <QString>
+#include <QList>
+#include <QFile>
+#include <QByteArray>
+
+namespace nerd {
+
+	class Value;
+
+	/**
+	 * ValueSnapshot.
+	 *
+	 * Binary counterpart of the text value files used by ValueManager::loadValues() and
+	 * ValueManager::saveValues(). A snapshot file contains a table with one entry per 
+	 * Value (name, type, payload location) followed by the UTF-8 names and the typed 
+	 * payloads. Bool, Int, Double and ULongLong Values are stored binary, all other
+	 * Values with their string representation.
+	 *
+	 * Snapshots are read through a memory mapping of the file, so many processes can 
+	 * share a single snapshot without parsing it. Files are written to a temporary 
+	 * file and renamed afterwards, so readers never see incomplete snapshots and 
+	 * no file locking is required.
+	 *
+	 * A snapshot can be a diff against a base snapshot. Then it only contains the 
+	 * Values whose payload differs from the base and references the base file, which
+	 * is loaded first when the diff is applied.
+	 *
+	 * All numbers are stored in little endian byte order.
+	 */
+	class ValueSnapshot {
+	public:
+		enum PayloadType {TYPE_STRING = 0, TYPE_BOOL = 1, TYPE_INT = 2, TYPE_DOUBLE = 3, 
+						  TYPE_ULONGLONG = 4};
+
+	public:
+		ValueSnapshot();
+		virtual ~ValueSnapshot();
+
+		bool open(const QString &fileName);
+		void close();
+		bool isOpen() const;
+
+		bool isDiff() const;
+		QString getBaseFileName() const;
+
+		int getNumberOfEntries() const;
+		QString getName(int index) const;
+		PayloadType getPayloadType(int index) const;
+		QByteArray getPayload(int index) const;
+		bool applyEntry(int index, Value *value) const;
+
+		static bool isSnapshotFile(const QString &fileName);
+		static PayloadType createPayload(Value *value, QByteArray &payload);
+		static bool write(const QString &fileName, const QList<QString> &names, 
+						  const QList<Value*> &values, const QString &baseFileName = "");
+
+		static const QString FILE_EXTENSION;
+
+	private:
+		quint32 readUInt32(quint32 offset) const;
+		const uchar* getEntry(int index) const;
+
+	private:
+		static const char MAGIC[8];
+		static const quint32 VERSION;
+		static const quint32 FLAG_DIFF;
+		static const quint32 HEADER_SIZE;
+		static const quint32 ENTRY_SIZE;
+
+		QFile mFile;
+		const uchar *mData;
+		quint32 mSize;
+		quint32 mNumberOfEntries;
+		quint32 mFlags;
+		QString mBaseFileName;
+	};
+
+}
+
+#endif
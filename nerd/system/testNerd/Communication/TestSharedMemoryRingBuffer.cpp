@@ -0,0 +1,167 @@
+/***************************************************************************
+ *   NERD - Neurodynamics and Evolutionary Robotics Development Toolkit    *
+ *                                                                         *
+ *   University of Osnabrueck, Germany                                     *
+ *   Institute of Cognitive Science                                        *
+ *   Neurocybernetics Group                                                *
+ *   http://www.ikw.uni-osnabrueck.de/~neurokybernetik/                    *
+ *                                                                         *
+ *   Project homepage: nerd.x-bot.org                                      *
+ *                                                                         *
+ *   Copyright (C) 2008 - 2013 by the Neurocybernetics Group Osnabrück     *
+ *   Contact: Christian Rempis                                             *
+ *   christian.rempis@uni-osnabrueck.de                                    *
+ *   Contributors: see contributors.txt in the nerd main directory.        *
+ *                                                                         *
+ *                                                                         *
+ *   Acknowledgments:                                                      *
+ *   The NERD Toolkit is part of the EU project ALEAR                      *
+ *   (Artificial Language Evolution on Autonomous Robots) www.ALEAR.eu     *
+ *   This work was funded (2008 - 2011) by EU-Project Number ICT 214856    *
+ *                                                                         *
+ *                                                                         *
+ *   License Agreement:                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ *                                                                         *
+ *   Publications based on work using the NERD kit have to state this      *
+ *   clearly by citing the NERD homepage and the NERD overview paper.      *  
+ ***************************************************************************/
+
+
+
+#include "TestSharedMemoryRingBuffer.h"
+#include "Core/Core.h"
+#include <QThread>
+#include <QCoreApplication>
+#include "Communication/SharedMemoryRingBuffer.h"
+
+namespace nerd {
+
+/**
+ * Writes numbered messages of varying size to a SharedMemoryRingBuffer.
+ */
+class RingBufferProducer : public QThread {
+public:
+	RingBufferProducer(SharedMemoryRingBuffer *buffer, int numberOfMessages)
+		: mBuffer(buffer), mNumberOfMessages(numberOfMessages), mOk(true) {}
+
+	static QByteArray createMessage(int index) {
+		return QByteArray((index * 37) % 500 + 1, (char) ('a' + (index % 26)));
+	}
+
+	SharedMemoryRingBuffer *mBuffer;
+	int mNumberOfMessages;
+	bool mOk;
+
+protected:
+	virtual void run() {
+		for(int i = 0; i < mNumberOfMessages && mOk; ++i) {
+			mOk = mBuffer->write(createMessage(i), 5000);
+		}
+	}
+};
+
+
+static QString getBufferName() {
+	return QString("/nerd_test_ringbuffer_%1").arg(QCoreApplication::applicationPid());
+}
+
+
+void TestSharedMemoryRingBuffer::testRoundTripWithWrapAround() {
+#ifdef linux
+	Core::resetCore();
+
+	SharedMemoryRingBuffer producer;
+	SharedMemoryRingBuffer consumer;
+	QVERIFY(producer.create(getBufferName(), 1000, SharedMemoryRingBuffer::PRODUCER));
+	QVERIFY(consumer.attach(getBufferName(), SharedMemoryRingBuffer::CONSUMER));
+
+	//roles are enforced.
+	QByteArray message;
+	QVERIFY(!producer.read(message, 0));
+	QVERIFY(!consumer.write("x", 0));
+
+	//empty buffer: read times out.
+	QVERIFY(!consumer.hasPendingMessages());
+	QVERIFY(!consumer.read(message, 10));
+
+	//messages of 300 bytes (+4 length bytes) in a buffer of 1024 bytes wrap around
+	//at different positions, including the length prefix.
+	for(int i = 0; i < 50; ++i) {
+		QByteArray first(300, (char) i);
+		QByteArray second(301 + i, (char) (i + 1));
+		QVERIFY(producer.write(first, 0));
+		QVERIFY(producer.write(second, 0));
+		QVERIFY(consumer.hasPendingMessages());
+		QVERIFY(consumer.read(message, 0));
+		QVERIFY(message == first);
+		QVERIFY(consumer.read(message, 0));
+		QVERIFY(message == second);
+		QVERIFY(!consumer.hasPendingMessages());
+	}
+
+	//full buffer: write times out, messages larger than the capacity are rejected.
+	QVERIFY(producer.write(QByteArray(600, 'a'), 0));
+	QVERIFY(!producer.write(QByteArray(600, 'b'), 10));
+	QVERIFY(!producer.write(QByteArray(2000, 'c'), 0));
+
+	//the consumer closes: the producer can not write any more.
+	consumer.close();
+	QVERIFY(producer.isClosed());
+	QVERIFY(!producer.write("x", 0));
+
+	consumer.detach();
+	producer.detach();
+
+	//the segment was removed by its owner.
+	QVERIFY(!consumer.attach(getBufferName(), SharedMemoryRingBuffer::CONSUMER));
+
+	Core::resetCore();
+#endif
+}
+
+
+void TestSharedMemoryRingBuffer::testProducerConsumerThreads() {
+#ifdef linux
+	Core::resetCore();
+
+	SharedMemoryRingBuffer producerBuffer;
+	SharedMemoryRingBuffer consumerBuffer;
+	QVERIFY(producerBuffer.create(getBufferName(), 2048, SharedMemoryRingBuffer::PRODUCER));
+	QVERIFY(consumerBuffer.attach(getBufferName(), SharedMemoryRingBuffer::CONSUMER));
+
+	//the producer has to wait for free space many times.
+	RingBufferProducer producer(&producerBuffer, 2000);
+	producer.start();
+
+	QByteArray message;
+	for(int i = 0; i < 2000; ++i) {
+		QVERIFY(consumerBuffer.read(message, 5000));
+		QVERIFY(message == RingBufferProducer::createMessage(i));
+	}
+	QVERIFY(producer.wait(5000));
+	QVERIFY(producer.mOk);
+
+	//the producer closes: a waiting consumer wakes up and fails.
+	producerBuffer.close();
+	QVERIFY(!consumerBuffer.read(message, 1000));
+
+	Core::resetCore();
+#endif
+}
+
+}
@@ -47,6 +47,8 @@
 #define NERDTaskAdapter_H
 
 #include "Core/Task.h"
+#include "Value/Value.h"
+#include <QString>
 
 namespace nerd {
 
@@ -55,8 +57,10 @@ namespace nerd {
 	 */
 	class TaskAdapter : public virtual Task {
 	public:
-		TaskAdapter(bool *destroyFlag, int *countRuns) : mDestroyFlag(destroyFlag),
-		 				mCountRuns(countRuns) 
+		TaskAdapter(bool *destroyFlag, int *countRuns, Value *observedValue = 0, 
+						QString *observedContent = 0) 
+			: mDestroyFlag(destroyFlag), mCountRuns(countRuns), 
+			  mObservedValue(observedValue), mObservedContent(observedContent)
 		{
 		}
 		
@@ -70,12 +74,17 @@ namespace nerd {
 			if(mCountRuns != 0) {
 				(*mCountRuns)++;
 			}
+			if(mObservedValue != 0 && mObservedContent != 0) {
+				*mObservedContent = mObservedValue->getValueAsString();
+			}
 			return true;
 		}
 
 	private:		
 		bool *mDestroyFlag;
 		int *mCountRuns;
+		Value *mObservedValue;
+		QString *mObservedContent;
 	};
 
 }
@@ -50,6 +50,14 @@
 #include <QString>
 #include "Event/EventListenerAdapter.h"
 #include "Core/TaskAdapter.h"
+#include "Util/Profiler.h"
+#include "Core/LogWriter.h"
+#include "Value/StringValue.h"
+#include "Value/BoolValue.h"
+#include "Value/ValueManager.h"
+#include "NerdConstants.h"
+#include "Value/ChangeValueTask.h"
+#include "Value/MyChangedListener.h"
 
 namespace nerd{
 
@@ -347,4 +355,213 @@ void TestCore::testTaskScheduling() {
 }
 
 
+void TestCore::testTaskCoalescing() {
+	Core::resetCore();
+	Core *cInstance = Core::getInstance();
+
+	IntValue *value1 = new IntValue(0);
+	IntValue *value2 = new IntValue(0);
+	MyChangedListener listener1;
+	MyChangedListener listener2;
+	value1->addValueChangedListener(&listener1);
+	value2->addValueChangedListener(&listener2);
+
+	bool destroyFlag = false;
+	int countRuns = 0;
+	QString seenContent;
+
+	QVERIFY(cInstance->hasPendingTasks() == false);
+
+	QVERIFY(cInstance->scheduleTask(new ChangeValueTask(value1, "1")));
+	QVERIFY(cInstance->hasPendingTasks() == true);
+	QVERIFY(cInstance->scheduleTask(new ChangeValueTask(value2, "5")));
+	QVERIFY(cInstance->scheduleTask(new ChangeValueTask(value1, "2")));
+	QVERIFY(cInstance->scheduleTask(new TaskAdapter(&destroyFlag, &countRuns, 
+						value1, &seenContent)));
+	QVERIFY(cInstance->scheduleTask(new ChangeValueTask(value1, "3")));
+	QCOMPARE(cInstance->getPendingTasks().size(), 5);
+
+	//the changes of value1 before the TaskAdapter are coalesced to "2", so the 
+	//TaskAdapter sees the same value as without coalescing. All tasks are destroyed.
+	cInstance->executePendingTasks();
+	QVERIFY(cInstance->hasPendingTasks() == false);
+	QCOMPARE(cInstance->getPendingTasks().size(), 0);
+	QCOMPARE(seenContent, QString("2"));
+	QCOMPARE(value1->get(), 3);
+	QCOMPARE(value2->get(), 5);
+	QCOMPARE(listener1.getCount(), 2);
+	QCOMPARE(listener2.getCount(), 1);
+	QCOMPARE(countRuns, 1);
+	QCOMPARE(destroyFlag, true);
+
+	//the last change is executed at the position of the first one.
+	QVERIFY(cInstance->scheduleTask(new ChangeValueTask(value1, "4")));
+	QVERIFY(cInstance->scheduleTask(new ChangeValueTask(value2, "6")));
+	QVERIFY(cInstance->scheduleTask(new ChangeValueTask(value1, "5")));
+	cInstance->executePendingTasks();
+	QCOMPARE(value1->get(), 5);
+	QCOMPARE(value2->get(), 6);
+	QCOMPARE(listener1.getCount(), 3);
+	QCOMPARE(listener2.getCount(), 2);
+
+	//tasks of a later call are not coalesced with executed ones.
+	QVERIFY(cInstance->scheduleTask(new ChangeValueTask(value1, "6")));
+	cInstance->executePendingTasks();
+	QCOMPARE(value1->get(), 6);
+	QCOMPARE(listener1.getCount(), 4);
+
+	//values that notify at all set attempts are never coalesced.
+	IntValue *value3 = new IntValue(0);
+	value3->setNotifyAllSetAttempts(true);
+	MyChangedListener listener3;
+	value3->addValueChangedListener(&listener3);
+	QVERIFY(cInstance->scheduleTask(new ChangeValueTask(value3, "7")));
+	QVERIFY(cInstance->scheduleTask(new ChangeValueTask(value3, "7")));
+	QVERIFY(cInstance->scheduleTask(new ChangeValueTask(value3, "8")));
+	cInstance->executePendingTasks();
+	QCOMPARE(value3->get(), 8);
+	QCOMPARE(listener3.getCount(), 3);
+
+	delete value1;
+	delete value2;
+	delete value3;
+	Core::resetCore();
+}
+
+
+void TestCore::testProfiler() {
+	Core::resetCore();
+	Core *cInstance = Core::getInstance();
+
+	Profiler *profiler = cInstance->getProfiler();
+	QVERIFY(profiler != 0);
+
+	BoolValue *enable = dynamic_cast<BoolValue*>(cInstance->getValueManager()->getValue(
+				NerdConstants::VALUE_NERD_ENABLE_PERFORMANCE_MEASUREMENTS));
+	QVERIFY(enable != 0);
+
+	//disabled: nothing is recorded.
+	enable->set(false);
+	QVERIFY(profiler->isEnabled() == false);
+	{
+		PROFILE_SCOPE("Outer");
+	}
+	QVERIFY(!profiler->createReport().contains("Outer"));
+
+	//enabled: nested scopes are aggregated per call path.
+	enable->set(true);
+	QVERIFY(profiler->isEnabled());
+	for(int i = 0; i < 3; ++i) {
+		PROFILE_SCOPE("Outer");
+		{
+			ProfilerScope scope(QString("Inner"));
+			QTest::qSleep(1);
+		}
+	}
+	{
+		PROFILE_SCOPE("Inner");
+	}
+
+	QString report = profiler->createReport();
+	QVERIFY(report.contains("  Outer  calls: 3"));
+	QVERIFY(report.contains("    Inner  calls: 3"));
+	QVERIFY(report.contains("  Inner  calls: 1"));
+
+	QString stacks = profiler->createFoldedStacks();
+	QVERIFY(stacks.contains("Thread0;Outer;Inner "));
+
+	QString trace = profiler->createChromeTrace();
+	QVERIFY(trace.startsWith("{\"displayTimeUnit\":\"ns\",\"traceEvents\":["));
+	QCOMPARE(trace.count("\"name\":\"Outer\""), 3);
+	QCOMPARE(trace.count("\"name\":\"Inner\""), 4);
+
+	//scopes named after types use the demangled type name.
+	profiler->enter(typeid(QString));
+	profiler->leave();
+	QVERIFY(profiler->createReport().contains("  QString  calls: 1"));
+	QCOMPARE(Profiler::getTypeName(typeid(Profiler)), QString("nerd::Profiler"));
+
+	//prefixed scope names are assembled only when the profiler is enabled.
+	{
+		ProfilerScope scope("Bind ", QString("Object"));
+	}
+	QVERIFY(profiler->createReport().contains("  Bind Object  calls: 1"));
+
+	//unmatched leave() is ignored.
+	profiler->leave();
+
+	//clear() resets the measurements.
+	profiler->clear();
+	QVERIFY(profiler->createReport().contains("  Outer  calls: 0"));
+	QCOMPARE(profiler->createChromeTrace().count("\"name\""), 0);
+
+	enable->set(false);
+	Core::resetCore();
+}
+
+
+void TestCore::testLogWriter() {
+	Core::resetCore();
+
+	QString output;
+	QTextStream stream(&output);
+	StringValue recentMessage("");
+
+	LogWriter *writer = new LogWriter(&stream);
+	writer->setRecentMessageValue(&recentMessage);
+	//the thread is not started, so that stop() writes all messages deterministically.
+
+	//the recent message is updated immediately within the burst.
+	writer->addMessage("First", Core::LOG_INFO);
+	QCOMPARE(recentMessage.get(), QString("First"));
+
+	//identical consecutive messages are collapsed.
+	writer->addMessage("Repeated", Core::LOG_WARNING);
+	writer->addMessage("Repeated", Core::LOG_WARNING);
+	writer->addMessage("Repeated", Core::LOG_WARNING);
+	writer->addMessage("~Highlighted", Core::LOG_INFO);
+
+	//exceed the burst: the value is updated with the last message at the latest by stop().
+	for(int i = 0; i < LogWriter::RECENT_MESSAGE_BURST + 10; ++i) {
+		writer->addMessage("Message " + QString::number(i), Core::LOG_INFO);
+	}
+	writer->stop();
+
+	QCOMPARE(recentMessage.get(), 
+			 QString("Message ") + QString::number(LogWriter::RECENT_MESSAGE_BURST + 9));
+
+	QStringList lines = output.split("\n");
+	QVERIFY(lines.at(0).endsWith(" : First"));
+	QVERIFY(lines.at(1).endsWith(" : [Warning] Repeated"));
+	QVERIFY(lines.at(2).endsWith(" : Last message repeated 2 times"));
+	QCOMPARE(lines.at(3), QString(""));
+	QVERIFY(lines.at(4).endsWith(" : Highlighted"));
+	QCOMPARE(output.count("Message "), LogWriter::RECENT_MESSAGE_BURST + 10);
+
+	//messages after stop() are written when the writer is destroyed.
+	writer->addMessage("Last", Core::LOG_ERROR);
+	delete writer;
+	QVERIFY(output.endsWith(" : [Error] Last\n"));
+
+	//messages below the minimum severity are ignored by the Core.
+	Core *core = Core::getInstance();
+	IntValue *minimumSeverity = core->getValueManager()->getIntValue(
+				NerdConstants::VALUE_NERD_MINIMUM_LOG_SEVERITY);
+	QVERIFY(minimumSeverity != 0);
+	StringValue *coreRecentMessage = core->getValueManager()->getStringValue(
+				NerdConstants::VALUE_NERD_RECENT_LOGGER_MESSAGE);
+	QVERIFY(coreRecentMessage != 0);
+
+	Core::log("Info");
+	QCOMPARE(coreRecentMessage->get(), QString("Info"));
+	Core::log("Debug", Core::LOG_DEBUG);
+	QCOMPARE(coreRecentMessage->get(), QString("Info"));
+	minimumSeverity->set(Core::LOG_DEBUG);
+	Core::log("Debug", Core::LOG_DEBUG);
+	QCOMPARE(coreRecentMessage->get(), QString("Debug"));
+
+	Core::resetCore();
+}
+
+
 }
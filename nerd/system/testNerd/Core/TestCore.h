@@ -60,6 +60,9 @@ private slots:
 	void testInitAndShutDown();
 	void testGlobalObjects();
 	void testTaskScheduling();
+	void testTaskCoalescing();
+	void testProfiler();
+	void testLogWriter();
 
 };
 }
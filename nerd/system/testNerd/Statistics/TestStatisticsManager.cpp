@@ -0,0 +1,212 @@
+/***************************************************************************
+ *   NERD - Neurodynamics and Evolutionary Robotics Development Toolkit    *
+ *                                                                         *
+ *   University of Osnabrueck, Germany                                     *
+ *   Institute of Cognitive Science                                        *
+ *   Neurocybernetics Group                                                *
+ *   http://www.ikw.uni-osnabrueck.de/~neurokybernetik/                    *
+ *                                                                         *
+ *   Project homepage: nerd.x-bot.org                                      *
+ *                                                                         *
+ *   Copyright (C) 2008 - 2013 by the Neurocybernetics Group Osnabrück     *
+ *   Contact: Christian Rempis                                             *
+ *   christian.rempis@uni-osnabrueck.de                                    *
+ *   Contributors: see contributors.txt in the nerd main directory.        *
+ *                                                                         *
+ *                                                                         *
+ *   Acknowledgments:                                                      *
+ *   The NERD Toolkit is part of the EU project ALEAR                      *
+ *   (Artificial Language Evolution on Autonomous Robots) www.ALEAR.eu     *
+ *   This work was funded (2008 - 2011) by EU-Project Number ICT 214856    *
+ *                                                                         *
+ *                                                                         *
+ *   License Agreement:                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ *                                                                         *
+ *   Publications based on work using the NERD kit have to state this      *
+ *   clearly by citing the NERD homepage and the NERD overview paper.      *  
+ ***************************************************************************/
+
+
+#include "TestStatisticsManager.h"
+#include "Core/Core.h"
+#include "Event/EventManager.h"
+#include "Event/EventListenerAdapter.h"
+#include "Statistics/StatisticsManager.h"
+#include "Statistics/StatisticCalculator.h"
+#include "Statistics/StatisticsLogWriter.h"
+#include "Value/DoubleValue.h"
+#include <QTemporaryFile>
+#include <QFile>
+#include <iostream>
+
+using namespace std;
+
+namespace nerd {
+
+void TestStatisticsManager::testStatisticsByEvent() {
+	Core::resetCore();
+	EventManager *em = Core::getInstance()->getEventManager();
+
+	StatisticsManager *sm = new StatisticsManager();
+	DoubleValue observed(1.0);
+
+	StatisticCalculator *c1 = new StatisticCalculator("C1");
+	StatisticCalculator *c2 = new StatisticCalculator("C2");
+	StatisticCalculator *c3 = new StatisticCalculator("C3");
+	QVERIFY(c1->setObservedValue(&observed));
+	QVERIFY(c2->setObservedValue(&observed));
+	QVERIFY(c3->setObservedValue(&observed));
+
+	QVERIFY(sm->addStatistics(0, "Test/Step1", "Test/Clear", "Test/Updated1") == false);
+	QVERIFY(sm->addStatistics(c1, "Test/Step1", "Test/Clear", "Test/Updated1"));
+	QVERIFY(sm->addStatistics(c2, "Test/Step2", "Test/Clear", "Test/Updated2"));
+	//c3 is stepped and cleared by the same event.
+	QVERIFY(sm->addStatistics(c3, "Test/Step1", "Test/Step1", "Test/Updated1"));
+
+	QList<StatisticCalculator*> step1Statistics = sm->getStatistics("Test/Step1");
+	QCOMPARE(step1Statistics.size(), 2);
+	QVERIFY(step1Statistics.contains(c1));
+	QVERIFY(step1Statistics.contains(c3));
+	QCOMPARE(sm->getStatistics("Test/Step2").size(), 1);
+	QVERIFY(sm->getStatistics("Test/Step2").contains(c2));
+	QCOMPARE(sm->getStatistics("Test/Unknown").size(), 0);
+
+	Event *step1 = em->getEvent("Test/Step1");
+	Event *step2 = em->getEvent("Test/Step2");
+	Event *clear = em->getEvent("Test/Clear");
+	Event *updated1 = em->getEvent("Test/Updated1");
+	Event *updated2 = em->getEvent("Test/Updated2");
+	QVERIFY(step1 != 0 && step2 != 0 && clear != 0 && updated1 != 0 && updated2 != 0);
+
+	EventListenerAdapter updatedListener1("Updated1");
+	EventListenerAdapter updatedListener2("Updated2");
+	updated1->addEventListener(&updatedListener1);
+	updated2->addEventListener(&updatedListener2);
+
+	//a step event only steps its own calculators and triggers the shared updated event once.
+	step1->trigger();
+	observed.set(2.0);
+	step1->trigger();
+	QCOMPARE(c1->getNumberOfValues(), 2);
+	QCOMPARE(c1->getLastValue(), 2.0);
+	QCOMPARE(c2->getNumberOfValues(), 0);
+	QCOMPARE(c3->getNumberOfValues(), 2);
+	QCOMPARE(updatedListener1.mCountEventOccured, 2);
+	QCOMPARE(updatedListener2.mCountEventOccured, 0);
+
+	step2->trigger();
+	QCOMPARE(c2->getNumberOfValues(), 1);
+	QCOMPARE(c1->getNumberOfValues(), 2);
+	QCOMPARE(updatedListener1.mCountEventOccured, 2);
+	QCOMPARE(updatedListener2.mCountEventOccured, 1);
+
+	//the clear event resets c1 and c2, but not c3.
+	clear->trigger();
+	QCOMPARE(c1->getNumberOfValues(), 0);
+	QCOMPARE(c2->getNumberOfValues(), 0);
+	QCOMPARE(c3->getNumberOfValues(), 2);
+	QCOMPARE(updatedListener1.mCountEventOccured, 2);
+
+	//removed calculators are no longer stepped.
+	QVERIFY(sm->removeStatistics(c1));
+	QCOMPARE(sm->getStatistics("Test/Step1").size(), 1);
+	QVERIFY(sm->getStatistics("Test/Step1").contains(c3));
+	step1->trigger();
+	QCOMPARE(c1->getNumberOfValues(), 0);
+	QCOMPARE(c3->getNumberOfValues(), 3);
+	QCOMPARE(updatedListener1.mCountEventOccured, 3);
+
+	//without calculators the updated event of the step event is not triggered any more.
+	QVERIFY(sm->removeStatistics(c3));
+	QCOMPARE(sm->getStatistics("Test/Step1").size(), 0);
+	step1->trigger();
+	QCOMPARE(c3->getNumberOfValues(), 3);
+	QCOMPARE(updatedListener1.mCountEventOccured, 3);
+
+	//adding a calculator again replaces the previous registration.
+	QVERIFY(sm->addStatistics(c1, "Test/Step2", "Test/Clear", "Test/Updated2"));
+	QVERIFY(sm->addStatistics(c1, "Test/Step2", "Test/Clear", "Test/Updated2"));
+	QCOMPARE(sm->getStatistics("Test/Step2").size(), 2);
+	step2->trigger();
+	QCOMPARE(c1->getNumberOfValues(), 1);
+	QCOMPARE(updatedListener2.mCountEventOccured, 2);
+
+	updated1->removeEventListener(&updatedListener1);
+	updated2->removeEventListener(&updatedListener2);
+
+	//c1 and c2 are destroyed by the manager.
+	delete sm;
+	delete c3;
+	Core::resetCore();
+}
+
+
+void TestStatisticsManager::testStatisticsLogWriter() {
+	Core::resetCore();
+
+	QTemporaryFile file;
+	QVERIFY(file.open());
+
+	//rows added to a running writer are all written when finish() returns.
+	StatisticsLogWriter *writer = new StatisticsLogWriter(&file);
+	writer->start();
+	int numberOfRows = 2000;
+	for(int i = 0; i < numberOfRows; ++i) {
+		QVector<double> row;
+		row.append(i);
+		row.append(0.5);
+		row.append(-i * 0.25);
+		writer->addRow(row);
+	}
+	writer->finish();
+	QVERIFY(writer->isFinished());
+	delete writer;
+
+	QFile result(file.fileName());
+	QVERIFY(result.open(QIODevice::ReadOnly));
+	QList<QByteArray> lines = result.readAll().split('\n');
+	result.close();
+	//the last line is terminated with a newline as well.
+	QCOMPARE(lines.size(), numberOfRows + 1);
+	QVERIFY(lines.last().isEmpty());
+	QCOMPARE(lines.at(0), QByteArray("0;0.5;0"));
+	QCOMPARE(lines.at(1), QByteArray("1;0.5;-0.25"));
+	QCOMPARE(lines.at(numberOfRows - 1), QByteArray("1999;0.5;-499.75"));
+	for(int i = 0; i < numberOfRows; ++i) {
+		QVERIFY(lines.at(i).startsWith(QByteArray::number(i) + ";"));
+	}
+
+	//a writer that was never started writes synchronously in finish().
+	QTemporaryFile file2;
+	QVERIFY(file2.open());
+	StatisticsLogWriter *syncWriter = new StatisticsLogWriter(&file2);
+	QVector<double> row(2, 1.5);
+	syncWriter->addRow(row);
+	syncWriter->addRow(row);
+	syncWriter->finish();
+	delete syncWriter;
+
+	QFile result2(file2.fileName());
+	QVERIFY(result2.open(QIODevice::ReadOnly));
+	QCOMPARE(result2.readAll(), QByteArray("1.5;1.5\n1.5;1.5\n"));
+	result2.close();
+
+	Core::resetCore();
+}
+
+}
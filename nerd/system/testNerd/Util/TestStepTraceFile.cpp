@@ -0,0 +1,139 @@
+/***************************************************************************
+ *   NERD - Neurodynamics and Evolutionary Robotics Development Toolkit    *
+ *                                                                         *
+ *   University of Osnabrueck, Germany                                     *
+ *   Institute of Cognitive Science                                        *
+ *   Neurocybernetics Group                                                *
+ *   http://www.ikw.uni-osnabrueck.de/~neurokybernetik/                    *
+ *                                                                         *
+ *   Project homepage: nerd.x-bot.org                                      *
+ *                                                                         *
+ *   Copyright (C) 2008 - 2013 by the Neurocybernetics Group Osnabrück     *
+ *   Contact: Christian Rempis                                             *
+ *   christian.rempis@uni-osnabrueck.de                                    *
+ *   Contributors: see contributors.txt in the nerd main directory.        *
+ *                                                                         *
+ *                                                                         *
+ *   Acknowledgments:                                                      *
+ *   The NERD Toolkit is part of the EU project ALEAR                      *
+ *   (Artificial Language Evolution on Autonomous Robots) www.ALEAR.eu     *
+ *   This work was funded (2008 - 2011) by EU-Project Number ICT 214856    *
+ *                                                                         *
+ *                                                                         *
+ *   License Agreement:                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ *                                                                         *
+ *   Publications based on work using the NERD kit have to state this      *
+ *   clearly by citing the NERD homepage and the NERD overview paper.      *  
+ ***************************************************************************/
+
+
+
+#include "TestStepTraceFile.h"
+#include "Core/Core.h"
+#include <QFile>
+#include "Util/StepTraceFile.h"
+
+namespace nerd{
+
+static bool writeTrace(const QString &fileName, double lastValue) {
+	StepTraceFile file;
+	if(!file.create(fileName)) {
+		return false;
+	}
+	QList<QString> channels;
+	channels << "/Interface/Robot/Sensor" << "/Fitness/Distance";
+	file.setChannels(channels);
+
+	StepTrace step;
+	step.mIndividual = 3;
+	step.mTry = 0;
+	for(quint32 i = 0; i < 5; ++i) {
+		step.mStep = i;
+		step.mValues.clear();
+		step.mValues << (0.1 * i) << (i == 4 ? lastValue : 1.0 / 3.0);
+		if(!file.writeStep(step)) {
+			return false;
+		}
+	}
+	file.close();
+	return true;
+}
+
+
+void TestStepTraceFile::testWriteAndReadTrace() {
+	Core::resetCore();
+
+	QVERIFY(writeTrace("TraceTestFile1.trc", 1.0 / 3.0));
+
+	StepTraceFile file;
+	QVERIFY(file.open("TraceTestFile1.trc"));
+	
+	StepTrace step;
+	for(quint32 i = 0; i < 5; ++i) {
+		QVERIFY(file.readStep(step));
+		QCOMPARE(step.mIndividual, (quint32) 3);
+		QCOMPARE(step.mStep, i);
+		QCOMPARE(step.mValues.size(), 2);
+		//values have to be restored bit exact.
+		QVERIFY(step.mValues.at(0) == 0.1 * i);
+		QVERIFY(step.mValues.at(1) == 1.0 / 3.0);
+	}
+	QCOMPARE(file.getChannels().size(), 2);
+	QCOMPARE(file.getChannels().at(1), QString("/Fitness/Distance"));
+	QVERIFY(!file.readStep(step));
+	QVERIFY(!file.hasError());
+	file.close();
+
+	//not a trace file
+	QFile invalid("TraceTestFile3.trc");
+	QVERIFY(invalid.open(QIODevice::WriteOnly));
+	invalid.write("no trace");
+	invalid.close();
+	QVERIFY(!file.open("TraceTestFile3.trc"));
+
+	QFile::remove("TraceTestFile1.trc");
+	QFile::remove("TraceTestFile3.trc");
+
+	Core::resetCore();
+}
+
+
+void TestStepTraceFile::testCompareTraces() {
+	Core::resetCore();
+
+	QString report;
+	QVERIFY(writeTrace("TraceTestFile1.trc", 1.0 / 3.0));
+	QVERIFY(writeTrace("TraceTestFile2.trc", 1.0 / 3.0));
+	QCOMPARE(StepTraceFile::compare("TraceTestFile1.trc", "TraceTestFile2.trc", 0.0, report), 0);
+
+	//differs in the last bits of the last step only.
+	QVERIFY(writeTrace("TraceTestFile2.trc", (1.0 / 3.0) + 1e-12));
+	QCOMPARE(StepTraceFile::compare("TraceTestFile1.trc", "TraceTestFile2.trc", 0.0, report), 1);
+	QVERIFY(report.contains("/Fitness/Distance"));
+	QCOMPARE(StepTraceFile::compare("TraceTestFile1.trc", "TraceTestFile2.trc", 1e-9, report), 0);
+
+	QCOMPARE(StepTraceFile::compare("TraceTestFile1.trc", "TraceTestFileMissing.trc", 
+									0.0, report), 2);
+
+	QFile::remove("TraceTestFile1.trc");
+	QFile::remove("TraceTestFile2.trc");
+
+	Core::resetCore();
+}
+
+}
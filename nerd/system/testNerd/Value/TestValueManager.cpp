@@ -53,6 +53,7 @@
 #include "Value/ValueManager.h"
 #include "Event/EventManager.h"
 #include <QString>
+#include <QDir>
 #include "MyRepositoryChangedListener.h"
 #include <iostream>
 #include "Value/StringValue.h"
@@ -66,6 +67,10 @@
 #include "Value/Vector3DValue.h"
 #include "Value/MyChangedListener.h"
 #include "Value/MyRepositoryChangedListener.h"
+#include "Value/ValueSnapshot.h"
+#include "Value/ValueFileInterfaceManager.h"
+#include "Event/Event.h"
+#include "Value/ULongLongValue.h"
 
 using namespace std;
 using namespace nerd;
@@ -484,3 +489,185 @@ void TestValueManager::testGetMultiPartValue() {
 	
 	Core::resetCore();
 }
+
+
+void TestValueManager::testPatternQueries() {
+	Core::resetCore();
+	ValueManager *manager = Core::getInstance()->getValueManager();
+
+	QCOMPARE(ValueManager::getLiteralPrefix("/Sim/Agent/.*"), QString("/Sim/Agent/"));
+	QCOMPARE(ValueManager::getLiteralPrefix("/Sim/Agents?/Pos"), QString("/Sim/Agent"));
+	QCOMPARE(ValueManager::getLiteralPrefix("/Sim/(A|B)/Pos"), QString(""));
+	QCOMPARE(ValueManager::getLiteralPrefix(".*/Pos"), QString(""));
+
+	IntValue *val1 = new IntValue(1);
+	IntValue *val2 = new IntValue(2);
+	QVERIFY(manager->addValue("/Sim/Agent/Pos", val1));
+	QVERIFY(manager->addValue("/Sim/Agent-2/Pos", val2));
+	QVERIFY(manager->addValue("/Sim/Agent/Alias", val1));
+	QVERIFY(manager->addValue("/Sim/Other/Pos", new IntValue(3)));
+
+	//order is the same as for a full scan of the sorted names.
+	QList<QString> names = manager->getValueNamesMatchingPattern("/Sim/Agent.*");
+	QCOMPARE(names.size(), 3);
+	QCOMPARE(names.at(0), QString("/Sim/Agent-2/Pos"));
+	QCOMPARE(names.at(1), QString("/Sim/Agent/Alias"));
+	QCOMPARE(names.at(2), QString("/Sim/Agent/Pos"));
+
+	QCOMPARE(manager->getValueNamesMatchingPattern("/Sim/Agent/Pos|/Sim/Other/Pos").size(), 2);
+	QCOMPARE(manager->getValueNamesMatchingPattern("/sim/agent/.*", false).size(), 2);
+	QCOMPARE(manager->getValueNamesMatchingPattern("/sim/agent/.*").size(), 0);
+
+	QList<Value*> values = manager->getValuesMatchingPattern("/Sim/Agent/.*");
+	QCOMPARE(values.size(), 1);
+	QVERIFY(values.at(0) == val1);
+
+	//cached results are invalidated when the set of values changes.
+	QVERIFY(manager->addValue("/Sim/Agent/Vel", val2));
+	values = manager->getValuesMatchingPattern("/Sim/Agent/.*");
+	QCOMPARE(values.size(), 2);
+	QCOMPARE(manager->getValueNamesMatchingPattern("/Sim/Agent.*").size(), 4);
+
+	QVERIFY(manager->removeValue("/Sim/Agent/Vel"));
+	QCOMPARE(manager->getValuesMatchingPattern("/Sim/Agent/.*").size(), 1);
+
+	Core::resetCore();
+}
+
+
+void TestValueManager::testValueSnapshots() {
+	Core::resetCore();
+	ValueManager *manager = Core::getInstance()->getValueManager();
+
+	IntValue *iVal = new IntValue(100);
+	DoubleValue *dVal = new DoubleValue(0.1);
+	BoolValue *bVal = new BoolValue(true);
+	StringValue *sVal = new StringValue("Some text=with separator");
+	ULongLongValue *ulVal = new ULongLongValue(12345678901234ULL);
+	Vector3DValue *vVal = new Vector3DValue(1.0, 2.0, 3.0);
+
+	QVERIFY(manager->addValue("/Snapshot/Int", iVal));
+	QVERIFY(manager->addValue("/Snapshot/Double", dVal));
+	QVERIFY(manager->addValue("/Snapshot/Bool", bVal));
+	QVERIFY(manager->addValue("/Snapshot/String", sVal));
+	QVERIFY(manager->addValue("/Snapshot/ULongLong", ulVal));
+	QVERIFY(manager->addValue("/Snapshot/Vector", vVal));
+
+	QList<QString> names = manager->getValueNamesMatchingPattern("/Snapshot/.*");
+	QCOMPARE(names.size(), 6);
+
+	//complete snapshot
+	QVERIFY(manager->saveValueSnapshot("testSnapshot.vsn", names));
+	QVERIFY(ValueSnapshot::isSnapshotFile("testSnapshot.vsn"));
+
+	//an existing snapshot is replaced, no temporary files are left behind.
+	QVERIFY(manager->saveValueSnapshot("testSnapshot.vsn", names));
+	QVERIFY(ValueSnapshot::isSnapshotFile("testSnapshot.vsn"));
+	QCOMPARE(QDir().entryList(QStringList("testSnapshot.vsn.*")).size(), 0);
+
+	iVal->set(-5);
+	dVal->set(2.5);
+	bVal->set(false);
+	sVal->set("");
+	ulVal->set(0);
+	vVal->set(0.0, 0.0, 0.0);
+
+	//loadValues detects snapshots automatically.
+	QVERIFY(manager->loadValues("testSnapshot.vsn"));
+	QCOMPARE(iVal->get(), 100);
+	QCOMPARE(dVal->get(), 0.1); //binary, no rounding
+	QCOMPARE(bVal->get(), true);
+	QCOMPARE(sVal->get(), QString("Some text=with separator"));
+	QCOMPARE(ulVal->get(), 12345678901234ULL);
+	QCOMPARE(vVal->getZ(), 3.0);
+
+	//diff against the snapshot only contains the changed values.
+	iVal->set(7);
+	sVal->set("Changed");
+	QVERIFY(manager->saveValueSnapshot("testSnapshotDiff.vsn", names, "testSnapshot.vsn"));
+	{
+		ValueSnapshot diff;
+		QVERIFY(diff.open("testSnapshotDiff.vsn"));
+		QVERIFY(diff.isDiff());
+		QCOMPARE(diff.getNumberOfEntries(), 2);
+		QCOMPARE(diff.getName(0), QString("/Snapshot/Int"));
+		QCOMPARE(diff.getName(1), QString("/Snapshot/String"));
+	}
+
+	//loading the diff loads the base first.
+	iVal->set(0);
+	dVal->set(0.0);
+	sVal->set("");
+	QVERIFY(manager->loadValueSnapshot("testSnapshotDiff.vsn"));
+	QCOMPARE(iVal->get(), 7);
+	QCOMPARE(dVal->get(), 0.1);
+	QCOMPARE(sVal->get(), QString("Changed"));
+
+	//text files are not accepted as snapshots.
+	QVERIFY(manager->saveValues("testSnapshot.val", names, ""));
+	QVERIFY(ValueSnapshot::isSnapshotFile("testSnapshot.val") == false);
+	ValueSnapshot text;
+	QVERIFY(text.open("testSnapshot.val") == false);
+
+	QFile::remove("testSnapshot.vsn");
+	QFile::remove("testSnapshotDiff.vsn");
+	QFile::remove("testSnapshot.val");
+
+	Core::resetCore();
+}
+
+
+//The store event of a ValueFileInterfaceManager writes a base snapshot once per run
+//and a diff against that base at each store.
+void TestValueManager::testValueFileInterfaceSnapshots() {
+	QFile::remove("testInterface.vsn");
+	QFile::remove("testInterface.base.vsn");
+
+	for(int run = 0; run < 2; ++run) {
+		Core::resetCore();
+		ValueManager *manager = Core::getInstance()->getValueManager();
+		Event *storeEvent = Core::getInstance()->getEventManager()->createEvent("StoreValues");
+		QVERIFY(storeEvent != 0);
+
+		IntValue *iVal = new IntValue(10 * run);
+		StringValue *sVal = new StringValue(QString("Run %1").arg(run));
+		QVERIFY(manager->addValue("/Stored/Int", iVal));
+		QVERIFY(manager->addValue("/Stored/String", sVal));
+
+		ValueFileInterfaceManager *valueInterface = new ValueFileInterfaceManager(
+					"ValueInterface", "/ValueInterface/", "LoadValues", "", 
+					"StoreValues", "testInterface.vsn", "/Stored/.*");
+		BoolValue *enable = dynamic_cast<BoolValue*>(
+					valueInterface->getParameter("EnableValueInterface"));
+		QVERIFY(enable != 0);
+		enable->set(true);
+		QVERIFY(valueInterface->bind());
+
+		storeEvent->trigger();
+		QVERIFY(ValueSnapshot::isSnapshotFile("testInterface.base.vsn"));
+
+		iVal->set(10 * run + 1);
+		storeEvent->trigger();
+		{
+			ValueSnapshot diff;
+			QVERIFY(diff.open("testInterface.vsn"));
+			QVERIFY(diff.isDiff());
+			QCOMPARE(diff.getBaseFileName(), QString("testInterface.base.vsn"));
+			QCOMPARE(diff.getNumberOfEntries(), 1);
+			QCOMPARE(diff.getName(0), QString("/Stored/Int"));
+		}
+
+		//the second run rewrites the base, its diffs still apply to the new base.
+		iVal->set(-1);
+		sVal->set("");
+		QVERIFY(manager->loadValues("testInterface.vsn"));
+		QCOMPARE(iVal->get(), 10 * run + 1);
+		QCOMPARE(sVal->get(), QString("Run %1").arg(run));
+		QCOMPARE(QDir().entryList(QStringList("testInterface*.vsn.*")).size(), 0);
+	}
+
+	QFile::remove("testInterface.vsn");
+	QFile::remove("testInterface.base.vsn");
+
+	Core::resetCore();
+}
@@ -62,6 +62,9 @@ private slots:
 	void testNotificationStack();
 	void testRemoveValuesByList();
 	void testGetMultiPartValue();
+	void testPatternQueries();
+	void testValueSnapshots();
+	void testValueFileInterfaceSnapshots();
 
 	void testPrototyping();
 };
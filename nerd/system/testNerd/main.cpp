@@ -64,11 +64,14 @@ using namespace std;
 #include "Value/TestNormalizedDoubleValue.h"
 #include "Math/TestMath.h"
 #include "Communication/TestUdpDatagram.h"
+#include "Communication/TestSharedMemoryRingBuffer.h"
 #include "Util/TestColor.h"
 #include "Util/TestFileLocker.h"
+#include "Util/TestStepTraceFile.h"
 #include "Math/TestMatrix.h"
+#include "Statistics/TestStatisticsManager.h"
 
-TEST_START("TestNerd", 1, -1, 16); 
+TEST_START("TestNerd", 1, -1, 19); 
 
 	TEST(TestMath);
 	TEST(TestValue);
@@ -83,9 +86,12 @@ TEST_START("TestNerd", 1, -1, 16);
 	TEST(TestInterfaceValue);
 	TEST(TestNormalizedDoubleValue);
 	TEST(TestUdpDatagram);
+	TEST(TestSharedMemoryRingBuffer);
 	TEST(TestColor);
 	TEST(TestFileLocker);
+	TEST(TestStepTraceFile);
 	TEST(TestMatrix);
+	TEST(TestStatisticsManager);
 
 TEST_END;
 